@@ -158,6 +158,32 @@ class Application
             };
         };
 
+        // A literal run of a resource string followed by an optional insert
+        struct STRING_PART
+        {
+            size_t offset;
+            size_t length;
+            size_t insert;      // 1 to 3 for %%1 to %%3, zero for none
+            STRING_PART():offset( 0 ),
+                          length( 0 ),
+                          insert( 0 )
+            {
+            };
+        };
+
+        // A resource string pre-parsed into its parts
+        struct STRING_TEMPLATE
+        {
+            size_t  firstPart;
+            size_t  numParts;
+            String  Text;
+            STRING_TEMPLATE():firstPart( 0 ),
+                              numParts( 0 ),
+                              Text()
+            {
+            };
+        };
+
         struct RESOURCE_LANGIDS
         {
             WORD resourceID;
@@ -182,6 +208,10 @@ class Application
                                      WORD* pPxsBaseLocaleID,
                                      WORD* pAppEnglishID, WORD* pAppLocaleID );
  static void GetStringTable( WORD resourceID, TList< ID_TEXT >* pStringTable );
+ static void MakeStringTemplates( TList< ID_TEXT >* pStringTable,
+                                  DWORD* pFirstStringID,
+                                  TArray< STRING_TEMPLATE >* pTemplates,
+                                  TArray< STRING_PART >* pParts );
  static void MergeStringTables( TList< ID_TEXT >* pTable1, TList< ID_TEXT >* pTable2 );
  static bool StringTableLineToIdString( const String& Line, ID_TEXT* pIdText );
 
@@ -190,6 +220,7 @@ class Application
         sig_atomic_t      m_isAppLogging;
         HWND              m_hWndMainFrame;
         DWORD             m_uLogLevel;
+        DWORD             m_uFirstStringID;
         COLORREF          m_crGradientOne;
         COLORREF          m_crGradientTwo;
         Mutex             m_Mutex;
@@ -206,7 +237,8 @@ class Application
         String            m_RegisteredOwnerName;
         String            m_SupportEmail;
         String            m_WebSiteURL;
-        TList< ID_TEXT >  m_StringTable;
+        TArray< STRING_PART >      m_StringParts;
+        TArray< STRING_TEMPLATE >  m_StringTemplates;
         TArray< RESOURCE_LANGIDS > m_AppResourceLanguageIDs;
 };
 
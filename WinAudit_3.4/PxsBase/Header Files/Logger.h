@@ -33,7 +33,9 @@
 // Remarks
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-// Logging can be to a file, a string array or both.
+// Logging can be to a file, a string array or both. File output is buffered
+// and written when the buffer is full, after a short interval or on Flush.
+// The string array is a ring holding the most recent messages.
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Includes
@@ -70,7 +72,7 @@ class Logger
 
         // Methods
         void    AppendComment( LPCWSTR pszComment );
-        void    Flush() const;
+        void    Flush();
         void    GetLogMessages( StringArray* pLogMessages ) const;
 const String&   GetPath() const;
         bool    IsStarted() const;
@@ -104,16 +106,23 @@ const String&   GetPath() const;
                           LPCWSTR pszMessage,
                           const String& Insert1, const String& Insert2, String* pEntry ) const;
  static void SeverityCodeToString( DWORD severity, String* pSeverityString );
+        void WriteBuffer();
         void WriteText( const String& Text );
         void WriteHeader();
         void WriteSystemDiagnosticData( bool wantExtraInfo );
 
         // Data members
+        size_t  MAX_LOG_MESSAGES;
+        size_t  WRITE_BUFFER_CHARS;
+        DWORD   WRITE_INTERVAL_MS;
         bool    m_bLogging;
         bool    m_bWantComputerName;
         bool    m_bWritingEntry;       // Indicate an entry is being written
         File    m_File;
+        size_t  m_idxOldestMessage;    // Next slot to overwrite when full
+        DWORD   m_uLastWriteTicks;
         String  m_FilePath;
+        String  m_WriteBuffer;         // Text not yet written to the file
         StringArray m_LogMessages;     // Array to hold the messages
 };
 
@@ -77,6 +77,7 @@ class NameValue
         void          Reset();
         void          SetNameValue( LPCWSTR pwzName, LPCWSTR pwzValue );
         void          SetNameValue( const String& Name, const String& Value );
+        void          Swap( NameValue& Other );
 
     protected:
         // Method
@@ -178,6 +178,10 @@ const DWORD PXS_LOG_LEVEL_ERROR             = 1;
 const DWORD PXS_LOG_LEVEL_NORMAL            = 2;
 const DWORD PXS_LOG_LEVEL_VERBOSE           = 3;
 
+// Sort key types
+const DWORD PXS_SORT_KEY_STRING             = 0;    // Case insensitive
+const DWORD PXS_SORT_KEY_VERSION            = 1;    // Numeric runs compared as numbers
+
 // State constants
 const DWORD PXS_STATE_UNKNOWN               = 0;
 const DWORD PXS_STATE_ERROR                 = 1;
@@ -412,6 +416,7 @@ const wchar_t PXS_DBMS_NAME_MYSQL[]         = L"MySQL";
 const wchar_t PXS_DBMS_NAME_ORACLE[]        = L"Oracle";
 const wchar_t PXS_DBMS_NAME_SQL_SERVER[]    = L"Microsoft SQL Server";
 const wchar_t PXS_DBMS_NAME_POSTGRE_SQL[]   = L"PostgreSQL";
+const wchar_t PXS_DBMS_NAME_SQLITE[]        = L"SQLite";
 
 // Database Keywords, UTC_TIMESTAMP is non-standard
 const wchar_t PXS_KEYWORD_CURRENT_TIMESTAMP[]   = L"CURRENT_TIMESTAMP";
@@ -453,18 +458,8 @@ const wchar_t PXS_STRING_RFC3987_UNRESERVED[]   = L"abcdefghijklmnopqrstuvwxyz"
 // Structures
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-typedef struct _PXS_TYPE_NUMBER_STRING
-{
-    size_t  number;
-    wchar_t szValue[ 32 ];
-} PXS_TYPE_NUMBER_STRING;
-
-
-typedef struct _PXS_TYPE_STRING_STRING
-{
-    LPCWSTR  pszString1;
-    LPCWSTR  pszString2;
-} PXS_TYPE_STRING_STRING;
+// Callback for PXSStableSortIndexes, compares the elements at two indexes
+typedef int ( *PXS_SORT_INDEX_COMPARE )( size_t index1, size_t index2, const void* pContext );
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Function prototypes
@@ -591,6 +586,7 @@ void    PXSLimitSizeT( size_t lower, size_t upper, size_t* pValue );
 void    PXSLimitUInt32( DWORD lower, DWORD upper, DWORD* pValue );
 
 // Logging
+DWORD   PXSGetNumberOfLoggedExceptions();
 bool    PXSIsAppLogging();
 void    PXSLogAppError( LPCWSTR pszMessage );
 void    PXSLogAppError1( LPCWSTR pszMessage, const String& Insert1 );
@@ -675,10 +671,9 @@ DWORD   PXSMultiplyUInt32( DWORD x, DWORD y );
 UINT64  PXSMultiplyUInt64( UINT64 x, UINT64 y );
 
 // Searching/Sorting
-int     PXSQSortStringAscending( const void* pArg1, const void* pArg2 );
-int     PXSQSortStringDescending( const void* pArg1, const void* pArg2 );
-int     PXSQSortStringStringAscending( const void* pArg1, const void* pArg2 );
 void    PXSSortNameValueArray( TArray< NameValue >* pNameValues );
+void    PXSStableSortIndexes( size_t* pIndexes, size_t numIndexes,
+                              PXS_SORT_INDEX_COMPARE pfnCompare, const void* pContext );
 
 // Abort
 void        PXSShowExceptionDialog( const Exception& e, HWND hWndOwner );
@@ -707,6 +702,7 @@ void     PXSBitmapRgbToGrb( HBITMAP hBitmap );
 BYTE     PXSCharToDigit( wchar_t wch );
 void     PXSCoInitializeSecurity();
 void     PXSColourRefToHtmlColour( COLORREF colour, String* pHtmlColour );
+int      PXSCompareSortKey( LPCWSTR pszKey1, LPCWSTR pszKey2, DWORD keyType );
 int      PXSCompareString( LPCWSTR pszString1, LPCWSTR pszString2, bool caseSensitive );
 int      PXSCompareStringN( LPCWSTR pszString1,
                             LPCWSTR pszString2, size_t numChars, bool caseSensitive );
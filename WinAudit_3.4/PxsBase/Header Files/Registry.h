@@ -78,6 +78,9 @@ class Registry
         void    GetNameValueList( LPCWSTR pszSubKey, TArray< NameValue >* pNameValueList );
         void    GetStringValue( LPCWSTR pszSubKey, LPCWSTR pszValueName, String* pStringValue );
         void    GetSubKeyList( LPCWSTR pszSubKey, StringArray* pSubKeyList ) const;
+        UINT64  GetSubKeyWriteTimes( LPCWSTR pszSubKey,
+                                     StringArray* pSubKeyList,
+                                     TArray< UINT64 >* pLastWriteTimes ) const;
         void    GetValueAsString( LPCWSTR pszSubKey, LPCWSTR pszValueName, String* pStringValue );
 
     protected:
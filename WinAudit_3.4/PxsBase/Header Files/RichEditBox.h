@@ -63,9 +63,10 @@ class RichEditBox : public TextArea
 
         // Methods
         void    AddToEventMask( LPARAM events );
-        void    AppendRichText( const String& RichText );
+        LONG    AppendRichText( const String& RichText );
         bool    FindText( const String& Text,
                           bool caseSensitive, bool forward, bool fromSelectionStart );
+        bool    FindTextFrom( const String& Text, bool caseSensitive, LONG position );
         bool    IsAnyTextSelected();
         void    SetRichText( const String& RichText );
         LONG    StreamInCallback( LPBYTE pbBuff, LONG cb );
@@ -92,6 +92,7 @@ class StringArray
         bool    StartsWithI( size_t index, wchar_t wch ) const;
         bool    StartsWithI( size_t index, LPCWSTR pszPrefix ) const;
         void    SubString( size_t index, size_t start, size_t length, String* pSub ) const;
+        void    Swap( StringArray& Other );
         void    ToString( wchar_t wch, String* pString ) const;
 
     protected:
@@ -101,6 +102,8 @@ class StringArray
 
     private:
         // Methods
+ static int     SortCompareAscending( size_t index1, size_t index2, const void* pContext );
+ static int     SortCompareDescending( size_t index1, size_t index2, const void* pContext );
 
         // Data members
         size_t    REALLOC_SIZE;     // Pseudo constant
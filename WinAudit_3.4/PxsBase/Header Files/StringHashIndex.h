@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// String Hash Index Class Header
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PXSBASE_STRING_HASH_INDEX_H_
+#define PXSBASE_STRING_HASH_INDEX_H_
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Open addressed hash table of indexes into a caller's array, e.g. a
+// StringArray of keys. The index holds only the hashes and the indexes so
+// keys that are not strings can supply their own hash and do their own
+// comparisons with FindFirst/FindNext. The table is doubled before it is half
+// full so the probe sequences stay short.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Includes
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "PxsBase/Header Files/PxsBase.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+
+// 5. This Project
+#include "PxsBase/Header Files/TArray.h"
+
+// 6. Forwards
+class StringArray;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Interface
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class StringHashIndex
+{
+    public:
+        // Default constructor
+        StringHashIndex();
+
+        // Destructor
+        ~StringHashIndex();
+
+        // Methods
+        void    Add( UINT32 hash, size_t index );
+        void    Add( LPCWSTR pszKey, bool caseSensitive, size_t index );
+        size_t  Find( const StringArray& Keys, LPCWSTR pszKey, bool caseSensitive ) const;
+        size_t  FindFirst( UINT32 hash, size_t* pPosition ) const;
+        size_t  FindNext( UINT32 hash, size_t* pPosition ) const;
+        size_t  GetSize() const;
+        void    RemoveAll();
+ static UINT32  HashString( LPCWSTR pszString, bool caseSensitive );
+ static UINT32  HashString( LPCWSTR pszString, size_t numChars, bool caseSensitive );
+
+    protected:
+        // Methods
+
+        // Data members
+
+    private:
+        // Copy constructor - not allowed
+        StringHashIndex( const StringHashIndex& oStringHashIndex );
+
+        // Assignment operator - not allowed
+        StringHashIndex& operator= ( const StringHashIndex& oStringHashIndex );
+
+        // Methods
+        void    Grow();
+        size_t  Probe( UINT32 hash, size_t idxSlot, size_t* pPosition ) const;
+
+        // Data members
+        TArray< UINT32 > m_Hashes;      // Hash of each entry, kept for re-hashing
+        TArray< size_t > m_Indexes;     // Caller's index of each entry
+        TArray< size_t > m_Slots;       // Entry + 1, 0 = empty
+};
+
+#endif  // PXSBASE_STRING_HASH_INDEX_H_
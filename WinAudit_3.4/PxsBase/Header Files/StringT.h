@@ -33,6 +33,11 @@
 // Remarks
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Strings of fewer than INLINE_CHARS characters are kept in the object so do
+// not allocate. The length is always kept so copies do not rescan for the
+// terminator. A null string, i.e. c_str() == nullptr, is still distinct
+// from an empty one.
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Includes
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -67,11 +72,15 @@ class String
         // Copy constructor
         String( const String& oString );
 
+        // Move constructor
+        String( String&& oString );
+
         // Destructor
         ~String();
 
         // Operators
         String& operator  = ( const String& oString );
+        String& operator  = ( String&& oString );
         String& operator += ( const String& oString );
 
         String& operator  = ( LPCWSTR pszString );
@@ -139,6 +148,7 @@ class String
         bool    StartsWith( const String& Prefix, bool caseSensitive ) const;
         bool    StartsWith( LPCWSTR pszPrefix, bool caseSensitive ) const;
         void    SubString( size_t start, size_t length, String* pSub ) const;
+        void    Swap( String& Other );
         bool    StartsWithI( LPCWSTR pszPrefix ) const;
         size_t  ToArray( wchar_t ch, StringArray* pTokens ) const;
         size_t  ToArray( const wchar_t* pSeparator, StringArray* pTokens ) const;
@@ -156,13 +166,18 @@ class String
 
     private:
         // Methods
+        void FreeBuffer();
         void SetMultibyte( const char* pszMB, size_t numChars, UINT codePage );
 
+        // Constants
+        static const size_t INLINE_CHARS       = 20;    // Including the terminator
+        static const size_t MINIMUM_ALLOCATION = 32;    // Smallest heap allocation
+
         // Data members
-        size_t   MINIMUM_ALLOCATION;    // Always allocate at least this amount
         size_t   m_uLengthChars;
         size_t   m_uCharsAllocated;
-        wchar_t* m_pwzString;
+        wchar_t* m_pwzString;                   // nullptr, m_szInline or on the heap
+        wchar_t  m_szInline[ INLINE_CHARS ];
 };
 
 #endif  // PXSBASE_STRING_H_
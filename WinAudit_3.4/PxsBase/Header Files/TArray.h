@@ -50,6 +50,7 @@
 #include "PxsBase/Header Files/BoundsException.h"
 #include "PxsBase/Header Files/FunctionException.h"
 #include "PxsBase/Header Files/MemoryException.h"
+#include "PxsBase/Header Files/ParameterException.h"
 
 // 6. Forwards
 
@@ -81,6 +82,7 @@ class TArray
         T*          GetPtr( size_t index ) const;
         size_t      GetSize() const;
         void        Insert( size_t index, const T& Element );
+        void        Permute( const size_t* pOrder, size_t numOrder );
         void        Remove( size_t index );
         void        RemoveAll();
         void        Set( size_t index, const T& Element );
@@ -362,6 +364,78 @@ void TArray< T >::Insert( size_t index, const T& Element )
     m_size   = newSize;
 }
 
+//===============================================================================================//
+//  Description:
+//      Re-order the array so that element i becomes the one that was at pOrder[ i ]
+//
+//  Parameters:
+//      pOrder   - the new order, a permutation of 0 to size - 1
+//      numOrder - the number of entries in pOrder, must equal the array size
+//
+//  Remarks:
+//      Follows each cycle of the permutation swapping elements into place,
+//      so requires T::Swap but no element is copied. Typically used with the
+//      output of PXSStableSortIndexes.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+template< class T >
+void TArray< T >::Permute( const size_t* pOrder, size_t numOrder )
+{
+    if ( pOrder == nullptr )
+    {
+        throw ParameterException( L"pOrder", __FUNCTION__ );
+    }
+
+    if ( numOrder != m_size )
+    {
+        throw BoundsException( L"numOrder", __FUNCTION__ );
+    }
+
+    if ( m_size < 2 )
+    {
+        return;     // Nothing to do
+    }
+
+    bool* pPlaced = new bool[ m_size ];
+    if ( pPlaced == nullptr )
+    {
+        throw MemoryException( __FUNCTION__ );
+    }
+    memset( pPlaced, 0, sizeof ( bool ) * m_size );
+
+    // Validate before moving anything so the array is left unchanged on error
+    for ( size_t i = 0; i < m_size; i++ )
+    {
+        if ( ( pOrder[ i ] >= m_size ) || pPlaced[ pOrder[ i ] ] )
+        {
+            delete[] pPlaced;
+            throw ParameterException( L"pOrder", __FUNCTION__ );
+        }
+        pPlaced[ pOrder[ i ] ] = true;
+    }
+    memset( pPlaced, 0, sizeof ( bool ) * m_size );
+
+    for ( size_t i = 0; i < m_size; i++ )
+    {
+        // Walk the cycle starting at i, each swap puts one element in place
+        size_t j = i;
+        while ( pPlaced[ j ] == false )
+        {
+            pPlaced[ j ] = true;
+            size_t k     = pOrder[ j ];
+            if ( k == i )
+            {
+                break;
+            }
+            m_pArray[ j ].Swap( m_pArray[ k ] );
+            j = k;
+        }
+    }
+    delete[] pPlaced;
+}
+
 //===============================================================================================//
 //  Description:
 //      Remove the element at the specified index from the array
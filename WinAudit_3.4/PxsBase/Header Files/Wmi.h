@@ -33,6 +33,10 @@
 // Remarks
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// ConnectServer is slow, calling Connect again on the same namespace re-uses
+// the existing connection. Callers that need several rows of a class should
+// read them once with GetClassRows rather than query per row.
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Includes
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -48,9 +52,11 @@
 // 4. Other Libraries
 
 // 5. This Project
+#include "PxsBase/Header Files/StringT.h"
 
 // 6. Forwards
 class NameValue;
+class StringArray;
 template< class T > class TArray;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -70,6 +76,8 @@ class Wmi
         void    CloseQuery();
         void    Connect( LPCWSTR pszNameSpace );
         void    Disconnect();
+        size_t  GetClassRows( LPCWSTR pszClassName,
+                              const StringArray& Properties, TArray< StringArray >* pRows );
         void    GetPropertyValues( TArray< NameValue >* pNameValues );
         void    ExecQuery( LPCWSTR pszQuery );
         void    Get( LPCWSTR pwszName, String* pValue );
@@ -102,6 +110,7 @@ class Wmi
         IWbemClassObject*     m_pIWbemClassObject;
         IWbemLocator*         m_pIWbemLocator;
         IWbemServices*        m_pIWbemServices;
+        String                m_NameSpace;
 };
 
 #endif  // PXSBASE_WMI_H_
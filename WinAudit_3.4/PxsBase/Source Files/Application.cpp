@@ -80,6 +80,7 @@ Application::Application()
              m_isAppLogging( FALSE ),
              m_hWndMainFrame( nullptr ),
              m_uLogLevel( PXS_LOG_LEVEL_NONE ),
+             m_uFirstStringID( 0 ),
              m_crGradientOne( CLR_INVALID ),
              m_crGradientTwo( CLR_INVALID ),
              m_Mutex(),
@@ -96,7 +97,8 @@ Application::Application()
              m_RegisteredOwnerName(),
              m_SupportEmail(),
              m_WebSiteURL(),
-             m_StringTable(),
+             m_StringParts(),
+             m_StringTemplates(),
              m_AppResourceLanguageIDs()
 {
 }
@@ -846,6 +848,10 @@ void Application::GetResourceString2( DWORD resourceID,
 //      Defaults to English. If a non-English resource or file has been
 //      loaded will use the foreign string
 //
+//      The string is found by indexing the template table with the id then
+//      its parts and inserts are copied in one pass. As for Formatter, a
+//      null insert is shown as <null>.
+//
 //  Returns:
 //      void. On error, "" is put into output ResourceString
 //===============================================================================================//
@@ -854,34 +860,79 @@ void Application::GetResourceString3( DWORD resourceID,
                                       const String& Insert2,
                                       const String& Insert3, String* pResourceString )
 {
-    bool      bFound   = false;
-    ID_TEXT*  pElement = nullptr;
-    Formatter Format;
+    size_t  i = 0, index = 0, numChars = 0;
+    size_t  insertLengths[ 4 ] = { 0 };
+    LPCWSTR pszText = nullptr;
+    LPCWSTR pszInserts[ 4 ] = { nullptr, Insert1.c_str(), Insert2.c_str(), Insert3.c_str() };
+    String  Result;
+    String* pTarget = pResourceString;
+    STRING_PART*     pPart     = nullptr;
+    STRING_TEMPLATE* pTemplate = nullptr;
 
     if ( pResourceString == nullptr )
     {
         return;
     }
-    *pResourceString = PXS_STRING_EMPTY;
+
+    // Build elsewhere if the output is also an insert
+    if ( ( pResourceString == &Insert1 ) ||
+         ( pResourceString == &Insert2 ) ||
+         ( pResourceString == &Insert3 )  )
+    {
+        pTarget = &Result;
+    }
+    *pTarget = PXS_STRING_EMPTY;
+
+    insertLengths[ 1 ] = Insert1.GetLength();
+    insertLengths[ 2 ] = Insert2.GetLength();
+    insertLengths[ 3 ] = Insert3.GetLength();
+    for ( i = 1; i < ARRAYSIZE( pszInserts ); i++ )
+    {
+        if ( pszInserts[ i ] == nullptr )
+        {
+            pszInserts[ i ]    = L"<null>";
+            insertLengths[ i ] = wcslen( pszInserts[ i ] );
+        }
+    }
 
     m_Mutex.Lock();
     AutoUnlockMutex AutoUnlock( &m_Mutex );
-    if ( m_StringTable.IsEmpty() )
+    if ( resourceID >= m_uFirstStringID )
     {
-        return;
+        index = resourceID - m_uFirstStringID;
+        if ( index < m_StringTemplates.GetSize() )
+        {
+            pTemplate = m_StringTemplates.GetPtr( index );
+            pszText   = pTemplate->Text.c_str();
+        }
     }
 
-    // Find the matching string id
-    m_StringTable.Rewind();
-    do
+    if ( pszText )
     {
-        pElement = m_StringTable.GetPointer();
-        if ( pElement && ( resourceID == pElement->id ) )
+        for ( i = 0; i < pTemplate->numParts; i++ )
+        {
+            pPart    = m_StringParts.GetPtr( pTemplate->firstPart + i );
+            numChars = PXSAddSizeT( numChars, pPart->length );
+            numChars = PXSAddSizeT( numChars, insertLengths[ pPart->insert ] );
+        }
+        pTarget->Allocate( PXSAddSizeT( numChars, 1 ) );
+
+        for ( i = 0; i < pTemplate->numParts; i++ )
         {
-            bFound = true;
-            *pResourceString = Format.String3( pElement->Text.c_str(), Insert1, Insert2, Insert3 );
+            pPart = m_StringParts.GetPtr( pTemplate->firstPart + i );
+            pTarget->AppendChars( pszText + pPart->offset, pPart->length );
+            if ( pPart->insert )
+            {
+                pTarget->AppendChars( pszInserts[ pPart->insert ],
+                                      insertLengths[ pPart->insert ] );
+            }
         }
-    } while ( ( bFound == false ) && ( m_StringTable.Advance() ) );
+    }
+
+    if ( pTarget != pResourceString )
+    {
+        pResourceString->Swap( Result );
+    }
 }
 
 //===============================================================================================//
@@ -1119,9 +1170,11 @@ void Application::LoadByteDataResource( DWORD resourceID, ByteArray* pBytes )
 void Application::LoadStringFile( WORD primaryLanguage, WORD subLanguage )
 {
     WORD    pxsBaseLocaleID = 0, appEnglishID = 0, appLocaleID = 0;
-    ID_TEXT Element;
+    DWORD   firstStringID = 0;
     TList< ID_TEXT > TempTable;
     TList< ID_TEXT > StringTable;
+    TArray< STRING_PART >     Parts;
+    TArray< STRING_TEMPLATE > Templates;
 
     // These combinations have a special meaning, see MSDN MAKELANGID.
     if ( primaryLanguage == LANG_NEUTRAL )
@@ -1171,16 +1224,17 @@ void Application::LoadStringFile( WORD primaryLanguage, WORD subLanguage )
         MergeStringTables( &TempTable, &StringTable );
     }
 
-    // Replace at class scope. Note, this is not exception safe, sorry!
+    // Parse the strings then swap them in so lookups do not see a
+    // partially built table
     if ( StringTable.IsEmpty() == false )
     {
-        m_StringTable.RemoveAll();
-        StringTable.Rewind();
-        do
-        {
-            Element = StringTable.Get();
-            m_StringTable.Append( Element );
-        } while ( StringTable.Advance() );
+        MakeStringTemplates( &StringTable, &firstStringID, &Templates, &Parts );
+
+        m_Mutex.Lock();
+        AutoUnlockMutex AutoUnlock( &m_Mutex );
+        m_uFirstStringID  = firstStringID;
+        m_StringTemplates = Templates;
+        m_StringParts     = Parts;
     }
 }
 
@@ -1928,6 +1982,120 @@ void Application::GetStringTable( WORD resourceID, TList< ID_TEXT >* pStringTabl
     }
 }
 
+//===============================================================================================//
+//  Description:
+//      Make the lookup table of a string table
+//
+//  Parameters:
+//      pStringTable   - the string table
+//      pFirstStringID - receives the id of the first template
+//      pTemplates     - receives the templates indexed by id less the first
+//      pParts         - receives the parts of all the templates
+//
+//  Remarks:
+//      The ids are small and nearly contiguous so indexing by id is a
+//      perfect hash. Each string is split at its %%1 to %%3 placeholders so
+//      lookups do not have to search for them. Ids above MAX_STRING_ID are
+//      ignored to bound the size of the table.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void Application::MakeStringTemplates( TList< ID_TEXT >* pStringTable,
+                                       DWORD* pFirstStringID,
+                                       TArray< STRING_TEMPLATE >* pTemplates,
+                                       TArray< STRING_PART >* pParts )
+{
+    const   DWORD MAX_STRING_ID = 0xFFFF;
+    DWORD   minID = MAX_STRING_ID, maxID = 0;
+    size_t  i = 0, start = 0, numChars = 0;
+    LPCWSTR pszText  = nullptr;
+    ID_TEXT* pElement = nullptr;
+    STRING_PART     Part;
+    STRING_TEMPLATE Template;
+
+    if ( ( pStringTable   == nullptr ) ||
+         ( pFirstStringID == nullptr ) ||
+         ( pTemplates     == nullptr ) ||
+         ( pParts         == nullptr )  )
+    {
+        throw ParameterException( L"nullptr", __FUNCTION__ );
+    }
+    *pFirstStringID = 0;
+    pTemplates->RemoveAll();
+    pParts->RemoveAll();
+
+    if ( pStringTable->IsEmpty() )
+    {
+        return;     // Nothing to do
+    }
+
+    // Find the range of ids
+    pStringTable->Rewind();
+    do
+    {
+        pElement = pStringTable->GetPointer();
+        if ( pElement && pElement->id && ( pElement->id <= MAX_STRING_ID ) )
+        {
+            minID = PXSMinUInt32( minID, pElement->id );
+            maxID = PXSMaxUInt32( maxID, pElement->id );
+        }
+    } while ( pStringTable->Advance() );
+
+    if ( maxID < minID )
+    {
+        return;     // No usable ids
+    }
+    pTemplates->SetSize( maxID - minID + 1 );
+    *pFirstStringID = minID;
+
+    // Split each string at its placeholders
+    pStringTable->Rewind();
+    do
+    {
+        pElement = pStringTable->GetPointer();
+        if ( pElement && ( pElement->id >= minID ) && ( pElement->id <= maxID ) )
+        {
+            Template.firstPart = pParts->GetSize();
+            Template.numParts  = 0;
+            Template.Text      = pElement->Text;
+            pszText  = pElement->Text.c_str();
+            numChars = pElement->Text.GetLength();
+            start    = 0;
+            i        = 0;
+            while ( PXSAddSizeT( i, 2 ) < numChars )
+            {
+                if ( ( pszText[ i     ] == '%' ) &&
+                     ( pszText[ i + 1 ] == '%' ) &&
+                     ( pszText[ i + 2 ] >= '1' ) && ( pszText[ i + 2 ] <= '3' ) )
+                {
+                    Part.offset = start;
+                    Part.length = i - start;
+                    Part.insert = static_cast<size_t>( pszText[ i + 2 ] - '0' );
+                    pParts->Add( Part );
+                    Template.numParts++;
+                    i    += 3;
+                    start = i;
+                }
+                else
+                {
+                    i++;
+                }
+            }
+
+            if ( start < numChars )
+            {
+                Part.offset = start;
+                Part.length = numChars - start;
+                Part.insert = 0;
+                pParts->Add( Part );
+                Template.numParts++;
+            }
+            pTemplates->Set( pElement->id - minID, Template );
+        }
+    } while ( pStringTable->Advance() );
+}
+
 //===============================================================================================//
 //  Description:
 //      Merge the specified string tables with the output placed in Table2
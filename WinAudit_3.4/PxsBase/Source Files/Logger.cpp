@@ -61,11 +61,17 @@
 // Default constructor, an empty logging object
 //
 Logger::Logger()
-       :m_bLogging( false ),
+       :MAX_LOG_MESSAGES( 10000 ),
+        WRITE_BUFFER_CHARS( 0x4000 ),
+        WRITE_INTERVAL_MS( 2000 ),
+        m_bLogging( false ),
         m_bWantComputerName( false ),
         m_bWritingEntry( false ),
         m_File(),
+        m_idxOldestMessage( 0 ),
+        m_uLastWriteTicks( 0 ),
         m_FilePath(),
+        m_WriteBuffer(),
         m_LogMessages()
 {
 }
@@ -128,13 +134,17 @@ void Logger::AppendComment( LPCWSTR pszComment )
 //  Parameters:
 //      None
 //
+//  Remarks:
+//      Writes any buffered text before flushing the file.
+//
 //  Returns:
 //      void
 //===============================================================================================//
-void Logger::Flush() const
+void Logger::Flush()
 {
     try
     {
+        WriteBuffer();
         m_File.Flush();
     }
     catch ( const Exception& )
@@ -163,6 +173,9 @@ bool Logger::IsStarted() const
 //  Parameters:
 //      pLogMessages - receives the log messages
 //
+//  Remarks:
+//      The messages are returned oldest first.
+//
 //  Returns:
 //      void
 //===============================================================================================//
@@ -170,9 +183,25 @@ void Logger::GetLogMessages( StringArray* pLogMessages ) const
 {
     try
     {
-        if ( pLogMessages )
+        if ( pLogMessages == nullptr )
+        {
+            return;
+        }
+
+        if ( m_idxOldestMessage == 0 )
         {
             *pLogMessages = m_LogMessages;
+            return;
+        }
+
+        // The ring has wrapped
+        size_t numMessages = m_LogMessages.GetSize();
+        pLogMessages->RemoveAll();
+        pLogMessages->SetSize( numMessages );
+        for ( size_t i = 0; i < numMessages; i++ )
+        {
+            size_t idxRing = ( m_idxOldestMessage + i ) % numMessages;
+            pLogMessages->Set( i, m_LogMessages.Get( idxRing ) );
         }
     }
     catch ( const Exception& )
@@ -207,6 +236,7 @@ const String& Logger::GetPath() const
 void Logger::PurgeLogMessages()
 {
     m_LogMessages.RemoveAll();
+    m_idxOldestMessage = 0;
 }
 
 //===============================================================================================//
@@ -332,6 +362,7 @@ void Logger::Stop()
 
         Line = L"!\r\n!Logging stopped.\r\n!";
         WriteText( Line );
+        WriteBuffer();
         m_File.Close();
         m_bLogging = false;
     }
@@ -655,6 +686,38 @@ void Logger::WriteSystemDiagnosticData( bool wantExtraInfo )
     { }     // Ignore
 }
 
+//===============================================================================================//
+//  Description:
+//      Write the buffered text to the log file
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void Logger::WriteBuffer()
+{
+    m_uLastWriteTicks = GetTickCount();
+    if ( m_WriteBuffer.IsEmpty() )
+    {
+        return;
+    }
+
+    try
+    {
+        if ( m_File.IsOpen() )
+        {
+            m_File.WriteChars( m_WriteBuffer );
+        }
+    }
+    catch ( const Exception& )
+    { }     // Ignore
+
+    // Discard the text even on error, otherwise the buffer grows unbounded
+    m_WriteBuffer.Zero();
+}
+
 //===============================================================================================//
 //  Description:
 //      Write the specified line to the log file and/or string array
@@ -662,13 +725,16 @@ void Logger::WriteSystemDiagnosticData( bool wantExtraInfo )
 //  Parameters:
 //      Text - the line to write
 //
+//  Remarks:
+//      The file output is buffered, it is written when the buffer is full or
+//      the previous write was more than WRITE_INTERVAL_MS ago. Once the
+//      string array is full, the oldest message is overwritten.
+//
 //  Returns:
 //      void
 //===============================================================================================//
 void Logger::WriteText( const String& Text )
 {
-    String NewLine;
-
     if ( ( m_bLogging == false ) || ( Text.IsEmpty() ) )
     {
         return;
@@ -678,11 +744,28 @@ void Logger::WriteText( const String& Text )
     {
         if ( m_File.IsOpen() )
         {
-            m_File.WriteChars( Text );
-            NewLine = PXS_STRING_CRLF;
-            m_File.WriteChars( NewLine );
+            if ( m_WriteBuffer.IsEmpty() )
+            {
+                m_WriteBuffer.Allocate( WRITE_BUFFER_CHARS );
+            }
+            m_WriteBuffer += Text;
+            m_WriteBuffer += PXS_STRING_CRLF;
+            if ( ( m_WriteBuffer.GetLength() >= WRITE_BUFFER_CHARS ) ||
+                 ( ( GetTickCount() - m_uLastWriteTicks ) >= WRITE_INTERVAL_MS ) )
+            {
+                WriteBuffer();
+            }
+        }
+
+        if ( m_LogMessages.GetSize() < MAX_LOG_MESSAGES )
+        {
+            m_LogMessages.Add( Text );
+        }
+        else
+        {
+            m_LogMessages.Set( m_idxOldestMessage, Text.c_str() );
+            m_idxOldestMessage = ( m_idxOldestMessage + 1 ) % MAX_LOG_MESSAGES;
         }
-        m_LogMessages.Add( Text );
     }
     catch ( const Exception& )
     { }     // Ignore
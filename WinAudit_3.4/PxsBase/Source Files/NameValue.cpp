@@ -210,6 +210,22 @@ void NameValue::SetNameValue( const String& Name, const String& Value )
     m_Value = Value;
 }
 
+//===============================================================================================//
+//  Description:
+//      Exchange the name and value with another pair
+//
+//  Parameters:
+//      Other - the pair to swap with
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void NameValue::Swap( NameValue& Other )
+{
+    m_Name.Swap( Other.m_Name );
+    m_Value.Swap( Other.m_Value );
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Protected Methods
 ///////////////////////////////////////////////////////////////////////////////////////////////////
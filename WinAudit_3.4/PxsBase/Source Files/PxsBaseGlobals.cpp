@@ -77,6 +77,7 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 static LONG m_lExceptionCount = 0;  // Count of fatal exceptions
+static LONG m_lLoggedExceptions = 0;  // Count of exceptions passed to PXSLogException
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Global Functions
@@ -1938,6 +1939,70 @@ void PXSColourRefToHtmlColour( COLORREF colour, String* pHtmlColour )
     *pHtmlColour = szHtmlColour;
 }
 
+//===============================================================================================//
+//  Description:
+//      Compare two sort keys according to their type
+//
+//  Parameters:
+//      pszKey1 - key one
+//      pszKey2 - key two
+//      keyType - a PXS_SORT_KEY_xxx constant
+//
+//  Remarks:
+//      Version keys compare runs of digits by value so that "1.10" sorts
+//      after "1.9". Keys that compare equal fall back to a string comparison
+//      so the ordering is total. NULL is treated as an empty string.
+//
+//  Returns:
+//      -ve if pszKey1 < pszKey2
+//        0 if pszKey1 = pszKey2
+//      +ve if pszKey1 > pszKey2
+//===============================================================================================//
+int PXSCompareSortKey( LPCWSTR pszKey1, LPCWSTR pszKey2, DWORD keyType )
+{
+    if ( pszKey1 == nullptr ) pszKey1 = PXS_STRING_EMPTY;
+    if ( pszKey2 == nullptr ) pszKey2 = PXS_STRING_EMPTY;
+
+    if ( keyType == PXS_SORT_KEY_VERSION )
+    {
+        LPCWSTR p1 = pszKey1, p2 = pszKey2;
+        while ( *p1 && *p2 )
+        {
+            if ( ( *p1 >= '0' ) && ( *p1 <= '9' ) && ( *p2 >= '0' ) && ( *p2 <= '9' ) )
+            {
+                // Compare the runs of digits by value, saturate on overflow
+                UINT64 value1 = 0, value2 = 0;
+                while ( ( *p1 >= '0' ) && ( *p1 <= '9' ) )
+                {
+                    value1 = ( value1 > ( UINT64_MAX - 9 ) / 10 ) ?
+                                                 UINT64_MAX : ( value1 * 10 ) + ( *p1 - '0' );
+                    p1++;
+                }
+                while ( ( *p2 >= '0' ) && ( *p2 <= '9' ) )
+                {
+                    value2 = ( value2 > ( UINT64_MAX - 9 ) / 10 ) ?
+                                                 UINT64_MAX : ( value2 * 10 ) + ( *p2 - '0' );
+                    p2++;
+                }
+                if ( value1 < value2 ) return -1;
+                if ( value1 > value2 ) return  1;
+            }
+            else
+            {
+                wchar_t ch1 = towupper( *p1 );
+                wchar_t ch2 = towupper( *p2 );
+                if ( ch1 < ch2 ) return -1;
+                if ( ch1 > ch2 ) return  1;
+                p1++;
+                p2++;
+            }
+        }
+        if ( *p1 ) return  1;
+        if ( *p2 ) return -1;
+    }
+    return PXSCompareString( pszKey1, pszKey2, false );
+}
+
 //===============================================================================================//
 //  Description:
 //      Compare two strings
@@ -2801,6 +2866,26 @@ size_t PXSGetHtmlCharacterEntity( wchar_t ch, wchar_t* pszBuffer, size_t bufChar
     return numCopied;
 }
 
+//===============================================================================================//
+//  Description:
+//      Get the number of exceptions that have been logged
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      Exceptions are counted whether or not the log is running so callers
+//      can tell if anything went wrong while they were busy. The count is for
+//      the process, not the thread.
+//
+//  Returns:
+//      the count, wraps around
+//===============================================================================================//
+DWORD PXSGetNumberOfLoggedExceptions()
+{
+    return static_cast<DWORD>( InterlockedCompareExchange( &m_lLoggedExceptions, 0, 0 ) );
+}
+
 //===============================================================================================//
 //  Description:
 //      Get a string based on its ID
@@ -5023,10 +5108,6 @@ void PXSLogException( const Exception& e, const char* function )
 {
     try
     {
-        if ( PXSIsAppLogging() == false )
-        {
-            return;
-        }
         PXSLogException( nullptr, e, function );
     }
     catch ( const Exception& )
@@ -5043,7 +5124,7 @@ void PXSLogException( const Exception& e, const char* function )
 //      function   - the function logging the exception
 //
 //   Remarks:
-//       Does not throw
+//       Does not throw. The exception is counted even if not logging.
 //
 //  Returns:
 //      void
@@ -5052,6 +5133,7 @@ void PXSLogException( LPCWSTR message, const Exception& e, const char* function
 {
     String LogMessage, FunctionName, Insert1, Insert2;
 
+    InterlockedIncrement( &m_lLoggedExceptions );
     try
     {
         if ( PXSIsAppLogging() == false )
@@ -6466,75 +6548,6 @@ bool PXSPromptForFilePath( HWND    hWndOwner,
     return true;
 }
 
-//===============================================================================================//
-//  Description:
-//      Callback for qsort for a case insensitive ascending string comparison
-//
-//  Parameters:
-//      pArg1 - pointer to string 1
-//      pArg2 - pointer to string 2
-//
-//  Returns:
-//      > 0  if arg1 greater than arg2
-//      = 0  if arg1 equivalent to arg2
-//      < 0  if arg1 less than arg2
-//===============================================================================================//
-int PXSQSortStringAscending( const void* pArg1, const void* pArg2 )
-{
-    return PXSCompareString( static_cast<LPCWSTR>( pArg1 ),
-                             static_cast<LPCWSTR>( pArg2 ), false );
-}
-
-//===============================================================================================//
-//  Description:
-//      Callback for qsort for a case insensitive descending string comparison
-//
-//  Parameters:
-//      pArg1 - pointer to string 1
-//      pArg2 - pointer to string 2
-//
-//  Returns:
-//      < 0  if arg1 less than arg2
-//      = 0  if arg1 equivalent to arg2
-//      > 0  if arg1 greater than arg2
-//===============================================================================================//
-int PXSQSortStringDescending( const void* pArg1, const void* pArg2 )
-{
-    return -PXSQSortStringAscending( pArg1, pArg2 );
-}
-
-//===============================================================================================//
-//  Description:
-//      Callback for qsort for a case insensitive ascending sort of a two
-//      PXS_TYPE_STRING_STRING structures. Only sorts on the first string.
-//
-//  Parameters:
-//      pArg1 - pointer to string 1
-//      pArg2 - pointer to string 2
-//
-//  Returns:
-//      > 0  if arg1 greater than arg2
-//      = 0  if arg1 equivalent to arg2
-//      < 0  if arg1 less than arg2
-//===============================================================================================//
-int PXSQSortStringStringAscending( const void* pArg1, const void* pArg2 )
-{
-    LPCWSTR pszOne  = nullptr;
-    LPCWSTR pszTwo  = nullptr;
-
-    // Compare on first string (pszString1) of each structure
-    if ( pArg1 )
-    {
-        pszOne = ( (const PXS_TYPE_STRING_STRING*)pArg1 )->pszString1;
-    }
-
-    if ( pArg2 )
-    {
-        pszTwo = ( (const PXS_TYPE_STRING_STRING*)pArg2 )->pszString1;
-    }
-    return PXSCompareString( pszOne, pszTwo, false );
-}
-
 //===============================================================================================//
 //  Description:
 //      Replace a colour in a bitmap with the specified new one.
@@ -6731,19 +6744,41 @@ void PXSShowExceptionDialog( const Exception& e, HWND hWndOwner )
 
 //===============================================================================================//
 //  Description:
-//     Sort a Name-Value array on the names
+//      Callback for PXSStableSortIndexes to compare the names in a name/value array
+//
+//  Parameters:
+//      index1   - index of the first element
+//      index2   - index of the second element
+//      pContext - pointer to the TArray< NameValue > being sorted
+//
+//  Returns:
+//      -ve, 0 or +ve for a case insensitive comparison of the names
+//===============================================================================================//
+static int PXSSortIndexCompareNameValue( size_t index1, size_t index2, const void* pContext )
+{
+    const TArray< NameValue >* pNameValues = static_cast<const TArray< NameValue >*>( pContext );
+
+    return PXSCompareString( pNameValues->Get( index1 ).GetName().c_str(),
+                             pNameValues->Get( index2 ).GetName().c_str(), false );
+}
+
+//===============================================================================================//
+//  Description:
+//      Sort an array of name value pairs in ascending order on the name
 //
 //  Parameters:
-//      pNameValues - the array to sort
+//      pNameValues - the name/value pairs
+//
+//  Remarks:
+//      The sort is stable and the elements are swapped into place, no
+//      strings are copied.
 //
 //  Returns:
 //      void
 //===============================================================================================//
 void PXSSortNameValueArray( TArray< NameValue >* pNameValues )
 {
-    String    Name, Value;
-    NameValue Element;
-    TArray< NameValue > SortedArray;
+    AllocateBytes AllocBytes;
 
     if ( pNameValues == nullptr )
     {
@@ -6751,45 +6786,120 @@ void PXSSortNameValueArray( TArray< NameValue >* pNameValues )
     }
 
     size_t numElements = pNameValues->GetSize();
-    if ( numElements < 1 )
+    if ( numElements < 2 )
     {
         return;     // Nothing to do
     }
 
-    PXS_TYPE_STRING_STRING* pArray = new PXS_TYPE_STRING_STRING[ numElements ];
-    if ( pArray == nullptr )
+    size_t  numBytes = PXSMultiplySizeT( numElements, sizeof ( size_t ) );
+    size_t* pOrder   = reinterpret_cast<size_t*>( AllocBytes.New( numBytes ) );
+    for ( size_t i = 0; i < numElements; i++ )
     {
-        throw MemoryException( __FUNCTION__ );
+        pOrder[ i ] = i;
     }
+    PXSStableSortIndexes( pOrder, numElements, PXSSortIndexCompareNameValue, pNameValues );
+    pNameValues->Permute( pOrder, numElements );
+}
 
-    try
+//===============================================================================================//
+//  Description:
+//      Stable sort of an array of indexes using a caller supplied comparison
+//
+//  Parameters:
+//      pIndexes   - the indexes to sort, usually 0 to numIndexes - 1
+//      numIndexes - the number of indexes
+//      pfnCompare - callback to compare the elements at two indexes
+//      pContext   - passed through to the callback
+//
+//  Remarks:
+//      Elements that compare equal keep their relative order so can sort
+//      on several keys by comparing each in turn. Short runs are insertion
+//      sorted then merged bottom-up through a scratch buffer, so the cost
+//      is O(n log n) comparisons whatever the input order. Only the indexes
+//      move, the caller applies the order to its data, e.g. TArray::Permute.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void PXSStableSortIndexes( size_t* pIndexes, size_t numIndexes,
+                           PXS_SORT_INDEX_COMPARE pfnCompare, const void* pContext )
+{
+    const size_t  RUN_LENGTH = 16;
+    AllocateBytes AllocBytes;
+
+    if ( ( pIndexes == nullptr ) || ( pfnCompare == nullptr ) )
+    {
+        throw ParameterException( L"pIndexes/pfnCompare", __FUNCTION__ );
+    }
+
+    if ( numIndexes < 2 )
     {
-        for ( size_t i = 0; i < numElements; i++ )
+        return;     // Nothing to do
+    }
+
+    // Insertion sort the runs
+    for ( size_t start = 0; start < numIndexes; start += RUN_LENGTH )
+    {
+        size_t end = PXSMinSizeT( start + RUN_LENGTH, numIndexes );
+        for ( size_t i = start + 1; i < end; i++ )
         {
-            // Get the first field of the record
-            pArray[ i ].pszString1 = pNameValues->Get( i ).GetName().c_str();
-            pArray[ i ].pszString2 = pNameValues->Get( i ).GetValue().c_str();
+            size_t index = pIndexes[ i ];
+            size_t j     = i;
+            while ( ( j > start ) && ( pfnCompare( pIndexes[ j - 1 ], index, pContext ) > 0 ) )
+            {
+                pIndexes[ j ] = pIndexes[ j - 1 ];
+                j--;
+            }
+            pIndexes[ j ] = index;
         }
-        qsort( pArray,
-               numElements, sizeof ( PXS_TYPE_STRING_STRING ), PXSQSortStringStringAscending );
+    }
 
-        // Replace
-        SortedArray.SetSize( numElements );
-        for ( size_t i = 0; i < numElements; i++ )
+    if ( numIndexes <= RUN_LENGTH )
+    {
+        return;     // Single run
+    }
+
+    // Merge pairs of runs, alternating between the input and the buffer
+    size_t  numBytes = PXSMultiplySizeT( numIndexes, sizeof ( size_t ) );
+    size_t* pSource  = pIndexes;
+    size_t* pTarget  = reinterpret_cast<size_t*>( AllocBytes.New( numBytes ) );
+    for ( size_t width = RUN_LENGTH; width < numIndexes; width = PXSMultiplySizeT( width, 2 ) )
+    {
+        for ( size_t left = 0; left < numIndexes; left += ( 2 * width ) )
         {
-            Name  = pArray[ i ].pszString1;     // false positive C6385 with /analyze
-            Value = pArray[ i ].pszString2;
-            Element.SetNameValue( Name, Value );
-            SortedArray.Set( i, Element );
+            size_t middle = PXSMinSizeT( left + width, numIndexes );
+            size_t right  = PXSMinSizeT( middle + width, numIndexes );
+            size_t i = left, j = middle, k = left;
+            while ( ( i < middle ) && ( j < right ) )
+            {
+                // On a tie take from the left run to keep the sort stable
+                if ( pfnCompare( pSource[ j ], pSource[ i ], pContext ) < 0 )
+                {
+                    pTarget[ k++ ] = pSource[ j++ ];
+                }
+                else
+                {
+                    pTarget[ k++ ] = pSource[ i++ ];
+                }
+            }
+            while ( i < middle )
+            {
+                pTarget[ k++ ] = pSource[ i++ ];
+            }
+            while ( j < right )
+            {
+                pTarget[ k++ ] = pSource[ j++ ];
+            }
         }
-        *pNameValues = SortedArray;
+        size_t* pSwap = pSource;
+        pSource = pTarget;
+        pTarget = pSwap;
     }
-    catch ( const Exception& )
+
+    if ( pSource != pIndexes )
     {
-        delete [] pArray;
-        throw;
+        memcpy( pIndexes, pSource, numBytes );
     }
-    delete [] pArray;
 }
 
 //===============================================================================================//
@@ -605,6 +605,125 @@ void Registry::GetSubKeyList( LPCWSTR pszSubKey, StringArray* pSubKeyList ) cons
     RegCloseKey(hKey);
 }
 
+//===============================================================================================//
+//  Description:
+//      Get the subkeys of a registry key together with their last write times
+//
+//  Parameters:
+//      pszSubKey       - pointer to registry subkey name, can be NULL
+//      pSubKeyList     - array to receive the subkeys
+//      pLastWriteTimes - array to receive the last write time of each
+//                        subkey as a FILETIME value, zero if not available
+//
+//  Remarks:
+//      Will avoid throwing on registry operation error. A key that does not
+//      exist is not logged as callers use this to test for changes to keys
+//      that may not be present.
+//
+//  Returns:
+//      The last write time of the key as a FILETIME value, zero if the key
+//      could not be read
+//===============================================================================================//
+UINT64 Registry::GetSubKeyWriteTimes( LPCWSTR pszSubKey,
+                                      StringArray* pSubKeyList,
+                                      TArray< UINT64 >* pLastWriteTimes ) const
+{
+    HKEY     hKey     = nullptr;
+    DWORD    cSubKeys = 0;
+    UINT64   lastWriteTime = 0;
+    String   Key, Insert1, Insert2;
+    FILETIME ftLastWrite;
+
+    if ( m_hKey == nullptr )
+    {
+        throw FunctionException( L"m_hKey", __FUNCTION__ );
+    }
+
+    if ( ( pSubKeyList == nullptr ) || ( pLastWriteTimes == nullptr ) )
+    {
+        throw ParameterException( L"pSubKeyList/pLastWriteTimes", __FUNCTION__ );
+    }
+    pSubKeyList->RemoveAll();
+    pLastWriteTimes->RemoveAll();
+
+    // Open the key for read access
+    LONG result = RegOpenKeyEx( m_hKey, pszSubKey, 0, KEY_READ, &hKey );
+    if ( result != ERROR_SUCCESS )
+    {
+        if ( result != ERROR_FILE_NOT_FOUND )
+        {
+            Insert1 = pszSubKey;
+            Insert2.SetAnsi( __FUNCTION__ );
+            PXSLogSysWarn2( static_cast<DWORD>( result ),
+                            L"RegOpenKeyEx for '%%1' in '%%2'.", Insert1, Insert2 );
+        }
+        return 0;
+    }
+
+    memset( &ftLastWrite, 0, sizeof ( ftLastWrite ) );
+    result = RegQueryInfoKey( hKey,
+                              nullptr,
+                              nullptr,
+                              nullptr,
+                              &cSubKeys,
+                              nullptr,
+                              nullptr,
+                              nullptr, nullptr, nullptr, nullptr, &ftLastWrite );
+    if ( result != ERROR_SUCCESS )
+    {
+        RegCloseKey( hKey );
+        Insert1 = pszSubKey;
+        Insert2.SetAnsi( __FUNCTION__ );
+        PXSLogSysError2( static_cast<DWORD>( result ),
+                         L"RegQueryInfoKey error '%%1' in '%%2'.", Insert1, Insert2 );
+        return 0;
+    }
+    lastWriteTime = ( static_cast<UINT64>( ftLastWrite.dwHighDateTime ) << 32 ) |
+                      ftLastWrite.dwLowDateTime;
+
+    //  Catch exceptions to clean up
+    try
+    {
+        wchar_t wzName[ MAX_PATH + 1 ] = { 0 };
+
+        for ( DWORD i = 0; i < cSubKeys ; i++ )
+        {
+            memset( wzName, 0, sizeof ( wzName ) );
+            memset( &ftLastWrite, 0, sizeof ( ftLastWrite ) );
+            DWORD cName = ARRAYSIZE( wzName );
+            result = RegEnumKeyEx( hKey,
+                                   i,
+                                   wzName,
+                                   &cName,  // In chars
+                                   nullptr, nullptr, nullptr, &ftLastWrite );
+            if ( result == ERROR_SUCCESS )
+            {
+                wzName[ ARRAYSIZE( wzName ) - 1 ] = PXS_CHAR_NULL;
+                Key = wzName;
+                pSubKeyList->Add( Key );
+                pLastWriteTimes->Add( ( static_cast<UINT64>( ftLastWrite.dwHighDateTime ) << 32 ) |
+                                        ftLastWrite.dwLowDateTime );
+            }
+            else
+            {
+                // Log it and continue
+                Insert1 = pszSubKey;
+                Insert2.SetAnsi( __FUNCTION__ );
+                PXSLogSysWarn2( static_cast<DWORD>( result ),
+                                L"RegEnumKeyEx at '%%1' in '%%2'.", Insert1, Insert2 );
+            }
+        }
+    }
+    catch ( const Exception& )
+    {
+        RegCloseKey(hKey);
+        throw;
+    }
+    RegCloseKey(hKey);
+
+    return lastWriteTime;
+}
+
 //===============================================================================================//
 //  Description:
 //      Get a value in the registry as a string
@@ -165,14 +165,17 @@ void RichEditBox::AddToEventMask( LPARAM events )
 //      RichText - the rich text
 //
 //  Remarks:
+//      The returned position is where the appended text starts, callers
+//      can keep it to go straight to that text later.
 //
 //  Returns:
-//      void
+//      LONG character position at which the text was inserted
 //===============================================================================================//
-void RichEditBox::AppendRichText( const String& RichText )
+LONG RichEditBox::AppendRichText( const String& RichText )
 {
     size_t     numChars = 0;
     Formatter  Format;
+    CHARRANGE  cr;
     EDITSTREAM es;
 
     if ( m_hWindow == nullptr )
@@ -180,9 +183,13 @@ void RichEditBox::AppendRichText( const String& RichText )
         throw FunctionException( L"m_hWindow", __FUNCTION__ );
     }
 
+    // Set selection at end, this is where the text will go
+    memset( &cr, 0, sizeof ( cr ) );
+    SendMessage( m_hWindow, EM_SETSEL, (WPARAM)-1, -1 );
+    SendMessage( m_hWindow, EM_EXGETSEL, 0, (LPARAM)&cr );
     if ( RichText.IsEmpty() )
     {
-        return;     // nothing to do
+        return cr.cpMin;    // nothing to do
     }
 
     // Reset the stream in buffer string
@@ -207,13 +214,14 @@ void RichEditBox::AppendRichText( const String& RichText )
     es.dwCookie    = reinterpret_cast<DWORD_PTR>( this );
     es.dwError     = 0;
     es.pfnCallback = PXSRichEditStreamInCallback;
-    SendMessage( m_hWindow, EM_SETSEL, (WPARAM)-1, -1);  // Set selection at end
     SendMessage( m_hWindow, EM_STREAMIN, SF_RTF | SFF_SELECTION, (LPARAM)&es );
     if ( es.dwError )
     {
         // Not necessarily a system error but will assume it is
         throw SystemException( es.dwError, L"EM_STREAMIN", __FUNCTION__ );
     }
+
+    return cr.cpMin;
 }
 
 //===============================================================================================//
@@ -320,6 +328,61 @@ bool RichEditBox::FindText( const String& Text,
     return found;
 }
 
+//===============================================================================================//
+//  Description:
+//      Find the specified text searching forward from a known position
+//
+//  Parameters:
+//      Text          - the text to search for
+//      caseSensitive - true if want a case sensitive search
+//      position      - zero-based character position at which to start
+//
+//  Remarks:
+//      Used when the caller already knows where the text is, e.g. an offset
+//      returned by AppendRichText, so the search stops almost at once and
+//      cannot land on an earlier occurrence of the same text.
+//
+//  Returns:
+//      true if found the text otherwise false
+//===============================================================================================//
+bool RichEditBox::FindTextFrom( const String& Text, bool caseSensitive, LONG position )
+{
+    WPARAM    wParam  = FR_DOWN;
+    LRESULT   lResult = 0;
+    FINDTEXT  ft;
+
+    if ( m_hWindow == nullptr )
+    {
+        return false;   // Nothing to do or error
+    }
+
+    if ( Text.IsEmpty() || ( position < 0 ) )
+    {
+        return false;   // Nothing to do
+    }
+
+    if ( caseSensitive )
+    {
+        wParam |= FR_MATCHCASE;
+    }
+    ft.chrg.cpMin = position;
+    ft.chrg.cpMax = -1;
+    ft.lpstrText  = Text.c_str();
+    lResult = SendMessage( m_hWindow, EM_FINDTEXT, wParam, (LPARAM)&ft );
+    if ( lResult == -1 )
+    {
+        return false;
+    }
+
+    // Scroll to the text, as for FindText set the selection at the end first
+    // so that the text is shown at the top of the window.
+    LPARAM lParam = lResult + PXSCastSizeTToInt32( Text.GetLength() );
+    SendMessage( m_hWindow, EM_SETSEL, (WPARAM)-1, -1 );
+    SendMessage( m_hWindow, EM_SETSEL, (WPARAM)lResult, lParam );
+
+    return true;
+}
+
 //===============================================================================================//
 //  Description:
 //      Determine if any the text is selected
@@ -64,11 +64,11 @@
 
 // Default constructor
 String::String()
-       :MINIMUM_ALLOCATION( 32 ),
-        m_uLengthChars( 0 ),
+       :m_uLengthChars( 0 ),
         m_uCharsAllocated( 0 ),
         m_pwzString( nullptr )
 {
+    m_szInline[ 0 ] = PXS_CHAR_NULL;
 }
 
 // Copy constructor
@@ -79,14 +79,18 @@ String::String( const String& oString )
     *this = oString;
 }
 
+// Move constructor
+String::String( String&& oString )
+       :String()
+{
+    Swap( oString );
+}
+
 // Destructor
 String::~String()
 {
     // Clean up
-    if ( m_pwzString )
-    {
-        delete[] m_pwzString;
-    }
+    FreeBuffer();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -98,7 +102,40 @@ String& String::operator=( const String& oString )
 {
     if ( this == &oString ) return *this;
 
-    *this = oString.m_pwzString;
+    // Preserve NULL or ""
+    if ( oString.m_pwzString == nullptr )
+    {
+        SetNull();
+        return *this;
+    }
+
+    if ( oString.m_uLengthChars == 0 )
+    {
+        SetEmpty();
+        return *this;
+    }
+
+    // The length is known so copy without scanning for the terminator. If
+    // the buffer is too small there is no need to keep the old characters.
+    if ( oString.m_uLengthChars >= m_uCharsAllocated )
+    {
+        Delete();
+    }
+    Allocate( PXSAddSizeT( oString.m_uLengthChars, 1 ) );
+    wmemcpy( m_pwzString, oString.m_pwzString, oString.m_uLengthChars );
+    m_uLengthChars = oString.m_uLengthChars;
+    m_pwzString[ m_uLengthChars ] = PXS_CHAR_NULL;
+
+    return *this;
+}
+
+// Move assignment operator
+String& String::operator= ( String&& oString )
+{
+    if ( this == &oString ) return *this;
+
+    Delete();
+    Swap( oString );
 
     return *this;
 }
@@ -136,11 +173,11 @@ String& String::operator= ( LPCWSTR pszString )
         return *this;
     }
 
-    // See if can put into the existing buffer
+    // See if can put into the existing buffer, pszString may be part of it
     charsNeeded = wcslen( pszString );
     charsNeeded = PXSAddSizeT( charsNeeded, 1 );    // Null terminator
     Allocate( charsNeeded );
-    PXSStringCchCopy( m_pwzString, charsNeeded, pszString, __FUNCTION__ );
+    wmemmove( m_pwzString, pszString, charsNeeded );
     m_uLengthChars = charsNeeded - 1;
 
     return *this;
@@ -185,6 +222,9 @@ String& String::operator+= ( wchar_t ch )
 //      Has no effect if the requested size numChars is smaller that the
 //      amount currently allocated.
 //      Any existing string is preserved.
+//      A null string uses the inline buffer if the request fits, otherwise
+//      only the existing characters and the terminator are written to the
+//      new buffer, the remainder is not zeroed.
 //
 //  Returns:
 //      void
@@ -198,6 +238,14 @@ void String::Allocate( size_t numChars )
         return;     // Nothing to do
     }
 
+    if ( ( m_pwzString == nullptr ) && ( numChars <= INLINE_CHARS ) )
+    {
+        m_szInline[ 0 ]   = PXS_CHAR_NULL;
+        m_pwzString       = m_szInline;
+        m_uCharsAllocated = INLINE_CHARS;
+        return;
+    }
+
     // Will grow the string by 50% more than requested amount
     numChars = PXSMultiplySizeT( numChars, 3 ) / 2;
     if ( numChars < MINIMUM_ALLOCATION )    // Enforce a minimum
@@ -209,21 +257,16 @@ void String::Allocate( size_t numChars )
     {
         throw MemoryException( __FUNCTION__ );
     }
-    wmemset( pszNew, 0, numChars );
 
-    // Copy in any existing string
+    // Copy in any existing string, its length is less than numChars
     if ( m_pwzString )
     {
-        HRESULT hr = StringCchCopy( pszNew, numChars, m_pwzString );
-        if ( FAILED( hr ) )
-        {
-            delete [] pszNew;
-            throw ComException( hr, L"StringCchCopy", __FUNCTION__ );
-        }
+        wmemcpy( pszNew, m_pwzString, m_uLengthChars );
     }
+    pszNew[ m_uLengthChars ] = PXS_CHAR_NULL;
 
     // Replace
-    delete[] m_pwzString;
+    FreeBuffer();
     m_pwzString       = pszNew;
     m_uCharsAllocated = numChars;
 }
@@ -527,13 +570,8 @@ size_t String::CountOfChar( wchar_t wch ) const
 //===============================================================================================//
 void String::Delete()
 {
-    if ( m_pwzString )
-    {
-        delete[] m_pwzString;
-    }
-    m_pwzString       = nullptr;
-    m_uLengthChars    = 0;
-    m_uCharsAllocated = 0;
+    FreeBuffer();
+    m_uLengthChars = 0;
 }
 
 //===============================================================================================//
@@ -689,7 +727,7 @@ void String::EscapeForHtml()
     pszNew[ numAllocated - 1 ] = PXS_CHAR_NULL;
 
     // Replace
-    delete[] m_pwzString;
+    FreeBuffer();
     m_pwzString = pszNew;
     m_uCharsAllocated = numAllocated;
     m_uLengthChars    = idx;
@@ -780,7 +818,7 @@ void String::EscapeForRichText()
     pszNew[ numAllocated - 1 ] = PXS_CHAR_NULL;
 
     // Replace
-    delete[] m_pwzString;
+    FreeBuffer();
     m_pwzString = pszNew;
     m_uCharsAllocated = numAllocated;
     m_uLengthChars    = idx;
@@ -1375,7 +1413,7 @@ size_t String::ReplaceI( LPCWSTR pszOld, LPCWSTR pszNew )
     }
 
     // Replace
-    delete[]  m_pwzString;
+    FreeBuffer();
     m_pwzString       = pszReplace;
     m_uLengthChars    = wcslen( m_pwzString );
     m_uCharsAllocated = numCharsReplace;
@@ -1745,7 +1783,8 @@ void String::SetEmpty()
     {
         Allocate( 1 );
     }
-    Zero();
+    m_pwzString[ 0 ] = PXS_CHAR_NULL;
+    m_uLengthChars   = 0;
 }
 
 //===============================================================================================//
@@ -1925,6 +1964,59 @@ void String::SubString( size_t start, size_t length, String* pSub ) const
     }
 }
 
+//===============================================================================================//
+//  Description:
+//      Exchange the contents of this string with another
+//
+//  Parameters:
+//      Other - the string to swap with
+//
+//  Remarks:
+//      Heap buffers are exchanged, only inline strings are copied
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void String::Swap( String& Other )
+{
+    bool     thisInline     = ( m_pwzString == m_szInline );
+    bool     otherInline    = ( Other.m_pwzString == Other.m_szInline );
+    size_t   lengthChars    = m_uLengthChars;
+    size_t   charsAllocated = m_uCharsAllocated;
+    wchar_t* pwzString      = m_pwzString;
+    wchar_t  szInline[ INLINE_CHARS ];
+
+    if ( this == &Other )
+    {
+        return;
+    }
+
+    if ( thisInline || otherInline )
+    {
+        wmemcpy( szInline, m_szInline, INLINE_CHARS );
+        wmemcpy( m_szInline, Other.m_szInline, INLINE_CHARS );
+        wmemcpy( Other.m_szInline, szInline, INLINE_CHARS );
+    }
+
+    m_uLengthChars          = Other.m_uLengthChars;
+    m_uCharsAllocated       = Other.m_uCharsAllocated;
+    m_pwzString             = Other.m_pwzString;
+    Other.m_uLengthChars    = lengthChars;
+    Other.m_uCharsAllocated = charsAllocated;
+    Other.m_pwzString       = pwzString;
+
+    // Inline strings must point at their new owner's buffer
+    if ( otherInline )
+    {
+        m_pwzString = m_szInline;
+    }
+
+    if ( thisInline )
+    {
+        Other.m_pwzString = Other.m_szInline;
+    }
+}
+
 //===============================================================================================//
 //  Description:
 //      Break up a string into tokens that are separated by the specified
@@ -2222,6 +2314,30 @@ void String::Zero()
 // Private Methods
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+//===============================================================================================//
+//  Description:
+//      Free the buffer of this string
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      The inline buffer is part of the object so is never deleted. Leaves
+//      a null string but does not reset the length.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void String::FreeBuffer()
+{
+    if ( m_pwzString && ( m_pwzString != m_szInline ) )
+    {
+        delete[] m_pwzString;
+    }
+    m_pwzString       = nullptr;
+    m_uCharsAllocated = 0;
+}
+
 //===============================================================================================//
 //  Description:
 //      Set this string using the specified mutlibyte and code page
@@ -44,7 +44,7 @@
 // 4. Other Libraries
 
 // 5. This Project
-#include "PxsBase/Header Files/AllocateWChars.h"
+#include "PxsBase/Header Files/AllocateBytes.h"
 #include "PxsBase/Header Files/BoundsException.h"
 #include "PxsBase/Header Files/ComException.h"
 #include "PxsBase/Header Files/Exception.h"
@@ -558,74 +558,54 @@ void StringArray::SetSize( size_t newSize )
 //  Parameters:
 //      ascending - true for an ascending sort otherwise false for descending
 //
+//  Remarks:
+//      Case insensitive and stable. Only the string pointers are re-ordered,
+//      the strings themselves are not copied.
+//
 //  Returns:
 //      void
 //===============================================================================================//
 void StringArray::Sort( bool ascending )
 {
-    size_t   maxChars   = 0, i = 0, sizeT = 0, newChars = 0;
-    wchar_t* pszStrings = nullptr;
-    LPCWSTR  psz        = nullptr;
-    AllocateWChars  AllocWChars;
+    size_t   i = 0, numBytes = 0;
+    size_t*  pOrder   = nullptr;
+    wchar_t** ppSorted = nullptr;
+    AllocateBytes AllocBytes;
 
-    sizeT = GetSize();
-    if ( sizeT <= 1 )
+    if ( m_uSize <= 1 )
     {
         return;       // Nothing to do
     }
 
-    // Get maximum characters in any string
-    for ( i = 0; i < sizeT; i++ )
-    {
-        psz = Get( i );
-        if ( psz )
-        {
-            maxChars = PXSMaxSizeT( maxChars, wcslen( psz ) );
-        }
-    }
-
-    if ( maxChars == 0 )
+    numBytes = PXSMultiplySizeT( m_uSize, sizeof ( size_t ) );
+    pOrder   = reinterpret_cast<size_t*>( AllocBytes.New( numBytes ) );
+    for ( i = 0; i < m_uSize; i++ )
     {
-        return;     // Nothing to do
-    }
-    maxChars = PXSAddSizeT( maxChars, 1 );    // Terminator
-
-    // Allocate a fixed-width array of strings and fill it
-    newChars   = PXSMultiplySizeT( sizeT, maxChars );
-    pszStrings = AllocWChars.New( newChars );
-    for ( i = 0; i < sizeT; i++ )
-    {
-        psz = Get( i );
-        if ( psz )
-        {
-            size_t idxOffset = PXSMultiplySizeT( i, maxChars );
-            PXSStringCchCopy( pszStrings + idxOffset, maxChars, psz, __FUNCTION__ );
-        }
+        pOrder[ i ] = i;
     }
 
-    // Use qsort
     if ( ascending )
     {
-        qsort( pszStrings,
-               sizeT,
-               PXSMultiplySizeT( maxChars, sizeof ( wchar_t ) ),
-               PXSQSortStringAscending );
+        PXSStableSortIndexes( pOrder, m_uSize, SortCompareAscending, m_ppStringArray );
     }
     else
     {
-        qsort( pszStrings,
-               sizeT,
-               PXSMultiplySizeT( maxChars, sizeof ( wchar_t ) ),
-               PXSQSortStringDescending );
+        PXSStableSortIndexes( pOrder, m_uSize, SortCompareDescending, m_ppStringArray );
     }
 
-    // Re-populate the input/output array, this is not exception safe
-    RemoveAll();
-    for ( i = 0; i < sizeT; i++ )
+    // Re-order the pointers into a new array
+    ppSorted = new wchar_t*[ m_uAllocated ];
+    if ( ppSorted == nullptr )
+    {
+        throw MemoryException( __FUNCTION__ );
+    }
+    memset( ppSorted, 0, sizeof ( wchar_t* ) * m_uAllocated );
+    for ( i = 0; i < m_uSize; i++ )
     {
-        size_t idxOffset = PXSMultiplySizeT( i, maxChars );
-        Add( pszStrings + idxOffset );
+        ppSorted[ i ] = m_ppStringArray[ pOrder[ i ] ];
     }
+    delete[] m_ppStringArray;
+    m_ppStringArray = ppSorted;
 }
 
 //===============================================================================================//
@@ -747,6 +727,33 @@ void StringArray::SubString( size_t index, size_t start, size_t length, String*
     }
 }
 
+//===============================================================================================//
+//  Description:
+//      Exchange the contents of this array with another
+//
+//  Parameters:
+//      Other - the array to swap with
+//
+//  Remarks:
+//      Only the pointer arrays are exchanged, no strings are copied
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void StringArray::Swap( StringArray& Other )
+{
+    size_t    size          = m_uSize;
+    size_t    allocated     = m_uAllocated;
+    wchar_t** ppStringArray = m_ppStringArray;
+
+    m_uSize               = Other.m_uSize;
+    m_uAllocated          = Other.m_uAllocated;
+    m_ppStringArray       = Other.m_ppStringArray;
+    Other.m_uSize         = size;
+    Other.m_uAllocated    = allocated;
+    Other.m_ppStringArray = ppStringArray;
+}
+
 //===============================================================================================//
 //  Description:
 //      Get this string array as a token separated string
@@ -799,3 +806,39 @@ void StringArray::ToString( wchar_t wch, String* pString ) const
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Private Methods
 ///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Callback for PXSStableSortIndexes for a case insensitive ascending sort
+//
+//  Parameters:
+//      index1   - index of the first string
+//      index2   - index of the second string
+//      pContext - the array of string pointers
+//
+//  Returns:
+//      -ve, 0 or +ve as for PXSCompareString
+//===============================================================================================//
+int StringArray::SortCompareAscending( size_t index1, size_t index2, const void* pContext )
+{
+    const wchar_t* const* ppStrings = static_cast<const wchar_t* const*>( pContext );
+
+    return PXSCompareString( ppStrings[ index1 ], ppStrings[ index2 ], false );
+}
+
+//===============================================================================================//
+//  Description:
+//      Callback for PXSStableSortIndexes for a case insensitive descending sort
+//
+//  Parameters:
+//      index1   - index of the first string
+//      index2   - index of the second string
+//      pContext - the array of string pointers
+//
+//  Returns:
+//      -ve, 0 or +ve as for PXSCompareString with the arguments reversed
+//===============================================================================================//
+int StringArray::SortCompareDescending( size_t index1, size_t index2, const void* pContext )
+{
+    return SortCompareAscending( index2, index1, pContext );
+}
@@ -0,0 +1,438 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// String Hash Index Class Implementation
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "PxsBase/Header Files/StringHashIndex.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+
+// 5. This Project
+#include "PxsBase/Header Files/ParameterException.h"
+#include "PxsBase/Header Files/StringArray.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Default constructor
+StringHashIndex::StringHashIndex()
+                :m_Hashes(),
+                 m_Indexes(),
+                 m_Slots()
+{
+}
+
+// Copy constructor - not allowed so no implementation
+
+// Destructor
+StringHashIndex::~StringHashIndex()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Operators
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Assignment operator - not allowed so no implementation
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Public Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Add an entry to the index
+//
+//  Parameters:
+//      hash  - hash of the entry's key
+//      index - the caller's index of the entry
+//
+//  Remarks:
+//      The caller must have checked that the key is not already in the
+//      index, FindFirst returns the earliest of any entries with equal keys.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void StringHashIndex::Add( UINT32 hash, size_t index )
+{
+    if ( PXSMultiplySizeT( m_Hashes.GetSize() + 1, 2 ) > m_Slots.GetSize() )
+    {
+        Grow();
+    }
+    m_Hashes.Add( hash );
+    m_Indexes.Add( index );
+
+    size_t mask    = m_Slots.GetSize() - 1;
+    size_t idxSlot = hash & mask;
+    while ( m_Slots.Get( idxSlot ) )
+    {
+        idxSlot = ( idxSlot + 1 ) & mask;
+    }
+    m_Slots.Set( idxSlot, m_Hashes.GetSize() );
+}
+
+//===============================================================================================//
+//  Description:
+//      Add a string key to the index
+//
+//  Parameters:
+//      pszKey        - the key
+//      caseSensitive - true if keys are compared case sensitively
+//      index         - the caller's index of the key
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void StringHashIndex::Add( LPCWSTR pszKey, bool caseSensitive, size_t index )
+{
+    if ( pszKey == nullptr )
+    {
+        throw ParameterException( L"pszKey", __FUNCTION__ );
+    }
+    Add( HashString( pszKey, caseSensitive ), index );
+}
+
+//===============================================================================================//
+//  Description:
+//      Find a string key whose entries were added with their index into the
+//      specified array
+//
+//  Parameters:
+//      Keys          - the array holding the keys
+//      pszKey        - the key to find
+//      caseSensitive - true for a case sensitive comparison, must match Add
+//
+//  Returns:
+//      Index of the key in Keys, PXS_MINUS_ONE if not found
+//===============================================================================================//
+size_t StringHashIndex::Find( const StringArray& Keys, LPCWSTR pszKey, bool caseSensitive ) const
+{
+    size_t position = 0;
+
+    if ( pszKey == nullptr )
+    {
+        return PXS_MINUS_ONE;
+    }
+
+    UINT32 hash  = HashString( pszKey, caseSensitive );
+    size_t index = FindFirst( hash, &position );
+    while ( index != PXS_MINUS_ONE )
+    {
+        if ( PXSCompareString( Keys.Get( index ), pszKey, caseSensitive ) == 0 )
+        {
+            return index;
+        }
+        index = FindNext( hash, &position );
+    }
+
+    return PXS_MINUS_ONE;
+}
+
+//===============================================================================================//
+//  Description:
+//      Find the first entry with the specified hash
+//
+//  Parameters:
+//      hash      - the hash of the key to find
+//      pPosition - receives the probe position, pass it to FindNext
+//
+//  Remarks:
+//      Different keys can have the same hash so the caller compares its key
+//      with the entry and if it does not match calls FindNext.
+//
+//  Returns:
+//      The caller's index of the entry, PXS_MINUS_ONE if none
+//===============================================================================================//
+size_t StringHashIndex::FindFirst( UINT32 hash, size_t* pPosition ) const
+{
+    if ( pPosition == nullptr )
+    {
+        throw ParameterException( L"pPosition", __FUNCTION__ );
+    }
+    *pPosition = 0;
+
+    size_t numSlots = m_Slots.GetSize();
+    if ( numSlots == 0 )
+    {
+        return PXS_MINUS_ONE;
+    }
+
+    return Probe( hash, hash & ( numSlots - 1 ), pPosition );
+}
+
+//===============================================================================================//
+//  Description:
+//      Find the next entry with the specified hash
+//
+//  Parameters:
+//      hash      - the hash passed to FindFirst
+//      pPosition - the position from FindFirst or FindNext, receives the next one
+//
+//  Returns:
+//      The caller's index of the entry, PXS_MINUS_ONE if no more
+//===============================================================================================//
+size_t StringHashIndex::FindNext( UINT32 hash, size_t* pPosition ) const
+{
+    if ( pPosition == nullptr )
+    {
+        throw ParameterException( L"pPosition", __FUNCTION__ );
+    }
+
+    size_t numSlots = m_Slots.GetSize();
+    if ( numSlots == 0 )
+    {
+        return PXS_MINUS_ONE;
+    }
+
+    return Probe( hash, ( *pPosition + 1 ) & ( numSlots - 1 ), pPosition );
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the number of entries in the index
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      size_t
+//===============================================================================================//
+size_t StringHashIndex::GetSize() const
+{
+    return m_Hashes.GetSize();
+}
+
+//===============================================================================================//
+//  Description:
+//      Remove all the entries
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void StringHashIndex::RemoveAll()
+{
+    m_Hashes.RemoveAll();
+    m_Indexes.RemoveAll();
+    m_Slots.RemoveAll();
+}
+
+//===============================================================================================//
+//  Description:
+//      Hash a string
+//
+//  Parameters:
+//      pszString     - the string, may be NULL
+//      caseSensitive - false to hash the upper case characters
+//
+//  Returns:
+//      UINT32 hash
+//===============================================================================================//
+UINT32 StringHashIndex::HashString( LPCWSTR pszString, bool caseSensitive )
+{
+    if ( pszString == nullptr )
+    {
+        return HashString( nullptr, 0, caseSensitive );
+    }
+
+    return HashString( pszString, wcslen( pszString ), caseSensitive );
+}
+
+//===============================================================================================//
+//  Description:
+//      Hash the first characters of a string
+//
+//  Parameters:
+//      pszString     - the string, may be NULL
+//      numChars      - the number of characters to hash
+//      caseSensitive - false to hash the upper case characters
+//
+//  Remarks:
+//      FNV-1a of the characters. Some callers store the case sensitive value
+//      so it must not change.
+//
+//      Without case the characters are upper cased by the invariant locale,
+//      as PXSCompareString ignores case, so strings it finds equal have the
+//      same hash whatever their script. The characters are mapped a chunk at
+//      a time with a short cut for chunks that are all ASCII.
+//
+//  Returns:
+//      UINT32 hash
+//===============================================================================================//
+UINT32 StringHashIndex::HashString( LPCWSTR pszString, size_t numChars, bool caseSensitive )
+{
+    const  size_t CHUNK_CHARS = 64;
+    int     cchChunk = 0;
+    bool    isAscii  = true;
+    size_t  i = 0, j = 0, numChunk = 0;
+    UINT32  hash = 2166136261;
+    wchar_t wch  = 0;
+    wchar_t szUpper[ CHUNK_CHARS ] = { 0 };
+    LPCWSTR pszChunk = nullptr;
+
+    if ( pszString == nullptr )
+    {
+        return hash;
+    }
+
+    for ( i = 0; i < numChars; i += numChunk )
+    {
+        numChunk = PXSMinSizeT( numChars - i, CHUNK_CHARS );
+        pszChunk = pszString + i;
+        if ( caseSensitive == false )
+        {
+            isAscii = true;
+            for ( j = 0; j < numChunk; j++ )
+            {
+                wch = pszChunk[ j ];
+                if ( wch > 0x7F )
+                {
+                    isAscii = false;
+                    break;
+                }
+                if ( ( wch >= 'a' ) && ( wch <= 'z' ) )
+                {
+                    wch = static_cast<wchar_t>( wch - ( 'a' - 'A' ) );
+                }
+                szUpper[ j ] = wch;
+            }
+
+            if ( isAscii == false )
+            {
+                // Simple case mapping, one character out for each in
+                cchChunk = PXSCastSizeTToInt32( numChunk );
+                if ( cchChunk != LCMapString( LOCALE_INVARIANT,
+                                              LCMAP_UPPERCASE,
+                                              pszChunk, cchChunk, szUpper, cchChunk ) )
+                {
+                    for ( j = 0; j < numChunk; j++ )
+                    {
+                        szUpper[ j ] = towupper( pszChunk[ j ] );
+                    }
+                }
+            }
+            pszChunk = szUpper;
+        }
+
+        for ( j = 0; j < numChunk; j++ )
+        {
+            hash ^= static_cast<UINT32>( pszChunk[ j ] );
+            hash *= 16777619;
+        }
+    }
+
+    return hash;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Protected Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Private Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Double the number of slots and re-hash the entries
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void StringHashIndex::Grow()
+{
+    size_t numSlots = m_Slots.GetSize();
+
+    numSlots = PXSMultiplySizeT( numSlots ? numSlots : 32, 2 );
+    m_Slots.SetSize( numSlots );
+    for ( size_t i = 0; i < numSlots; i++ )
+    {
+        m_Slots.Set( i, 0 );
+    }
+
+    size_t mask       = numSlots - 1;
+    size_t numEntries = m_Hashes.GetSize();
+    for ( size_t i = 0; i < numEntries; i++ )
+    {
+        size_t idxSlot = m_Hashes.Get( i ) & mask;
+        while ( m_Slots.Get( idxSlot ) )
+        {
+            idxSlot = ( idxSlot + 1 ) & mask;
+        }
+        m_Slots.Set( idxSlot, i + 1 );
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Probe the slots for an entry with the specified hash
+//
+//  Parameters:
+//      hash      - the hash to find
+//      idxSlot   - the slot to start at
+//      pPosition - receives the slot of the entry found
+//
+//  Returns:
+//      The caller's index of the entry, PXS_MINUS_ONE if an empty slot is reached
+//===============================================================================================//
+size_t StringHashIndex::Probe( UINT32 hash, size_t idxSlot, size_t* pPosition ) const
+{
+    size_t mask = m_Slots.GetSize() - 1;
+    size_t slot = m_Slots.Get( idxSlot );
+
+    while ( slot )
+    {
+        if ( m_Hashes.Get( slot - 1 ) == hash )
+        {
+            *pPosition = idxSlot;
+            return m_Indexes.Get( slot - 1 );
+        }
+        idxSlot = ( idxSlot + 1 ) & mask;
+        slot    = m_Slots.Get( idxSlot );
+    }
+
+    return PXS_MINUS_ONE;
+}
@@ -56,6 +56,7 @@
 #include "PxsBase/Header Files/NameValue.h"
 #include "PxsBase/Header Files/NullException.h"
 #include "PxsBase/Header Files/ParameterException.h"
+#include "PxsBase/Header Files/StringArray.h"
 #include "PxsBase/Header Files/SystemException.h"
 #include "PxsBase/Header Files/TArray.h"
 
@@ -70,7 +71,8 @@ Wmi::Wmi()
     :m_pIEnumWbemClassObject( nullptr ),
      m_pIWbemClassObject( nullptr ),
      m_pIWbemLocator( nullptr ),
-     m_pIWbemServices( nullptr )
+     m_pIWbemServices( nullptr ),
+     m_NameSpace()
 {
 }
 
@@ -139,6 +141,9 @@ void Wmi::CloseQuery()
 //      specify a maximum of 2 minutes. Think this only applies to remote
 //      servers. Documentation says, call will block if server 'broken'.
 //
+//      If already connected to the name space, the connection is re-used
+//      and any open query is closed.
+//
 //  Returns:
 //      void
 //===============================================================================================//
@@ -155,6 +160,12 @@ void Wmi::Connect( LPCWSTR pszNameSpace )
     {
         throw ParameterException( L"pszNameSpace", __FUNCTION__ );
     }
+
+    if ( m_pIWbemServices && ( NameSpace.CompareI( m_NameSpace ) == 0 ) )
+    {
+        CloseQuery();
+        return;
+    }
     Disconnect();   // Ensure disconnected before proceeding
 
     // WbemLocator
@@ -198,6 +209,7 @@ void Wmi::Connect( LPCWSTR pszNameSpace )
         throw NullException( L"m_pIWbemServices", __FUNCTION__ );
     }
     ApplyProxySecurity( m_pIWbemServices );
+    m_NameSpace = NameSpace;
 }
 
 //===============================================================================================//
@@ -242,6 +254,89 @@ void Wmi::Disconnect()
         m_pIWbemLocator->Release();
         m_pIWbemLocator = nullptr;
     }
+    m_NameSpace = PXS_STRING_EMPTY;
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the specified properties of every instance of a class
+//
+//  Parameters:
+//      pszClassName - the WMI class name
+//      Properties   - the property names to select
+//      pRows        - receives one string array per instance, each value
+//                     in the same order as Properties
+//
+//  Remarks:
+//      Must be connected. Only the named properties are selected, NULL and
+//      empty values are returned as empty strings.
+//
+//  Returns:
+//      size_t number of rows
+//===============================================================================================//
+size_t Wmi::GetClassRows( LPCWSTR pszClassName,
+                          const StringArray& Properties, TArray< StringArray >* pRows )
+{
+    String      Query, Value;
+    HRESULT     hResult = 0;
+    VARIANT     variant;
+    StringArray Row;
+
+    if ( ( pszClassName == nullptr ) || ( *pszClassName == PXS_CHAR_NULL ) )
+    {
+        throw ParameterException( L"pszClassName", __FUNCTION__ );
+    }
+
+    if ( pRows == nullptr )
+    {
+        throw ParameterException( L"pRows", __FUNCTION__ );
+    }
+    pRows->RemoveAll();
+
+    size_t numProperties = Properties.GetSize();
+    if ( numProperties == 0 )
+    {
+        throw ParameterException( L"Properties", __FUNCTION__ );
+    }
+
+    Query = L"SELECT ";
+    for ( size_t i = 0; i < numProperties; i++ )
+    {
+        if ( i )
+        {
+            Query += L", ";
+        }
+        Query += Properties.Get( i );
+    }
+    Query += L" FROM ";
+    Query += pszClassName;
+
+    ExecQuery( Query.c_str() );
+    while ( Next() )
+    {
+        Row.RemoveAll();
+        for ( size_t i = 0; i < numProperties; i++ )
+        {
+            Value = PXS_STRING_EMPTY;
+            VariantInit( &variant );
+            hResult = m_pIWbemClassObject->Get( Properties.Get( i ), 0, &variant, nullptr, nullptr );
+            if ( FAILED( hResult ) )
+            {
+                CloseQuery();
+                throw ComException( hResult, Properties.Get( i ), "IWbemClassObject::Get" );
+            }
+            AutoVariantClear VariantClearVal( &variant );
+            if ( ( variant.vt != VT_NULL ) && ( variant.vt != VT_EMPTY ) )
+            {
+                PXSVariantToString( &variant, &Value );
+            }
+            Row.Add( Value );
+        }
+        pRows->Add( Row );
+    }
+    CloseQuery();
+
+    return pRows->GetSize();
 }
 
 //===============================================================================================//
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Account Name Cache Class Header
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef WINAUDIT_ACCOUNT_NAME_CACHE_H_
+#define WINAUDIT_ACCOUNT_NAME_CACHE_H_
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Resolves SIDs to account names for the permissions and user rights
+// categories. Entries live for the duration of an audit, including those for
+// SIDs that could not be mapped, so each SID is looked up at most once. All
+// public methods are serialised by a mutex.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Includes
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Header Files/WinAudit.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/Mutex.h"
+#include "PxsBase/Header Files/StringArray.h"
+#include "PxsBase/Header Files/StringHashIndex.h"
+#include "PxsBase/Header Files/TArray.h"
+#include "PxsBase/Header Files/UInt32Array.h"
+
+// 5. This Project
+
+// 6. Forwards
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Interface
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class AccountNameCache
+{
+    public:
+        // Default constructor
+        AccountNameCache();
+
+        // Destructor
+        ~AccountNameCache();
+
+        // Methods
+        void GetAccountName( const PSID pSid, bool withDomain, String* pAccountName );
+        void GetStatistics( size_t* pNumHits, size_t* pNumMisses );
+        void LogStatistics();
+        void LookupSids( const PSID* pSids, size_t numSids );
+        void Reset();
+
+    protected:
+        // Methods
+
+        // Data members
+
+    private:
+        // Copy constructor - not allowed
+        AccountNameCache( const AccountNameCache& oAccountNameCache );
+
+        // Assignment operator - not allowed
+        AccountNameCache& operator= ( const AccountNameCache& oAccountNameCache );
+
+        // Methods
+        void   AddEntry( const String& StringSid,
+                         LPCWSTR pszDomainName, LPCWSTR pszName, SID_NAME_USE eUse );
+        size_t FindEntry( const String& StringSid ) const;
+
+        // Data members
+        size_t      m_uNumHits;
+        size_t      m_uNumMisses;
+        Mutex       m_Mutex;
+        StringArray m_StringSids;
+        StringArray m_DomainNames;
+        StringArray m_Names;
+        UInt32Array m_Uses;             // SID_NAME_USE, SidTypeUnknown = not mapped
+        StringHashIndex  m_SidIndex;    // Index into m_StringSids
+};
+
+#endif  // WINAUDIT_ACCOUNT_NAME_CACHE_H_
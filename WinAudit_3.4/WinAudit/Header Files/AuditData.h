@@ -47,6 +47,9 @@
 // 4. Other Libraries
 
 // 5. This Project
+#include "WinAudit/Header Files/AccountNameCache.h"
+#include "WinAudit/Header Files/CategorySnapshotCache.h"
+#include "WinAudit/Header Files/ProcessInformation.h"
 #include "WinAudit/Header Files/SmbiosInformation.h"
 
 // 6. Forwards
@@ -82,8 +85,10 @@ class AuditData
  static void  GetRegionalSettingsRecords( TArray< AuditRecord >* pRecords );
  static void  GetSystemFilesRecords( LPCWSTR pszFilter, TArray< AuditRecord >* pRecords );
         void  GetSystemOverviewRecord( const String& LocalTime, AuditRecord* pRecord );
+        void  LogCacheStatistics();
  static void  MakeAuditMasterRecord( AuditRecord* pAuditMaster );
         void  MakeComputerMasterRecord( AuditRecord* pComputerMaster );
+        void  ResetPerPassState();
 
     protected:
         // Methods
@@ -101,7 +106,10 @@ class AuditData
  static void TranslateCalenderType( LPCWSTR pszCalendar, String* pMeaning );
 
         // Data members
-        SmbiosInformation   m_SmbiosInfo;
+        AccountNameCache      m_AccountNameCache;
+        CategorySnapshotCache m_SnapshotCache;
+        ProcessInformation    m_ProcessInfo;
+        SmbiosInformation     m_SmbiosInfo;
 };
 
 #endif  // WINAUDIT_AUDIT_DATA_H_
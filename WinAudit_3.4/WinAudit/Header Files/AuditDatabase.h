@@ -33,6 +33,23 @@
 // Remarks
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// The identifying columns of Computer_Master each have a Key_ column that
+// holds the trimmed, upper-case value. These are written when a computer is
+// inserted or updated so identification can compare them directly and use
+// their indexes rather than apply UPPER to every row. Databases created
+// before the Key_ columns existed are upgraded by the administration dialog,
+// until then the original columns are used. Whether they exist is looked up
+// once per connection.
+//
+// The Summary_ tables hold the counts behind the canned reports over each
+// computer's last audit. Rather than GROUP BY all of Audit_Data when a report
+// is run, they are adjusted as each audit is made the computer's last one by
+// taking off the counts of the audit it replaces and adding its own. Only the
+// keys whose counts differ are written so re-auditing an unchanged computer
+// costs two small reads per table. Summary_Status records when they could not
+// be adjusted, the reports then count from Audit_Data until
+// RebuildSummaryTables regenerates them from scratch.
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Includes
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -51,8 +68,10 @@
 
 // 6. Forwards
 class AuditRecord;
+class NameValue;
 class SmbiosInformation;
 class String;
+class StringArray;
 template< class T > class TArray;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -69,12 +88,48 @@ class AuditDatabase : public OdbcDatabase
         ~AuditDatabase();
 
         // Methods
+        void       ClearSchemaCache();
+ static void       ComputerMasterRecordToKeys( const AuditRecord& ComputerMaster,
+                                               StringArray* pKeys );
+        void       Connect( const String& ConnectionString,
+                            DWORD connectTimeoutSecs, DWORD queryTimeoutSecs, HWND hWnd );
+        size_t     CountOldAudits( DWORD retainCount, DWORD retainDays );
+        size_t     DeleteOldAuditsBatch( DWORD retainCount,
+                                         DWORD retainDays,
+                                         DWORD batchSize, SQLINTEGER* pLastAuditID );
+        void       Disconnect();
+ static LPCWSTR    GetKeyColumnName( size_t idxKey, bool normalised );
+        void       GetTableColumns( LPCWSTR pszTable, StringArray* pColumns );
+        bool       HasComputerMasterKeys();
+        bool       HasSummaryTables();
         SQLINTEGER IdentifyComputerID( const AuditRecord& ComputerMaster );
         SQLINTEGER InsertAuditMaster(  SQLINTEGER computerID, const AuditRecord& AuditMaster );
         SQLINTEGER InsertComputerMaster( const AuditRecord& ComputerMaster );
+        bool       IsSummaryStale();
+ static void       MakeOldAuditsPredicate( const String& DbmsName,
+                                           DWORD retainCount,
+                                           DWORD retainDays, String* pPredicate );
+        void       RebuildSummaryTables();
+        void       SetLastAuditID( SQLINTEGER computerID, SQLINTEGER auditID );
         void UpdateComputerMaster( const AuditRecord& ComputerMaster,
                                    SQLINTEGER computerID, SQLINTEGER auditID );
 
+        // Identifying keys of the Computer_Master table
+        static const size_t KEY_WINAUDIT_GUID  = 0;
+        static const size_t KEY_FQDN           = 1;
+        static const size_t KEY_SMBIOS_UUID    = 2;
+        static const size_t KEY_ASSET_TAG      = 3;
+        static const size_t KEY_MAC_ADDRESS    = 4;
+        static const size_t KEY_OS_PRODUCT_ID  = 5;
+        static const size_t KEY_COMPUTER_NAME  = 6;
+        static const size_t NUM_KEYS           = 7;
+
+        // Report summary tables
+        static const size_t SUMMARY_SOFTWARE   = 0;
+        static const size_t SUMMARY_ERRORS     = 1;
+        static const size_t SUMMARY_DOMAINS    = 2;
+        static const size_t NUM_SUMMARIES      = 3;
+
     protected:
         // Methods
 
@@ -88,6 +143,9 @@ class AuditDatabase : public OdbcDatabase
         AuditDatabase& operator= ( const AuditDatabase& oAuditDatabase );
 
         // Methods
+        void ApplySummaryDeltas( size_t idxSummary,
+                                 const TArray< NameValue >& OldCounts,
+                                 const TArray< NameValue >& NewCounts );
         void ComputerMasterRecordToValues( const AuditRecord &ComputerMaster,
                                            String* pMacAddress,
                                            String* pSmbiosUUID,
@@ -99,7 +157,20 @@ class AuditDatabase : public OdbcDatabase
                                            String* pOsProductID,
                                            String* pOtherIdentifier,
                                            String* pWinAuditGUID) const;
+        void GetSummaryCounts( size_t idxSummary,
+                               SQLINTEGER computerID, TArray< NameValue >* pCounts );
+ static void GetSummaryNames( size_t idxSummary,
+                              LPCWSTR* ppszTable,
+                              LPCWSTR* ppszKeyColumn, LPCWSTR* ppszCountColumn );
+        void MakeSummarySelectSql( size_t idxSummary, SQLINTEGER computerID, String* pSqlQuery );
+        void SetComputerMasterKeys( SQLINTEGER computerID, const StringArray& Keys );
+        void UpdateSummaryCount( size_t idxSummary, const String& Key, SQLINTEGER delta );
+
         // Data members
+        bool    m_bKnowComputerMasterKeys;
+        bool    m_bHasComputerMasterKeys;
+        bool    m_bKnowSummaryTables;
+        bool    m_bHasSummaryTables;
 };
 
 #endif  // WINAUDIT_AUDIT_DATABASE_H_
@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Audit File Ingester Class Header
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef WINAUDIT_AUDIT_FILE_INGESTER_H_
+#define WINAUDIT_AUDIT_FILE_INGESTER_H_
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Reads back the CSV2 files written by computers in command line mode and
+// exports them to a database. Worker threads parse the files into a ring of
+// slots while the creator thread exports the slots in file order. A worker
+// only takes a file when a slot is free so at most one file per slot is held
+// in memory however many files there are.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Includes
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/TArray.h"
+#include "PxsBase/Header Files/Thread.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/AuditRecord.h"
+#include "WinAudit/Header Files/WinAudit.h"
+
+// 6. Forwards
+class StringArray;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Interface
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class AuditFileIngester : public Thread
+{
+    public:
+        // Default constructor
+        AuditFileIngester();
+
+        // Destructor
+        ~AuditFileIngester();
+
+        // Methods
+ static void IngestDirectory( const String& DirectoryPath,
+                              const String& FileSwitchValue, bool valueDictionary );
+ static void MasterRecordsToCsv2( const AuditRecord& ComputerMaster,
+                                  const AuditRecord& AuditMaster, String* pCsvText );
+ static void ReadCsv2File( const String& FilePath,
+                           AuditRecord* pComputerMaster,
+                           AuditRecord* pAuditMaster, TArray< AuditRecord >* pAuditRecords );
+
+    protected:
+        // Methods
+
+        // Data members
+
+    private:
+        // A parsed file waiting to be exported
+        typedef struct _TYPE_INGEST_SLOT
+        {
+            volatile LONG         fileNumber;   // One-based, zero when empty
+            bool                  parsed;
+            AuditRecord           ComputerMaster;
+            AuditRecord           AuditMaster;
+            TArray< AuditRecord > AuditRecords;
+        } TYPE_INGEST_SLOT;
+
+        // Work shared by the worker threads and the creator
+        typedef struct _TYPE_INGEST_BATCH
+        {
+            const StringArray* pFilePaths;
+            TYPE_INGEST_SLOT*  pSlots;
+            LONG               numSlots;
+            HANDLE             hFreeSlots;      // Semaphore, one count per free slot
+            HANDLE             hFileReady;      // Auto-reset, set when a slot is filled
+            volatile LONG      nextIndex;
+        } TYPE_INGEST_BATCH;
+
+        // Copy constructor - not allowed
+        AuditFileIngester( const AuditFileIngester& oAuditFileIngester );
+
+        // Assignment operator - not allowed
+        AuditFileIngester& operator= ( const AuditFileIngester& oAuditFileIngester );
+
+        // Methods
+ static void  ExportFiles( const String& FileSwitchValue,
+                           bool valueDictionary,
+                           TYPE_INGEST_BATCH* pBatch, size_t* pNumExported );
+ static void  ParseCsv2( const String& CsvText,
+                         AuditRecord* pComputerMaster,
+                         AuditRecord* pAuditMaster, TArray< AuditRecord >* pAuditRecords );
+ static bool  ReadCsvField( LPCWSTR* ppCsv, String* pField );
+        DWORD RunWorkerThread() override;
+
+        // Data members
+        TYPE_INGEST_BATCH* m_pBatchMT;      // Shared variable
+};
+
+#endif  // WINAUDIT_AUDIT_FILE_INGESTER_H_
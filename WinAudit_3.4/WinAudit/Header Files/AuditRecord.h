@@ -79,8 +79,12 @@ class AuditRecord
         void    GetCategoryIdAndValues( DWORD* pCategoryID, StringArray* pValues ) const;
         DWORD   GetCategoryID() const;
         size_t  GetNumberOfValues() const;
+        LPCWSTR GetItemValue( DWORD itemID ) const;
         void    GetItemValue( DWORD itemID, String* pValue ) const;
+        LPCWSTR GetValue( size_t index ) const;
+        size_t  GetValueLength( size_t index ) const;
         void    Reset( DWORD categoryID );
+        void    Swap( AuditRecord& Other );
         void    ToString( String* pRecordString ) const;
 
     protected:
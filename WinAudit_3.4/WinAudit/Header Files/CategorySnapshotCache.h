@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Category Snapshot Cache Class Header
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef WINAUDIT_CATEGORY_SNAPSHOT_CACHE_H_
+#define WINAUDIT_CATEGORY_SNAPSHOT_CACHE_H_
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Keeps the records of the slow categories, e.g. installed programs, on disk
+// together with a fingerprint of the sources they were collected from. The
+// fingerprint is made from cheap signals such as registry key last write
+// times and service states. If it is unchanged on the next audit and the
+// snapshot is not too old the saved records are used instead of collecting
+// them again.
+//
+// Snapshots are kept in a directory only SYSTEM, Administrators and its owner
+// can write to. A snapshot is only loaded if it is owned by one of them and
+// only saved if no exception was logged while its records were collected.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Includes
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Header Files/WinAudit.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/StringT.h"
+
+// 5. This Project
+
+// 6. Forwards
+class AuditRecord;
+template< class T > class TArray;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Interface
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class CategorySnapshotCache
+{
+    public:
+        // Default constructor
+        CategorySnapshotCache();
+
+        // Destructor
+        virtual ~CategorySnapshotCache();
+
+        // Methods
+        bool GetRecords( DWORD categoryID, TArray< AuditRecord >* pRecords );
+        void GetStatistics( size_t* pNumHits, size_t* pNumMisses ) const;
+ static bool IsCacheableCategory( DWORD categoryID );
+        void LogStatistics() const;
+ static void MakeFingerprint( DWORD categoryID, String* pFingerprint );
+        void Reset();
+        void SaveRecords( DWORD categoryID, const TArray< AuditRecord >& Records );
+        void SetDirectoryPath( const String& DirectoryPath );
+
+    protected:
+        // Methods
+        virtual void GetFingerprint( DWORD categoryID, String* pFingerprint );
+
+        // Data members
+
+    private:
+        // Copy constructor - not allowed
+        CategorySnapshotCache( const CategorySnapshotCache& oCategorySnapshotCache );
+
+        // Assignment operator - not allowed
+        CategorySnapshotCache& operator= ( const CategorySnapshotCache& oCategorySnapshotCache );
+
+        // Methods
+ static void CreateSnapshotDirectory( const String& DirectoryPath );
+        void GetSnapshotFilePath( DWORD categoryID, bool create, String* pFilePath ) const;
+ static void HashPrinters( UINT64* pHash, size_t* pNumItems );
+ static void HashRegistryKey( HKEY hKey,
+                              DWORD samDesired,
+                              LPCWSTR pszSubKey, UINT64* pHash, size_t* pNumItems );
+ static void HashServices( UINT64* pHash, size_t* pNumItems );
+ static void HashString( LPCWSTR pszString, UINT64* pHash );
+ static void HashUInt64( UINT64 value, UINT64* pHash );
+ static bool IsTrustedOwner( const String& Path );
+ static bool ParseRecordLine( DWORD categoryID, const String& Line, AuditRecord* pRecord );
+ static void WriteRecordLine( const AuditRecord& Record, String* pLine );
+
+        // Data members
+        DWORD  m_uPendingCategoryID;    // Category of m_PendingFingerprint
+        DWORD  m_uPendingExceptions;    // Exceptions logged before collecting
+        size_t m_uNumHits;
+        size_t m_uNumMisses;
+        String m_PendingFingerprint;    // Fingerprint to save with the records
+        String m_DirectoryPath;         // Empty for the default directory
+};
+
+#endif  // WINAUDIT_CATEGORY_SNAPSHOT_CACHE_H_
@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Collector Thread Class Header
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef WINAUDIT_COLLECTOR_THREAD_H_
+#define WINAUDIT_COLLECTOR_THREAD_H_
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Keeps WinAudit resident and re-audits categories on their own schedules,
+// e.g. running programs every 15 minutes and installed software daily. One
+// AuditData is used for the life of the thread, what it remembers of the
+// processes and accounts is discarded at the start of each pass.
+//
+// The categories that are due are collected together and a full audit is
+// exported only if the records of one of them changed, so audits in the
+// database stay complete for the reports. An export that fails is retried
+// with an increasing delay. Changes made in the meantime are merged into the
+// one pending audit rather than queued.
+//
+// Collection and export are virtual so the scheduling can be driven with
+// stubs and a made-up clock.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Includes
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+
+// 2. C System Files
+#include <time.h>
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/StringT.h"
+#include "PxsBase/Header Files/TArray.h"
+#include "PxsBase/Header Files/Thread.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/AuditData.h"
+#include "WinAudit/Header Files/AuditDatabase.h"
+#include "WinAudit/Header Files/AuditRecord.h"
+#include "WinAudit/Header Files/OdbcExportDialog.h"
+#include "WinAudit/Header Files/WinAudit.h"
+
+// 6. Forwards
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Interface
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class CollectorThread : public Thread
+{
+    public:
+        // Default constructor
+        CollectorThread();
+
+        // Destructor
+        ~CollectorThread();
+
+        // Methods
+        void   AddSchedule( DWORD categoryID, DWORD intervalSecs );
+        size_t GetNumberOfSchedules() const;
+        void   SetSink( const String& FileSwitchValue, const String& TimestampSwitchValue );
+ static void   SignalStop();
+        void   WaitForStop();
+
+        // Constants
+        static const DWORD MIN_INTERVAL_SECS = 60;
+
+    protected:
+        // Methods
+        virtual void CollectCategory( DWORD categoryID,
+                                      const String& LocalTime, TArray< AuditRecord >* pRecords );
+        virtual void ExportAudit( const String& LocalTime,
+                                  const TArray< AuditRecord >& AuditRecords );
+        bool  CollectDueCategories( time_t now, const String& LocalTime );
+        DWORD GetWaitMilliSecs( time_t now ) const;
+        void  PushChanges( time_t now, const String& LocalTime );
+        void  RunPass( time_t now, const String& LocalTime );
+
+        // Data members
+
+    private:
+        // A category's schedule and its records from the last collection
+        typedef struct _TYPE_COLLECTOR_ENTRY
+        {
+            DWORD                 categoryID;
+            DWORD                 intervalSecs;
+            time_t                dueAt;
+            UINT64                recordsHash;
+            TArray< AuditRecord > Records;
+        } TYPE_COLLECTOR_ENTRY;
+
+        // Constants
+        static const DWORD MAX_WAIT_SECS  = 3600;
+        static const DWORD MAX_RETRY_SECS = 3600;
+
+        // Copy constructor - not allowed
+        CollectorThread( const CollectorThread& oCollectorThread );
+
+        // Assignment operator - not allowed
+        CollectorThread& operator= ( const CollectorThread& oCollectorThread );
+
+        // Methods
+ static UINT64 HashRecords( const TArray< AuditRecord >& Records );
+        DWORD  RunWorkerThread() override;
+
+        // Data members, only used by the worker once it is running
+        bool          m_bExportPending;
+        DWORD         m_uNumFailures;
+        time_t        m_retryAt;
+        String        m_FileSwitchValue;
+        String        m_TimestampSwitchValue;
+        AuditData     m_Auditor;
+        AuditDatabase m_Database;
+        OdbcExportDialog m_OdbcExport;
+        TArray< TYPE_COLLECTOR_ENTRY > m_Entries;
+};
+
+#endif  // WINAUDIT_COLLECTOR_THREAD_H_
@@ -113,6 +113,9 @@ class ConfigurationSettings
         DWORD   connectTimeoutSecs;   // The database connection timeout
         DWORD   queryTimeoutSecs;     // The statement query timeout
         DWORD   reportMaxRecords;     // The maximum records to show in a report
+        DWORD   retainAuditCount;     // Audits to keep per computer when purging
+        DWORD   retainAuditDays;      // Keep audits newer than this, 0 = no age limit
+        DWORD   purgeBatchSize;       // Audits deleted per purge transaction
         String  DBMS;                 // The database management system name
         String  DatabaseName;         // The database name
         String  MySqlDriver;          // The MySQL driver name
@@ -76,6 +76,8 @@ class DatabaseAdministrationDialog: public Dialog
         // Destructor
         ~DatabaseAdministrationDialog();
 
+ static void    AddCreateAuditValueTriggerSql( StringArray* pStatements );
+ static void    AddCreateSqliteSql( bool valueDictionary, StringArray* pStatements );
         void    GetConfigurationSettings( ConfigurationSettings* pSettings ) const;
         void    SetConfigurationSettings( const ConfigurationSettings& Settings );
 
@@ -99,6 +101,8 @@ class DatabaseAdministrationDialog: public Dialog
  static void AddCreateAuditDataSql( const String& IntegerKeyword,
                                     const String& TCharKeyword,
                                     const String& VarTCharKeyword, StringArray* pStatements );
+ static void AddCreateAuditItemSql( const String& IntegerKeyword,
+                                   const String& VarTCharKeyword, StringArray* pStatements );
  static void AddCreateAuditMasterSql( const String& AutoIncrementKeyword,
                                       const String& IntegerKeyword,
                                       const String& TimestampKeyword,
@@ -109,17 +113,27 @@ class DatabaseAdministrationDialog: public Dialog
                                          const String& TimestampKeyword,
                                          const String& VarCharKeyword,
                                          const String& VarTCharKeyword, StringArray* pStatements );
+ static void AddCreateComputerMasterKeyIndexes( StringArray* pStatements );
  static void AddCreateDisplayNamesSql( const String& IntegerKeyword,
                                        const String& VarTCharKeyword, StringArray* pStatements );
+        void AddComputerMasterGrants( StringArray* pStatements ) const;
         void AddCreateGrants( StringArray* pStatements ) const;
+        void AddSummaryGrants( StringArray* pStatements ) const;
  static void AddCreateMySqlProcedures( StringArray* pStatements );
  static void AddCreateSqlServerProcedures( StringArray* pStatements );
+ static void AddCreateSummarySql( const String& IntegerKeyword,
+                                  const String& VarTCharKeyword,
+                                  const StringArray& Tables, bool stale, StringArray* pStatements );
  static void AddCreateViews( const String& SchemaName, StringArray* pStatements );
         void ConnectDB( bool serverOnly );
         void CreateAccessDatabase();
         void CreateDatabase();
         void CreateServerDatabase();
         void DeleteOldAudits();
+ static void GetComputerMasterKeyColumns( const String& VarCharKeyword,
+                                          StringArray* pDefinitions );
+        void GetComputerMasterUpgrade( StringArray* pColumnStatements,
+                                       StringArray* pIndexStatements, String* pBackfillSql );
         void GetDatabaseSpecificKeywords( String* pAutoIncrementKeyword,
                                           String* pCharKeyword,
                                           String* pIntegerKeyword,
@@ -128,17 +142,23 @@ class DatabaseAdministrationDialog: public Dialog
                                           String* pVarCharKeyword,
                                           String* pWCharKeyword,
                                           String* pWVarCharKeyword );
+        void GetGrantSchema( String* pSchema ) const;
         void MakeReportSql( const String& UpperKeyword, String* pSqlQuery ) const;
+        void RebuildSummaries();
         void RunReport();
         void UpdateSettings();
+        void UpgradeComputerMaster();
+        void UpgradeSummaryTables();
         void SetProgressMessage( const String& ProgressMessage );
 
         // Data members
+        bool                    m_bHasSummaryTables;
         size_t                  m_uIdxStaticProgress;
         String                  m_OdbcDriver;
         Button                  m_CloseButton;
         Button                  m_CreateButton;
         Button                  m_DeleteHistoryButton;
+        Button                  m_RebuildSummariesButton;
         Button                  m_RunReportButton;
         CheckBox                m_GrantPublicCheckBox;
         CheckBox                m_ReportShowSqlCheckBox;
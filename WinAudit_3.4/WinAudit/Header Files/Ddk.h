@@ -60,6 +60,14 @@
 
 #define STATUS_OBJECT_NAME_NOT_FOUND    ((NTSTATUS)0xC0000034L)
 
+#ifndef STATUS_SOME_NOT_MAPPED
+    #define STATUS_SOME_NOT_MAPPED      ((NTSTATUS)0x00000107L)
+#endif
+
+#ifndef STATUS_NONE_MAPPED
+    #define STATUS_NONE_MAPPED          ((NTSTATUS)0xC0000073L)
+#endif
+
 // Will use a name space called PXSDDK and use the required declares from the
 // DDK's header files. This avoids compiling with both the SDK and DDK
 // simultaneously. A time goes by more of the DDK seems to creep into the SDK.
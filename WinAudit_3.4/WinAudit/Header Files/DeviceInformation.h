@@ -47,13 +47,15 @@
 
 // 4. Other Libraries
 #include "PxsBase/Header Files/StringArray.h"
-#include "PxsBase/Header Files/TList.h"
+#include "PxsBase/Header Files/StringHashIndex.h"
+#include "PxsBase/Header Files/TArray.h"
+#include "PxsBase/Header Files/UInt32Array.h"
 
 // 5. This Project
 
 // 6. Forwards
 class AuditRecord;
-template< class T > class TArray;
+class Registry;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Interface
@@ -77,21 +79,21 @@ class DeviceInformation
         // Methods
 
     private:
-        // Structure to hold device information
+        // Structure to hold device information, the strings are indexes
+        // into m_StringPool
         typedef struct _TYPE_DEVICE_INFO
         {
-            GUID    ClassGuid;
-            ULONG   statusCode;            // See CM_Get_DevNode_Status
-            wchar_t szDeviceType[ 64 ];
-            wchar_t szDeviceName[ 64 ];
-            wchar_t szDescription[ 64 ];
-            wchar_t szManufacturer[ 64 ];
-            wchar_t szLocation[ 64 ];
-            wchar_t szDriverProvider[ 64 ];
-            wchar_t szDriverVersion[ 64 ];
-            wchar_t szDriverDate[ 64 ];
-            wchar_t szStatusMsg[ 128 ];
-            wchar_t szDeviceID[ 128 ];
+            ULONG statusCode;               // See CM_Get_DevNode_Status
+            DWORD idxClass;                 // Index into m_ClassGuids
+            DWORD idxDeviceName;
+            DWORD idxDescription;
+            DWORD idxManufacturer;
+            DWORD idxLocation;
+            DWORD idxDriverProvider;
+            DWORD idxDriverVersion;
+            DWORD idxDriverDate;
+            DWORD idxStatusMsg;
+            DWORD idxDeviceID;
         } TYPE_DEVICE_INFO;
 
         // Copy constructor - not allowed
@@ -102,25 +104,32 @@ class DeviceInformation
 
         // Methods
         size_t FillData();
+        DWORD  GetClassIndex( const GUID& ClassGuid );
  static void   GetDeviceStatus( DEVINST dnDevInst,
                                 const GUID* pGuid,
                                 PULONG pStatusCode,
                                 LPWSTR pszStatusMsg, size_t bufferChars );
  static void   GetDriverInfo( HDEVINFO DeviceInfoSet,
                               PSP_DEVINFO_DATA  DeviceInfoData,
+                              Registry* pRegObject,
                               LPWSTR pszDriverProvider,
                               size_t numProviderChars,
                               LPWSTR pszDriverVersion,
                               size_t numVersionChars,
                               LPWSTR pszDriverDate, size_t numDateChars );
-        size_t GetNextDeviceType( String* pDeviceType, TArray< AuditRecord >* pRecords );
+        DWORD  PoolDeviceProperty( HDEVINFO DeviceInfoSet,
+                                   PSP_DEVINFO_DATA DeviceInfoData, DWORD property );
+        DWORD  PoolString( LPCWSTR pszString );
         void   Reset();
  static void   TranslateDeviceCode( ULONG ulProblemNumber, String* pStatus );
 
         // Data members
-        DWORD           m_uLastDeviceTypeIndex;
-        StringArray     m_DeviceTypes;
-        TList< TYPE_DEVICE_INFO > m_Devices;
+        size_t           m_uNumDevices;     // Devices in use in m_Devices
+        StringArray      m_StringPool;      // Distinct strings, 0 = empty string
+        StringHashIndex  m_PoolIndex;       // Index into m_StringPool, not the empty string
+        TArray< GUID >   m_ClassGuids;      // Distinct device classes
+        UInt32Array      m_ClassTypes;      // Pool index of each class's description
+        TArray< TYPE_DEVICE_INFO > m_Devices;
 };
 
 #endif  // WINAUDIT_DEVICE_INFORMATION_H_
@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Disk Data Decoder Class Header
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef WINAUDIT_DISK_DATA_DECODER_H_
+#define WINAUDIT_DISK_DATA_DECODER_H_
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Decodes the data blocks a disk returns about itself: the ATA IDENTIFY
+// DEVICE and SMART READ DATA sectors and the NVMe Identify Controller,
+// Identify Namespace and SMART/Health Information log pages. Everything works
+// on byte buffers so the live disk audit and the decoding of captured data
+// blocks share the same code.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Includes
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Header Files/WinAudit.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+
+// 5. This Project
+#include "WinAudit/Header Files/Ddk.h"
+
+// 6. Forwards
+class AuditRecord;
+class ByteArray;
+template< class T > class TArray;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Interface
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class DiskDataDecoder
+{
+    public:
+        // Default constructor
+        DiskDataDecoder();
+
+        // Destructor
+        ~DiskDataDecoder();
+
+        // Sizes of the data blocks
+        static const size_t ATA_SECTOR_SIZE       = 512;
+        static const size_t NVME_IDENTIFY_SIZE    = 4096;
+        static const size_t NVME_HEALTH_LOG_SIZE  = 512;
+
+        // Methods
+ static void DecodeDirectory( const String& DirectoryPath,
+                              TArray< AuditRecord >* pRecords, String* pTranslations );
+ static void DiskSerialHexToSerialNumber( const String& SerialHex, String* pSerialNumber );
+ static bool ExtractIddStringValue( const BYTE* pbData, size_t numBytes, String* pDataString );
+ static void FormatAtaSmartData( const BYTE* pSmart, size_t bufferSize, String* pTranslation );
+ static void FormatDiskFirmwareDataBlock( const PXSDDK::IDENTIFY_DEVICE_DATA* pIDD,
+                                          String* pIddString );
+ static void FormatIddStructureAsString( const PXSDDK::IDENTIFY_DEVICE_DATA* pIDD,
+                                         String* pFormattedIdd );
+ static void FormatNvmeControllerData( const BYTE* pIdentify,
+                                       size_t bufferSize, String* pTranslation );
+ static void FormatNvmeHealthLog( const BYTE* pHealthLog, size_t bufferSize, String* pTranslation );
+ static void FormatNvmeNamespaceData( const BYTE* pIdentify,
+                                      size_t bufferSize, String* pTranslation );
+ static bool ReadDataBlockFile( const String& FilePath, size_t minimumSize, ByteArray* pDataBlock );
+ static void ResolveManufacturer( const String& Model, String* pManufacturerName );
+
+    protected:
+        // Methods
+
+        // Data members
+
+    private:
+        // Copy constructor - not allowed
+        DiskDataDecoder( const DiskDataDecoder& oDiskDataDecoder );
+
+        // Assignment operator - not allowed
+        DiskDataDecoder& operator= ( const DiskDataDecoder& oDiskDataDecoder );
+
+        // Methods
+ static void   ExtractAsciiString( const BYTE* pbData, size_t numBytes, String* pDataString );
+ static UINT64 GetUInt64LE( const BYTE* pbData, size_t numBytes );
+ static bool   IsZeroSumBlock( const BYTE* pbData, size_t numBytes );
+ static void   MakeAtaDiskRecord( const BYTE* pIdentify,
+                                  size_t identifySize,
+                                  const BYTE* pSmart,
+                                  size_t smartSize, size_t itemNumber, AuditRecord* pRecord );
+ static void   MakeNvmeDiskRecord( const BYTE* pController,
+                                   size_t controllerSize,
+                                   const BYTE* pNamespace,
+                                   size_t namespaceSize,
+                                   const BYTE* pHealthLog,
+                                   size_t healthLogSize, size_t itemNumber, AuditRecord* pRecord );
+ static void   TranslateKelvin( WORD kelvin, String* pTemperature );
+
+        // Data members
+};
+
+#endif  // WINAUDIT_DISK_DATA_DECODER_H_
@@ -45,6 +45,8 @@
 // 3. C++ System Files
 
 // 4. Other Libraries
+#include "PxsBase/Header Files/StringArray.h"
+#include "PxsBase/Header Files/TArray.h"
 
 // 5. This Project
 #include "WinAudit/Header Files/Ddk.h"
@@ -52,7 +54,6 @@
 // 6. Forwards
 class AuditRecord;
 class String;
-template< class T > class TArray;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Interface
@@ -67,9 +68,37 @@ class DiskInformation
         // Destructor
         ~DiskInformation();
 
+        // Win32_DiskDrive properties cached in m_WmiDiskDrives
+        static const size_t WMI_DISK_DEVICE_ID          = 0;
+        static const size_t WMI_DISK_SIZE               = 1;
+        static const size_t WMI_DISK_TOTAL_CYLINDERS    = 2;
+        static const size_t WMI_DISK_TOTAL_HEADS        = 3;
+        static const size_t WMI_DISK_SECTORS_PER_TRACK  = 4;
+        static const size_t WMI_DISK_MEDIA_TYPE         = 5;
+        static const size_t WMI_DISK_MANUFACTURER       = 6;
+        static const size_t WMI_DISK_MODEL              = 7;
+        static const size_t WMI_DISK_SCSI_PORT          = 8;
+        static const size_t WMI_DISK_SCSI_TARGET_ID     = 9;
+        static const size_t WMI_DISK_SERIAL_NUMBER      = 10;     // Vista+
+        static const size_t WMI_DISK_FIRMWARE_REVISION  = 11;     // Vista+
+
         // Methods
+ static const StringArray* FindWmiDiskRow( BYTE physicalDrive, const TArray< StringArray >& Rows );
         void    GetDiagnostics( String* pDiagnostics );
         void    GetAuditRecords( TArray< AuditRecord >* pRecords );
+ static bool    GetWmiDiskNumber( BYTE physicalDrive,
+                                  const TArray< StringArray >& DiskDrives, BYTE* pDiskNumber );
+ static bool    GetWmiDiskValues( BYTE physicalDrive,
+                                  const TArray< StringArray >& DiskDrives,
+                                  const TArray< StringArray >& PhysicalMedia,
+                                  UINT64* pDiskSizeBytes,
+                                  UINT64* pTotalCylinders,
+                                  DWORD*  pTotalHeads,
+                                  DWORD*  pSectorsPerTrack,
+                                  String* pMediaType,
+                                  String* pManufacturerName,
+                                  String* pModel,
+                                  String* pSerialNumber, String* pFirmwareRevision );
 
     protected:
         // Data members
@@ -85,20 +114,13 @@ class DiskInformation
 
         // Methods
         HANDLE CreateDiskHandle( const String& DiskName );
- static void   DiskSerialHexToSerialNumber( const String& SerialHex, String* pSerialNumber );
- static bool   ExtractIddStringValue( const BYTE* pbData,
-                                      size_t numBytes, String* pDataString );
- static void   FormatDiskFirmwareDataBlock( const PXSDDK::IDENTIFY_DEVICE_DATA* pIDD,
-                                            String* pIddString );
- static void   FormatIddStructureAsString( const PXSDDK::IDENTIFY_DEVICE_DATA* pIDD,
-                                           String* pFormattedIdd );
  static void   GetConfigManagerDiskData( String* pConfigManagerDiskData );
         bool   GetDataIdd( BYTE    physicalDrive,
                            WORD*   pBufferKB,
                            String* pSerialNumber,
                            String* pFirmwareRevision, bool* pSmartSupported, bool* pSmartEnabled );
         void   GetDataIoctl( BYTE physicalDrive, String* pSerialNumber, String* pFirmwareRevision );
- static bool   GetDataWMI( BYTE physicalDrive,
+        bool   GetDataWMI( BYTE physicalDrive,
                            UINT64* pDiskSizeBytes,
                            UINT64* pTotalCylinders,
                            DWORD* pTotalHeads,
@@ -108,7 +130,7 @@ class DiskInformation
                            String* pModel, String* pSerialNumber, String* pFirmwareRevision );
  static void   GetDiskPartionInfo( HANDLE hDisk, String* pDiskPartionInfo );
         void   GetDisksAndDevicesData( String* pDisksAndDevicesData );
- static void   GetFixedDiskControllerPosition( BYTE physicalDrive,
+        void   GetFixedDiskControllerPosition( BYTE physicalDrive,
                                                String* pRank, String* pMasterSlave );
         bool   GetIDDScsiMiniPort( BYTE physicalDrive, PXSDDK::IDENTIFY_DEVICE_DATA* pIDD );
         bool   GetIDDSmart( BYTE physicalDrive, PXSDDK::IDENTIFY_DEVICE_DATA* pIDD );
@@ -129,14 +151,17 @@ class DiskInformation
                                            String* pSerialNumber,
                                            String* pBusType, String* pErrorMessage );
  static void   GetWmiDiskDriveData( String* pWmiDiskDriveData );
- static bool   PhysDriveNumToDiskNum( BYTE physicalDrive, BYTE* pDiskNumber );
- static void   ResolveManufacturer( const String& Model, String* pManufacturerName );
+        void   LoadWmiDiskData();
+        bool   PhysDriveNumToDiskNum( BYTE physicalDrive, BYTE* pDiskNumber );
  static void   TranslateDeviceTypeQualifier( BYTE deviceTypeQualifier, String* pTranslation );
  static void   TranslateIdeDeviceType( UCHAR DeviceType, String* pTranslation );
  static void   TranslatePartitionType( BYTE PartitionType, String* pTranslation );
  static void   TranslateStorageBusType( BYTE BusType, String* pTranslation );
 
         // Data members
+        bool    m_bWmiDiskDataLoaded;
+        TArray< StringArray > m_WmiDiskDrives;      // Win32_DiskDrive
+        TArray< StringArray > m_WmiPhysicalMedia;   // Win32_PhysicalMedia Tag, SerialNumber
 };
 
 #endif  // WINAUDIT_DISK_INFORMATION_H_
@@ -70,7 +70,6 @@ class DisplayInformation
  static void GetDescriptionString( String* pDescriptionString );
  static void GetDiagnostics( String* pDiagnostics );
  static void GetIdentificationRecords( TArray< AuditRecord >* pRecords );
- static void ReadEdidHexFile( const String& FilePath, BYTE* pEdid, size_t bufferSize );
 
     protected:
         // Methods
@@ -93,24 +92,8 @@ class DisplayInformation
  static void GetPrimaryMonitorRecord( AuditRecord* pRecord );
  static void GetProductIdSizeString( String* pProductIdSizeString );
  static void GetResolutionString( String* pResolutionString );
- static bool IsValidEdidHeader( const BYTE* pEdid, size_t bufferSize );
  static bool ReadEdidDataBlock( const String& MonitorID,
                                 BYTE* pEdid, size_t bufferSize, String* pDeviceDesc );
- static void TranslateEdidData( const BYTE*   pEdid, size_t  bufferSize,
-                                bool*   pValidHeader, bool*   pValidCheckSum,
-                                String* pVersionRev , String* pManufacturerID,
-                                String* pProductID  , String* pSerialNumber,
-                                String* pManufacDate, String* pDigDisplay,
-                                String* pDisplaySize, String* pGamma,
-                                String* pDisplayType, String* pMonitorSerial,
-                                String* pTextData   , String* pMonitorName,
-                                String* pFeatures   , String* pEstTimings,
-                                String* pStdTimings , String* pHexData );
- static void TranslateEdidDescriptorBlock( const BYTE* pEdid,
-                                           size_t  bufferSize,
-                                           String* pMonitorSerial,
-                                           String* pTextData, String* pMonitorName );
- static void TranslateIdManufacturerCode( const String& PnPID, String* pManufacturerName );
         // Data members
 };
 
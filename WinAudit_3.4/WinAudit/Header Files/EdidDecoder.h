@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// EDID Decoder Class Header
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef WINAUDIT_EDID_DECODER_H_
+#define WINAUDIT_EDID_DECODER_H_
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Decodes Extended Display Identification Data (EDID) from a byte buffer, the
+// base block and any CEA-861 or DisplayID extension blocks. Nothing here reads
+// the registry or calls the display APIs so the same code serves the live
+// audit and the decoding of saved EDID dumps. A directory of dumps is decoded
+// by worker threads that share nothing but the index of the next file, each
+// puts its record in the file's slot.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Includes
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Header Files/WinAudit.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/Thread.h"
+
+// 5. This Project
+
+// 6. Forwards
+class AuditRecord;
+class ByteArray;
+class StringArray;
+template< class T > class TArray;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Interface
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class EdidDecoder : public Thread
+{
+    public:
+        // Default constructor
+        EdidDecoder();
+
+        // Destructor
+        ~EdidDecoder();
+
+        // Methods
+ static void DecodeDirectory( const String& DirectoryPath, TArray< AuditRecord >* pRecords );
+ static bool IsValidEdidHeader( const BYTE* pEdid, size_t bufferSize );
+ static void MakeEdidRecord( const BYTE* pEdid,
+                             size_t bufferSize,
+                             size_t itemNumber,
+                             const String& DeviceDesc,
+                             const String& Source, AuditRecord* pRecord );
+ static bool ReadEdidFile( const String& FilePath, ByteArray* pEdid );
+ static void TranslateEdidData( const BYTE*   pEdid, size_t  bufferSize,
+                                bool*   pValidHeader, bool*   pValidCheckSum,
+                                String* pVersionRev , String* pManufacturerID,
+                                String* pProductID  , String* pSerialNumber,
+                                String* pManufacDate, String* pDigDisplay,
+                                String* pDisplaySize, String* pGamma,
+                                String* pDisplayType, String* pMonitorSerial,
+                                String* pTextData   , String* pMonitorName,
+                                String* pFeatures   , String* pEstTimings,
+                                String* pStdTimings , String* pHexData );
+ static void TranslateExtensionBlocks( const BYTE* pEdid, size_t bufferSize, String* pExtensions );
+ static void TranslateIdManufacturerCode( const String& PnPID, String* pManufacturerName );
+ static void TranslatePreferredTiming( const BYTE* pEdid, size_t bufferSize, String* pResolution );
+
+    protected:
+        // Methods
+
+        // Data members
+
+    private:
+        // Work shared by the worker threads, each record slot belongs to the
+        // worker that took its file
+        typedef struct _TYPE_EDID_BATCH
+        {
+            const StringArray*     pFilePaths;
+            const StringArray*     pFileNames;
+            TArray< AuditRecord >* pRecords;
+            volatile LONG          nextIndex;
+        } TYPE_EDID_BATCH;
+
+        // Copy constructor - not allowed
+        EdidDecoder( const EdidDecoder& oEdidDecoder );
+
+        // Assignment operator - not allowed
+        EdidDecoder& operator= ( const EdidDecoder& oEdidDecoder );
+
+        // Methods
+ static bool DecodeFile( const String& FilePath, const String& FileName, AuditRecord* pRecord );
+ static void FormatTiming( DWORD pixelClockKHz,
+                           DWORD hActive,
+                           DWORD hBlank,
+                           DWORD vActive, DWORD vBlank, bool interlaced, String* pTiming );
+ static void TranslateCeaBlock( const BYTE* pBlock, String* pTranslation );
+ static void TranslateCeaDataBlock( const BYTE* pDataBlock, String* pTranslation );
+ static void TranslateDetailedTiming( const BYTE* pDescriptor, String* pTiming );
+ static void TranslateDisplayIdBlock( const BYTE* pBlock, String* pTranslation );
+ static void TranslateDisplayIdTiming( const BYTE* pDescriptor,
+                                       DWORD clockUnitKHz, String* pTiming );
+ static void TranslateEdidDescriptorBlock( const BYTE* pEdid,
+                                           size_t  bufferSize,
+                                           String* pMonitorSerial,
+                                           String* pTextData, String* pMonitorName );
+        DWORD RunWorkerThread() override;
+
+        // Data members
+        TYPE_EDID_BATCH* m_pBatchMT;        // Shared variable
+};
+
+#endif  // WINAUDIT_EDID_DECODER_H_
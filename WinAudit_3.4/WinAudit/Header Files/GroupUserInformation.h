@@ -50,6 +50,7 @@
 
 // 6. Forwards
 class AuditRecord;
+class StringHashIndex;
 template< class T > class TArray;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -69,7 +70,18 @@ class GroupUserInformation
  static void GetGroupRecords( TArray< AuditRecord >* pRecords );
  static void GetGroupMemberRecords( TArray< AuditRecord >* pRecords );
  static void GetGroupPolicyRecords( TArray< AuditRecord >* pRecords );
+ static void GetMemberGroups( const String& MemberName,
+                              bool localGroups,
+                              bool haveIndex,
+                              const StringArray& Members,
+                              const StringArray& GroupLists,
+                              const StringHashIndex& MemberIndex, String* pGroups );
  static void GetUserRecords( TArray< AuditRecord >* pRecords );
+ static void MakeMembershipIndex( const StringArray& GroupNames,
+                                  const TArray< StringArray >& GroupMembers,
+                                  const String& DomainPrefix,
+                                  StringArray* pMembers,
+                                  StringArray* pGroupLists, StringHashIndex* pMemberIndex );
 
     protected:
         // Methods
@@ -84,6 +96,13 @@ class GroupUserInformation
         GroupUserInformation& operator= ( const GroupUserInformation& oGroupUserInformation );
 
         // Methods
+ static void AddMembership( const String& MemberName,
+                            const String& GroupName,
+                            StringArray* pMembers,
+                            StringArray* pGroupLists, StringHashIndex* pMemberIndex );
+ static size_t FindMembership( const String& MemberName,
+                               const StringArray& Members, const StringHashIndex& MemberIndex );
+ static void GetAccountDomainName( String* pDomainName );
  static void GetGlobalGroupComment( const String& GroupName, String* pComment );
  static void GetGlobalGroupMembers( const String& GroupName, StringArray* pMembers );
  static void GetGlobalGroupNames( StringArray* pNames );
@@ -91,9 +110,16 @@ class GroupUserInformation
  static void GetLocalGroupComment( const String& GroupName, String* pComment );
  static void GetLocalGroupMembers3( const String& GroupName, StringArray* pMembers );
  static void GetLocalGroupNames( StringArray* pGroupNames );
+ static void GetMembershipIndex( bool localGroups,
+                                 StringArray* pMembers,
+                                 StringArray* pGroupLists, StringHashIndex* pMemberIndex );
  static void GetUserGlobalGroups( const String& UserName, String* pGlobalGroups );
- static void GetUserInfo_4( const String& UserName, bool* pPasswordExpired,
-                            DWORD* pAccountExpires );
+ static bool GetUserInfo_4( const String& UserName,
+                            DWORD* pPasswordAge,
+                            DWORD* pLastLogon,
+                            DWORD* pLastLogoff,
+                            DWORD* pNumberLogons,
+                            DWORD* pNumBadLogons, bool* pPasswordExpired, DWORD* pAccountExpires );
  static void GetUserInfo_11( const String& UserName,
                              DWORD* pPasswordAge,
                              DWORD* pLastLogon,
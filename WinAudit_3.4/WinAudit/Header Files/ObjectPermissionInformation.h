@@ -50,6 +50,7 @@
 // 5. This Project
 
 // 6. Forwards
+class AccountNameCache;
 class AuditRecord;
 template< class T > class TArray;
 
@@ -67,7 +68,8 @@ class ObjectPermissionInformation
         ~ObjectPermissionInformation();
 
         // Methods
- static void GetAuditRecords( TArray< AuditRecord >* pRecords );
+ static void GetAuditRecords( AccountNameCache* pAccountNameCache,
+                             TArray< AuditRecord >* pRecords );
 
     protected:
         // Methods
@@ -83,13 +85,13 @@ class ObjectPermissionInformation
 
         // Methods
 
- static void GetAccountNameFromSid( const PSID pSid, String* pAccountName);
  static void GetDesktopSecurity( PSECURITY_DESCRIPTOR* ppSecurityDescriptor );
  static void GetNonWindowSecurity( const String& ObjectName,
                                    SE_OBJECT_TYPE objectType,
                                    PSECURITY_DESCRIPTOR* ppSecurityDescriptor);
  static void GetObjectPermissionRecords( const String& ObjectName,
                                          SE_OBJECT_TYPE objectType,
+                                         AccountNameCache* pAccountNameCache,
                                          TArray< AuditRecord >* pRecords );
  static void GetWorkStationSecurity( PSECURITY_DESCRIPTOR* ppSecurityDescriptor );
  static bool HasAllAccess( ACCESS_MASK accessMask, SE_OBJECT_TYPE type, bool workStation );
@@ -97,6 +99,7 @@ class ObjectPermissionInformation
                                           SE_OBJECT_TYPE type,
                                           bool workStation,
                                           PSECURITY_DESCRIPTOR pSecurityDescriptor,
+                                          AccountNameCache* pAccountNameCache,
                                           TArray< AuditRecord >* pRecords );
  static void TranslateAccessMask( ACCESS_MASK accessMask,
                                   SE_OBJECT_TYPE type,
@@ -180,6 +180,10 @@ class Odbc
                           SQLINTEGER Attribute,
                           SQLPOINTER ValuePtr,
                           SQLINTEGER StringLength );
+ static void Statistics( SQLHSTMT     StatementHandle,
+                         const String& CatalogName,
+                         const String& SchemaName,
+                         const String& TableName, SQLUSMALLINT Unique, SQLUSMALLINT Reserved );
  static void Tables( SQLHSTMT  StatementHandle,
                      const String& CatalogName,
                      const String& SchemaName,
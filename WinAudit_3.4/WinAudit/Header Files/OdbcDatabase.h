@@ -51,6 +51,8 @@
 #include "WinAudit/Header Files/Odbc.h"
 
 // 6. Forwards
+class StringArray;
+template< class T > class TArray;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Interface
@@ -72,14 +74,17 @@ class OdbcDatabase
                          DWORD connectTimeoutSecs, DWORD queryTimeoutSecs, HWND hWnd );
         void    Disconnect();
         SQLLEN  ExecuteDirect( const String& SqlQuery );
+        size_t  ExecuteSelectParams( const String& SqlQuery,
+                                     const StringArray& Parameters, TArray< StringArray >* pRows );
         bool    ExecuteSelectSqlInteger( const String& SqlQuery, SQLINTEGER* pSqlInteger );
-        void    ExecuteTrans( const String& SqlQuery,
+        SQLLEN  ExecuteTrans( const String& SqlQuery,
                               SQLLEN maxRecordsAffected = PXS_SQLLEN_MAX );
         void    FixUpStringSQL( const String& Input, SQLSMALLINT sqlType, String* pOutput ) const;
         SQLHDBC GetConnectionHandle() const;
         void    GetDbKeyWord( LPCWSTR pszAnsiKeyword, String* pDbKeyword );
         void    GetDatabaseName( String* pDatabaseName );
 const String&   GetDbmsName() const;
+        void    GetIndexes( const String& TableName, StringArray* pIndexes );
         void    GetMajorMinorVersion( int* pMajor, int* pMinor ) const;
         void    GetProcedures( const String& Filter, StringArray* pProcedures );
 const String&   GetServerName() const;
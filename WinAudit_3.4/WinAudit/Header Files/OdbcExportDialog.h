@@ -33,6 +33,10 @@
 // Remarks
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// The Audit_Data rows are bound row-wise into one buffer that is kept between
+// exports and only grown when an audit has more records than it holds, so a
+// dialog can be reused to export many audits.
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Includes
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -93,15 +97,14 @@ class OdbcExportDialog: public Dialog
         // Data members
 
     private:
-        // Holds column properties, see SQLBindCol
+        // Holds column properties, see SQLBindCol. The offsets are into a row
         typedef struct _TYPE_COLUMN_PROPS
         {
             SQLSMALLINT  TargetType;
             SQLSMALLINT  sqlType;
             SQLLEN       BufferLength;
-            BYTE*        TargetValuePtr;
-            SQLLEN*      StrLen_or_Ind;
-            size_t       numBytes;
+            size_t       valueOffset;
+            size_t       indicatorOffset;
         } TYPE_COLUMN_PROPS;
 
         // Constants
@@ -119,6 +122,7 @@ class OdbcExportDialog: public Dialog
         void    FillAuditDataBindBuffers( SQLINTEGER auditID,
                                           SQLINTEGER computerID );
         void    FreeAuditDataBindBuffers();
+ static SQLSMALLINT GetBindSqlType( SQLSMALLINT columnType );
         void    SetProgressMessage( const String& ProgressMessage );
         void    ShowAdminDialog();
         void    UpdateConfigurationSettings();
@@ -127,7 +131,10 @@ class OdbcExportDialog: public Dialog
         bool                  m_bDidExport;
         size_t                m_idxProgressMessageStatic;
         size_t                m_uNumColumns;
+        size_t                m_uRowBytes;
+        size_t                m_uRowCapacity;
         TYPE_COLUMN_PROPS*    m_pColumnProps;
+        BYTE*                 m_pRowBuffer;
         SQLUSMALLINT*         m_pRowStatus;
         AuditRecord           m_AuditMasterRecord;
         AuditRecord           m_ComputerMasterRecord;
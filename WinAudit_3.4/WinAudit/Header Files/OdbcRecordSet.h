@@ -33,6 +33,12 @@
 // Remarks
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Rows are fetched in blocks using row-wise binding, the cache holds exactly
+// one block. Unless set by the caller, the block size is derived from the row
+// width so that the cache stays within a fixed memory budget. With the default
+// forward-only cursor the previous block is overwritten, so arbitrarily large
+// results are streamed with constant memory.
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Includes
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -70,6 +76,8 @@ class OdbcRecordSet
         void        Close();
       const String& FieldValue( size_t idxColumn );
       const String& FieldValue( size_t idxRow, size_t idxColumn );
+        bool        FieldDouble( size_t idxColumn, double* pValue );
+        bool        FieldInt64( size_t idxColumn, __int64* pValue );
         size_t      GetColumnCount() const;
         LPCWSTR     GetColumnDisplayName( size_t idxColumn ) const;
         size_t      GetColumnDisplaySizeChars( size_t idxColumn ) const;
@@ -85,6 +93,7 @@ class OdbcRecordSet
         bool        Move( size_t idxRow );
         bool        MoveNext();
         void        Open( const String& SqlQuery, OdbcDatabase* pDatabase );
+        void        SetFetchBlockSize( size_t numRows );
 
     protected:
         // Methods
@@ -126,6 +135,7 @@ class OdbcRecordSet
         void    FlllColumnDisplayName();
         void    FillColumnProperties( const String& Dbms );
         BYTE*   GetDataPointerInCache( size_t idxRow, size_t idxColumn );
+        bool    GetFieldNumber( size_t idxColumn, __int64* pInt64, double* pDouble );
         SQLLEN  GetIndicatorValue( size_t idxRow, size_t idxColumn );
         void    UnbindAndDeleteCache();
         void    ZeroCache( size_t idxOffset );
@@ -134,6 +144,9 @@ class OdbcRecordSet
         size_t          ROW_ARRAY_SIZE;
         size_t          MAX_COLUMN_LENGTH_BYTES;
         size_t          MAX_CACHE_RECORDS;
+        size_t          MAX_ROW_ARRAY_SIZE;
+        size_t          CACHE_BUDGET_BYTES;
+        size_t          m_uFetchBlockSize;
         size_t          m_uNumColumns;
         size_t          m_uCacheSize;
         size_t          m_uCacheRowSizeBytes;
@@ -50,6 +50,7 @@
 
 // 6. Forwards
 class AuditRecord;
+class ProcessInformation;
 template< class T > class TArray;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -66,7 +67,7 @@ class OpenNetworkPortInformation
         ~OpenNetworkPortInformation();
 
         // Methods
-        void GetAuditRecords( TArray< AuditRecord >* pRecords );
+        void GetAuditRecords( ProcessInformation* pProcessInfo, TArray< AuditRecord >* pRecords );
 
     protected:
         // Methods
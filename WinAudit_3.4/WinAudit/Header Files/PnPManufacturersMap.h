@@ -0,0 +1,300 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Plug and Play Manufacturers Map Header
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef WINAUDIT_PNP_MANUFACTURERS_MAP_H_
+#define WINAUDIT_PNP_MANUFACTURERS_MAP_H_
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Table to map a 3 letter Plug and Play vendor identifier to a manufacturer's
+// name. Searched with a binary search so it is checked at compile time.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Includes
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Header Files/WinAudit.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+
+// 5. This Project
+
+// 6. Forwards
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Map
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The array must be in ordinal order of the identifiers with no duplicates and
+// identifiers must be upper case, see the static_assert below
+constexpr PXS_TYPE_PNP_MANUFACTURER PXS_PNP_ID_MANUFACTURERS[] =
+    {
+      { L"ACC", L"Accton Technology Corp"       },
+      { L"ACR", L"Acer Corporation"             },
+      { L"ACS", L"ACS"                          },
+      { L"ACT", L"Actebis"                      },
+      { L"ACU", L"NCR"                          },
+      { L"ADD", L"Addtron"                      },
+      { L"ADI", L"ADI Systems Inc"              },
+      { L"ADP", L"Adaptec"                      },
+      { L"ADV", L"AMD"                          },
+      { L"ALS", L"Advance Logic (ADL) Inc"      },
+      { L"AMB", L"Ambient Technologies Inc"     },
+      { L"AMP", L"Amptron"                      },
+      { L"AMT", L"V7 Video Seven"               },
+      { L"ANX", L"Acer Netxus Inc."             },
+      { L"AOC", L"AOC International (USA) Ltd." },
+      { L"API", L"Benq Corp"                    },
+      { L"APP", L"Apple Computer"               },
+      { L"ART", L"Artmedia"                     },
+      { L"ASC", L"AdvanSys"                     },
+      { L"AST", L"AST"                          },
+      { L"ATI", L"ATI"                          },
+      { L"ATK", L"ATKK"                         },
+      { L"AXS", L"Analog Devices"               },
+      { L"AZT", L"Aztech"                       },
+      { L"AZU", L"Azura"                        },
+      { L"BDP", L"BestData"                     },
+      { L"BMM", L"Proview"                      },
+      { L"BRG", L"Bridge"                       },
+      { L"BRI", L"Boca"                         },
+      { L"BUS", L"Buslogic"                     },
+      { L"CAC", L"Cardinal"                     },
+      { L"CCP", L"Epson"                        },
+      { L"CIR", L"Cirrus Logic"                 },
+      { L"CMI", L"C-Media Electronics Inc"      },
+      { L"CPI", L"CPI"                          },
+      { L"CPL", L"Compal Electronics"           },
+      { L"CPQ", L"Compaq"                       },
+      { L"CRN", L"Cornerstone Imaging"          },
+      { L"CRX", L"Cyrix Corporation"            },
+      { L"CSC", L"Crystal"                      },
+      { L"CSI", L"Cabletron"                    },
+      { L"CTL", L"Creative"                     },
+      { L"CTX", L"Chuntex Electronic"           },
+      { L"CYB", L"CyberVision"                  },
+      { L"DBK", L"Databook"                     },
+      { L"DEL", L"Dell Computer Corp"           },
+      { L"DMB", L"Digicom System"               },
+      { L"DNV", L"Xenon"                        },
+      { L"DPC", L"Delta Electronics"            },
+      { L"DPT", L"DPT"                          },
+      { L"DRT", L"Digital Research"             },
+      { L"DVC", L"DecaView"                     },
+      { L"DWE", L"Daewoo"                       },
+      { L"DWT", L"Korea Data Systems"           },
+      { L"ECS", L"ELITEGROUP Computer Systems"  },
+      { L"EIZ", L"Eizo"                         },
+      { L"ELS", L"ELSA GmbH"                    },
+      { L"EMC", L"ProView (EMC)"                },
+      { L"EPI", L"EnVision Inc"                 },
+      { L"ESS", L"ESS Technology Inc"           },
+      { L"FAR", L"Farallon"                     },
+      { L"FCM", L"Funai"                        },
+      { L"FDC", L"Future Domain"                },
+      { L"FPA", L"Fujutsu"                      },
+      { L"FUJ", L"Fujitsu"                      },
+      { L"FUS", L"Fujitsu Siemens"              },
+      { L"GSM", L"LG Electronics Inc."          },
+      { L"GVT", L"G-Vision"                     },
+      { L"GWY", L"Gateway 2000"                 },
+      { L"HAY", L"Hayes Microcomputer Products" },
+      { L"HCM", L"HCL Peripherals"              },
+      { L"HEI", L"Hyundai Electronics"          },
+      { L"HIT", L"Hitachi"                      },
+      { L"HSL", L"Hansol Electronics"           },
+      { L"IBM", L"IBM"                          },
+      { L"ICL", L"Fujitsu ICL"                  },
+      { L"INT", L"Intel Corporation"            },
+      { L"IOD", L"I-O Data"                     },
+      { L"IQT", L"ImageQuest"                   },
+      { L"ISA", L"Iomega"                       },
+      { L"IVM", L"Idek Iiyama North America"    },
+      { L"IXD", L"Intertex"                     },
+      { L"JEN", L"Jean"                         },
+      { L"KFC", L"KFC Computek"                 },
+      { L"KOR", L"KXPro"                        },
+      { L"KTC", L"Kingston Technology Corp"     },
+      { L"KTR", L"IMRI"                         },
+      { L"KYE", L"KYE Systems Corp"             },
+      { L"LEN", L"Lenovo"                       },
+      { L"LEO", L"LEO Systems"                  },
+      { L"LKM", L"Likom"                        },
+      { L"LNK", L"LINK Technologie"             },
+      { L"LTN", L"Lite-on Technology Corp."     },
+      { L"MAX", L"Maxdata Computer GmbH"        },
+      { L"MDD", L"Modis"                        },
+      { L"MDG", L"Madge"                        },
+      { L"MDY", L"Microdyne"                    },
+      { L"MED", L"Medion"                       },
+      { L"MEI", L"Panasonic"                    },
+      { L"MEL", L"Mitsubishi Electronics"       },
+      { L"MIR", L"Miro Computer Products AG"    },
+      { L"MOT", L"Motorola"                     },
+      { L"MS_", L"Microsoft Corp"               },
+      { L"MTC", L"Mitac"                        },
+      { L"NAN", L"Nanao"                        },
+      { L"NCD", L"NCD"                          },
+      { L"NCI", L"Packard Bell"                 },
+      { L"NCL", L"Netcomm"                      },
+      { L"NLM", L"Newcomm"                      },
+      { L"NMX", L"Neomagic Corp"                },
+      { L"NOK", L"Nokia"                        },
+      { L"NVL", L"Novell/Anthem"                },
+      { L"OEC", L"Daytek"                       },
+      { L"OKI", L"OKI"                          },
+      { L"OLC", L"Olicom"                       },
+      { L"OLI", L"Olivett"                      },
+      { L"OPT", L"OPTi Inc"                     },
+      { L"OQI", L"Optiquest"                    },
+      { L"OZO", L"Zoom Telephonics Inc"         },
+      { L"PEA", L"Peacock"                      },
+      { L"PEI", L"Proton"                       },
+      { L"PGS", L"Princeton Graphic Systems"    },
+      { L"PLB", L"Philips Consumer Electronics" },
+      { L"PMC", L"Pace"                         },
+      { L"PMV", L"MAG Technology Co"            },
+      { L"PPI", L"Practical Peripherals"        },
+      { L"PRO", L"Proteon"                      },
+      { L"RDS", L"Radius (KDS)"                 },
+      { L"REL", L"Relisys"                      },
+      { L"RII", L"Racal"                        },
+      { L"RPT", L"RPTI"                         },
+      { L"RTL", L"Realtek Semiconductor Corp"   },
+      { L"SAM", L"Samsung"                      },
+      { L"SCM", L"SCM"                          },
+      { L"SGX", L"Silicon Graphics"             },
+      { L"SHP", L"Sharp Corp"                   },
+      { L"SHT", L"SHINHO"                       },
+      { L"SIB", L"Sanyo"                        },
+      { L"SIE", L"Siemens"                      },
+      { L"SKD", L"SysKonnect"                   },
+      { L"SLI", L"LSI Logic"                    },
+      { L"SMC", L"SMC"                          },
+      { L"SML", L"Smile Technologies"           },
+      { L"SNI", L"Siemens Nixdorf"              },
+      { L"SNY", L"Sony Corporation"             },
+      { L"SPT", L"Sceptre"                      },
+      { L"SRC", L"Shamrock"                     },
+      { L"SSC", L"Sierra Semiconductor"         },
+      { L"STA", L"Stesa"                        },
+      { L"STN", L"Samtron"                      },
+      { L"SUN", L"Sun"                          },
+      { L"SUP", L"Diamond Multimedia"           },
+      { L"SVE", L"SVEC"                         },
+      { L"SYL", L"Sylvania"                     },
+      { L"SYN", L"Synaptics"                    },
+      { L"TAT", L"Tatung"                       },
+      { L"TAX", L"Taxan"                        },
+      { L"TCI", L"Tulip"                        },
+      { L"TCM", L"3Com Corp"                    },
+      { L"TCO", L"Thomas-Conrad Corp"           },
+      { L"TEA", L"Teac"                         },
+      { L"TEI", L"TECO"                         },
+      { L"TEO", L"Teco Information Systems"     },
+      { L"TER", L"TerraTec Electronic GmbH"     },
+      { L"TOS", L"Toshiba"                      },
+      { L"TRL", L"Royal Information Company"    },
+      { L"TRU", L"Aashima Technology B.V."      },
+      { L"TTK", L"Totoku / TeleVideo"           },
+      { L"TTX", L"TTX"                          },
+      { L"TVD", L"Trans Video Deutschland"      },
+      { L"TVI", L"TeleVideo"                    },
+      { L"TVM", L"TVM"                          },
+      { L"TVP", L"Top Victory Electronics"      },
+      { L"UMC", L"UMC Electronics Co Ltd"       },
+      { L"UNM", L"Unisys Corporation"           },
+      { L"USC", L"UltraStor"                    },
+      { L"UTB", L"Utobia"                       },
+      { L"VDM", L"Vadem"                        },
+      { L"VES", L"Vestel"                       },
+      { L"VIA", L"VIA Technologies Inc"         },
+      { L"VOB", L"VOBIS"                        },
+      { L"VSC", L"ViewSonic Corporation"        },
+      { L"WCI", L"Conexant Systems"             },
+      { L"WEC", L"Winbond Electronics Corp"     },
+      { L"WTC", L"Wen Technology"               },
+      { L"XDM", L"Yi Ray Electronic Co."        },
+      { L"XOC", L"Sky Wide Technology"          },
+      { L"YMH", L"YAMAHA Corp"                  },
+      { L"ZCM", L"Zenith Data Systems"          },
+      { L"ZDS", L"Zeos"                         },
+      { L"ZIN", L"Zhi-Ying Display Equipment"   }
+    };
+
+// Test the identifiers are 3 upper case characters in ascending ordinal order
+constexpr bool PXSIsPnPManufacturersMapValid( const PXS_TYPE_PNP_MANUFACTURER* pManufacturers,
+                                              size_t numManufacturers )
+{
+    for ( size_t i = 0; i < numManufacturers; i++ )
+    {
+        LPCWSTR pszPnPID = pManufacturers[ i ].pszPnPID;
+        for ( size_t j = 0; j < 3; j++ )
+        {
+            wchar_t ch = pszPnPID[ j ];
+            if ( ( ( ch < 'A' ) || ( ch > 'Z' ) ) && ( ch != '_' ) )
+            {
+                return false;
+            }
+        }
+
+        if ( pszPnPID[ 3 ] != 0 )
+        {
+            return false;
+        }
+
+        if ( i > 0 )
+        {
+            LPCWSTR pszPrevious = pManufacturers[ i - 1 ].pszPnPID;
+            size_t  j = 0;
+            while ( ( j < 3 ) && ( pszPrevious[ j ] == pszPnPID[ j ] ) )
+            {
+                j++;
+            }
+
+            if ( ( j == 3 ) || ( pszPrevious[ j ] > pszPnPID[ j ] ) )
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static_assert( PXSIsPnPManufacturersMapValid( PXS_PNP_ID_MANUFACTURERS,
+                                              ARRAYSIZE( PXS_PNP_ID_MANUFACTURERS ) ),
+               "PXS_PNP_ID_MANUFACTURERS must be upper case, sorted and unique" );
+
+#endif  // WINAUDIT_PNP_MANUFACTURERS_MAP_H_
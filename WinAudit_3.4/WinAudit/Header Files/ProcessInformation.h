@@ -33,6 +33,10 @@
 // Remarks
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// The process table is a snapshot taken once by FillProcessesInfo and then
+// shared by the running processes, open ports and loaded modules categories.
+// Lookups by process id go through a hash index so they do not scan the table.
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Includes
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -45,12 +49,14 @@
 // 3. C++ System Files
 
 // 4. Other Libraries
+#include "PxsBase/Header Files/StringHashIndex.h"
 #include "PxsBase/Header Files/TArray.h"
 
 // 5. This Project
 
 // 6. Forwards
 class AuditRecord;
+class StringArray;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Interface
@@ -69,9 +75,12 @@ class ProcessInformation
  static void ChangePrivilege( LPCWSTR pszPrivilege, bool enable );
         void FillProcessesInfo();
         void GetExePath( DWORD processID, String* pExePath ) const;
- static void GetLoadedModuleRecords( TArray< AuditRecord >* pRecords );
+        void GetExeVersion( DWORD processID, String* pManufacturerName, String* pDescription );
+        void GetLoadedModuleRecords( TArray< AuditRecord >* pRecords );
         void GetRunningProcesseRecords( TArray< AuditRecord >* pRecords );
  static bool IsPrivilegeEnabled( LPCWSTR pszPrivilege );
+        void Reset();
+        void SetProcesses( const TArray< DWORD >& ProcessIDs, const StringArray& ExePaths );
 
     protected:
         // Methods
@@ -83,9 +92,12 @@ class ProcessInformation
         typedef struct _TYPE_PROCESS_INFO
         {
             DWORD   processID;                  // Process ID
+            bool    versionRead;                // Version resource has been read
             size_t  workingSet;                 // Working Set Memory - WinNT
             wchar_t szExeName[ MAX_PATH + 1 ];  // Executable file name
             wchar_t szExePath[ MAX_PATH + 1 ];  // Executable file path
+            wchar_t szManufacturer[ 256 ];      // Cached from the version resource
+            wchar_t szDescription[ 256 ];       // Cached from the version resource
         } TYPE_PROCESS_INFO;
 
         // Copy constructor - not allowed
@@ -95,10 +107,15 @@ class ProcessInformation
         ProcessInformation& operator= ( const ProcessInformation& oProcess );
 
         // Methods
-        size_t GetMemoryUsage( DWORD processID ) const;
+        void   AppendProcess( const TYPE_PROCESS_INFO& ProcessInfo );
+        size_t FindProcess( DWORD processID ) const;
  static size_t GetWorkingSetSize( DWORD processID );
+        void   IndexProcesses();
 
         // Data members
+        bool    m_bFilled;
+        size_t  m_numProcesses;
+        StringHashIndex m_ProcessIndex;     // Keyed on process id
         TArray< TYPE_PROCESS_INFO > m_Processes;
 };
 
@@ -51,6 +51,7 @@
 // 5. This Project
 
 // 6. Forwards
+class AccountNameCache;
 class AuditRecord;
 template< class T > class TArray;
 
@@ -75,7 +76,8 @@ class SecurityInformation
  static void GetRSOPSecuritySetting( LPCWSTR pszKeyName, VARTYPE varType, String* pSetting );
  static void GetSecuritySettingsRecords( TArray< AuditRecord >* pRecords );
  static void GetSystemRestorePointRecords( TArray< AuditRecord >* pRecords );
- static void GetUserRightsAssignmentRecords( TArray< AuditRecord >* pRecords );
+ static void GetUserRightsAssignmentRecords( AccountNameCache* pAccountNameCache,
+                                            TArray< AuditRecord >* pRecords );
 
     protected:
         // Methods
@@ -91,7 +93,9 @@ class SecurityInformation
 
         // Methods
  static void EnumerationInformationToAccounts( const LSA_ENUMERATION_INFORMATION* pEnumeration,
-                                               ULONG count, String* pAccounts );
+                                               ULONG count,
+                                               AccountNameCache* pAccountNameCache,
+                                               String* pAccounts );
  static void MakeAccountLockingRecords( TArray< AuditRecord >* pRecords );
  static void MakeAccountSettingsRecords( TArray< AuditRecord >* pRecords );
  static void MakeAuditPolicyRecords( TArray< AuditRecord >* pRecords );
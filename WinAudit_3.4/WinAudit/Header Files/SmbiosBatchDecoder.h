@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// SMBIOS Batch Decoder Class Header
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef WINAUDIT_SMBIOS_BATCH_DECODER_H_
+#define WINAUDIT_SMBIOS_BATCH_DECODER_H_
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Decodes a directory of SMBIOS dumps collected from other computers. Each
+// dump is written to its own output file so the worker threads share nothing
+// but the index of the next dump to decode.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Includes
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/Thread.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/WinAudit.h"
+
+// 6. Forwards
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Interface
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class SmbiosBatchDecoder : public Thread
+{
+    public:
+        // Default constructor
+        SmbiosBatchDecoder();
+
+        // Destructor
+        ~SmbiosBatchDecoder();
+
+        // Methods
+ static void DecodeDirectory( const String& DirectoryPath, const String& FileSwitchValue );
+
+    protected:
+        // Methods
+
+        // Data members
+
+    private:
+        // Work shared by the worker threads, read-only apart from the counters
+        typedef struct _TYPE_SMBIOS_BATCH
+        {
+            const StringArray* pDumpPaths;
+            const StringArray* pOutputPaths;
+            volatile LONG      nextIndex;
+            volatile LONG      numDecoded;
+        } TYPE_SMBIOS_BATCH;
+
+        // Copy constructor - not allowed
+        SmbiosBatchDecoder( const SmbiosBatchDecoder& oSmbiosBatchDecoder );
+
+        // Assignment operator - not allowed
+        SmbiosBatchDecoder& operator= ( const SmbiosBatchDecoder& oSmbiosBatchDecoder );
+
+        // Methods
+ static void  DecodeDump( const String& DumpPath, const String& OutputPath );
+        DWORD RunWorkerThread() override;
+
+        // Data members
+        TYPE_SMBIOS_BATCH* m_pBatchMT;      // Shared variable
+};
+
+#endif  // WINAUDIT_SMBIOS_BATCH_DECODER_H_
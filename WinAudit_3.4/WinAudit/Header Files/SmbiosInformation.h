@@ -81,6 +81,9 @@ class SmbiosInformation
         DWORD GetTotalRamMB() const;
         void  ReadSmbiosData();
         void  ReadSmbiosDataFromFile();
+        void  ReadSmbiosDumpFile( const String& FilePath );
+        void  SetSmbiosData( const BYTE* pTable,
+                             size_t tableLength, BYTE majorVersion, BYTE minorVersion );
 
     protected:
         // Methods
@@ -0,0 +1,189 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// SQLite Database Class Header
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef WINAUDIT_SQLITE_DATABASE_H_
+#define WINAUDIT_SQLITE_DATABASE_H_
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Writes audits to a local SQLite file with the same Computer_Master,
+// Audit_Master and Audit_Data tables as an ODBC database so the files can be
+// collected and merged centrally. sqlite3.dll is loaded at run time from the
+// application's directory, there is no build or installation dependency.
+//
+// The file is opened in write-ahead log mode so readers do not block the
+// export. Each audit is one transaction and the Audit_Data rows are inserted
+// with a single prepared statement that is reset and re-bound for each row.
+// Old audits are purged in batches with the same retention predicate as an
+// ODBC database.
+//
+// A new file can instead keep the audit data as a value dictionary. Each
+// distinct value is stored once in Audit_Value and Audit_Item has one narrow
+// row per non-empty item. An Audit_Data view pivots the items back into
+// columns so the category views and reports work on either layout.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Includes
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/Library.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/WinAudit.h"
+
+// 6. Forwards
+class AuditRecord;
+class String;
+class StringArray;
+template< class T > class TArray;
+
+// SQLite's opaque handles and the signatures of the functions used
+struct sqlite3;
+struct sqlite3_stmt;
+
+typedef void ( __cdecl *LPFN_SQLITE3_DESTRUCTOR )( void* );
+typedef int  ( __cdecl *LPFN_SQLITE3_BIND_INT64 )( sqlite3_stmt*, int, __int64 );
+typedef int  ( __cdecl *LPFN_SQLITE3_BIND_NULL )( sqlite3_stmt*, int );
+typedef int  ( __cdecl *LPFN_SQLITE3_BIND_TEXT16 )( sqlite3_stmt*,
+                                                    int, const void*, int,
+                                                    LPFN_SQLITE3_DESTRUCTOR );
+typedef int  ( __cdecl *LPFN_SQLITE3_BUSY_TIMEOUT )( sqlite3*, int );
+typedef int  ( __cdecl *LPFN_SQLITE3_CLOSE )( sqlite3* );
+typedef __int64 ( __cdecl *LPFN_SQLITE3_COLUMN_INT64 )( sqlite3_stmt*, int );
+typedef const void* ( __cdecl *LPFN_SQLITE3_ERRMSG16 )( sqlite3* );
+typedef int  ( __cdecl *LPFN_SQLITE3_FINALIZE )( sqlite3_stmt* );
+typedef __int64 ( __cdecl *LPFN_SQLITE3_LAST_INSERT_ROWID )( sqlite3* );
+typedef int  ( __cdecl *LPFN_SQLITE3_OPEN16 )( const void*, sqlite3** );
+typedef int  ( __cdecl *LPFN_SQLITE3_PREPARE16_V2 )( sqlite3*,
+                                                     const void*, int,
+                                                     sqlite3_stmt**, const void** );
+typedef int  ( __cdecl *LPFN_SQLITE3_RESET )( sqlite3_stmt* );
+typedef int  ( __cdecl *LPFN_SQLITE3_STEP )( sqlite3_stmt* );
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Interface
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class SqliteDatabase
+{
+    public:
+        // Default constructor
+        SqliteDatabase();
+
+        // Destructor
+        ~SqliteDatabase();
+
+        // Methods
+        void   Close();
+        size_t CountOldAudits( DWORD retainCount, DWORD retainDays );
+        size_t DeleteOldAuditsBatch( DWORD retainCount,
+                                     DWORD retainDays,
+                                     DWORD batchSize, __int64* pLastAuditID );
+        void   ExportAudit( const AuditRecord& ComputerMaster,
+                            const AuditRecord& AuditMaster,
+                            const TArray< AuditRecord >& AuditRecords, String* pResultMessage );
+ static bool   IsSqliteFilePath( const String& FilePath );
+        void   Open( const String& FilePath, bool valueDictionary );
+
+    protected:
+        // Methods
+
+        // Data members
+
+    private:
+        // Copy constructor - not allowed
+        SqliteDatabase( const SqliteDatabase& oSqliteDatabase );
+
+        // Assignment operator - not allowed
+        SqliteDatabase& operator= ( const SqliteDatabase& oSqliteDatabase );
+
+        // Methods
+        void    BindInt64( sqlite3_stmt* pStmt, int index, __int64 value );
+        void    BindText( sqlite3_stmt* pStmt, int index, LPCWSTR pszValue, size_t numChars );
+        void    CreateTables( bool valueDictionary );
+        void    Execute( LPCWSTR pszSql );
+        void    Finalize( sqlite3_stmt* pStmt );
+ static size_t  GetItemMaxChars( size_t index );
+        bool    HasSchemaObject( LPCWSTR pszType, LPCWSTR pszName );
+        __int64 IdentifyComputerID( const StringArray& Keys );
+        size_t  InsertAuditData( __int64 auditID,
+                                 __int64 computerID, const TArray< AuditRecord >& AuditRecords );
+        size_t  InsertAuditItems( __int64 auditID,
+                                  __int64 computerID, const TArray< AuditRecord >& AuditRecords );
+        __int64 InsertAuditMaster( __int64 computerID, const AuditRecord& AuditMaster );
+        __int64 InsertComputerMaster( const AuditRecord& ComputerMaster,
+                                      const StringArray& Keys );
+        void    LoadSqliteLibrary();
+        void    LookupValueIDs( const TArray< AuditRecord >& AuditRecords,
+                                const TArray< size_t >& DistinctRefs,
+                                size_t numDistinct, TArray< __int64 >* pValueIDs );
+        sqlite3_stmt* Prepare( LPCWSTR pszSql );
+        void    SetLastAuditID( __int64 computerID, __int64 auditID );
+        bool    Step( sqlite3_stmt* pStmt );
+        void    ThrowSqliteError( int result, LPCWSTR pszDetails, const char* pszFunction );
+
+        // SQLite result codes
+        static const int RESULT_OK   = 0;
+        static const int RESULT_ROW  = 100;
+        static const int RESULT_DONE = 101;
+
+        // Audit_Data item columns, the first are wide the rest one character
+        static const size_t NUM_AUDIT_DATA_ITEMS = 50;
+        static const size_t NUM_WIDE_ITEMS       = 25;
+        static const size_t WIDE_ITEM_CHARS      = 255;
+
+        // Data members
+        bool       m_bValueDictionary;
+        sqlite3*   m_pDatabase;
+        Library    m_SqliteLibrary;
+        LPFN_SQLITE3_BIND_INT64        m_pfnBindInt64;
+        LPFN_SQLITE3_BIND_NULL         m_pfnBindNull;
+        LPFN_SQLITE3_BIND_TEXT16       m_pfnBindText16;
+        LPFN_SQLITE3_BUSY_TIMEOUT      m_pfnBusyTimeout;
+        LPFN_SQLITE3_CLOSE             m_pfnClose;
+        LPFN_SQLITE3_COLUMN_INT64      m_pfnColumnInt64;
+        LPFN_SQLITE3_ERRMSG16          m_pfnErrMsg16;
+        LPFN_SQLITE3_FINALIZE          m_pfnFinalize;
+        LPFN_SQLITE3_LAST_INSERT_ROWID m_pfnLastInsertRowID;
+        LPFN_SQLITE3_OPEN16            m_pfnOpen16;
+        LPFN_SQLITE3_PREPARE16_V2      m_pfnPrepare16;
+        LPFN_SQLITE3_RESET             m_pfnReset;
+        LPFN_SQLITE3_STEP              m_pfnStep;
+};
+
+#endif  // WINAUDIT_SQLITE_DATABASE_H_
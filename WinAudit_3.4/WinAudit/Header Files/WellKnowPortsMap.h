@@ -33,7 +33,9 @@
 // Remarks
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-// bearch table to map a well know port number to its name
+// Table to map a well know port number to its name. The source array is
+// checked at compile time and a direct index by port number is built from it
+// so a lookup is a single array access.
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Includes
@@ -56,8 +58,8 @@
 // Map
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-// The array must be sorted by port number as it is used by bsearch
-const PXS_TYPE_PORT_SERVICE PXS_WELL_KNOWN_PORT_SERVICES[] =
+// The array must be sorted by port number with no duplicates, see the static_assert below
+constexpr PXS_TYPE_PORT_SERVICE PXS_WELL_KNOWN_PORT_SERVICES[] =
     { { 1,   L"tcpmux"         },
       { 2,   L"compressnet"    },
       { 3,   L"compressnet"    },
@@ -714,4 +716,43 @@ const PXS_TYPE_PORT_SERVICE PXS_WELL_KNOWN_PORT_SERVICES[] =
       { 1010, L"surf"          }
     };
 
+// Test the ports are in ascending order, unique and within the index
+constexpr bool PXSIsWellKnownPortsMapValid( const PXS_TYPE_PORT_SERVICE* pPorts, size_t numPorts )
+{
+    for ( size_t i = 0; i < numPorts; i++ )
+    {
+        if ( pPorts[ i ].portID > PXS_MAX_WELL_KNOWN_PORT )
+        {
+            return false;
+        }
+
+        if ( ( i > 0 ) && ( pPorts[ i - 1 ].portID >= pPorts[ i ].portID ) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert( PXSIsWellKnownPortsMapValid( PXS_WELL_KNOWN_PORT_SERVICES,
+                                            ARRAYSIZE( PXS_WELL_KNOWN_PORT_SERVICES ) ),
+               "PXS_WELL_KNOWN_PORT_SERVICES must be sorted, unique and in range" );
+
+// Build the index from port number to one based position in the services array
+constexpr PXS_TYPE_PORT_SERVICE_INDEX PXSMakeWellKnownPortsIndex(
+                                            const PXS_TYPE_PORT_SERVICE* pPorts, size_t numPorts )
+{
+    PXS_TYPE_PORT_SERVICE_INDEX PortIndex = {};
+
+    for ( size_t i = 0; i < numPorts; i++ )
+    {
+        PortIndex.serviceIndex[ pPorts[ i ].portID ] = static_cast<WORD>( i + 1 );
+    }
+    return PortIndex;
+}
+
+constexpr PXS_TYPE_PORT_SERVICE_INDEX PXS_WELL_KNOWN_PORTS_INDEX =
+                PXSMakeWellKnownPortsIndex( PXS_WELL_KNOWN_PORT_SERVICES,
+                                            ARRAYSIZE( PXS_WELL_KNOWN_PORT_SERVICES ) );
+
 #endif  // WINAUDIT_WELL_KNOWN_PORTS_MAP_H_
@@ -97,6 +97,7 @@ const wchar_t PXS_WINAUDIT_COMPUTER_GUID[] = L"WinAuditGuid";
 const wchar_t PXS_REG_PATH_COMPUTER_GUID[] = L"Software\\Parmavex\\WinAudit";
 const wchar_t PXS_KEYWORD_MAC_ADDRESS[]    = L"macaddress";
 const wchar_t PXS_WINAUDIT_GUID_TXT[]      = L"WinAuditGuid.txt";
+const wchar_t PXS_COLLECTOR_STOP_EVENT[]   = L"Local\\WinAuditCollectorStop";
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // System Management BIOS
@@ -150,6 +151,9 @@ const DWORD PXS_HDD_MANUFACTURER_SAMSUNG_ID = 4;
 const DWORD PXS_HDD_MANUFACTURER_SEAGATE_ID = 5;
 const DWORD PXS_HDD_MANUFACTURER_WESTERN_ID = 6;
 
+// Highest port number in the well known ports map
+const DWORD PXS_MAX_WELL_KNOWN_PORT = 1023;
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Limits
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -183,6 +187,16 @@ const DWORD PXS_REPORT_MAX_RECORDS_MIN      = 1;
 const DWORD PXS_REPORT_MAX_RECORDS_MAX      = 99999;
 const DWORD PXS_REPORT_MAX_RECORDS_DEFAULT  = 100;
 
+// Audit retention, zero days means any age
+const DWORD PXS_DB_RETAIN_AUDITS_DEFAULT    = 1;
+const DWORD PXS_DB_RETAIN_AUDITS_MIN        = 1;
+const DWORD PXS_DB_RETAIN_AUDITS_MAX        = 999;
+const DWORD PXS_DB_RETAIN_DAYS_DEFAULT      = 0;
+const DWORD PXS_DB_RETAIN_DAYS_MAX          = 9999;
+const DWORD PXS_DB_PURGE_BATCH_DEFAULT      = 100;
+const DWORD PXS_DB_PURGE_BATCH_MIN          = 1;
+const DWORD PXS_DB_PURGE_BATCH_MAX          = 9999;
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // WinAudit Tables. Values from 1-99 are used to group data for display
 // purposes. Values >= 100 are actual data tables.
@@ -651,6 +665,7 @@ const DWORD PXS_PHYS_DISKS_BUFFER_KB        = PXS_CATEGORY_PHYS_DISKS + 13;
 const DWORD PXS_PHYS_DISKS_SMART_SUPPORTED  = PXS_CATEGORY_PHYS_DISKS + 14;
 const DWORD PXS_PHYS_DISKS_SMART_ENABLED    = PXS_CATEGORY_PHYS_DISKS + 15;
 const DWORD PXS_PHYS_DISKS_SMART_SELF_TEST  = PXS_CATEGORY_PHYS_DISKS + 16;
+const DWORD PXS_PHYS_DISKS_CRITICAL_WARN    = PXS_CATEGORY_PHYS_DISKS + 17;
 
 // Drives
 const DWORD PXS_CATEGORY_DRIVES             = 3800;
@@ -1090,6 +1105,27 @@ typedef struct _PXS_TYPE_PORT_SERVICE
     LPCWSTR pszServiceName;
 } PXS_TYPE_PORT_SERVICE;
 
+// Direct index from a port number to its entry in PXS_WELL_KNOWN_PORT_SERVICES
+typedef struct _PXS_TYPE_PORT_SERVICE_INDEX
+{
+    WORD serviceIndex[ PXS_MAX_WELL_KNOWN_PORT + 1 ];   // One based, zero if no service
+} PXS_TYPE_PORT_SERVICE_INDEX;
+
+// Map a Plug and Play vendor identifier to the manufacturer's name
+typedef struct _PXS_TYPE_PNP_MANUFACTURER
+{
+    LPCWSTR pszPnPID;
+    LPCWSTR pszManufacturer;
+} PXS_TYPE_PNP_MANUFACTURER;
+
+// Typed sort keys of an array of audit records, see PXSSortAuditRecordsByKeys
+typedef struct _PXS_TYPE_AUDIT_SORT_KEYS
+{
+    size_t          numKeys;
+    const DWORD*    pKeyTypes;      // PXS_SORT_KEY_xxx for each key
+    const LPCWSTR*  ppKeys;         // numKeys values for each record, row by row
+} PXS_TYPE_AUDIT_SORT_KEYS;
+
 // Structure to for the SMBIOS SPECFICATION
 typedef struct  _PXS_TYPE_SMBIOS_SPECIFICATION
 {
@@ -1687,6 +1723,7 @@ const PXS_TYPE_AUDIT_ITEM PXS_AUDIT_ITEMS[] = {
     { PXS_PHYS_DISKS_SMART_SUPPORTED  , L"SMART Supported"               },
     { PXS_PHYS_DISKS_SMART_ENABLED    , L"SMART Enabled"                 },
     { PXS_PHYS_DISKS_SMART_SELF_TEST  , L"SMART Self Test"               },
+    { PXS_PHYS_DISKS_CRITICAL_WARN    , L"Critical Warning"              },
     { PXS_DRIVES_LETTER               , L"Letter"                        },
     { PXS_DRIVES_TYPE                 , L"Drive Type"                    },
     { PXS_DRIVES_USED_SPACE_PERCENT   , L"Percent Used"                  },
@@ -1842,14 +1879,15 @@ const PXS_TYPE_AUDIT_ITEM PXS_AUDIT_ITEMS[] = {
 
 // Searching/Sorting
 void PXSGetAuditItemDisplayName( DWORD itemID, String* pDisplayName );
-int  PXSQSortNumberStringAscending( const void* pArg1, const void* pArg2 );
 int  PXSBSearchCompareAuditItems( const void* pItem1, const void* pItem2 );
-int  PXSBSearchComparePortServices( const void* pPort1, const void* pPort2);
 void PXSSortAuditRecords( TArray< AuditRecord >* pRecords, DWORD itemID );
+void PXSSortAuditRecordsByKeys( TArray< AuditRecord >* pRecords,
+                                const DWORD* pItemIDs, const DWORD* pKeyTypes, size_t numKeys );
 
 // Audit
 void PXSAuditRecordsToContent( const TArray< AuditRecord >& AuditRecords,
                                TArray< TreeViewItem >* pCategoryItems,
+                               TArray< size_t >* pTitleOffsets,
                                DWORD* pTableCounter, String* pRichText );
 void PXSAuditRecordsToCsv( const TArray< AuditRecord >&  AuditRecords,
                            bool wantHeaderRow, String* pCsvText );
@@ -1860,15 +1898,26 @@ void PXSGetCommandLineSwitchValues( const StringArray& Switches,
                                     String* pReportSwitchValue,
                                     String* pFileSwitchValue,
                                     String* pLogSwitchValue,
-                                    String* pTimestampSwitchValue, String* pLanguageSwitchValue );
+                                    String* pTimestampSwitchValue,
+                                    String* pLanguageSwitchValue,
+                                    String* pEdidSwitchValue,
+                                    String* pSmbiosSwitchValue,
+                                    String* pDiskSwitchValue,
+                                    String* pIngestSwitchValue,
+                                    String* pLayoutSwitchValue,
+                                    String* pScheduleSwitchValue,
+                                    String* pPurgeSwitchValue );
 void PXSGetDataCategoryProperties( DWORD categoryID,
                                    String* pCategoryName,
                                    DWORD*  pCaptionID,
                                    bool*   pIsColumnar, bool* pIsNode, BYTE* pDepth );
 void PXSGetWinAuditGuidFilePath( String* pFilePath );
+bool PXSIsDatabaseOutputPath( const String& FileSwitchValue );
 void PXSMakeCommandLineOutputPath( const String& FileSwitchValue,
                                    const String& TimestampSwitchValue,
                                    const String& LocalTimeIso, String* pOutputPath );
+void PXSPurgeOldAuditsCommandLine( const String& FileSwitchValue,
+                                   DWORD retainCount, DWORD retainDays, DWORD batchSize );
 void PXSReadWinAuditGuidFile( String* pWinAuditGuid );
 void PXSSaveAuditCommandLine( const String& OutputPath, const TArray<AuditRecord>& AuditRecords );
 void PXSWriteWinAuditGuidFile();
@@ -191,10 +191,13 @@ class WinAuditFrame : public Frame
         WinAuditFrame& operator= ( const WinAuditFrame& oWinAuditFrame );
 
         // Methods
+        void AppendAuditContent( const String& RichText,
+                                 const TArray< size_t >& TitleOffsets, DWORD firstTable );
  static void CopySelection();
  static void DesktopShortCut();
         void DestroyMenuItems();
         void FillHelpContents();
+        bool FindAuditTable( const String& Bookmark );
         void FindText( bool forward, bool fromSelectionStart );
         void HandleButtonClick( const HWND hWnd );
         void HandleHideWindow( const HWND hWnd );
@@ -252,6 +255,7 @@ class WinAuditFrame : public Frame
         AuditThread  m_AuditThread;
         ConfigurationSettings m_ConfigurationSettings;
         TArray< AuditRecord > m_AuditRecords;
+        TArray< LONG >        m_AuditTableOffsets;
 
         // Multi-thread variables
         sig_atomic_t          m_bRunAuditThreadMT;
@@ -0,0 +1,478 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Account Name Cache Class Implementation
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Header Files/AccountNameCache.h"
+
+// 2. C System Files
+#include <NTSecAPI.h>
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/AutoUnlockMutex.h"
+#include "PxsBase/Header Files/Formatter.h"
+#include "PxsBase/Header Files/NullException.h"
+#include "PxsBase/Header Files/ParameterException.h"
+#include "PxsBase/Header Files/SystemException.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/Ddk.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Default constructor
+AccountNameCache::AccountNameCache()
+                 :m_uNumHits( 0 ),
+                  m_uNumMisses( 0 ),
+                  m_Mutex(),
+                  m_StringSids(),
+                  m_DomainNames(),
+                  m_Names(),
+                  m_Uses(),
+                  m_SidIndex()
+{
+}
+
+// Copy constructor - not allowed so no implementation
+
+// Destructor
+AccountNameCache::~AccountNameCache()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Operators
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Assignment operator - not allowed so no implementation
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Public Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Get the account name from the specified security identifier
+//
+//  Parameters:
+//      pSid         - pointer to the SID
+//      withDomain   - true to pre-pend the domain name if there is one
+//      pAccountName - receives the account name
+//
+//  Remarks:
+//      If the SID cannot be mapped to an account, e.g. ERROR_NONE_MAPPED for
+//      some ACEs of SE_WINDOW_OBJECT, the SID is returned in string format.
+//
+//  Returns:
+//      void, empty string if there is no SID
+//===============================================================================================//
+void AccountNameCache::GetAccountName( const PSID pSid, bool withDomain, String* pAccountName )
+{
+    DWORD   cchName = 0, cchDomainName = 0;
+    size_t  idxEntry = 0;
+    String  StringSid;
+    wchar_t szName[ MAX_PATH + 1 ] = { 0 };
+    wchar_t szDomainName[ MAX_PATH + 1 ] = { 0 };
+    Formatter    Format;
+    SID_NAME_USE eUse = SidTypeUnknown;
+
+    if ( pAccountName == nullptr )
+    {
+        throw ParameterException( L"pAccountName", __FUNCTION__ );
+    }
+    *pAccountName = PXS_STRING_EMPTY;
+
+    if ( pSid == nullptr )
+    {
+        return;     // No account name
+    }
+
+    StringSid = Format.SidToString( pSid );
+    if ( StringSid.IsEmpty() )
+    {
+        return;     // Not a valid SID
+    }
+
+    m_Mutex.Lock();
+    AutoUnlockMutex AutoUnlock( &m_Mutex );
+
+    idxEntry = FindEntry( StringSid );
+    if ( idxEntry != PXS_MINUS_ONE )
+    {
+        m_uNumHits++;
+    }
+    else
+    {
+        m_uNumMisses++;
+        cchName = ARRAYSIZE( szName );
+        cchDomainName = ARRAYSIZE( szDomainName );
+        if ( LookupAccountSid( nullptr,     // = local machine
+                               pSid, szName, &cchName, szDomainName, &cchDomainName, &eUse ) )
+        {
+            szName[ ARRAYSIZE( szName ) - 1 ] = PXS_CHAR_NULL;
+            szDomainName[ ARRAYSIZE( szDomainName ) - 1 ] = PXS_CHAR_NULL;
+            if ( eUse == SidTypeUnknown )
+            {
+                eUse = SidTypeInvalid;      // Reserve unknown for not mapped
+            }
+        }
+        else
+        {
+            // Cache the failure as well, so only log it once
+            DWORD lastError = GetLastError();
+            PXSLogSysError1( lastError,
+                             L"LookupAccountSid failed for SID = '%%1'.", StringSid );
+            szName[ 0 ]       = PXS_CHAR_NULL;
+            szDomainName[ 0 ] = PXS_CHAR_NULL;
+            eUse = SidTypeUnknown;
+        }
+        AddEntry( StringSid, szDomainName, szName, eUse );
+        idxEntry = m_StringSids.GetSize() - 1;
+    }
+
+    if ( m_Uses.Get( idxEntry ) == SidTypeUnknown )
+    {
+        *pAccountName = StringSid;
+        return;
+    }
+
+    // Pre-pend the domain name if have it
+    if ( withDomain && m_DomainNames.Get( idxEntry ) && *m_DomainNames.Get( idxEntry ) )
+    {
+        *pAccountName  = m_DomainNames.Get( idxEntry );
+        *pAccountName += PXS_PATH_SEPARATOR;
+    }
+    *pAccountName += m_Names.Get( idxEntry );
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the cache statistics
+//
+//  Parameters:
+//      pNumHits   - receives the number of names obtained without asking LSA
+//      pNumMisses - receives the number of SIDs that LSA was asked for
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AccountNameCache::GetStatistics( size_t* pNumHits, size_t* pNumMisses )
+{
+    if ( ( pNumHits == nullptr ) || ( pNumMisses == nullptr ) )
+    {
+        throw ParameterException( L"pNumHits/pNumMisses", __FUNCTION__ );
+    }
+
+    m_Mutex.Lock();
+    AutoUnlockMutex AutoUnlock( &m_Mutex );
+    *pNumHits   = m_uNumHits;
+    *pNumMisses = m_uNumMisses;
+}
+
+//===============================================================================================//
+//  Description:
+//      Write the cache statistics to the log
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AccountNameCache::LogStatistics()
+{
+    size_t    numHits = 0, numMisses = 0;
+    String    Hits, Misses;
+    Formatter Format;
+
+    GetStatistics( &numHits, &numMisses );
+    if ( ( numHits == 0 ) && ( numMisses == 0 ) )
+    {
+        return;     // Not used
+    }
+    Hits   = Format.SizeT( numHits );
+    Misses = Format.SizeT( numMisses );
+    PXSLogAppInfo2( L"Account name cache hits = %%1, misses = %%2.", Hits, Misses );
+}
+
+//===============================================================================================//
+//  Description:
+//      Resolve the SIDs that are not yet in the cache with one call to LSA
+//
+//  Parameters:
+//      pSids   - array of SIDs, nullptr entries are ignored
+//      numSids - number of SIDs in the array
+//
+//  Remarks:
+//      Errors are logged rather than thrown, GetAccountName will then look up
+//      the SIDs one at a time.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AccountNameCache::LookupSids( const PSID* pSids, size_t numSids )
+{
+    String      StringSid, DomainName, Name, Insert1;
+    NTSTATUS    status = 0;
+    Formatter   Format;
+    LSA_HANDLE  PolicyHandle = nullptr;
+    StringArray PendingStringSids;
+    TArray< PSID > PendingSids;
+    LSA_OBJECT_ATTRIBUTES       ObjectAttributes;
+    LSA_TRANSLATED_NAME*        pNames   = nullptr;
+    LSA_REFERENCED_DOMAIN_LIST* pDomains = nullptr;
+
+    if ( ( pSids == nullptr ) || ( numSids == 0 ) )
+    {
+        return;     // Nothing to do
+    }
+
+    m_Mutex.Lock();
+    AutoUnlockMutex AutoUnlock( &m_Mutex );
+
+    // Collect the distinct SIDs not in the cache
+    for ( size_t i = 0; i < numSids; i++ )
+    {
+        if ( pSids[ i ] )
+        {
+            StringSid = Format.SidToString( pSids[ i ] );
+            if ( StringSid.GetLength() &&
+                 ( FindEntry( StringSid ) == PXS_MINUS_ONE ) &&
+                 ( PendingStringSids.IndexOf( StringSid.c_str(), true ) == PXS_MINUS_ONE ) )
+            {
+                PendingStringSids.Add( StringSid );
+                PendingSids.Add( pSids[ i ] );
+            }
+        }
+    }
+
+    size_t numPending = PendingSids.GetSize();
+    if ( numPending == 0 )
+    {
+        return;     // All cached
+    }
+
+    memset( &ObjectAttributes, 0, sizeof ( ObjectAttributes ) );
+    Insert1.SetAnsi( __FUNCTION__ );
+    status = LsaOpenPolicy( nullptr,               // Local computer
+                            &ObjectAttributes, POLICY_LOOKUP_NAMES, &PolicyHandle );
+    if ( status )
+    {
+        PXSLogNtStatusWarn1( status, L"LsaOpenPolicy failed in '%%1'.", Insert1 );
+        return;
+    }
+
+    if ( PolicyHandle == nullptr )
+    {
+        return;
+    }
+
+    status = LsaLookupSids( PolicyHandle,
+                            PXSCastSizeTToUInt32( numPending ),
+                            PendingSids.GetPtr( 0 ), &pDomains, &pNames );
+    LsaClose( PolicyHandle );
+
+    // Catch exceptions to free the buffers
+    try
+    {
+        if ( ( status == STATUS_SUCCESS ) || ( status == STATUS_SOME_NOT_MAPPED ) )
+        {
+            if ( pNames == nullptr )
+            {
+                throw NullException( L"pNames", __FUNCTION__ );
+            }
+
+            for ( size_t i = 0; i < numPending; i++ )
+            {
+                m_uNumMisses++;
+                Name       = PXS_STRING_EMPTY;
+                DomainName = PXS_STRING_EMPTY;
+                SID_NAME_USE eUse = pNames[ i ].Use;
+                if ( ( eUse == SidTypeInvalid ) || ( eUse == SidTypeUnknown ) )
+                {
+                    eUse = SidTypeUnknown;
+                }
+                else
+                {
+                    if ( pNames[ i ].Name.Buffer )
+                    {
+                        Name.AppendChars( pNames[ i ].Name.Buffer,
+                                          pNames[ i ].Name.Length / sizeof ( wchar_t ) );
+                    }
+
+                    LONG idxDomain = pNames[ i ].DomainIndex;
+                    if ( pDomains && ( idxDomain >= 0 ) &&
+                         ( static_cast<ULONG>( idxDomain ) < pDomains->Entries ) )
+                    {
+                        const LSA_UNICODE_STRING& Domain = pDomains->Domains[ idxDomain ].Name;
+                        if ( Domain.Buffer )
+                        {
+                            DomainName.AppendChars( Domain.Buffer,
+                                                    Domain.Length / sizeof ( wchar_t ) );
+                        }
+                    }
+                }
+                AddEntry( PendingStringSids.Get( i ), DomainName.c_str(), Name.c_str(), eUse );
+            }
+        }
+        else if ( status == STATUS_NONE_MAPPED )
+        {
+            for ( size_t i = 0; i < numPending; i++ )
+            {
+                m_uNumMisses++;
+                AddEntry( PendingStringSids.Get( i ), nullptr, nullptr, SidTypeUnknown );
+            }
+        }
+        else
+        {
+            PXSLogNtStatusWarn1( status, L"LsaLookupSids failed in '%%1'.", Insert1 );
+        }
+    }
+    catch ( const Exception& )
+    {
+        if ( pNames )
+        {
+            LsaFreeMemory( pNames );
+        }
+
+        if ( pDomains )
+        {
+            LsaFreeMemory( pDomains );
+        }
+        throw;
+    }
+
+    if ( pNames )
+    {
+        LsaFreeMemory( pNames );
+    }
+
+    if ( pDomains )
+    {
+        LsaFreeMemory( pDomains );
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Forget the cached account names
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      Accounts can be renamed or deleted so a long running process empties
+//      the cache between audits. The statistics are kept.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AccountNameCache::Reset()
+{
+    m_Mutex.Lock();
+    AutoUnlockMutex AutoUnlock( &m_Mutex );
+    m_StringSids.RemoveAll();
+    m_DomainNames.RemoveAll();
+    m_Names.RemoveAll();
+    m_Uses.RemoveAll();
+    m_SidIndex.RemoveAll();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Protected Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Private Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Add an entry to the cache
+//
+//  Parameters:
+//      StringSid     - the SID in string format
+//      pszDomainName - the account's domain name, may be NULL
+//      pszName       - the account's name, may be NULL
+//      eUse          - the account type, SidTypeUnknown if not mapped
+//
+//  Remarks:
+//      The caller must hold the mutex and have checked that the SID is not
+//      already in the cache.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AccountNameCache::AddEntry( const String& StringSid,
+                                 LPCWSTR pszDomainName, LPCWSTR pszName, SID_NAME_USE eUse )
+{
+    if ( StringSid.IsEmpty() )
+    {
+        throw ParameterException( L"StringSid", __FUNCTION__ );
+    }
+
+    m_StringSids.Add( StringSid );
+    m_DomainNames.Add( pszDomainName ? pszDomainName : PXS_STRING_EMPTY );
+    m_Names.Add( pszName ? pszName : PXS_STRING_EMPTY );
+    m_Uses.Add( static_cast<DWORD>( eUse ) );
+    m_SidIndex.Add( StringSid.c_str(), false, m_StringSids.GetSize() - 1 );
+}
+
+//===============================================================================================//
+//  Description:
+//      Find an entry in the cache
+//
+//  Parameters:
+//      StringSid - the SID in string format
+//
+//  Remarks:
+//      The caller must hold the mutex.
+//
+//  Returns:
+//      Index of the entry, PXS_MINUS_ONE if not found
+//===============================================================================================//
+size_t AccountNameCache::FindEntry( const String& StringSid ) const
+{
+    if ( StringSid.IsEmpty() )
+    {
+        return PXS_MINUS_ONE;
+    }
+
+    return m_SidIndex.Find( m_StringSids, StringSid.c_str(), false );
+}
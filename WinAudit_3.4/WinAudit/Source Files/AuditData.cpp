@@ -94,7 +94,10 @@
 
 // Default constructor
 AuditData::AuditData()
-          :m_SmbiosInfo()
+          :m_AccountNameCache(),
+           m_SnapshotCache(),
+           m_ProcessInfo(),
+           m_SmbiosInfo()
 {
 }
 
@@ -226,7 +229,6 @@ void AuditData::GetCategoryRecords( DWORD categoryID,
     OpenNetworkPortInformation   OpenNetworkPortInfo;
     PeripheralInformation        PeripheralInfo;
     PrinterInformation           PrinterInfo;
-    ProcessInformation           ProcessInfo;
     SecurityInformation          SecurityInfo;
     SoftwareInformation          SoftwareInfo;
     TaskSchedulerInformation     TaskSchedulerInfo;
@@ -245,6 +247,15 @@ void AuditData::GetCategoryRecords( DWORD categoryID,
                                   &CategoryName, &captionID, &isColumnar, &isNode, &depth );
     PXSLogAppInfo1( L"Start category '%%1'.", CategoryName );
 
+    // Use the last snapshot if the category's sources have not changed
+    if ( m_SnapshotCache.GetRecords( categoryID, pRecords ) )
+    {
+        NumberOfRecords = Format.SizeT( pRecords->GetSize() );
+        PXSLogAppInfo2( L"End category '%%1', unchanged so used %%2 snapshot record(s).",
+                        CategoryName, NumberOfRecords );
+        return;
+    }
+
     switch ( categoryID )
     {
         default:
@@ -299,7 +310,7 @@ void AuditData::GetCategoryRecords( DWORD categoryID,
             break;
 
         case PXS_CATEGORY_OPEN_PORTS:
-            OpenNetworkPortInfo.GetAuditRecords( pRecords );
+            OpenNetworkPortInfo.GetAuditRecords( &m_ProcessInfo, pRecords );
             break;
 
         case PXS_CATEGORY_SECURITY_LOG:
@@ -430,7 +441,7 @@ void AuditData::GetCategoryRecords( DWORD categoryID,
             break;
 
         case PXS_CATEGORY_RUNNING_PROCS:
-            ProcessInfo.GetRunningProcesseRecords( pRecords );
+            m_ProcessInfo.GetRunningProcesseRecords( pRecords );
             break;
 
         case PXS_CATEGORY_LOADED_MODULES:
@@ -462,7 +473,7 @@ void AuditData::GetCategoryRecords( DWORD categoryID,
             break;
 
         case PXS_CATEGORY_PERMISSIONS:
-            ObjectPermissionInfo.GetAuditRecords( pRecords );
+            ObjectPermissionInfo.GetAuditRecords( &m_AccountNameCache, pRecords );
             break;
 
         case PXS_CATEGORY_USER_LOGONS:
@@ -542,7 +553,7 @@ void AuditData::GetCategoryRecords( DWORD categoryID,
             break;
 
         case PXS_CATEGORY_USER_RIGHTS:
-            SecurityInfo.GetUserRightsAssignmentRecords( pRecords );
+            SecurityInfo.GetUserRightsAssignmentRecords( &m_AccountNameCache, pRecords );
             break;
 
         case PXS_CATEGORY_KERBEROS_POLICY:
@@ -577,6 +588,7 @@ void AuditData::GetCategoryRecords( DWORD categoryID,
         Record.Reset( categoryID );
         pRecords->Add( Record );
     }
+    m_SnapshotCache.SaveRecords( categoryID, *pRecords );
 
     // To help locate problems will flush the log at the end of each category
     // so messages are written to disk
@@ -1676,6 +1688,22 @@ void AuditData::GetSystemOverviewRecord( const String& LocalTime, AuditRecord* p
     pRecord->Add( PXS_SYS_OVERVIEW_LOCAL_TIME, LocalTime );
 }
 
+//===============================================================================================//
+//  Description:
+//      Write the statistics of the caches shared by the categories to the log
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditData::LogCacheStatistics()
+{
+    m_AccountNameCache.LogStatistics();
+    m_SnapshotCache.LogStatistics();
+}
+
 //===============================================================================================//
 //  Description:
 //      Make the audit master record for a database insert
@@ -1881,6 +1909,28 @@ void AuditData::MakeComputerMasterRecord( AuditRecord* pComputerMaster )
     pComputerMaster->Add( PXS_COMP_MASTER_WINAUDIT_GUID, Value );
 }
 
+//===============================================================================================//
+//  Description:
+//      Discard what was gathered for the last audit so a process that audits
+//      more than once sees the machine as it is now
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      The SMBIOS tables do not change while the machine is running so are
+//      kept.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditData::ResetPerPassState()
+{
+    m_AccountNameCache.Reset();
+    m_SnapshotCache.Reset();
+    m_ProcessInfo.Reset();
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Protected Methods
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -43,17 +43,21 @@
 
 // 4. Other Libraries
 #include "PxsBase/Header Files/Application.h"
+#include "PxsBase/Header Files/BoundsException.h"
 #include "PxsBase/Header Files/Formatter.h"
 #include "PxsBase/Header Files/FunctionException.h"
 #include "PxsBase/Header Files/NameValue.h"
 #include "PxsBase/Header Files/Registry.h"
 #include "PxsBase/Header Files/ParameterException.h"
+#include "PxsBase/Header Files/StringArray.h"
 #include "PxsBase/Header Files/SystemException.h"
+#include "PxsBase/Header Files/TArray.h"
 
 // 5. This Project
 #include "WinAudit/Header Files/AuditData.h"
 #include "WinAudit/Header Files/AuditRecord.h"
 #include "WinAudit/Header Files/OdbcDatabase.h"
+#include "WinAudit/Header Files/OdbcRecordSet.h"
 #include "WinAudit/Header Files/SmbiosInformation.h"
 #include "WinAudit/Header Files/TcpIpInformation.h"
 #include "WinAudit/Header Files/WindowsInformation.h"
@@ -64,6 +68,10 @@
 
 // Default constructor
 AuditDatabase::AuditDatabase()
+              :m_bKnowComputerMasterKeys( false ),
+               m_bHasComputerMasterKeys( false ),
+               m_bKnowSummaryTables( false ),
+               m_bHasSummaryTables( false )
 {
 }
 
@@ -86,224 +94,555 @@ AuditDatabase::~AuditDatabase()
 
 //===============================================================================================//
 //  Description:
-//      Get a computer's identifier from the Computer_Master table using
-//      various identifying data
+//      Forget what is known about the database schema
 //
 //  Parameters:
-//      ComputerMaster - the computer master record
+//      None
 //
 //  Remarks:
-//      20/04/2014 - will accept WINAUDIT_GUID alone or a reasonable combination
-//                   of two identifiers in the event identifiers are duplicated
-//                   on different machines.
-// 
-//      25/03/2022 - dropped .
+//      Call after changing the schema on the current connection
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditDatabase::ClearSchemaCache()
+{
+    m_bKnowComputerMasterKeys = false;
+    m_bHasComputerMasterKeys  = false;
+    m_bKnowSummaryTables      = false;
+    m_bHasSummaryTables       = false;
+}
 
+//===============================================================================================//
+//  Description:
+//      Connect to a database
+//
+//  Parameters:
+//      ConnectionString   - the ODBC connection string
+//      connectTimeoutSecs - the connection timeout in seconds
+//      queryTimeoutSecs   - the query timeout in seconds
+//      hWnd               - handle to the owner window
+//
+//  Remarks:
+//      The schema may differ from that of any previous connection
 //
 //  Returns:
-//      SQLINTEGER of the computer identifier, zero if not found
+//      void
 //===============================================================================================//
-SQLINTEGER AuditDatabase::IdentifyComputerID( const AuditRecord& ComputerMaster )
+void AuditDatabase::Connect( const String& ConnectionString,
+                             DWORD connectTimeoutSecs, DWORD queryTimeoutSecs, HWND hWnd )
 {
-    String     UpperCaseKeyword, SqlQuery, WinAuditGuid, WinAuditGuidClean;
-    String     MacAddress, MacAddressClean, SmbiosUuid, SmbiosUuidClean;
-    String     AssetTag, AssetTagClean, FQDN, FQDNClean;
-    String     ComputerName, ComputerNameClean, OsProductID, OsProductIDClean;
-    String     SqlUpdateWinAuditGuid;
+    ClearSchemaCache();
+    OdbcDatabase::Connect( ConnectionString, connectTimeoutSecs, queryTimeoutSecs, hWnd );
+}
+
+//===============================================================================================//
+//  Description:
+//      Count the audits that are outside the retention policy
+//
+//  Parameters:
+//      retainCount - the number of most recent audits to keep per computer
+//      retainDays  - keep audits newer than this many days, zero for no
+//                    age limit
+//
+//  Returns:
+//      size_t number of audits
+//===============================================================================================//
+size_t AuditDatabase::CountOldAudits( DWORD retainCount, DWORD retainDays )
+{
+    String     SqlQuery, Predicate;
+    SQLINTEGER count = 0;
+
+    MakeOldAuditsPredicate( GetDbmsName(), retainCount, retainDays, &Predicate );
+    SqlQuery  = L"SELECT COUNT(*) FROM Audit_Master AS am WHERE ";
+    SqlQuery += Predicate;
+    ExecuteSelectSqlInteger( SqlQuery, &count );
+    if ( count < 0 )
+    {
+        count = 0;
+    }
+
+    return PXSCastInt32ToSizeT( count );
+}
+
+//===============================================================================================//
+//  Description:
+//      Delete a batch of the audits that are outside the retention policy
+//
+//  Parameters:
+//      retainCount  - the number of most recent audits to keep per computer
+//      retainDays   - keep audits newer than this many days, zero for no
+//                     age limit
+//      batchSize    - the maximum number of audits to delete
+//      pLastAuditID - on input the highest Audit_ID of the previous batch,
+//                     zero for the first. Receives the highest Audit_ID
+//                     deleted by this batch
+//
+//  Remarks:
+//      Audits are taken in Audit_ID order so call repeatedly until zero is
+//      returned. Deleting an older audit does not change whether a newer one
+//      is kept so the batches need not rescan what has been done. Each batch
+//      is one transaction and Audit_Data rows go by ON DELETE CASCADE, this
+//      bounds the size of the transaction log.
+//
+//      The IDs are read first rather than deleted with a sub-query on the
+//      same table as MySQL does not allow that.
+//
+//  Returns:
+//      size_t number of audits deleted
+//===============================================================================================//
+size_t AuditDatabase::DeleteOldAuditsBatch( DWORD retainCount,
+                                            DWORD retainDays,
+                                            DWORD batchSize, SQLINTEGER* pLastAuditID )
+{
+    size_t     numAudits = 0;
+    String     SqlQuery, Predicate, Top, Limit, AuditIDs, BatchSize;
     Formatter  Format;
-    SQLINTEGER computerID = 0;
+    __int64    value   = 0;
+    SQLINTEGER auditID = 0;
+    OdbcRecordSet RecordSet;
 
-    // Get if the database is case sensitive
-    UpperCaseKeyword = PXS_STRING_EMPTY;
-    if ( IsCaseSensitiveSort() )
+    if ( pLastAuditID == nullptr )
     {
-        GetDbKeyWord( PXS_KEYWORD_UPPER, &UpperCaseKeyword );
+        throw ParameterException( L"pLastAuditID", __FUNCTION__ );
     }
 
-    // Look for the WinAuditGuid
-    WinAuditGuid      = PXS_STRING_EMPTY;
-    WinAuditGuidClean = PXS_STRING_EMPTY;
-    ComputerMaster.GetItemValue( PXS_COMP_MASTER_WINAUDIT_GUID , &WinAuditGuid );
-    if ( Format.IsValidStringGuid( WinAuditGuid ) == false )
+    if ( batchSize == 0 )
     {
-        PXSLogAppInfo1( L"Invalid WinAuditGUID '%%1'", WinAuditGuid );
-        throw SystemException( ERROR_INVALID_DATA, PXS_WINAUDIT_COMPUTER_GUID, __FUNCTION__ );
+        throw ParameterException( L"batchSize", __FUNCTION__ );
     }
-    FixUpStringSQL( WinAuditGuid, SQL_VARCHAR, &WinAuditGuidClean );
-    SqlQuery  = L"SELECT Computer_ID FROM Computer_Master WHERE ";
-    SqlQuery += Format.String2( L"%%1(WinAudit_GUID) = %%1(%%2)",
-                                UpperCaseKeyword, WinAuditGuidClean );
-    ExecuteSelectSqlInteger( SqlQuery, &computerID );
-    if ( computerID )
+
+    // Row limiting is not standard, if unknown will stop reading at batchSize
+    BatchSize = Format.UInt32( batchSize );
+    if ( ( GetDbmsName().CompareI( PXS_DBMS_NAME_ACCESS     ) == 0 ) ||
+         ( GetDbmsName().CompareI( PXS_DBMS_NAME_SQL_SERVER ) == 0 )  )
     {
-        PXSLogAppInfo( L"Matched computer using WINAUDIT_GUID" );
-        return computerID;
+        Top = Format.String1( L"TOP %%1 ", BatchSize );
+    }
+    else if ( ( GetDbmsName().CompareI( PXS_DBMS_NAME_MYSQL       ) == 0 ) ||
+              ( GetDbmsName().CompareI( PXS_DBMS_NAME_POSTGRE_SQL ) == 0 ) ||
+              ( GetDbmsName().CompareI( PXS_DBMS_NAME_SQLITE      ) == 0 )  )
+    {
+        Limit = Format.String1( L" LIMIT %%1", BatchSize );
     }
 
-    // Did not find the WinAuditGuid. Search for a computer with matching identifiers that
-    // do not have a WinAudidGuid. If a record is found will update the WinAuditGuid
-    SqlUpdateWinAuditGuid  = L"UPDATE Computer_Master SET WinAudit_GUID = ";
-    SqlUpdateWinAuditGuid += WinAuditGuidClean;
-    SqlUpdateWinAuditGuid += L" WHERE Computer_ID = ";
+    MakeOldAuditsPredicate( GetDbmsName(), retainCount, retainDays, &Predicate );
+    SqlQuery.Allocate( 512 );
+    SqlQuery  = L"SELECT ";
+    SqlQuery += Top;
+    SqlQuery += L"am.Audit_ID FROM Audit_Master AS am WHERE ";
+    SqlQuery += Predicate;
+    SqlQuery += L" AND am.Audit_ID > ";
+    SqlQuery += Format.Int32( *pLastAuditID );
+    SqlQuery += L" ORDER BY am.Audit_ID";
+    SqlQuery += Limit;
+
+    AuditIDs.Allocate( PXSMultiplySizeT( batchSize, 12 ) );
+    RecordSet.Open( SqlQuery, this );
+    while ( ( numAudits < batchSize ) && RecordSet.MoveNext() )
+    {
+        auditID = 0;
+        if ( RecordSet.FieldInt64( 0, &value ) )
+        {
+            auditID = PXSCastInt64ToInt32( value );
+        }
+        if ( auditID > 0 )
+        {
+            if ( numAudits )
+            {
+                AuditIDs += L",";
+            }
+            AuditIDs += Format.Int32( auditID );
+            *pLastAuditID = auditID;
+            numAudits++;
+        }
+    }
+    RecordSet.Close();
 
-    MacAddress      = PXS_STRING_EMPTY;
-    SmbiosUuid      = PXS_STRING_EMPTY;
-    AssetTag        = PXS_STRING_EMPTY;
-    FQDN            = PXS_STRING_EMPTY;
-    ComputerName    = PXS_STRING_EMPTY;
-    OsProductID     = PXS_STRING_EMPTY;
-    ComputerMaster.GetItemValue( PXS_COMP_MASTER_MAC_ADDRESS   , &MacAddress   );
-    ComputerMaster.GetItemValue( PXS_COMP_MASTER_SMBIOS_UUID   , &SmbiosUuid   );
-    ComputerMaster.GetItemValue( PXS_COMP_MASTER_ASSET_TAG     , &AssetTag );
-    ComputerMaster.GetItemValue( PXS_COMP_MASTER_FQDN          , &FQDN         );
-    ComputerMaster.GetItemValue( PXS_COMP_MASTER_COMPUTER_NAME , &ComputerName );
-    ComputerMaster.GetItemValue( PXS_COMP_MASTER_OS_PRODUCT_ID , &OsProductID  );
+    if ( numAudits == 0 )
+    {
+        return 0;
+    }
 
-    MacAddressClean   = PXS_STRING_EMPTY;
-    SmbiosUuidClean   = PXS_STRING_EMPTY;
-    AssetTagClean     = PXS_STRING_EMPTY;
-    FQDNClean         = PXS_STRING_EMPTY;
-    ComputerNameClean = PXS_STRING_EMPTY;
-    OsProductIDClean  = PXS_STRING_EMPTY;
-    FixUpStringSQL( MacAddress   , SQL_VARCHAR, &MacAddressClean   );
-    FixUpStringSQL( SmbiosUuid   , SQL_VARCHAR, &SmbiosUuidClean   );
-    FixUpStringSQL( AssetTag     , SQL_VARCHAR, &AssetTagClean );
-    FixUpStringSQL( FQDN         , SQL_VARCHAR, &FQDNClean         );
-    FixUpStringSQL( ComputerName , SQL_VARCHAR, &ComputerNameClean );
-    FixUpStringSQL( OsProductID  , SQL_VARCHAR, &OsProductIDClean  );
+    SqlQuery  = L"DELETE FROM Audit_Master WHERE Audit_ID IN (";
+    SqlQuery += AuditIDs;
+    SqlQuery += L")";
+    BeginTrans();
+    try
+    {
+        ExecuteTrans( SqlQuery, PXS_SQLLEN_MAX );
+    }
+    catch ( const Exception& )
+    {
+        RollbackTrans();
+        throw;
+    }
+    CommitTrans();
+
+    return numAudits;
+}
+
+//===============================================================================================//
+//  Description:
+//      Disconnect from the database
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditDatabase::Disconnect()
+{
+    ClearSchemaCache();
+    OdbcDatabase::Disconnect();
+}
 
-    // FULLY_QUALIFIED_DOMAIN_NAME + SMBIOS_UUID + ASSET_TAG
-    if ( FQDNClean.GetLength() && SmbiosUuidClean.GetLength() + AssetTag.GetLength() )
+//===============================================================================================//
+//  Description:
+//      Get the name of the Computer_Master column for an identifying key
+//
+//  Parameters:
+//      idxKey     - the key, one of the KEY_ constants
+//      normalised - true for the normalised Key_ column, otherwise the
+//                   column that holds the value as audited
+//
+//  Returns:
+//      Constant pointer to the column name
+//===============================================================================================//
+LPCWSTR AuditDatabase::GetKeyColumnName( size_t idxKey, bool normalised )
+{
+    LPCWSTR KEY_COLUMNS[ NUM_KEYS ]    = { L"Key_WinAudit_GUID",
+                                           L"Key_FQDN",
+                                           L"Key_Smbios_UUID",
+                                           L"Key_Asset_Tag",
+                                           L"Key_MAC_Address",
+                                           L"Key_OS_Product_ID",
+                                           L"Key_Computer_Name" };
+    LPCWSTR SOURCE_COLUMNS[ NUM_KEYS ] = { L"WinAudit_GUID",
+                                           L"Fully_Qualified_Domain_Name",
+                                           L"Smbios_UUID",
+                                           L"Asset_Tag",
+                                           L"MAC_Address",
+                                           L"OS_Product_ID",
+                                           L"Computer_Name" };
+    if ( idxKey >= NUM_KEYS )
     {
-        SqlQuery  = L"SELECT Computer_ID FROM Computer_Master WHERE ";
-        SqlQuery += Format.String2( L"%%1(Fully_Qualified_Domain_Name) = %%1(%%2)",
-                                    UpperCaseKeyword, FQDNClean );
-        SqlQuery += Format.String2( L" AND %%1(Smbios_UUID) = %%1(%%2)",
-                                    UpperCaseKeyword, SmbiosUuidClean );
-        SqlQuery += Format.String2( L" AND %%1(Asset_Tag) = %%1(%%2)",
-                                    UpperCaseKeyword, AssetTagClean );
-        ExecuteSelectSqlInteger( SqlQuery, &computerID );
-        if ( computerID )
-        {
-            PXSLogAppInfo( L"Matched computer using FULLY_QUALIFIED_DOMAIN_NAME +"
-                            "PXS_COMP_MASTER_SMBIOS_UUID + ASSET_TAG" );
-            SqlUpdateWinAuditGuid += Format.Int32( computerID );
-            ExecuteDirect( SqlUpdateWinAuditGuid );
-            return computerID;
-        }
+        throw BoundsException( L"idxKey", __FUNCTION__ );
     }
 
-    // FULLY_QUALIFIED_DOMAIN_NAME + SMBIOS_UUID
-    if ( FQDNClean.GetLength() && SmbiosUuidClean.GetLength() )
+    if ( normalised )
     {
-        SqlQuery  = L"SELECT Computer_ID FROM Computer_Master WHERE ";
-        SqlQuery += Format.String2( L"%%1(Fully_Qualified_Domain_Name) = %%1(%%2)",
-                                    UpperCaseKeyword, FQDNClean );
-        SqlQuery += Format.String2( L" AND %%1(Smbios_UUID) = %%1(%%2)",
-                                    UpperCaseKeyword, SmbiosUuidClean );
-        ExecuteSelectSqlInteger( SqlQuery, &computerID );
-        if ( computerID )
+        return KEY_COLUMNS[ idxKey ];
+    }
+    return SOURCE_COLUMNS[ idxKey ];
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the names of a table's columns
+//
+//  Parameters:
+//      pszTable - the table name
+//      pColumns - receives the column names
+//
+//  Remarks:
+//      An empty result set is enough to get the column names and does not
+//      abort the caller's transaction as would querying a missing column
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditDatabase::GetTableColumns( LPCWSTR pszTable, StringArray* pColumns )
+{
+    size_t i = 0, numColumns = 0;
+    String SqlQuery;
+    OdbcRecordSet RecordSet;
+
+    if ( ( pszTable == nullptr ) || ( *pszTable == PXS_CHAR_NULL ) )
+    {
+        throw ParameterException( L"pszTable", __FUNCTION__ );
+    }
+
+    if ( pColumns == nullptr )
+    {
+        throw ParameterException( L"pColumns", __FUNCTION__ );
+    }
+    pColumns->RemoveAll();
+
+    SqlQuery  = L"SELECT * FROM ";
+    SqlQuery += pszTable;
+    SqlQuery += L" WHERE 1 = 2";
+    RecordSet.Open( SqlQuery, this );
+    numColumns = RecordSet.GetColumnCount();
+    for ( i = 0; i < numColumns; i++ )
+    {
+        pColumns->Add( RecordSet.GetColumnName( i, false ) );
+    }
+    RecordSet.Close();
+}
+
+//===============================================================================================//
+//  Description:
+//      Determine if the Computer_Master table has the normalised key columns
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      The answer is kept until the connection changes or ClearSchemaCache is
+//      called as it is asked for on every export
+//
+//  Returns:
+//      true if the table has all the Key_ columns, else false
+//===============================================================================================//
+bool AuditDatabase::HasComputerMasterKeys()
+{
+    size_t  i = 0;
+    LPCWSTR pszKeyColumn = nullptr;
+    StringArray Columns;
+
+    if ( m_bKnowComputerMasterKeys )
+    {
+        return m_bHasComputerMasterKeys;
+    }
+
+    GetTableColumns( L"Computer_Master", &Columns );
+    m_bHasComputerMasterKeys = true;
+    for ( i = 0; i < NUM_KEYS; i++ )
+    {
+        pszKeyColumn = GetKeyColumnName( i, true );
+        if ( Columns.IndexOf( pszKeyColumn, false ) == PXS_MINUS_ONE )
         {
-            PXSLogAppInfo( L"Matched computer using FULLY_QUALIFIED_DOMAIN_NAME +"
-                            "PXS_COMP_MASTER_SMBIOS_UUID" );
-            SqlUpdateWinAuditGuid += Format.Int32( computerID );
-            ExecuteDirect( SqlUpdateWinAuditGuid );
-            return computerID;
+            m_bHasComputerMasterKeys = false;
         }
     }
+    m_bKnowComputerMasterKeys = true;
 
-    // MAC_ADDRESS + SMBIOS_UUID
-    if ( MacAddressClean.GetLength() && SmbiosUuidClean.GetLength() )
+    if ( m_bHasComputerMasterKeys == false )
     {
-        SqlQuery  = L"SELECT Computer_ID FROM Computer_Master WHERE ";
-        SqlQuery += Format.String2( L"%%1(MAC_Address) = %%1(%%2)",
-                                    UpperCaseKeyword, MacAddressClean );
-        SqlQuery += Format.String2( L" AND %%1(Smbios_UUID) = %%1(%%2)",
-                                    UpperCaseKeyword, SmbiosUuidClean );
-        ExecuteSelectSqlInteger( SqlQuery, &computerID );
-        if ( computerID )
+        PXSLogAppInfo( L"Computer_Master does not have the normalised key columns." );
+    }
+
+    return m_bHasComputerMasterKeys;
+}
+
+//===============================================================================================//
+//  Description:
+//      Determine if the database has the report summary tables
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      Uses the catalogue so a missing table does not abort a transaction.
+//      The answer is kept until the connection changes or ClearSchemaCache is
+//      called.
+//
+//  Returns:
+//      true if all the Summary_ tables exist, otherwise false
+//===============================================================================================//
+bool AuditDatabase::HasSummaryTables()
+{
+    size_t  i = 0;
+    LPCWSTR pszTable = nullptr, pszKeyColumn = nullptr, pszCountColumn = nullptr;
+    StringArray Tables;
+
+    if ( m_bKnowSummaryTables )
+    {
+        return m_bHasSummaryTables;
+    }
+
+    GetTables( true, false, false, &Tables );
+    m_bHasSummaryTables = true;
+    for ( i = 0; i <= NUM_SUMMARIES; i++ )
+    {
+        pszTable = L"Summary_Status";
+        if ( i < NUM_SUMMARIES )
+        {
+            GetSummaryNames( i, &pszTable, &pszKeyColumn, &pszCountColumn );
+        }
+
+        if ( Tables.IndexOf( pszTable, false ) == PXS_MINUS_ONE )
         {
-            PXSLogAppInfo( L"Matched computer using MAC_ADDRESS + SMBIOS_UUID" );
-            SqlUpdateWinAuditGuid += Format.Int32( computerID );
-            ExecuteDirect( SqlUpdateWinAuditGuid );
-            return computerID;
+            PXSLogAppInfo1( L"The database does not have table '%%1'.", pszTable );
+            m_bHasSummaryTables = false;
         }
     }
+    m_bKnowSummaryTables = true;
 
-    // MAC_ADDRESS + OS_PRODUCT_ID
-    if ( MacAddressClean.GetLength() && OsProductIDClean.GetLength() )
+    return m_bHasSummaryTables;
+}
+
+//===============================================================================================//
+//  Description:
+//      Get a computer's identifier from the Computer_Master table using
+//      various identifying data
+//
+//  Parameters:
+//      ComputerMaster - the computer master record
+//
+//  Remarks:
+//      20/04/2014 - will accept WINAUDIT_GUID alone or a reasonable combination
+//                   of two identifiers in the event identifiers are duplicated
+//                   on different machines.
+//
+//      19/10/2026 - one parameterised query on the indexed key columns
+//                   fetches the candidates, the combinations are then tested
+//                   against them in the same order of preference as before.
+//
+//  Returns:
+//      SQLINTEGER of the computer identifier, zero if not found
+//===============================================================================================//
+SQLINTEGER AuditDatabase::IdentifyComputerID( const AuditRecord& ComputerMaster )
+{
+    // Combinations in order of preference, all of a combination's keys must
+    // be present and equal. Unused slots are PXS_MINUS_ONE.
+    const size_t NUM_RULES = 8, NUM_RULE_KEYS = 3;
+    const size_t RULE_KEYS[ NUM_RULES ][ NUM_RULE_KEYS ] = {
+                 { KEY_WINAUDIT_GUID, PXS_MINUS_ONE    , PXS_MINUS_ONE },
+                 { KEY_FQDN         , KEY_SMBIOS_UUID  , KEY_ASSET_TAG },
+                 { KEY_FQDN         , KEY_SMBIOS_UUID  , PXS_MINUS_ONE },
+                 { KEY_MAC_ADDRESS  , KEY_SMBIOS_UUID  , PXS_MINUS_ONE },
+                 { KEY_MAC_ADDRESS  , KEY_OS_PRODUCT_ID, PXS_MINUS_ONE },
+                 { KEY_SMBIOS_UUID  , KEY_OS_PRODUCT_ID, PXS_MINUS_ONE },
+                 { KEY_FQDN         , KEY_OS_PRODUCT_ID, PXS_MINUS_ONE },
+                 { KEY_COMPUTER_NAME, KEY_OS_PRODUCT_ID, PXS_MINUS_ONE } };
+    LPCWSTR RULE_NAMES[ NUM_RULES ] = {
+                 L"WINAUDIT_GUID",
+                 L"FULLY_QUALIFIED_DOMAIN_NAME + SMBIOS_UUID + ASSET_TAG",
+                 L"FULLY_QUALIFIED_DOMAIN_NAME + SMBIOS_UUID",
+                 L"MAC_ADDRESS + SMBIOS_UUID",
+                 L"MAC_ADDRESS + OS_PRODUCT_ID",
+                 L"SMBIOS_UUID + OS_PRODUCT_ID",
+                 L"FULLY_QUALIFIED_DOMAIN_NAME + OS_PRODUCT_ID",
+                 L"COMPUTER_NAME + OS_PRODUCT_ID" };
+
+    // Every combination includes at least one of these so together they
+    // select all the candidates. Each has an index on its Key_ column.
+    const size_t NUM_INDEXED = 5;
+    const size_t INDEXED_KEYS[ NUM_INDEXED ] = { KEY_WINAUDIT_GUID,
+                                                 KEY_FQDN,
+                                                 KEY_MAC_ADDRESS,
+                                                 KEY_SMBIOS_UUID, KEY_COMPUTER_NAME };
+    bool       matched  = false, hasKeys = false;
+    size_t     i = 0, j = 0, k = 0, idxKey = 0, numRows = 0;
+    size_t     bestRule = PXS_MINUS_ONE, bestRow = PXS_MINUS_ONE;
+    String     UpperCaseKeyword, SqlQuery, WinAuditGuid, WinAuditGuidClean;
+    String     Column, Value, ValueClean;
+    Formatter  Format;
+    StringArray Keys, Columns, Parameters;
+    TArray< StringArray > Rows;
+    SQLINTEGER computerID = 0;
+
+    WinAuditGuid = PXS_STRING_EMPTY;
+    ComputerMaster.GetItemValue( PXS_COMP_MASTER_WINAUDIT_GUID , &WinAuditGuid );
+    if ( Format.IsValidStringGuid( WinAuditGuid ) == false )
     {
-        SqlQuery  = L"SELECT Computer_ID FROM Computer_Master WHERE ";
-        SqlQuery += Format.String2( L"%%1(MAC_Address) = %%1(%%2)",
-                                    UpperCaseKeyword, MacAddressClean );
-        SqlQuery += Format.String2( L" AND %%1(OS_Product_ID) = %%1(%%2)",
-                                    UpperCaseKeyword, OsProductIDClean );
-        ExecuteSelectSqlInteger( SqlQuery, &computerID );
-        if ( computerID )
+        PXSLogAppInfo1( L"Invalid WinAuditGUID '%%1'", WinAuditGuid );
+        throw SystemException( ERROR_INVALID_DATA, PXS_WINAUDIT_COMPUTER_GUID, __FUNCTION__ );
+    }
+    ComputerMasterRecordToKeys( ComputerMaster, &Keys );
+
+    // Compare with the normalised columns if present, otherwise with the
+    // upper case of the original columns as for a case sensitive database
+    hasKeys = HasComputerMasterKeys();
+    UpperCaseKeyword = PXS_STRING_EMPTY;
+    if ( ( hasKeys == false ) && IsCaseSensitiveSort() )
+    {
+        GetDbKeyWord( PXS_KEYWORD_UPPER, &UpperCaseKeyword );
+    }
+    for ( idxKey = 0; idxKey < NUM_KEYS; idxKey++ )
+    {
+        if ( hasKeys )
+        {
+            Columns.Add( GetKeyColumnName( idxKey, true ) );
+        }
+        else
         {
-            PXSLogAppInfo( L"Matched computer using MAC_ADDRESS + OS_PRODUCT_ID" );
-            SqlUpdateWinAuditGuid += Format.Int32( computerID );
-            ExecuteDirect( SqlUpdateWinAuditGuid );
-            return computerID;
+            Column = GetKeyColumnName( idxKey, false );
+            Columns.Add( Format.String2( L"%%1(%%2)", UpperCaseKeyword, Column ) );
         }
     }
 
-    // SMBIOS_UUID + OS_PRODUCT_ID
-    if ( SmbiosUuidClean.GetLength() && OsProductIDClean.GetLength() )
+    // The result set columns are Computer_ID then the keys in KEY_ order. An
+    // empty key is bound as NULL so its predicate never matches.
+    SqlQuery.Allocate( 512 );
+    SqlQuery = L"SELECT Computer_ID";
+    for ( idxKey = 0; idxKey < NUM_KEYS; idxKey++ )
     {
-        SqlQuery  = L"SELECT Computer_ID FROM Computer_Master WHERE ";
-        SqlQuery += Format.String2( L"%%1(Smbios_UUID) = %%1(%%2)",
-                                    UpperCaseKeyword, SmbiosUuidClean );
-        SqlQuery += Format.String2( L" AND %%1(OS_Product_ID) = %%1(%%2)",
-                                    UpperCaseKeyword, OsProductIDClean );
-        ExecuteSelectSqlInteger( SqlQuery, &computerID );
-        if ( computerID )
+        SqlQuery += L", ";
+        SqlQuery += Columns.Get( idxKey );
+    }
+    SqlQuery += L" FROM Computer_Master WHERE ";
+    for ( i = 0; i < NUM_INDEXED; i++ )
+    {
+        if ( i )
         {
-            PXSLogAppInfo( L"Matched computer using SMBIOS_UUID + OS_PRODUCT_ID" );
-            SqlUpdateWinAuditGuid += Format.Int32( computerID );
-            ExecuteDirect( SqlUpdateWinAuditGuid );
-            return computerID;
+            SqlQuery += L" OR ";
         }
+        SqlQuery += Columns.Get( INDEXED_KEYS[ i ] );
+        SqlQuery += L" = ?";
+        Parameters.Add( Keys.Get( INDEXED_KEYS[ i ] ) );
     }
+    numRows = ExecuteSelectParams( SqlQuery, Parameters, &Rows );
 
-    // FULLY_QUALIFIED_DOMAIN_NAME + OS_PRODUCT_ID
-    if ( FQDNClean.GetLength() && OsProductIDClean.GetLength() )
+    // Find the candidate that satisfies the most preferred combination
+    for ( i = 0; i < numRows; i++ )
     {
-        SqlQuery  = L"SELECT Computer_ID FROM Computer_Master WHERE ";
-        SqlQuery += Format.String2( L"%%1(Fully_Qualified_Domain_Name) = %%1(%%2)",
-                                    UpperCaseKeyword, FQDNClean );
-        SqlQuery += Format.String2( L" AND %%1(OS_Product_ID) = %%1(%%2)",
-                                    UpperCaseKeyword, OsProductIDClean );
-        ExecuteSelectSqlInteger( SqlQuery, &computerID );
-        if ( computerID )
+        const StringArray& Row = Rows.Get( i );
+        for ( j = 0; ( j < NUM_RULES ) && ( j < bestRule ); j++ )
         {
-            PXSLogAppInfo( L"Matched computer using FULLY_QUALIFIED_DOMAIN_NAME + OS_PRODUCT_ID" );
-            SqlUpdateWinAuditGuid += Format.Int32( computerID );
-            ExecuteDirect( SqlUpdateWinAuditGuid );
-            return computerID;
+            matched = true;
+            for ( k = 0; matched && ( k < NUM_RULE_KEYS ); k++ )
+            {
+                idxKey = RULE_KEYS[ j ][ k ];
+                if ( idxKey != PXS_MINUS_ONE )
+                {
+                    Value = Keys.Get( idxKey );
+                    if ( Value.IsEmpty() || Value.CompareI( Row.Get( idxKey + 1 ) ) )
+                    {
+                        matched = false;
+                    }
+                }
+            }
+
+            if ( matched )
+            {
+                bestRule = j;
+                bestRow  = i;
+            }
         }
     }
 
-    // COMPUTER_NAME + OS_PRODUCT_ID
-    if ( ComputerNameClean.GetLength() && OsProductIDClean.GetLength() )
+    if ( bestRow == PXS_MINUS_ONE )
     {
-        SqlQuery  = L"SELECT Computer_ID FROM Computer_Master WHERE ";
-        SqlQuery += Format.String2( L"%%1(Computer_Name) = %%1(%%2)",
-                                    UpperCaseKeyword, ComputerNameClean );
-        SqlQuery += Format.String2( L" AND %%1(OS_Product_ID) = %%1(%%2)",
-                                    UpperCaseKeyword, OsProductIDClean );
-        ExecuteSelectSqlInteger( SqlQuery, &computerID );
-        if ( computerID )
+        PXSLogAppInfo( L"Did not find matching Computer_ID Computer_Master table." );
+        return 0;
+    }
+    computerID = Format.StringToInt32( Rows.Get( bestRow ).Get( 0 ) );
+    PXSLogAppInfo1( L"Matched computer using %%1", RULE_NAMES[ bestRule ] );
+
+    // Matched on identifiers other than the WinAuditGuid so record it for
+    // the next time.
+    if ( bestRule != 0 )
+    {
+        FixUpStringSQL( WinAuditGuid, SQL_VARCHAR, &WinAuditGuidClean );
+        SqlQuery  = L"UPDATE Computer_Master SET WinAudit_GUID = ";
+        SqlQuery += WinAuditGuidClean;
+        if ( hasKeys )
         {
-            PXSLogAppInfo( L"Matched computer using COMPUTER_NAME + OS_PRODUCT_ID" );
-            SqlUpdateWinAuditGuid += Format.Int32( computerID );
-            ExecuteDirect( SqlUpdateWinAuditGuid );
-            return computerID;
+            Column = GetKeyColumnName( KEY_WINAUDIT_GUID, true );
+            Value  = Keys.Get( KEY_WINAUDIT_GUID );
+            FixUpStringSQL( Value, SQL_VARCHAR, &ValueClean );
+            SqlQuery += Format.String2( L", %%1 = %%2", Column, ValueClean );
         }
+        SqlQuery += L" WHERE Computer_ID = ";
+        SqlQuery += Format.Int32( computerID );
+        ExecuteDirect( SqlQuery );
     }
 
-    PXSLogAppInfo( L"Did not find matching Computer_ID Computer_Master table." );
-    return 0;
+    return computerID;
 }
 
 /*
@@ -644,6 +983,7 @@ SQLINTEGER AuditDatabase::InsertComputerMaster( const AuditRecord& ComputerMaste
     String     SiteName, DomainName, ComputerName, OsProductID;
     String     OtherIdentifier, WinAuditGUID, SqlQuery, ErrorMessage;
     Formatter  Format;
+    StringArray Keys;
     SQLINTEGER computerID = 0;
 
     ComputerGUID  = L"'";
@@ -728,32 +1068,231 @@ SQLINTEGER AuditDatabase::InsertComputerMaster( const AuditRecord& ComputerMaste
         SqlQuery += Format.String1( L"%%1 )", WinAuditGUID );
     }
 
-    // Test for a transaction otherwise execute directly.
-    if ( StartedTrans() )
+    // Test for a transaction otherwise execute directly.
+    if ( StartedTrans() )
+    {
+        ExecuteTrans( SqlQuery );
+    }
+    else
+    {
+        ExecuteDirect( SqlQuery );
+    }
+
+    // Get the computer id.
+    SqlQuery  = L"SELECT Computer_ID FROM Computer_Master ";
+    SqlQuery += L"WHERE Computer_GUID = ";
+    SqlQuery += ComputerGUID;
+    ExecuteSelectSqlInteger( SqlQuery, &computerID );
+    if ( computerID <= 0 )
+    {
+        ErrorMessage  = L"computerID <= 0\r\n\r\n";
+        ErrorMessage += L"SQL:\r\n";
+        ErrorMessage += SqlQuery;
+        ErrorMessage += PXS_STRING_CRLF;
+        throw Exception( PXS_ERROR_TYPE_APPLICATION,
+                         PXS_ERROR_DB_OPERATION_FAILED, ErrorMessage.c_str(), __FUNCTION__ );
+    }
+
+    // The stored procedures predate the key columns so set them separately
+    if ( HasComputerMasterKeys() )
+    {
+        ComputerMasterRecordToKeys( ComputerMaster, &Keys );
+        SetComputerMasterKeys( computerID, Keys );
+    }
+
+    return computerID;
+}
+
+//===============================================================================================//
+//  Description:
+//      Determine if the report summary tables are out of date
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      Not kept as other exports can mark them stale at any time
+//
+//  Returns:
+//      true if they need rebuilding or the status is missing, otherwise false
+//===============================================================================================//
+bool AuditDatabase::IsSummaryStale()
+{
+    String     SqlQuery;
+    SQLINTEGER isStale = 0;
+
+    SqlQuery = L"SELECT Is_Stale FROM Summary_Status WHERE Status_ID = 1";
+    if ( ExecuteSelectSqlInteger( SqlQuery, &isStale ) == false )
+    {
+        return true;
+    }
+
+    return ( isStale != 0 );
+}
+
+//===============================================================================================//
+//  Description:
+//      Regenerate the report summary tables from the computers' last audits
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      Done in one transaction so the reports never see a partial rebuild.
+//      Clears the stale mark.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditDatabase::RebuildSummaryTables()
+{
+    size_t  i = 0;
+    String  SqlQuery, SelectSql;
+    LPCWSTR pszTable = nullptr, pszKeyColumn = nullptr, pszCountColumn = nullptr;
+
+    PXSLogAppInfo( L"Rebuilding the report summary tables." );
+    BeginTrans();
+    try
+    {
+        for ( i = 0; i < NUM_SUMMARIES; i++ )
+        {
+            GetSummaryNames( i, &pszTable, &pszKeyColumn, &pszCountColumn );
+            SqlQuery  = L"DELETE FROM ";
+            SqlQuery += pszTable;
+            ExecuteTrans( SqlQuery );
+
+            MakeSummarySelectSql( i, 0, &SelectSql );
+            SqlQuery.Allocate( 512 );
+            SqlQuery  = L"INSERT INTO ";
+            SqlQuery += pszTable;
+            SqlQuery += L" ( ";
+            SqlQuery += pszKeyColumn;
+            SqlQuery += L", ";
+            SqlQuery += pszCountColumn;
+            SqlQuery += L" ) ";
+            SqlQuery += SelectSql;
+            ExecuteTrans( SqlQuery );
+        }
+        SqlQuery = L"UPDATE Summary_Status SET Is_Stale = 0 WHERE Status_ID = 1";
+        if ( ExecuteTrans( SqlQuery, 1 ) == 0 )
+        {
+            SqlQuery = L"INSERT INTO Summary_Status ( Status_ID, Is_Stale ) VALUES ( 1, 0 )";
+            ExecuteTrans( SqlQuery, 1 );
+        }
+    }
+    catch ( const Exception& )
+    {
+        RollbackTrans();
+        throw;
+    }
+    CommitTrans();
+    PXSLogAppInfo( L"Rebuilt the report summary tables." );
+}
+
+//===============================================================================================//
+//  Description:
+//      Make an audit the last one of its computer and bring the report
+//      summary tables up to date
+//
+//  Parameters:
+//      computerID - the computer identifier
+//      auditID    - the audit identifier
+//
+//  Remarks:
+//      The computer's summary counts are read before and after its
+//      Last_Audit_ID is changed and the difference applied, all in one
+//      transaction so the summaries always match the last audits. Exports
+//      running at the same time can both insert the same key so a failed
+//      transaction is tried again. If it still fails, e.g. the user has no
+//      grant on the summaries, Last_Audit_ID is updated in the same
+//      transaction as the summaries are marked stale so the reports stop
+//      using them until they are rebuilt.
+//
+//      A database without the summary tables, or where they are already
+//      stale, only has Last_Audit_ID updated.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditDatabase::SetLastAuditID( SQLINTEGER computerID, SQLINTEGER auditID )
+{
+    const  DWORD NUM_ATTEMPTS = 3;
+    DWORD     attempt = 0;
+    size_t    i = 0;
+    bool      hasSummaries = false;
+    String    SqlQuery, StaleSql;
+    Formatter Format;
+    TArray< NameValue > OldCounts[ NUM_SUMMARIES ];
+    TArray< NameValue > NewCounts;
+
+    if ( computerID <= 0 )
+    {
+       throw ParameterException( L"computerID", __FUNCTION__ );
+    }
+
+    if ( auditID <= 0 )
     {
-        ExecuteTrans( SqlQuery );
+        throw ParameterException( L"auditID", __FUNCTION__ );
     }
-    else
+
+    // Look in the catalogue before starting the transaction
+    hasSummaries = HasSummaryTables();
+    if ( hasSummaries && IsSummaryStale() )
     {
-        ExecuteDirect( SqlQuery );
+        hasSummaries = false;
     }
 
-    // Get the computer id.
-    SqlQuery  = L"SELECT Computer_ID FROM Computer_Master ";
-    SqlQuery += L"WHERE Computer_GUID = ";
-    SqlQuery += ComputerGUID;
-    ExecuteSelectSqlInteger( SqlQuery, &computerID );
-    if ( computerID <= 0 )
+    SqlQuery  = L"UPDATE Computer_Master SET Last_Audit_ID=";
+    SqlQuery += Format.Int32( auditID );
+    SqlQuery += L" WHERE Computer_ID=";
+    SqlQuery += Format.Int32( computerID );
+    for ( attempt = 1; hasSummaries && ( attempt <= NUM_ATTEMPTS ); attempt++ )
     {
-        ErrorMessage  = L"computerID <= 0\r\n\r\n";
-        ErrorMessage += L"SQL:\r\n";
-        ErrorMessage += SqlQuery;
-        ErrorMessage += PXS_STRING_CRLF;
-        throw Exception( PXS_ERROR_TYPE_APPLICATION,
-                         PXS_ERROR_DB_OPERATION_FAILED, ErrorMessage.c_str(), __FUNCTION__ );
+        BeginTrans();
+        try
+        {
+            for ( i = 0; i < NUM_SUMMARIES; i++ )
+            {
+                GetSummaryCounts( i, computerID, &OldCounts[ i ] );
+            }
+            ExecuteTrans( SqlQuery, 1 );   // Limit to 1 row
+
+            for ( i = 0; i < NUM_SUMMARIES; i++ )
+            {
+                GetSummaryCounts( i, computerID, &NewCounts );
+                ApplySummaryDeltas( i, OldCounts[ i ], NewCounts );
+            }
+            CommitTrans();
+            return;
+        }
+        catch ( const Exception& e )
+        {
+            RollbackTrans();
+            PXSLogException( Format.StringUInt32( L"Failed to update the report summaries, "
+                                                  L"attempt %%1.", attempt ).c_str(),
+                             e, __FUNCTION__ );
+        }
+        Sleep( 100 * attempt );     // Let the other export finish
     }
 
-    return computerID;
+    // Never set Last_Audit_ID without either the deltas or the stale mark
+    BeginTrans();
+    try
+    {
+        if ( hasSummaries )
+        {
+            StaleSql = L"UPDATE Summary_Status SET Is_Stale = 1 WHERE Status_ID = 1";
+            ExecuteTrans( StaleSql, 1 );
+            PXSLogAppWarn( L"Marked the report summaries as needing to be rebuilt." );
+        }
+        ExecuteTrans( SqlQuery, 1 );
+    }
+    catch ( const Exception& )
+    {
+        RollbackTrans();
+        throw;
+    }
+    CommitTrans();
 }
 
 //===============================================================================================//
@@ -775,6 +1314,7 @@ void AuditDatabase::UpdateComputerMaster( const AuditRecord& ComputerMaster,
     String AssetTag, FQDN, SiteName, DomainName, ComputerName, OsProductID;
     String OtherIdentifier, WinAuditGUID, SqlQuery, AuditIDString;
     Formatter Format;
+    StringArray Keys;
 
     if ( computerID <= 0 )
     {
@@ -838,6 +1378,12 @@ void AuditDatabase::UpdateComputerMaster( const AuditRecord& ComputerMaster,
     {
         ExecuteDirect( SqlQuery );
     }
+
+    if ( HasComputerMasterKeys() )
+    {
+        ComputerMasterRecordToKeys( ComputerMaster, &Keys );
+        SetComputerMasterKeys( computerID, Keys );
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -848,6 +1394,137 @@ void AuditDatabase::UpdateComputerMaster( const AuditRecord& ComputerMaster,
 // Private Methods
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+//===============================================================================================//
+//  Description:
+//      Apply the difference between a computer's old and new counts to a
+//      report summary table
+//
+//  Parameters:
+//      idxSummary - the summary, one of the SUMMARY_ constants
+//      OldCounts  - the counts of the audit being replaced, sorted on key
+//      NewCounts  - the counts of the new audit, sorted on key
+//
+//  Remarks:
+//      The arrays are merged so only keys whose counts differ are written,
+//      and always in key order so concurrent exports take their row locks
+//      in the same order. Keys are sorted ignoring case, those that only
+//      differ in case are treated as different keys and left for the
+//      database's collation to resolve.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditDatabase::ApplySummaryDeltas( size_t idxSummary,
+                                        const TArray< NameValue >& OldCounts,
+                                        const TArray< NameValue >& NewCounts )
+{
+    int        compare  = 0;
+    size_t     idxOld   = 0, idxNew = 0;
+    size_t     numOld   = OldCounts.GetSize();
+    size_t     numNew   = NewCounts.GetSize();
+    SQLINTEGER oldCount = 0, newCount = 0;
+    Formatter  Format;
+
+    while ( ( idxOld < numOld ) || ( idxNew < numNew ) )
+    {
+        if ( idxOld == numOld )
+        {
+            compare = 1;
+        }
+        else if ( idxNew == numNew )
+        {
+            compare = -1;
+        }
+        else
+        {
+            const String& OldKey = OldCounts.Get( idxOld ).GetName();
+            const String& NewKey = NewCounts.Get( idxNew ).GetName();
+            compare = PXSCompareString( OldKey.c_str(), NewKey.c_str(), false );
+            if ( ( compare == 0 ) &&
+                 ( PXSCompareString( OldKey.c_str(), NewKey.c_str(), true ) != 0 ) )
+            {
+                compare = -1;
+            }
+        }
+
+        if ( compare < 0 )
+        {
+            const NameValue& Old = OldCounts.Get( idxOld );
+            oldCount = Format.StringToInt32( Old.GetValue() );
+            UpdateSummaryCount( idxSummary, Old.GetName(), -oldCount );
+            idxOld++;
+        }
+        else if ( compare > 0 )
+        {
+            const NameValue& New = NewCounts.Get( idxNew );
+            newCount = Format.StringToInt32( New.GetValue() );
+            UpdateSummaryCount( idxSummary, New.GetName(), newCount );
+            idxNew++;
+        }
+        else
+        {
+            oldCount = Format.StringToInt32( OldCounts.Get( idxOld ).GetValue() );
+            newCount = Format.StringToInt32( NewCounts.Get( idxNew ).GetValue() );
+            UpdateSummaryCount( idxSummary,
+                                NewCounts.Get( idxNew ).GetName(), newCount - oldCount );
+            idxOld++;
+            idxNew++;
+        }
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the normalised identifying keys of a computer_master record
+//
+//  Parameters:
+//      ComputerMaster - the computer_master record
+//      pKeys          - receives the keys in KEY_ order, an invalid or
+//                       missing value is an empty string
+//
+//  Remarks:
+//      Keys are trimmed and upper case to match the Key_ columns
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditDatabase::ComputerMasterRecordToKeys( const AuditRecord& ComputerMaster,
+                                                StringArray* pKeys )
+{
+    const DWORD ITEM_IDS[ NUM_KEYS ] = { PXS_COMP_MASTER_WINAUDIT_GUID,
+                                         PXS_COMP_MASTER_FQDN,
+                                         PXS_COMP_MASTER_SMBIOS_UUID,
+                                         PXS_COMP_MASTER_ASSET_TAG,
+                                         PXS_COMP_MASTER_MAC_ADDRESS,
+                                         PXS_COMP_MASTER_OS_PRODUCT_ID,
+                                         PXS_COMP_MASTER_COMPUTER_NAME };
+    size_t    idxKey = 0;
+    String    Value;
+    Formatter Format;
+
+    if ( pKeys == nullptr )
+    {
+        throw ParameterException( L"pKeys", __FUNCTION__ );
+    }
+    pKeys->RemoveAll();
+
+    for ( idxKey = 0; idxKey < NUM_KEYS; idxKey++ )
+    {
+        Value = PXS_STRING_EMPTY;
+        ComputerMaster.GetItemValue( ITEM_IDS[ idxKey ], &Value );
+        Value.Trim();
+
+        // Same validation as when the values are stored
+        if ( ( ( idxKey == KEY_MAC_ADDRESS ) && !Format.IsValidMacAddress( Value ) ) ||
+             ( ( idxKey == KEY_SMBIOS_UUID ) && !Format.IsValidStringGuid( Value ) )  )
+        {
+            Value = PXS_STRING_EMPTY;
+        }
+        Value.ToUppercase();
+        pKeys->Add( Value );
+    }
+}
+
 //===============================================================================================//
 //  Description:
 //      Get the values in the computer_master record
@@ -1013,3 +1690,397 @@ void AuditDatabase::ComputerMasterRecordToValues(
         PXSLogAppError1( L"Invalid WinAudit GUID: '%%1'", Value );
     }
 }
+
+//===============================================================================================//
+//  Description:
+//      Get the report summary counts of a computer's last audit
+//
+//  Parameters:
+//      idxSummary - the summary, one of the SUMMARY_ constants
+//      computerID - the computer identifier
+//      pCounts    - receives the key/count pairs sorted on the key
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditDatabase::GetSummaryCounts( size_t idxSummary,
+                                      SQLINTEGER computerID, TArray< NameValue >* pCounts )
+{
+    size_t    numCounts = 0;
+    __int64   value     = 0;
+    String    SqlQuery, Key, Count;
+    NameValue Element;
+    Formatter Format;
+    OdbcRecordSet RecordSet;
+
+    if ( pCounts == nullptr )
+    {
+        throw ParameterException( L"pCounts", __FUNCTION__ );
+    }
+    pCounts->RemoveAll();
+
+    if ( computerID <= 0 )
+    {
+       throw ParameterException( L"computerID", __FUNCTION__ );
+    }
+
+    MakeSummarySelectSql( idxSummary, computerID, &SqlQuery );
+    RecordSet.Open( SqlQuery, this );
+    while ( RecordSet.MoveNext() )
+    {
+        value = 0;
+        Key   = RecordSet.FieldValue( 0 );
+        RecordSet.FieldInt64( 1, &value );
+        if ( Key.GetLength() && ( value > 0 ) )
+        {
+            // Grow by doubling as adding one at a time copies the array
+            if ( numCounts == pCounts->GetSize() )
+            {
+                pCounts->SetSize( PXSAddSizeT( PXSMultiplySizeT( numCounts, 2 ), 16 ) );
+            }
+            Count = Format.Int64( value );
+            Element.SetNameValue( Key, Count );
+            pCounts->Set( numCounts, Element );
+            numCounts++;
+        }
+    }
+    RecordSet.Close();
+    pCounts->SetSize( numCounts );
+    PXSSortNameValueArray( pCounts );
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the table and column names of a report summary
+//
+//  Parameters:
+//      idxSummary      - the summary, one of the SUMMARY_ constants
+//      ppszTable       - receives the table name
+//      ppszKeyColumn   - receives the name of the key column
+//      ppszCountColumn - receives the name of the count column
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditDatabase::GetSummaryNames( size_t idxSummary,
+                                     LPCWSTR* ppszTable,
+                                     LPCWSTR* ppszKeyColumn, LPCWSTR* ppszCountColumn )
+{
+    LPCWSTR TABLES[ NUM_SUMMARIES ]        = { L"Summary_Software",
+                                               L"Summary_Errors",
+                                               L"Summary_Domains" };
+    LPCWSTR KEY_COLUMNS[ NUM_SUMMARIES ]   = { L"Software_Name",
+                                               L"Error_Type",
+                                               L"Domain_Name" };
+    LPCWSTR COUNT_COLUMNS[ NUM_SUMMARIES ] = { L"Installed_Count",
+                                               L"Error_Count",
+                                               L"Computer_Count" };
+
+    if ( ( ppszTable       == nullptr ) ||
+         ( ppszKeyColumn   == nullptr ) ||
+         ( ppszCountColumn == nullptr )  )
+    {
+        throw ParameterException( L"ppszTable/ppszKeyColumn/ppszCountColumn", __FUNCTION__ );
+    }
+
+    if ( idxSummary >= NUM_SUMMARIES )
+    {
+        throw BoundsException( L"idxSummary", __FUNCTION__ );
+    }
+    *ppszTable       = TABLES[ idxSummary ];
+    *ppszKeyColumn   = KEY_COLUMNS[ idxSummary ];
+    *ppszCountColumn = COUNT_COLUMNS[ idxSummary ];
+}
+
+//===============================================================================================//
+//  Description:
+//      Make the WHERE clause predicate that selects audits outside the
+//      retention policy
+//
+//  Parameters:
+//      DbmsName    - the database's SQL_DBMS_NAME, e.g. PXS_DBMS_NAME_SQLITE
+//      retainCount - the number of most recent audits to keep per computer,
+//                    at least one so Last_Audit_ID is never orphaned
+//      retainDays  - keep audits newer than this many days, zero for no
+//                    age limit
+//      pPredicate  - receives the predicate, Audit_Master has the alias am
+//
+//  Remarks:
+//      An audit is old if the computer has at least retainCount newer ones
+//      and, when there is an age limit, it was stored before the cut-off.
+//      The sub-query is answered from the index on Audit_Master.Computer_ID.
+//      SQLite stores Database_Local as local time text so the cut-off is
+//      made the same way.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditDatabase::MakeOldAuditsPredicate( const String& DbmsName,
+                                            DWORD retainCount,
+                                            DWORD retainDays, String* pPredicate )
+{
+    String    Days, CutOff;
+    Formatter Format;
+
+    if ( pPredicate == nullptr )
+    {
+        throw ParameterException( L"pPredicate", __FUNCTION__ );
+    }
+
+    if ( retainCount == 0 )
+    {
+        throw ParameterException( L"retainCount", __FUNCTION__ );
+    }
+
+    *pPredicate  = L"( SELECT COUNT(*) FROM Audit_Master AS newer "
+                   L"WHERE newer.Computer_ID = am.Computer_ID "
+                   L"AND newer.Audit_ID > am.Audit_ID ) >= ";
+    *pPredicate += Format.UInt32( retainCount );
+
+    if ( retainDays == 0 )
+    {
+        return;
+    }
+
+    // Date arithmetic is database specific
+    Days = Format.UInt32( retainDays );
+    if ( DbmsName.CompareI( PXS_DBMS_NAME_ACCESS ) == 0 )
+    {
+        CutOff = Format.String1( L"DateAdd( 'd', -%%1, Now() )", Days );
+    }
+    else if ( DbmsName.CompareI( PXS_DBMS_NAME_SQL_SERVER ) == 0 )
+    {
+        CutOff = Format.String1( L"DATEADD( day, -%%1, CURRENT_TIMESTAMP )", Days );
+    }
+    else if ( DbmsName.CompareI( PXS_DBMS_NAME_MYSQL ) == 0 )
+    {
+        CutOff = Format.String1( L"DATE_SUB( CURRENT_TIMESTAMP, INTERVAL %%1 DAY )", Days );
+    }
+    else if ( DbmsName.CompareI( PXS_DBMS_NAME_POSTGRE_SQL ) == 0 )
+    {
+        CutOff = Format.String1( L"CURRENT_TIMESTAMP - INTERVAL '%%1 days'", Days );
+    }
+    else if ( DbmsName.CompareI( PXS_DBMS_NAME_SQLITE ) == 0 )
+    {
+        CutOff = Format.String1( L"datetime( 'now', 'localtime', '-%%1 days' )", Days );
+    }
+    else
+    {
+        throw SystemException( ERROR_NOT_SUPPORTED, DbmsName.c_str(), __FUNCTION__ );
+    }
+    *pPredicate += L" AND am.Database_Local < ";
+    *pPredicate += CutOff;
+}
+
+//===============================================================================================//
+//  Description:
+//      Make the SELECT statement that counts a report summary's keys over
+//      the last audits
+//
+//  Parameters:
+//      idxSummary - the summary, one of the SUMMARY_ constants
+//      computerID - limit to this computer, zero for all computers
+//      pSqlQuery  - receives the statement, its columns are the key and count
+//
+//  Remarks:
+//      Keys are grouped the same way as the original reports, i.e. by UPPER
+//      if the database sorts case sensitively. NULL and empty keys are not
+//      counted. Only computers that have a last audit are counted by domain.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditDatabase::MakeSummarySelectSql( size_t idxSummary,
+                                          SQLINTEGER computerID, String* pSqlQuery )
+{
+    String    UpperKeyword, ComputerIDString, Filter;
+    Formatter Format;
+
+    if ( pSqlQuery == nullptr )
+    {
+        throw ParameterException( L"pSqlQuery", __FUNCTION__ );
+    }
+    *pSqlQuery = PXS_STRING_EMPTY;
+
+    if ( IsCaseSensitiveSort() )
+    {
+        GetDbKeyWord( PXS_KEYWORD_UPPER, &UpperKeyword );
+    }
+
+    if ( computerID > 0 )
+    {
+        ComputerIDString = Format.Int32( computerID );
+        Filter = Format.String1( L" AND Computer_Master.Computer_ID = %%1", ComputerIDString );
+    }
+
+    switch ( idxSummary )
+    {
+        case SUMMARY_SOFTWARE:
+            *pSqlQuery = L"SELECT %%1( Audit_Data.Item_1 ), COUNT(*) "
+                         L"FROM Computer_Master INNER JOIN Audit_Data ON "
+                         L"Computer_Master.Last_Audit_ID = Audit_Data.Audit_ID "
+                         L"WHERE Audit_Data.Category_ID = 500 "
+                         L"AND Audit_Data.Item_1 <> ''%%2 "
+                         L"GROUP BY %%1( Audit_Data.Item_1 )";
+            break;
+
+        case SUMMARY_ERRORS:
+            *pSqlQuery = L"SELECT %%1( Audit_Data.Item_3 ), COUNT(*) "
+                         L"FROM Computer_Master INNER JOIN Audit_Data ON "
+                         L"Computer_Master.Last_Audit_ID = Audit_Data.Audit_ID "
+                         L"WHERE Audit_Data.Category_ID = 2200 "
+                         L"AND Audit_Data.Item_3 <> ''%%2 "
+                         L"GROUP BY %%1( Audit_Data.Item_3 )";
+            break;
+
+        case SUMMARY_DOMAINS:
+            *pSqlQuery = L"SELECT %%1( Computer_Master.Domain_Name ), COUNT(*) "
+                         L"FROM Computer_Master "
+                         L"WHERE Computer_Master.Last_Audit_ID > 0 "
+                         L"AND Computer_Master.Domain_Name <> ''%%2 "
+                         L"GROUP BY %%1( Computer_Master.Domain_Name )";
+            break;
+
+        default:
+            throw BoundsException( L"idxSummary", __FUNCTION__ );
+    }
+    pSqlQuery->ReplaceI( L"%%1", UpperKeyword.c_str() );
+    pSqlQuery->ReplaceI( L"%%2", Filter.c_str() );
+}
+
+//===============================================================================================//
+//  Description:
+//      Set the normalised key columns of a computer in the computer_master table
+//
+//  Parameters:
+//      computerID - the computer identifier
+//      Keys       - the keys in KEY_ order as from ComputerMasterRecordToKeys
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditDatabase::SetComputerMasterKeys( SQLINTEGER computerID, const StringArray& Keys )
+{
+    size_t    idxKey = 0;
+    String    SqlQuery, Column, Value, ValueClean;
+    Formatter Format;
+
+    if ( computerID <= 0 )
+    {
+       throw ParameterException( L"computerID", __FUNCTION__ );
+    }
+
+    if ( Keys.GetSize() != NUM_KEYS )
+    {
+       throw ParameterException( L"Keys", __FUNCTION__ );
+    }
+
+    SqlQuery.Allocate( 512 );
+    SqlQuery = L"UPDATE Computer_Master SET ";
+    for ( idxKey = 0; idxKey < NUM_KEYS; idxKey++ )
+    {
+        ValueClean = L"NULL";
+        Value      = Keys.Get( idxKey );
+        if ( Value.GetLength() )
+        {
+            FixUpStringSQL( Value, SQL_VARCHAR, &ValueClean );
+        }
+
+        if ( idxKey )
+        {
+            SqlQuery += L", ";
+        }
+        Column    = GetKeyColumnName( idxKey, true );
+        SqlQuery += Format.String2( L"%%1=%%2", Column, ValueClean );
+    }
+    SqlQuery += L" WHERE Computer_ID = ";
+    SqlQuery += Format.Int32( computerID );
+
+    // Test for a transaction otherwise execute directly.
+    if ( StartedTrans() )
+    {
+        ExecuteTrans( SqlQuery, 1 );    // Limit to 1 record
+    }
+    else
+    {
+        ExecuteDirect( SqlQuery );
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Add to the count of a key in a report summary table
+//
+//  Parameters:
+//      idxSummary - the summary, one of the SUMMARY_ constants
+//      Key        - the key
+//      delta      - the amount to add, can be negative
+//
+//  Remarks:
+//      Must be in a transaction. A key not in the table is inserted and one
+//      whose count falls to zero is deleted. The drivers used report the
+//      rows an UPDATE affected, if one does not then the key is assumed to
+//      be present.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditDatabase::UpdateSummaryCount( size_t idxSummary, const String& Key, SQLINTEGER delta )
+{
+    SQLLEN    rowCount = 0;
+    String    SqlQuery, KeyClean, Delta;
+    LPCWSTR   pszTable = nullptr, pszKeyColumn = nullptr, pszCountColumn = nullptr;
+    Formatter Format;
+
+    if ( delta == 0 )
+    {
+        return;     // Nothing to do
+    }
+    GetSummaryNames( idxSummary, &pszTable, &pszKeyColumn, &pszCountColumn );
+    FixUpStringSQL( Key, SQL_VARCHAR, &KeyClean );
+    Delta = Format.Int32( delta );
+
+    SqlQuery.Allocate( 512 );
+    SqlQuery  = L"UPDATE ";
+    SqlQuery += pszTable;
+    SqlQuery += L" SET ";
+    SqlQuery += pszCountColumn;
+    SqlQuery += L" = ";
+    SqlQuery += pszCountColumn;
+    SqlQuery += L" + ( ";
+    SqlQuery += Delta;
+    SqlQuery += L" ) WHERE ";
+    SqlQuery += pszKeyColumn;
+    SqlQuery += L" = ";
+    SqlQuery += KeyClean;
+    rowCount  = ExecuteTrans( SqlQuery, 1 );    // Limit to 1 row
+
+    if ( ( rowCount == 0 ) && ( delta > 0 ) )
+    {
+        SqlQuery  = L"INSERT INTO ";
+        SqlQuery += pszTable;
+        SqlQuery += L" ( ";
+        SqlQuery += pszKeyColumn;
+        SqlQuery += L", ";
+        SqlQuery += pszCountColumn;
+        SqlQuery += L" ) VALUES ( ";
+        SqlQuery += KeyClean;
+        SqlQuery += L", ";
+        SqlQuery += Delta;
+        SqlQuery += L" )";
+        ExecuteTrans( SqlQuery, 1 );
+    }
+    else if ( delta < 0 )
+    {
+        SqlQuery  = L"DELETE FROM ";
+        SqlQuery += pszTable;
+        SqlQuery += L" WHERE ";
+        SqlQuery += pszKeyColumn;
+        SqlQuery += L" = ";
+        SqlQuery += KeyClean;
+        SqlQuery += L" AND ";
+        SqlQuery += pszCountColumn;
+        SqlQuery += L" <= 0";
+        ExecuteTrans( SqlQuery, 1 );
+    }
+}
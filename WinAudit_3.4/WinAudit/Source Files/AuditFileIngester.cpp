@@ -0,0 +1,718 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Audit File Ingester Class Implementation
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Header Files/AuditFileIngester.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/AutoCloseHandle.h"
+#include "PxsBase/Header Files/Directory.h"
+#include "PxsBase/Header Files/File.h"
+#include "PxsBase/Header Files/Formatter.h"
+#include "PxsBase/Header Files/ParameterException.h"
+#include "PxsBase/Header Files/StringArray.h"
+#include "PxsBase/Header Files/SystemException.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/AuditDatabase.h"
+#include "WinAudit/Header Files/OdbcExportDialog.h"
+#include "WinAudit/Header Files/SqliteDatabase.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Default constructor
+AuditFileIngester::AuditFileIngester()
+                  :m_pBatchMT( nullptr )
+{
+}
+
+// Copy constructor - not allowed so no implementation
+
+// Destructor
+AuditFileIngester::~AuditFileIngester()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Operators
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Assignment operator - not allowed so no implementation
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Public Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Export the CSV2 audit files in a directory to a database
+//
+//  Parameters:
+//      DirectoryPath   - the directory holding the .csv2 files
+//      FileSwitchValue - the /f= value, an ODBC connection string or the
+//                        path of a SQLite database
+//      valueDictionary - true if a new SQLite database is to store the
+//                        audit data in a value dictionary
+//
+//  Remarks:
+//      A file that cannot be read or exported is logged and skipped. The
+//      files must have been written in command line mode as those carry the
+//      computer and audit master records needed to identify the computer.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditFileIngester::IngestDirectory( const String& DirectoryPath,
+                                         const String& FileSwitchValue, bool valueDictionary )
+{
+    const  DWORD MAX_WORKERS = 16;
+    const  LONG  SLOTS_PER_WORKER = 2;    // So the workers do not wait on each export
+    DWORD  numWorkers = 0, i = 0;
+    size_t numFiles = 0, numExported = 0, j = 0;
+    UINT64 startTick = 0, elapsed = 0;
+    String FileDirectory, FilePath, Insert2, Insert3;
+    Formatter   Format;
+    StringArray FileNames, FilePaths;
+    SYSTEM_INFO SystemInfo;
+    TYPE_INGEST_BATCH Batch;
+    TYPE_INGEST_SLOT  Slots[ MAX_WORKERS * SLOTS_PER_WORKER ];
+    AuditFileIngester Workers[ MAX_WORKERS ];
+
+    if ( DirectoryPath.IsEmpty() )
+    {
+        throw ParameterException( L"DirectoryPath", __FUNCTION__ );
+    }
+
+    if ( ( FileSwitchValue.StartsWith( L"DBQ="   , false ) == false ) &&
+         ( FileSwitchValue.StartsWith( L"DRIVER=", false ) == false ) &&
+         ( SqliteDatabase::IsSqliteFilePath( FileSwitchValue ) == false ) )
+    {
+        PXSLogAppError( L"Audit files can only be ingested into a database." );
+        return;
+    }
+
+    FileDirectory = DirectoryPath;
+    if ( FileDirectory.EndsWithCharacterI( PXS_PATH_SEPARATOR ) == false )
+    {
+        FileDirectory += PXS_PATH_SEPARATOR;
+    }
+    Directory::ListFiles( DirectoryPath, L".csv2", &FileNames );
+    numFiles = FileNames.GetSize();
+    if ( numFiles == 0 )
+    {
+        PXSLogAppWarn1( L"No CSV2 audit files found in '%%1'.", DirectoryPath );
+        return;
+    }
+    for ( j = 0; j < numFiles; j++ )
+    {
+        FilePath  = FileDirectory;
+        FilePath += FileNames.Get( j );
+        FilePaths.Add( FilePath );
+    }
+
+    memset( &SystemInfo, 0, sizeof ( SystemInfo ) );
+    GetSystemInfo( &SystemInfo );
+    numWorkers = PXSMaxUInt32( 1, PXSMinUInt32( SystemInfo.dwNumberOfProcessors, MAX_WORKERS ) );
+    if ( numWorkers > numFiles )
+    {
+        numWorkers = PXSCastSizeTToUInt32( numFiles );
+    }
+
+    memset( &Batch, 0, sizeof ( Batch ) );
+    Batch.pFilePaths = &FilePaths;
+    Batch.pSlots     = Slots;
+    Batch.numSlots   = PXSCastUInt32ToInt32( numWorkers ) * SLOTS_PER_WORKER;
+    Batch.nextIndex  = 0;
+    for ( j = 0; j < ARRAYSIZE( Slots ); j++ )
+    {
+        Slots[ j ].fileNumber = 0;
+        Slots[ j ].parsed     = false;
+    }
+    Batch.hFreeSlots = CreateSemaphore( nullptr, Batch.numSlots, Batch.numSlots, nullptr );
+    if ( Batch.hFreeSlots == nullptr )
+    {
+        throw SystemException( GetLastError(), L"CreateSemaphore", __FUNCTION__ );
+    }
+    AutoCloseHandle CloseFreeSlots( Batch.hFreeSlots );
+
+    Batch.hFileReady = CreateEvent( nullptr, FALSE, FALSE, nullptr );
+    if ( Batch.hFileReady == nullptr )
+    {
+        throw SystemException( GetLastError(), L"CreateEvent", __FUNCTION__ );
+    }
+    AutoCloseHandle CloseFileReady( Batch.hFileReady );
+
+    startTick = GetTickCount64();
+    try
+    {
+        for ( i = 0; i < numWorkers; i++ )
+        {
+            Workers[ i ].m_pBatchMT = &Batch;
+            Workers[ i ].Run( nullptr );
+        }
+        ExportFiles( FileSwitchValue, valueDictionary, &Batch, &numExported );
+    }
+    catch ( const Exception& )
+    {
+        // Leave no file for the workers then let any waiting on a slot exit
+        InterlockedExchange( &Batch.nextIndex, PXSCastSizeTToInt32( numFiles ) );
+        ReleaseSemaphore( Batch.hFreeSlots, PXSCastUInt32ToInt32( numWorkers ), nullptr );
+        for ( i = 0; i < numWorkers; i++ )
+        {
+            Workers[ i ].Join();
+        }
+        throw;
+    }
+
+    // The batch is on the stack so wait for every worker
+    for ( i = 0; i < numWorkers; i++ )
+    {
+        Workers[ i ].Join();
+    }
+    elapsed = GetTickCount64() - startTick;
+    if ( elapsed == 0 )
+    {
+        elapsed = 1;
+    }
+
+    Insert2 = Format.SizeT( numFiles );
+    Insert3 = Format.UInt64( elapsed );
+    PXSLogAppInfo3( L"Ingested %%1 of %%2 audit file(s) in %%3ms.",
+                    Format.SizeT( numExported ), Insert2, Insert3 );
+    PXSLogAppInfo1( L"Ingest rate: %%1 files per second.",
+                    Format.UInt64( ( 1000 * numExported ) / elapsed ) );
+}
+
+//===============================================================================================//
+//  Description:
+//      Append the computer and audit master records to CSV2 text
+//
+//  Parameters:
+//      ComputerMaster - the computer master record
+//      AuditMaster    - the audit master record
+//      pCsvText       - receives the rows at its end
+//
+//  Remarks:
+//      The rows have record number zero so are not mistaken for audit data.
+//      Their item names are left empty, ReadCsv2File identifies the values by
+//      their item identifiers.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditFileIngester::MasterRecordsToCsv2( const AuditRecord& ComputerMaster,
+                                             const AuditRecord& AuditMaster, String* pCsvText )
+{
+    const size_t NUM_MASTERS = 2;
+    const AuditRecord* MASTERS[ NUM_MASTERS ] = { &ComputerMaster, &AuditMaster };
+    LPCWSTR NAMES[ NUM_MASTERS ] = { L"\"Computer_Master\",", L"\"Audit_Master\"," };
+    size_t    i = 0, j = 0, numValues = 0;
+    DWORD     categoryID = 0;
+    String    Value, CsvLine;
+    Formatter Format;
+
+    if ( pCsvText == nullptr )
+    {
+        throw ParameterException( L"pCsvText", __FUNCTION__ );
+    }
+
+    if ( ( ComputerMaster.GetCategoryID() != PXS_CATEGORY_COMPUTER_MASTER ) ||
+         ( AuditMaster.GetCategoryID()    != PXS_CATEGORY_AUDIT_MASTER    )  )
+    {
+        throw ParameterException( L"ComputerMaster/AuditMaster", __FUNCTION__ );
+    }
+
+    CsvLine.Allocate( 256 );
+    for ( i = 0; i < NUM_MASTERS; i++ )
+    {
+        categoryID = MASTERS[ i ]->GetCategoryID();
+        numValues  = MASTERS[ i ]->GetNumberOfValues();
+        for ( j = 0; j < numValues; j++ )
+        {
+            // ItemOrder and RecordNumber
+            CsvLine  = L"0,0,";
+            CsvLine += Format.UInt32( categoryID );
+            CsvLine += PXS_CHAR_COMMA;
+            CsvLine += NAMES[ i ];
+            CsvLine += Format.UInt32( PXSCastSizeTToUInt32( categoryID + j + 1 ) );
+            CsvLine += L",\"\",";
+
+            Value = MASTERS[ i ]->GetValue( j );
+            Value.ReplaceChar( PXS_CHAR_TAB, PXS_CHAR_SPACE );
+            Value.ReplaceChar( PXS_CHAR_QUOTE, L"\"\"" );
+            CsvLine += PXS_CHAR_QUOTE;
+            CsvLine += Value;
+            CsvLine += PXS_CHAR_QUOTE;
+            CsvLine += PXS_STRING_CRLF;
+            *pCsvText += CsvLine;
+        }
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Read a CSV2 file back into audit records
+//
+//  Parameters:
+//      FilePath        - path of the file
+//      pComputerMaster - receives the computer master record
+//      pAuditMaster    - receives the audit master record
+//      pAuditRecords   - receives the audit records
+//
+//  Remarks:
+//      File::ReadAll limits the size of file so limits the memory used
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditFileIngester::ReadCsv2File( const String& FilePath,
+                                      AuditRecord* pComputerMaster,
+                                      AuditRecord* pAuditMaster,
+                                      TArray< AuditRecord >* pAuditRecords )
+{
+    File   CsvFile;
+    String CsvText;
+
+    CsvFile.Open( FilePath, GENERIC_READ, FILE_SHARE_READ, 1, true );
+    CsvFile.ReadAll( &CsvText );
+    CsvFile.Close();
+    ParseCsv2( CsvText, pComputerMaster, pAuditMaster, pAuditRecords );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Protected Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Private Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Export the files as the workers parse them. This method must only be
+//      called by the creator thread.
+//
+//  Parameters:
+//      FileSwitchValue - an ODBC connection string or a SQLite database path
+//      valueDictionary - true if a new SQLite database is to use the value
+//                        dictionary layout
+//      pBatch          - the shared batch, the workers must be running
+//      pNumExported    - receives the number of files exported
+//
+//  Remarks:
+//      The files are taken in order so the slot of the next file is always
+//      known. Each export is its own transaction so a failure only loses the
+//      one file.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditFileIngester::ExportFiles( const String& FileSwitchValue,
+                                     bool valueDictionary,
+                                     TYPE_INGEST_BATCH* pBatch, size_t* pNumExported )
+{
+    bool   useSqlite = false;
+    LONG   fileNumber = 0;
+    size_t i = 0, numFiles = 0;
+    String ResultMessage, Message;
+    AuditDatabase    Database;
+    SqliteDatabase   SqliteDb;
+    OdbcExportDialog OdbcExport;
+    TYPE_INGEST_SLOT* pSlot = nullptr;
+
+    if ( ( pBatch == nullptr ) || ( pNumExported == nullptr ) )
+    {
+        throw ParameterException( L"pBatch/pNumExported", __FUNCTION__ );
+    }
+    *pNumExported = 0;
+
+    // Connect while the workers parse the first files
+    useSqlite = SqliteDatabase::IsSqliteFilePath( FileSwitchValue );
+    if ( useSqlite )
+    {
+        SqliteDb.Open( FileSwitchValue, valueDictionary );
+    }
+    else
+    {
+        Database.Connect( FileSwitchValue,
+                          PXS_DB_CONNECT_TIMEOUT_SECS_DEF,
+                          PXS_DB_QUERY_TIMEOUT_SECS_DEF, nullptr );
+    }
+
+    numFiles = pBatch->pFilePaths->GetSize();
+    for ( i = 0; i < numFiles; i++ )
+    {
+        fileNumber = PXSCastSizeTToInt32( i + 1 );
+        pSlot      = pBatch->pSlots + ( i % PXSCastInt32ToSizeT( pBatch->numSlots ) );
+        while ( pSlot->fileNumber != fileNumber )
+        {
+            if ( WaitForSingleObject( pBatch->hFileReady, INFINITE ) == WAIT_FAILED )
+            {
+                throw SystemException( GetLastError(), L"WaitForSingleObject", __FUNCTION__ );
+            }
+        }
+
+        if ( pSlot->parsed )
+        {
+            try
+            {
+                if ( useSqlite )
+                {
+                    SqliteDb.ExportAudit( pSlot->ComputerMaster,
+                                          pSlot->AuditMaster, pSlot->AuditRecords, &ResultMessage );
+                }
+                else
+                {
+                    OdbcExport.SetAuditRecords( pSlot->AuditMaster,
+                                                pSlot->ComputerMaster, pSlot->AuditRecords );
+                    OdbcExport.ExportRecordsToDatabase( &Database, &ResultMessage );
+                }
+                *pNumExported = *pNumExported + 1;
+            }
+            catch ( const Exception& e )
+            {
+                // The next file uses the same connection
+                if ( useSqlite == false )
+                {
+                    Database.RollbackTrans();
+                }
+                Message  = L"Error exporting audit file '";
+                Message += pBatch->pFilePaths->Get( i );
+                Message += L"'.";
+                PXSLogException( Message.c_str(), e, __FUNCTION__ );
+            }
+        }
+
+        // Empty the slot then hand it back
+        pSlot->AuditRecords.RemoveAll();
+        pSlot->fileNumber = 0;
+        if ( ReleaseSemaphore( pBatch->hFreeSlots, 1, nullptr ) == 0 )
+        {
+            throw SystemException( GetLastError(), L"ReleaseSemaphore", __FUNCTION__ );
+        }
+    }
+
+    if ( useSqlite )
+    {
+        SqliteDb.Close();
+    }
+    else
+    {
+        Database.Disconnect();
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Parse CSV2 text into audit records
+//
+//  Parameters:
+//      CsvText         - the text as written by PXSAuditRecordsToCsv2
+//      pComputerMaster - receives the computer master record
+//      pAuditMaster    - receives the audit master record
+//      pAuditRecords   - receives the audit records
+//
+//  Remarks:
+//      The columns are ItemOrder, RecordNumber, CategoryID, CategoryName,
+//      ItemID, ItemName and ItemValue. The names are ignored so the file can
+//      be in any language. A row that does not start with a number, e.g. the
+//      header, is skipped. The master records have record number zero.
+//
+//      The records array is grown by doubling as TArray::Add copies the whole
+//      array each time.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditFileIngester::ParseCsv2( const String& CsvText,
+                                   AuditRecord* pComputerMaster,
+                                   AuditRecord* pAuditMaster,
+                                   TArray< AuditRecord >* pAuditRecords )
+{
+    const  size_t NUM_COLUMNS = 7;
+    bool   endOfRow = false;
+    size_t column = 0, numRecords = 0, capacity = 0;
+    DWORD  recordNumber = 0, lastRecordNumber = 0, categoryID = 0, itemID = 0;
+    String Fields[ NUM_COLUMNS ], Unused, ErrorMessage;
+    LPCWSTR      pCsv    = nullptr;
+    AuditRecord* pRecord = nullptr;
+
+    if ( ( pComputerMaster == nullptr ) ||
+         ( pAuditMaster    == nullptr ) ||
+         ( pAuditRecords   == nullptr )  )
+    {
+        throw ParameterException( L"nullptr", __FUNCTION__ );
+    }
+    pComputerMaster->Reset( PXS_CATEGORY_UKNOWN );
+    pAuditMaster->Reset( PXS_CATEGORY_UKNOWN );
+    pAuditRecords->RemoveAll();
+
+    for ( column = 0; column < NUM_COLUMNS; column++ )
+    {
+        Fields[ column ].Allocate( 256 );
+    }
+
+    pCsv = CsvText.c_str();
+    while ( pCsv && ( *pCsv != PXS_CHAR_NULL ) )
+    {
+        // Read the row, any columns past the last are ignored
+        column   = 0;
+        endOfRow = false;
+        while ( endOfRow == false )
+        {
+            if ( column < NUM_COLUMNS )
+            {
+                endOfRow = ReadCsvField( &pCsv, Fields + column );
+            }
+            else
+            {
+                endOfRow = ReadCsvField( &pCsv, &Unused );
+            }
+            column++;
+        }
+
+        if ( ( column < NUM_COLUMNS ) ||
+             ( Fields[ 0 ].IsOnlyDigits() == false ) ||
+             ( Fields[ 1 ].IsOnlyDigits() == false ) ||
+             ( Fields[ 2 ].IsOnlyDigits() == false ) ||
+             ( Fields[ 4 ].IsOnlyDigits() == false )  )
+        {
+            continue;       // Header or blank line
+        }
+        recordNumber = Formatter::StringToUInt32( Fields[ 1 ] );
+        categoryID   = Formatter::StringToUInt32( Fields[ 2 ] );
+        itemID       = Formatter::StringToUInt32( Fields[ 4 ] );
+
+        if ( recordNumber == 0 )
+        {
+            if ( categoryID == PXS_CATEGORY_COMPUTER_MASTER )
+            {
+                pRecord = pComputerMaster;
+            }
+            else if ( categoryID == PXS_CATEGORY_AUDIT_MASTER )
+            {
+                pRecord = pAuditMaster;
+            }
+            else
+            {
+                ErrorMessage  = L"Record number zero for category ";
+                ErrorMessage += Fields[ 2 ];
+                throw SystemException( ERROR_INVALID_DATA, ErrorMessage.c_str(), __FUNCTION__ );
+            }
+
+            if ( pRecord->GetCategoryID() != categoryID )
+            {
+                pRecord->Reset( categoryID );
+            }
+        }
+        else if ( recordNumber != lastRecordNumber )
+        {
+            numRecords++;
+            if ( numRecords > capacity )
+            {
+                capacity = PXSMaxSizeT( 64, PXSMultiplySizeT( capacity, 2 ) );
+                pAuditRecords->SetSize( capacity );
+            }
+            pRecord = pAuditRecords->GetPtr( numRecords - 1 );
+            pRecord->Reset( categoryID );
+            lastRecordNumber = recordNumber;
+        }
+        pRecord->Add( itemID, Fields[ 6 ] );
+    }
+    pAuditRecords->SetSize( numRecords );
+
+    if ( ( pComputerMaster->GetCategoryID() != PXS_CATEGORY_COMPUTER_MASTER ) ||
+         ( pAuditMaster->GetCategoryID()    != PXS_CATEGORY_AUDIT_MASTER    )  )
+    {
+        throw SystemException( ERROR_INVALID_DATA, L"No master records", __FUNCTION__ );
+    }
+
+    if ( numRecords == 0 )
+    {
+        throw SystemException( ERROR_INVALID_DATA, L"No audit records", __FUNCTION__ );
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Read a field from CSV text
+//
+//  Parameters:
+//      ppCsv  - pointer to the position in the text, on output is at the
+//               start of the next field or row
+//      pField - receives the field, quotes removed and "" unescaped
+//
+//  Remarks:
+//      A quoted field can contain commas and line breaks
+//
+//  Returns:
+//      true if the field is the last in its row, otherwise false
+//===============================================================================================//
+bool AuditFileIngester::ReadCsvField( LPCWSTR* ppCsv, String* pField )
+{
+    LPCWSTR pCsv   = nullptr;
+    LPCWSTR pStart = nullptr;
+
+    if ( ( ppCsv == nullptr ) || ( *ppCsv == nullptr ) || ( pField == nullptr ) )
+    {
+        throw ParameterException( L"ppCsv/pField", __FUNCTION__ );
+    }
+    *pField = PXS_STRING_EMPTY;
+    pCsv    = *ppCsv;
+
+    if ( *pCsv == PXS_CHAR_QUOTE )
+    {
+        // Copy runs of characters between the quotes
+        pCsv++;
+        pStart = pCsv;
+        while ( *pCsv != PXS_CHAR_NULL )
+        {
+            if ( *pCsv == PXS_CHAR_QUOTE )
+            {
+                pField->AppendChars( pStart, PXSCastPtrDiffToSizeT( pCsv - pStart ) );
+                pCsv++;
+                if ( *pCsv != PXS_CHAR_QUOTE )
+                {
+                    break;  // Closing quote
+                }
+                pStart = pCsv;  // Escaped quote, keep the second one
+            }
+            pCsv++;
+        }
+    }
+    else
+    {
+        pStart = pCsv;
+        while ( ( *pCsv != PXS_CHAR_NULL  ) &&
+                ( *pCsv != PXS_CHAR_COMMA ) && ( *pCsv != '\r' ) && ( *pCsv != '\n' ) )
+        {
+            pCsv++;
+        }
+        pField->AppendChars( pStart, PXSCastPtrDiffToSizeT( pCsv - pStart ) );
+    }
+
+    // Step over the separator
+    if ( *pCsv == PXS_CHAR_COMMA )
+    {
+        *ppCsv = pCsv + 1;
+        return false;
+    }
+
+    if ( *pCsv == '\r' )
+    {
+        pCsv++;
+    }
+    if ( *pCsv == '\n' )
+    {
+        pCsv++;
+    }
+    *ppCsv = pCsv;
+
+    return true;
+}
+
+//===============================================================================================//
+//  Description:
+//      Run the worker thread. This method must only be called by the worker.
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      Takes files until none are left or told to stop. Waiting on the
+//      semaphore before taking a file means file N is only taken once file
+//      N minus the number of slots has been exported, so its slot is free.
+//      A file that fails is logged and its slot handed over unparsed.
+//
+//  Returns:
+//      DWORD system error code
+//===============================================================================================//
+DWORD AuditFileIngester::RunWorkerThread()
+{
+    LONG   index = 0;
+    size_t numFiles = 0;
+    String Message;
+    TYPE_INGEST_SLOT* pSlot = nullptr;
+
+    if ( m_pBatchMT == nullptr )
+    {
+        return ERROR_INVALID_FUNCTION;
+    }
+    numFiles = m_pBatchMT->pFilePaths->GetSize();
+
+    while ( m_bRunMT )
+    {
+        if ( WaitForSingleObject( m_pBatchMT->hFreeSlots, INFINITE ) == WAIT_FAILED )
+        {
+            return GetLastError();
+        }
+
+        index = InterlockedIncrement( &m_pBatchMT->nextIndex ) - 1;
+        if ( static_cast<size_t>( index ) >= numFiles )
+        {
+            // Pass the count on so the other workers also see the end
+            ReleaseSemaphore( m_pBatchMT->hFreeSlots, 1, nullptr );
+            break;
+        }
+
+        pSlot = m_pBatchMT->pSlots + ( index % m_pBatchMT->numSlots );
+        pSlot->parsed = false;
+        try
+        {
+            ReadCsv2File( m_pBatchMT->pFilePaths->Get( static_cast<size_t>( index ) ),
+                          &pSlot->ComputerMaster, &pSlot->AuditMaster, &pSlot->AuditRecords );
+            pSlot->parsed = true;
+        }
+        catch ( const Exception& e )
+        {
+            Message  = L"Error reading audit file '";
+            Message += m_pBatchMT->pFilePaths->Get( static_cast<size_t>( index ) );
+            Message += L"'.";
+            PXSLogException( Message.c_str(), e, __FUNCTION__ );
+        }
+
+        // Interlocked so the slot's contents are visible before its number
+        InterlockedExchange( &pSlot->fileNumber, index + 1 );
+        SetEvent( m_pBatchMT->hFileReady );
+    }
+
+    return ERROR_SUCCESS;
+}
@@ -222,12 +222,14 @@ size_t AuditRecord::GetNumberOfValues() const
 //
 //  Parameters:
 //      itemID - the audit item's identifier
-//      pValue - receives the value
+//
+//  Remarks:
+//      As for GetValue the pointer is into this record's storage
 //
 //  Returns:
-//      void
+//      Pointer to the value, never NULL
 //===============================================================================================//
-void AuditRecord::GetItemValue( DWORD itemID, String* pValue ) const
+LPCWSTR AuditRecord::GetItemValue( DWORD itemID ) const
 {
     String    ErrorMessage, RecordString;
     Formatter Format;
@@ -261,11 +263,69 @@ void AuditRecord::GetItemValue( DWORD itemID, String* pValue ) const
         throw BoundsException( ErrorMessage.c_str(), __FUNCTION__ );
     }
 
+    return GetValue( index );
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the value of the specified audit item
+//
+//  Parameters:
+//      itemID - the audit item's identifier
+//      pValue - receives the value
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditRecord::GetItemValue( DWORD itemID, String* pValue ) const
+{
     if ( pValue == nullptr )
     {
         throw ParameterException( L"pValue", __FUNCTION__ );
     }
-    *pValue = m_Values.Get( index );
+    *pValue = GetItemValue( itemID );
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the value at the specified index
+//
+//  Parameters:
+//      index - zero based index of the value
+//
+//  Remarks:
+//      The pointer is into this record's storage, so it is only valid until
+//      the record is modified or destroyed. Use this rather than
+//      GetCategoryIdAndValues when only need to read the values.
+//
+//  Returns:
+//      Pointer to the value, never NULL
+//===============================================================================================//
+LPCWSTR AuditRecord::GetValue( size_t index ) const
+{
+    LPCWSTR pszValue = m_Values.Get( index );
+
+    if ( pszValue == nullptr )
+    {
+        return PXS_STRING_EMPTY;
+    }
+
+    return pszValue;
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the length of the value at the specified index
+//
+//  Parameters:
+//      index - zero based index of the value
+//
+//  Returns:
+//      Length in characters
+//===============================================================================================//
+size_t AuditRecord::GetValueLength( size_t index ) const
+{
+    return wcslen( GetValue( index ) );
 }
 
 //===============================================================================================//
@@ -284,6 +344,27 @@ void AuditRecord::Reset( DWORD categoryID )
     m_Values.RemoveAll();
 }
 
+//===============================================================================================//
+//  Description:
+//      Exchange the contents of this record with another
+//
+//  Parameters:
+//      Other - the record to swap with
+//
+//  Remarks:
+//      Used when sorting, no values are copied
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void AuditRecord::Swap( AuditRecord& Other )
+{
+    DWORD categoryID    = m_uCategoryID;
+    m_uCategoryID       = Other.m_uCategoryID;
+    Other.m_uCategoryID = categoryID;
+    m_Values.Swap( Other.m_Values );
+}
+
 //===============================================================================================//
 //  Description:
 //      Convert this record object to a string
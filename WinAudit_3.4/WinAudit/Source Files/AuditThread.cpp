@@ -195,6 +195,7 @@ DWORD AuditThread::DoAuditLocked( AuditThreadParameter* pParameter ) const
             }
             i++;
         }
+        Auditor.LogCacheStatistics();
     }
     catch ( const Exception& e )
     {
@@ -0,0 +1,1155 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Category Snapshot Cache Class Implementation
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// A snapshot is a Unicode text file with two header lines, the fingerprint
+// and the time it was saved, followed by one line per record. A record line
+// is the category identifier then each value preceded by a tab. Tabs, new
+// lines and back slashes in values are escaped as \t, \r, \n and \\.
+//
+// The default directory is shared by all users so it is created with a
+// protected DACL. A user who made it first, or a file in it, before WinAudit
+// was run by an administrator would own it so the owner is checked too.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Header Files/CategorySnapshotCache.h"
+
+// 2. C System Files
+#include <AclAPI.h>
+#include <sddl.h>
+#include <winspool.h>
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/AllocateBytes.h"
+#include "PxsBase/Header Files/AutoCloseHandle.h"
+#include "PxsBase/Header Files/Directory.h"
+#include "PxsBase/Header Files/Exception.h"
+#include "PxsBase/Header Files/File.h"
+#include "PxsBase/Header Files/Formatter.h"
+#include "PxsBase/Header Files/ParameterException.h"
+#include "PxsBase/Header Files/Registry.h"
+#include "PxsBase/Header Files/StringArray.h"
+#include "PxsBase/Header Files/SystemException.h"
+#include "PxsBase/Header Files/TArray.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/AuditRecord.h"
+#include "WinAudit/Header Files/Resources.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Default constructor
+CategorySnapshotCache::CategorySnapshotCache()
+                      :m_uPendingCategoryID( PXS_CATEGORY_UKNOWN ),
+                       m_uPendingExceptions( 0 ),
+                       m_uNumHits( 0 ),
+                       m_uNumMisses( 0 ),
+                       m_PendingFingerprint(),
+                       m_DirectoryPath()
+{
+}
+
+// Copy constructor - not allowed so no implementation
+
+// Destructor
+CategorySnapshotCache::~CategorySnapshotCache()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Operators
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Assignment operator - not allowed so no implementation
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Public Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Get the records of a category from its snapshot if the category's
+//      sources have not changed since the snapshot was saved
+//
+//  Parameters:
+//      categoryID - defined category number
+//      pRecords   - receives the records
+//
+//  Remarks:
+//      The fingerprint made here is kept so that SaveRecords can store it
+//      with the freshly collected records on a miss. A snapshot whose owner
+//      is not trusted is ignored. Errors are logged and treated as a miss so
+//      the category is collected in the usual way.
+//
+//  Returns:
+//      true if the records came from the snapshot, otherwise false
+//===============================================================================================//
+bool CategorySnapshotCache::GetRecords( DWORD categoryID, TArray< AuditRecord >* pRecords )
+{
+    const UINT64 MAX_SNAPSHOT_AGE = 864000000000;   // 24 hours in 100ns units
+    bool        success  = false;
+    size_t      i = 0, numLines = 0;
+    UINT64      savedTime = 0, timeNow = 0;
+    String      Fingerprint, FilePath, Contents, Line, Expected, SavedTime;
+    File        SnapshotFile;
+    Formatter   Format;
+    FILETIME    ftNow;
+    StringArray Lines;
+    AuditRecord Record;
+
+    if ( pRecords == nullptr )
+    {
+        throw ParameterException( L"pRecords", __FUNCTION__ );
+    }
+    pRecords->RemoveAll();
+    m_uPendingCategoryID = PXS_CATEGORY_UKNOWN;
+    m_PendingFingerprint = PXS_STRING_EMPTY;
+
+    if ( IsCacheableCategory( categoryID ) == false )
+    {
+        return false;
+    }
+
+    try
+    {
+        GetFingerprint( categoryID, &Fingerprint );
+        m_uPendingCategoryID = categoryID;
+        m_PendingFingerprint = Fingerprint;
+
+        GetSnapshotFilePath( categoryID, false, &FilePath );
+        if ( SnapshotFile.Exists( FilePath ) && ( IsTrustedOwner( FilePath ) == false ) )
+        {
+            PXSLogAppWarn1( L"Ignored snapshot '%%1' as its owner is not trusted.", FilePath );
+        }
+        else if ( SnapshotFile.Exists( FilePath ) )
+        {
+            SnapshotFile.Open( FilePath, GENERIC_READ, FILE_SHARE_READ, 1, true );
+            SnapshotFile.ReadAll( &Contents );
+            SnapshotFile.Close();
+            Contents.ToArray( PXS_STRING_CRLF, &Lines );
+            numLines = Lines.GetSize();
+
+            // Two header lines, at least one record and the empty string
+            // after the last CRLF
+            Expected  = L"Fingerprint=";
+            Expected += Fingerprint;
+            if ( numLines > 3 )
+            {
+                Line = Lines.Get( 0 );
+            }
+            if ( Line.Compare( Expected, true ) == 0 )
+            {
+                Line = Lines.Get( 1 );
+                if ( Line.StartsWith( L"Saved=", true ) )
+                {
+                    Line.SubString( 6, Line.GetLength() - 6, &SavedTime );
+                    savedTime = Format.StringToUInt64( SavedTime );
+                }
+                GetSystemTimeAsFileTime( &ftNow );
+                timeNow = ( static_cast<UINT64>( ftNow.dwHighDateTime ) << 32 ) |
+                            ftNow.dwLowDateTime;
+                if ( ( savedTime <= timeNow ) && ( ( timeNow - savedTime ) < MAX_SNAPSHOT_AGE ) )
+                {
+                    success = true;
+                    for ( i = 2; success && ( i < ( numLines - 1 ) ); i++ )
+                    {
+                        Line    = Lines.Get( i );
+                        success = ParseRecordLine( categoryID, Line, &Record );
+                        if ( success )
+                        {
+                            pRecords->Add( Record );
+                        }
+                    }
+                }
+            }
+        }
+    }
+    catch ( const Exception& e )
+    {
+        PXSLogException( L"Error reading a category snapshot.", e, __FUNCTION__ );
+        success = false;
+    }
+
+    if ( success )
+    {
+        m_uNumHits++;
+        m_uPendingCategoryID = PXS_CATEGORY_UKNOWN;
+        m_PendingFingerprint = PXS_STRING_EMPTY;
+    }
+    else
+    {
+        m_uNumMisses++;
+        m_uPendingExceptions = PXSGetNumberOfLoggedExceptions();
+        pRecords->RemoveAll();
+    }
+
+    return success;
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the snapshot cache statistics
+//
+//  Parameters:
+//      pNumHits   - receives the number of categories taken from a snapshot
+//      pNumMisses - receives the number of categories that were collected
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CategorySnapshotCache::GetStatistics( size_t* pNumHits, size_t* pNumMisses ) const
+{
+    if ( ( pNumHits == nullptr ) || ( pNumMisses == nullptr ) )
+    {
+        throw ParameterException( L"pNumHits/pNumMisses", __FUNCTION__ );
+    }
+    *pNumHits   = m_uNumHits;
+    *pNumMisses = m_uNumMisses;
+}
+
+//===============================================================================================//
+//  Description:
+//      Determine if the records of a category can be kept in a snapshot
+//
+//  Parameters:
+//      categoryID - defined category number
+//
+//  Remarks:
+//      These are the categories that are slow to collect and have a cheap
+//      signal for change. SMBIOS categories are not included as they are
+//      decoded from a table already held in memory.
+//
+//  Returns:
+//      true if cacheable, otherwise false
+//===============================================================================================//
+bool CategorySnapshotCache::IsCacheableCategory( DWORD categoryID )
+{
+    if ( ( categoryID == PXS_CATEGORY_INSTALLED_PROGS  ) ||
+         ( categoryID == PXS_CATEGORY_SOFTWARE_UPDATES ) ||
+         ( categoryID == PXS_CATEGORY_NTSERVICES       ) ||
+         ( categoryID == PXS_CATEGORY_PRINTERS         )  )
+    {
+        return true;
+    }
+
+    return false;
+}
+
+//===============================================================================================//
+//  Description:
+//      Write the cache statistics to the log
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CategorySnapshotCache::LogStatistics() const
+{
+    size_t    numHits = 0, numMisses = 0;
+    String    Hits, Misses, HitRate;
+    Formatter Format;
+
+    GetStatistics( &numHits, &numMisses );
+    if ( ( numHits == 0 ) && ( numMisses == 0 ) )
+    {
+        return;     // Not used
+    }
+    Hits    = Format.SizeT( numHits );
+    Misses  = Format.SizeT( numMisses );
+    HitRate = Format.SizeT( ( 100 * numHits ) / ( numHits + numMisses ) );
+    PXSLogAppInfo3( L"Category snapshot hits = %%1, misses = %%2, hit rate = %%3 percent.",
+                    Hits, Misses, HitRate );
+}
+
+//===============================================================================================//
+//  Description:
+//      Make the fingerprint of the sources a category's records come from
+//
+//  Parameters:
+//      categoryID   - defined category number, must be cacheable
+//      pFingerprint - receives the fingerprint
+//
+//  Remarks:
+//      The fingerprint is a 64-bit FNV-1a hash of the change signals and
+//      the number of items hashed. It includes the last write time of this
+//      program and a resource string so that another version or language
+//      does not use the snapshot.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CategorySnapshotCache::MakeFingerprint( DWORD categoryID, String* pFingerprint )
+{
+    size_t    i = 0, numItems = 0;
+    UINT64    hash = 14695981039346656037ULL;
+    String    ExePath, ResourceString, NumItems;
+    Formatter Format;
+    FILETIME  ftCreation, ftLastAccess, ftLastWrite;
+    LPCWSTR   UNINSTALL_KEY = L"Software\\Microsoft\\Windows\\CurrentVersion\\UnInstall";
+    LPCWSTR   ARP_CACHE_KEY = L"Software\\Microsoft\\Windows\\CurrentVersion"
+                              L"\\App Management\\ARPCache";
+
+    struct _SOURCES
+    {
+        DWORD   categoryID;
+        HKEY    hKey;
+        DWORD   samDesired;
+        LPCWSTR pszSubKey;
+    } Sources[] =
+        { { PXS_CATEGORY_INSTALLED_PROGS , HKEY_LOCAL_MACHINE,
+            KEY_READ | KEY_WOW64_64KEY, UNINSTALL_KEY },
+          { PXS_CATEGORY_INSTALLED_PROGS , HKEY_LOCAL_MACHINE,
+            KEY_READ | KEY_WOW64_32KEY, UNINSTALL_KEY },
+          { PXS_CATEGORY_INSTALLED_PROGS , HKEY_CURRENT_USER,
+            KEY_READ | KEY_WOW64_64KEY, UNINSTALL_KEY },
+          { PXS_CATEGORY_INSTALLED_PROGS , HKEY_CURRENT_USER,
+            KEY_READ | KEY_WOW64_32KEY, UNINSTALL_KEY },
+          { PXS_CATEGORY_INSTALLED_PROGS , HKEY_LOCAL_MACHINE,
+            KEY_READ | KEY_WOW64_64KEY, L"SOFTWARE\\Classes\\Installer\\Products" },
+          { PXS_CATEGORY_INSTALLED_PROGS , HKEY_LOCAL_MACHINE,
+            KEY_READ | KEY_WOW64_64KEY, ARP_CACHE_KEY },
+          { PXS_CATEGORY_INSTALLED_PROGS , HKEY_CURRENT_USER,
+            KEY_READ | KEY_WOW64_64KEY, ARP_CACHE_KEY },
+          { PXS_CATEGORY_INSTALLED_PROGS , HKEY_LOCAL_MACHINE,
+            KEY_READ | KEY_WOW64_64KEY, L"SOFTWARE\\Microsoft\\Office\\15.0\\ClickToRun" },
+          { PXS_CATEGORY_INSTALLED_PROGS , HKEY_LOCAL_MACHINE,
+            KEY_READ | KEY_WOW64_64KEY,
+            L"SOFTWARE\\Microsoft\\Office\\15.0\\Common\\InstalledPackages" },
+          { PXS_CATEGORY_SOFTWARE_UPDATES, HKEY_LOCAL_MACHINE,
+            KEY_READ | KEY_WOW64_64KEY, UNINSTALL_KEY },
+          { PXS_CATEGORY_SOFTWARE_UPDATES, HKEY_LOCAL_MACHINE,
+            KEY_READ | KEY_WOW64_32KEY, UNINSTALL_KEY },
+          { PXS_CATEGORY_SOFTWARE_UPDATES, HKEY_LOCAL_MACHINE,
+            KEY_READ | KEY_WOW64_64KEY, L"SOFTWARE\\Classes\\Installer\\Patches" },
+          { PXS_CATEGORY_SOFTWARE_UPDATES, HKEY_LOCAL_MACHINE,
+            KEY_READ | KEY_WOW64_64KEY,
+            L"SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Component Based Servicing\\Packages" },
+          { PXS_CATEGORY_SOFTWARE_UPDATES, HKEY_LOCAL_MACHINE,
+            KEY_READ | KEY_WOW64_64KEY,
+            L"SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\WindowsUpdate\\Auto Update\\Results" },
+          { PXS_CATEGORY_SOFTWARE_UPDATES, HKEY_LOCAL_MACHINE,
+            KEY_READ | KEY_WOW64_32KEY, L"SOFTWARE\\Microsoft\\Updates" },
+          { PXS_CATEGORY_NTSERVICES      , HKEY_LOCAL_MACHINE,
+            KEY_READ | KEY_WOW64_64KEY, L"SYSTEM\\CurrentControlSet\\Services" },
+          { PXS_CATEGORY_PRINTERS        , HKEY_LOCAL_MACHINE,
+            KEY_READ | KEY_WOW64_64KEY, L"SYSTEM\\CurrentControlSet\\Control\\Print\\Printers" } };
+
+    if ( pFingerprint == nullptr )
+    {
+        throw ParameterException( L"pFingerprint", __FUNCTION__ );
+    }
+    *pFingerprint = PXS_STRING_EMPTY;
+
+    if ( IsCacheableCategory( categoryID ) == false )
+    {
+        throw ParameterException( L"categoryID", __FUNCTION__ );
+    }
+
+    // Version and language
+    PXSGetExePath( &ExePath );
+    File::GetTimes( ExePath, &ftCreation, &ftLastAccess, &ftLastWrite );
+    HashUInt64( ( static_cast<UINT64>( ftLastWrite.dwHighDateTime ) << 32 ) |
+                  ftLastWrite.dwLowDateTime, &hash );
+    PXSGetResourceString( PXS_IDS_1261_YES, &ResourceString );
+    HashString( ResourceString.c_str(), &hash );
+    HashUInt64( categoryID, &hash );
+
+    // Registry keys, the spooler updates a printer's key, e.g. its ChangeID
+    // value, when the printer is changed
+    for ( i = 0; i < ARRAYSIZE( Sources ); i++ )
+    {
+        if ( categoryID == Sources[ i ].categoryID )
+        {
+            HashRegistryKey( Sources[ i ].hKey,
+                             Sources[ i ].samDesired, Sources[ i ].pszSubKey, &hash, &numItems );
+        }
+    }
+
+    // Run time states that are shown in the records
+    if ( categoryID == PXS_CATEGORY_NTSERVICES )
+    {
+        HashServices( &hash, &numItems );
+    }
+    else if ( categoryID == PXS_CATEGORY_PRINTERS )
+    {
+        HashPrinters( &hash, &numItems );
+    }
+
+    NumItems       = Format.SizeT( numItems );
+    *pFingerprint  = Format.UInt64Hex( hash, false );
+    *pFingerprint += L"-";
+    *pFingerprint += NumItems;
+}
+
+//===============================================================================================//
+//  Description:
+//      Forget the fingerprint of a category that was looked up but not saved
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      The snapshot files and statistics are kept
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CategorySnapshotCache::Reset()
+{
+    m_uPendingCategoryID = PXS_CATEGORY_UKNOWN;
+    m_PendingFingerprint = PXS_STRING_EMPTY;
+}
+
+//===============================================================================================//
+//  Description:
+//      Save the records of a category as its snapshot
+//
+//  Parameters:
+//      categoryID - defined category number
+//      Records    - the records that were collected
+//
+//  Remarks:
+//      Only saves if GetRecords made a fingerprint for the category and
+//      did not find a usable snapshot. Collectors log and carry on after
+//      most errors so if an exception was logged since GetRecords the
+//      records may be incomplete and are not saved. The file is written under
+//      another name then moved into place so a concurrent audit does not read
+//      a partial snapshot. Errors are logged.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CategorySnapshotCache::SaveRecords( DWORD categoryID, const TArray< AuditRecord >& Records )
+{
+    size_t    i = 0, numRecords = 0;
+    UINT64    timeNow = 0;
+    File      SnapshotFile;
+    String    FilePath, TempPath, Contents, Line;
+    Formatter Format;
+    FILETIME  ftNow;
+
+    if ( ( categoryID != m_uPendingCategoryID ) || m_PendingFingerprint.IsEmpty() )
+    {
+        return;
+    }
+    m_uPendingCategoryID = PXS_CATEGORY_UKNOWN;
+
+    if ( PXSGetNumberOfLoggedExceptions() != m_uPendingExceptions )
+    {
+        PXSLogAppInfo1( L"Did not save the snapshot of category %%1 as errors were logged.",
+                        Format.UInt32( categoryID ) );
+        m_PendingFingerprint = PXS_STRING_EMPTY;
+        return;
+    }
+
+    try
+    {
+        GetSystemTimeAsFileTime( &ftNow );
+        timeNow = ( static_cast<UINT64>( ftNow.dwHighDateTime ) << 32 ) | ftNow.dwLowDateTime;
+
+        Contents  = L"Fingerprint=";
+        Contents += m_PendingFingerprint;
+        Contents += PXS_STRING_CRLF;
+        Contents += L"Saved=";
+        Contents += Format.UInt64( timeNow );
+        Contents += PXS_STRING_CRLF;
+        numRecords = Records.GetSize();
+        for ( i = 0; i < numRecords; i++ )
+        {
+            WriteRecordLine( Records.Get( i ), &Line );
+            Contents += Line;
+        }
+
+        GetSnapshotFilePath( categoryID, true, &FilePath );
+        TempPath  = FilePath;
+        TempPath += L".tmp";
+        SnapshotFile.CreateNew( TempPath, 0, true );
+        SnapshotFile.WriteChars( Contents );
+        SnapshotFile.Close();
+        if ( MoveFileEx( TempPath.c_str(), FilePath.c_str(), MOVEFILE_REPLACE_EXISTING ) == 0 )
+        {
+            throw SystemException( GetLastError(), FilePath.c_str(), "MoveFileEx" );
+        }
+    }
+    catch ( const Exception& e )
+    {
+        PXSLogException( L"Error saving a category snapshot.", e, __FUNCTION__ );
+    }
+    m_PendingFingerprint = PXS_STRING_EMPTY;
+}
+
+//===============================================================================================//
+//  Description:
+//      Set the directory to keep the snapshots in
+//
+//  Parameters:
+//      DirectoryPath - the directory, empty for the default
+//
+//  Remarks:
+//      The directory is created as for the default one. Used to keep the
+//      snapshots of a test apart from those of the audits.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CategorySnapshotCache::SetDirectoryPath( const String& DirectoryPath )
+{
+    m_DirectoryPath = DirectoryPath;
+    m_DirectoryPath.Trim();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Protected Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Make the fingerprint of the sources a category's records come from
+//
+//  Parameters:
+//      categoryID   - defined category number, must be cacheable
+//      pFingerprint - receives the fingerprint
+//
+//  Remarks:
+//      Virtual so a test can say when the sources have changed
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CategorySnapshotCache::GetFingerprint( DWORD categoryID, String* pFingerprint )
+{
+    MakeFingerprint( categoryID, pFingerprint );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Private Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Create the directory to keep the snapshots in
+//
+//  Parameters:
+//      DirectoryPath - the directory
+//
+//  Remarks:
+//      The DACL is protected so nothing is inherited from the parent. Only
+//      SYSTEM, Administrators and the owner, i.e. whoever creates it, have
+//      access. If the directory exists it is left as it is.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CategorySnapshotCache::CreateSnapshotDirectory( const String& DirectoryPath )
+{
+    DWORD   lastError = ERROR_SUCCESS;
+    LPCWSTR SNAPSHOT_DIRECTORY_SDDL = L"D:P(A;OICI;FA;;;SY)(A;OICI;FA;;;BA)(A;OICI;FA;;;OW)";
+    SECURITY_ATTRIBUTES  SecurityAttributes;
+    PSECURITY_DESCRIPTOR pSecurityDescriptor = nullptr;
+
+    if ( DirectoryPath.IsEmpty() )
+    {
+        throw ParameterException( L"DirectoryPath", __FUNCTION__ );
+    }
+
+    if ( ConvertStringSecurityDescriptorToSecurityDescriptor( SNAPSHOT_DIRECTORY_SDDL,
+                                                              SDDL_REVISION_1,
+                                                              &pSecurityDescriptor,
+                                                              nullptr ) == 0 )
+    {
+        throw SystemException( GetLastError(),
+                               L"ConvertStringSecurityDescriptorToSecurityDescriptor",
+                               __FUNCTION__ );
+    }
+
+    memset( &SecurityAttributes, 0, sizeof ( SecurityAttributes ) );
+    SecurityAttributes.nLength              = sizeof ( SecurityAttributes );
+    SecurityAttributes.lpSecurityDescriptor = pSecurityDescriptor;
+    SecurityAttributes.bInheritHandle       = FALSE;
+    if ( CreateDirectory( DirectoryPath.c_str(), &SecurityAttributes ) == 0 )
+    {
+        lastError = GetLastError();
+    }
+    LocalFree( pSecurityDescriptor );
+
+    if ( ( lastError != ERROR_SUCCESS ) && ( lastError != ERROR_ALREADY_EXISTS ) )
+    {
+        throw SystemException( lastError, DirectoryPath.c_str(), "CreateDirectory" );
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the path of a category's snapshot file
+//
+//  Parameters:
+//      categoryID - defined category number
+//      create     - true to create the snapshot directory if it does not
+//                   exist and check it can be written to safely
+//      pFilePath  - receives the path
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CategorySnapshotCache::GetSnapshotFilePath( DWORD categoryID,
+                                                 bool create, String* pFilePath ) const
+{
+    Formatter Format;
+    Directory DirectoryObj;
+
+    if ( pFilePath == nullptr )
+    {
+        throw ParameterException( L"pFilePath", __FUNCTION__ );
+    }
+    *pFilePath = PXS_STRING_EMPTY;
+
+    if ( m_DirectoryPath.GetLength() )
+    {
+        *pFilePath = m_DirectoryPath;
+    }
+    else
+    {
+        DirectoryObj.GetSpecialDirectory( CSIDL_COMMON_APPDATA, pFilePath );
+        if ( pFilePath->EndsWithCharacterI( PXS_PATH_SEPARATOR ) == false )
+        {
+            *pFilePath += PXS_PATH_SEPARATOR;
+        }
+
+        *pFilePath += L"Parmavex";
+        if ( create && ( DirectoryObj.Exists( *pFilePath ) == false ) )
+        {
+            DirectoryObj.CreateNew( *pFilePath );
+        }
+
+        *pFilePath += L"\\WinAudit";
+        if ( create && ( DirectoryObj.Exists( *pFilePath ) == false ) )
+        {
+            DirectoryObj.CreateNew( *pFilePath );
+        }
+        *pFilePath += L"\\Snapshots";
+    }
+
+    if ( create )
+    {
+        if ( DirectoryObj.Exists( *pFilePath ) == false )
+        {
+            CreateSnapshotDirectory( *pFilePath );
+        }
+
+        if ( IsTrustedOwner( *pFilePath ) == false )
+        {
+            throw SystemException( ERROR_ACCESS_DENIED, pFilePath->c_str(), __FUNCTION__ );
+        }
+    }
+
+    if ( pFilePath->EndsWithCharacterI( PXS_PATH_SEPARATOR ) == false )
+    {
+        *pFilePath += PXS_PATH_SEPARATOR;
+    }
+    *pFilePath += Format.StringUInt32( L"Category_%%1.txt", categoryID );
+}
+
+//===============================================================================================//
+//  Description:
+//      Add the local printers and their states to a hash
+//
+//  Parameters:
+//      pHash     - the hash to update
+//      pNumItems - incremented by the number of printers
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CategorySnapshotCache::HashPrinters( UINT64* pHash, size_t* pNumItems )
+{
+    DWORD cbNeeded = 0, cbBuf = 0, Returned = 0, lastError = 0;
+    AllocateBytes   AllocBytes;
+    PRINTER_INFO_2* pPrinterEnum = nullptr;
+
+    if ( ( pHash == nullptr ) || ( pNumItems == nullptr ) )
+    {
+        throw ParameterException( L"pHash/pNumItems", __FUNCTION__ );
+    }
+
+    // First call to determine the amount of memory required
+    if ( EnumPrinters( PRINTER_ENUM_LOCAL, nullptr, 2, nullptr, 0, &cbNeeded, &Returned ) )
+    {
+        return;     // No printers
+    }
+
+    lastError = GetLastError();
+    if ( lastError != ERROR_INSUFFICIENT_BUFFER )
+    {
+        throw SystemException( lastError, L"EnumPrinters failed on first call.", __FUNCTION__ );
+    }
+
+    // Second call, allocate extra bytes
+    cbNeeded     = PXSMultiplyUInt32( cbNeeded, 2 );
+    pPrinterEnum = reinterpret_cast<PRINTER_INFO_2*>( AllocBytes.New(cbNeeded));
+    cbBuf        = cbNeeded;
+    cbNeeded     = 0;
+    Returned     = 0;
+    if ( EnumPrinters( PRINTER_ENUM_LOCAL,
+                       nullptr,
+                       2, (LPBYTE)pPrinterEnum, cbBuf, &cbNeeded, &Returned ) == 0 )
+    {
+        throw SystemException( GetLastError(),
+                               L"EnumPrinters failed on second call.", __FUNCTION__ );
+    }
+
+    for ( DWORD i = 0; i < Returned; i++ )
+    {
+        HashString( pPrinterEnum[ i ].pPrinterName, pHash );
+        HashString( pPrinterEnum[ i ].pDriverName , pHash );
+        HashString( pPrinterEnum[ i ].pPortName   , pHash );
+        HashUInt64( pPrinterEnum[ i ].Status      , pHash );
+        HashUInt64( pPrinterEnum[ i ].Attributes  , pHash );
+        *pNumItems += 1;
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Add the subkeys of a registry key and their last write times to a hash
+//
+//  Parameters:
+//      hKey       - handle to the registry hive
+//      samDesired - access mask with the registry view
+//      pszSubKey  - the registry key
+//      pHash      - the hash to update
+//      pNumItems  - incremented by the number of subkeys
+//
+//  Remarks:
+//      The key's own last write time changes when subkeys are added or
+//      removed, each subkey's time changes when its values are written.
+//      A key that does not exist adds a zero time to the hash.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CategorySnapshotCache::HashRegistryKey( HKEY hKey,
+                                             DWORD samDesired,
+                                             LPCWSTR pszSubKey, UINT64* pHash, size_t* pNumItems )
+{
+    size_t      i = 0, numSubKeys = 0;
+    UINT64      lastWriteTime = 0;
+    Registry    RegObject;
+    StringArray SubKeys;
+    TArray< UINT64 > LastWriteTimes;
+
+    if ( ( pHash == nullptr ) || ( pNumItems == nullptr ) )
+    {
+        throw ParameterException( L"pHash/pNumItems", __FUNCTION__ );
+    }
+
+    RegObject.Connect2( hKey, samDesired );
+    lastWriteTime = RegObject.GetSubKeyWriteTimes( pszSubKey, &SubKeys, &LastWriteTimes );
+    HashString( pszSubKey, pHash );
+    HashUInt64( lastWriteTime, pHash );
+
+    numSubKeys = SubKeys.GetSize();
+    for ( i = 0; i < numSubKeys; i++ )
+    {
+        HashString( SubKeys.Get( i ), pHash );
+        HashUInt64( LastWriteTimes.Get( i ), pHash );
+    }
+    *pNumItems += numSubKeys;
+}
+
+//===============================================================================================//
+//  Description:
+//      Add the services and their states to a hash
+//
+//  Parameters:
+//      pHash     - the hash to update
+//      pNumItems - incremented by the number of services
+//
+//  Remarks:
+//      The service configuration is in the registry so is covered by the
+//      Services key, here only need the run time state.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CategorySnapshotCache::HashServices( UINT64* pHash, size_t* pNumItems )
+{
+    DWORD bytesESS = 0, bytesNeeded = 0, servicesReturned = 0;
+    DWORD lastError = 0, resumeHandle = 0;
+    SC_HANDLE     hSCManager = nullptr;
+    AllocateBytes AllocBytes;
+    ENUM_SERVICE_STATUS* lpESS = nullptr;
+
+    if ( ( pHash == nullptr ) || ( pNumItems == nullptr ) )
+    {
+        throw ParameterException( L"pHash/pNumItems", __FUNCTION__ );
+    }
+
+    // Same buffer size as used to collect the services
+    bytesESS = 100 * ( sizeof ( ENUM_SERVICE_STATUS ) + 512 );
+    lpESS = reinterpret_cast<ENUM_SERVICE_STATUS*>( AllocBytes.New(bytesESS ));
+
+    hSCManager = OpenSCManager( nullptr, nullptr, SC_MANAGER_ENUMERATE_SERVICE );
+    if ( hSCManager == nullptr )
+    {
+        throw SystemException( GetLastError(), L"OpenSCManager", __FUNCTION__ );
+    }
+
+    // Must catch all errors to free handle
+    try
+    {
+        do
+        {
+            servicesReturned = 0;
+            memset( lpESS, 0, bytesESS );
+            BOOL success = EnumServicesStatus( hSCManager,
+                                               SERVICE_WIN32 | SERVICE_DRIVER,
+                                               SERVICE_STATE_ALL,
+                                               lpESS,
+                                               bytesESS,
+                                               &bytesNeeded, &servicesReturned, &resumeHandle );
+            lastError = GetLastError();
+            if ( ( success == 0 ) && ( lastError != ERROR_MORE_DATA ) )
+            {
+                throw SystemException( lastError, L"EnumServicesStatus", __FUNCTION__ );
+            }
+
+            for ( DWORD i = 0; i < servicesReturned; i++ )
+            {
+                HashString( lpESS[ i ].lpServiceName, pHash );
+                HashUInt64( lpESS[ i ].ServiceStatus.dwServiceType , pHash );
+                HashUInt64( lpESS[ i ].ServiceStatus.dwCurrentState, pHash );
+            }
+            *pNumItems += servicesReturned;
+        } while ( ( resumeHandle     != 0 ) &&
+                  ( servicesReturned != 0 ) &&
+                  ( lastError == ERROR_MORE_DATA ) );
+    }
+    catch ( const Exception& )
+    {
+        CloseServiceHandle( hSCManager );
+        throw;
+    }
+    CloseServiceHandle( hSCManager );
+}
+
+//===============================================================================================//
+//  Description:
+//      Add a string to a 64-bit FNV-1a hash
+//
+//  Parameters:
+//      pszString - the string, can be NULL
+//      pHash     - the hash to update
+//
+//  Remarks:
+//      A terminator is also hashed so that "ab" + "c" and "a" + "bc" differ
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CategorySnapshotCache::HashString( LPCWSTR pszString, UINT64* pHash )
+{
+    if ( pHash == nullptr )
+    {
+        throw ParameterException( L"pHash", __FUNCTION__ );
+    }
+
+    if ( pszString )
+    {
+        while ( *pszString )
+        {
+            *pHash ^= *pszString;
+            *pHash *= 1099511628211ULL;
+            pszString++;
+        }
+    }
+    *pHash ^= 0xFFFF;
+    *pHash *= 1099511628211ULL;
+}
+
+//===============================================================================================//
+//  Description:
+//      Add a number to a 64-bit FNV-1a hash
+//
+//  Parameters:
+//      value - the number
+//      pHash - the hash to update
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CategorySnapshotCache::HashUInt64( UINT64 value, UINT64* pHash )
+{
+    if ( pHash == nullptr )
+    {
+        throw ParameterException( L"pHash", __FUNCTION__ );
+    }
+
+    for ( int i = 0; i < 8; i++ )
+    {
+        *pHash ^= ( value & 0xFF );
+        *pHash *= 1099511628211ULL;
+        value >>= 8;
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Determine if a file or directory is owned by SYSTEM, Administrators
+//      or the user running this program
+//
+//  Parameters:
+//      Path - the file or directory, must exist
+//
+//  Remarks:
+//      A reparse point is not trusted as the owner would be its target's.
+//
+//  Returns:
+//      true if the owner is trusted, otherwise false
+//===============================================================================================//
+bool CategorySnapshotCache::IsTrustedOwner( const String& Path )
+{
+    bool   trusted    = false;
+    DWORD  attributes = 0, errorCode = 0, length = 0;
+    PSID   pSidOwner  = nullptr;
+    HANDLE hToken     = nullptr;
+    TOKEN_USER*   pTokenUser = nullptr;
+    AllocateBytes AllocBytes;
+    PSECURITY_DESCRIPTOR pSecurityDescriptor = nullptr;
+
+    if ( Path.IsEmpty() )
+    {
+        throw ParameterException( L"Path", __FUNCTION__ );
+    }
+
+    attributes = GetFileAttributes( Path.c_str() );
+    if ( attributes == INVALID_FILE_ATTRIBUTES )
+    {
+        throw SystemException( GetLastError(), Path.c_str(), "GetFileAttributes" );
+    }
+
+    if ( attributes & FILE_ATTRIBUTE_REPARSE_POINT )
+    {
+        return false;
+    }
+
+    errorCode = GetNamedSecurityInfo( Path.c_str(),
+                                      SE_FILE_OBJECT,
+                                      OWNER_SECURITY_INFORMATION,
+                                      &pSidOwner, nullptr, nullptr, nullptr, &pSecurityDescriptor );
+    if ( errorCode != ERROR_SUCCESS )
+    {
+        throw SystemException( errorCode, Path.c_str(), "GetNamedSecurityInfo" );
+    }
+
+    // Catch as must free the security descriptor
+    try
+    {
+        if ( pSidOwner == nullptr )
+        {
+            trusted = false;
+        }
+        else if ( IsWellKnownSid( pSidOwner, WinLocalSystemSid ) ||
+                  IsWellKnownSid( pSidOwner, WinBuiltinAdministratorsSid ) )
+        {
+            trusted = true;
+        }
+        else
+        {
+            if ( OpenProcessToken( GetCurrentProcess(), TOKEN_QUERY, &hToken ) == 0 )
+            {
+                throw SystemException( GetLastError(), L"OpenProcessToken", __FUNCTION__ );
+            }
+            AutoCloseHandle CloseTokenHandle( hToken );
+
+            length     = sizeof ( TOKEN_USER ) + SECURITY_MAX_SID_SIZE;
+            pTokenUser = reinterpret_cast<TOKEN_USER*>( AllocBytes.New( length ) );
+            if ( GetTokenInformation( hToken, TokenUser, pTokenUser, length, &length ) == 0 )
+            {
+                throw SystemException( GetLastError(), L"GetTokenInformation", __FUNCTION__ );
+            }
+
+            if ( EqualSid( pSidOwner, pTokenUser->User.Sid ) )
+            {
+                trusted = true;
+            }
+        }
+    }
+    catch ( const Exception& )
+    {
+        LocalFree( pSecurityDescriptor );
+        throw;
+    }
+    LocalFree( pSecurityDescriptor );
+
+    return trusted;
+}
+
+//===============================================================================================//
+//  Description:
+//      Make an audit record from a snapshot record line
+//
+//  Parameters:
+//      categoryID - the expected category
+//      Line       - the record line without the CRLF
+//      pRecord    - receives the record
+//
+//  Returns:
+//      true if the line is a valid record of the category, otherwise false
+//===============================================================================================//
+bool CategorySnapshotCache::ParseRecordLine( DWORD categoryID,
+                                             const String& Line, AuditRecord* pRecord )
+{
+    wchar_t     ch = 0;
+    size_t      i = 0, j = 0, numFields = 0, length = 0;
+    String      Field, Value;
+    Formatter   Format;
+    StringArray Fields;
+
+    if ( pRecord == nullptr )
+    {
+        throw ParameterException( L"pRecord", __FUNCTION__ );
+    }
+
+    numFields = Line.ToArray( PXS_CHAR_TAB, &Fields );
+    if ( ( numFields == 0 ) || ( numFields > PXS_CATEGORY_INTERVAL ) )
+    {
+        return false;
+    }
+
+    Field = Fields.Get( 0 );
+    if ( Field.IsEmpty() || ( Format.StringToUInt32( Field ) != categoryID ) )
+    {
+        return false;
+    }
+    pRecord->Reset( categoryID );
+
+    // Item identifiers follow from the position of the value
+    for ( i = 1; i < numFields; i++ )
+    {
+        Field  = Fields.Get( i );
+        length = Field.GetLength();
+        Value  = PXS_STRING_EMPTY;
+        Value.Allocate( length + 1 );
+        for ( j = 0; j < length; j++ )
+        {
+            ch = Field.CharAt( j );
+            if ( ( ch == '\\' ) && ( ( j + 1 ) < length ) )
+            {
+                j++;
+                ch = Field.CharAt( j );
+                if ( ch == 't' )
+                {
+                    ch = PXS_CHAR_TAB;
+                }
+                else if ( ch == 'r' )
+                {
+                    ch = PXS_CHAR_CR;
+                }
+                else if ( ch == 'n' )
+                {
+                    ch = PXS_CHAR_LF;
+                }
+            }
+            Value += ch;
+        }
+        pRecord->Add( categoryID + static_cast<DWORD>( i ), Value );
+    }
+
+    return true;
+}
+
+//===============================================================================================//
+//  Description:
+//      Make a snapshot record line from an audit record
+//
+//  Parameters:
+//      Record - the audit record
+//      pLine  - receives the line including the CRLF
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CategorySnapshotCache::WriteRecordLine( const AuditRecord& Record, String* pLine )
+{
+    size_t    i = 0, numValues = 0;
+    LPCWSTR   pszValue = nullptr;
+    Formatter Format;
+
+    if ( pLine == nullptr )
+    {
+        throw ParameterException( L"pLine", __FUNCTION__ );
+    }
+    *pLine = Format.UInt32( Record.GetCategoryID() );
+
+    numValues = Record.GetNumberOfValues();
+    for ( i = 0; i < numValues; i++ )
+    {
+        *pLine  += PXS_CHAR_TAB;
+        pszValue = Record.GetValue( i );
+        while ( pszValue && *pszValue )
+        {
+            switch ( *pszValue )
+            {
+                default:
+                    *pLine += *pszValue;
+                    break;
+
+                case PXS_CHAR_TAB:
+                    *pLine += L"\\t";
+                    break;
+
+                case PXS_CHAR_CR:
+                    *pLine += L"\\r";
+                    break;
+
+                case PXS_CHAR_LF:
+                    *pLine += L"\\n";
+                    break;
+
+                case '\\':
+                    *pLine += L"\\\\";
+                    break;
+            }
+            pszValue++;
+        }
+    }
+    *pLine += PXS_STRING_CRLF;
+}
@@ -0,0 +1,613 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Collector Thread Class Implementation
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Header Files/CollectorThread.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/Application.h"
+#include "PxsBase/Header Files/AutoCloseHandle.h"
+#include "PxsBase/Header Files/Formatter.h"
+#include "PxsBase/Header Files/FunctionException.h"
+#include "PxsBase/Header Files/ParameterException.h"
+#include "PxsBase/Header Files/SystemException.h"
+
+// 5. This Project
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Default constructor
+CollectorThread::CollectorThread()
+                :m_bExportPending( false ),
+                 m_uNumFailures( 0 ),
+                 m_retryAt( 0 ),
+                 m_FileSwitchValue(),
+                 m_TimestampSwitchValue(),
+                 m_Auditor(),
+                 m_Database(),
+                 m_OdbcExport(),
+                 m_Entries()
+{
+}
+
+// Copy constructor - not allowed so no implementation
+
+// Destructor
+CollectorThread::~CollectorThread()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Operators
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Assignment operator - not allowed so no implementation
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Public Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Add a category to collect at the specified interval
+//
+//  Parameters:
+//      categoryID   - the category
+//      intervalSecs - seconds between collections, at least MIN_INTERVAL_SECS
+//
+//  Remarks:
+//      Called by worker: No. Must be called before the thread is run. If the
+//      category is already scheduled the shorter interval is kept.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CollectorThread::AddSchedule( DWORD categoryID, DWORD intervalSecs )
+{
+    size_t i = 0, numEntries = 0;
+    TYPE_COLLECTOR_ENTRY  Entry;
+    TYPE_COLLECTOR_ENTRY* pEntry = nullptr;
+
+    if ( IsCreated() )
+    {
+        throw FunctionException( L"IsCreated", __FUNCTION__ );
+    }
+
+    if ( intervalSecs < MIN_INTERVAL_SECS )
+    {
+        throw ParameterException( L"intervalSecs", __FUNCTION__ );
+    }
+
+    numEntries = m_Entries.GetSize();
+    for ( i = 0; i < numEntries; i++ )
+    {
+        pEntry = m_Entries.GetPtr( i );
+        if ( pEntry->categoryID == categoryID )
+        {
+            pEntry->intervalSecs = PXSMinUInt32( pEntry->intervalSecs, intervalSecs );
+            return;
+        }
+    }
+
+    // Due straight away
+    Entry.categoryID   = categoryID;
+    Entry.intervalSecs = intervalSecs;
+    Entry.dueAt        = 0;
+    Entry.recordsHash  = 0;
+    m_Entries.Add( Entry );
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the number of scheduled categories
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      size_t
+//===============================================================================================//
+size_t CollectorThread::GetNumberOfSchedules() const
+{
+    return m_Entries.GetSize();
+}
+
+//===============================================================================================//
+//  Description:
+//      Set where the audits are sent
+//
+//  Parameters:
+//      FileSwitchValue      - the /f= value, a file name or a connection string
+//      TimestampSwitchValue - the /T= value for file names
+//
+//  Remarks:
+//      Called by worker: No. Must be called before the thread is run.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CollectorThread::SetSink( const String& FileSwitchValue, const String& TimestampSwitchValue )
+{
+    if ( IsCreated() )
+    {
+        throw FunctionException( L"IsCreated", __FUNCTION__ );
+    }
+    m_FileSwitchValue      = FileSwitchValue;
+    m_TimestampSwitchValue = TimestampSwitchValue;
+}
+
+//===============================================================================================//
+//  Description:
+//      Tell a resident collector in this session to stop
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CollectorThread::SignalStop()
+{
+    HANDLE hEvent = OpenEvent( EVENT_MODIFY_STATE, FALSE, PXS_COLLECTOR_STOP_EVENT );
+    if ( hEvent == nullptr )
+    {
+        PXSLogAppWarn( L"There is no resident collector to stop." );
+        return;
+    }
+    AutoCloseHandle CloseEvent( hEvent );
+
+    if ( SetEvent( hEvent ) == 0 )
+    {
+        throw SystemException( GetLastError(), L"SetEvent", __FUNCTION__ );
+    }
+    PXSLogAppInfo( L"Told the resident collector to stop." );
+}
+
+//===============================================================================================//
+//  Description:
+//      Run the collector until it is told to stop
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      Called by worker: No. Blocks the creator until another process calls
+//      SignalStop or the worker exits.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CollectorThread::WaitForStop()
+{
+    const  DWORD POLL_MS = 1000;
+    DWORD  waitResult = WAIT_TIMEOUT;
+    HANDLE hEvent = nullptr;
+
+    if ( m_Entries.GetSize() == 0 )
+    {
+        throw FunctionException( L"m_Entries", __FUNCTION__ );
+    }
+
+    // Manual reset so a stop sent before the wait is not lost
+    hEvent = CreateEvent( nullptr, TRUE, FALSE, PXS_COLLECTOR_STOP_EVENT );
+    if ( hEvent == nullptr )
+    {
+        throw SystemException( GetLastError(), L"CreateEvent", __FUNCTION__ );
+    }
+    AutoCloseHandle CloseEvent( hEvent );
+
+    if ( GetLastError() == ERROR_ALREADY_EXISTS )
+    {
+        throw SystemException( ERROR_ALREADY_EXISTS,
+                               L"A resident collector is already running.", __FUNCTION__ );
+    }
+
+    PXSLogAppInfo( L"Starting the resident collector." );
+    Run( nullptr );
+    while ( IsRunning() && ( waitResult == WAIT_TIMEOUT ) )
+    {
+        waitResult = WaitForSingleObject( hEvent, POLL_MS );
+    }
+    Stop();
+    Join();
+    PXSLogAppInfo( L"The resident collector has stopped." );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Protected Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Collect the records of a category
+//
+//  Parameters:
+//      categoryID - the category
+//      LocalTime  - the time of this pass in ISO format
+//      pRecords   - receives the records
+//
+//  Remarks:
+//      Called by worker: Yes
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CollectorThread::CollectCategory( DWORD categoryID,
+                                       const String& LocalTime, TArray< AuditRecord >* pRecords )
+{
+    m_Auditor.GetCategoryRecords( categoryID, LocalTime, pRecords );
+}
+
+//===============================================================================================//
+//  Description:
+//      Collect the categories that are due
+//
+//  Parameters:
+//      now       - the current time
+//      LocalTime - the time of this pass in ISO format
+//
+//  Remarks:
+//      Called by worker: Yes. The next collection is scheduled from now so
+//      runs missed while busy or suspended are not made up. A category that
+//      fails keeps its previous records. The auditor's state from the last
+//      pass is discarded first so processes and accounts are read afresh.
+//
+//  Returns:
+//      true if the records of a category changed otherwise false
+//===============================================================================================//
+bool CollectorThread::CollectDueCategories( time_t now, const String& LocalTime )
+{
+    bool      changed = false;
+    size_t    i = 0, numEntries = 0, numCollected = 0, numChanged = 0;
+    UINT64    hash = 0;
+    String    Collected, Changed;
+    Formatter Format;
+    TArray< AuditRecord > Records;
+    TYPE_COLLECTOR_ENTRY* pEntry = nullptr;
+
+    m_Auditor.ResetPerPassState();
+    numEntries = m_Entries.GetSize();
+    for ( i = 0; i < numEntries; i++ )
+    {
+        pEntry = m_Entries.GetPtr( i );
+        if ( m_bRunMT && ( pEntry->dueAt <= now ) )
+        {
+            pEntry->dueAt = now + pEntry->intervalSecs;
+            try
+            {
+                Records.RemoveAll();
+                CollectCategory( pEntry->categoryID, LocalTime, &Records );
+                hash = HashRecords( Records );
+                if ( hash != pEntry->recordsHash )
+                {
+                    pEntry->recordsHash = hash;
+                    pEntry->Records     = Records;
+                    numChanged++;
+                    changed = true;
+                }
+                numCollected++;
+            }
+            catch ( const Exception& e )
+            {
+                PXSLogException( e, __FUNCTION__ );
+            }
+        }
+    }
+
+    if ( numCollected )
+    {
+        Collected = Format.SizeT( numCollected );
+        Changed   = Format.SizeT( numChanged );
+        PXSLogAppInfo2( L"Collected %%1 categories, %%2 changed.", Collected, Changed );
+    }
+
+    return changed;
+}
+
+//===============================================================================================//
+//  Description:
+//      Send an audit to the sink
+//
+//  Parameters:
+//      LocalTime    - the time of this pass in ISO format
+//      AuditRecords - the records of all the scheduled categories
+//
+//  Remarks:
+//      Called by worker: Yes. A database connection is kept between audits
+//      and dropped on an error so the next try makes a new one. SQLite
+//      databases and files are handled as for a command line audit.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CollectorThread::ExportAudit( const String& LocalTime,
+                                   const TArray< AuditRecord >& AuditRecords )
+{
+    String      OutputPath, ResultMessage;
+    AuditRecord AuditMasterRecord, ComputerMasterRecord;
+
+    if ( m_FileSwitchValue.StartsWith( L"DBQ=", false ) ||
+         m_FileSwitchValue.StartsWith( L"DRIVER=", false ) )
+    {
+        if ( m_Database.IsConnected() == false )
+        {
+            m_Database.Connect( m_FileSwitchValue,
+                                PXS_DB_CONNECT_TIMEOUT_SECS_DEF,
+                                PXS_DB_QUERY_TIMEOUT_SECS_DEF, nullptr );
+        }
+        m_Auditor.MakeAuditMasterRecord( &AuditMasterRecord );
+        m_Auditor.MakeComputerMasterRecord( &ComputerMasterRecord );
+        m_OdbcExport.SetAuditRecords( AuditMasterRecord, ComputerMasterRecord, AuditRecords );
+        try
+        {
+            m_OdbcExport.ExportRecordsToDatabase( &m_Database, &ResultMessage );
+        }
+        catch ( const Exception& )
+        {
+            m_Database.Disconnect();
+            throw;
+        }
+    }
+    else
+    {
+        PXSMakeCommandLineOutputPath( m_FileSwitchValue,
+                                      m_TimestampSwitchValue, LocalTime, &OutputPath );
+        PXSSaveAuditCommandLine( OutputPath, AuditRecords );
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Get how long to wait before the next pass
+//
+//  Parameters:
+//      now - the current time
+//
+//  Remarks:
+//      Called by worker: Yes
+//
+//  Returns:
+//      milli-seconds until a category is due or an export is to be retried
+//===============================================================================================//
+DWORD CollectorThread::GetWaitMilliSecs( time_t now ) const
+{
+    size_t i = 0, numEntries = 0;
+    time_t wakeAt = now + MAX_WAIT_SECS;
+
+    numEntries = m_Entries.GetSize();
+    for ( i = 0; i < numEntries; i++ )
+    {
+        const TYPE_COLLECTOR_ENTRY& Entry = m_Entries.Get( i );
+        if ( Entry.dueAt < wakeAt )
+        {
+            wakeAt = Entry.dueAt;
+        }
+    }
+
+    if ( m_bExportPending && ( m_retryAt < wakeAt ) )
+    {
+        wakeAt = m_retryAt;
+    }
+
+    if ( wakeAt <= now )
+    {
+        return 0;
+    }
+
+    return 1000 * PXSCastTimeTToUInt32( wakeAt - now );
+}
+
+//===============================================================================================//
+//  Description:
+//      Export the pending audit unless backing off after a failure
+//
+//  Parameters:
+//      now       - the current time
+//      LocalTime - the time of this pass in ISO format
+//
+//  Remarks:
+//      Called by worker: Yes. The audit is made from the latest records of
+//      every category when it is sent so changes made while the sink is
+//      failing are merged. The retry delay doubles up to MAX_RETRY_SECS.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CollectorThread::PushChanges( time_t now, const String& LocalTime )
+{
+    DWORD     delaySecs = 0;
+    size_t    i = 0, numEntries = 0;
+    Formatter Format;
+    TArray< AuditRecord > AuditRecords;
+
+    if ( ( m_bExportPending == false ) || ( now < m_retryAt ) )
+    {
+        return;
+    }
+
+    numEntries = m_Entries.GetSize();
+    for ( i = 0; i < numEntries; i++ )
+    {
+        AuditRecords.Append( m_Entries.Get( i ).Records );
+    }
+
+    try
+    {
+        ExportAudit( LocalTime, AuditRecords );
+        m_bExportPending = false;
+        m_uNumFailures   = 0;
+        m_retryAt        = 0;
+    }
+    catch ( const Exception& e )
+    {
+        PXSLogException( e, __FUNCTION__ );
+        m_uNumFailures = PXSAddUInt32( m_uNumFailures, 1 );
+        delaySecs = MIN_INTERVAL_SECS << PXSMinUInt32( m_uNumFailures - 1, 6 );
+        delaySecs = PXSMinUInt32( delaySecs, MAX_RETRY_SECS );
+        m_retryAt = now + delaySecs;
+        PXSLogAppWarn1( L"Will retry the export in %%1 seconds.", Format.UInt32( delaySecs ) );
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Collect the categories that are due then export if any changed
+//
+//  Parameters:
+//      now       - the current time
+//      LocalTime - the time of this pass in ISO format
+//
+//  Remarks:
+//      Called by worker: Yes
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void CollectorThread::RunPass( time_t now, const String& LocalTime )
+{
+    if ( CollectDueCategories( now, LocalTime ) )
+    {
+        m_bExportPending = true;
+    }
+    PushChanges( now, LocalTime );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Private Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Hash the records of a category to tell if they changed
+//
+//  Parameters:
+//      Records - the records
+//
+//  Remarks:
+//      FNV-1a over the category identifiers and values. A separator is
+//      hashed after each value so moving text between values changes it.
+//
+//  Returns:
+//      the hash
+//===============================================================================================//
+UINT64 CollectorThread::HashRecords( const TArray< AuditRecord >& Records )
+{
+    const  UINT64 FNV_PRIME = 1099511628211ULL;
+    size_t i = 0, j = 0, k = 0, numRecords = 0, numValues = 0, numChars = 0;
+    UINT64 hash = 14695981039346656037ULL;
+    LPCWSTR pszValue = nullptr;
+
+    numRecords = Records.GetSize();
+    for ( i = 0; i < numRecords; i++ )
+    {
+        const AuditRecord& Record = Records.Get( i );
+        hash ^= Record.GetCategoryID();
+        hash *= FNV_PRIME;
+
+        numValues = Record.GetNumberOfValues();
+        for ( j = 0; j < numValues; j++ )
+        {
+            pszValue = Record.GetValue( j );
+            numChars = Record.GetValueLength( j );
+            for ( k = 0; k < numChars; k++ )
+            {
+                hash ^= static_cast<UINT64>( pszValue[ k ] );
+                hash *= FNV_PRIME;
+            }
+            hash ^= 0xFFFF;
+            hash *= FNV_PRIME;
+        }
+    }
+
+    return hash;
+}
+
+//===============================================================================================//
+//  Description:
+//      Run the worker thread. This method must only be called by the worker.
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      DWORD system error code
+//===============================================================================================//
+DWORD CollectorThread::RunWorkerThread()
+{
+    DWORD     result = ERROR_SUCCESS, waitMS = 0;
+    time_t    now = 0;
+    String    LocalTime;
+    Formatter Format;
+
+    if ( m_hStopEventMT == nullptr )
+    {
+        return ERROR_INVALID_FUNCTION;
+    }
+
+    try
+    {
+        PXSInitializeComOnThread();
+        do
+        {
+            time( &now );
+            LocalTime = Format.LocalTimeInIsoFormat();
+            RunPass( now, LocalTime );
+
+            // The logger only flushes on its interval when the next entry
+            // arrives so write out this pass's messages before sleeping
+            if ( g_pApplication )
+            {
+                g_pApplication->LogFlush();
+            }
+            time( &now );
+            waitMS = GetWaitMilliSecs( now );
+        }
+        while ( m_bRunMT && ( WaitForSingleObject( m_hStopEventMT, waitMS ) == WAIT_TIMEOUT ) );
+        m_Auditor.LogCacheStatistics();
+    }
+    catch ( const Exception& e )
+    {
+        result = e.GetErrorCode();
+        PXSLogException( e, __FUNCTION__ );
+    }
+
+    return result;
+}
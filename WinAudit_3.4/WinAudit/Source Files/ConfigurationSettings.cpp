@@ -89,6 +89,9 @@ ConfigurationSettings::ConfigurationSettings()
                        connectTimeoutSecs( PXS_DB_LOGIN_TIMEOUT_SECS_DEF ),
                        queryTimeoutSecs( PXS_DB_QUERY_TIMEOUT_SECS_DEF ),
                        reportMaxRecords( PXS_REPORT_MAX_RECORDS_DEFAULT ),
+                       retainAuditCount( PXS_DB_RETAIN_AUDITS_DEFAULT ),
+                       retainAuditDays( PXS_DB_RETAIN_DAYS_DEFAULT ),
+                       purgeBatchSize( PXS_DB_PURGE_BATCH_DEFAULT ),
                        DBMS(),
                        DatabaseName(),
                        MySqlDriver(),
@@ -159,6 +162,9 @@ ConfigurationSettings& ConfigurationSettings::operator= (
     connectTimeoutSecs = oSettings.connectTimeoutSecs;
     queryTimeoutSecs   = oSettings.queryTimeoutSecs;
     reportMaxRecords   = oSettings.reportMaxRecords;
+    retainAuditCount   = oSettings.retainAuditCount;
+    retainAuditDays    = oSettings.retainAuditDays;
+    purgeBatchSize     = oSettings.purgeBatchSize;
     DBMS               = oSettings.DBMS;
     DatabaseName       = oSettings.DatabaseName;
     MySqlDriver        = oSettings.MySqlDriver;
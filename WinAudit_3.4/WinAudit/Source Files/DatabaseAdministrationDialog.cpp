@@ -47,6 +47,7 @@
 #include "PxsBase/Header Files/Application.h"
 #include "PxsBase/Header Files/File.h"
 #include "PxsBase/Header Files/Formatter.h"
+#include "PxsBase/Header Files/FunctionException.h"
 #include "PxsBase/Header Files/MessageDialog.h"
 #include "PxsBase/Header Files/NameValue.h"
 #include "PxsBase/Header Files/ParameterException.h"
@@ -68,11 +69,13 @@
 
 // Default Constructor
 DatabaseAdministrationDialog::DatabaseAdministrationDialog()
-                             :m_uIdxStaticProgress( PXS_MINUS_ONE ),
+                             :m_bHasSummaryTables( false ),
+                              m_uIdxStaticProgress( PXS_MINUS_ONE ),
                               m_OdbcDriver(),
                               m_CloseButton(),
                               m_CreateButton(),
                               m_DeleteHistoryButton(),
+                              m_RebuildSummariesButton(),
                               m_RunReportButton(),
                               m_GrantPublicCheckBox(),
                               m_ReportShowSqlCheckBox(),
@@ -86,7 +89,7 @@ DatabaseAdministrationDialog::DatabaseAdministrationDialog()
 {
     try
     {
-        SetSize( 440, 370 );
+        SetSize( 440, 393 );
     }
     catch ( const Exception& e )
     {
@@ -126,6 +129,87 @@ DatabaseAdministrationDialog::~DatabaseAdministrationDialog()
 // Public Methods
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+//===============================================================================================//
+//  Description:
+//      Add the SQL statement to create the trigger that deletes an Audit_Value
+//      row when the last Audit_Item row using it is deleted
+//
+//  Parameters:
+//      pStatements - array to receive the statement
+//
+//  Remarks:
+//      SQLite only. Deleting an audit cascades to its Audit_Item rows and the
+//      cascade fires the trigger so the value dictionary does not keep the
+//      values of audits that have gone.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DatabaseAdministrationDialog::AddCreateAuditValueTriggerSql( StringArray* pStatements )
+{
+    if ( pStatements == nullptr )
+    {
+        throw ParameterException( L"pStatements", __FUNCTION__ );
+    }
+
+    pStatements->Add( L"CREATE TRIGGER trg_AI_Delete_Value AFTER DELETE ON Audit_Item "
+                      L"FOR EACH ROW WHEN OLD.Value_ID IS NOT NULL AND NOT EXISTS "
+                      L"( SELECT 1 FROM Audit_Item WHERE Value_ID = OLD.Value_ID ) "
+                      L"BEGIN DELETE FROM Audit_Value WHERE Value_ID = OLD.Value_ID; END" );
+}
+
+//===============================================================================================//
+//  Description:
+//      Add the SQL statements to create the tables of a SQLite database to
+//      the Statements array
+//
+//  Parameters:
+//      valueDictionary - true to store the audit data in a value dictionary
+//      pStatements     - receives the data definition queries
+//
+//  Remarks:
+//      A SQLite file is for collecting audits to merge into a server database
+//      so there are no summary tables or procedures. A column of type INTEGER
+//      that is the primary key is the rowid so increments automatically.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DatabaseAdministrationDialog::AddCreateSqliteSql( bool valueDictionary,
+                                                       StringArray* pStatements )
+{
+    String AutoIncrementKeyword, IntegerKeyword, TimestampKeyword;
+    String VarCharKeyword, TCharKeyword, VarTCharKeyword, SchemaName;
+
+    if ( pStatements == nullptr )
+    {
+        throw ParameterException( L"pStatements", __FUNCTION__ );
+    }
+    AutoIncrementKeyword = L"INTEGER";
+    IntegerKeyword       = L"INTEGER";
+    TimestampKeyword     = L"TIMESTAMP";
+    VarCharKeyword       = L"VARCHAR";
+    TCharKeyword         = L"CHAR";
+    VarTCharKeyword      = L"VARCHAR";
+
+    AddCreateComputerMasterSql( AutoIncrementKeyword,
+                                IntegerKeyword,
+                                TimestampKeyword, VarCharKeyword, VarTCharKeyword, pStatements );
+    AddCreateAuditMasterSql( AutoIncrementKeyword,
+                             IntegerKeyword,
+                             TimestampKeyword, VarCharKeyword, VarTCharKeyword, pStatements );
+    if ( valueDictionary )
+    {
+        AddCreateAuditItemSql( IntegerKeyword, VarTCharKeyword, pStatements );
+    }
+    else
+    {
+        AddCreateAuditDataSql( IntegerKeyword, TCharKeyword, VarTCharKeyword, pStatements );
+    }
+    AddCreateDisplayNamesSql( IntegerKeyword, VarTCharKeyword, pStatements );
+    AddCreateViews( SchemaName, pStatements );
+}
+
 //===============================================================================================//
 //  Description:
 //      Get the settings used by the dialog
@@ -240,6 +324,11 @@ LRESULT DatabaseAdministrationDialog::CommandEvent( WPARAM wParam, LPARAM lParam
             DeleteOldAudits();
             m_DeleteHistoryButton.Repaint();
         }
+        else if ( IsClickFromButton( m_RebuildSummariesButton, wParam, lParam ) )
+        {
+            RebuildSummaries();
+            m_RebuildSummariesButton.Repaint();
+        }
         else if ( IsClickFromButton( m_RunReportButton, wParam, lParam ) )
         {
             RunReport();
@@ -425,7 +514,7 @@ void DatabaseAdministrationDialog::InitDialogEvent()
     bounds.left   = GAP;
     bounds.right  = dialogSize.cx - GAP;
     bounds.top    = bounds.bottom + LINE_HEIGHT;
-    bounds.bottom = bounds.top + ( 2 * LINE_HEIGHT ) + GAP;
+    bounds.bottom = bounds.top + ( 3 * LINE_HEIGHT ) + GAP;
     Static.SetBounds( bounds );
     Static.SetShape( frameShape );
     PXSGetResourceString( PXS_IDS_1102_DATA_MAINTENANCE, &Text );
@@ -453,6 +542,24 @@ void DatabaseAdministrationDialog::InitDialogEvent()
     PXSGetResourceString( PXS_IDS_1104_DELETE, &Text );
     m_DeleteHistoryButton.SetText( Text );
 
+    // Label, will use English as for the report names
+    bounds.top   += LINE_HEIGHT;
+    bounds.bottom = bounds.top + CONTROL_HEIGHT;
+    bounds.right  = 250;
+    Static.SetBounds( bounds );
+    Text = L"Upgrade and rebuild summaries";
+    Static.SetText( Text );
+    m_Statics.Add( Static );
+    Static.Reset();
+
+    // Button to rebuild the report summary tables
+    location.x = dialogSize.cx - ( GAP + GAP + buttonSize.cx );
+    location.y = bounds.top;
+    m_RebuildSummariesButton.SetLocation( location );
+    m_RebuildSummariesButton.Create( m_hWindow );
+    Text = L"Rebuild";
+    m_RebuildSummariesButton.SetText( Text );
+
     // Frame for reports
     bounds.left   = GAP;
     bounds.right  = dialogSize.cx - GAP;
@@ -588,6 +695,7 @@ void DatabaseAdministrationDialog::InitDialogEvent()
         m_CloseButton.RtlMirror( dialogSize.cx );
         m_CreateButton.RtlMirror( dialogSize.cx );
         m_DeleteHistoryButton.RtlMirror( dialogSize.cx );
+        m_RebuildSummariesButton.RtlMirror( dialogSize.cx );
         m_RunReportButton.RtlMirror( dialogSize.cx );
         m_GrantPublicCheckBox.RtlMirror( dialogSize.cx );
         m_ReportShowSqlCheckBox.RtlMirror( dialogSize.cx );
@@ -774,6 +882,98 @@ void DatabaseAdministrationDialog::AddCreateAuditDataSql( const String& IntegerK
                       L"SELECT * FROM Audit_Data WHERE 1 = 2" );
 }
 
+//===============================================================================================//
+//  Description:
+//      Add the SQL statements to create the value dictionary form of the
+//      audit data to the Statements array
+//
+//  Parameters:
+//      IntegerKeyword  - the database specific SQL_INTEGER keyword
+//      VarTCharKeyword - the database specific SQL_VARCHAR/WVARCHAR keyword
+//      pStatements     - receives the  data definition queries
+//
+//  Remarks:
+//      SQLite only. Each distinct value is stored once in Audit_Value and
+//      Audit_Item has a row for each non-empty item. Audit_Data is a view
+//      that pivots the items back into the Item_n columns so the category
+//      views work unchanged. Grouping on Category_ID lets a category filter
+//      on the view use the index on Audit_Item.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DatabaseAdministrationDialog::AddCreateAuditItemSql( const String& IntegerKeyword,
+                                                          const String& VarTCharKeyword,
+                                                          StringArray* pStatements )
+{
+    size_t    i = 0;
+    String    SqlQuery, ItemNumber;
+    Formatter Format;
+
+    if ( pStatements == nullptr )
+    {
+        throw ParameterException( L"pStatements", __FUNCTION__ );
+    }
+
+    SqlQuery.Allocate( 256 );
+    SqlQuery = L"CREATE TABLE Audit_Value( "
+               L"Value_ID %%1 NOT NULL, "
+               L"Value_Hash %%1 NOT NULL, "
+               L"Value_Text %%2( 255 ) NOT NULL, "
+               L"CONSTRAINT PK_Audit_Value PRIMARY KEY ( Value_ID ) ) ";
+    SqlQuery.ReplaceI( L"%%1", IntegerKeyword.c_str() );
+    SqlQuery.ReplaceI( L"%%2", VarTCharKeyword.c_str() );
+    pStatements->Add( SqlQuery );
+    pStatements->Add( L"CREATE INDEX idx_AV_Value_Hash "
+                      L"ON Audit_Value( Value_Hash )" );
+
+    SqlQuery = L"CREATE TABLE Audit_Item( "
+               L"Audit_ID %%1 NOT NULL, "
+               L"Record_Ordinal %%1 NOT NULL, "
+               L"Computer_ID %%1 NULL, "
+               L"Category_ID %%1 NULL, "
+               L"Item_Number %%1 NOT NULL, "
+               L"Value_ID %%1 NULL, "
+               L"CONSTRAINT FK_Audit_Item_Audit_ID FOREIGN KEY "
+               L"( Audit_ID ) REFERENCES Audit_Master( Audit_ID ) "
+               L"ON DELETE CASCADE, CONSTRAINT FK_Audit_Item_Value_ID FOREIGN KEY "
+               L"( Value_ID ) REFERENCES Audit_Value( Value_ID ), "
+               L"CONSTRAINT PK_Audit_Item PRIMARY KEY"
+               L" ( Audit_ID, Record_Ordinal, Item_Number ) ) WITHOUT ROWID";
+    SqlQuery.ReplaceI( L"%%1", IntegerKeyword.c_str() );
+    pStatements->Add( SqlQuery );
+
+    // Indexes
+    pStatements->Add( L"CREATE INDEX idx_AI_Computer_ID "
+                      L"ON Audit_Item( Computer_ID )" );
+    pStatements->Add( L"CREATE INDEX idx_AI_Category_ID "
+                      L"ON Audit_Item( Category_ID )" );
+    pStatements->Add( L"CREATE INDEX idx_AI_Value_ID "
+                      L"ON Audit_Item( Value_ID )" );
+    AddCreateAuditValueTriggerSql( pStatements );
+
+    // Audit_Data as a view, 50 items as for AddCreateAuditDataSql
+    SqlQuery.Allocate( 4096 );
+    SqlQuery = L"CREATE VIEW Audit_Data AS SELECT "
+               L"I.Audit_ID, I.Record_Ordinal, I.Computer_ID, I.Category_ID";
+    for ( i = 0; i < 50; i++ )
+    {
+        ItemNumber = Format.SizeT( i + 1 );
+        SqlQuery  += L", MAX( CASE WHEN I.Item_Number = ";
+        SqlQuery  += ItemNumber;
+        SqlQuery  += L" THEN V.Value_Text END ) AS Item_";
+        SqlQuery  += ItemNumber;
+    }
+    SqlQuery += L" FROM Audit_Item AS I "
+                L"LEFT JOIN Audit_Value AS V ON V.Value_ID = I.Value_ID "
+                L"GROUP BY I.Audit_ID, I.Record_Ordinal, I.Computer_ID, I.Category_ID";
+    pStatements->Add( SqlQuery );
+
+    // Empty view
+    pStatements->Add( L"CREATE VIEW v_Audit_Data_Empty AS "
+                      L"SELECT * FROM Audit_Data WHERE 1 = 2" );
+}
+
 //===============================================================================================//
 //  Description:
 //      Add the SQL statements to create the Audit_Master table to the
@@ -850,8 +1050,10 @@ void DatabaseAdministrationDialog::AddCreateComputerMasterSql( const String& Aut
                                                                const String& VarTCharKeyword,
                                                                StringArray* pStatements )
 {
+    size_t    i = 0, numKeyColumns = 0;
     String    SqlQuery;
     Formatter Format;
+    StringArray KeyColumns;
 
     if ( pStatements == nullptr )
     {
@@ -875,6 +1077,13 @@ void DatabaseAdministrationDialog::AddCreateComputerMasterSql( const String& Aut
     SqlQuery += Format.String1( L"OS_Product_ID %%1( 32 ) NULL, "         , VarCharKeyword );
     SqlQuery += Format.String1( L"Other_Identifier %%1( 32 ) NULL, "      , VarCharKeyword );
     SqlQuery += Format.String1( L"WinAudit_GUID %%1( 40 ) NULL, "         , VarCharKeyword );
+    GetComputerMasterKeyColumns( VarCharKeyword, &KeyColumns );
+    numKeyColumns = KeyColumns.GetSize();
+    for ( i = 0; i < numKeyColumns; i++ )
+    {
+        SqlQuery += KeyColumns.Get( i );
+        SqlQuery += L", ";
+    }
     SqlQuery += L"CONSTRAINT PK_Computer_Master PRIMARY KEY(Computer_ID) )";
     pStatements->Add( SqlQuery );
 
@@ -888,6 +1097,40 @@ void DatabaseAdministrationDialog::AddCreateComputerMasterSql( const String& Aut
                       L"Computer_Master ( Computer_Name )" );
     pStatements->Add( L"CREATE UNIQUE INDEX idx_CM_Computer_GUID ON "
                       L"Computer_Master ( Computer_GUID )" );
+    AddCreateComputerMasterKeyIndexes( pStatements );
+}
+
+//===============================================================================================//
+//  Description:
+//      Add the SQL statements to create the indexes on the Computer_Master
+//      key columns to the Statements array
+//
+//  Parameters:
+//      pStatements - receives the statements
+//
+//  Remarks:
+//      These are the columns that identify a computer on export
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DatabaseAdministrationDialog::AddCreateComputerMasterKeyIndexes( StringArray* pStatements )
+{
+    if ( pStatements == nullptr )
+    {
+        throw ParameterException( L"pStatements", __FUNCTION__ );
+    }
+
+    pStatements->Add( L"CREATE INDEX idx_CM_Key_WinAudit_GUID ON "
+                      L"Computer_Master ( Key_WinAudit_GUID )" );
+    pStatements->Add( L"CREATE INDEX idx_CM_Key_FQDN ON "
+                      L"Computer_Master ( Key_FQDN )" );
+    pStatements->Add( L"CREATE INDEX idx_CM_Key_MAC_Address ON "
+                      L"Computer_Master ( Key_MAC_Address )" );
+    pStatements->Add( L"CREATE INDEX idx_CM_Key_Smbios_UUID ON "
+                      L"Computer_Master ( Key_Smbios_UUID )" );
+    pStatements->Add( L"CREATE INDEX idx_CM_Key_Computer_Name ON "
+                      L"Computer_Master ( Key_Computer_Name )" );
 }
 
 //===============================================================================================//
@@ -1012,39 +1255,64 @@ void DatabaseAdministrationDialog::AddCreateDisplayNamesSql( const String& Integ
 //===============================================================================================//
 //  Description:
 //      Add the SQL statements to create the PostgreSQL and SQL Server GRANTs
-//      to the Statements array
+//      on the Computer_Master table to the Statements array
 //
 //  Parameters:
 //      pStatements - receives the  data definition queries
 //
+//  Remarks:
+//      Exports update the Key_ columns so these are granted along with the
+//      columns that were always updated
+//
 //  Returns:
 //      void
 //===============================================================================================//
-void DatabaseAdministrationDialog::AddCreateGrants( StringArray* pStatements ) const
+void DatabaseAdministrationDialog::AddComputerMasterGrants( StringArray* pStatements ) const
 {
-    String    SqlQuery, UserName, Schema;
+    String    SqlQuery, Schema;
     Formatter Format;
 
     if ( pStatements == nullptr )
     {
         throw ParameterException( L"pStatements", __FUNCTION__ );
     }
+    GetGrantSchema( &Schema );
 
-    // CREATE ROLE is new for SQL Server 2005.
-    UserName = m_AuditDatabase.GetUserName();
-    if ( UserName.GetLength() )
-    {
-        Schema = Format.String1( L"[%%1].", UserName );
-    }
     SqlQuery = Format.String1( L"GRANT INSERT ON %%1[Computer_Master] TO PUBLIC", Schema );
     pStatements->Add( SqlQuery );
 
     SqlQuery = Format.String1( L"GRANT SELECT ON %%1[Computer_Master] TO PUBLIC", Schema );
     pStatements->Add( SqlQuery );
 
-    SqlQuery = Format.String1( L"GRANT UPDATE( Last_Audit_ID ) ON %%1[Computer_Master] TO PUBLIC",
-                               Schema );
+    SqlQuery = Format.String1( L"GRANT UPDATE( Last_Audit_ID, WinAudit_GUID, Key_WinAudit_GUID, "
+                               L"Key_FQDN, Key_Smbios_UUID, Key_Asset_Tag, Key_MAC_Address, "
+                               L"Key_OS_Product_ID, Key_Computer_Name ) "
+                               L"ON %%1[Computer_Master] TO PUBLIC", Schema );
     pStatements->Add( SqlQuery );
+}
+
+//===============================================================================================//
+//  Description:
+//      Add the SQL statements to create the PostgreSQL and SQL Server GRANTs
+//      to the Statements array
+//
+//  Parameters:
+//      pStatements - receives the  data definition queries
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DatabaseAdministrationDialog::AddCreateGrants( StringArray* pStatements ) const
+{
+    String    SqlQuery, Schema;
+    Formatter Format;
+
+    if ( pStatements == nullptr )
+    {
+        throw ParameterException( L"pStatements", __FUNCTION__ );
+    }
+    GetGrantSchema( &Schema );
+    AddComputerMasterGrants( pStatements );
 
     SqlQuery = Format.String1( L"GRANT INSERT ON %%1[Audit_Master] TO PUBLIC", Schema );
     pStatements->Add( SqlQuery );
@@ -1062,6 +1330,8 @@ void DatabaseAdministrationDialog::AddCreateGrants( StringArray* pStatements ) c
     SqlQuery = Format.String1( L"GRANT SELECT ON %%1[v_Audit_Data_Empty] TO PUBLIC", Schema );
     pStatements->Add( SqlQuery );
 
+    AddSummaryGrants( pStatements );
+
     SqlQuery = Format.String1( L"GRANT EXECUTE ON %%1[pxs_sp_insert_computer_master] TO PUBLIC",
                                Schema );
     pStatements->Add( SqlQuery );
@@ -1308,6 +1578,120 @@ void DatabaseAdministrationDialog::AddCreateSqlServerProcedures( StringArray* pS
     pStatements->Add( SqlQuery );
 }
 
+//===============================================================================================//
+//  Description:
+//      Add the SQL statements to create the report summary tables to the
+//      Statements array
+//
+//  Parameters:
+//      IntegerKeyword  - the database specific SQL_INTEGER keyword
+//      VarTCharKeyword - the database specific SQL_VARCHAR/WVARCHAR keyword
+//      Tables          - the tables already in the database, these are skipped
+//      stale           - the summaries need rebuilding before they are used
+//      pStatements     - receives the  data definition queries
+//
+//  Remarks:
+//      The keys are wide enough for the columns they are counted from
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DatabaseAdministrationDialog::AddCreateSummarySql( const String& IntegerKeyword,
+                                                        const String& VarTCharKeyword,
+                                                        const StringArray& Tables,
+                                                        bool stale, StringArray* pStatements )
+{
+    String    SqlQuery;
+    Formatter Format;
+
+    if ( pStatements == nullptr )
+    {
+        throw ParameterException( L"pStatements", __FUNCTION__ );
+    }
+
+    if ( Tables.IndexOf( L"Summary_Software", false ) == PXS_MINUS_ONE )
+    {
+        SqlQuery  = L"CREATE TABLE Summary_Software( ";
+        SqlQuery += Format.String1( L"Software_Name %%1( 255 ) NOT NULL, ", VarTCharKeyword );
+        SqlQuery += Format.String1( L"Installed_Count %%1 NOT NULL, ", IntegerKeyword );
+        SqlQuery += L"CONSTRAINT PK_Summary_Software PRIMARY KEY( Software_Name ) )";
+        pStatements->Add( SqlQuery );
+    }
+
+    if ( Tables.IndexOf( L"Summary_Errors", false ) == PXS_MINUS_ONE )
+    {
+        SqlQuery  = L"CREATE TABLE Summary_Errors( ";
+        SqlQuery += Format.String1( L"Error_Type %%1( 255 ) NOT NULL, ", VarTCharKeyword );
+        SqlQuery += Format.String1( L"Error_Count %%1 NOT NULL, ", IntegerKeyword );
+        SqlQuery += L"CONSTRAINT PK_Summary_Errors PRIMARY KEY( Error_Type ) )";
+        pStatements->Add( SqlQuery );
+    }
+
+    if ( Tables.IndexOf( L"Summary_Domains", false ) == PXS_MINUS_ONE )
+    {
+        SqlQuery  = L"CREATE TABLE Summary_Domains( ";
+        SqlQuery += Format.String1( L"Domain_Name %%1( 255 ) NOT NULL, ", VarTCharKeyword );
+        SqlQuery += Format.String1( L"Computer_Count %%1 NOT NULL, ", IntegerKeyword );
+        SqlQuery += L"CONSTRAINT PK_Summary_Domains PRIMARY KEY( Domain_Name ) )";
+        pStatements->Add( SqlQuery );
+    }
+
+    // One row, Is_Stale is set when an export could not adjust the counts
+    if ( Tables.IndexOf( L"Summary_Status", false ) == PXS_MINUS_ONE )
+    {
+        SqlQuery  = L"CREATE TABLE Summary_Status( ";
+        SqlQuery += Format.String1( L"Status_ID %%1 NOT NULL, ", IntegerKeyword );
+        SqlQuery += Format.String1( L"Is_Stale %%1 NOT NULL, ", IntegerKeyword );
+        SqlQuery += L"CONSTRAINT PK_Summary_Status PRIMARY KEY( Status_ID ) )";
+        pStatements->Add( SqlQuery );
+
+        SqlQuery  = L"INSERT INTO Summary_Status ( Status_ID, Is_Stale ) VALUES ( 1, ";
+        SqlQuery += ( stale ? L"1 )" : L"0 )" );
+        pStatements->Add( SqlQuery );
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Add the SQL statements to create the PostgreSQL and SQL Server GRANTs
+//      on the report summary tables to the Statements array
+//
+//  Parameters:
+//      pStatements - receives the  data definition queries
+//
+//  Remarks:
+//      Exports adjust the counts and may mark them stale
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DatabaseAdministrationDialog::AddSummaryGrants( StringArray* pStatements ) const
+{
+    String    SqlQuery, Schema;
+    Formatter Format;
+
+    if ( pStatements == nullptr )
+    {
+        throw ParameterException( L"pStatements", __FUNCTION__ );
+    }
+    GetGrantSchema( &Schema );
+
+    SqlQuery = Format.String1( L"GRANT SELECT, INSERT, UPDATE, DELETE "
+                               L"ON %%1[Summary_Software] TO PUBLIC", Schema );
+    pStatements->Add( SqlQuery );
+
+    SqlQuery = Format.String1( L"GRANT SELECT, INSERT, UPDATE, DELETE "
+                               L"ON %%1[Summary_Errors] TO PUBLIC", Schema );
+    pStatements->Add( SqlQuery );
+
+    SqlQuery = Format.String1( L"GRANT SELECT, INSERT, UPDATE, DELETE "
+                               L"ON %%1[Summary_Domains] TO PUBLIC", Schema );
+    pStatements->Add( SqlQuery );
+
+    SqlQuery = Format.String1( L"GRANT SELECT, UPDATE ON %%1[Summary_Status] TO PUBLIC", Schema );
+    pStatements->Add( SqlQuery );
+}
+
 //===============================================================================================//
 //  Description:
 //      Add the SQL statements to create the views to the Statements array
@@ -1506,6 +1890,25 @@ void DatabaseAdministrationDialog::ConnectDB( bool serverOnly )
     // Store the user's choices at class scope
     m_Settings.ServerName = m_AuditDatabase.GetServerName();
     m_Settings.UID        = m_AuditDatabase.GetUserName();
+
+    // Without usable summary tables the reports are computed live. Older
+    // databases are upgraded by the rebuild button, not here.
+    m_bHasSummaryTables = false;
+    if ( serverOnly == false )
+    {
+        try
+        {
+            if ( m_AuditDatabase.HasSummaryTables() &&
+                 ( m_AuditDatabase.IsSummaryStale() == false ) )
+            {
+                m_bHasSummaryTables = true;
+            }
+        }
+        catch ( const Exception& e )
+        {
+            PXSLogException( L"Failed to check the report summary tables.", e, __FUNCTION__ );
+        }
+    }
 }
 
 //===============================================================================================//
@@ -1525,7 +1928,7 @@ void DatabaseAdministrationDialog::CreateAccessDatabase()
     String TimestampKeyword, VarCharKeyword, WCharKeyword, WVarCharKeyword;
     String TCharKeyword, VarTCharKeyword, ProviderID, SqlQuery;
     String SchemaName, UserName, Password, ProgressMessage;
-    StringArray Statements;
+    StringArray Statements, NoTables;
     AccessDatabase Access;
 
     // Must have an extension as this determines the OLEDB driver
@@ -1559,6 +1962,7 @@ void DatabaseAdministrationDialog::CreateAccessDatabase()
                              TimestampKeyword, VarCharKeyword, VarTCharKeyword, &Statements );
     AddCreateAuditDataSql( IntegerKeyword, TCharKeyword, VarTCharKeyword, &Statements );
     AddCreateDisplayNamesSql( IntegerKeyword, VarTCharKeyword, &Statements );
+    AddCreateSummarySql( IntegerKeyword, VarTCharKeyword, NoTables, false, &Statements );
     AddCreateAccessProcedures( &Statements );
     AddCreateViews( SchemaName, &Statements );
 
@@ -1658,7 +2062,7 @@ void DatabaseAdministrationDialog::CreateServerDatabase()
     String TCharKeyword, VarTCharKeyword, SqlQuery, UserName, SchemaName;
     String ProgressMessage;
     Formatter   Format;
-    StringArray Statements;
+    StringArray Statements, NoTables;
 
     ConnectDB( true );  // Server connect only
     GetDatabaseSpecificKeywords( &AutoIncrementKeyword,
@@ -1725,6 +2129,7 @@ void DatabaseAdministrationDialog::CreateServerDatabase()
                              TimestampKeyword, VarCharKeyword, VarTCharKeyword, &Statements );
     AddCreateAuditDataSql( IntegerKeyword, TCharKeyword, VarTCharKeyword, &Statements );
     AddCreateDisplayNamesSql( IntegerKeyword, VarTCharKeyword, &Statements );
+    AddCreateSummarySql( IntegerKeyword, VarTCharKeyword, NoTables, false, &Statements );
 
     // Views
     AddCreateViews( SchemaName, &Statements );
@@ -1768,6 +2173,8 @@ void DatabaseAdministrationDialog::CreateServerDatabase()
             m_ProgressBar.SetPercentage( percentage );
         }
         m_AuditDatabase.CommitTrans();
+        m_AuditDatabase.ClearSchemaCache();
+        m_bHasSummaryTables = true;
         m_ProgressBar.SetPercentage( 100 );
     }
     catch ( const Exception& )
@@ -1782,22 +2189,27 @@ void DatabaseAdministrationDialog::CreateServerDatabase()
 
 //===============================================================================================//
 //  Description:
-//      Delete the old audits, i.e. preserve the most recent audit for each
+//      Delete the old audits, i.e. preserve the most recent audits for each
 //      computer in the database
 //
 //  Parameters:
 //      None
 //
+//  Remarks:
+//      The retention policy is in the configuration settings. The deletes
+//      are done in batches, each in its own transaction, so an interrupted
+//      purge keeps what it has done and can be run again.
+//
 //  Returns:
 //      void
 //===============================================================================================//
 void DatabaseAdministrationDialog::DeleteOldAudits()
 {
-    String ApplicationName, SqlQuery, SqlDelete, ComputerID, MaxOfAuditID;
-    String Text, ProgressMessage;
-    Formatter     Format;
-    OdbcRecordSet RecordSet;
-    StringArray DeleteStatements;
+    size_t     numOldAudits = 0, numDeleted = 0, totalDeleted = 0;
+    DWORD      percentage   = 0;
+    String     ApplicationName, Text, ProgressMessage;
+    Formatter  Format;
+    SQLINTEGER lastAuditID  = 0;
 
     // Make sure the controls have been created
     if ( m_bControlsCreated == false ) return;
@@ -1813,35 +2225,13 @@ void DatabaseAdministrationDialog::DeleteOldAudits()
     }
     PXSLogAppInfo( L"Deleteing old audits." );
 
-    // Get the maximum audit ID for each computer that has more than one audit
-    // in the database
+    // Is there anything to do?
     ConnectDB( false );
     WaitCursor Wait;
-    SqlQuery  = L"SELECT Audit_Master.Computer_ID, "
-                L"MAX(Audit_Master.Audit_ID) AS MaxOfAudit_ID "
-                L"FROM Audit_Master "
-                L"GROUP BY Audit_Master.Computer_ID "
-                L"HAVING ( ( ( COUNT(Audit_Master.Audit_ID) )>1 ) );";
-    RecordSet.Open( SqlQuery, &m_AuditDatabase );
-    while ( RecordSet.MoveNext() )
-    {
-        ComputerID   = RecordSet.FieldValue( 0 );
-        MaxOfAuditID = RecordSet.FieldValue( 1 );
-        if ( ComputerID.GetLength() && MaxOfAuditID.GetLength() )
-        {
-            SqlDelete  = L"Delete FROM Audit_Master WHERE Computer_ID=";
-            SqlDelete += ComputerID;
-            SqlDelete += L" AND Audit_ID< ";
-            SqlDelete += MaxOfAuditID;
-            DeleteStatements.Add( SqlDelete );
-        }
-    }
-    RecordSet.Close();
-
-    // Is there anything to do?
-    size_t numStatements = DeleteStatements.GetSize();
-    PXSLogAppInfo1( L"Found old audits for %%1 computers.", Format.SizeT(  numStatements ) );
-    if ( numStatements == 0 )
+    numOldAudits = m_AuditDatabase.CountOldAudits( m_Settings.retainAuditCount,
+                                                   m_Settings.retainAuditDays );
+    PXSLogAppInfo1( L"Found %%1 old audits.", Format.SizeT( numOldAudits ) );
+    if ( numOldAudits == 0 )
     {
         PXSGetResourceString( PXS_IDS_1241_NO_OLD_AUDITS, &Text );
         MessageBox( m_hWindow, Text.c_str(), ApplicationName.c_str(), MB_OK | MB_ICONINFORMATION );
@@ -1849,31 +2239,225 @@ void DatabaseAdministrationDialog::DeleteOldAudits()
     }
 
     // Do the deletes
-    m_AuditDatabase.BeginTrans();
     try
     {
         m_ProgressBar.SetPercentage( 0 );
         m_ProgressBar.SetVisible( true );
-        for ( size_t i = 0; i < numStatements; i++ )
+        do
         {
-            DWORD percentage = PXSCastSizeTToUInt32( ( i * 100 ) / numStatements );
+            numDeleted = m_AuditDatabase.DeleteOldAuditsBatch( m_Settings.retainAuditCount,
+                                                               m_Settings.retainAuditDays,
+                                                               m_Settings.purgeBatchSize,
+                                                               &lastAuditID );
+            totalDeleted = PXSAddSizeT( totalDeleted, numDeleted );
+            percentage   = PXSCastSizeTToUInt32( ( totalDeleted * 100 ) / numOldAudits );
+            if ( percentage > 100 )
+            {
+                percentage = 100;   // New audits may have aged out since the count
+            }
             m_ProgressBar.SetPercentage( percentage );
-            SqlDelete = DeleteStatements.Get( i );
-            m_AuditDatabase.ExecuteTrans( SqlDelete, PXS_SQLLEN_MAX );
-        }
+        } while ( numDeleted );
     }
     catch ( const Exception& )
     {
         m_ProgressBar.SetVisible( false );
-        m_AuditDatabase.RollbackTrans();
+        PXSLogAppInfo1( L"Deleted %%1 old audits before the error.", Format.SizeT( totalDeleted ) );
         throw;
     }
-    m_AuditDatabase.CommitTrans();
     m_ProgressBar.SetVisible( false );
+    PXSLogAppInfo1( L"Deleted %%1 old audits.", Format.SizeT( totalDeleted ) );
     PXSGetResourceString( PXS_IDS_1242_DELETED_OLD_AUDITS, &ProgressMessage );
     SetProgressMessage( ProgressMessage );
 }
 
+//===============================================================================================//
+//  Description:
+//      Get the definitions of the normalised key columns of the
+//      Computer_Master table
+//
+//  Parameters:
+//      VarCharKeyword - the database specific SQL_VARCHAR keyword
+//      pDefinitions   - receives the column definitions
+//
+//  Remarks:
+//      Each holds the trimmed, upper case value of an identifying column so
+//      is the same size as that column.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DatabaseAdministrationDialog::GetComputerMasterKeyColumns( const String& VarCharKeyword,
+                                                                StringArray* pDefinitions )
+{
+    Formatter Format;
+
+    if ( pDefinitions == nullptr )
+    {
+        throw ParameterException( L"pDefinitions", __FUNCTION__ );
+    }
+    pDefinitions->RemoveAll();
+
+    pDefinitions->Add( Format.String1( L"Key_WinAudit_GUID %%1( 40 ) NULL" , VarCharKeyword ) );
+    pDefinitions->Add( Format.String1( L"Key_FQDN %%1( 252 ) NULL"         , VarCharKeyword ) );
+    pDefinitions->Add( Format.String1( L"Key_Smbios_UUID %%1( 40 ) NULL"   , VarCharKeyword ) );
+    pDefinitions->Add( Format.String1( L"Key_Asset_Tag %%1( 24 ) NULL"     , VarCharKeyword ) );
+    pDefinitions->Add( Format.String1( L"Key_MAC_Address %%1( 24 ) NULL"   , VarCharKeyword ) );
+    pDefinitions->Add( Format.String1( L"Key_OS_Product_ID %%1( 32 ) NULL" , VarCharKeyword ) );
+    pDefinitions->Add( Format.String1( L"Key_Computer_Name %%1( 64 ) NULL" , VarCharKeyword ) );
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the statements still needed to give the Computer_Master table
+//      the normalised key columns
+//
+//  Parameters:
+//      pColumnStatements - receives the statements to add missing columns
+//      pIndexStatements  - receives the statements to add missing indexes
+//      pBackfillSql      - receives the statement to fill the Key_ columns of
+//                          the rows that have none, empty if there are none
+//
+//  Remarks:
+//      Looks at what is in the database rather than a version number so an
+//      upgrade that was interrupted carries on from where it stopped.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DatabaseAdministrationDialog::GetComputerMasterUpgrade( StringArray* pColumnStatements,
+                                                             StringArray* pIndexStatements,
+                                                             String* pBackfillSql )
+{
+    const  size_t CREATE_INDEX_LEN = 13;    // = "CREATE INDEX "
+    size_t i = 0, idxTable = 0, idxSpace = 0, numIndexes = 0;
+    String AutoIncrementKeyword, CharKeyword, SmallIntKeyword, IntegerKeyword;
+    String TimestampKeyword, VarCharKeyword, WCharKeyword, WVarCharKeyword;
+    String UpperKeyword, AddKeyword, TableName, IndexName, Statement, Predicate, SqlQuery;
+    Formatter   Format;
+    SQLINTEGER  pending = 0;
+    StringArray Columns, KeyColumns, Tables, Indexes, AllIndexes;
+
+    if ( ( pColumnStatements == nullptr ) ||
+         ( pIndexStatements  == nullptr ) ||
+         ( pBackfillSql      == nullptr )  )
+    {
+        throw ParameterException( L"pColumnStatements", __FUNCTION__ );
+    }
+    pColumnStatements->RemoveAll();
+    pIndexStatements->RemoveAll();
+    *pBackfillSql = PXS_STRING_EMPTY;
+
+    // Columns
+    m_AuditDatabase.GetTableColumns( L"Computer_Master", &Columns );
+    for ( i = 0; i < AuditDatabase::NUM_KEYS; i++ )
+    {
+        if ( Columns.IndexOf( AuditDatabase::GetKeyColumnName( i, true ),
+                              false ) == PXS_MINUS_ONE )
+        {
+            if ( KeyColumns.GetSize() == 0 )
+            {
+                GetDatabaseSpecificKeywords( &AutoIncrementKeyword,
+                                             &CharKeyword,
+                                             &IntegerKeyword,
+                                             &SmallIntKeyword,
+                                             &TimestampKeyword,
+                                             &VarCharKeyword, &WCharKeyword, &WVarCharKeyword );
+                GetComputerMasterKeyColumns( VarCharKeyword, &KeyColumns );
+
+                // SQL Server does not accept the optional COLUMN keyword
+                AddKeyword = L"ADD COLUMN";
+                if ( m_Settings.DBMS.CompareI( PXS_DBMS_NAME_SQL_SERVER ) == 0 )
+                {
+                    AddKeyword = L"ADD";
+                }
+            }
+            SqlQuery  = L"ALTER TABLE Computer_Master ";
+            SqlQuery += AddKeyword;
+            SqlQuery += L" ";
+            SqlQuery += KeyColumns.Get( i );
+            pColumnStatements->Add( SqlQuery );
+        }
+    }
+
+    // Indexes, the catalogue wants the table name as the database stored it
+    TableName = L"Computer_Master";
+    m_AuditDatabase.GetTables( true, false, false, &Tables );
+    idxTable = Tables.IndexOf( TableName.c_str(), false );
+    if ( idxTable != PXS_MINUS_ONE )
+    {
+        TableName = Tables.Get( idxTable );
+    }
+    m_AuditDatabase.GetIndexes( TableName, &Indexes );
+    AddCreateComputerMasterKeyIndexes( &AllIndexes );
+    numIndexes = AllIndexes.GetSize();
+    for ( i = 0; i < numIndexes; i++ )
+    {
+        Statement = AllIndexes.Get( i );
+        idxSpace  = Statement.IndexOf( ' ', CREATE_INDEX_LEN );
+        if ( idxSpace == PXS_MINUS_ONE )
+        {
+            throw FunctionException( L"idxSpace", __FUNCTION__ );
+        }
+        Statement.SubString( CREATE_INDEX_LEN, idxSpace - CREATE_INDEX_LEN, &IndexName );
+        if ( Indexes.IndexOf( IndexName.c_str(), false ) == PXS_MINUS_ONE )
+        {
+            pIndexStatements->Add( Statement );
+        }
+    }
+
+    // Rows that have none of the Key_ values but have a value to make one
+    // from, a single statement so it either fills all of them or none
+    Predicate.Allocate( 1024 );
+    Predicate = L"(";
+    for ( i = 0; i < AuditDatabase::NUM_KEYS; i++ )
+    {
+        if ( i )
+        {
+            Predicate += L" AND";
+        }
+        Predicate += Format.String1( L" %%1 IS NULL",
+                                     AuditDatabase::GetKeyColumnName( i, true ) );
+    }
+    Predicate += L" ) AND (";
+    for ( i = 0; i < AuditDatabase::NUM_KEYS; i++ )
+    {
+        if ( i )
+        {
+            Predicate += L" OR";
+        }
+        Predicate += Format.String1( L" %%1 IS NOT NULL",
+                                     AuditDatabase::GetKeyColumnName( i, false ) );
+    }
+    Predicate += L" )";
+
+    if ( pColumnStatements->GetSize() == 0 )
+    {
+        SqlQuery  = L"SELECT COUNT(*) FROM Computer_Master WHERE ";
+        SqlQuery += Predicate;
+        m_AuditDatabase.ExecuteSelectSqlInteger( SqlQuery, &pending );
+    }
+
+    if ( pColumnStatements->GetSize() || ( pending > 0 ) )
+    {
+        m_AuditDatabase.GetDbKeyWord( PXS_KEYWORD_UPPER, &UpperKeyword );
+        pBackfillSql->Allocate( 2048 );
+        *pBackfillSql = L"UPDATE Computer_Master SET ";
+        for ( i = 0; i < AuditDatabase::NUM_KEYS; i++ )
+        {
+            if ( i )
+            {
+                *pBackfillSql += L", ";
+            }
+            *pBackfillSql += AuditDatabase::GetKeyColumnName( i, true );
+            *pBackfillSql += Format.String2( L" = %%1(%%2)",
+                                             UpperKeyword,
+                                             AuditDatabase::GetKeyColumnName( i, false ) );
+        }
+        *pBackfillSql += L" WHERE ";
+        *pBackfillSql += Predicate;
+    }
+}
+
 //===============================================================================================//
 //  Description:
 //      Get the SQL keywords used by the database
@@ -1978,6 +2562,35 @@ void DatabaseAdministrationDialog::GetDatabaseSpecificKeywords(
     PXSLogAppInfo1( L"AQL_WVARCHAR      : '%%1'", *pWVarCharKeyword );
 }
 
+//===============================================================================================//
+//  Description:
+//      Get the schema prefix used in GRANT statements
+//
+//  Parameters:
+//      pSchema - receives the schema followed by a dot, empty if none
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DatabaseAdministrationDialog::GetGrantSchema( String* pSchema ) const
+{
+    String    UserName;
+    Formatter Format;
+
+    if ( pSchema == nullptr )
+    {
+        throw ParameterException( L"pSchema", __FUNCTION__ );
+    }
+    *pSchema = PXS_STRING_EMPTY;
+
+    // CREATE ROLE is new for SQL Server 2005.
+    UserName = m_AuditDatabase.GetUserName();
+    if ( UserName.GetLength() )
+    {
+        *pSchema = Format.String1( L"[%%1].", UserName );
+    }
+}
+
 //===============================================================================================//
 //  Description:
 //      Make the sql statement for the specified report
@@ -1986,6 +2599,10 @@ void DatabaseAdministrationDialog::GetDatabaseSpecificKeywords(
 //      UpperKeyword - the database specific UPPER keyword, can be empty
 //      pSqlQuery    - receives the  SQL statement
 //
+//  Remarks:
+//      The counts of computers by domain, errors and software are read from
+//      the summary tables if the database has them.
+//
 //  Returns:
 //      void
 //===============================================================================================//
@@ -2036,6 +2653,13 @@ void DatabaseAdministrationDialog::MakeReportSql( const String& UpperKeyword,
 
         case 2:
             // Counts of Computers by Domain/Workgroup
+            if ( m_bHasSummaryTables )
+            {
+                Sql = L"SELECT Domain_Name, Computer_Count \r\n"
+                      L"FROM Summary_Domains \r\n"
+                      L"ORDER BY Domain_Name";
+                break;
+            }
             Sql = L"SELECT %%1( Computer_Master.Domain_Name ) AS "
                   L"Domain_Name, COUNT( Computer_Master.Computer_Name ) AS "
                   L"Computer_Count \r\n"
@@ -2046,6 +2670,13 @@ void DatabaseAdministrationDialog::MakeReportSql( const String& UpperKeyword,
 
         case 3:
             // Counts of Errors by Type
+            if ( m_bHasSummaryTables )
+            {
+                Sql = L"SELECT Error_Type, Error_Count \r\n"
+                      L"FROM Summary_Errors \r\n"
+                      L"ORDER BY Error_Type";
+                break;
+            }
             Sql = L"SELECT %%1( Audit_Data.Item_3 ) As Error_Type, "
                   L"COUNT( Audit_Data.Item_3 ) AS Error_Count \r\n"
                   L"FROM Computer_Master INNER JOIN Audit_Data ON "
@@ -2057,6 +2688,13 @@ void DatabaseAdministrationDialog::MakeReportSql( const String& UpperKeyword,
 
         case 4:
             // Counts of Installed Software Products
+            if ( m_bHasSummaryTables )
+            {
+                Sql = L"SELECT Software_Name, Installed_Count \r\n"
+                      L"FROM Summary_Software \r\n"
+                      L"ORDER BY Software_Name";
+                break;
+            }
             Sql = L"SELECT %%1( Audit_Data.Item_1 ) As Software_Name, "
                   L"COUNT( Audit_Data.Item_1 ) AS Installed_Count \r\n"
                   L"FROM Computer_Master INNER JOIN Audit_Data ON "
@@ -2208,6 +2846,41 @@ void DatabaseAdministrationDialog::MakeReportSql( const String& UpperKeyword,
     *pSqlQuery = Sql;
 }
 
+//===============================================================================================//
+//  Description:
+//      Regenerate the report summary tables from scratch
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      This is where a database made by an older version gets the Key_
+//      columns and the summary tables, connecting never changes the schema.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DatabaseAdministrationDialog::RebuildSummaries()
+{
+    String ProgressMessage;
+
+    // Make sure the controls have been created
+    if ( m_bControlsCreated == false ) return;
+
+    ProgressMessage = PXS_STRING_EMPTY;
+    SetProgressMessage( ProgressMessage );
+    ConnectDB( false );
+    UpgradeComputerMaster();
+    UpgradeSummaryTables();
+
+    WaitCursor Wait;
+    m_bHasSummaryTables = false;
+    m_AuditDatabase.RebuildSummaryTables();
+    m_bHasSummaryTables = true;
+    ProgressMessage = L"Rebuilt the report summaries.";
+    SetProgressMessage( ProgressMessage );
+}
+
 //===============================================================================================//
 //  Description:
 //      Run the selected report
@@ -2407,6 +3080,147 @@ void DatabaseAdministrationDialog::RunReport()
     ReportDialog.Create( m_hWindow );
 }
 
+//===============================================================================================//
+//  Description:
+//      Add the normalised key columns and their indexes to a Computer_Master
+//      table that was created without them
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      The new columns are filled from the existing rows. The values were
+//      trimmed when they were stored so only need to be made upper case.
+//
+//      Each statement is run on its own as some databases will not do data
+//      definition in a transaction. Only what is missing is done so if
+//      interrupted it can be run again. The fill comes last, rows without
+//      keys mean the upgrade did not finish.
+//
+//      As when creating, the GRANTs are only made if GRANT PUBLIC is ticked.
+//      They come before the indexes so if an index is missing they are made
+//      again.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DatabaseAdministrationDialog::UpgradeComputerMaster()
+{
+    size_t i = 0, numStatements = 0;
+    String SqlQuery, BackfillSql;
+    StringArray ColumnStatements, IndexStatements, Statements;
+
+    GetComputerMasterUpgrade( &ColumnStatements, &IndexStatements, &BackfillSql );
+    if ( ( ColumnStatements.GetSize() == 0 ) &&
+         ( IndexStatements.GetSize()  == 0 ) && BackfillSql.IsEmpty() )
+    {
+        return;     // Nothing to do
+    }
+    PXSLogAppInfo( L"Upgrading the Computer_Master table." );
+
+    Statements.AddArray( ColumnStatements );
+    if ( ( m_GrantPublicCheckBox.GetState() ) &&
+         ( ( m_Settings.DBMS.CompareI( PXS_DBMS_NAME_POSTGRE_SQL ) == 0 ) ||
+           ( m_Settings.DBMS.CompareI( PXS_DBMS_NAME_SQL_SERVER  ) == 0 )  ) )
+    {
+        AddComputerMasterGrants( &Statements );
+    }
+    Statements.AddArray( IndexStatements );
+    if ( BackfillSql.GetLength() )
+    {
+        Statements.Add( BackfillSql );
+    }
+
+    WaitCursor Cursor;
+    try
+    {
+        numStatements = Statements.GetSize();
+        for ( i = 0; i < numStatements; i++ )
+        {
+            SqlQuery = Statements.Get( i );
+            m_AuditDatabase.ExecuteDirect( SqlQuery );
+        }
+    }
+    catch ( const Exception& )
+    {
+        m_AuditDatabase.ClearSchemaCache();
+        throw;
+    }
+    m_AuditDatabase.ClearSchemaCache();
+    PXSLogAppInfo( L"Upgraded the Computer_Master table." );
+}
+
+//===============================================================================================//
+//  Description:
+//      Add the report summary tables that are missing from a database
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      Each table is created on its own as some databases will not do data
+//      definition in a transaction. A table that exists is left alone so if
+//      interrupted it can be run again. The summaries are marked stale until
+//      the caller rebuilds them. As when creating, the GRANTs are only made
+//      if GRANT PUBLIC is ticked.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DatabaseAdministrationDialog::UpgradeSummaryTables()
+{
+    size_t i = 0, numStatements = 0;
+    String AutoIncrementKeyword, CharKeyword, SmallIntKeyword, IntegerKeyword;
+    String TimestampKeyword, VarCharKeyword, WCharKeyword, WVarCharKeyword;
+    String VarTCharKeyword, SqlQuery;
+    StringArray Tables, Statements;
+
+    if ( m_AuditDatabase.HasSummaryTables() )
+    {
+        return;     // Nothing to do
+    }
+    PXSLogAppInfo( L"Adding the report summary tables." );
+
+    GetDatabaseSpecificKeywords( &AutoIncrementKeyword,
+                                 &CharKeyword,
+                                 &IntegerKeyword,
+                                 &SmallIntKeyword,
+                                 &TimestampKeyword,
+                                 &VarCharKeyword, &WCharKeyword, &WVarCharKeyword );
+    // MySql ODBC says "" for SQL_WVARCHAR
+    VarTCharKeyword = WVarCharKeyword;
+    if ( VarTCharKeyword.IsEmpty() )
+    {
+        VarTCharKeyword = VarCharKeyword;
+    }
+    m_AuditDatabase.GetTables( true, false, false, &Tables );
+    AddCreateSummarySql( IntegerKeyword, VarTCharKeyword, Tables, true, &Statements );
+    if ( ( m_GrantPublicCheckBox.GetState() ) &&
+         ( ( m_Settings.DBMS.CompareI( PXS_DBMS_NAME_POSTGRE_SQL ) == 0 ) ||
+           ( m_Settings.DBMS.CompareI( PXS_DBMS_NAME_SQL_SERVER  ) == 0 )  ) )
+    {
+        AddSummaryGrants( &Statements );
+    }
+
+    WaitCursor Cursor;
+    try
+    {
+        numStatements = Statements.GetSize();
+        for ( i = 0; i < numStatements; i++ )
+        {
+            SqlQuery = Statements.Get( i );
+            m_AuditDatabase.ExecuteDirect( SqlQuery );
+        }
+    }
+    catch ( const Exception& )
+    {
+        m_AuditDatabase.ClearSchemaCache();
+        throw;
+    }
+    m_AuditDatabase.ClearSchemaCache();
+    PXSLogAppInfo( L"Added the report summary tables." );
+}
+
 //===============================================================================================//
 //  Description:
 //      Put the control values in the configuration
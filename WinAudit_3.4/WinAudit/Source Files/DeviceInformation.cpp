@@ -59,8 +59,11 @@
 
 // Default constructor
 DeviceInformation::DeviceInformation()
-                  :m_uLastDeviceTypeIndex( DWORD_MAX ),     // -1
-                   m_DeviceTypes(),
+                  :m_uNumDevices( 0 ),
+                   m_StringPool(),
+                   m_PoolIndex(),
+                   m_ClassGuids(),
+                   m_ClassTypes(),
                    m_Devices()
 {
 }
@@ -102,8 +105,11 @@ DeviceInformation::~DeviceInformation()
 //===============================================================================================//
 void DeviceInformation::GetAuditRecords( TArray< AuditRecord >* pRecords )
 {
-    String DeviceType;
-    TArray< AuditRecord > DeviceRecords;
+    size_t      i = 0, numRecords = 0;
+    LPCWSTR     pszDeviceType = nullptr;
+    String      Value;
+    Formatter   Format;
+    AuditRecord Record;
 
     if ( pRecords == nullptr )
     {
@@ -111,14 +117,50 @@ void DeviceInformation::GetAuditRecords( TArray< AuditRecord >* pRecords )
     }
     pRecords->RemoveAll();
 
-
     FillData();
-    while ( GetNextDeviceType( &DeviceType , &DeviceRecords ) )
+    if ( m_uNumDevices == 0 )
+    {
+        return;
+    }
+
+    // Size the array once, records are swapped in rather than copied
+    pRecords->SetSize( m_uNumDevices );
+    for ( i = 0; i < m_uNumDevices; i++ )
     {
-        pRecords->Append( DeviceRecords );
-        DeviceType = PXS_STRING_EMPTY;
-        DeviceRecords.RemoveAll();
-    };
+        const TYPE_DEVICE_INFO& Device = m_Devices.Get( i );
+
+        // Devices of a class without a description have never been listed
+        pszDeviceType = m_StringPool.Get( m_ClassTypes.Get( Device.idxClass ) );
+        if ( ( pszDeviceType == nullptr ) || ( *pszDeviceType == PXS_CHAR_NULL ) )
+        {
+            continue;
+        }
+
+        Record.Reset( PXS_CATEGORY_HARDWARE_DEVICES );
+        Record.Add( PXS_HARDWARE_DEVS_DEVICE_TYPE , pszDeviceType );
+        Record.Add( PXS_HARDWARE_DEVS_DEVICE_NAME , m_StringPool.Get( Device.idxDeviceName ) );
+        Record.Add( PXS_HARDWARE_DEVS_DESCRIPTION , m_StringPool.Get( Device.idxDescription ) );
+        Record.Add( PXS_HARDWARE_DEVS_MANUFACTURER, m_StringPool.Get( Device.idxManufacturer ) );
+        Record.Add( PXS_HARDWARE_DEVS_LOCATION    , m_StringPool.Get( Device.idxLocation ) );
+        Record.Add( PXS_HARDWARE_DEVS_DRIVER_PROV , m_StringPool.Get( Device.idxDriverProvider ) );
+        Record.Add( PXS_HARDWARE_DEVS_DRIVER_VER  , m_StringPool.Get( Device.idxDriverVersion ) );
+        Record.Add( PXS_HARDWARE_DEVS_DRIVER_DATE , m_StringPool.Get( Device.idxDriverDate ) );
+
+        Value = Format.UInt32( Device.statusCode );
+        Record.Add( PXS_HARDWARE_DEVS_STATUS_CODE, Value );
+
+        Record.Add( PXS_HARDWARE_DEVS_STATUS_MSG, m_StringPool.Get( Device.idxStatusMsg ) );
+
+        Value = Format.GuidToString( m_ClassGuids.Get( Device.idxClass ) );
+        Record.Add( PXS_HARDWARE_DEVS_CLASS_GUID, Value );
+
+        Record.Add( PXS_HARDWARE_DEVS_DEVICE_ID, m_StringPool.Get( Device.idxDeviceID ) );
+        pRecords->GetPtr( numRecords )->Swap( Record );
+        numRecords++;
+    }
+    pRecords->SetSize( numRecords );
+
+    // One stable sort groups the devices by type in enumeration order
     PXSSortAuditRecords( pRecords, PXS_HARDWARE_DEVS_DEVICE_TYPE );
 }
 
@@ -132,18 +174,19 @@ void DeviceInformation::GetAuditRecords( TArray< AuditRecord >* pRecords )
 
 //===============================================================================================//
 //  Description:
-//      Discover all the installed devices and fill the class scope pointer
-//      list.
+//      Discover all the installed devices and fill the class scope device
+//      array in one pass.
 //
 //  Parameters:
 //      None
 //
 //  Remarks:
-//      Fills an alphabetically sorted array of device types for
-//      later enumeration by GetNextDeviceType
-//
 //      Both Plug-and-Play and Legacy/Hidden devices can be detected
 //
+//      Devices are bucketed by class GUID so each class description is
+//      read once. The strings are pooled as many devices share the same
+//      manufacturer, driver provider, version and date.
+//
 //      Will avoid SetupDiClassGuidsFromName as names change and the
 //      system may not have all relevant names. SetupDiClassGuidsFromName
 //      function retrieves the GUID(s) associated with the specified class
@@ -157,12 +200,21 @@ size_t DeviceInformation::FillData()
 {
     GUID       guidZero;
     DWORD      requiredSize = 0;
+    wchar_t    szStatusMsg[ 128 ]      = { 0 };
+    wchar_t    szDriverProvider[ 64 ]  = { 0 };
+    wchar_t    szDriverVersion[ 64 ]   = { 0 };
+    wchar_t    szDriverDate[ 64 ]      = { 0 };
+    wchar_t    szDeviceID[ 128 ]       = { 0 };
+    Registry   RegObject;
     HDEVINFO   hDevInfo = nullptr;
     SP_DEVINFO_DATA  DeviceInfoData;
     TYPE_DEVICE_INFO DeviceInfo;
 
     Reset();
 
+    // One connection for all the driver lookups
+    RegObject.Connect( HKEY_LOCAL_MACHINE );
+
     // Create a HDEVINFO with all present devices.
     hDevInfo = SetupDiGetClassDevs( nullptr,
                                     nullptr,    // Enumerator
@@ -176,6 +228,7 @@ size_t DeviceInformation::FillData()
     try
     {
         // Enumerate through all devices
+        memset( &guidZero, 0, sizeof ( guidZero ) );    // i.e all zeros
         memset( &DeviceInfoData, 0, sizeof ( DeviceInfoData ) );
         DeviceInfoData.cbSize = sizeof ( DeviceInfoData );
         DWORD memberIndex     = 0;
@@ -184,95 +237,68 @@ size_t DeviceInformation::FillData()
             memberIndex++;
 
             // GUID can be zero, so filter those out
-            memset( &guidZero, 0, sizeof ( guidZero ) );    // i.e all zeros
             if ( memcmp( &guidZero,
                          &DeviceInfoData.ClassGuid, sizeof ( guidZero ) ) )
             {
                 memset( &DeviceInfo, 0, sizeof ( DeviceInfo ) );
 
-                // GUID
-                DeviceInfo.ClassGuid = DeviceInfoData.ClassGuid;
+                // Class, i.e. the device type
+                DeviceInfo.idxClass = GetClassIndex( DeviceInfoData.ClassGuid );
 
                 // Get the status of the device
                 GetDeviceStatus( DeviceInfoData.DevInst,
-                                 &DeviceInfo.ClassGuid,
+                                 &DeviceInfoData.ClassGuid,
                                  &DeviceInfo.statusCode,
-                                 DeviceInfo.szStatusMsg, ARRAYSIZE( DeviceInfo.szStatusMsg ) );
-
-                // Class Description / Device Type.
-                SetupDiGetClassDescription( &DeviceInfoData.ClassGuid,
-                                            DeviceInfo.szDeviceType,
-                                            ARRAYSIZE(DeviceInfo.szDeviceType),
-                                            nullptr );
-                DeviceInfo.szDeviceType[ ARRAYSIZE(DeviceInfo.szDeviceType) - 1 ] = PXS_CHAR_NULL;
-                m_DeviceTypes.AddUniqueI( DeviceInfo.szDeviceType );
-
-                // Friendly name
-                SetupDiGetDeviceRegistryProperty(hDevInfo,
-                                                 &DeviceInfoData,
-                                                 SPDRP_FRIENDLYNAME,
-                                                 nullptr,
-                                                 reinterpret_cast<BYTE*>(&DeviceInfo.szDeviceName),
-                                                 sizeof ( DeviceInfo.szDeviceName ),
-                                                 nullptr );
-                DeviceInfo.szDeviceName[
-                      ARRAYSIZE( DeviceInfo.szDeviceName ) -1 ] = PXS_CHAR_NULL;
-
-                // Device description
-                SetupDiGetDeviceRegistryProperty(
-                                              hDevInfo,
-                                              &DeviceInfoData,
-                                              SPDRP_DEVICEDESC,
-                                              nullptr,
-                                              reinterpret_cast<BYTE*>( &DeviceInfo.szDescription ),
-                                              sizeof ( DeviceInfo.szDescription ),  // Bytes
-                                              nullptr );
-                DeviceInfo.szDescription[ ARRAYSIZE(DeviceInfo.szDescription)-1 ] = PXS_CHAR_NULL;
-
-                // Device manufacturer
-                SetupDiGetDeviceRegistryProperty(
-                                              hDevInfo,
-                                              &DeviceInfoData,
-                                              SPDRP_MFG,
-                                              nullptr,
-                                              reinterpret_cast<BYTE*>(&DeviceInfo.szManufacturer),
-                                              sizeof ( DeviceInfo.szManufacturer ),  // Bytes
-                                              nullptr );
-                DeviceInfo.szManufacturer[
-                                      ARRAYSIZE( DeviceInfo.szManufacturer ) - 1 ] = PXS_CHAR_NULL;
-
-                // Device location
-                SetupDiGetDeviceRegistryProperty( hDevInfo,
-                                                  &DeviceInfoData,
-                                                  SPDRP_LOCATION_INFORMATION,
-                                                  nullptr,
-                                                  reinterpret_cast<BYTE*>(&DeviceInfo.szLocation),
-                                                  sizeof ( DeviceInfo.szLocation ),  // Bytes
-                                                  nullptr );
-                DeviceInfo.szLocation[ ARRAYSIZE( DeviceInfo.szLocation ) - 1 ] = PXS_CHAR_NULL;
+                                 szStatusMsg, ARRAYSIZE( szStatusMsg ) );
+                DeviceInfo.idxStatusMsg = PoolString( szStatusMsg );
+
+                // Friendly name, description, manufacturer and location
+                DeviceInfo.idxDeviceName   = PoolDeviceProperty( hDevInfo,
+                                                                 &DeviceInfoData,
+                                                                 SPDRP_FRIENDLYNAME );
+                DeviceInfo.idxDescription  = PoolDeviceProperty( hDevInfo,
+                                                                 &DeviceInfoData,
+                                                                 SPDRP_DEVICEDESC );
+                DeviceInfo.idxManufacturer = PoolDeviceProperty( hDevInfo,
+                                                                 &DeviceInfoData, SPDRP_MFG );
+                DeviceInfo.idxLocation     = PoolDeviceProperty( hDevInfo,
+                                                                 &DeviceInfoData,
+                                                                 SPDRP_LOCATION_INFORMATION );
 
                 // Driver information
                 GetDriverInfo( hDevInfo,
                                &DeviceInfoData,
-                               DeviceInfo.szDriverProvider,
-                               ARRAYSIZE( DeviceInfo.szDriverProvider ),
-                               DeviceInfo.szDriverVersion,
-                               ARRAYSIZE( DeviceInfo.szDriverVersion ),
-                               DeviceInfo.szDriverDate,
-                               ARRAYSIZE( DeviceInfo.szDriverDate ) );
+                               &RegObject,
+                               szDriverProvider,
+                               ARRAYSIZE( szDriverProvider ),
+                               szDriverVersion,
+                               ARRAYSIZE( szDriverVersion ),
+                               szDriverDate,
+                               ARRAYSIZE( szDriverDate ) );
+                DeviceInfo.idxDriverProvider = PoolString( szDriverProvider );
+                DeviceInfo.idxDriverVersion  = PoolString( szDriverVersion );
+                DeviceInfo.idxDriverDate     = PoolString( szDriverDate );
 
                 // Device instance ID, this is system defined and is unique for
                 // each device, it is persistent across system boots. Note, this
                 // function takes number of characters
                 requiredSize = 0;
+                memset( szDeviceID, 0, sizeof ( szDeviceID ) );
                 SetupDiGetDeviceInstanceId( hDevInfo,
                                             &DeviceInfoData,
-                                            DeviceInfo.szDeviceID,
-                                            ARRAYSIZE( DeviceInfo.szDeviceID ),
+                                            szDeviceID,
+                                            ARRAYSIZE( szDeviceID ),
                                             &requiredSize );
-                DeviceInfo.szDeviceID[ ARRAYSIZE( DeviceInfo.szDeviceID ) - 1 ] = PXS_CHAR_NULL;
-
-                m_Devices.Append( DeviceInfo );
+                szDeviceID[ ARRAYSIZE( szDeviceID ) - 1 ] = PXS_CHAR_NULL;
+                DeviceInfo.idxDeviceID = PoolString( szDeviceID );
+
+                // Grow by doubling so adding a device is not a copy of them all
+                if ( m_uNumDevices == m_Devices.GetSize() )
+                {
+                    m_Devices.SetSize( m_uNumDevices ? PXSMultiplySizeT( m_uNumDevices, 2 ) : 256 );
+                }
+                m_Devices.Set( m_uNumDevices, DeviceInfo );
+                m_uNumDevices++;
             }
         }
     }
@@ -282,9 +308,48 @@ size_t DeviceInformation::FillData()
         throw;
     }
     SetupDiDestroyDeviceInfoList( hDevInfo );
-    m_DeviceTypes.Sort( true );
 
-    return m_DeviceTypes.GetSize();
+    return m_uNumDevices;
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the index of a device class, adding it if it is new
+//
+//  Parameters:
+//      ClassGuid - the device class GUID
+//
+//  Remarks:
+//      There are a few dozen classes at most so a linear search is used.
+//      The class description is read only when the class is first seen.
+//
+//  Returns:
+//      Index into m_ClassGuids
+//===============================================================================================//
+DWORD DeviceInformation::GetClassIndex( const GUID& ClassGuid )
+{
+    size_t  i = 0, numClasses = m_ClassGuids.GetSize();
+    String  DeviceType;
+    wchar_t szDeviceType[ 64 ] = { 0 };
+
+    for ( i = 0; i < numClasses; i++ )
+    {
+        if ( memcmp( m_ClassGuids.GetPtr( i ), &ClassGuid, sizeof ( ClassGuid ) ) == 0 )
+        {
+            return static_cast<DWORD>( i );
+        }
+    }
+
+    // Class Description / Device Type.
+    SetupDiGetClassDescription( &ClassGuid, szDeviceType, ARRAYSIZE( szDeviceType ), nullptr );
+    szDeviceType[ ARRAYSIZE( szDeviceType ) - 1 ] = PXS_CHAR_NULL;
+    DeviceType = szDeviceType;
+    DeviceType.Trim();
+
+    m_ClassGuids.Add( ClassGuid );
+    m_ClassTypes.Add( PoolString( DeviceType.c_str() ) );
+
+    return static_cast<DWORD>( numClasses );
 }
 
 //===============================================================================================//
@@ -358,6 +423,7 @@ void DeviceInformation::GetDeviceStatus( DEVINST dnDevInst,
 //  Parameters:
 //      DeviceInfoSet     - handle to the device instance
 //      DeviceInfoData    - pointer to the device data
+//      pRegObject        - registry object connected to HKEY_LOCAL_MACHINE
 //      pszDriverProvider - receives driver's provider name
 //      numProviderChars  - size of the driver provider buffer in chars
 //      pszDriverVersion  - receives driver version
@@ -370,6 +436,7 @@ void DeviceInformation::GetDeviceStatus( DEVINST dnDevInst,
 //===============================================================================================//
 void DeviceInformation::GetDriverInfo( HDEVINFO DeviceInfoSet,
                                        PSP_DEVINFO_DATA  DeviceInfoData,
+                                       Registry* pRegObject,
                                        LPWSTR pszDriverProvider,
                                        size_t numProviderChars,
                                        LPWSTR pszDriverVersion,
@@ -379,10 +446,10 @@ void DeviceInformation::GetDriverInfo( HDEVINFO DeviceInfoSet,
 {
     wchar_t  szBuffer[ MAX_PATH + 1 ] = { 0 };
     String   Value, DriverKey, Insert1;
-    Registry RegObject;
 
     if ( ( DeviceInfoSet     == nullptr ) ||
          ( DeviceInfoData    == nullptr ) ||
+         ( pRegObject        == nullptr ) ||
          ( pszDriverProvider == nullptr ) ||
          ( pszDriverVersion  == nullptr ) ||
          ( pszDriverDate     == nullptr )  )
@@ -423,11 +490,10 @@ void DeviceInformation::GetDriverInfo( HDEVINFO DeviceInfoSet,
     // Make the registry path
     DriverKey  = L"System\\CurrentControlSet\\Control\\Class\\";
     DriverKey += szBuffer;
-    RegObject.Connect( HKEY_LOCAL_MACHINE );
 
     // Driver provider name
     Value = PXS_STRING_EMPTY;
-    RegObject.GetStringValue( DriverKey.c_str(), L"ProviderName", &Value );
+    pRegObject->GetStringValue( DriverKey.c_str(), L"ProviderName", &Value );
     if ( Value.c_str() )
     {
         PXSStringCchCopy( pszDriverProvider, numProviderChars, Value.c_str(), __FUNCTION__ );
@@ -435,7 +501,7 @@ void DeviceInformation::GetDriverInfo( HDEVINFO DeviceInfoSet,
 
     // Driver version
     Value = PXS_STRING_EMPTY;
-    RegObject.GetStringValue( DriverKey.c_str(), L"DriverVersion", &Value );
+    pRegObject->GetStringValue( DriverKey.c_str(), L"DriverVersion", &Value );
     if ( Value.c_str() )
     {
         PXSStringCchCopy( pszDriverVersion, numVersionChars, Value.c_str(), __FUNCTION__ );
@@ -443,7 +509,7 @@ void DeviceInformation::GetDriverInfo( HDEVINFO DeviceInfoSet,
 
     // Driver date
     Value = PXS_STRING_EMPTY;
-    RegObject.GetStringValue( DriverKey.c_str(), L"DriverDate", &Value );
+    pRegObject->GetStringValue( DriverKey.c_str(), L"DriverDate", &Value );
     if ( Value.c_str() )
     {
         PXSStringCchCopy( pszDriverDate, numDateChars, Value.c_str(), __FUNCTION__ );
@@ -452,98 +518,71 @@ void DeviceInformation::GetDriverInfo( HDEVINFO DeviceInfoSet,
 
 //===============================================================================================//
 //  Description:
-//      Get the devices that are of the "next device type".
+//      Read a string property of a device and add it to the string pool
 //
 //  Parameters:
-//      DeviceType - string object to receive the name of the device type
-//      pRecords   - array to receive the audit records
+//      DeviceInfoSet  - handle to the device instance
+//      DeviceInfoData - pointer to the device data
+//      property       - the SPDRP_xxx property to read
 //
 //  Remarks:
-//      Must have first called FillData.
-//
-//      Devices are enumerated by device type. Each time this method is called,
-//      the device type is advance and DeviceType is set to indicate its name.
-//      Records receives formatted audit records of all the devices of the
-//      current device type.
+//      Values are limited to 63 characters as they have always been, a
+//      property that does not fit or does not exist is an empty string.
 //
 //  Returns:
-//      Number of devices of the named device type. Zero if none found
+//      Index of the value in m_StringPool
 //===============================================================================================//
-size_t DeviceInformation::GetNextDeviceType( String* pDeviceType,
-                                             TArray< AuditRecord >* pRecords )
+DWORD DeviceInformation::PoolDeviceProperty( HDEVINFO DeviceInfoSet,
+                                             PSP_DEVINFO_DATA DeviceInfoData, DWORD property )
 {
-    String      Value;
-    Formatter   Format;
-    AuditRecord Record;
-    const TYPE_DEVICE_INFO* pDI = nullptr;
-
-    if ( ( pDeviceType == nullptr ) || ( pRecords == nullptr ) )
-    {
-        throw ParameterException( L"pDeviceType/pRecords", __FUNCTION__ );
-    }
-    *pDeviceType = PXS_STRING_EMPTY;
-    pRecords->RemoveAll();
-
-    // Get the name of the device type to enumerate in the sorted array.
-    if ( m_uLastDeviceTypeIndex == DWORD_MAX )
-    {
-        // Starting a new enumeration
-        m_uLastDeviceTypeIndex = 0;
-    }
-    else
-    {
-        // Continuing an existing enumeration
-        m_uLastDeviceTypeIndex = PXSAddUInt32( m_uLastDeviceTypeIndex, 1 );
-    }
+    wchar_t szValue[ 64 ] = { 0 };
+
+    SetupDiGetDeviceRegistryProperty( DeviceInfoSet,
+                                      DeviceInfoData,
+                                      property,
+                                      nullptr,
+                                      reinterpret_cast<BYTE*>( &szValue ),
+                                      sizeof ( szValue ),  // Bytes
+                                      nullptr );
+    szValue[ ARRAYSIZE( szValue ) - 1 ] = PXS_CHAR_NULL;
+
+    return PoolString( szValue );
+}
 
-    if ( m_uLastDeviceTypeIndex < m_DeviceTypes.GetSize() )
+//===============================================================================================//
+//  Description:
+//      Add a string to the string pool if it is not already there
+//
+//  Parameters:
+//      pszString - the string, can be NULL
+//
+//  Remarks:
+//      Index 0 is always the empty string, it is not in m_PoolIndex.
+//
+//  Returns:
+//      Index of the string in m_StringPool
+//===============================================================================================//
+DWORD DeviceInformation::PoolString( LPCWSTR pszString )
+{
+    if ( m_StringPool.GetSize() == 0 )
     {
-        *pDeviceType = m_DeviceTypes.Get( m_uLastDeviceTypeIndex );
-        pDeviceType->Trim();
+        m_StringPool.Add( PXS_STRING_EMPTY );
     }
 
-    if ( pDeviceType->IsEmpty() )
+    if ( ( pszString == nullptr ) || ( *pszString == PXS_CHAR_NULL ) )
     {
         return 0;
     }
 
-    if ( m_Devices.IsEmpty() )
+    size_t idxString = m_PoolIndex.Find( m_StringPool, pszString, true );
+    if ( idxString == PXS_MINUS_ONE )
     {
-        return 0;
+        idxString = m_StringPool.GetSize();
+        m_StringPool.Add( pszString );
+        m_PoolIndex.Add( pszString, true, idxString );
     }
 
-    // Scan device the setup list to match the device types
-    m_Devices.Rewind();
-    do
-    {
-        pDI = m_Devices.GetPointer();
-        if ( lstrcmpi( pDI->szDeviceType, pDeviceType->c_str() ) == 0 )
-        {
-            // Make the record
-            Record.Reset( PXS_CATEGORY_HARDWARE_DEVICES );
-            Record.Add( PXS_HARDWARE_DEVS_DEVICE_TYPE , *pDeviceType );
-            Record.Add( PXS_HARDWARE_DEVS_DEVICE_NAME , pDI->szDeviceName );
-            Record.Add( PXS_HARDWARE_DEVS_DESCRIPTION , pDI->szDescription );
-            Record.Add( PXS_HARDWARE_DEVS_MANUFACTURER, pDI->szManufacturer);
-            Record.Add( PXS_HARDWARE_DEVS_LOCATION    , pDI->szLocation );
-            Record.Add( PXS_HARDWARE_DEVS_DRIVER_PROV , pDI->szDriverProvider);
-            Record.Add( PXS_HARDWARE_DEVS_DRIVER_VER  , pDI->szDriverVersion );
-            Record.Add( PXS_HARDWARE_DEVS_DRIVER_DATE , pDI->szDriverDate );
-
-            Value = Format.UInt32( pDI->statusCode );
-            Record.Add( PXS_HARDWARE_DEVS_STATUS_CODE, Value );
-
-            Record.Add( PXS_HARDWARE_DEVS_STATUS_MSG, pDI->szStatusMsg );
-
-            Value = Format.GuidToString( pDI->ClassGuid );
-            Record.Add( PXS_HARDWARE_DEVS_CLASS_GUID, Value );
-
-            Record.Add( PXS_HARDWARE_DEVS_DEVICE_ID, pDI->szDeviceID );
-            pRecords->Add( Record );
-        }
-    } while ( m_Devices.Advance() );
-
-    return pRecords->GetSize();
+    return static_cast<DWORD>( idxString );
 }
 
 //===============================================================================================//
@@ -561,9 +600,12 @@ size_t DeviceInformation::GetNextDeviceType( String* pDeviceType,
 //===============================================================================================//
 void DeviceInformation::Reset()
 {
-    m_uLastDeviceTypeIndex = DWORD_MAX;  // Reset the last device type to none
+    m_uNumDevices = 0;
+    m_StringPool.RemoveAll();
+    m_PoolIndex.RemoveAll();
+    m_ClassGuids.RemoveAll();
+    m_ClassTypes.RemoveAll();
     m_Devices.RemoveAll();
-    m_DeviceTypes.RemoveAll();
 }
 
 //===============================================================================================//
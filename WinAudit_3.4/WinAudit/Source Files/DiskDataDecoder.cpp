@@ -0,0 +1,1787 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Disk Data Decoder Class Implementation
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Header Files/DiskDataDecoder.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/ByteArray.h"
+#include "PxsBase/Header Files/Directory.h"
+#include "PxsBase/Header Files/File.h"
+#include "PxsBase/Header Files/Formatter.h"
+#include "PxsBase/Header Files/ParameterException.h"
+#include "PxsBase/Header Files/StringArray.h"
+#include "PxsBase/Header Files/TArray.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/AuditRecord.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Constants
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static_assert( sizeof ( PXSDDK::IDENTIFY_DEVICE_DATA ) == DiskDataDecoder::ATA_SECTOR_SIZE,
+               "IDENTIFY_DEVICE_DATA must be one ATA sector" );
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Default constructor
+DiskDataDecoder::DiskDataDecoder()
+{
+}
+
+// Copy constructor - not allowed so no implementation
+
+// Destructor
+DiskDataDecoder::~DiskDataDecoder()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Operators
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Assignment operator - not allowed so no implementation
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Public Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Decode the disk data blocks in a directory into physical disk audit
+//      records and a text translation
+//
+//  Parameters:
+//      DirectoryPath - the directory holding the data block files
+//      pRecords      - receives the audit records
+//      pTranslations - receives the translation of the data blocks
+//
+//  Remarks:
+//      Each file holds one binary data block, the file extension gives its
+//      type:
+//          .idd   - ATA IDENTIFY DEVICE data, 512 bytes
+//          .smart - ATA SMART READ DATA, 512 bytes
+//          .nvid  - NVMe Identify Controller data structure, 4096 bytes
+//          .nvns  - NVMe Identify Namespace data structure, 4096 bytes
+//          .nvlog - NVMe SMART/Health Information log page, 512 bytes
+//      Files that differ only by extension, e.g. disk0.idd and disk0.smart,
+//      are from the same disk so make one record. A file that cannot be read
+//      is logged and skipped so that one bad capture does not stop the batch.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DiskDataDecoder::DecodeDirectory( const String& DirectoryPath,
+                                       TArray< AuditRecord >* pRecords, String* pTranslations )
+{
+    size_t      i = 0, numFiles = 0;
+    String      FileName, FilePath, Stem, Drive, Dir, Fname, Ext;
+    String      Translation, Message, Insert2;
+    ByteArray   AtaIdentify, AtaSmart, NvmeController, NvmeNamespace, NvmeHealthLog;
+    Formatter   Format;
+    StringArray FileNames;
+    AuditRecord Record;
+    PXSDDK::IDENTIFY_DEVICE_DATA IDD;
+
+    if ( pRecords == nullptr )
+    {
+        throw ParameterException( L"pRecords", __FUNCTION__ );
+    }
+    pRecords->RemoveAll();
+
+    if ( pTranslations == nullptr )
+    {
+        throw ParameterException( L"pTranslations", __FUNCTION__ );
+    }
+    *pTranslations = PXS_STRING_EMPTY;
+
+    if ( DirectoryPath.IsEmpty() )
+    {
+        throw ParameterException( L"DirectoryPath", __FUNCTION__ );
+    }
+
+    Directory::ListFiles( DirectoryPath, PXS_STRING_EMPTY, &FileNames );
+    numFiles = FileNames.GetSize();
+    while ( i < numFiles )
+    {
+        // Gather the data blocks of one disk, the sorted names are adjacent
+        AtaIdentify.Free();
+        AtaSmart.Free();
+        NvmeController.Free();
+        NvmeNamespace.Free();
+        NvmeHealthLog.Free();
+        Directory::SplitPath( FileNames.Get( i ), &Drive, &Dir, &Stem, &Ext );
+        do
+        {
+            FileName = FileNames.Get( i );
+            Directory::SplitPath( FileName, &Drive, &Dir, &Fname, &Ext );
+            if ( Fname.CompareI( Stem ) != 0 )
+            {
+                break;
+            }
+            i++;
+
+            FilePath = DirectoryPath;
+            if ( FilePath.EndsWithCharacterI( PXS_PATH_SEPARATOR ) == false )
+            {
+                FilePath += PXS_PATH_SEPARATOR;
+            }
+            FilePath += FileName;
+            try
+            {
+                if ( Ext.CompareI( L".idd" ) == 0 )
+                {
+                    ReadDataBlockFile( FilePath, ATA_SECTOR_SIZE, &AtaIdentify );
+                }
+                else if ( Ext.CompareI( L".smart" ) == 0 )
+                {
+                    ReadDataBlockFile( FilePath, ATA_SECTOR_SIZE, &AtaSmart );
+                }
+                else if ( Ext.CompareI( L".nvid" ) == 0 )
+                {
+                    ReadDataBlockFile( FilePath, NVME_IDENTIFY_SIZE, &NvmeController );
+                }
+                else if ( Ext.CompareI( L".nvns" ) == 0 )
+                {
+                    ReadDataBlockFile( FilePath, NVME_IDENTIFY_SIZE, &NvmeNamespace );
+                }
+                else if ( Ext.CompareI( L".nvlog" ) == 0 )
+                {
+                    ReadDataBlockFile( FilePath, NVME_HEALTH_LOG_SIZE, &NvmeHealthLog );
+                }
+                else
+                {
+                    PXSLogAppInfo1( L"Skipped '%%1', not a disk data block file.", FilePath );
+                }
+            }
+            catch ( const Exception& e )
+            {
+                Message  = L"Error reading disk data block file '";
+                Message += FilePath;
+                Message += L"'.";
+                PXSLogException( Message.c_str(), e, __FUNCTION__ );
+            }
+        } while ( i < numFiles );
+
+        if ( ( AtaIdentify.GetSize()    == 0 ) && ( AtaSmart.GetSize()      == 0 ) &&
+             ( NvmeController.GetSize() == 0 ) && ( NvmeNamespace.GetSize() == 0 ) &&
+             ( NvmeHealthLog.GetSize()  == 0 )  )
+        {
+            continue;
+        }
+        *pTranslations += L"---------------------\r\n";
+        *pTranslations += Stem;
+        *pTranslations += L"\r\n---------------------\r\n\r\n";
+
+        try
+        {
+            if ( AtaIdentify.GetSize() || AtaSmart.GetSize() )
+            {
+                if ( AtaIdentify.GetSize() )
+                {
+                    memcpy( &IDD, AtaIdentify.GetPtr(), sizeof ( IDD ) );
+                    FormatDiskFirmwareDataBlock( &IDD, &Translation );
+                    *pTranslations += Translation;
+                }
+                FormatAtaSmartData( AtaSmart.GetPtr(), AtaSmart.GetSize(), &Translation );
+                *pTranslations += Translation;
+
+                MakeAtaDiskRecord( AtaIdentify.GetPtr(),
+                                   AtaIdentify.GetSize(),
+                                   AtaSmart.GetPtr(),
+                                   AtaSmart.GetSize(), pRecords->GetSize() + 1, &Record );
+                pRecords->Add( Record );
+            }
+
+            if ( NvmeController.GetSize() || NvmeNamespace.GetSize() || NvmeHealthLog.GetSize() )
+            {
+                FormatNvmeControllerData( NvmeController.GetPtr(),
+                                          NvmeController.GetSize(), &Translation );
+                *pTranslations += Translation;
+                FormatNvmeNamespaceData( NvmeNamespace.GetPtr(),
+                                         NvmeNamespace.GetSize(), &Translation );
+                *pTranslations += Translation;
+                FormatNvmeHealthLog( NvmeHealthLog.GetPtr(),
+                                     NvmeHealthLog.GetSize(), &Translation );
+                *pTranslations += Translation;
+
+                MakeNvmeDiskRecord( NvmeController.GetPtr(),
+                                    NvmeController.GetSize(),
+                                    NvmeNamespace.GetPtr(),
+                                    NvmeNamespace.GetSize(),
+                                    NvmeHealthLog.GetPtr(),
+                                    NvmeHealthLog.GetSize(), pRecords->GetSize() + 1, &Record );
+                pRecords->Add( Record );
+            }
+        }
+        catch ( const Exception& e )
+        {
+            *pTranslations += e.GetMessage();
+            *pTranslations += PXS_STRING_CRLF;
+
+            Message  = L"Error decoding disk data blocks '";
+            Message += Stem;
+            Message += L"'.";
+            PXSLogException( Message.c_str(), e, __FUNCTION__ );
+        }
+        *pTranslations += PXS_STRING_CRLF;
+    }
+
+    Insert2 = Format.SizeT( numFiles );
+    PXSLogAppInfo2( L"Decoded %%1 disk(s) from %%2 file(s).",
+                    Format.SizeT( pRecords->GetSize() ), Insert2 );
+}
+
+//===============================================================================================//
+//  Description:
+//      Convert a hex format (raw) disk serial number to a display string
+//
+//  Parameters:
+//      SerialHex     - hex string of the serial number
+//      pSerialNumber - receives the diplay string
+//
+//  Remarks:
+//      Normally the serial number is a hex represention of character swapped
+//      ASCII e.g.
+//      30534538314a414f323132353738202020202020
+//      0 S E 8 1 J A O 2 1 2 5 7 8
+//      S08EJ1OA125287
+//      However, if this does not seem to be the case will return the raw data
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DiskDataDecoder::DiskSerialHexToSerialNumber( const String& SerialHex, String* pSerialNumber )
+{
+    bool      swap = true;   // Assume will swap characters
+    String    HexByte;
+    Formatter Format;
+
+    if ( pSerialNumber == nullptr )
+    {
+        throw ParameterException( L"pSerialNumber", __FUNCTION__ );
+    }
+    *pSerialNumber = PXS_STRING_EMPTY;
+
+    size_t lenChars = SerialHex.GetLength();
+    if ( lenChars == 0 )
+    {
+        return;     // Nothing to do
+    }
+
+    // Must be an divisble by 4 for character swapping
+    lenChars = SerialHex.GetLength();
+    if ( lenChars % 4 )
+    {
+        swap = false;
+        PXSLogAppWarn( L"HDD serial number length not multiple of 4." );
+    }
+
+    // Scan the string for unexpected characters
+    for ( size_t i = 0; i < lenChars; i++ )
+    {
+        wchar_t ch = SerialHex.CharAt( i );
+        if ( PXSIsHexitW( ch ) == false )
+        {
+            swap = false;
+            PXSLogAppWarn( L"HDD serial number has non-hexadecimal chars." );
+            break;
+        }
+    }
+
+    // Sometimes the hex string has non-printable (< 0x20) characters. Perhaps
+    // the disk's manufacturer intended the serial number to be shown
+    // in hex format.
+    for ( size_t i = 0; i < lenChars; i+=2 )  // NB lenChars is even
+    {
+        // Test the first hexit of each 2-hexit byte
+        wchar_t ch = SerialHex.CharAt( i );
+        if ( ch < '1' )
+        {
+            swap = false;
+            PXSLogAppWarn( L"HDD serial number has non-printable chars." );
+            break;
+        }
+    }
+
+    // If no reversal, return the input string
+    if ( swap == false )
+    {
+        *pSerialNumber = SerialHex;
+        return;
+    }
+
+    // Swap the hex pairs
+    for ( size_t i = 0; i < (lenChars - 3); i += 4 )  // NB lenChars is > 3 and even
+    {
+        HexByte      = SerialHex.CharAt( i + 2 );
+        HexByte     += SerialHex.CharAt( i + 3 );
+        DWORD number = Format.HexStringToNumber( HexByte );
+        pSerialNumber->AppendChar( 0xFF & number, 1 );
+
+        HexByte  = SerialHex.CharAt( i );
+        HexByte += SerialHex.CharAt( i + 1 );
+        number   = Format.HexStringToNumber( HexByte );
+        pSerialNumber->AppendChar( 0xFF & number, 1 );
+    }
+    pSerialNumber->Trim();      // Often the data is padded with spaces.
+}
+
+//===============================================================================================//
+//  Description:
+//      Get a string from an IDENTIFY_DEVICE_DATA structure
+//
+//  Parameters:
+//      pbData      - byte buffer holding the string data
+//      numBytes    - size of the buffer
+//      pDataString - string object to receive the data
+//
+//  Remarks:
+//      String data is in bytes that need reversing
+//
+//  Returns:
+//      true if got data, else false
+//===============================================================================================//
+bool DiskDataDecoder::ExtractIddStringValue( const BYTE* pbData,
+                                             size_t numBytes, String* pDataString )
+{
+    if ( pDataString == nullptr )
+    {
+        throw ParameterException( L"pDataString", __FUNCTION__ );
+    }
+    pDataString->Allocate( 128 );        // Only expecting short strings
+    *pDataString = PXS_STRING_EMPTY;
+
+    if ( ( pbData == nullptr ) || ( numBytes == 0 ) )
+    {
+        return false;
+    }
+
+    // Add bytes to string, make sure only going up to an even number of bytes
+    numBytes = ( numBytes / 2 ) * 2;
+    for ( DWORD i = 0; i < numBytes; i++ )
+    {
+        // Reverse bytes
+        wchar_t ch;
+        if ( ( i % 2 ) == 0 )
+        {
+            ch = pbData[ i + 1 ];
+        }
+        else
+        {
+            ch = pbData[ i - 1 ];
+        }
+
+        // Replace white spaces with spaces
+        if ( PXSIsWhiteSpace( ch ) )
+        {
+            ch = PXS_CHAR_SPACE;
+        }
+        *pDataString += ch;
+    }
+    pDataString->Trim();
+
+    return true;
+}
+
+//===============================================================================================//
+//  Description:
+//      Format an ATA SMART READ DATA sector as a string
+//
+//  Parameters:
+//      pSmart       - pointer to the SMART data
+//      bufferSize   - size of the buffer, must be at least 512 bytes
+//      pTranslation - receives the formatted data
+//
+//  Remarks:
+//      The sector has 30 vendor specific attribute entries of 12 bytes from
+//      byte 2, an entry with an ID of zero is unused. Attribute names vary by
+//      vendor so only the commonly agreed ones are named.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DiskDataDecoder::FormatAtaSmartData( const BYTE* pSmart,
+                                          size_t bufferSize, String* pTranslation )
+{
+    const size_t NUM_ATTRIBUTES = 30;
+    const size_t ATTRIBUTE_SIZE = 12;
+    size_t    i = 0, j = 0;
+    String    Data, RawValue;
+    Formatter Format;
+    const BYTE* pAttribute = nullptr;
+
+    struct _ATTRIBUTE_NAME
+    {
+        BYTE    id;
+        LPCWSTR pszName;
+    } Names[] = { {   1, L"Raw Read Error Rate"          },
+                  {   3, L"Spin Up Time"                 },
+                  {   4, L"Start/Stop Count"             },
+                  {   5, L"Reallocated Sectors Count"    },
+                  {   7, L"Seek Error Rate"              },
+                  {   9, L"Power-On Hours"               },
+                  {  10, L"Spin Retry Count"             },
+                  {  12, L"Power Cycle Count"            },
+                  { 177, L"Wear Leveling Count"          },
+                  { 187, L"Reported Uncorrectable Errors"},
+                  { 190, L"Airflow Temperature"          },
+                  { 192, L"Power-off Retract Count"      },
+                  { 193, L"Load Cycle Count"             },
+                  { 194, L"Temperature"                  },
+                  { 196, L"Reallocation Event Count"     },
+                  { 197, L"Current Pending Sector Count" },
+                  { 198, L"Uncorrectable Sector Count"   },
+                  { 199, L"UltraDMA CRC Error Count"     },
+                  { 231, L"SSD Life Left"                },
+                  { 241, L"Total LBAs Written"           },
+                  { 242, L"Total LBAs Read"              } };
+
+    if ( pTranslation == nullptr )
+    {
+        throw ParameterException( L"pTranslation", __FUNCTION__ );
+    }
+    *pTranslation = PXS_STRING_EMPTY;
+
+    if ( ( pSmart == nullptr ) || ( bufferSize < ATA_SECTOR_SIZE ) )
+    {
+        return;     // Nothing to do
+    }
+    Data.Allocate( 4096 );
+
+    Data += L"SMART Data Translation:\r\n";
+    Data += Format.StringUInt32( L"Revision                   \t= %%1\r\n",
+                                 MAKEWORD( pSmart[ 0 ], pSmart[ 1 ] ) );
+    Data += Format.StringUInt32( L"Offline Collection Status  \t= %%1\r\n", pSmart[ 362 ] );
+    Data += Format.StringUInt32( L"Self-test Execution Status \t= %%1\r\n", pSmart[ 363 ] >> 4 );
+    if ( IsZeroSumBlock( pSmart, ATA_SECTOR_SIZE ) )
+    {
+        Data += L"CheckSum                   \t= Valid\r\n";
+    }
+    else
+    {
+        Data += L"CheckSum                   \t= Invalid\r\n";
+    }
+
+    Data += L"Attributes (ID, Current, Worst, Raw Value, Name):\r\n";
+    for ( i = 0; i < NUM_ATTRIBUTES; i++ )
+    {
+        pAttribute = pSmart + 2 + ( i * ATTRIBUTE_SIZE );
+        if ( pAttribute[ 0 ] == 0 )
+        {
+            continue;   // Unused entry
+        }
+        RawValue = Format.UInt64( GetUInt64LE( pAttribute + 5, 6 ) );
+        Data += Format.StringUInt32_3( L"\t%%1\t%%2\t%%3\t",
+                                       pAttribute[ 0 ], pAttribute[ 3 ], pAttribute[ 4 ] );
+        Data += RawValue;
+        for ( j = 0; j < ARRAYSIZE( Names ); j++ )
+        {
+            if ( Names[ j ].id == pAttribute[ 0 ] )
+            {
+                Data += L"\t";
+                Data += Names[ j ].pszName;
+                break;
+            }
+        }
+        Data += PXS_STRING_CRLF;
+    }
+    Data += PXS_STRING_CRLF;
+
+    *pTranslation = Data;
+}
+
+//===============================================================================================//
+//  Description:
+//      Format the IDENTIFY_DEVICE_DATA structure as a string
+//
+//  Parameters:
+//      pIDD       - pointer to the IDENTIFY_DEVICE_DATA structure
+//      pIddString - receives the formatted data
+//
+//  Remarks:
+//      ulBufferSize should normally be 512
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DiskDataDecoder::FormatDiskFirmwareDataBlock( const PXSDDK::IDENTIFY_DEVICE_DATA* pIDD,
+                                                   String* pIddString )
+{
+    ULONG     i = 0;
+    String    FormattedIdd;
+    Formatter Format;
+    const BYTE* pBytes = nullptr;
+
+    if ( pIddString == nullptr )
+    {
+        throw ParameterException( L"pIddString", __FUNCTION__ );
+    }
+    pIddString->Allocate( 4096 );
+    *pIddString = PXS_STRING_EMPTY;
+
+    if ( pIDD == nullptr )
+    {
+        return;     // Nothing to do
+    }
+
+    // Write out as an line of bytes
+    pBytes     = reinterpret_cast<const BYTE*>( pIDD );
+    *pIddString += L"0000:";
+    for ( i = 0; i < sizeof ( PXSDDK::IDENTIFY_DEVICE_DATA ); i++ )
+    {
+        // Make the line start
+        if ( ( i != 0 ) && ( ( i % 16 ) == 0 ) )
+        {
+            *pIddString += PXS_STRING_CRLF;
+            if ( i < 99 )
+            {
+                // e.g. 0032:
+                *pIddString += Format.StringUInt32( L"00%%1:", i );
+            }
+            else
+            {
+                // >= 100, // e.g. 0128:
+                *pIddString += Format.StringUInt32( L"0%%1:", i );
+            }
+        }
+
+        // Write the bytes
+        *pIddString += Format.UInt8Hex( pBytes[ i ], false );
+        *pIddString += PXS_CHAR_SPACE;
+    }
+    *pIddString += PXS_STRING_CRLF;
+
+    // Translation the data structure.
+    FormatIddStructureAsString( pIDD, &FormattedIdd );
+    *pIddString += PXS_STRING_CRLF;
+    *pIddString += L"Data Block Translation:\r\n";
+    *pIddString += FormattedIdd;
+    *pIddString += PXS_STRING_CRLF;
+    *pIddString += PXS_STRING_CRLF;
+}
+
+//===============================================================================================//
+//  Description:
+//      Interpret an IDD structure
+//
+//  Parameters:
+//      pIDD           - pointer to an IDENTIFY_DEVICE_DATA with the data
+//      pFormattedIdd - string object to receive the formatted string
+//
+//  Remarks:
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DiskDataDecoder::FormatIddStructureAsString( const PXSDDK::IDENTIFY_DEVICE_DATA* pIDD,
+                                                  String* pFormattedIdd )
+{
+    DWORD     i = 0;
+    String    Data;
+    Formatter Format;
+
+    if ( pFormattedIdd == nullptr )
+    {
+        throw ParameterException( L"pFormattedIdd", __FUNCTION__ );
+    }
+    *pFormattedIdd = PXS_STRING_EMPTY;
+
+    if ( pIDD == nullptr )
+    {
+        return;     // Nothing to do
+    }
+    Data.Allocate( 2048 );
+
+    // Add notice
+    Data += L"Where appropriate 0 = false/no and 1 = true/yes.";
+    Data += PXS_STRING_CRLF;
+    Data += L"Some information requires character reversal, for";
+    Data += PXS_STRING_CRLF;
+    Data += L"example, aMtxro = Maxtor.\r\n";
+    Data += PXS_STRING_CRLF;
+
+    /////////////////////////////////
+    // Add the data
+
+    Data += L"GeneralConfiguration:\r\n";
+    Data += Format.StringUInt32( L"\tReserved1            \t= %%1\r\n",
+                                 pIDD->GeneralConfiguration.Reserved1 );
+    Data += Format.StringUInt32( L"\tRetired3             \t= %%1\r\n",
+                                 pIDD->GeneralConfiguration.Retired3 );
+    Data += Format.StringUInt32( L"\tResponseIncomplete   \t= %%1\r\n",
+                                 pIDD->GeneralConfiguration.ResponseIncomplete);
+    Data += Format.StringUInt32( L"\tRetired2             \t= %%1\r\n",
+                                 pIDD->GeneralConfiguration.Retired2 );
+    Data += Format.StringUInt32( L"\tFixedDevice          \t= %%1\r\n",
+                                 pIDD->GeneralConfiguration.FixedDevice );
+    Data += Format.StringUInt32( L"\tRemovableMedia       \t= %%1\r\n",
+                                pIDD->GeneralConfiguration.RemovableMedia );
+    Data += Format.StringUInt32( L"\tRetired1             \t= %%1\r\n",
+                                 pIDD->GeneralConfiguration.Retired1 );
+    Data += Format.StringUInt32( L"\tDeviceType           \t= %%1\r\n",
+                                 pIDD->GeneralConfiguration.DeviceType );
+
+    Data += Format.StringUInt32( L"NumCylinders            \t= %%1\r\n",
+                                 pIDD->NumCylinders );
+    Data += Format.StringUInt32( L"ReservedWord2           \t= %%1\r\n",
+                                 pIDD->ReservedWord2 );
+    Data += Format.StringUInt32( L"NumHeads                \t= %%1\r\n",
+                                 pIDD->NumHeads );
+
+    Data += L"Retired1[2]:\r\n";
+    Data += Format.StringUInt32( L"\tRetired1[0]          \t= %%1\r\n",
+                                 pIDD->Retired1[0] );
+    Data += Format.StringUInt32( L"\tRetired1[1]          \t= %%1\r\n",
+                                 pIDD->Retired1[1] );
+
+    Data += Format.StringUInt32( L"NumSectorsPerTrack      \t= %%1\r\n",
+                                 pIDD->NumSectorsPerTrack );
+
+    Data += L"VendorUnique1[3]:\r\n";
+    Data += Format.StringUInt32( L"\tVendorUnique1[0]     \t= %%1\r\n",
+                                 pIDD->VendorUnique1[0] );
+    Data += Format.StringUInt32( L"\tVendorUnique1[1]     \t= %%1\r\n",
+                                 pIDD->VendorUnique1[1] );
+    Data += Format.StringUInt32( L"\tVendorUnique1[2]     \t= %%1\r\n",
+                                 pIDD->VendorUnique1[2] );
+
+    Data += L"SerialNumber[20]:\r\n";
+    for ( i = 0; i < ARRAYSIZE( pIDD->SerialNumber ); i++ )
+    {
+        Data += Format.StringUInt32( L"\tSerialNumber[%%1]   \t= ", i );
+        Data += pIDD->SerialNumber[ i ];
+        Data += PXS_STRING_CRLF;
+    }
+
+    Data += L"Retired2[2]:\r\n";
+    Data += Format.StringUInt32( L"\tRetired2[0]          \t= %%1\r\n",
+                                 pIDD->Retired2[0] );
+    Data += Format.StringUInt32( L"\tRetired2[1]          \t= %%1\r\n",
+                                 pIDD->Retired2[1] );
+
+    Data += Format.StringUInt32( L"Obsolete1              \t= %%1\r\n",
+                                 pIDD->Obsolete1 );
+
+    Data += L"FirmwareRevision[8]:\r\n";
+    for ( i = 0; i < ARRAYSIZE( pIDD->FirmwareRevision ); i++ )
+    {
+        Data += Format.StringUInt32( L"\tFirmwareRevision[%%1]\t= ", i );
+        Data += pIDD->FirmwareRevision[ i ];
+        Data += PXS_STRING_CRLF;
+    }
+
+    Data += L"ModelNumber[40]:\r\n";
+    for ( i = 0; i < ARRAYSIZE( pIDD->ModelNumber ); i++ )
+    {
+        Data += Format.StringUInt32( L"\tModelNumber[%%1]      \t= ", i );
+        Data += pIDD->ModelNumber[ i ];
+        Data += PXS_STRING_CRLF;
+    }
+
+    Data += Format.StringUInt32( L"MaximumBlockTransfer       \t= %%1\r\n",
+                                 pIDD->MaximumBlockTransfer );
+    Data += Format.StringUInt32( L"VendorUnique2              \t= %%1\r\n",
+                                pIDD->VendorUnique2 );
+    Data += Format.StringUInt32( L"ReservedWord48             \t= %%1\r\n",
+                                 pIDD->ReservedWord48 );
+
+    Data += L"Capabilities:\r\n";
+    Data += Format.StringUInt32( L"\tReservedByte49       \t= %%1\r\n",
+                                pIDD->Capabilities.ReservedByte49 );
+    Data += Format.StringUInt32( L"\tDmaSupported         \t= %%1\r\n",
+                                 pIDD->Capabilities.DmaSupported );
+    Data += Format.StringUInt32( L"\tLbaSupported         \t= %%1\r\n",
+                                pIDD->Capabilities.LbaSupported );
+    Data += Format.StringUInt32( L"\tIordyDisable         \t= %%1\r\n",
+                                 pIDD->Capabilities.IordyDisable );
+    Data += Format.StringUInt32( L"\tIordySupported       \t= %%1\r\n",
+                                 pIDD->Capabilities.IordySupported );
+    Data += Format.StringUInt32( L"\tReserved1            \t= %%1\r\n",
+                                 pIDD->Capabilities.Reserved1 );
+    Data += Format.StringUInt32( L"\tStandybyTimerSupport \t= %%1\r\n",
+                                 pIDD->Capabilities.StandybyTimerSupport );
+    Data += Format.StringUInt32( L"\tReserved2            \t= %%1\r\n",
+                                 pIDD->Capabilities.Reserved2 );
+    Data += Format.StringUInt32( L"\tReservedWord50       \t= %%1\r\n",
+                                 pIDD->Capabilities.ReservedWord50 );
+
+    Data += L"ObsoleteWords51[2]:\r\n";
+    Data += Format.StringUInt32( L"\tObsoleteWords51[0]   \t= %%1\r\n",
+                                 pIDD->ObsoleteWords51[0] );
+    Data += Format.StringUInt32( L"\tObsoleteWords51[1]   \t= %%1\r\n",
+                                 pIDD->ObsoleteWords51[1] );
+
+    Data += Format.StringUInt32( L"TranslationFieldsValid:3   \t= %%1\r\n",
+                                 pIDD->TranslationFieldsValid );
+    Data += Format.StringUInt32( L"Reserved3:13               \t= %%1\r\n",
+                                pIDD->Reserved3 );
+    Data += Format.StringUInt32( L"NumberOfCurrentCylinders   \t= %%1\r\n",
+                                 pIDD->NumberOfCurrentCylinders );
+    Data += Format.StringUInt32( L"NumberOfCurrentHeads       \t= %%1\r\n",
+                                 pIDD->NumberOfCurrentHeads );
+    Data += Format.StringUInt32( L"CurrentSectorsPerTrack     \t= %%1\r\n",
+                                 pIDD->CurrentSectorsPerTrack );
+    Data += Format.StringUInt32( L"CurrentSectorCapacity      \t= %%1\r\n",
+                                 pIDD->CurrentSectorCapacity );
+    Data += Format.StringUInt32( L"CurrentMultiSectorSetting  \t= %%1\r\n",
+                                 pIDD->CurrentMultiSectorSetting );
+    Data += Format.StringUInt32( L"MultiSectorSettingValid : 1\t= %%1\r\n",
+                                 pIDD->MultiSectorSettingValid );
+    Data += Format.StringUInt32( L"ReservedByte59: 7          \t= %%1\r\n",
+                                 pIDD->ReservedByte59 );
+    Data += Format.StringUInt32( L"UserAddressableSectors     \t= %%1\r\n",
+                                 pIDD->UserAddressableSectors );
+    Data += Format.StringUInt32( L"ObsoleteWord62             \t= %%1\r\n",
+                                 pIDD->ObsoleteWord62 );
+    Data += Format.StringUInt32( L"MultiWordDMASupport : 8    \t= %%1\r\n",
+                                 pIDD->MultiWordDMASupport );
+    Data += Format.StringUInt32( L"MultiWordDMAActive : 8     \t= %%1\r\n",
+                                 pIDD->MultiWordDMAActive );
+    Data += Format.StringUInt32( L"AdvancedPIOModes : 8       \t= %%1\r\n",
+                                 pIDD->AdvancedPIOModes );
+    Data += Format.StringUInt32( L"ReservedByte64 : 8         \t= %%1\r\n",
+                                 pIDD->ReservedByte64 );
+    Data += Format.StringUInt32( L"MinimumMWXferCycleTime     \t= %%1\r\n",
+                                 pIDD->MinimumMWXferCycleTime );
+    Data += Format.StringUInt32( L"MinimumPIOCycleTime        \t= %%1\r\n",
+                                 pIDD->MinimumPIOCycleTime );
+    Data += Format.StringUInt32( L"MinimumPIOCycleTimeIORDY   \t= %%1\r\n",
+                                 pIDD->MinimumPIOCycleTimeIORDY );
+
+    Data += L"ReservedWords69[6]:\r\n";
+    for ( i = 0; i < ARRAYSIZE( pIDD->ReservedWords76 ); i++ )
+    {
+       Data += Format.StringUInt32_2( L"\tReservedWords69[%%1]   \t= %%2\r\n",
+                                      i, pIDD->ReservedWords69[0] );
+    }
+
+    Data += Format.StringUInt32( L"QueueDepth : 5             \t= %%1\r\n",
+                                 pIDD->QueueDepth );
+    Data += Format.StringUInt32( L"ReservedWord75 : 11        \t= %%1\r\n",
+                                 pIDD->ReservedWord75 );
+
+    Data += L"ReservedWords76[4]:\r\n";
+    for ( i = 0; i < ARRAYSIZE( pIDD->ReservedWords76 ); i++ )
+    {
+        Data += Format.StringUInt32_2(
+                                L"\tReservedWords76[%%1]   \t= %%2\r\n",
+                                i, pIDD->ReservedWords76[ i ] );
+    }
+
+    Data += Format.StringUInt32( L"MajorRevision              \t= %%1\r\n",
+                                 pIDD->MajorRevision );
+    Data += Format.StringUInt32( L"MinorRevision              \t= %%1\r\n",
+                                 pIDD->MinorRevision );
+
+    Data += L"CommandSetSupport:\r\n";
+    Data += Format.StringUInt32( L"\tSmartCommands        \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.SmartCommands );
+    Data += Format.StringUInt32( L"\tSecurityMode         \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.SecurityMode );
+    Data += Format.StringUInt32( L"\tRemovableMedia       \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.RemovableMedia );
+    Data += Format.StringUInt32( L"\tPowerManagement      \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.PowerManagement );
+    Data += Format.StringUInt32( L"\tReserved1            \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.Reserved1 );
+    Data += Format.StringUInt32( L"\tWriteCache           \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.WriteCache );
+    Data += Format.StringUInt32( L"\tLookAhead            \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.LookAhead );
+    Data += Format.StringUInt32( L"\tReleaseInterrupt     \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.ReleaseInterrupt );
+    Data += Format.StringUInt32( L"\tServiceInterrupt     \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.ServiceInterrupt );
+    Data += Format.StringUInt32( L"\tDeviceReset          \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.DeviceReset );
+    Data += Format.StringUInt32( L"\tHostProtectedArea    \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.HostProtectedArea);
+    Data += Format.StringUInt32( L"\tObsolete1            \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.Obsolete1 );
+    Data += Format.StringUInt32( L"\tWriteBuffer          \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.WriteBuffer );
+    Data += Format.StringUInt32( L"\tReadBuffer           \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.ReadBuffer );
+    Data += Format.StringUInt32( L"\tNop                  \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.Nop );
+    Data += Format.StringUInt32( L"\tObsolete2            \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.Obsolete2 );
+    Data += Format.StringUInt32( L"\tDownloadMicrocode    \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.DownloadMicrocode );
+    Data += Format.StringUInt32( L"\tDmaQueued            \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.DmaQueued );
+    Data += Format.StringUInt32( L"\tCfa                  \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.Cfa );
+    Data += Format.StringUInt32( L"\tAdvancedPm           \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.AdvancedPm );
+    Data += Format.StringUInt32( L"\tMsn                  \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.Msn );
+    Data += Format.StringUInt32( L"\tPowerUpInStandby     \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.PowerUpInStandby );
+    Data += Format.StringUInt32( L"\tManualPowerUp        \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.ManualPowerUp );
+    Data += Format.StringUInt32( L"\tReserved2            \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.Reserved2 );
+    Data += Format.StringUInt32( L"\tSetMax               \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.SetMax );
+    Data += Format.StringUInt32( L"\tAcoustics            \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.Acoustics );
+    Data += Format.StringUInt32( L"\tBigLba               \t= %%1\r\n",
+                                pIDD->CommandSetSupport.BigLba );
+    Data += Format.StringUInt32( L"\tResrved3             \t= %%1\r\n",
+                                 pIDD->CommandSetSupport.Resrved3 );
+
+    Data += Format.StringUInt32( L"ReservedWord84             \t= %%1\r\n",
+                                 pIDD->ReservedWord84 );
+
+    Data += L"CommandSetActive:\r\n";
+    Data += Format.StringUInt32( L"\tSmartCommands        \t= %%1\r\n",
+                                 pIDD->CommandSetActive.SmartCommands );
+    Data += Format.StringUInt32( L"\tSecurityMode         \t= %%1\r\n",
+                                 pIDD->CommandSetActive.SecurityMode );
+    Data += Format.StringUInt32( L"\tRemovableMedia       \t= %%1\r\n",
+                                 pIDD->CommandSetActive.RemovableMedia );
+    Data += Format.StringUInt32( L"\tPowerManagement      \t= %%1\r\n",
+                                 pIDD->CommandSetActive.PowerManagement );
+    Data += Format.StringUInt32( L"\tReserved1            \t= %%1\r\n",
+                                 pIDD->CommandSetActive.Reserved1 );
+    Data += Format.StringUInt32( L"\tWriteCache           \t= %%1\r\n",
+                                 pIDD->CommandSetActive.WriteCache );
+    Data += Format.StringUInt32( L"\tLookAhead            \t= %%1\r\n",
+                                 pIDD->CommandSetActive.LookAhead );
+    Data += Format.StringUInt32( L"\tReleaseInterrupt     \t= %%1\r\n",
+                                 pIDD->CommandSetActive.ReleaseInterrupt );
+    Data += Format.StringUInt32( L"\tServiceInterrupt     \t= %%1\r\n",
+                                 pIDD->CommandSetActive.ServiceInterrupt );
+    Data += Format.StringUInt32( L"\tDeviceReset          \t= %%1\r\n",
+                                 pIDD->CommandSetActive.DeviceReset );
+    Data += Format.StringUInt32( L"\tHostProtectedArea    \t= %%1\r\n",
+                                 pIDD->CommandSetActive.HostProtectedArea );
+    Data += Format.StringUInt32( L"\tObsolete1            \t= %%1\r\n",
+                                 pIDD->CommandSetActive.Obsolete1 );
+    Data += Format.StringUInt32( L"\tWriteBuffer          \t= %%1\r\n",
+                                 pIDD->CommandSetActive.WriteBuffer );
+    Data += Format.StringUInt32( L"\tReadBuffer           \t= %%1\r\n",
+                                 pIDD->CommandSetActive.ReadBuffer );
+    Data += Format.StringUInt32( L"\tNop                  \t= %%1\r\n",
+                                 pIDD->CommandSetActive.Nop );
+    Data += Format.StringUInt32( L"\tObsolete2            \t= %%1\r\n",
+                                 pIDD->CommandSetActive.Obsolete2 );
+    Data += Format.StringUInt32( L"\tDownloadMicrocode    \t= %%1\r\n",
+                                 pIDD->CommandSetActive.DownloadMicrocode );
+    Data += Format.StringUInt32( L"\tDmaQueued            \t= %%1\r\n",
+                                 pIDD->CommandSetActive.DmaQueued );
+    Data += Format.StringUInt32( L"\tCfa                  \t= %%1\r\n",
+                                 pIDD->CommandSetActive.Cfa );
+    Data += Format.StringUInt32( L"\tAdvancedPm           \t= %%1\r\n",
+                                 pIDD->CommandSetActive.AdvancedPm );
+    Data += Format.StringUInt32( L"\tMsn                  \t= %%1\r\n",
+                                 pIDD->CommandSetActive.Msn );
+    Data += Format.StringUInt32( L"\tPowerUpInStandby     \t= %%1\r\n",
+                                 pIDD->CommandSetActive.PowerUpInStandby );
+    Data += Format.StringUInt32( L"\tManualPowerUp        \t= %%1\r\n",
+                                 pIDD->CommandSetActive.ManualPowerUp );
+    Data += Format.StringUInt32( L"\tReserved2            \t= %%1\r\n",
+                                 pIDD->CommandSetActive.Reserved2 );
+    Data += Format.StringUInt32( L"\tSetMax               \t= %%1\r\n",
+                                 pIDD->CommandSetActive.SetMax );
+    Data += Format.StringUInt32( L"\tAcoustics            \t= %%1\r\n",
+                                 pIDD->CommandSetActive.Acoustics );
+    Data += Format.StringUInt32( L"\tBigLba               \t= %%1\r\n",
+                                 pIDD->CommandSetActive.BigLba );
+    Data += Format.StringUInt32( L"\tResrved3             \t= %%1\r\n",
+                                 pIDD->CommandSetActive.Resrved3 );
+
+    Data += Format.StringUInt32( L"ReservedWord87             \t= %%1\r\n",
+                                 pIDD->ReservedWord87 );
+    Data += Format.StringUInt32( L"UltraDMASupport : 8        \t= %%1\r\n",
+                                 pIDD->UltraDMASupport );
+    Data += Format.StringUInt32( L"UltraDMAActive  : 8        \t= %%1\r\n",
+                                 pIDD->UltraDMAActive );
+
+    Data += L"ReservedWord89[4]:\r\n";
+    for ( i = 0; i < ARRAYSIZE( pIDD->ReservedWord89 ); i++ )
+    {
+       Data += Format.StringUInt32_2( L"\tReservedWord89[%%1]    \t= %%2\r\n",
+                                      i, pIDD->ReservedWord89[ i ] );
+    }
+
+    Data += Format.StringUInt32( L"HardwareResetResult        \t= %%1\r\n",
+                                 pIDD->HardwareResetResult );
+    Data += Format.StringUInt32( L"CurrentAcousticValue : 8   \t= %%1\r\n",
+                                 pIDD->CurrentAcousticValue );
+    Data += Format.StringUInt32( L"RecommendedAcousticValue:8 \t= %%1\r\n",
+                                 pIDD->RecommendedAcousticValue );
+
+    Data += L"ReservedWord95[5]:\r\n";
+    for ( i = 0; i < ARRAYSIZE( pIDD->ReservedWord95 ); i++ )
+    {
+       Data += Format.StringUInt32_2( L"\tReservedWord95[%%1]    \t= %%2\r\n",
+                                      i, pIDD->ReservedWord95[ i ] );
+    }
+
+    Data += L"Max48BitLBA[2]:\r\n";
+    Data += Format.StringUInt32( L"\tMax48BitLBA[0]       \t= %%1\r\n",
+                                 pIDD->Max48BitLBA[0] );
+    Data += Format.StringUInt32( L"\tMax48BitLBA[1]       \t= %%1\r\n",
+                                 pIDD->Max48BitLBA[1] );
+
+    Data += L"ReservedWord104[23]:\r\n";
+    for ( i = 0; i < ARRAYSIZE( pIDD->ReservedWord104 ); i++ )
+    {
+        Data += Format.StringUInt32_2( L"\tReservedWord104[%%1] \t= %%2\r\n",
+                                       i, pIDD->ReservedWord104[i] );
+    }
+
+    Data += Format.StringUInt32( L"MsnSupport : 2             \t= %%1\r\n",
+                                 pIDD->MsnSupport );
+    Data += Format.StringUInt32( L"ReservedWord127 : 14       \t= %%1\r\n",
+                                 pIDD->ReservedWord127 );
+    Data += Format.StringUInt32( L"SecurityStatus : 14        \t= %%1\r\n",
+                                 pIDD->SecurityStatus );
+
+    Data += L"ReservedWord129[126]:\r\n";
+    for ( i = 0; i < ARRAYSIZE( pIDD->ReservedWord129 ); i++ )
+    {
+        Data += Format.StringUInt32_2( L"\tReservedWord129[%%1] \t= %%2\r\n",
+                                       i, pIDD->ReservedWord129[i] );
+    }
+
+    Data += Format.StringUInt32( L"Signature : 8              \t= %%1\r\n",
+                                 pIDD->Signature );
+    Data += Format.StringUInt32( L"CheckSum : 8               \t= %%1\r\n",
+                                 pIDD->CheckSum );
+
+    *pFormattedIdd = Data;
+}
+
+//===============================================================================================//
+//  Description:
+//      Format an NVMe Identify Controller data structure as a string
+//
+//  Parameters:
+//      pIdentify    - pointer to the data structure
+//      bufferSize   - size of the buffer, must be at least 4096 bytes
+//      pTranslation - receives the formatted data
+//
+//  Remarks:
+//      Only the fields that identify the controller or describe its
+//      capacity and thermal limits are translated. Capacities are 128-bit
+//      values, the upper 64 bits are ignored.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DiskDataDecoder::FormatNvmeControllerData( const BYTE* pIdentify,
+                                                size_t bufferSize, String* pTranslation )
+{
+    DWORD     version = 0;
+    String    Data, Value;
+    Formatter Format;
+
+    if ( pTranslation == nullptr )
+    {
+        throw ParameterException( L"pTranslation", __FUNCTION__ );
+    }
+    *pTranslation = PXS_STRING_EMPTY;
+
+    if ( ( pIdentify == nullptr ) || ( bufferSize < NVME_IDENTIFY_SIZE ) )
+    {
+        return;     // Nothing to do
+    }
+    Data.Allocate( 2048 );
+
+    Data += L"Identify Controller Translation:\r\n";
+    Data += Format.StringUInt32Hex( L"PCI Vendor ID              \t= %%1\r\n",
+                                    MAKEWORD( pIdentify[ 0 ], pIdentify[ 1 ] ), true );
+    Data += Format.StringUInt32Hex( L"PCI Subsystem Vendor ID    \t= %%1\r\n",
+                                    MAKEWORD( pIdentify[ 2 ], pIdentify[ 3 ] ), true );
+
+    ExtractAsciiString( pIdentify + 4, 20, &Value );
+    Data += Format.String1( L"Serial Number              \t= %%1\r\n", Value );
+    ExtractAsciiString( pIdentify + 24, 40, &Value );
+    Data += Format.String1( L"Model Number               \t= %%1\r\n", Value );
+    ExtractAsciiString( pIdentify + 64, 8, &Value );
+    Data += Format.String1( L"Firmware Revision          \t= %%1\r\n", Value );
+
+    Data += Format.StringUInt32( L"Arbitration Burst          \t= %%1\r\n", pIdentify[ 72 ] );
+    Data += Format.StringUInt32Hex( L"IEEE OUI Identifier        \t= %%1\r\n",
+                                    static_cast<DWORD>( GetUInt64LE( pIdentify + 73, 3 ) ), true );
+    Data += Format.StringUInt32( L"Maximum Data Transfer Size \t= %%1\r\n", pIdentify[ 77 ] );
+    Data += Format.StringUInt32( L"Controller ID              \t= %%1\r\n",
+                                 MAKEWORD( pIdentify[ 78 ], pIdentify[ 79 ] ) );
+
+    version = static_cast<DWORD>( GetUInt64LE( pIdentify + 80, 4 ) );
+    Data += Format.StringUInt32_3( L"Version                    \t= %%1.%%2.%%3\r\n",
+                                   version >> 16, ( version >> 8 ) & 0xFF, version & 0xFF );
+    Data += Format.StringUInt32Hex( L"Optional Admin Commands    \t= %%1\r\n",
+                                    MAKEWORD( pIdentify[ 256 ], pIdentify[ 257 ] ), true );
+
+    TranslateKelvin( MAKEWORD( pIdentify[ 266 ], pIdentify[ 267 ] ), &Value );
+    Data += Format.String1( L"Warning Temperature        \t= %%1\r\n", Value );
+    TranslateKelvin( MAKEWORD( pIdentify[ 268 ], pIdentify[ 269 ] ), &Value );
+    Data += Format.String1( L"Critical Temperature       \t= %%1\r\n", Value );
+
+    Value = Format.StorageBytes( GetUInt64LE( pIdentify + 280, 8 ) );
+    Data += Format.String1( L"Total NVM Capacity         \t= %%1\r\n", Value );
+    Value = Format.StorageBytes( GetUInt64LE( pIdentify + 296, 8 ) );
+    Data += Format.String1( L"Unallocated NVM Capacity   \t= %%1\r\n", Value );
+    Data += Format.StringUInt32( L"Number of Namespaces       \t= %%1\r\n",
+                                 static_cast<DWORD>( GetUInt64LE( pIdentify + 516, 4 ) ) );
+
+    ExtractAsciiString( pIdentify + 768, 256, &Value );
+    Data += Format.String1( L"NVM Subsystem Qualified Name\t= %%1\r\n", Value );
+    Data += PXS_STRING_CRLF;
+
+    *pTranslation = Data;
+}
+
+//===============================================================================================//
+//  Description:
+//      Format an NVMe SMART/Health Information log page as a string
+//
+//  Parameters:
+//      pHealthLog   - pointer to the log page
+//      bufferSize   - size of the buffer, must be at least 512 bytes
+//      pTranslation - receives the formatted data
+//
+//  Remarks:
+//      The counters are 128-bit values, the upper 64 bits are ignored. A data
+//      unit is 1000 blocks of 512 bytes.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DiskDataDecoder::FormatNvmeHealthLog( const BYTE* pHealthLog,
+                                           size_t bufferSize, String* pTranslation )
+{
+    const UINT64 DATA_UNIT_BYTES = 512000;
+    BYTE      criticalWarning = 0;
+    WORD      kelvin = 0;
+    DWORD     i = 0;
+    UINT64    dataUnits = 0;
+    String    Data, Value;
+    Formatter Format;
+
+    if ( pTranslation == nullptr )
+    {
+        throw ParameterException( L"pTranslation", __FUNCTION__ );
+    }
+    *pTranslation = PXS_STRING_EMPTY;
+
+    if ( ( pHealthLog == nullptr ) || ( bufferSize < NVME_HEALTH_LOG_SIZE ) )
+    {
+        return;     // Nothing to do
+    }
+    Data.Allocate( 2048 );
+
+    Data += L"SMART/Health Log Translation:\r\n";
+    Data += L"Where appropriate 0 = false/no and 1 = true/yes.\r\n";
+    criticalWarning = pHealthLog[ 0 ];
+    Data += Format.StringUInt32Hex( L"Critical Warning           \t= %%1\r\n",
+                                    criticalWarning, true );
+    Data += Format.StringUInt32( L"\tSpare Below Threshold\t= %%1\r\n", criticalWarning & 0x01 );
+    Data += Format.StringUInt32( L"\tTemperature          \t= %%1\r\n",
+                                 ( criticalWarning >> 1 ) & 0x01 );
+    Data += Format.StringUInt32( L"\tReliability Degraded \t= %%1\r\n",
+                                 ( criticalWarning >> 2 ) & 0x01 );
+    Data += Format.StringUInt32( L"\tRead Only            \t= %%1\r\n",
+                                 ( criticalWarning >> 3 ) & 0x01 );
+    Data += Format.StringUInt32( L"\tVolatile Backup Fail \t= %%1\r\n",
+                                 ( criticalWarning >> 4 ) & 0x01 );
+
+    TranslateKelvin( MAKEWORD( pHealthLog[ 1 ], pHealthLog[ 2 ] ), &Value );
+    Data += Format.String1( L"Composite Temperature      \t= %%1\r\n", Value );
+    Data += Format.StringUInt32( L"Available Spare Percent    \t= %%1\r\n", pHealthLog[ 3 ] );
+    Data += Format.StringUInt32( L"Spare Threshold Percent    \t= %%1\r\n", pHealthLog[ 4 ] );
+    Data += Format.StringUInt32( L"Percentage Used            \t= %%1\r\n", pHealthLog[ 5 ] );
+
+    dataUnits = GetUInt64LE( pHealthLog + 32, 8 );
+    Data += Format.StringUInt64( L"Data Units Read            \t= %%1", dataUnits );
+    if ( dataUnits <= ( UINT64_MAX / DATA_UNIT_BYTES ) )
+    {
+        Value = Format.StorageBytes( dataUnits * DATA_UNIT_BYTES );
+        Data += Format.String1( L" (%%1)", Value );
+    }
+    Data += PXS_STRING_CRLF;
+
+    dataUnits = GetUInt64LE( pHealthLog + 48, 8 );
+    Data += Format.StringUInt64( L"Data Units Written         \t= %%1", dataUnits );
+    if ( dataUnits <= ( UINT64_MAX / DATA_UNIT_BYTES ) )
+    {
+        Value = Format.StorageBytes( dataUnits * DATA_UNIT_BYTES );
+        Data += Format.String1( L" (%%1)", Value );
+    }
+    Data += PXS_STRING_CRLF;
+
+    Data += Format.StringUInt64( L"Host Read Commands         \t= %%1\r\n",
+                                 GetUInt64LE( pHealthLog + 64, 8 ) );
+    Data += Format.StringUInt64( L"Host Write Commands        \t= %%1\r\n",
+                                 GetUInt64LE( pHealthLog + 80, 8 ) );
+    Data += Format.StringUInt64( L"Controller Busy Minutes    \t= %%1\r\n",
+                                 GetUInt64LE( pHealthLog + 96, 8 ) );
+    Data += Format.StringUInt64( L"Power Cycles               \t= %%1\r\n",
+                                 GetUInt64LE( pHealthLog + 112, 8 ) );
+    Data += Format.StringUInt64( L"Power On Hours             \t= %%1\r\n",
+                                 GetUInt64LE( pHealthLog + 128, 8 ) );
+    Data += Format.StringUInt64( L"Unsafe Shutdowns           \t= %%1\r\n",
+                                 GetUInt64LE( pHealthLog + 144, 8 ) );
+    Data += Format.StringUInt64( L"Media and Integrity Errors \t= %%1\r\n",
+                                 GetUInt64LE( pHealthLog + 160, 8 ) );
+    Data += Format.StringUInt64( L"Error Log Entries          \t= %%1\r\n",
+                                 GetUInt64LE( pHealthLog + 176, 8 ) );
+    Data += Format.StringUInt32( L"Warning Temperature Minutes\t= %%1\r\n",
+                                 static_cast<DWORD>( GetUInt64LE( pHealthLog + 192, 4 ) ) );
+    Data += Format.StringUInt32( L"Critical Temperature Mins  \t= %%1\r\n",
+                                 static_cast<DWORD>( GetUInt64LE( pHealthLog + 196, 4 ) ) );
+
+    // Eight optional temperature sensors, zero means not implemented
+    for ( i = 0; i < 8; i++ )
+    {
+        kelvin = MAKEWORD( pHealthLog[ 200 + ( 2 * i ) ], pHealthLog[ 201 + ( 2 * i ) ] );
+        if ( kelvin )
+        {
+            TranslateKelvin( kelvin, &Value );
+            Data += Format.StringUInt32( L"Temperature Sensor %%1       \t= ", i + 1 );
+            Data += Value;
+            Data += PXS_STRING_CRLF;
+        }
+    }
+    Data += PXS_STRING_CRLF;
+
+    *pTranslation = Data;
+}
+
+//===============================================================================================//
+//  Description:
+//      Format an NVMe Identify Namespace data structure as a string
+//
+//  Parameters:
+//      pIdentify    - pointer to the data structure
+//      bufferSize   - size of the buffer, must be at least 4096 bytes
+//      pTranslation - receives the formatted data
+//
+//  Remarks:
+//      Sizes are in logical blocks of the LBA format in use. The LBA format
+//      table starts at byte 128, 4 bytes per entry, up to 64 entries.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DiskDataDecoder::FormatNvmeNamespaceData( const BYTE* pIdentify,
+                                               size_t bufferSize, String* pTranslation )
+{
+    const DWORD MAX_LBA_FORMATS = 64;
+    DWORD     i = 0, numFormats = 0, formatIndex = 0, dataSize = 0;
+    String    Data;
+    Formatter Format;
+    const BYTE* pLbaFormat = nullptr;
+
+    if ( pTranslation == nullptr )
+    {
+        throw ParameterException( L"pTranslation", __FUNCTION__ );
+    }
+    *pTranslation = PXS_STRING_EMPTY;
+
+    if ( ( pIdentify == nullptr ) || ( bufferSize < NVME_IDENTIFY_SIZE ) )
+    {
+        return;     // Nothing to do
+    }
+    Data.Allocate( 2048 );
+
+    Data += L"Identify Namespace Translation:\r\n";
+    Data += Format.StringUInt64( L"Namespace Size             \t= %%1\r\n",
+                                 GetUInt64LE( pIdentify, 8 ) );
+    Data += Format.StringUInt64( L"Namespace Capacity         \t= %%1\r\n",
+                                 GetUInt64LE( pIdentify + 8, 8 ) );
+    Data += Format.StringUInt64( L"Namespace Utilization      \t= %%1\r\n",
+                                 GetUInt64LE( pIdentify + 16, 8 ) );
+    Data += Format.StringUInt32Hex( L"Namespace Features         \t= %%1\r\n",
+                                    pIdentify[ 24 ], true );
+
+    // The count is zero based, the index has two upper bits in bits 5 and 6
+    numFormats  = PXSMinUInt32( pIdentify[ 25 ] + 1UL, MAX_LBA_FORMATS );
+    formatIndex = ( pIdentify[ 26 ] & 0x0FUL ) | ( ( pIdentify[ 26 ] & 0x60UL ) >> 1 );
+    Data += Format.StringUInt32( L"Number of LBA Formats      \t= %%1\r\n", numFormats );
+    Data += Format.StringUInt32( L"Formatted LBA Size         \t= %%1\r\n", formatIndex );
+    for ( i = 0; i < numFormats; i++ )
+    {
+        pLbaFormat = pIdentify + 128 + ( 4 * i );
+        dataSize   = 0;
+        if ( pLbaFormat[ 2 ] < 32 )
+        {
+            dataSize = 1UL << pLbaFormat[ 2 ];
+        }
+        Data += Format.StringUInt32_3( L"\tLBA Format %%1 \t= Data %%2 bytes, Metadata %%3 bytes",
+                                       i, dataSize, MAKEWORD( pLbaFormat[ 0 ], pLbaFormat[ 1 ] ) );
+        Data += Format.StringUInt32( L", Relative Performance %%1", pLbaFormat[ 3 ] & 0x03 );
+        if ( i == formatIndex )
+        {
+            Data += L" (in use)";
+        }
+        Data += PXS_STRING_CRLF;
+    }
+    Data += PXS_STRING_CRLF;
+
+    *pTranslation = Data;
+}
+
+//===============================================================================================//
+//  Description:
+//      Read a disk data block from a file
+//
+//  Parameters:
+//      FilePath    - path to the file
+//      minimumSize - the minimum size of the data block in bytes
+//      pDataBlock  - receives the data
+//
+//  Remarks:
+//      The file is a raw binary capture as written by a disk utility, e.g.
+//      the output of an identify command. Any bytes beyond the data block
+//      are kept so the caller can decide what to use.
+//
+//  Returns:
+//      true if read at least minimumSize bytes, otherwise false
+//===============================================================================================//
+bool DiskDataDecoder::ReadDataBlockFile( const String& FilePath,
+                                         size_t minimumSize, ByteArray* pDataBlock )
+{
+    const UINT64 MAX_FILE_SIZE = 64 * 1024;
+    File      InputFile;
+    Formatter Format;
+
+    if ( pDataBlock == nullptr )
+    {
+        throw ParameterException( L"pDataBlock", __FUNCTION__ );
+    }
+    pDataBlock->Free();
+
+    InputFile.Open( FilePath, GENERIC_READ, FILE_SHARE_READ, 1, false );
+    if ( InputFile.GetSize() > MAX_FILE_SIZE )
+    {
+        PXSLogAppWarn1( L"Disk data block file '%%1' is too large.", FilePath );
+        return false;
+    }
+    InputFile.ReadAll( pDataBlock );
+    InputFile.Close();
+
+    if ( pDataBlock->GetSize() < minimumSize )
+    {
+        PXSLogAppWarn2( L"Disk data block file '%%1' has fewer than %%2 bytes.",
+                        FilePath, Format.SizeT( minimumSize ) );
+        pDataBlock->Free();
+        return false;
+    }
+
+    return true;
+}
+
+//===============================================================================================//
+//  Description:
+//      Attempt to identify the manufacturer of the physical disk
+//
+//  Parameters:
+//      Model - the model number
+//      pManufacturerName - receives the name of the manufacturer
+//
+//  Remarks:
+//      Be conservative, don't want to show an incorrect name.
+//      Use the model number to identify manufacturer
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DiskDataDecoder::ResolveManufacturer( const String& Model, String* pManufacturerName)
+{
+    if ( pManufacturerName == nullptr )
+    {
+        throw ParameterException( L"pManufacturerName", __FUNCTION__ );
+    }
+    *pManufacturerName = PXS_STRING_EMPTY;
+
+    // Check for the manufacturer's name in the model or serial numbers
+    if ( Model.IndexOfI( PXS_HDD_MANUFACTURER_FUJITSU ) != PXS_MINUS_ONE )
+    {
+        *pManufacturerName = PXS_HDD_MANUFACTURER_FUJITSU;
+    }
+    else if ( Model.IndexOfI( PXS_HDD_MANUFACTURER_HITACHI ) != PXS_MINUS_ONE )
+    {
+        *pManufacturerName = PXS_HDD_MANUFACTURER_HITACHI;
+    }
+    else if ( Model.IndexOfI( PXS_HDD_MANUFACTURER_MAXTOR ) != PXS_MINUS_ONE )
+    {
+        *pManufacturerName = PXS_HDD_MANUFACTURER_MAXTOR;
+    }
+    else if ( Model.IndexOfI( PXS_HDD_MANUFACTURER_SAMSUNG ) != PXS_MINUS_ONE )
+    {
+        *pManufacturerName = PXS_HDD_MANUFACTURER_SAMSUNG;
+    }
+    else if ( Model.IndexOfI( PXS_HDD_MANUFACTURER_SEAGATE ) != PXS_MINUS_ONE )
+    {
+        *pManufacturerName = PXS_HDD_MANUFACTURER_SEAGATE;
+    }
+    else if ( Model.IndexOfI( PXS_HDD_MANUFACTURER_WESTERN ) != PXS_MINUS_ONE )
+    {
+        *pManufacturerName = PXS_HDD_MANUFACTURER_WESTERN;
+    }
+    else if ( Model.StartsWith( L"ST", false ) )
+    {
+        // Seagate model numbers usually begin with "ST"
+        *pManufacturerName = PXS_HDD_MANUFACTURER_SEAGATE;
+    }
+    else if ( Model.StartsWith( L"WDC ", false ) )
+    {
+        // Western digital model numbers usually begin with "WDC "
+        *pManufacturerName = PXS_HDD_MANUFACTURER_WESTERN;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Protected Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Private Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Get a string from an ASCII field of an NVMe data structure
+//
+//  Parameters:
+//      pbData      - byte buffer holding the string data
+//      numBytes    - size of the field
+//      pDataString - string object to receive the data
+//
+//  Remarks:
+//      Unlike ATA, the bytes are in order. Fields are space padded but some
+//      are null terminated so stop at the first null.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DiskDataDecoder::ExtractAsciiString( const BYTE* pbData,
+                                          size_t numBytes, String* pDataString )
+{
+    if ( pDataString == nullptr )
+    {
+        throw ParameterException( L"pDataString", __FUNCTION__ );
+    }
+    *pDataString = PXS_STRING_EMPTY;
+
+    if ( pbData == nullptr )
+    {
+        return;
+    }
+
+    for ( size_t i = 0; i < numBytes; i++ )
+    {
+        if ( pbData[ i ] == 0 )
+        {
+            break;
+        }
+
+        // Replace non-printable characters with spaces
+        wchar_t ch = pbData[ i ];
+        if ( ( ch < 0x20 ) || ( ch > 0x7E ) )
+        {
+            ch = PXS_CHAR_SPACE;
+        }
+        *pDataString += ch;
+    }
+    pDataString->Trim();
+}
+
+//===============================================================================================//
+//  Description:
+//      Get an unsigned little-endian integer from a byte buffer
+//
+//  Parameters:
+//      pbData   - pointer to the first byte
+//      numBytes - number of bytes in the integer, at most 8 are used
+//
+//  Remarks:
+//      Used for the lower part of 128-bit counters as well
+//
+//  Returns:
+//      The value, zero if the buffer is NULL
+//===============================================================================================//
+UINT64 DiskDataDecoder::GetUInt64LE( const BYTE* pbData, size_t numBytes )
+{
+    UINT64 value = 0;
+
+    if ( pbData == nullptr )
+    {
+        return 0;
+    }
+
+    if ( numBytes > sizeof ( value ) )
+    {
+        numBytes = sizeof ( value );
+    }
+
+    for ( size_t i = numBytes; i > 0; i-- )
+    {
+        value = ( value << 8 ) | pbData[ i - 1 ];
+    }
+
+    return value;
+}
+
+//===============================================================================================//
+//  Description:
+//      Determine if the bytes of a block sum to zero, modulo 256
+//
+//  Parameters:
+//      pbData   - pointer to the block
+//      numBytes - size of the block
+//
+//  Remarks:
+//      The last byte of the ATA IDENTIFY DEVICE and SMART sectors is a check
+//      sum byte that makes the sum zero.
+//
+//  Returns:
+//      true if sums to zero, otherwise false
+//===============================================================================================//
+bool DiskDataDecoder::IsZeroSumBlock( const BYTE* pbData, size_t numBytes )
+{
+    BYTE sum = 0;
+
+    if ( pbData == nullptr )
+    {
+        return false;
+    }
+
+    for ( size_t i = 0; i < numBytes; i++ )
+    {
+        sum = static_cast<BYTE>( sum + pbData[ i ] );
+    }
+
+    return ( sum == 0 );
+}
+
+//===============================================================================================//
+//  Description:
+//      Make a physical disk audit record from ATA data blocks
+//
+//  Parameters:
+//      pIdentify    - the IDENTIFY DEVICE data, can be NULL
+//      identifySize - size of the IDENTIFY DEVICE data
+//      pSmart       - the SMART READ DATA, can be NULL
+//      smartSize    - size of the SMART data
+//      itemNumber   - the record's item number, counting starts at 1
+//      pRecord      - receives the data
+//
+//  Remarks:
+//      The capacity uses the 48-bit sector count when that feature set is
+//      enabled and the logical sector size when the disk reports one.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DiskDataDecoder::MakeAtaDiskRecord( const BYTE* pIdentify,
+                                         size_t identifySize,
+                                         const BYTE* pSmart,
+                                         size_t smartSize, size_t itemNumber, AuditRecord* pRecord )
+{
+    BYTE      selfTestStatus = 0;
+    WORD      sectorSizeInfo = 0;
+    UINT64    numSectors = 0, sectorBytes = 512;
+    String    MediaType, Model, SerialNumber, FirmwareRevision, ManufacturerName;
+    String    DiskSizeMB, DiskBufferKB, SmartSupported, SmartEnabled, SmartTestResult;
+    String    TotalCylinders, TotalHeads, SectorsPerTrack;
+    String    LocaleKB, LocaleMB, LocaleNo, LocaleYes;
+    Formatter Format;
+    PXSDDK::IDENTIFY_DEVICE_DATA IDD;
+
+    if ( pRecord == nullptr )
+    {
+        throw ParameterException( L"pRecord", __FUNCTION__ );
+    }
+    pRecord->Reset( PXS_CATEGORY_PHYS_DISKS );
+
+    PXSGetResourceString( PXS_IDS_136_MB  , &LocaleMB  );
+    PXSGetResourceString( PXS_IDS_135_KB  , &LocaleKB  );
+    PXSGetResourceString( PXS_IDS_1260_NO , &LocaleNo  );
+    PXSGetResourceString( PXS_IDS_1261_YES, &LocaleYes );
+
+    if ( pIdentify && ( identifySize >= sizeof ( IDD ) ) )
+    {
+        memcpy( &IDD, pIdentify, sizeof ( IDD ) );
+        if ( ( IDD.Signature == 0xA5 ) && ( IsZeroSumBlock( pIdentify, sizeof ( IDD ) ) == false ) )
+        {
+            PXSLogAppWarn( L"Invalid IDENTIFY DEVICE data check sum." );
+        }
+
+        // Word 217 is the nominal rotation rate, 1 means no rotation
+        MediaType = L"ATA";
+        if ( IDD.ReservedWord129[ 217 - 129 ] == 1 )
+        {
+            MediaType = L"ATA Solid State";
+        }
+        ExtractIddStringValue( IDD.ModelNumber, ARRAYSIZE( IDD.ModelNumber ), &Model );
+        ExtractIddStringValue( IDD.SerialNumber, ARRAYSIZE( IDD.SerialNumber ), &SerialNumber );
+        ExtractIddStringValue( IDD.FirmwareRevision,
+                               ARRAYSIZE( IDD.FirmwareRevision ), &FirmwareRevision );
+        ResolveManufacturer( Model, &ManufacturerName );
+
+        // Capacity, word 106 says if words 117-118 have the sector size in words
+        numSectors = IDD.UserAddressableSectors;
+        if ( IDD.CommandSetActive.BigLba )
+        {
+            numSectors = ( static_cast<UINT64>( IDD.Max48BitLBA[ 1 ] ) << 32 ) |
+                         IDD.Max48BitLBA[ 0 ];
+        }
+        sectorSizeInfo = IDD.ReservedWord104[ 106 - 104 ];
+        if ( ( ( sectorSizeInfo & 0xC000 ) == 0x4000 ) && ( sectorSizeInfo & 0x1000 ) )
+        {
+            sectorBytes = static_cast<DWORD>( MAKELONG( IDD.ReservedWord104[ 117 - 104 ],
+                                                        IDD.ReservedWord104[ 118 - 104 ] ) );
+            sectorBytes = 2 * sectorBytes;
+            if ( sectorBytes == 0 )
+            {
+                sectorBytes = 512;
+            }
+        }
+        DiskSizeMB  = Format.UInt64( ( numSectors * sectorBytes ) / ( 1024 * 1024 ) );
+        DiskSizeMB += LocaleMB;
+
+        if ( IDD.Retired2[ 1 ] > 0 )
+        {
+            DiskBufferKB  = Format.UInt16( IDD.Retired2[ 1 ] );
+            DiskBufferKB += LocaleKB;
+        }
+
+        SmartSupported = LocaleNo;
+        if ( IDD.CommandSetSupport.SmartCommands )
+        {
+            SmartSupported = LocaleYes;
+        }
+
+        SmartEnabled = LocaleNo;
+        if ( IDD.CommandSetActive.SmartCommands )
+        {
+            SmartEnabled = LocaleYes;
+        }
+        TotalCylinders  = Format.UInt16( IDD.NumCylinders );
+        TotalHeads      = Format.UInt16( IDD.NumHeads );
+        SectorsPerTrack = Format.UInt16( IDD.NumSectorsPerTrack );
+    }
+
+    // Self-test execution status, 3 to 8 mean a test failed
+    if ( pSmart && ( smartSize >= ATA_SECTOR_SIZE ) )
+    {
+        if ( IsZeroSumBlock( pSmart, ATA_SECTOR_SIZE ) == false )
+        {
+            PXSLogAppWarn( L"Invalid SMART data check sum." );
+        }
+
+        selfTestStatus = static_cast<BYTE>( pSmart[ 363 ] >> 4 );
+        if ( selfTestStatus == 0 )
+        {
+            SmartTestResult = L"OK";
+        }
+        else if ( ( selfTestStatus >= 3 ) && ( selfTestStatus <= 8 ) )
+        {
+            SmartTestResult = Format.StringUInt32( L"Failed with code %%1", selfTestStatus );
+        }
+    }
+
+    pRecord->Add( PXS_PHYS_DISKS_ITEM_NUMBER    , Format.SizeT( itemNumber ) );
+    pRecord->Add( PXS_PHYS_DISKS_CAPACITY_MB    , DiskSizeMB );
+    pRecord->Add( PXS_PHYS_DISKS_TYPE           , MediaType );
+    pRecord->Add( PXS_PHYS_DISKS_MANUFACTURER   , ManufacturerName );
+    pRecord->Add( PXS_PHYS_DISKS_MODEL          , Model );
+    pRecord->Add( PXS_PHYS_DISKS_SERIAL_NUMBER  , SerialNumber );
+    pRecord->Add( PXS_PHYS_DISKS_FIRMWARE_REV   , FirmwareRevision );
+    pRecord->Add( PXS_PHYS_DISKS_CONTROL_RANK   , PXS_STRING_EMPTY );
+    pRecord->Add( PXS_PHYS_DISKS_MASTER_SLAVE   , PXS_STRING_EMPTY );
+    pRecord->Add( PXS_PHYS_DISKS_TOTAL_CYLINDERS, TotalCylinders );
+    pRecord->Add( PXS_PHYS_DISKS_TOTAL_HEADS    , TotalHeads );
+    pRecord->Add( PXS_PHYS_DISKS_SECTORS_PER_TRK, SectorsPerTrack );
+    pRecord->Add( PXS_PHYS_DISKS_BUFFER_KB      , DiskBufferKB );
+    pRecord->Add( PXS_PHYS_DISKS_SMART_SUPPORTED, SmartSupported );
+    pRecord->Add( PXS_PHYS_DISKS_SMART_ENABLED  , SmartEnabled );
+    pRecord->Add( PXS_PHYS_DISKS_SMART_SELF_TEST, SmartTestResult );
+    pRecord->Add( PXS_PHYS_DISKS_CRITICAL_WARN  , PXS_STRING_EMPTY );
+}
+
+//===============================================================================================//
+//  Description:
+//      Make a physical disk audit record from NVMe data blocks
+//
+//  Parameters:
+//      pController    - the Identify Controller data, can be NULL
+//      controllerSize - size of the Identify Controller data
+//      pNamespace     - the Identify Namespace data, can be NULL
+//      namespaceSize  - size of the Identify Namespace data
+//      pHealthLog     - the SMART/Health Information log page, can be NULL
+//      healthLogSize  - size of the log page
+//      itemNumber     - the record's item number, counting starts at 1
+//      pRecord        - receives the data
+//
+//  Remarks:
+//      The capacity is the controller's total NVM capacity, which is
+//      optional, else the size of the namespace. The health log is mandatory
+//      so SMART is always supported and enabled. The health log has no self
+//      test result, its critical warning bits are a separate item.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DiskDataDecoder::MakeNvmeDiskRecord( const BYTE* pController,
+                                          size_t controllerSize,
+                                          const BYTE* pNamespace,
+                                          size_t namespaceSize,
+                                          const BYTE* pHealthLog,
+                                          size_t healthLogSize,
+                                          size_t itemNumber, AuditRecord* pRecord )
+{
+    BYTE      formatIndex = 0, lbaDataSize = 0;
+    UINT64    capacityBytes = 0, numBlocks = 0;
+    String    Model, SerialNumber, FirmwareRevision, ManufacturerName;
+    String    DiskSizeMB, CriticalWarning, LocaleMB, LocaleYes;
+    Formatter Format;
+
+    if ( pRecord == nullptr )
+    {
+        throw ParameterException( L"pRecord", __FUNCTION__ );
+    }
+    pRecord->Reset( PXS_CATEGORY_PHYS_DISKS );
+
+    PXSGetResourceString( PXS_IDS_136_MB  , &LocaleMB  );
+    PXSGetResourceString( PXS_IDS_1261_YES, &LocaleYes );
+
+    if ( pController && ( controllerSize >= NVME_IDENTIFY_SIZE ) )
+    {
+        ExtractAsciiString( pController + 4 , 20, &SerialNumber );
+        ExtractAsciiString( pController + 24, 40, &Model );
+        ExtractAsciiString( pController + 64,  8, &FirmwareRevision );
+        ResolveManufacturer( Model, &ManufacturerName );
+        capacityBytes = GetUInt64LE( pController + 280, 8 );
+    }
+
+    if ( ( capacityBytes == 0 ) && pNamespace && ( namespaceSize >= NVME_IDENTIFY_SIZE ) )
+    {
+        formatIndex = static_cast<BYTE>( ( pNamespace[ 26 ] & 0x0F ) |
+                                         ( ( pNamespace[ 26 ] & 0x60 ) >> 1 ) );
+        if ( formatIndex <= pNamespace[ 25 ] )
+        {
+            lbaDataSize = pNamespace[ 128 + ( 4 * formatIndex ) + 2 ];
+            // NSZE is in logical blocks of 2^LBADS bytes, do not let it overflow
+            numBlocks = GetUInt64LE( pNamespace, 8 );
+            if ( ( lbaDataSize < 64 ) && ( numBlocks <= ( UINT64_MAX >> lbaDataSize ) ) )
+            {
+                capacityBytes = numBlocks << lbaDataSize;
+            }
+        }
+    }
+
+    if ( capacityBytes )
+    {
+        DiskSizeMB  = Format.UInt64( capacityBytes / ( 1024 * 1024 ) );
+        DiskSizeMB += LocaleMB;
+    }
+
+    if ( pHealthLog && ( healthLogSize >= NVME_HEALTH_LOG_SIZE ) )
+    {
+        if ( pHealthLog[ 0 ] == 0 )
+        {
+            CriticalWarning = L"None";
+        }
+        else
+        {
+            CriticalWarning = Format.StringUInt32Hex( L"%%1", pHealthLog[ 0 ], true );
+        }
+    }
+
+    pRecord->Add( PXS_PHYS_DISKS_ITEM_NUMBER    , Format.SizeT( itemNumber ) );
+    pRecord->Add( PXS_PHYS_DISKS_CAPACITY_MB    , DiskSizeMB );
+    pRecord->Add( PXS_PHYS_DISKS_TYPE           , L"NVMe" );
+    pRecord->Add( PXS_PHYS_DISKS_MANUFACTURER   , ManufacturerName );
+    pRecord->Add( PXS_PHYS_DISKS_MODEL          , Model );
+    pRecord->Add( PXS_PHYS_DISKS_SERIAL_NUMBER  , SerialNumber );
+    pRecord->Add( PXS_PHYS_DISKS_FIRMWARE_REV   , FirmwareRevision );
+    pRecord->Add( PXS_PHYS_DISKS_CONTROL_RANK   , PXS_STRING_EMPTY );
+    pRecord->Add( PXS_PHYS_DISKS_MASTER_SLAVE   , PXS_STRING_EMPTY );
+    pRecord->Add( PXS_PHYS_DISKS_TOTAL_CYLINDERS, PXS_STRING_EMPTY );
+    pRecord->Add( PXS_PHYS_DISKS_TOTAL_HEADS    , PXS_STRING_EMPTY );
+    pRecord->Add( PXS_PHYS_DISKS_SECTORS_PER_TRK, PXS_STRING_EMPTY );
+    pRecord->Add( PXS_PHYS_DISKS_BUFFER_KB      , PXS_STRING_EMPTY );
+    pRecord->Add( PXS_PHYS_DISKS_SMART_SUPPORTED, LocaleYes );
+    pRecord->Add( PXS_PHYS_DISKS_SMART_ENABLED  , LocaleYes );
+    pRecord->Add( PXS_PHYS_DISKS_SMART_SELF_TEST, PXS_STRING_EMPTY );
+    pRecord->Add( PXS_PHYS_DISKS_CRITICAL_WARN  , CriticalWarning );
+}
+
+//===============================================================================================//
+//  Description:
+//      Translate an NVMe temperature in Kelvin
+//
+//  Parameters:
+//      kelvin       - the temperature, zero means not reported
+//      pTemperature - receives the translation e.g. 310 K (37 C)
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void DiskDataDecoder::TranslateKelvin( WORD kelvin, String* pTemperature )
+{
+    Formatter Format;
+
+    if ( pTemperature == nullptr )
+    {
+        throw ParameterException( L"pTemperature", __FUNCTION__ );
+    }
+    *pTemperature = PXS_STRING_EMPTY;
+
+    if ( kelvin == 0 )
+    {
+        return;
+    }
+    *pTemperature  = Format.UInt16( kelvin );
+    *pTemperature += L" K (";
+    *pTemperature += Format.Int32( kelvin - 273 );
+    *pTemperature += L" C)";
+}
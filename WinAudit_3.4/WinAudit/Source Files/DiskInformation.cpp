@@ -59,6 +59,7 @@
 
 // 5. This Project
 #include "WinAudit/Header Files/AuditRecord.h"
+#include "WinAudit/Header Files/DiskDataDecoder.h"
 #include "WinAudit/Header Files/WindowsInformation.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -71,6 +72,9 @@
 
 // Default constructor
 DiskInformation::DiskInformation()
+                :m_bWmiDiskDataLoaded( false ),
+                 m_WmiDiskDrives(),
+                 m_WmiPhysicalMedia()
 {
 }
 
@@ -91,6 +95,42 @@ DiskInformation::~DiskInformation()
 // Public Methods
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+//===============================================================================================//
+//  Description:
+//      Find the cached WMI row of a physical drive
+//
+//  Parameters:
+//      physicalDrive - the OS drive number, e.g. PhysicalDrive#
+//      Rows          - the cached rows, the first value is the device id
+//
+//  Remarks:
+//      Win32_DiskDrive.DeviceID and Win32_PhysicalMedia.Tag are both of the
+//      form \\.\PHYSICALDRIVE#
+//
+//  Returns:
+//      Pointer to the row, NULL if not found
+//===============================================================================================//
+const StringArray* DiskInformation::FindWmiDiskRow( BYTE physicalDrive,
+                                                    const TArray< StringArray >& Rows )
+{
+    String    DeviceID;
+    Formatter Format;
+
+    DeviceID  = L"\\\\.\\PHYSICALDRIVE";
+    DeviceID += Format.UInt8( physicalDrive );
+    size_t numRows = Rows.GetSize();
+    for ( size_t i = 0; i < numRows; i++ )
+    {
+        const StringArray* pRow = Rows.GetPtr( i );
+        if ( pRow->GetSize() && ( DeviceID.CompareI( pRow->Get( 0 ) ) == 0 ) )
+        {
+            return pRow;
+        }
+    }
+
+    return nullptr;
+}
+
 //===============================================================================================//
 //  Description:
 //      Get a information about the disk devices
@@ -407,7 +447,7 @@ void DiskInformation::GetAuditRecords( TArray< AuditRecord >* pRecords )
                     SerialHex = SerialHexIdd;
                 }
             }
-            DiskSerialHexToSerialNumber( SerialHex, &SerialNumber );
+            DiskDataDecoder::DiskSerialHexToSerialNumber( SerialHex, &SerialNumber );
 
             // Firmware revision
             if ( FirmwareRevision.IsEmpty() && haveIddData )
@@ -436,7 +476,7 @@ void DiskInformation::GetAuditRecords( TArray< AuditRecord >* pRecords )
 
             if ( ManufacturerName.IsEmpty() )
             {
-                ResolveManufacturer( Model, &ManufacturerName );
+                DiskDataDecoder::ResolveManufacturer( Model, &ManufacturerName );
             }
 
             DiskSizeMB    = Format.UInt64( diskSizeBytes / ( 1024 * 1024 ) );
@@ -494,691 +534,238 @@ void DiskInformation::GetAuditRecords( TArray< AuditRecord >* pRecords )
             Record.Add( PXS_PHYS_DISKS_SMART_SUPPORTED, LocaleSmartSupported );
             Record.Add( PXS_PHYS_DISKS_SMART_ENABLED  , LocaleSmartEnabled );
             Record.Add( PXS_PHYS_DISKS_SMART_SELF_TEST, SmartTestResult );
+            Record.Add( PXS_PHYS_DISKS_CRITICAL_WARN  , PXS_STRING_EMPTY );
             pRecords->Add( Record );
         }
     }
 }
 
-///////////////////////////////////////////////////////////////////////////////////////////////////
-// Protected Methods
-///////////////////////////////////////////////////////////////////////////////////////////////////
-
-///////////////////////////////////////////////////////////////////////////////////////////////////
-// Private Methods
-///////////////////////////////////////////////////////////////////////////////////////////////////
-
 //===============================================================================================//
 //  Description:
-//      Use CreateFile to get a handle to the specified disk path
+//      Get the disk number used by the controller from the WMI disk rows
 //
 //  Parameters:
-//      DiskName - the disk name, e.g. 
+//      physicalDrive - the OS drive number, e.g. PhysicalDrive#
+//      DiskDrives    - the Win32_DiskDrive rows, see the WMI_DISK_ constants
+//      pDiskNumber   - receives the disk number, UINT8_MAX if not known
 //
 //  Remarks:
-//      The caller must fre the created handle if it is valid
+//      Two disks per SCSI port with the primary at target id 0 and the
+//      secondary at target id 1.
 //
 //  Returns:
-//      Handle to the disk, INVALID_HANDLE_VALUE (-1) on fail
+//      true on success, otherwise false
 //===============================================================================================//
-HANDLE DiskInformation::CreateDiskHandle( const String& DiskName )
+bool DiskInformation::GetWmiDiskNumber( BYTE physicalDrive,
+                                        const TArray< StringArray >& DiskDrives,
+                                        BYTE* pDiskNumber )
 {
-    DWORD  error;
-    HANDLE hDisk;
+    int       number = 0;
+    String    ScsiPort, ScsiTargetId;
+    Formatter Format;
+    const StringArray* pDisk = nullptr;
 
-    if ( DiskName.GetLength() == 0 )
+    if ( pDiskNumber == nullptr )
     {
-        throw ParameterException( L"DiskName", __FUNCTION__ );
+        throw ParameterException( L"pDiskNumber", __FUNCTION__ );
     }
+    *pDiskNumber = UINT8_MAX;    // = -1
 
-    // MSDN "Device Handles" says should use FILE_SHARE_READ | FILE_SHARE_WRITE
-    // and OPEN_EXISTING. Will first try dwDesiredAccess as GENERIC_READ | GENERIC_WRITE
-    // for admin privileges. Can sometimes get ERROR_ACCESS_DENIED
-    hDisk = CreateFile( DiskName.c_str(),
-                        GENERIC_READ | GENERIC_WRITE,
-                        FILE_SHARE_READ | FILE_SHARE_WRITE,
-                        nullptr, OPEN_EXISTING, 0, nullptr );
-    if ( hDisk != INVALID_HANDLE_VALUE )
+    pDisk = FindWmiDiskRow( physicalDrive, DiskDrives );
+    if ( ( pDisk == nullptr ) || ( pDisk->GetSize() <= WMI_DISK_SCSI_TARGET_ID ) )
     {
-        return hDisk;
+        return false;
     }
-
-    // Test for no such disk
-    error = GetLastError();
-    if ( error == ERROR_FILE_NOT_FOUND )
+    ScsiPort     = pDisk->Get( WMI_DISK_SCSI_PORT );
+    ScsiTargetId = pDisk->Get( WMI_DISK_SCSI_TARGET_ID );
+    if ( ( ScsiPort.GetLength() == 0 ) || ( ScsiTargetId.GetLength() == 0 ) )
     {
-        return INVALID_HANDLE_VALUE;
+        return false;
     }
 
-    // Try as standard user
-    hDisk = CreateFile( DiskName.c_str(),
-                        0,
-                        FILE_SHARE_READ | FILE_SHARE_WRITE,
-                        nullptr, OPEN_EXISTING, 0, nullptr );
-    if ( hDisk != INVALID_HANDLE_VALUE )
+    number = PXSMultiplyInt32( 2, Format.StringToInt32( ScsiPort ) );
+    number = PXSAddInt32( number, Format.StringToInt32( ScsiTargetId ) );
+    if ( ( number < 0 ) || ( number >= 256 ) )
     {
-        return hDisk;
+        return false;
     }
+    *pDiskNumber = PXSCastInt32ToUInt8( number );
 
-    // Fail
-    PXSLogSysWarn1( GetLastError(), L"CreateFile failed for '%%1'.", DiskName );
-    return INVALID_HANDLE_VALUE;
+    return true;
 }
 
 //===============================================================================================//
 //  Description:
-//      Convert a hex format (raw) disk serial number to a display string
+//      Get the data of a physical drive from the WMI disk rows
 //
 //  Parameters:
-//      SerialHex     - hex string of the serial number
-//      pSerialNumber - receives the diplay string
+//      physicalDrive     - the OS drive number, e.g. PhysicalDrive#
+//      DiskDrives        - the Win32_DiskDrive rows, see the WMI_DISK_ constants
+//      PhysicalMedia     - the Win32_PhysicalMedia Tag and SerialNumber rows
+//      pDiskSizeBytes    - receives the disk size in bytes
+//      pTotalCylinders   - receives the total number of cylinders
+//      pTotalHeads       - receives the total number of heads
+//      pSectorsPerTrack  - receives the sectors per track
+//      pMediaType        - receives the media type, e.g disk, tape etc.
+//      pManufacturerName - receives the manufacturer name
+//      pModel            - receives the model number
+//      pSerialNumber     - receives the serial number
+//      pFirmwareRevision - receives the firmware revision
 //
 //  Remarks:
-//      Normally the serial number is a hex represention of character swapped
-//      ASCII e.g.
-//      30534538314a414f323132353738202020202020
-//      0 S E 8 1 J A O 2 1 2 5 7 8
-//      S08EJ1OA125287
-//      However, if this does not seem to be the case will return the raw data
+//      The serial number and firmware revision columns are only present on
+//      Vista and newer. A row with fewer columns than that is treated as
+//      missing.
+//
+//      Win32_DiskDrive may return a string that requires byte swapping.
+//      However, Win32_PhysicalMedia seems to return an already byte swapped
+//      string so it is preferred when not blank.
 //
 //  Returns:
-//      void
+//      true if the drive has a row, otherwise false
 //===============================================================================================//
-void DiskInformation::DiskSerialHexToSerialNumber( const String& SerialHex, String* pSerialNumber )
+bool DiskInformation::GetWmiDiskValues( BYTE physicalDrive,
+                                        const TArray< StringArray >& DiskDrives,
+                                        const TArray< StringArray >& PhysicalMedia,
+                                        UINT64* pDiskSizeBytes,
+                                        UINT64* pTotalCylinders,
+                                        DWORD*  pTotalHeads,
+                                        DWORD*  pSectorsPerTrack,
+                                        String* pMediaType,
+                                        String* pManufacturerName,
+                                        String* pModel,
+                                        String* pSerialNumber, String* pFirmwareRevision )
 {
-    bool      swap = true;   // Assume will swap characters
-    String    HexByte;
+    String    Value;
     Formatter Format;
+    const StringArray* pDisk  = nullptr;
+    const StringArray* pMedia = nullptr;
 
-    if ( pSerialNumber == nullptr )
+    if ( ( pDiskSizeBytes    == nullptr ) ||
+         ( pTotalCylinders   == nullptr ) ||
+         ( pTotalHeads       == nullptr ) ||
+         ( pSectorsPerTrack  == nullptr ) ||
+         ( pMediaType        == nullptr ) ||
+         ( pManufacturerName == nullptr ) ||
+         ( pModel            == nullptr ) ||
+         ( pSerialNumber     == nullptr ) ||
+         ( pFirmwareRevision == nullptr )  )
     {
-        throw ParameterException( L"pSerialNumber", __FUNCTION__ );
+        throw ParameterException( L"pDiskSizeBytes...", __FUNCTION__ );
     }
-    *pSerialNumber = PXS_STRING_EMPTY;
 
-    size_t lenChars = SerialHex.GetLength();
-    if ( lenChars == 0 )
-    {
-        return;     // Nothing to do
-    }
+    *pDiskSizeBytes    = 0;
+    *pTotalCylinders   = 0,
+    *pTotalHeads       = 0,
+    *pSectorsPerTrack  = 0,
+    *pMediaType        = PXS_STRING_EMPTY;
+    *pManufacturerName = PXS_STRING_EMPTY;
+    *pModel            = PXS_STRING_EMPTY;
+    *pSerialNumber     = PXS_STRING_EMPTY;
+    *pFirmwareRevision = PXS_STRING_EMPTY;
 
-    // Must be an divisble by 4 for character swapping
-    lenChars = SerialHex.GetLength();
-    if ( lenChars % 4 )
+    // Win32_DiskDrive, the device id is recognised so drive exists
+    pDisk = FindWmiDiskRow( physicalDrive, DiskDrives );
+    if ( ( pDisk == nullptr ) || ( pDisk->GetSize() <= WMI_DISK_SCSI_TARGET_ID ) )
     {
-        swap = false;
-        PXSLogAppWarn( L"HDD serial number length not multiple of 4." );
+        return false;
     }
+    Value = pDisk->Get( WMI_DISK_SIZE );
+    *pDiskSizeBytes = Format.StringToUInt64( Value );
+    Value = pDisk->Get( WMI_DISK_TOTAL_CYLINDERS );
+    *pTotalCylinders = Format.StringToUInt64( Value );
+    Value = pDisk->Get( WMI_DISK_TOTAL_HEADS );
+    *pTotalHeads = Format.StringToUInt32( Value );
+    Value = pDisk->Get( WMI_DISK_SECTORS_PER_TRACK );
+    *pSectorsPerTrack  = Format.StringToUInt32( Value );
+    *pMediaType        = pDisk->Get( WMI_DISK_MEDIA_TYPE );
+    *pManufacturerName = pDisk->Get( WMI_DISK_MANUFACTURER );
+    *pModel            = pDisk->Get( WMI_DISK_MODEL );
 
-    // Scan the string for unexpected characters
-    for ( size_t i = 0; i < lenChars; i++ )
+    // These are available from Vista onwards
+    if ( pDisk->GetSize() > WMI_DISK_FIRMWARE_REVISION )
     {
-        wchar_t ch = SerialHex.CharAt( i );
-        if ( PXSIsHexitW( ch ) == false )
-        {
-            swap = false;
-            PXSLogAppWarn( L"HDD serial number has non-hexadecimal chars." );
-            break;
-        }
+        *pSerialNumber     = pDisk->Get( WMI_DISK_SERIAL_NUMBER );
+        *pFirmwareRevision = pDisk->Get( WMI_DISK_FIRMWARE_REVISION );
     }
 
-    // Sometimes the hex string has non-printable (< 0x20) characters. Perhaps
-    // the disk's manufacturer intended the serial number to be shown
-    // in hex format.
-    for ( size_t i = 0; i < lenChars; i+=2 )  // NB lenChars is even
+    pMedia = FindWmiDiskRow( physicalDrive, PhysicalMedia );
+    if ( pMedia && ( pMedia->GetSize() > 1 ) )
     {
-        // Test the first hexit of each 2-hexit byte
-        wchar_t ch = SerialHex.CharAt( i );
-        if ( ch < '1' )
+        Value = pMedia->Get( 1 );
+        Value.Trim();
+        if ( Value.GetLength() )
         {
-            swap = false;
-            PXSLogAppWarn( L"HDD serial number has non-printable chars." );
-            break;
+            *pSerialNumber = Value;
         }
     }
 
-    // If no reversal, return the input string
-    if ( swap == false )
-    {
-        *pSerialNumber = SerialHex;
-        return;
-    }
-
-    // Swap the hex pairs
-    for ( size_t i = 0; i < (lenChars - 3); i += 4 )  // NB lenChars is > 3 and even
-    {
-        HexByte      = SerialHex.CharAt( i + 2 );
-        HexByte     += SerialHex.CharAt( i + 3 );
-        DWORD number = Format.HexStringToNumber( HexByte );
-        pSerialNumber->AppendChar( 0xFF & number, 1 );
-
-        HexByte  = SerialHex.CharAt( i );
-        HexByte += SerialHex.CharAt( i + 1 );
-        number   = Format.HexStringToNumber( HexByte );
-        pSerialNumber->AppendChar( 0xFF & number, 1 );
-    }
-    pSerialNumber->Trim();      // Often the data is padded with spaces.
+    return true;
 }
 
-//===============================================================================================//
-//  Description:
-//      Get a string from an IDENTIFY_DEVICE_DATA structure
-//
-//  Parameters:
-//      pbData      - byte buffer holding the string data
-//      numBytes    - size of the buffer
-//      pDataString - string object to receive the data
-//
-//  Remarks:
-//      String data is in bytes that need reversing
-//
-//  Returns:
-//      true if got data, else false
-//===============================================================================================//
-bool DiskInformation::ExtractIddStringValue( const BYTE* pbData,
-                                             size_t numBytes, String* pDataString )
-{
-    if ( pDataString == nullptr )
-    {
-        throw ParameterException( L"pDataString", __FUNCTION__ );
-    }
-    pDataString->Allocate( 128 );        // Only expecting short strings
-    *pDataString = PXS_STRING_EMPTY;
-
-    if ( ( pbData == nullptr ) || ( numBytes == 0 ) )
-    {
-        return false;
-    }
-
-    // Add bytes to string, make sure only going up to an even number of bytes
-    numBytes = ( numBytes / 2 ) * 2;
-    for ( DWORD i = 0; i < numBytes; i++ )
-    {
-        // Reverse bytes
-        wchar_t ch;
-        if ( ( i % 2 ) == 0 )
-        {
-            ch = pbData[ i + 1 ];
-        }
-        else
-        {
-            ch = pbData[ i - 1 ];
-        }
-
-        // Replace white spaces with spaces
-        if ( PXSIsWhiteSpace( ch ) )
-        {
-            ch = PXS_CHAR_SPACE;
-        }
-        *pDataString += ch;
-    }
-    pDataString->Trim();
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Protected Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
 
-    return true;
-}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Private Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
 
 //===============================================================================================//
 //  Description:
-//      Format the IDENTIFY_DEVICE_DATA structure as a string
+//      Use CreateFile to get a handle to the specified disk path
 //
 //  Parameters:
-//      pIDD       - pointer to the IDENTIFY_DEVICE_DATA structure
-//      pIddString - receives the formatted data
+//      DiskName - the disk name, e.g. 
 //
 //  Remarks:
-//      ulBufferSize should normally be 512
+//      The caller must fre the created handle if it is valid
 //
 //  Returns:
-//      void
+//      Handle to the disk, INVALID_HANDLE_VALUE (-1) on fail
 //===============================================================================================//
-void DiskInformation::FormatDiskFirmwareDataBlock( const PXSDDK::IDENTIFY_DEVICE_DATA* pIDD,
-                                                   String* pIddString )
+HANDLE DiskInformation::CreateDiskHandle( const String& DiskName )
 {
-    ULONG     i = 0;
-    String    FormattedIdd;
-    Formatter Format;
-    const BYTE* pBytes = nullptr;
+    DWORD  error;
+    HANDLE hDisk;
 
-    if ( pIddString == nullptr )
+    if ( DiskName.GetLength() == 0 )
     {
-        throw ParameterException( L"pIddString", __FUNCTION__ );
+        throw ParameterException( L"DiskName", __FUNCTION__ );
     }
-    pIddString->Allocate( 4096 );
-    *pIddString = PXS_STRING_EMPTY;
 
-    if ( pIDD == nullptr )
+    // MSDN "Device Handles" says should use FILE_SHARE_READ | FILE_SHARE_WRITE
+    // and OPEN_EXISTING. Will first try dwDesiredAccess as GENERIC_READ | GENERIC_WRITE
+    // for admin privileges. Can sometimes get ERROR_ACCESS_DENIED
+    hDisk = CreateFile( DiskName.c_str(),
+                        GENERIC_READ | GENERIC_WRITE,
+                        FILE_SHARE_READ | FILE_SHARE_WRITE,
+                        nullptr, OPEN_EXISTING, 0, nullptr );
+    if ( hDisk != INVALID_HANDLE_VALUE )
     {
-        return;     // Nothing to do
+        return hDisk;
     }
 
-    // Write out as an line of bytes
-    pBytes     = reinterpret_cast<const BYTE*>( pIDD );
-    *pIddString += L"0000:";
-    for ( i = 0; i < sizeof ( PXSDDK::IDENTIFY_DEVICE_DATA ); i++ )
+    // Test for no such disk
+    error = GetLastError();
+    if ( error == ERROR_FILE_NOT_FOUND )
     {
-        // Make the line start
-        if ( ( i != 0 ) && ( ( i % 16 ) == 0 ) )
-        {
-            *pIddString += PXS_STRING_CRLF;
-            if ( i < 99 )
-            {
-                // e.g. 0032:
-                *pIddString += Format.StringUInt32( L"00%%1:", i );
-            }
-            else
-            {
-                // >= 100, // e.g. 0128:
-                *pIddString += Format.StringUInt32( L"0%%1:", i );
-            }
-        }
-
-        // Write the bytes
-        *pIddString += Format.UInt8Hex( pBytes[ i ], false );
-        *pIddString += PXS_CHAR_SPACE;
+        return INVALID_HANDLE_VALUE;
     }
-    *pIddString += PXS_STRING_CRLF;
 
-    // Translation the data structure.
-    FormatIddStructureAsString( pIDD, &FormattedIdd );
-    *pIddString += PXS_STRING_CRLF;
-    *pIddString += L"Data Block Translation:\r\n";
-    *pIddString += FormattedIdd;
-    *pIddString += PXS_STRING_CRLF;
-    *pIddString += PXS_STRING_CRLF;
-}
-
-//===============================================================================================//
-//  Description:
-//      Interpret an IDD structure
-//
-//  Parameters:
-//      pIDD           - pointer to an IDENTIFY_DEVICE_DATA with the data
-//      pFormattedIdd - string object to receive the formatted string
-//
-//  Remarks:
-//
-//  Returns:
-//      void
-//===============================================================================================//
-void DiskInformation::FormatIddStructureAsString( const PXSDDK::IDENTIFY_DEVICE_DATA* pIDD,
-                                                  String* pFormattedIdd )
-{
-    DWORD     i = 0;
-    String    Data;
-    Formatter Format;
-
-    if ( pFormattedIdd == nullptr )
+    // Try as standard user
+    hDisk = CreateFile( DiskName.c_str(),
+                        0,
+                        FILE_SHARE_READ | FILE_SHARE_WRITE,
+                        nullptr, OPEN_EXISTING, 0, nullptr );
+    if ( hDisk != INVALID_HANDLE_VALUE )
     {
-        throw ParameterException( L"pFormattedIdd", __FUNCTION__ );
+        return hDisk;
     }
-    *pFormattedIdd = PXS_STRING_EMPTY;
 
-    if ( pIDD == nullptr )
-    {
-        return;     // Nothing to do
-    }
-    Data.Allocate( 2048 );
-
-    // Add notice
-    Data += L"Where appropriate 0 = false/no and 1 = true/yes.";
-    Data += PXS_STRING_CRLF;
-    Data += L"Some information requires character reversal, for";
-    Data += PXS_STRING_CRLF;
-    Data += L"example, aMtxro = Maxtor.\r\n";
-    Data += PXS_STRING_CRLF;
-
-    /////////////////////////////////
-    // Add the data
-
-    Data += L"GeneralConfiguration:\r\n";
-    Data += Format.StringUInt32( L"\tReserved1            \t= %%1\r\n",
-                                 pIDD->GeneralConfiguration.Reserved1 );
-    Data += Format.StringUInt32( L"\tRetired3             \t= %%1\r\n",
-                                 pIDD->GeneralConfiguration.Retired3 );
-    Data += Format.StringUInt32( L"\tResponseIncomplete   \t= %%1\r\n",
-                                 pIDD->GeneralConfiguration.ResponseIncomplete);
-    Data += Format.StringUInt32( L"\tRetired2             \t= %%1\r\n",
-                                 pIDD->GeneralConfiguration.Retired2 );
-    Data += Format.StringUInt32( L"\tFixedDevice          \t= %%1\r\n",
-                                 pIDD->GeneralConfiguration.FixedDevice );
-    Data += Format.StringUInt32( L"\tRemovableMedia       \t= %%1\r\n",
-                                pIDD->GeneralConfiguration.RemovableMedia );
-    Data += Format.StringUInt32( L"\tRetired1             \t= %%1\r\n",
-                                 pIDD->GeneralConfiguration.Retired1 );
-    Data += Format.StringUInt32( L"\tDeviceType           \t= %%1\r\n",
-                                 pIDD->GeneralConfiguration.DeviceType );
-
-    Data += Format.StringUInt32( L"NumCylinders            \t= %%1\r\n",
-                                 pIDD->NumCylinders );
-    Data += Format.StringUInt32( L"ReservedWord2           \t= %%1\r\n",
-                                 pIDD->ReservedWord2 );
-    Data += Format.StringUInt32( L"NumHeads                \t= %%1\r\n",
-                                 pIDD->NumHeads );
-
-    Data += L"Retired1[2]:\r\n";
-    Data += Format.StringUInt32( L"\tRetired1[0]          \t= %%1\r\n",
-                                 pIDD->Retired1[0] );
-    Data += Format.StringUInt32( L"\tRetired1[1]          \t= %%1\r\n",
-                                 pIDD->Retired1[1] );
-
-    Data += Format.StringUInt32( L"NumSectorsPerTrack      \t= %%1\r\n",
-                                 pIDD->NumSectorsPerTrack );
-
-    Data += L"VendorUnique1[3]:\r\n";
-    Data += Format.StringUInt32( L"\tVendorUnique1[0]     \t= %%1\r\n",
-                                 pIDD->VendorUnique1[0] );
-    Data += Format.StringUInt32( L"\tVendorUnique1[1]     \t= %%1\r\n",
-                                 pIDD->VendorUnique1[1] );
-    Data += Format.StringUInt32( L"\tVendorUnique1[2]     \t= %%1\r\n",
-                                 pIDD->VendorUnique1[2] );
-
-    Data += L"SerialNumber[20]:\r\n";
-    for ( i = 0; i < ARRAYSIZE( pIDD->SerialNumber ); i++ )
-    {
-        Data += Format.StringUInt32( L"\tSerialNumber[%%1]   \t= ", i );
-        Data += pIDD->SerialNumber[ i ];
-        Data += PXS_STRING_CRLF;
-    }
-
-    Data += L"Retired2[2]:\r\n";
-    Data += Format.StringUInt32( L"\tRetired2[0]          \t= %%1\r\n",
-                                 pIDD->Retired2[0] );
-    Data += Format.StringUInt32( L"\tRetired2[1]          \t= %%1\r\n",
-                                 pIDD->Retired2[1] );
-
-    Data += Format.StringUInt32( L"Obsolete1              \t= %%1\r\n",
-                                 pIDD->Obsolete1 );
-
-    Data += L"FirmwareRevision[8]:\r\n";
-    for ( i = 0; i < ARRAYSIZE( pIDD->FirmwareRevision ); i++ )
-    {
-        Data += Format.StringUInt32( L"\tFirmwareRevision[%%1]\t= ", i );
-        Data += pIDD->FirmwareRevision[ i ];
-        Data += PXS_STRING_CRLF;
-    }
-
-    Data += L"ModelNumber[40]:\r\n";
-    for ( i = 0; i < ARRAYSIZE( pIDD->ModelNumber ); i++ )
-    {
-        Data += Format.StringUInt32( L"\tModelNumber[%%1]      \t= ", i );
-        Data += pIDD->ModelNumber[ i ];
-        Data += PXS_STRING_CRLF;
-    }
-
-    Data += Format.StringUInt32( L"MaximumBlockTransfer       \t= %%1\r\n",
-                                 pIDD->MaximumBlockTransfer );
-    Data += Format.StringUInt32( L"VendorUnique2              \t= %%1\r\n",
-                                pIDD->VendorUnique2 );
-    Data += Format.StringUInt32( L"ReservedWord48             \t= %%1\r\n",
-                                 pIDD->ReservedWord48 );
-
-    Data += L"Capabilities:\r\n";
-    Data += Format.StringUInt32( L"\tReservedByte49       \t= %%1\r\n",
-                                pIDD->Capabilities.ReservedByte49 );
-    Data += Format.StringUInt32( L"\tDmaSupported         \t= %%1\r\n",
-                                 pIDD->Capabilities.DmaSupported );
-    Data += Format.StringUInt32( L"\tLbaSupported         \t= %%1\r\n",
-                                pIDD->Capabilities.LbaSupported );
-    Data += Format.StringUInt32( L"\tIordyDisable         \t= %%1\r\n",
-                                 pIDD->Capabilities.IordyDisable );
-    Data += Format.StringUInt32( L"\tIordySupported       \t= %%1\r\n",
-                                 pIDD->Capabilities.IordySupported );
-    Data += Format.StringUInt32( L"\tReserved1            \t= %%1\r\n",
-                                 pIDD->Capabilities.Reserved1 );
-    Data += Format.StringUInt32( L"\tStandybyTimerSupport \t= %%1\r\n",
-                                 pIDD->Capabilities.StandybyTimerSupport );
-    Data += Format.StringUInt32( L"\tReserved2            \t= %%1\r\n",
-                                 pIDD->Capabilities.Reserved2 );
-    Data += Format.StringUInt32( L"\tReservedWord50       \t= %%1\r\n",
-                                 pIDD->Capabilities.ReservedWord50 );
-
-    Data += L"ObsoleteWords51[2]:\r\n";
-    Data += Format.StringUInt32( L"\tObsoleteWords51[0]   \t= %%1\r\n",
-                                 pIDD->ObsoleteWords51[0] );
-    Data += Format.StringUInt32( L"\tObsoleteWords51[1]   \t= %%1\r\n",
-                                 pIDD->ObsoleteWords51[1] );
-
-    Data += Format.StringUInt32( L"TranslationFieldsValid:3   \t= %%1\r\n",
-                                 pIDD->TranslationFieldsValid );
-    Data += Format.StringUInt32( L"Reserved3:13               \t= %%1\r\n",
-                                pIDD->Reserved3 );
-    Data += Format.StringUInt32( L"NumberOfCurrentCylinders   \t= %%1\r\n",
-                                 pIDD->NumberOfCurrentCylinders );
-    Data += Format.StringUInt32( L"NumberOfCurrentHeads       \t= %%1\r\n",
-                                 pIDD->NumberOfCurrentHeads );
-    Data += Format.StringUInt32( L"CurrentSectorsPerTrack     \t= %%1\r\n",
-                                 pIDD->CurrentSectorsPerTrack );
-    Data += Format.StringUInt32( L"CurrentSectorCapacity      \t= %%1\r\n",
-                                 pIDD->CurrentSectorCapacity );
-    Data += Format.StringUInt32( L"CurrentMultiSectorSetting  \t= %%1\r\n",
-                                 pIDD->CurrentMultiSectorSetting );
-    Data += Format.StringUInt32( L"MultiSectorSettingValid : 1\t= %%1\r\n",
-                                 pIDD->MultiSectorSettingValid );
-    Data += Format.StringUInt32( L"ReservedByte59: 7          \t= %%1\r\n",
-                                 pIDD->ReservedByte59 );
-    Data += Format.StringUInt32( L"UserAddressableSectors     \t= %%1\r\n",
-                                 pIDD->UserAddressableSectors );
-    Data += Format.StringUInt32( L"ObsoleteWord62             \t= %%1\r\n",
-                                 pIDD->ObsoleteWord62 );
-    Data += Format.StringUInt32( L"MultiWordDMASupport : 8    \t= %%1\r\n",
-                                 pIDD->MultiWordDMASupport );
-    Data += Format.StringUInt32( L"MultiWordDMAActive : 8     \t= %%1\r\n",
-                                 pIDD->MultiWordDMAActive );
-    Data += Format.StringUInt32( L"AdvancedPIOModes : 8       \t= %%1\r\n",
-                                 pIDD->AdvancedPIOModes );
-    Data += Format.StringUInt32( L"ReservedByte64 : 8         \t= %%1\r\n",
-                                 pIDD->ReservedByte64 );
-    Data += Format.StringUInt32( L"MinimumMWXferCycleTime     \t= %%1\r\n",
-                                 pIDD->MinimumMWXferCycleTime );
-    Data += Format.StringUInt32( L"MinimumPIOCycleTime        \t= %%1\r\n",
-                                 pIDD->MinimumPIOCycleTime );
-    Data += Format.StringUInt32( L"MinimumPIOCycleTimeIORDY   \t= %%1\r\n",
-                                 pIDD->MinimumPIOCycleTimeIORDY );
-
-    Data += L"ReservedWords69[6]:\r\n";
-    for ( i = 0; i < ARRAYSIZE( pIDD->ReservedWords76 ); i++ )
-    {
-       Data += Format.StringUInt32_2( L"\tReservedWords69[%%1]   \t= %%2\r\n",
-                                      i, pIDD->ReservedWords69[0] );
-    }
-
-    Data += Format.StringUInt32( L"QueueDepth : 5             \t= %%1\r\n",
-                                 pIDD->QueueDepth );
-    Data += Format.StringUInt32( L"ReservedWord75 : 11        \t= %%1\r\n",
-                                 pIDD->ReservedWord75 );
-
-    Data += L"ReservedWords76[4]:\r\n";
-    for ( i = 0; i < ARRAYSIZE( pIDD->ReservedWords76 ); i++ )
-    {
-        Data += Format.StringUInt32_2(
-                                L"\tReservedWords76[%%1]   \t= %%2\r\n",
-                                i, pIDD->ReservedWords76[ i ] );
-    }
-
-    Data += Format.StringUInt32( L"MajorRevision              \t= %%1\r\n",
-                                 pIDD->MajorRevision );
-    Data += Format.StringUInt32( L"MinorRevision              \t= %%1\r\n",
-                                 pIDD->MinorRevision );
-
-    Data += L"CommandSetSupport:\r\n";
-    Data += Format.StringUInt32( L"\tSmartCommands        \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.SmartCommands );
-    Data += Format.StringUInt32( L"\tSecurityMode         \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.SecurityMode );
-    Data += Format.StringUInt32( L"\tRemovableMedia       \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.RemovableMedia );
-    Data += Format.StringUInt32( L"\tPowerManagement      \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.PowerManagement );
-    Data += Format.StringUInt32( L"\tReserved1            \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.Reserved1 );
-    Data += Format.StringUInt32( L"\tWriteCache           \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.WriteCache );
-    Data += Format.StringUInt32( L"\tLookAhead            \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.LookAhead );
-    Data += Format.StringUInt32( L"\tReleaseInterrupt     \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.ReleaseInterrupt );
-    Data += Format.StringUInt32( L"\tServiceInterrupt     \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.ServiceInterrupt );
-    Data += Format.StringUInt32( L"\tDeviceReset          \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.DeviceReset );
-    Data += Format.StringUInt32( L"\tHostProtectedArea    \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.HostProtectedArea);
-    Data += Format.StringUInt32( L"\tObsolete1            \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.Obsolete1 );
-    Data += Format.StringUInt32( L"\tWriteBuffer          \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.WriteBuffer );
-    Data += Format.StringUInt32( L"\tReadBuffer           \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.ReadBuffer );
-    Data += Format.StringUInt32( L"\tNop                  \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.Nop );
-    Data += Format.StringUInt32( L"\tObsolete2            \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.Obsolete2 );
-    Data += Format.StringUInt32( L"\tDownloadMicrocode    \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.DownloadMicrocode );
-    Data += Format.StringUInt32( L"\tDmaQueued            \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.DmaQueued );
-    Data += Format.StringUInt32( L"\tCfa                  \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.Cfa );
-    Data += Format.StringUInt32( L"\tAdvancedPm           \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.AdvancedPm );
-    Data += Format.StringUInt32( L"\tMsn                  \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.Msn );
-    Data += Format.StringUInt32( L"\tPowerUpInStandby     \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.PowerUpInStandby );
-    Data += Format.StringUInt32( L"\tManualPowerUp        \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.ManualPowerUp );
-    Data += Format.StringUInt32( L"\tReserved2            \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.Reserved2 );
-    Data += Format.StringUInt32( L"\tSetMax               \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.SetMax );
-    Data += Format.StringUInt32( L"\tAcoustics            \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.Acoustics );
-    Data += Format.StringUInt32( L"\tBigLba               \t= %%1\r\n",
-                                pIDD->CommandSetSupport.BigLba );
-    Data += Format.StringUInt32( L"\tResrved3             \t= %%1\r\n",
-                                 pIDD->CommandSetSupport.Resrved3 );
-
-    Data += Format.StringUInt32( L"ReservedWord84             \t= %%1\r\n",
-                                 pIDD->ReservedWord84 );
-
-    Data += L"CommandSetActive:\r\n";
-    Data += Format.StringUInt32( L"\tSmartCommands        \t= %%1\r\n",
-                                 pIDD->CommandSetActive.SmartCommands );
-    Data += Format.StringUInt32( L"\tSecurityMode         \t= %%1\r\n",
-                                 pIDD->CommandSetActive.SecurityMode );
-    Data += Format.StringUInt32( L"\tRemovableMedia       \t= %%1\r\n",
-                                 pIDD->CommandSetActive.RemovableMedia );
-    Data += Format.StringUInt32( L"\tPowerManagement      \t= %%1\r\n",
-                                 pIDD->CommandSetActive.PowerManagement );
-    Data += Format.StringUInt32( L"\tReserved1            \t= %%1\r\n",
-                                 pIDD->CommandSetActive.Reserved1 );
-    Data += Format.StringUInt32( L"\tWriteCache           \t= %%1\r\n",
-                                 pIDD->CommandSetActive.WriteCache );
-    Data += Format.StringUInt32( L"\tLookAhead            \t= %%1\r\n",
-                                 pIDD->CommandSetActive.LookAhead );
-    Data += Format.StringUInt32( L"\tReleaseInterrupt     \t= %%1\r\n",
-                                 pIDD->CommandSetActive.ReleaseInterrupt );
-    Data += Format.StringUInt32( L"\tServiceInterrupt     \t= %%1\r\n",
-                                 pIDD->CommandSetActive.ServiceInterrupt );
-    Data += Format.StringUInt32( L"\tDeviceReset          \t= %%1\r\n",
-                                 pIDD->CommandSetActive.DeviceReset );
-    Data += Format.StringUInt32( L"\tHostProtectedArea    \t= %%1\r\n",
-                                 pIDD->CommandSetActive.HostProtectedArea );
-    Data += Format.StringUInt32( L"\tObsolete1            \t= %%1\r\n",
-                                 pIDD->CommandSetActive.Obsolete1 );
-    Data += Format.StringUInt32( L"\tWriteBuffer          \t= %%1\r\n",
-                                 pIDD->CommandSetActive.WriteBuffer );
-    Data += Format.StringUInt32( L"\tReadBuffer           \t= %%1\r\n",
-                                 pIDD->CommandSetActive.ReadBuffer );
-    Data += Format.StringUInt32( L"\tNop                  \t= %%1\r\n",
-                                 pIDD->CommandSetActive.Nop );
-    Data += Format.StringUInt32( L"\tObsolete2            \t= %%1\r\n",
-                                 pIDD->CommandSetActive.Obsolete2 );
-    Data += Format.StringUInt32( L"\tDownloadMicrocode    \t= %%1\r\n",
-                                 pIDD->CommandSetActive.DownloadMicrocode );
-    Data += Format.StringUInt32( L"\tDmaQueued            \t= %%1\r\n",
-                                 pIDD->CommandSetActive.DmaQueued );
-    Data += Format.StringUInt32( L"\tCfa                  \t= %%1\r\n",
-                                 pIDD->CommandSetActive.Cfa );
-    Data += Format.StringUInt32( L"\tAdvancedPm           \t= %%1\r\n",
-                                 pIDD->CommandSetActive.AdvancedPm );
-    Data += Format.StringUInt32( L"\tMsn                  \t= %%1\r\n",
-                                 pIDD->CommandSetActive.Msn );
-    Data += Format.StringUInt32( L"\tPowerUpInStandby     \t= %%1\r\n",
-                                 pIDD->CommandSetActive.PowerUpInStandby );
-    Data += Format.StringUInt32( L"\tManualPowerUp        \t= %%1\r\n",
-                                 pIDD->CommandSetActive.ManualPowerUp );
-    Data += Format.StringUInt32( L"\tReserved2            \t= %%1\r\n",
-                                 pIDD->CommandSetActive.Reserved2 );
-    Data += Format.StringUInt32( L"\tSetMax               \t= %%1\r\n",
-                                 pIDD->CommandSetActive.SetMax );
-    Data += Format.StringUInt32( L"\tAcoustics            \t= %%1\r\n",
-                                 pIDD->CommandSetActive.Acoustics );
-    Data += Format.StringUInt32( L"\tBigLba               \t= %%1\r\n",
-                                 pIDD->CommandSetActive.BigLba );
-    Data += Format.StringUInt32( L"\tResrved3             \t= %%1\r\n",
-                                 pIDD->CommandSetActive.Resrved3 );
-
-    Data += Format.StringUInt32( L"ReservedWord87             \t= %%1\r\n",
-                                 pIDD->ReservedWord87 );
-    Data += Format.StringUInt32( L"UltraDMASupport : 8        \t= %%1\r\n",
-                                 pIDD->UltraDMASupport );
-    Data += Format.StringUInt32( L"UltraDMAActive  : 8        \t= %%1\r\n",
-                                 pIDD->UltraDMAActive );
-
-    Data += L"ReservedWord89[4]:\r\n";
-    for ( i = 0; i < ARRAYSIZE( pIDD->ReservedWord89 ); i++ )
-    {
-       Data += Format.StringUInt32_2( L"\tReservedWord89[%%1]    \t= %%2\r\n",
-                                      i, pIDD->ReservedWord89[ i ] );
-    }
-
-    Data += Format.StringUInt32( L"HardwareResetResult        \t= %%1\r\n",
-                                 pIDD->HardwareResetResult );
-    Data += Format.StringUInt32( L"CurrentAcousticValue : 8   \t= %%1\r\n",
-                                 pIDD->CurrentAcousticValue );
-    Data += Format.StringUInt32( L"RecommendedAcousticValue:8 \t= %%1\r\n",
-                                 pIDD->RecommendedAcousticValue );
-
-    Data += L"ReservedWord95[5]:\r\n";
-    for ( i = 0; i < ARRAYSIZE( pIDD->ReservedWord95 ); i++ )
-    {
-       Data += Format.StringUInt32_2( L"\tReservedWord95[%%1]    \t= %%2\r\n",
-                                      i, pIDD->ReservedWord95[ i ] );
-    }
-
-    Data += L"Max48BitLBA[2]:\r\n";
-    Data += Format.StringUInt32( L"\tMax48BitLBA[0]       \t= %%1\r\n",
-                                 pIDD->Max48BitLBA[0] );
-    Data += Format.StringUInt32( L"\tMax48BitLBA[1]       \t= %%1\r\n",
-                                 pIDD->Max48BitLBA[1] );
-
-    Data += L"ReservedWord104[23]:\r\n";
-    for ( i = 0; i < ARRAYSIZE( pIDD->ReservedWord104 ); i++ )
-    {
-        Data += Format.StringUInt32_2( L"\tReservedWord104[%%1] \t= %%2\r\n",
-                                       i, pIDD->ReservedWord104[i] );
-    }
-
-    Data += Format.StringUInt32( L"MsnSupport : 2             \t= %%1\r\n",
-                                 pIDD->MsnSupport );
-    Data += Format.StringUInt32( L"ReservedWord127 : 14       \t= %%1\r\n",
-                                 pIDD->ReservedWord127 );
-    Data += Format.StringUInt32( L"SecurityStatus : 14        \t= %%1\r\n",
-                                 pIDD->SecurityStatus );
-
-    Data += L"ReservedWord129[126]:\r\n";
-    for ( i = 0; i < ARRAYSIZE( pIDD->ReservedWord129 ); i++ )
-    {
-        Data += Format.StringUInt32_2( L"\tReservedWord129[%%1] \t= %%2\r\n",
-                                       i, pIDD->ReservedWord129[i] );
-    }
-
-    Data += Format.StringUInt32( L"Signature : 8              \t= %%1\r\n",
-                                 pIDD->Signature );
-    Data += Format.StringUInt32( L"CheckSum : 8               \t= %%1\r\n",
-                                 pIDD->CheckSum );
-
-    *pFormattedIdd = Data;
+    // Fail
+    PXSLogSysWarn1( GetLastError(), L"CreateFile failed for '%%1'.", DiskName );
+    return INVALID_HANDLE_VALUE;
 }
 
 //===============================================================================================//
@@ -1383,10 +970,11 @@ bool DiskInformation::GetDataIdd( BYTE    physicalDrive,
     }
 
     // This usually requires byte reversing but will return unmodified
-    ExtractIddStringValue( idd.SerialNumber, ARRAYSIZE( idd.SerialNumber ), pSerialNumber );
+    DiskDataDecoder::ExtractIddStringValue( idd.SerialNumber,
+                                            ARRAYSIZE( idd.SerialNumber ), pSerialNumber );
 
-    ExtractIddStringValue( idd.FirmwareRevision,
-                           ARRAYSIZE( idd.FirmwareRevision ), pFirmwareRevision );
+    DiskDataDecoder::ExtractIddStringValue( idd.FirmwareRevision,
+                                            ARRAYSIZE( idd.FirmwareRevision ), pFirmwareRevision );
 
     // Buffer
     if ( idd.Retired2[ 1 ] > 0 )
@@ -1483,10 +1071,7 @@ void DiskInformation::GetDataIoctl( BYTE physicalDrive,
 //      Sometimes the caller does not know if the drive exists so will
 //      return a success flag rather than throw.
 //
-//      Win32_DiskDrive may return a string that requires byte swapping. However,
-//      Win32_PhysicalMedia seems to return an already byte swapped string. The WMI documentation
-//      for these classes does not indicate any difference in behaviour.
-//
+//      Reads the data cached by LoadWmiDiskData, see GetWmiDiskValues.
 //
 //  Returns:
 //      true if obtained data otherwise false;
@@ -1502,95 +1087,17 @@ bool DiskInformation::GetDataWMI( BYTE physicalDrive,
                                   String* pSerialNumber,
                                   String* pFirmwareRevision )
 {
-    Wmi       WMI;
-    bool      success = false;
-    String    Query, PhysicalMediaSerialNumber;
-    Formatter Format;
-    SystemInformation  SystemInfo;
-    WindowsInformation WindowsInfo;
-
-    if ( ( pDiskSizeBytes    == nullptr ) ||
-         ( pTotalCylinders   == nullptr ) ||
-         ( pTotalHeads       == nullptr ) ||
-         ( pSectorsPerTrack  == nullptr ) ||
-         ( pMediaType        == nullptr ) ||
-         ( pManufacturerName == nullptr ) ||
-         ( pModel            == nullptr ) ||
-         ( pSerialNumber     == nullptr ) ||
-         ( pFirmwareRevision == nullptr )  )
-    {
-        throw ParameterException( L"pDiskSizeBytes...", __FUNCTION__ );
-    }
-
-    *pDiskSizeBytes    = 0;
-    *pTotalCylinders   = 0,
-    *pTotalHeads       = 0,
-    *pSectorsPerTrack  = 0,
-    *pMediaType        = PXS_STRING_EMPTY;
-    *pManufacturerName = PXS_STRING_EMPTY;
-    *pModel            = PXS_STRING_EMPTY;
-    *pSerialNumber     = PXS_STRING_EMPTY;
-    *pFirmwareRevision = PXS_STRING_EMPTY;
-
-    // Get Win32_DiskDrive data
-    WMI.Connect( L"root\\cimv2" );
-    Query  = L"Select * From Win32_DiskDrive WHERE DeviceID='";
-    Query += L"\\\\\\\\.\\\\PHYSICALDRIVE";
-    Query += Format.UInt8( physicalDrive );
-    Query += L"'";
-    WMI.ExecQuery( Query.c_str() );
-    if ( WMI.Next() )
-    {
-        // The device id is recognised so drive exists, call that success
-        success = true;
-        WMI.GetUInt64( L"Size"           , pDiskSizeBytes );
-        WMI.GetUInt64( L"TotalCylinders" , pTotalCylinders );
-        WMI.GetUInt32( L"TotalHeads"     , pTotalHeads );
-        WMI.GetUInt32( L"SectorsPerTrack", pSectorsPerTrack );
-        WMI.Get( L"MediaType"   , pMediaType );
-        WMI.Get( L"Manufacturer", pManufacturerName );
-        WMI.Get( L"Model"       , pModel );
-
-        // These are avialable from Vista onwards
-        if ( WindowsInfo.GetMajorVersion() >= 6 )
-        {
-            WMI.Get( L"SerialNumber"    , pSerialNumber );
-            WMI.Get( L"FirmwareRevision", pFirmwareRevision );
-        }
-    }
-    WMI.Disconnect();
-
-    // Win32_Diskdrive may return a string serial number that needs byte swapping. However,
-    // Win32_PhysicalMedia seems to return an already byte swapped string. So will overwrite
-    // the serail numb obtained ablove. This usually needs admin privileges.
-    if ( success )
-    {
-        try
-        {
-            WMI.Connect( L"root\\cimv2" );
-            Query  = L"Select SerialNumber From Win32_PhysicalMedia ";
-            Query += L"WHERE Tag='\\\\\\\\.\\\\PHYSICALDRIVE";
-            Query += Format.UInt8( physicalDrive );
-            Query += L"'";
-            WMI.ExecQuery( Query.c_str() );
-            if ( WMI.Next() )
-            {
-                WMI.Get( L"SerialNumber", &PhysicalMediaSerialNumber );
-                PhysicalMediaSerialNumber.Trim();
-                if ( PhysicalMediaSerialNumber.GetLength() )
-                {
-                    *pSerialNumber = PhysicalMediaSerialNumber;
-                }
-            }
-            WMI.Disconnect();
-        }
-        catch ( const Exception& e )
-        {
-            PXSLogException( e, __FUNCTION__ );
-        }
-    }
-
-    return success;
+    LoadWmiDiskData();
+
+    return GetWmiDiskValues( physicalDrive,
+                             m_WmiDiskDrives,
+                             m_WmiPhysicalMedia,
+                             pDiskSizeBytes,
+                             pTotalCylinders,
+                             pTotalHeads,
+                             pSectorsPerTrack,
+                             pMediaType,
+                             pManufacturerName, pModel, pSerialNumber, pFirmwareRevision );
 }
 
 /*
@@ -2421,7 +1928,7 @@ void DiskInformation::GetRawDiskData( String* pRawDiskData )
             if ( GetIdentifyDeviceData( i, &IDD ) )
             {
                 DataBlock = PXS_STRING_EMPTY;
-                FormatDiskFirmwareDataBlock( &IDD, &DataBlock );
+                DiskDataDecoder::FormatDiskFirmwareDataBlock( &IDD, &DataBlock );
             }
             else
             {
@@ -3156,7 +2663,7 @@ void DiskInformation::GetWmiDiskDriveData( String* pWmiDiskDriveData )
         }
         DataString += PXS_STRING_CRLF;
     }
-    WMI.Disconnect();
+    WMI.CloseQuery();
     DataString += PXS_STRING_CRLF;
 
     // Win32_PhysicalMedia
@@ -3164,7 +2671,6 @@ void DiskInformation::GetWmiDiskDriveData( String* pWmiDiskDriveData )
     DataString += L"--------------------------\r\n";
     DataString += L"Physical Media Enumeration\r\n";
     DataString += L"--------------------------\r\n";
-    WMI.Connect( L"root\\cimv2" );
     WMI.ExecQuery( L"Select * from Win32_PhysicalMedia" );
     while ( WMI.Next() )
     {
@@ -3193,116 +2699,84 @@ void DiskInformation::GetWmiDiskDriveData( String* pWmiDiskDriveData )
 
 //===============================================================================================//
 //  Description:
-//      Get the disk number as used by the controller from the physical
-//      drive number
+//      Read the WMI disk drive and physical media data
 //
 //  Parameters:
-//      physicalDrive - the OS drive number, e.g. PhysicalDrive#
-//      pDiskNumber   - receives the disk number used by the controller
+//      None
+//
+//  Remarks:
+//      The classes are read once with one connection and cached for the life
+//      of this object, per drive lookups are then made in memory. Only the
+//      properties used are selected. Not retried on error.
 //
 //  Returns:
-//      true on success, otherwise false
+//      void
 //===============================================================================================//
-bool DiskInformation::PhysDriveNumToDiskNum( BYTE physicalDrive, BYTE* pDiskNumber)
+void DiskInformation::LoadWmiDiskData()
 {
-    bool      result = false;
-    Wmi       WMI;
-    String    Query;
-    Formatter Format;
+    Wmi         WMI;
+    StringArray Properties;
+    WindowsInformation WindowsInfo;
 
-    if ( pDiskNumber == nullptr )
+    if ( m_bWmiDiskDataLoaded )
     {
-        throw ParameterException( L"pDiskNumber", __FUNCTION__ );
+        return;
+    }
+    m_bWmiDiskDataLoaded = true;
+    m_WmiDiskDrives.RemoveAll();
+    m_WmiPhysicalMedia.RemoveAll();
+
+    // Order must match the WMI_DISK_ constants
+    Properties.Add( L"DeviceID" );
+    Properties.Add( L"Size" );
+    Properties.Add( L"TotalCylinders" );
+    Properties.Add( L"TotalHeads" );
+    Properties.Add( L"SectorsPerTrack" );
+    Properties.Add( L"MediaType" );
+    Properties.Add( L"Manufacturer" );
+    Properties.Add( L"Model" );
+    Properties.Add( L"SCSIPort" );
+    Properties.Add( L"SCSITargetId" );
+    if ( WindowsInfo.GetMajorVersion() >= 6 )
+    {
+        Properties.Add( L"SerialNumber" );
+        Properties.Add( L"FirmwareRevision" );
     }
-    *pDiskNumber = UINT8_MAX;    // = -1
-
-    // WMI Win32_DiskDrive
-    Query  = L"Select * From Win32_DiskDrive WHERE DeviceID='";
-    Query += L"\\\\\\\\.\\\\PHYSICALDRIVE";
-    Query += Format.UInt8( physicalDrive );
-    Query += L"'";
     WMI.Connect( L"root\\cimv2" );
-    WMI.ExecQuery( Query.c_str() );
-    if ( WMI.Next() )
+    WMI.GetClassRows( L"Win32_DiskDrive", Properties, &m_WmiDiskDrives );
+
+    // Win32_PhysicalMedia usually needs admin privileges
+    try
     {
-        int scsiPort     = 0;
-        int scsiTargetId = 0;
-        if ( ( WMI.GetInt32( L"SCSIPort"    , &scsiPort     ) ) &&
-             ( WMI.GetInt32( L"SCSITargetId", &scsiTargetId ) )  )
-        {
-            // Two disks per port with the primary at targetid=0 and the
-            // secondary at tatgetid=1
-            int number = PXSMultiplyInt32( 2, scsiPort );
-            number     = PXSAddInt32( number, scsiTargetId );
-            if ( number < 256 )
-            {
-                *pDiskNumber = PXSCastInt32ToUInt8( number );
-                result = true;
-            }
-        }
+        Properties.RemoveAll();
+        Properties.Add( L"Tag" );
+        Properties.Add( L"SerialNumber" );
+        WMI.GetClassRows( L"Win32_PhysicalMedia", Properties, &m_WmiPhysicalMedia );
+    }
+    catch ( const Exception& e )
+    {
+        PXSLogException( e, __FUNCTION__ );
     }
-    WMI.Disconnect();
-    return result;
 }
 
 //===============================================================================================//
 //  Description:
-//      Attempt to identify the manufacturer of the physical disk
+//      Get the disk number as used by the controller from the physical
+//      drive number
 //
 //  Parameters:
-//      Model - the model number
-//      pManufacturerName - receives the name of the manufacturer
-//
-//  Remarks:
-//      Be conservative, don't want to show an incorrect name.
-//      Use the model number to identify manufacturer
+//      physicalDrive - the OS drive number, e.g. PhysicalDrive#
+//      pDiskNumber   - receives the disk number used by the controller
 //
 //  Returns:
-//      void
+//      true on success, otherwise false
 //===============================================================================================//
-void DiskInformation::ResolveManufacturer( const String& Model, String* pManufacturerName)
+bool DiskInformation::PhysDriveNumToDiskNum( BYTE physicalDrive, BYTE* pDiskNumber)
 {
-    if ( pManufacturerName == nullptr )
-    {
-        throw ParameterException( L"pManufacturerName", __FUNCTION__ );
-    }
-    *pManufacturerName = PXS_STRING_EMPTY;
+    // WMI Win32_DiskDrive
+    LoadWmiDiskData();
 
-    // Check for the manufacturer's name in the model or serial numbers
-    if ( Model.IndexOfI( PXS_HDD_MANUFACTURER_FUJITSU ) != PXS_MINUS_ONE )
-    {
-        *pManufacturerName = PXS_HDD_MANUFACTURER_FUJITSU;
-    }
-    else if ( Model.IndexOfI( PXS_HDD_MANUFACTURER_HITACHI ) != PXS_MINUS_ONE )
-    {
-        *pManufacturerName = PXS_HDD_MANUFACTURER_HITACHI;
-    }
-    else if ( Model.IndexOfI( PXS_HDD_MANUFACTURER_MAXTOR ) != PXS_MINUS_ONE )
-    {
-        *pManufacturerName = PXS_HDD_MANUFACTURER_MAXTOR;
-    }
-    else if ( Model.IndexOfI( PXS_HDD_MANUFACTURER_SAMSUNG ) != PXS_MINUS_ONE )
-    {
-        *pManufacturerName = PXS_HDD_MANUFACTURER_SAMSUNG;
-    }
-    else if ( Model.IndexOfI( PXS_HDD_MANUFACTURER_SEAGATE ) != PXS_MINUS_ONE )
-    {
-        *pManufacturerName = PXS_HDD_MANUFACTURER_SEAGATE;
-    }
-    else if ( Model.IndexOfI( PXS_HDD_MANUFACTURER_WESTERN ) != PXS_MINUS_ONE )
-    {
-        *pManufacturerName = PXS_HDD_MANUFACTURER_WESTERN;
-    }
-    else if ( Model.StartsWith( L"ST", false ) )
-    {
-        // Seagate model numbers usually begin with "ST"
-        *pManufacturerName = PXS_HDD_MANUFACTURER_SEAGATE;
-    }
-    else if ( Model.StartsWith( L"WDC ", false ) )
-    {
-        // Western digital model numbers usually begin with "WDC "
-        *pManufacturerName = PXS_HDD_MANUFACTURER_WESTERN;
-    }
+    return GetWmiDiskNumber( physicalDrive, m_WmiDiskDrives, pDiskNumber );
 }
 
 //===============================================================================================//
@@ -38,7 +38,6 @@
 #include "WinAudit/Header Files/DisplayInformation.h"
 
 // 2. C System Files
-#include <math.h>
 
 // 3. C++ System Files
 
@@ -52,6 +51,7 @@
 
 // 5. This Project
 #include "WinAudit/Header Files/AuditRecord.h"
+#include "WinAudit/Header Files/EdidDecoder.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -546,10 +546,11 @@ void DisplayInformation::GetDiagnostics( String* pDiagnostics )
     String ManufacDate, DigDisplay, DisplaySize,  Gamma;
     String DisplayType, MonitorSerial, TextData, MonitorName;
     String Features, EstTimings,  StdTimings, HexData;
+    String Resolution, Extensions;
 
     try
     {
-        BYTE edidBlock[ 256 ] = { 0 };      // EDID version 2 is 256 bytes;
+        BYTE edidBlock[ 512 ] = { 0 };      // Base block and up to 3 extensions
 
         RegDisplay = L"System\\CurrentControlSet\\Enum\\Display\\";
 
@@ -627,16 +628,20 @@ void DisplayInformation::GetDiagnostics( String* pDiagnostics )
                     DataString += PXS_STRING_CRLF;
 
                     // Interpret EDID data
-                    TranslateEdidData( edidBlock   , sizeof ( edidBlock ),
-                                       &validHeader, &validCheckSum,
-                                       &VersionRev , &ManufacturerID,
-                                       &ProductID  , &SerialNumber,
-                                       &ManufacDate, &DigDisplay,
-                                       &DisplaySize, &Gamma,
-                                       &DisplayType, &MonitorSerial,
-                                       &TextData   , &MonitorName,
-                                       &Features   , &EstTimings,
-                                       &StdTimings , &HexData );
+                    EdidDecoder::TranslateEdidData( edidBlock   , sizeof ( edidBlock ),
+                                                    &validHeader, &validCheckSum,
+                                                    &VersionRev , &ManufacturerID,
+                                                    &ProductID  , &SerialNumber,
+                                                    &ManufacDate, &DigDisplay,
+                                                    &DisplaySize, &Gamma,
+                                                    &DisplayType, &MonitorSerial,
+                                                    &TextData   , &MonitorName,
+                                                    &Features   , &EstTimings,
+                                                    &StdTimings , &HexData );
+                    EdidDecoder::TranslatePreferredTiming( edidBlock,
+                                                           sizeof ( edidBlock ), &Resolution );
+                    EdidDecoder::TranslateExtensionBlocks( edidBlock,
+                                                           sizeof ( edidBlock ), &Extensions );
 
                     // Check header bytes, failure does not signify bad data
                     DataString += L"Valid Header         : ";
@@ -709,6 +714,14 @@ void DisplayInformation::GetDiagnostics( String* pDiagnostics )
                     DataString += StdTimings;
                     DataString += PXS_STRING_CRLF;
 
+                    DataString += L"Preferred Timing     : ";
+                    DataString += Resolution;
+                    DataString += PXS_STRING_CRLF;
+
+                    DataString += L"Extension Block(s)   :\r\n";
+                    DataString += Extensions;
+                    DataString += PXS_STRING_CRLF;
+
                     DataString += L"EDID hex data        :";
                     DataString += HexData;
                     DataString += PXS_STRING_CRLF;
@@ -771,62 +784,6 @@ void DisplayInformation::GetIdentificationRecords( TArray< AuditRecord >* pRecor
     PXSSortAuditRecords( pRecords, PXS_DISPLAY_EDID_DISPLAY_NAME );
 }
 
-//===============================================================================================//
-//  Description:
-//      Debug/Testing routine to read the hex data stored in a file
-//
-//  Parameters:
-//      FilePath    - path to EDID data
-//      pEdid       - pointer to receive byte data
-//      bufferSize  - size of buffer
-//
-//  Returns:
-//      void
-//===============================================================================================//
-void DisplayInformation::ReadEdidHexFile( const String& FilePath, BYTE* pEdid, size_t bufferSize )
-{
-    File      InputFile;
-    String    Line, EdidData, HexByte;
-    Formatter Format;
-
-    if ( FilePath.IsEmpty() )
-    {
-        throw ParameterException( L"FilePath", __FUNCTION__ );
-    }
-
-    if ( ( pEdid == nullptr ) || ( bufferSize == 0 ) )
-    {
-        throw ParameterException( L"pEdid, bufferSize ", __FUNCTION__ );
-    }
-    memset( pEdid, 0, bufferSize );
-
-    // Read the file
-    EdidData.Allocate( 1024 );
-    InputFile.OpenText( FilePath );
-    while ( InputFile.ReadLine( &Line ) )
-    {
-        Line.Trim();
-        EdidData += Line;
-    }
-    EdidData.Trim();
-    EdidData.ToUppercase();
-
-    // Hex data is in 2-letter form so there are only half as many bytes
-    size_t maxBytes = EdidData.GetLength() / 2;
-    if ( maxBytes > bufferSize )
-    {
-        maxBytes = bufferSize;
-    }
-
-    for ( size_t i = 0; i < maxBytes; i++ )
-    {
-        HexByte = PXS_STRING_EMPTY;
-        EdidData.SubString( ( 2 * i ), 2, &HexByte );
-        DWORD number = Format.HexStringToNumber( HexByte);
-        pEdid[ i ]   = static_cast<BYTE>( 0xFF & number );
-    }
-}
-
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Protected Methods
@@ -1115,13 +1072,8 @@ void DisplayInformation::GetDisplayRecord( size_t monitorNumber,
                                            const String& MonitorID,
                                            const String& DeviceName, AuditRecord* pRecord )
 {
-    bool      validHeader = false, validCheckSum = false;
     BYTE      edidBlock[ 512 ] = { 0 };     // EDID v2.0 is 256 bytes
-    String    VersionRev, ManufacturerID, ProductID, SerialNumber;
-    String    ManufacDate, DigDisplay, DisplaySize, Gamma;
-    String    DisplayType, MonitorSerial, TextData, MonitorName;
-    String    DeviceDesc, Features, EstTimings, StdTimings;
-    String    HexData, ManufacturerName, DisplayResolution;
+    String    DeviceDesc, DisplayResolution;
     DEVMODE   DevMode;
     Formatter Format;
 
@@ -1137,66 +1089,9 @@ void DisplayInformation::GetDisplayRecord( size_t monitorNumber,
                        MonitorID );
         return;
     }
-
-    TranslateEdidData( edidBlock   , sizeof ( edidBlock ),
-                       &validHeader, &validCheckSum,
-                       &VersionRev , &ManufacturerID,
-                       &ProductID  , &SerialNumber,
-                       &ManufacDate, &DigDisplay,
-                       &DisplaySize, &Gamma,
-                       &DisplayType, &MonitorSerial,
-                       &TextData   , &MonitorName,
-                       &Features   , &EstTimings,
-                       &StdTimings , &HexData );
-
-    // Check header bytes, failure does not signify bad data
-    if ( validHeader == false )
-    {
-        // Hmm... not the expected header
-        PXSLogAppWarn1( L"Invalid EDID header for '%%1.", MonitorID );
-    }
-
-    // Check the checksum failure does not signify bad data
-    if ( validCheckSum == false )
-    {
-        PXSLogAppWarn1( L"Invalid EDID checksum for '%%1.", MonitorID );
-    }
-
-    // Make the audit record
-    pRecord->Add( PXS_DISPLAY_EDID_ITEM_NUMBER, Format.SizeT( monitorNumber ) );
-
-    // Monitor Name
-    if ( MonitorName.IsEmpty() )
-    {
-        MonitorName = DeviceDesc;   // If none use the description
-    }
-    pRecord->Add( PXS_DISPLAY_EDID_DISPLAY_NAME, MonitorName );
-
-    TranslateIdManufacturerCode( ManufacturerID, &ManufacturerName );
-    if ( ManufacturerName.GetLength() )
-    {
-        pRecord->Add( PXS_DISPLAY_EDID_MANUFACTURER, ManufacturerName );
-    }
-    else
-    {
-        pRecord->Add( PXS_DISPLAY_EDID_MANUFACTURER, ManufacturerID );
-    }
-    pRecord->Add( PXS_DISPLAY_EDID_MANUFAC_DATE, ManufacDate );
-
-    // Serial Number, preference is for the monitor serial number
-    if ( MonitorSerial.GetLength() )
-    {
-        pRecord->Add( PXS_DISPLAY_EDID_SERIAL_NUMBER, MonitorSerial );
-    }
-    else
-    {
-        pRecord->Add( PXS_DISPLAY_EDID_SERIAL_NUMBER, SerialNumber );
-    }
-
-    pRecord->Add( PXS_DISPLAY_EDID_PRODUCT_ID  , ProductID   );
-    pRecord->Add( PXS_DISPLAY_EDID_DISPLAY_SIZE, DisplaySize );
-    pRecord->Add( PXS_DISPLAY_EDID_DISPLAY_TYPE, DisplayType );
-    pRecord->Add( PXS_DISPLAY_EDID_FEATURES    , Features    );
+    EdidDecoder::MakeEdidRecord( edidBlock,
+                                 sizeof ( edidBlock ),
+                                 monitorNumber, DeviceDesc, MonitorID, pRecord );
 
     // Display size in pixels, a device adaptor could have more than one
     // attached monitor, will use whatever is set into DEVMOD for the
@@ -1428,35 +1323,6 @@ void DisplayInformation::GetResolutionString( String* pResolutionString )
     ReleaseDC( nullptr, hdc );
 }
 
-//===============================================================================================//
-//  Description:
-//      Determine if the specified EDID data block has a valid header
-//
-//  Parameters:
-//      pEdid      - buffer to receive the data
-//      bufferSize - sizeof the buffer in bytes
-//
-//  Returns:
-//      true if valid, otherwise false
-//===============================================================================================//
-bool DisplayInformation::IsValidEdidHeader(const BYTE* pEdid, size_t bufferSize)
-{
-    bool valid    = false;
-    BYTE Header[] = { 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00 };
-
-    if ( ( pEdid == nullptr ) || ( ARRAYSIZE( Header ) > bufferSize ) )
-    {
-        return false;
-    }
-
-    if ( memcmp( pEdid, Header, ARRAYSIZE( Header ) ) == 0 )
-    {
-        valid = true;
-    }
-
-    return valid;
-}
-
 //===============================================================================================//
 //  Description:
 //      Read the EDID data block in the registry
@@ -1544,656 +1410,3 @@ bool DisplayInformation::ReadEdidDataBlock( const String& MonitorID,
 
     return success;
 }
-
-//===============================================================================================//
-//  Description:
-//      Translate an EDID data block, the first 128 bytes which corresponds
-//      to EDID version 1
-//
-//  Parameters:
-//      pEdid         - pointer to EDID data block
-//      bufferSize    - size of the data block, must be at least 128 bytes
-//      validHeader   - receives if the header data is invalid
-//      validCheckSum - receives if the check sum is valid
-//      Strings       - these receive the values
-//
-//  Remarks:
-//      The data block for EDID version 1 is 128 bytes long, for version
-//      it is 256 bytes long
-//
-//  Returns:
-//      void
-//===============================================================================================//
-void DisplayInformation::TranslateEdidData( const BYTE* pEdid   , size_t  bufferSize,
-                                            bool*   pValidHeader, bool*   pValidCheckSum,
-                                            String* pVersionRev , String* pManufacturerID,
-                                            String* pProductID  , String* pSerialNumber,
-                                            String* pManufacDate, String* pDigDisplay,
-                                            String* pDisplaySize, String* pGamma,
-                                            String* pDisplayType, String* pMonitorSerial,
-                                            String* pTextData   , String* pMonitorName,
-                                            String* pFeatures   , String* pEstTimings,
-                                            String* pStdTimings , String* pHexData )
-{
-    int       code = 0;
-    size_t    i    = 0;
-    BYTE      xDim = 0, yDim = 0;
-    DWORD     checkSum  = 0, serial = 0, value = 0;
-    wchar_t   szID[ 8 ] = { 0 };             // 3-letter manufacturer id
-    Formatter Format;
-
-    *pValidHeader    = false;
-    *pValidCheckSum  = false;
-    *pVersionRev     = PXS_STRING_EMPTY;
-    *pManufacturerID = PXS_STRING_EMPTY;
-    *pProductID      = PXS_STRING_EMPTY;
-    *pSerialNumber   = PXS_STRING_EMPTY;
-    *pManufacDate    = PXS_STRING_EMPTY;
-    *pDigDisplay     = PXS_STRING_EMPTY;
-    *pDisplaySize    = PXS_STRING_EMPTY;
-    *pGamma          = PXS_STRING_EMPTY;
-    *pDisplayType    = PXS_STRING_EMPTY;
-    *pMonitorSerial  = PXS_STRING_EMPTY;
-    *pTextData       = PXS_STRING_EMPTY;
-    *pMonitorName    = PXS_STRING_EMPTY;
-    *pFeatures       = PXS_STRING_EMPTY;
-    *pEstTimings     = PXS_STRING_EMPTY;
-    *pStdTimings     = PXS_STRING_EMPTY;
-    *pHexData        = PXS_STRING_EMPTY;
-
-    if ( pEdid == nullptr )
-    {
-        return;     // Nothing to do
-    }
-
-    // Must have at 128 bytes, will only examine up to 128 bytes
-    if ( bufferSize < 128 )
-    {
-        throw ParameterException( L"bufferSize", __FUNCTION__ );
-    }
-    bufferSize = 128;        // Limit
-
-    // Check header bytes, failure does not signify bad data
-    // Checksum, byte sum should be zero. Failure does not always signify
-    // bad data
-    *pValidHeader = IsValidEdidHeader( pEdid, bufferSize );
-    for ( i = 0; i < bufferSize; i++ )
-    {
-        checkSum = PXSAddUInt32( checkSum, pEdid[ i ] );
-    }
-    if ( ( checkSum % 256 ) == 0 )
-    {
-        *pValidCheckSum = true;
-    }
-
-    // EDID Version.Revision
-    *pVersionRev  = Format.UInt32( pEdid[ 0x12 ] );
-    *pVersionRev += PXS_STRING_DOT;
-    *pVersionRev += Format.UInt32( pEdid[ 0x13 ] );
-
-    // Manufacturer Code - three letters, each of 5-bits encoded into two bytes
-    // with 1 = A (or 0 = @ = 64). This is the manufacturer's Plug and Play ID.
-    // First  letter: bits 14-10
-    // Second letter: bits  9-5
-    // Third  letter: bits  4-0
-    code = ( pEdid[ 0x09 ] + ( pEdid[ 0x08 ] * 0x0100 ) );
-    szID[ 0 ] = static_cast<wchar_t>( (0x1F & ( code >> 10 ) ) + 64 );
-    szID[ 1 ] = static_cast<wchar_t>( (0x1F & ( code >>  5 ) ) + 64 );
-    szID[ 2 ] = static_cast<wchar_t>( (0x1F & ( code >>  0 ) ) + 64 );
-    szID[ 3 ] = PXS_CHAR_NULL;
-    *pManufacturerID = szID;
-
-    // Product Code
-    *pProductID  = Format.UInt8Hex( pEdid[ 0x0B ], false );
-    *pProductID += Format.UInt8Hex( pEdid[ 0x0A ], false );
-
-    // Serial Number - express as decimal, zero if not used
-    serial = PXSMultiplyUInt32( pEdid[ 0x0C ], 0x00000001 ) +
-             PXSMultiplyUInt32( pEdid[ 0x0D ], 0x00000100 ) +
-             PXSMultiplyUInt32( pEdid[ 0x0E ], 0x00010000 ) +
-             PXSMultiplyUInt32( pEdid[ 0x0F ], 0x01000000 );
-    if ( serial )
-    {
-        *pSerialNumber = Format.UInt32( serial );
-    }
-
-    // Week of Manufacture - range is 1 - 54 inclusive
-    if ( ( pEdid[ 0x10 ] >= 1 ) && ( pEdid[ 0x10 ] <= 54 ) )
-    {
-        *pManufacDate  = L"Week ";
-        *pManufacDate += Format.UInt8( pEdid[ 0x10 ] );
-    }
-
-    // Year of Manufacture - minimum value is 3
-    if ( pEdid[ 0x11 ] > 3 )
-    {
-        if ( pManufacDate->GetLength() > 0 )
-        {
-            *pManufacDate += L", ";
-        }
-        *pManufacDate += L"Year ";
-        *pManufacDate += Format.Int32( 1990 + pEdid[ 0x11 ] );
-    }
-
-    // Digital Display
-    *pDigDisplay = PXS_STRING_NO;
-    if ( pEdid[ 0x14 ] & ( 1 << 7 ) )
-    {
-        *pDigDisplay = PXS_STRING_YES;
-    }
-
-    // Display size, make sure it looks reasonable, have seen 255*255
-    // so test for that
-    xDim = pEdid[ 0x15 ];
-    yDim = pEdid[ 0x16 ];
-    if ( ( xDim > 0    ) &&
-         ( yDim > 0    ) &&
-         ( xDim < 0xff ) &&
-         ( yDim < 0xff )  )
-    {
-        uint32_t tmp1 = PXSMultiplyUInt32( xDim, xDim );
-        uint32_t tmp2 = PXSMultiplyUInt32( yDim, yDim );
-        double size   = static_cast< double >( PXSAddUInt32( tmp1, tmp2 ) );
-        size          = pow( size, 0.5 );
-        size          = ( size / 2.54 );
-
-        *pDisplaySize  = Format.Double( size, 1 );  // 1 decimal place
-        *pDisplaySize += L"\" (";
-        *pDisplaySize += Format.UInt32( xDim );
-        *pDisplaySize += L"cm x ";
-        *pDisplaySize += Format.UInt32( yDim );
-        *pDisplaySize += L"cm)";
-    }
-
-    // Gamma - stored as = (gamma x 100 ) - 100
-    *pGamma = Format.Double( ( pEdid[ 0x17 ] / 100.0 ) + 1.0 );
-
-    // Display type, combination of analog, colour mode. When pertaining to an
-    // electronic attribute American spelling is correct.
-    value = 0;
-    if ( pEdid[ 0x18 ] & (1 << 4) )
-    {
-        value += 2;
-    }
-    if ( pEdid[ 0x18 ] & (1 << 3) )
-    {
-        value += 1;
-    }
-
-    if ( value == 0 )
-    {
-        *pDisplayType = L"Monochrome";
-    }
-    else if ( 1 == value )
-    {
-        *pDisplayType = L"RGB Color";
-    }
-    else if ( 2 == value )
-    {
-        *pDisplayType = L"Non-RGB multicolor";
-    }
-    else
-    {
-        *pDisplayType = L"Undefined";
-    }
-
-    TranslateEdidDescriptorBlock( pEdid, bufferSize, pMonitorSerial, pTextData, pMonitorName );
-
-    // Power Management
-    if ( pEdid[ 0x18 ] & ( 1 << 7 ) )
-    {
-        *pFeatures += L"Standby";
-    }
-
-    if ( pEdid[ 0x18 ] & ( 1 << 6 ) )
-    {
-        if ( pFeatures->GetLength() )
-        {
-            *pFeatures += L", ";
-        }
-        *pFeatures += L"Suspend";
-    }
-
-    if ( pEdid[ 0x18 ] & ( 1 << 5 ) )
-    {
-        if ( pFeatures->GetLength() )
-        {
-            *pFeatures += L", ";
-        }
-        *pFeatures += L"Active-Off";
-    }
-
-    // Established timings I and II
-    LPCWSTR Timings[] = { L" 800 x 600  @ 60Hz",
-                          L" 800 x 600  @ 56Hz",
-                          L" 640 x 480  @ 75Hz",
-                          L" 640 x 480  @ 72Hz",
-                          L" 640 x 480  @ 67Hz",
-                          L" 640 x 480  @ 60Hz",
-                          L" 720 x 400  @ 88Hz",
-                          L" 720 x 400  @ 70Hz",
-                          L"1280 x 1024 @ 75Hz",
-                          L"1024 x 768  @ 75Hz",
-                          L"1024 x 768  @ 70Hz",
-                          L"1024 x 768  @ 60Hz",
-                          L"1024 x 768  @ 87Hz (Interlaced)",
-                          L" 832 x 624  @ 75Hz",
-                          L" 800 x 600  @ 75Hz",
-                          L" 800 x 600  @ 72Hz" };
-
-    for ( i = 0; i < ARRAYSIZE( Timings ); i++ )
-    {
-        // Bit is set if used
-        if ( pEdid[ 0x23 + ( i / 8 ) ] & ( 1 << ( i % 8 ) ) )
-        {
-            *pEstTimings += PXS_CHAR_TAB;
-            *pEstTimings += Timings[ i ];
-            *pEstTimings += PXS_STRING_CRLF;
-        }
-    }
-
-    // Standard Timing Identification
-    for ( i = 0x26; i <= 0x34; i+=2 )
-    {
-        BYTE b1 = pEdid[ i ];
-        BYTE b2 = pEdid[ i + 1 ];
-
-        // 0x0101 means no data
-        if ( ( b1 != 0x01) && ( b2 != 0x01 ) )
-        {
-            // Resolution
-            *pStdTimings += L"\tHorizontal Res.: ";
-            *pStdTimings += Format.Int32( (b1 * 8) + 248 );
-
-            // Aspect ratio
-            value = 0;
-            if ( b2 & (1 << 7) )
-            {
-                value += 2;
-            }
-            if ( b2 & (1 << 6) )
-            {
-                value += 1;
-            }
-
-            *pStdTimings += L", Aspect Ratio: ";
-            if ( value == 0 )
-            {
-                *pStdTimings += L"16:10";
-            }
-            else if ( 1 == value )
-            {
-                *pStdTimings += L"4:3";
-            }
-            else if ( 2 == value )
-            {
-                *pStdTimings += L"5:4";
-            }
-            else
-            {
-                *pStdTimings += L"16:9";
-            }
-
-            // Vertical frequency
-            // 0x3F = 00111111
-            *pStdTimings += L", Vertical Freq.: ";
-            *pStdTimings += Format.Int32( ( b2 & 0x3F ) + 60 );
-            *pStdTimings += L"Hz";
-            *pStdTimings += PXS_STRING_CRLF;
-        }
-    }
-
-    // EDID block in hex format
-    pHexData->Allocate( 1024 );
-    for ( i = 0; i < bufferSize; i++ )
-    {
-        if ( (i % 8) == 0 )
-        {
-            *pHexData += PXS_STRING_CRLF;
-        }
-        *pHexData += Format.UInt8Hex( pEdid[ i ], false );
-    }
-}
-
-//===============================================================================================//
-//  Description:
-//      Translate an EDID data block, the first 128 bytes which corresponds
-//      to EDID version 1
-//
-//  Parameters:
-//      pEdid         - pointer to EDID data block
-//      bufferSize    - size of the data block, must be at least 128 bytes
-//      pMonitorSerial- receives the monitor's serial number
-//      pTextData     - receives any associated text data
-//      pMonitorName  - receives the monitor's name
-//
-//  Remarks:
-//      The descriptor data starts at offset 0x36. There are 4 blocks, each
-//      of 18 bytes.
-//
-//  Returns:
-//      void
-//===============================================================================================//
-void DisplayInformation::TranslateEdidDescriptorBlock( const BYTE* pEdid,
-                                                       size_t  bufferSize,
-                                                       String* pMonitorSerial,
-                                                       String* pTextData,
-                                                       String* pMonitorName )
-{
-    char   szAnsi[ 32 ] = { 0 };    // Big enough for 13 chars + terminator
-    String DataString;
-
-    if ( pEdid == nullptr )
-    {
-        return;     // Nothing to do
-    }
-
-    // Must have at 126 bytes of data, 0x36 + ( 4 * 18 )
-    if ( bufferSize < 126 )
-    {
-        throw ParameterException( L"bufferSize", __FUNCTION__ );
-    }
-
-    if ( ( pMonitorSerial == nullptr ) || ( pTextData == nullptr ) || ( pMonitorName == nullptr ) )
-    {
-        throw ParameterException( L"nullptr", __FUNCTION__ );
-    }
-    *pMonitorSerial = PXS_STRING_EMPTY;
-    *pTextData      = PXS_STRING_EMPTY;
-    *pMonitorName   = PXS_STRING_EMPTY;
-
-    // Scan for the blocks
-    for ( size_t i = 0; i < 4; i++ )
-    {
-        // Set start in array
-        size_t idxStart = 0x36 + ( i * 18 );  // Each descriptor block is 18 bytes
-
-        // FFh = Monitor Serial Number
-        // FEh = ASCII string
-        // FDh = Monitor Range Limits,
-        // FCh = Monitor name
-        // FBh = Colour Point Data
-        // FAh = Standard Timing Data
-        // F9h = Currently undefined
-        // F8h = Defined by manufacturer
-        BYTE bTag = pEdid[ idxStart + 3 ];
-
-        // Look for tag format 000n0
-        memset( szAnsi, 0, sizeof ( szAnsi ) );
-        if ( ( pEdid[ idxStart + 0 ] == 0 ) &&
-             ( pEdid[ idxStart + 1 ] == 0 ) &&
-             ( pEdid[ idxStart + 2 ] == 0 ) &&
-             ( pEdid[ idxStart + 4 ] == 0 )  )
-        {
-            // pEdid has ASCII data comprising of line-feed separated fields.
-            // The maximum length is 13 characters as its starts at offset 5
-            // and a descriptor block is 18 characters long
-            memcpy( szAnsi, pEdid + idxStart + 5, 13 );
-            szAnsi[ sizeof ( szAnsi ) - 1 ] = 0x00;
-            DataString.SetAnsi( szAnsi );
-            DataString.ReplaceChar( 0x0A, PXS_CHAR_NULL );
-            if ( bTag == 0xFF )
-            {
-                *pMonitorSerial = DataString;
-            }
-            else if ( bTag == 0xFE )
-            {
-                // Concat to existing data
-                *pTextData += DataString;
-            }
-            else if ( bTag == 0xFC )
-            {
-                // Concat to existing data
-                *pMonitorName += DataString;
-            }
-        }
-    }
-}
-
-//===============================================================================================//
-//  Description:
-//      Translate a 3 letter ID to a Manufacturers Name
-//
-//  Parameters:
-//      PnPID             - the Plug and Play ID
-//      pManufacturerName - receives the manufacturer's name
-//
-//  Remarks:
-//      The 3 character serial number in the EDID data block is the display's
-//      manufacturers Plug and Play Identifier.
-//
-//      Plug and Play ID's are maintained by Microsoft, see "Plug and Play
-//      ID - PNPID Request". A list is available for download:
-//      http://download.microsoft.com/download/7/E/7/7E7662CF-CBEA-470B-A97E-CE7CE0D98DC2/ISA_PNPID_List.xlsx
-//      The last update 3/Feb/2013 which contains 2249 companies
-//
-//  Returns:
-//      void, zero length string "" if not identified
-//===============================================================================================//
-void DisplayInformation::TranslateIdManufacturerCode( const String& PnPID,
-                                                      String* pManufacturerName)
-{
-    size_t i = 0;
-
-    // Common manufacturer names
-    struct _NAMES
-    {
-        LPCWSTR pszPnPID;
-        LPCWSTR pszManufacturer;
-    } Names[] =
-        { { L"TCM", L"3Com Corp"                    },
-          { L"TRU", L"Aashima Technology B.V."      },
-          { L"ADV", L"AMD"                          },
-          { L"ACC", L"Accton Technology Corp"       },
-          { L"AMP", L"Amptron"                      },
-          { L"ACR", L"Acer Corporation"             },
-          { L"AXS", L"Analog Devices"               },
-          { L"ANX", L"Acer Netxus Inc."             },
-          { L"AOC", L"AOC International (USA) Ltd." },
-          { L"ACS", L"ACS"                          },
-          { L"APP", L"Apple Computer"               },
-          { L"ACT", L"Actebis"                      },
-          { L"ART", L"Artmedia"                     },
-          { L"ADP", L"Adaptec"                      },
-          { L"AST", L"AST"                          },
-          { L"ADD", L"Addtron"                      },
-          { L"ATI", L"ATI"                          },
-          { L"ADI", L"ADI Systems Inc"              },
-          { L"ATK", L"ATKK"                         },
-          { L"ALS", L"Advance Logic (ADL) Inc"      },
-          { L"AZT", L"Aztech"                       },
-          { L"ASC", L"AdvanSys"                     },
-          { L"AZU", L"Azura"                        },
-          { L"AMB", L"Ambient Technologies Inc"     },
-          { L"API", L"Benq Corp"                    },
-          { L"BRG", L"Bridge"                       },
-          { L"BDP", L"BestData"                     },
-          { L"BUS", L"Buslogic"                     },
-          { L"BRI", L"Boca"                         },
-          { L"CMI", L"C-Media Electronics Inc"      },
-          { L"CRN", L"Cornerstone Imaging"          },
-          { L"CSI", L"Cabletron"                    },
-          { L"CPI", L"CPI"                          },
-          { L"CAC", L"Cardinal"                     },
-          { L"CTL", L"Creative"                     },
-          { L"CTX", L"Chuntex Electronic"           },
-          { L"CSC", L"Crystal"                      },
-          { L"CIR", L"Cirrus Logic"                 },
-          { L"CYB", L"CyberVision"                  },
-          { L"CPL", L"Compal Electronics"           },
-          { L"CPQ", L"Compaq"                       },
-          { L"CRX", L"Cyrix Corporation"            },
-          { L"WCI", L"Conexant Systems"             },
-          { L"DWE", L"Daewoo"                       },
-          { L"SUP", L"Diamond Multimedia"           },
-          { L"DBK", L"Databook"                     },
-          { L"DMB", L"Digicom System"               },
-          { L"OEC", L"Daytek"                       },
-          { L"DRT", L"Digital Research"             },
-          { L"DVC", L"DecaView"                     },
-          { L"DPT", L"DPT"                          },
-          { L"DEL", L"Dell Computer Corp"           },
-          { L"DPC", L"Delta Electronics"            },
-          { L"EIZ", L"Eizo"                         },
-          { L"EPI", L"EnVision Inc"                 },
-          { L"CCP", L"Epson"                        },
-          { L"ECS", L"ELITEGROUP Computer Systems"  },
-          { L"ESS", L"ESS Technology Inc"           },
-          { L"ELS", L"ELSA GmbH"                    },
-          { L"EPI", L"EPI"                          },
-          { L"FAR", L"Farallon"                     },
-          { L"FPA", L"Fujutsu"                      },
-          { L"FUJ", L"Fujitsu"                      },
-          { L"FCM", L"Funai"                        },
-          { L"ICL", L"Fujitsu ICL"                  },
-          { L"FDC", L"Future Domain"                },
-          { L"FUS", L"Fujitsu Siemens"              },
-          { L"GVT", L"G-Vision"                     },
-          { L"GWY", L"Gateway 2000"                 },
-          { L"HSL", L"Hansol Electronics"           },
-          { L"HIT", L"Hitachi"                      },
-          { L"HAY", L"Hayes Microcomputer Products" },
-          { L"HEI", L"Hyundai Electronics"          },
-          { L"HCM", L"HCL Peripherals"              },
-          { L"CPQ", L"Hewlett Packard"              },
-          { L"IOD", L"I-O Data"                     },
-          { L"INT", L"Intel Corporation"            },
-          { L"IBM", L"IBM"                          },
-          { L"IXD", L"Intertex"                     },
-          { L"IVM", L"Idek Iiyama North America"    },
-          { L"ISA", L"Iomega"                       },
-          { L"IQT", L"ImageQuest"                   },
-          { L"KTR", L"IMRI"                         },
-          { L"JEN", L"Jean"                         },
-          { L"KFC", L"KFC Computek"                 },
-          { L"KOR", L"KXPro"                        },
-          { L"KTC", L"Kingston Technology Corp"     },
-          { L"KYE", L"KYE Systems Corp"             },
-          { L"DWT", L"Korea Data Systems"           },
-          { L"LEN", L"Lenovo"                       },
-          { L"LEO", L"LEO Systems"                  },
-          { L"LTN", L"Lite-on Technology Corp."     },
-          { L"GSM", L"LG Electronics Inc."          },
-          { L"SLI", L"LSI Logic"                    },
-          { L"LKM", L"Likom"                        },
-          { L"LNK", L"LINK Technologie"             },
-          { L"MDG", L"Madge"                        },
-          { L"MIR", L"Miro Computer Products AG"    },
-          { L"PMV", L"MAG Technology Co"            },
-          { L"MTC", L"Mitac"                        },
-          { L"MAX", L"Maxdata Computer GmbH"        },
-          { L"MEL", L"Mitsubishi Electronics"       },
-          { L"MED", L"Medion"                       },
-          { L"MDD", L"Modis"                        },
-          { L"MDY", L"Microdyne"                    },
-          { L"MOT", L"Motorola"                     },
-          { L"MS_", L"Microsoft Corp"               },
-          { L"NAN", L"Nanao"                        },
-          { L"NLM", L"Newcomm"                      },
-          { L"NCD", L"NCD"                          },
-          { L"NOK", L"Nokia"                        },
-          { L"ACU", L"NCR"                          },
-          { L"NVL", L"Novell/Anthem"                },
-          { L"NMX", L"Neomagic Corp"                },
-          { L"NCL", L"Netcomm"                      },
-          { L"OKI", L"OKI"                          },
-          { L"OPT", L"OPTi Inc"                     },
-          { L"OLC", L"Olicom"                       },
-          { L"OQI", L"Optiquest"                    },
-          { L"OLI", L"Olivett"                      },
-          { L"PMC", L"Pace"                         },
-          { L"PGS", L"Princeton Graphic Systems"    },
-          { L"NCI", L"Packard Bell"                 },
-          { L"PRO", L"Proteon"                      },
-          { L"MEI", L"Panasonic"                    },
-          { L"PEI", L"Proton"                       },
-          { L"PEA", L"Peacock"                      },
-          { L"BMM", L"Proview"                      },
-          { L"PLB", L"Philips Consumer Electronics" },
-          { L"EMC", L"ProView (EMC)"                },
-          { L"PPI", L"Practical Peripherals"        },
-          { L"RII", L"Racal"                        },
-          { L"TRL", L"Royal Information Company"    },
-          { L"RDS", L"Radius (KDS)"                 },
-          { L"RPT", L"RPTI"                         },
-          { L"RTL", L"Realtek Semiconductor Corp"   },
-          { L"REL", L"Relisys"                      },
-          { L"SAM", L"Samsung"                      },
-          { L"XOC", L"Sky Wide Technology"          },
-          { L"STN", L"Samtron"                      },
-          { L"SMC", L"SMC"                          },
-          { L"SIB", L"Sanyo"                        },
-          { L"SML", L"Smile Technologies"           },
-          { L"SPT", L"Sceptre"                      },
-          { L"SNY", L"Sony Corporation"             },
-          { L"SCM", L"SCM"                          },
-          { L"STA", L"Stesa"                        },
-          { L"SRC", L"Shamrock"                     },
-          { L"SUN", L"Sun"                          },
-          { L"SHP", L"Sharp Corp"                   },
-          { L"SVE", L"SVEC"                         },
-          { L"SHT", L"SHINHO"                       },
-          { L"SYL", L"Sylvania"                     },
-          { L"SIE", L"Siemens"                      },
-          { L"SYN", L"Synaptics"                    },
-          { L"SNI", L"Siemens Nixdorf"              },
-          { L"SKD", L"SysKonnect"                   },
-          { L"SSC", L"Sierra Semiconductor"         },
-          { L"SGX", L"Silicon Graphics"             },
-          { L"TAT", L"Tatung"                       },
-          { L"TVP", L"Top Victory Electronics"      },
-          { L"TAX", L"Taxan"                        },
-          { L"TOS", L"Toshiba"                      },
-          { L"TEA", L"Teac"                         },
-          { L"TTK", L"Totoku / TeleVideo"           },
-          { L"TEI", L"TECO"                         },
-          { L"TVD", L"Trans Video Deutschland"      },
-          { L"TEO", L"Teco Information Systems"     },
-          { L"TTX", L"TTX"                          },
-          { L"TVI", L"TeleVideo"                    },
-          { L"TCI", L"Tulip"                        },
-          { L"TER", L"TerraTec Electronic GmbH"     },
-          { L"TVM", L"TVM"                          },
-          { L"TCO", L"Thomas-Conrad Corp"           },
-          { L"USC", L"UltraStor"                    },
-          { L"UTB", L"Utobia"                       },
-          { L"UMC", L"UMC Electronics Co Ltd"       },
-          { L"UNM", L"Unisys Corporation"           },
-          { L"AMT", L"V7 Video Seven"               },
-          { L"VSC", L"ViewSonic Corporation"        },
-          { L"VDM", L"Vadem"                        },
-          { L"VOB", L"VOBIS"                        },
-          { L"VES", L"Vestel"                       },
-          { L"VIA", L"VIA Technologies Inc"         },
-          { L"WTC", L"Wen Technology"               },
-          { L"WEC", L"Winbond Electronics Corp"     },
-          { L"DNV", L"Xenon"                        },
-          { L"YMH", L"YAMAHA Corp"                  },
-          { L"XDM", L"Yi Ray Electronic Co."        },
-          { L"ZCM", L"Zenith Data Systems"          },
-          { L"OZO", L"Zoom Telephonics Inc"         },
-          { L"ZDS", L"Zeos"                         },
-          { L"ZIN", L"Zhi-Ying Display Equipment"   }
-        };
-
-    if ( pManufacturerName == nullptr )
-    {
-        throw ParameterException( L"pManufacturerName", __FUNCTION__ );
-    }
-    *pManufacturerName = PXS_STRING_EMPTY;
-
-    // List is unsorted so will do a linear search
-    for ( i = 0; i < ARRAYSIZE( Names ); i++ )
-    {
-        if ( PnPID.CompareI( Names[ i ].pszPnPID ) == 0 )
-        {
-            *pManufacturerName = Names[ i ].pszManufacturer;
-            break;
-        }
-    }
-
-    if ( pManufacturerName->IsEmpty() )
-    {
-        PXSLogAppWarn1( L"Unrecognised PnP ID '%%1'.", PnPID );
-    }
-}
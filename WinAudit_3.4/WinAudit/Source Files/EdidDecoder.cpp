@@ -0,0 +1,1673 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// EDID Decoder Class Implementation
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Header Files/EdidDecoder.h"
+
+// 2. C System Files
+#include <math.h>
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/AllocateBytes.h"
+#include "PxsBase/Header Files/ByteArray.h"
+#include "PxsBase/Header Files/Directory.h"
+#include "PxsBase/Header Files/File.h"
+#include "PxsBase/Header Files/Formatter.h"
+#include "PxsBase/Header Files/ParameterException.h"
+#include "PxsBase/Header Files/StringArray.h"
+#include "PxsBase/Header Files/TArray.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/AuditRecord.h"
+#include "WinAudit/Header Files/PnPManufacturersMap.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Default constructor
+EdidDecoder::EdidDecoder()
+            :m_pBatchMT( nullptr )
+{
+}
+
+// Copy constructor - not allowed so no implementation
+
+// Destructor
+EdidDecoder::~EdidDecoder()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Operators
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Assignment operator - not allowed so no implementation
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Public Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Decode the EDID dumps in a directory into display audit records
+//
+//  Parameters:
+//      DirectoryPath - the directory holding the EDID files
+//      pRecords      - receives the audit records
+//
+//  Remarks:
+//      Each file is a raw binary dump or a hex text dump. A file that cannot
+//      be read or decoded is logged and skipped so that one bad dump does
+//      not stop the batch. The files are decoded by one worker per processor.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void EdidDecoder::DecodeDirectory( const String& DirectoryPath, TArray< AuditRecord >* pRecords )
+{
+    const  DWORD MAX_WORKERS = 16;
+    DWORD  numWorkers = 0, i = 0;
+    size_t numFiles = 0, j = 0;
+    UINT64 startTick = 0, elapsed = 0;
+    String FilePath, Insert2, Insert3;
+    Formatter   Format;
+    StringArray FileNames, FilePaths;
+    AuditRecord Record;
+    SYSTEM_INFO SystemInfo;
+    TYPE_EDID_BATCH Batch;
+    TArray< AuditRecord > FileRecords;
+    EdidDecoder Workers[ MAX_WORKERS ];
+
+    if ( pRecords == nullptr )
+    {
+        throw ParameterException( L"pRecords", __FUNCTION__ );
+    }
+    pRecords->RemoveAll();
+
+    if ( DirectoryPath.IsEmpty() )
+    {
+        throw ParameterException( L"DirectoryPath", __FUNCTION__ );
+    }
+
+    Directory::ListFiles( DirectoryPath, PXS_STRING_EMPTY, &FileNames );
+    numFiles = FileNames.GetSize();
+    if ( numFiles == 0 )
+    {
+        PXSLogAppWarn1( L"No EDID files found in '%%1'.", DirectoryPath );
+        return;
+    }
+
+    for ( j = 0; j < numFiles; j++ )
+    {
+        FilePath = DirectoryPath;
+        if ( FilePath.EndsWithCharacterI( PXS_PATH_SEPARATOR ) == false )
+        {
+            FilePath += PXS_PATH_SEPARATOR;
+        }
+        FilePath += FileNames.Get( j );
+        FilePaths.Add( FilePath );
+    }
+
+    // One worker per processor, each takes the next file. The slots start
+    // with no category so those of files not decoded are recognised
+    memset( &SystemInfo, 0, sizeof ( SystemInfo ) );
+    GetSystemInfo( &SystemInfo );
+    numWorkers = PXSMaxUInt32( 1, PXSMinUInt32( SystemInfo.dwNumberOfProcessors, MAX_WORKERS ) );
+    if ( numWorkers > numFiles )
+    {
+        numWorkers = PXSCastSizeTToUInt32( numFiles );
+    }
+    FileRecords.SetSize( numFiles );
+
+    Batch.pFilePaths = &FilePaths;
+    Batch.pFileNames = &FileNames;
+    Batch.pRecords   = &FileRecords;
+    Batch.nextIndex  = 0;
+    startTick = GetTickCount64();
+    for ( i = 0; i < numWorkers; i++ )
+    {
+        Workers[ i ].m_pBatchMT = &Batch;
+        Workers[ i ].Run( nullptr );
+    }
+
+    // The batch is on the stack so wait for every worker
+    for ( i = 0; i < numWorkers; i++ )
+    {
+        Workers[ i ].Join();
+    }
+    elapsed = GetTickCount64() - startTick;
+    if ( elapsed == 0 )
+    {
+        elapsed = 1;
+    }
+
+    // Number the records in file order as a sequential decode would
+    for ( j = 0; j < numFiles; j++ )
+    {
+        Record = FileRecords.Get( j );
+        if ( Record.GetCategoryID() == PXS_CATEGORY_DISPLAY_EDID )
+        {
+            Record.Add( PXS_DISPLAY_EDID_ITEM_NUMBER, Format.SizeT( pRecords->GetSize() + 1 ) );
+            pRecords->Add( Record );
+        }
+    }
+    PXSSortAuditRecords( pRecords, PXS_DISPLAY_EDID_DISPLAY_NAME );
+
+    Insert2 = Format.SizeT( numFiles );
+    Insert3 = Format.UInt64( elapsed );
+    PXSLogAppInfo3( L"Decoded %%1 of %%2 EDID file(s) in %%3ms.",
+                    Format.SizeT( pRecords->GetSize() ), Insert2, Insert3 );
+    PXSLogAppInfo1( L"EDID decode rate: %%1 files per second.",
+                    Format.UInt64( ( 1000 * numFiles ) / elapsed ) );
+}
+
+//===============================================================================================//
+//  Description:
+//      Determine if the specified EDID data block has a valid header
+//
+//  Parameters:
+//      pEdid      - buffer to receive the data
+//      bufferSize - sizeof the buffer in bytes
+//
+//  Returns:
+//      true if valid, otherwise false
+//===============================================================================================//
+bool EdidDecoder::IsValidEdidHeader(const BYTE* pEdid, size_t bufferSize)
+{
+    bool valid    = false;
+    BYTE Header[] = { 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00 };
+
+    if ( ( pEdid == nullptr ) || ( ARRAYSIZE( Header ) > bufferSize ) )
+    {
+        return false;
+    }
+
+    if ( memcmp( pEdid, Header, ARRAYSIZE( Header ) ) == 0 )
+    {
+        valid = true;
+    }
+
+    return valid;
+}
+
+//===============================================================================================//
+//  Description:
+//      Make a display audit record from an EDID data block
+//
+//  Parameters:
+//      pEdid      - pointer to EDID data block
+//      bufferSize - size of the data block, must be at least 128 bytes
+//      itemNumber - the record's item number, counting starts at 1
+//      DeviceDesc - display name to use if the EDID does not have one
+//      Source     - where the data came from, used in log messages
+//      pRecord    - receives the data
+//
+//  Remarks:
+//      The resolution is not added as that depends on the source, the
+//      caller appends it to complete the record.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void EdidDecoder::MakeEdidRecord( const BYTE* pEdid,
+                                  size_t bufferSize,
+                                  size_t itemNumber,
+                                  const String& DeviceDesc,
+                                  const String& Source, AuditRecord* pRecord )
+{
+    bool      validHeader = false, validCheckSum = false;
+    String    VersionRev, ManufacturerID, ProductID, SerialNumber;
+    String    ManufacDate, DigDisplay, DisplaySize, Gamma;
+    String    DisplayType, MonitorSerial, TextData, MonitorName;
+    String    Features, EstTimings, StdTimings, HexData, ManufacturerName;
+    Formatter Format;
+
+    if ( pRecord == nullptr )
+    {
+        throw ParameterException( L"pRecord", __FUNCTION__ );
+    }
+    pRecord->Reset( PXS_CATEGORY_DISPLAY_EDID );
+
+    TranslateEdidData( pEdid       , bufferSize,
+                       &validHeader, &validCheckSum,
+                       &VersionRev , &ManufacturerID,
+                       &ProductID  , &SerialNumber,
+                       &ManufacDate, &DigDisplay,
+                       &DisplaySize, &Gamma,
+                       &DisplayType, &MonitorSerial,
+                       &TextData   , &MonitorName,
+                       &Features   , &EstTimings,
+                       &StdTimings , &HexData );
+
+    // Check header bytes, failure does not signify bad data
+    if ( validHeader == false )
+    {
+        // Hmm... not the expected header
+        PXSLogAppWarn1( L"Invalid EDID header for '%%1.", Source );
+    }
+
+    // Check the checksum failure does not signify bad data
+    if ( validCheckSum == false )
+    {
+        PXSLogAppWarn1( L"Invalid EDID checksum for '%%1.", Source );
+    }
+
+    // Make the audit record
+    pRecord->Add( PXS_DISPLAY_EDID_ITEM_NUMBER, Format.SizeT( itemNumber ) );
+
+    // Monitor Name
+    if ( MonitorName.IsEmpty() )
+    {
+        MonitorName = DeviceDesc;   // If none use the description
+    }
+    pRecord->Add( PXS_DISPLAY_EDID_DISPLAY_NAME, MonitorName );
+
+    TranslateIdManufacturerCode( ManufacturerID, &ManufacturerName );
+    if ( ManufacturerName.GetLength() )
+    {
+        pRecord->Add( PXS_DISPLAY_EDID_MANUFACTURER, ManufacturerName );
+    }
+    else
+    {
+        pRecord->Add( PXS_DISPLAY_EDID_MANUFACTURER, ManufacturerID );
+    }
+    pRecord->Add( PXS_DISPLAY_EDID_MANUFAC_DATE, ManufacDate );
+
+    // Serial Number, preference is for the monitor serial number
+    if ( MonitorSerial.GetLength() )
+    {
+        pRecord->Add( PXS_DISPLAY_EDID_SERIAL_NUMBER, MonitorSerial );
+    }
+    else
+    {
+        pRecord->Add( PXS_DISPLAY_EDID_SERIAL_NUMBER, SerialNumber );
+    }
+
+    pRecord->Add( PXS_DISPLAY_EDID_PRODUCT_ID  , ProductID   );
+    pRecord->Add( PXS_DISPLAY_EDID_DISPLAY_SIZE, DisplaySize );
+    pRecord->Add( PXS_DISPLAY_EDID_DISPLAY_TYPE, DisplayType );
+    pRecord->Add( PXS_DISPLAY_EDID_FEATURES    , Features    );
+}
+
+//===============================================================================================//
+//  Description:
+//      Read an EDID data block from a file
+//
+//  Parameters:
+//      FilePath - path to the EDID file
+//      pEdid    - receives the data
+//
+//  Remarks:
+//      The file is either a raw binary dump, recognised by the fixed 8-byte
+//      header, or text of hex digit pairs such as copied from a registry
+//      export or a monitor information utility. In text, white space and the
+//      separators , : ; - are skipped as is any 0x prefix.
+//
+//  Returns:
+//      true if read at least one 128-byte block, otherwise false
+//===============================================================================================//
+bool EdidDecoder::ReadEdidFile( const String& FilePath, ByteArray* pEdid )
+{
+    const UINT64 MAX_FILE_SIZE = 256 * 1024;    // 256 blocks as hex text
+    const BYTE   UTF8_BOM[]    = { 0xEF, 0xBB, 0xBF };
+    bool      highNibble = true;
+    BYTE      value = 0, nibble = 0, character = 0;
+    BYTE*     pDecoded  = nullptr;
+    size_t    i = 0, numBytes = 0, numDecoded = 0;
+    File      InputFile;
+    ByteArray Contents;
+    AllocateBytes AllocBytes;
+
+    if ( pEdid == nullptr )
+    {
+        throw ParameterException( L"pEdid", __FUNCTION__ );
+    }
+    pEdid->Free();
+
+    InputFile.Open( FilePath, GENERIC_READ, FILE_SHARE_READ, 1, false );
+    if ( InputFile.GetSize() > MAX_FILE_SIZE )
+    {
+        PXSLogAppWarn1( L"EDID file '%%1' is too large.", FilePath );
+        return false;
+    }
+    InputFile.ReadAll( &Contents );
+    InputFile.Close();
+
+    // Binary dump
+    numBytes = Contents.GetSize();
+    if ( IsValidEdidHeader( Contents.GetPtr(), numBytes ) )
+    {
+        pEdid->Append( Contents.GetPtr(), numBytes );
+        return ( pEdid->GetSize() >= 128 );
+    }
+
+    // Hex text, two digits per byte
+    if ( Contents.BeginsWith( UTF8_BOM, sizeof ( UTF8_BOM ) ) )
+    {
+        i = sizeof ( UTF8_BOM );
+    }
+    pDecoded = AllocBytes.New( ( numBytes / 2 ) + 1 );
+    while ( i < numBytes )
+    {
+        character = Contents.Get( i );
+        i++;
+        if ( ( character >= '0' ) && ( character <= '9' ) )
+        {
+            nibble = static_cast<BYTE>( character - '0' );
+        }
+        else if ( ( character >= 'A' ) && ( character <= 'F' ) )
+        {
+            nibble = static_cast<BYTE>( character - 'A' + 10 );
+        }
+        else if ( ( character >= 'a' ) && ( character <= 'f' ) )
+        {
+            nibble = static_cast<BYTE>( character - 'a' + 10 );
+        }
+        else if ( ( character == 'x' ) || ( character == 'X' ) )
+        {
+            // Only valid as the 0x prefix of a byte
+            if ( highNibble || ( value != 0 ) )
+            {
+                return false;
+            }
+            highNibble = true;
+            continue;
+        }
+        else if ( ( character == ' '  ) || ( character == '\t' ) ||
+                  ( character == '\r' ) || ( character == '\n' ) ||
+                  ( character == ','  ) || ( character == ':'  ) ||
+                  ( character == ';'  ) || ( character == '-'  )  )
+        {
+            // Separators are only allowed between bytes
+            if ( highNibble == false )
+            {
+                return false;
+            }
+            continue;
+        }
+        else
+        {
+            return false;   // Not an EDID hex dump
+        }
+
+        if ( highNibble )
+        {
+            value      = static_cast<BYTE>( nibble << 4 );
+            highNibble = false;
+        }
+        else
+        {
+            pDecoded[ numDecoded++ ] = static_cast<BYTE>( value | nibble );
+            value      = 0;
+            highNibble = true;
+        }
+    }
+
+    if ( highNibble == false )
+    {
+        return false;       // Odd number of digits
+    }
+    pEdid->Append( pDecoded, numDecoded );
+
+    return ( pEdid->GetSize() >= 128 );
+}
+
+//===============================================================================================//
+//  Description:
+//      Translate an EDID data block, the first 128 bytes which corresponds
+//      to EDID version 1
+//
+//  Parameters:
+//      pEdid         - pointer to EDID data block
+//      bufferSize    - size of the data block, must be at least 128 bytes
+//      validHeader   - receives if the header data is invalid
+//      validCheckSum - receives if the check sum is valid
+//      Strings       - these receive the values
+//
+//  Remarks:
+//      The data block for EDID version 1 is 128 bytes long, for version
+//      it is 256 bytes long
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void EdidDecoder::TranslateEdidData( const BYTE* pEdid   , size_t  bufferSize,
+                                     bool*   pValidHeader, bool*   pValidCheckSum,
+                                     String* pVersionRev , String* pManufacturerID,
+                                     String* pProductID  , String* pSerialNumber,
+                                     String* pManufacDate, String* pDigDisplay,
+                                     String* pDisplaySize, String* pGamma,
+                                     String* pDisplayType, String* pMonitorSerial,
+                                     String* pTextData   , String* pMonitorName,
+                                     String* pFeatures   , String* pEstTimings,
+                                     String* pStdTimings , String* pHexData )
+{
+    int       code = 0;
+    size_t    i    = 0;
+    BYTE      xDim = 0, yDim = 0;
+    DWORD     checkSum  = 0, serial = 0, value = 0;
+    wchar_t   szID[ 8 ] = { 0 };             // 3-letter manufacturer id
+    Formatter Format;
+
+    *pValidHeader    = false;
+    *pValidCheckSum  = false;
+    *pVersionRev     = PXS_STRING_EMPTY;
+    *pManufacturerID = PXS_STRING_EMPTY;
+    *pProductID      = PXS_STRING_EMPTY;
+    *pSerialNumber   = PXS_STRING_EMPTY;
+    *pManufacDate    = PXS_STRING_EMPTY;
+    *pDigDisplay     = PXS_STRING_EMPTY;
+    *pDisplaySize    = PXS_STRING_EMPTY;
+    *pGamma          = PXS_STRING_EMPTY;
+    *pDisplayType    = PXS_STRING_EMPTY;
+    *pMonitorSerial  = PXS_STRING_EMPTY;
+    *pTextData       = PXS_STRING_EMPTY;
+    *pMonitorName    = PXS_STRING_EMPTY;
+    *pFeatures       = PXS_STRING_EMPTY;
+    *pEstTimings     = PXS_STRING_EMPTY;
+    *pStdTimings     = PXS_STRING_EMPTY;
+    *pHexData        = PXS_STRING_EMPTY;
+
+    if ( pEdid == nullptr )
+    {
+        return;     // Nothing to do
+    }
+
+    // Must have at 128 bytes, will only examine up to 128 bytes
+    if ( bufferSize < 128 )
+    {
+        throw ParameterException( L"bufferSize", __FUNCTION__ );
+    }
+    bufferSize = 128;        // Limit
+
+    // Check header bytes, failure does not signify bad data
+    // Checksum, byte sum should be zero. Failure does not always signify
+    // bad data
+    *pValidHeader = IsValidEdidHeader( pEdid, bufferSize );
+    for ( i = 0; i < bufferSize; i++ )
+    {
+        checkSum = PXSAddUInt32( checkSum, pEdid[ i ] );
+    }
+    if ( ( checkSum % 256 ) == 0 )
+    {
+        *pValidCheckSum = true;
+    }
+
+    // EDID Version.Revision
+    *pVersionRev  = Format.UInt32( pEdid[ 0x12 ] );
+    *pVersionRev += PXS_STRING_DOT;
+    *pVersionRev += Format.UInt32( pEdid[ 0x13 ] );
+
+    // Manufacturer Code - three letters, each of 5-bits encoded into two bytes
+    // with 1 = A (or 0 = @ = 64). This is the manufacturer's Plug and Play ID.
+    // First  letter: bits 14-10
+    // Second letter: bits  9-5
+    // Third  letter: bits  4-0
+    code = ( pEdid[ 0x09 ] + ( pEdid[ 0x08 ] * 0x0100 ) );
+    szID[ 0 ] = static_cast<wchar_t>( (0x1F & ( code >> 10 ) ) + 64 );
+    szID[ 1 ] = static_cast<wchar_t>( (0x1F & ( code >>  5 ) ) + 64 );
+    szID[ 2 ] = static_cast<wchar_t>( (0x1F & ( code >>  0 ) ) + 64 );
+    szID[ 3 ] = PXS_CHAR_NULL;
+    *pManufacturerID = szID;
+
+    // Product Code
+    *pProductID  = Format.UInt8Hex( pEdid[ 0x0B ], false );
+    *pProductID += Format.UInt8Hex( pEdid[ 0x0A ], false );
+
+    // Serial Number - express as decimal, zero if not used
+    serial = PXSMultiplyUInt32( pEdid[ 0x0C ], 0x00000001 ) +
+             PXSMultiplyUInt32( pEdid[ 0x0D ], 0x00000100 ) +
+             PXSMultiplyUInt32( pEdid[ 0x0E ], 0x00010000 ) +
+             PXSMultiplyUInt32( pEdid[ 0x0F ], 0x01000000 );
+    if ( serial )
+    {
+        *pSerialNumber = Format.UInt32( serial );
+    }
+
+    // Week of Manufacture - range is 1 - 54 inclusive
+    if ( ( pEdid[ 0x10 ] >= 1 ) && ( pEdid[ 0x10 ] <= 54 ) )
+    {
+        *pManufacDate  = L"Week ";
+        *pManufacDate += Format.UInt8( pEdid[ 0x10 ] );
+    }
+
+    // Year of Manufacture - minimum value is 3
+    if ( pEdid[ 0x11 ] > 3 )
+    {
+        if ( pManufacDate->GetLength() > 0 )
+        {
+            *pManufacDate += L", ";
+        }
+        *pManufacDate += L"Year ";
+        *pManufacDate += Format.Int32( 1990 + pEdid[ 0x11 ] );
+    }
+
+    // Digital Display
+    *pDigDisplay = PXS_STRING_NO;
+    if ( pEdid[ 0x14 ] & ( 1 << 7 ) )
+    {
+        *pDigDisplay = PXS_STRING_YES;
+    }
+
+    // Display size, make sure it looks reasonable, have seen 255*255
+    // so test for that
+    xDim = pEdid[ 0x15 ];
+    yDim = pEdid[ 0x16 ];
+    if ( ( xDim > 0    ) &&
+         ( yDim > 0    ) &&
+         ( xDim < 0xff ) &&
+         ( yDim < 0xff )  )
+    {
+        uint32_t tmp1 = PXSMultiplyUInt32( xDim, xDim );
+        uint32_t tmp2 = PXSMultiplyUInt32( yDim, yDim );
+        double size   = static_cast< double >( PXSAddUInt32( tmp1, tmp2 ) );
+        size          = pow( size, 0.5 );
+        size          = ( size / 2.54 );
+
+        *pDisplaySize  = Format.Double( size, 1 );  // 1 decimal place
+        *pDisplaySize += L"\" (";
+        *pDisplaySize += Format.UInt32( xDim );
+        *pDisplaySize += L"cm x ";
+        *pDisplaySize += Format.UInt32( yDim );
+        *pDisplaySize += L"cm)";
+    }
+
+    // Gamma - stored as = (gamma x 100 ) - 100
+    *pGamma = Format.Double( ( pEdid[ 0x17 ] / 100.0 ) + 1.0 );
+
+    // Display type, combination of analog, colour mode. When pertaining to an
+    // electronic attribute American spelling is correct.
+    value = 0;
+    if ( pEdid[ 0x18 ] & (1 << 4) )
+    {
+        value += 2;
+    }
+    if ( pEdid[ 0x18 ] & (1 << 3) )
+    {
+        value += 1;
+    }
+
+    if ( value == 0 )
+    {
+        *pDisplayType = L"Monochrome";
+    }
+    else if ( 1 == value )
+    {
+        *pDisplayType = L"RGB Color";
+    }
+    else if ( 2 == value )
+    {
+        *pDisplayType = L"Non-RGB multicolor";
+    }
+    else
+    {
+        *pDisplayType = L"Undefined";
+    }
+
+    TranslateEdidDescriptorBlock( pEdid, bufferSize, pMonitorSerial, pTextData, pMonitorName );
+
+    // Power Management
+    if ( pEdid[ 0x18 ] & ( 1 << 7 ) )
+    {
+        *pFeatures += L"Standby";
+    }
+
+    if ( pEdid[ 0x18 ] & ( 1 << 6 ) )
+    {
+        if ( pFeatures->GetLength() )
+        {
+            *pFeatures += L", ";
+        }
+        *pFeatures += L"Suspend";
+    }
+
+    if ( pEdid[ 0x18 ] & ( 1 << 5 ) )
+    {
+        if ( pFeatures->GetLength() )
+        {
+            *pFeatures += L", ";
+        }
+        *pFeatures += L"Active-Off";
+    }
+
+    // Established timings I and II
+    LPCWSTR Timings[] = { L" 800 x 600  @ 60Hz",
+                          L" 800 x 600  @ 56Hz",
+                          L" 640 x 480  @ 75Hz",
+                          L" 640 x 480  @ 72Hz",
+                          L" 640 x 480  @ 67Hz",
+                          L" 640 x 480  @ 60Hz",
+                          L" 720 x 400  @ 88Hz",
+                          L" 720 x 400  @ 70Hz",
+                          L"1280 x 1024 @ 75Hz",
+                          L"1024 x 768  @ 75Hz",
+                          L"1024 x 768  @ 70Hz",
+                          L"1024 x 768  @ 60Hz",
+                          L"1024 x 768  @ 87Hz (Interlaced)",
+                          L" 832 x 624  @ 75Hz",
+                          L" 800 x 600  @ 75Hz",
+                          L" 800 x 600  @ 72Hz" };
+
+    for ( i = 0; i < ARRAYSIZE( Timings ); i++ )
+    {
+        // Bit is set if used
+        if ( pEdid[ 0x23 + ( i / 8 ) ] & ( 1 << ( i % 8 ) ) )
+        {
+            *pEstTimings += PXS_CHAR_TAB;
+            *pEstTimings += Timings[ i ];
+            *pEstTimings += PXS_STRING_CRLF;
+        }
+    }
+
+    // Standard Timing Identification
+    for ( i = 0x26; i <= 0x34; i+=2 )
+    {
+        BYTE b1 = pEdid[ i ];
+        BYTE b2 = pEdid[ i + 1 ];
+
+        // 0x0101 means no data
+        if ( ( b1 != 0x01) && ( b2 != 0x01 ) )
+        {
+            // Resolution
+            *pStdTimings += L"\tHorizontal Res.: ";
+            *pStdTimings += Format.Int32( (b1 * 8) + 248 );
+
+            // Aspect ratio
+            value = 0;
+            if ( b2 & (1 << 7) )
+            {
+                value += 2;
+            }
+            if ( b2 & (1 << 6) )
+            {
+                value += 1;
+            }
+
+            *pStdTimings += L", Aspect Ratio: ";
+            if ( value == 0 )
+            {
+                *pStdTimings += L"16:10";
+            }
+            else if ( 1 == value )
+            {
+                *pStdTimings += L"4:3";
+            }
+            else if ( 2 == value )
+            {
+                *pStdTimings += L"5:4";
+            }
+            else
+            {
+                *pStdTimings += L"16:9";
+            }
+
+            // Vertical frequency
+            // 0x3F = 00111111
+            *pStdTimings += L", Vertical Freq.: ";
+            *pStdTimings += Format.Int32( ( b2 & 0x3F ) + 60 );
+            *pStdTimings += L"Hz";
+            *pStdTimings += PXS_STRING_CRLF;
+        }
+    }
+
+    // EDID block in hex format
+    pHexData->Allocate( 1024 );
+    for ( i = 0; i < bufferSize; i++ )
+    {
+        if ( (i % 8) == 0 )
+        {
+            *pHexData += PXS_STRING_CRLF;
+        }
+        *pHexData += Format.UInt8Hex( pEdid[ i ], false );
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Translate the extension blocks that follow the 128-byte base block
+//
+//  Parameters:
+//      pEdid       - pointer to EDID data
+//      bufferSize  - size of the data, must be at least 128 bytes
+//      pExtensions - receives the translation, one or more lines per block
+//
+//  Remarks:
+//      The extension count is at offset 0x7E of the base block. Only the
+//      blocks actually present in the buffer are examined.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void EdidDecoder::TranslateExtensionBlocks( const BYTE* pEdid,
+                                            size_t bufferSize, String* pExtensions )
+{
+    size_t    i = 0, j = 0, numExtensions = 0;
+    DWORD     checkSum = 0;
+    String    Translation;
+    Formatter Format;
+
+    if ( pExtensions == nullptr )
+    {
+        throw ParameterException( L"pExtensions", __FUNCTION__ );
+    }
+    *pExtensions = PXS_STRING_EMPTY;
+
+    if ( pEdid == nullptr )
+    {
+        return;     // Nothing to do
+    }
+
+    if ( bufferSize < 128 )
+    {
+        throw ParameterException( L"bufferSize", __FUNCTION__ );
+    }
+
+    numExtensions = pEdid[ 0x7E ];
+    if ( numExtensions > ( ( bufferSize / 128 ) - 1 ) )
+    {
+        *pExtensions += L"\tExtension blocks not all present, expected ";
+        *pExtensions += Format.SizeT( numExtensions );
+        *pExtensions += PXS_STRING_CRLF;
+        numExtensions = ( bufferSize / 128 ) - 1;
+    }
+
+    for ( i = 1; i <= numExtensions; i++ )
+    {
+        const BYTE* pBlock = pEdid + ( i * 128 );
+
+        checkSum = 0;
+        for ( j = 0; j < 128; j++ )
+        {
+            checkSum = PXSAddUInt32( checkSum, pBlock[ j ] );
+        }
+
+        Translation = PXS_STRING_EMPTY;
+        *pExtensions += L"\tBlock ";
+        *pExtensions += Format.SizeT( i );
+        *pExtensions += L": ";
+        if ( pBlock[ 0 ] == 0x02 )
+        {
+            *pExtensions += L"CEA-861";
+            TranslateCeaBlock( pBlock, &Translation );
+        }
+        else if ( pBlock[ 0 ] == 0x70 )
+        {
+            *pExtensions += L"DisplayID";
+            TranslateDisplayIdBlock( pBlock, &Translation );
+        }
+        else if ( pBlock[ 0 ] == 0xF0 )
+        {
+            *pExtensions += L"Block Map";
+        }
+        else
+        {
+            *pExtensions += L"Tag ";
+            *pExtensions += Format.UInt8Hex( pBlock[ 0 ], true );
+        }
+
+        if ( ( checkSum % 256 ) != 0 )
+        {
+            *pExtensions += L" (invalid checksum)";
+        }
+        *pExtensions += PXS_STRING_CRLF;
+        *pExtensions += Translation;
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Translate a 3 letter ID to a Manufacturers Name
+//
+//  Parameters:
+//      PnPID             - the Plug and Play ID
+//      pManufacturerName - receives the manufacturer's name
+//
+//  Remarks:
+//      The 3 character serial number in the EDID data block is the display's
+//      manufacturers Plug and Play Identifier.
+//
+//      Plug and Play ID's are maintained by Microsoft, see "Plug and Play
+//      ID - PNPID Request". A list is available for download:
+//      http://download.microsoft.com/download/7/E/7/7E7662CF-CBEA-470B-A97E-CE7CE0D98DC2/ISA_PNPID_List.xlsx
+//      The last update 3/Feb/2013 which contains 2249 companies
+//
+//  Returns:
+//      void, zero length string "" if not identified
+//===============================================================================================//
+void EdidDecoder::TranslateIdManufacturerCode( const String& PnPID,
+                                               String* pManufacturerName)
+{
+    if ( pManufacturerName == nullptr )
+    {
+        throw ParameterException( L"pManufacturerName", __FUNCTION__ );
+    }
+    *pManufacturerName = PXS_STRING_EMPTY;
+
+    // The map is in ordinal order of the upper case identifiers
+    if ( PnPID.GetLength() == 3 )
+    {
+        wchar_t szPnPID[ 4 ] = { 0 };
+        for ( size_t i = 0; i < 3; i++ )
+        {
+            szPnPID[ i ] = static_cast<wchar_t>( towupper( PnPID.CharAt( i ) ) );
+        }
+
+        size_t lower = 0, upper = ARRAYSIZE( PXS_PNP_ID_MANUFACTURERS );
+        while ( lower < upper )
+        {
+            size_t middle = lower + ( ( upper - lower ) / 2 );
+            int    result = wcscmp( szPnPID, PXS_PNP_ID_MANUFACTURERS[ middle ].pszPnPID );
+            if ( result == 0 )
+            {
+                *pManufacturerName = PXS_PNP_ID_MANUFACTURERS[ middle ].pszManufacturer;
+                break;
+            }
+
+            if ( result < 0 )
+            {
+                upper = middle;
+            }
+            else
+            {
+                lower = middle + 1;
+            }
+        }
+    }
+
+    if ( pManufacturerName->IsEmpty() )
+    {
+        PXSLogAppWarn1( L"Unrecognised PnP ID '%%1'.", PnPID );
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the resolution of the preferred timing
+//
+//  Parameters:
+//      pEdid       - pointer to EDID data block
+//      bufferSize  - size of the data block, must be at least 128 bytes
+//      pResolution - receives the resolution, e.g. "1920 x 1080 pixels"
+//
+//  Remarks:
+//      The first detailed timing descriptor at 0x36 is the preferred timing.
+//      Its pixel clock is zero if the slot holds a display descriptor.
+//
+//  Returns:
+//      void, zero length string "" if there is no preferred timing
+//===============================================================================================//
+void EdidDecoder::TranslatePreferredTiming( const BYTE* pEdid,
+                                            size_t bufferSize, String* pResolution )
+{
+    DWORD     hActive = 0, vActive = 0;
+    Formatter Format;
+
+    if ( pResolution == nullptr )
+    {
+        throw ParameterException( L"pResolution", __FUNCTION__ );
+    }
+    *pResolution = PXS_STRING_EMPTY;
+
+    if ( pEdid == nullptr )
+    {
+        return;     // Nothing to do
+    }
+
+    if ( bufferSize < 128 )
+    {
+        throw ParameterException( L"bufferSize", __FUNCTION__ );
+    }
+
+    if ( ( pEdid[ 0x36 ] == 0 ) && ( pEdid[ 0x37 ] == 0 ) )
+    {
+        return;
+    }
+    hActive = pEdid[ 0x38 ] | ( static_cast<DWORD>( pEdid[ 0x3A ] & 0xF0 ) << 4 );
+    vActive = pEdid[ 0x3B ] | ( static_cast<DWORD>( pEdid[ 0x3D ] & 0xF0 ) << 4 );
+
+    *pResolution  = Format.UInt32( hActive );
+    *pResolution += L" x ";
+    *pResolution += Format.UInt32( vActive );
+    *pResolution += L" pixels";
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Protected Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Private Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Decode one EDID file into a display audit record
+//
+//  Parameters:
+//      FilePath - path to the EDID file
+//      FileName - the file's name, the display name if the EDID has none
+//      pRecord  - receives the record, the caller sets the item number
+//
+//  Returns:
+//      true if the file held EDID data, otherwise false
+//===============================================================================================//
+bool EdidDecoder::DecodeFile( const String& FilePath, const String& FileName, AuditRecord* pRecord )
+{
+    String    Resolution;
+    ByteArray Edid;
+
+    if ( pRecord == nullptr )
+    {
+        throw ParameterException( L"pRecord", __FUNCTION__ );
+    }
+
+    if ( ReadEdidFile( FilePath, &Edid ) == false )
+    {
+        PXSLogAppWarn1( L"No EDID data found in '%%1'.", FilePath );
+        return false;
+    }
+    MakeEdidRecord( Edid.GetPtr(), Edid.GetSize(), 0, FileName, FilePath, pRecord );
+    TranslatePreferredTiming( Edid.GetPtr(), Edid.GetSize(), &Resolution );
+    pRecord->Add( PXS_DISPLAY_RESOLUTION, Resolution );
+
+    return true;
+}
+
+//===============================================================================================//
+//  Description:
+//      Format a video timing as resolution, refresh rate and pixel clock
+//
+//  Parameters:
+//      pixelClockKHz - the pixel clock in kHz
+//      hActive       - horizontal active pixels
+//      hBlank        - horizontal blanking pixels
+//      vActive       - vertical active lines
+//      vBlank        - vertical blanking lines
+//      interlaced    - true if the timing is interlaced
+//      pTiming       - receives the formatted timing
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void EdidDecoder::FormatTiming( DWORD pixelClockKHz,
+                                DWORD hActive,
+                                DWORD hBlank,
+                                DWORD vActive,
+                                DWORD vBlank, bool interlaced, String* pTiming )
+{
+    double    refresh = 0.0, totalPixels = 0.0;
+    Formatter Format;
+
+    if ( pTiming == nullptr )
+    {
+        throw ParameterException( L"pTiming", __FUNCTION__ );
+    }
+
+    totalPixels = static_cast<double>( hActive + hBlank ) * ( vActive + vBlank );
+    if ( totalPixels > 0.0 )
+    {
+        refresh = ( pixelClockKHz * 1000.0 ) / totalPixels;
+    }
+
+    *pTiming  = Format.UInt32( hActive );
+    *pTiming += L" x ";
+    *pTiming += Format.UInt32( vActive );
+    if ( interlaced )
+    {
+        *pTiming += L"i";
+    }
+    *pTiming += L" @ ";
+    *pTiming += Format.Double( refresh, 2 );
+    *pTiming += L"Hz, ";
+    *pTiming += Format.Double( pixelClockKHz / 1000.0, 2 );
+    *pTiming += L"MHz";
+}
+
+//===============================================================================================//
+//  Description:
+//      Translate a CEA-861 extension block
+//
+//  Parameters:
+//      pBlock       - pointer to the 128-byte extension block
+//      pTranslation - receives the translation
+//
+//  Remarks:
+//      Byte 2 is the offset of the first detailed timing descriptor, the data
+//      block collection (revision 3 and later) lies between byte 4 and that
+//      offset. Every offset is checked against the block so a corrupt dump
+//      cannot read past it.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void EdidDecoder::TranslateCeaBlock( const BYTE* pBlock, String* pTranslation )
+{
+    size_t    offset = 0, dtdOffset = 0, length = 0;
+    String    Line, Supports;
+    Formatter Format;
+
+    if ( ( pBlock == nullptr ) || ( pTranslation == nullptr ) )
+    {
+        throw ParameterException( L"pBlock/pTranslation", __FUNCTION__ );
+    }
+    *pTranslation = PXS_STRING_EMPTY;
+
+    *pTranslation += L"\tRevision: ";
+    *pTranslation += Format.UInt8( pBlock[ 1 ] );
+    *pTranslation += PXS_STRING_CRLF;
+
+    // Flags byte is defined from revision 2
+    if ( pBlock[ 1 ] >= 2 )
+    {
+        LPCWSTR Flags[] = { L"underscan", L"basic audio", L"YCbCr 4:4:4", L"YCbCr 4:2:2" };
+        for ( size_t i = 0; i < ARRAYSIZE( Flags ); i++ )
+        {
+            if ( pBlock[ 3 ] & ( 0x80 >> i ) )
+            {
+                if ( Supports.GetLength() )
+                {
+                    Supports += L", ";
+                }
+                Supports += Flags[ i ];
+            }
+        }
+        if ( Supports.GetLength() )
+        {
+            *pTranslation += L"\tSupports: ";
+            *pTranslation += Supports;
+            *pTranslation += PXS_STRING_CRLF;
+        }
+    }
+
+    // Zero means neither data blocks nor detailed timings
+    dtdOffset = pBlock[ 2 ];
+    if ( ( dtdOffset < 4 ) || ( dtdOffset > 127 ) )
+    {
+        return;
+    }
+
+    if ( pBlock[ 1 ] >= 3 )
+    {
+        offset = 4;
+        while ( offset < dtdOffset )
+        {
+            length = pBlock[ offset ] & 0x1F;
+            if ( ( offset + 1 + length ) > dtdOffset )
+            {
+                *pTranslation += L"\tTruncated data block\r\n";
+                break;
+            }
+            TranslateCeaDataBlock( pBlock + offset, &Line );
+            *pTranslation += Line;
+            offset += ( 1 + length );
+        }
+    }
+
+    // Detailed timings run up to the checksum, a zero pixel clock ends them
+    offset = dtdOffset;
+    while ( ( offset + 18 ) <= 127 )
+    {
+        if ( ( pBlock[ offset ] == 0 ) && ( pBlock[ offset + 1 ] == 0 ) )
+        {
+            break;
+        }
+        TranslateDetailedTiming( pBlock + offset, &Line );
+        *pTranslation += L"\tDetailed Timing: ";
+        *pTranslation += Line;
+        *pTranslation += PXS_STRING_CRLF;
+        offset += 18;
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Translate a CEA-861 data block
+//
+//  Parameters:
+//      pDataBlock   - pointer to the data block, the caller has checked that
+//                     the length in the header byte lies within the block
+//      pTranslation - receives the translation
+//
+//  Remarks:
+//      Header byte: bits 7-5 are the tag, bits 4-0 the payload length.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void EdidDecoder::TranslateCeaDataBlock( const BYTE* pDataBlock, String* pTranslation )
+{
+    size_t    i = 0, length = 0;
+    BYTE      tag = 0, vic = 0;
+    DWORD     oui = 0;
+    String    Values;
+    Formatter Format;
+    const BYTE* pPayload = nullptr;
+
+    if ( ( pDataBlock == nullptr ) || ( pTranslation == nullptr ) )
+    {
+        throw ParameterException( L"pDataBlock/pTranslation", __FUNCTION__ );
+    }
+    *pTranslation = PXS_STRING_EMPTY;
+
+    tag      = static_cast<BYTE>( pDataBlock[ 0 ] >> 5 );
+    length   = pDataBlock[ 0 ] & 0x1F;
+    pPayload = pDataBlock + 1;
+    if ( tag == 1 )
+    {
+        // Short audio descriptors, 3 bytes each
+        LPCWSTR Formats[] = { L"Reserved", L"LPCM", L"AC-3", L"MPEG-1", L"MP3", L"MPEG-2",
+                              L"AAC LC", L"DTS", L"ATRAC", L"One Bit Audio", L"E-AC-3",
+                              L"DTS-HD", L"MAT", L"DST", L"WMA Pro", L"Extended" };
+        *pTranslation += L"\tAudio: ";
+        for ( i = 0; ( i + 3 ) <= length; i += 3 )
+        {
+            if ( i )
+            {
+                *pTranslation += L", ";
+            }
+            *pTranslation += Formats[ 0x0F & ( pPayload[ i ] >> 3 ) ];
+            *pTranslation += L" ";
+            *pTranslation += Format.UInt32( ( pPayload[ i ] & 0x07 ) + 1U );
+            *pTranslation += L"ch";
+        }
+    }
+    else if ( tag == 2 )
+    {
+        // Short video descriptors, 129-192 are native formats
+        *pTranslation += L"\tVideo VIC(s): ";
+        for ( i = 0; i < length; i++ )
+        {
+            vic = pPayload[ i ];
+            if ( i )
+            {
+                *pTranslation += L", ";
+            }
+            if ( ( vic >= 129 ) && ( vic <= 192 ) )
+            {
+                *pTranslation += Format.UInt8( static_cast<BYTE>( vic & 0x7F ) );
+                *pTranslation += L" (native)";
+            }
+            else
+            {
+                *pTranslation += Format.UInt8( vic );
+            }
+        }
+    }
+    else if ( tag == 3 )
+    {
+        // Vendor specific, the IEEE OUI is little-endian
+        if ( length >= 3 )
+        {
+            oui = pPayload[ 0 ] |
+                  ( static_cast<DWORD>( pPayload[ 1 ] ) << 8  ) |
+                  ( static_cast<DWORD>( pPayload[ 2 ] ) << 16 );
+        }
+        if ( ( oui == 0x000C03 ) && ( length >= 5 ) )
+        {
+            *pTranslation += L"\tHDMI 1.x: physical address ";
+            *pTranslation += Format.UInt32( pPayload[ 3 ] >> 4U );
+            *pTranslation += PXS_STRING_DOT;
+            *pTranslation += Format.UInt32( pPayload[ 3 ] & 0x0FU );
+            *pTranslation += PXS_STRING_DOT;
+            *pTranslation += Format.UInt32( pPayload[ 4 ] >> 4U );
+            *pTranslation += PXS_STRING_DOT;
+            *pTranslation += Format.UInt32( pPayload[ 4 ] & 0x0FU );
+        }
+        else if ( ( oui == 0xC45DD8 ) && ( length >= 5 ) )
+        {
+            *pTranslation += L"\tHDMI Forum: max. TMDS rate ";
+            *pTranslation += Format.UInt32( pPayload[ 4 ] * 5U );
+            *pTranslation += L"MHz";
+        }
+        else
+        {
+            *pTranslation += L"\tVendor Specific: OUI ";
+            *pTranslation += Format.UInt32Hex( oui, true );
+        }
+    }
+    else if ( tag == 4 )
+    {
+        LPCWSTR Speakers[] = { L"FL/FR", L"LFE", L"FC", L"RL/RR", L"RC", L"FLC/FRC", L"RLC/RRC" };
+        *pTranslation += L"\tSpeakers: ";
+        for ( i = 0; ( length >= 1 ) && ( i < ARRAYSIZE( Speakers ) ); i++ )
+        {
+            if ( pPayload[ 0 ] & ( 1 << i ) )
+            {
+                if ( Values.GetLength() )
+                {
+                    Values += L", ";
+                }
+                Values += Speakers[ i ];
+            }
+        }
+        *pTranslation += Values;
+    }
+    else if ( ( tag == 7 ) && ( length >= 1 ) )
+    {
+        // Extended tag in the first payload byte
+        if ( pPayload[ 0 ] == 0 )
+        {
+            *pTranslation += L"\tVideo Capability";
+        }
+        else if ( ( pPayload[ 0 ] == 5 ) && ( length >= 2 ) )
+        {
+            LPCWSTR Colorimetry[] = { L"xvYCC601", L"xvYCC709", L"sYCC601", L"opYCC601",
+                                      L"opRGB", L"BT2020cYCC", L"BT2020YCC", L"BT2020RGB" };
+            for ( i = 0; i < ARRAYSIZE( Colorimetry ); i++ )
+            {
+                if ( pPayload[ 1 ] & ( 1 << i ) )
+                {
+                    if ( Values.GetLength() )
+                    {
+                        Values += L", ";
+                    }
+                    Values += Colorimetry[ i ];
+                }
+            }
+            *pTranslation += L"\tColorimetry: ";
+            *pTranslation += Values;
+        }
+        else if ( ( pPayload[ 0 ] == 6 ) && ( length >= 2 ) )
+        {
+            LPCWSTR Eotfs[] = { L"SDR", L"HDR", L"SMPTE ST 2084", L"HLG" };
+            for ( i = 0; i < ARRAYSIZE( Eotfs ); i++ )
+            {
+                if ( pPayload[ 1 ] & ( 1 << i ) )
+                {
+                    if ( Values.GetLength() )
+                    {
+                        Values += L", ";
+                    }
+                    Values += Eotfs[ i ];
+                }
+            }
+            *pTranslation += L"\tHDR Static Metadata: ";
+            *pTranslation += Values;
+        }
+        else if ( pPayload[ 0 ] == 7 )
+        {
+            *pTranslation += L"\tHDR Dynamic Metadata";
+        }
+        else if ( pPayload[ 0 ] == 14 )
+        {
+            *pTranslation += L"\tYCbCr 4:2:0 Video";
+        }
+        else if ( pPayload[ 0 ] == 15 )
+        {
+            *pTranslation += L"\tYCbCr 4:2:0 Capability Map";
+        }
+        else
+        {
+            *pTranslation += L"\tExtended Tag ";
+            *pTranslation += Format.UInt8( pPayload[ 0 ] );
+        }
+    }
+    else
+    {
+        *pTranslation += L"\tData Block Tag ";
+        *pTranslation += Format.UInt8( tag );
+    }
+    *pTranslation += PXS_STRING_CRLF;
+}
+
+//===============================================================================================//
+//  Description:
+//      Translate an 18-byte detailed timing descriptor
+//
+//  Parameters:
+//      pDescriptor - pointer to the descriptor
+//      pTiming     - receives the translation
+//
+//  Remarks:
+//      The pixel clock is in units of 10kHz. Active and blanking values are
+//      12-bit, the high nibbles are packed into bytes 4 and 7.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void EdidDecoder::TranslateDetailedTiming( const BYTE* pDescriptor, String* pTiming )
+{
+    DWORD     pixelClock = 0, hActive = 0, hBlank = 0, vActive = 0, vBlank = 0;
+    DWORD     hSize = 0, vSize = 0;
+    Formatter Format;
+
+    if ( ( pDescriptor == nullptr ) || ( pTiming == nullptr ) )
+    {
+        throw ParameterException( L"pDescriptor/pTiming", __FUNCTION__ );
+    }
+
+    pixelClock = pDescriptor[ 0 ] | ( static_cast<DWORD>( pDescriptor[ 1 ] ) << 8 );
+    hActive    = pDescriptor[ 2 ] | ( static_cast<DWORD>( pDescriptor[ 4 ] & 0xF0 ) << 4 );
+    hBlank     = pDescriptor[ 3 ] | ( static_cast<DWORD>( pDescriptor[ 4 ] & 0x0F ) << 8 );
+    vActive    = pDescriptor[ 5 ] | ( static_cast<DWORD>( pDescriptor[ 7 ] & 0xF0 ) << 4 );
+    vBlank     = pDescriptor[ 6 ] | ( static_cast<DWORD>( pDescriptor[ 7 ] & 0x0F ) << 8 );
+    hSize      = pDescriptor[ 12 ] | ( static_cast<DWORD>( pDescriptor[ 14 ] & 0xF0 ) << 4 );
+    vSize      = pDescriptor[ 13 ] | ( static_cast<DWORD>( pDescriptor[ 14 ] & 0x0F ) << 8 );
+
+    FormatTiming( pixelClock * 10,
+                  hActive, hBlank, vActive, vBlank, ( pDescriptor[ 17 ] & 0x80 ) != 0, pTiming );
+    if ( hSize && vSize )
+    {
+        *pTiming += L", ";
+        *pTiming += Format.UInt32( hSize );
+        *pTiming += L"mm x ";
+        *pTiming += Format.UInt32( vSize );
+        *pTiming += L"mm";
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Translate a DisplayID extension block
+//
+//  Parameters:
+//      pBlock       - pointer to the 128-byte extension block
+//      pTranslation - receives the translation
+//
+//  Remarks:
+//      The DisplayID section starts at byte 1 of the extension block, its
+//      data blocks at byte 5. Each data block is tag, revision, payload
+//      length then the payload. Only the timing blocks are decoded.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void EdidDecoder::TranslateDisplayIdBlock( const BYTE* pBlock, String* pTranslation )
+{
+    size_t    offset = 0, endOffset = 0, length = 0, i = 0;
+    BYTE      tag = 0;
+    DWORD     clockUnitKHz = 0;
+    String    Timing;
+    Formatter Format;
+
+    if ( ( pBlock == nullptr ) || ( pTranslation == nullptr ) )
+    {
+        throw ParameterException( L"pBlock/pTranslation", __FUNCTION__ );
+    }
+    *pTranslation = PXS_STRING_EMPTY;
+
+    *pTranslation += L"\tVersion: ";
+    *pTranslation += Format.UInt32( pBlock[ 1 ] >> 4U );
+    *pTranslation += PXS_STRING_DOT;
+    *pTranslation += Format.UInt32( pBlock[ 1 ] & 0x0FU );
+    *pTranslation += PXS_STRING_CRLF;
+
+    // Section length excludes the 5 header bytes and the section checksum,
+    // which precede the block checksum at byte 127
+    endOffset = 5 + static_cast<size_t>( pBlock[ 2 ] );
+    if ( endOffset > 126 )
+    {
+        endOffset = 126;
+    }
+
+    offset = 5;
+    while ( ( offset + 3 ) <= endOffset )
+    {
+        tag    = pBlock[ offset ];
+        length = pBlock[ offset + 2 ];
+        if ( ( offset + 3 + length ) > endOffset )
+        {
+            *pTranslation += L"\tTruncated data block\r\n";
+            break;
+        }
+
+        clockUnitKHz = 0;
+        if ( tag == 0x03 )
+        {
+            clockUnitKHz = 10;      // Type I detailed timing
+        }
+        else if ( tag == 0x22 )
+        {
+            clockUnitKHz = 1;       // Type VII detailed timing
+        }
+
+        if ( clockUnitKHz )
+        {
+            for ( i = 0; ( i + 20 ) <= length; i += 20 )
+            {
+                TranslateDisplayIdTiming( pBlock + offset + 3 + i, clockUnitKHz, &Timing );
+                *pTranslation += L"\tDetailed Timing: ";
+                *pTranslation += Timing;
+                *pTranslation += PXS_STRING_CRLF;
+            }
+        }
+        else if ( tag || length )
+        {
+            *pTranslation += L"\tData Block ";
+            *pTranslation += Format.UInt8Hex( tag, true );
+            *pTranslation += PXS_STRING_CRLF;
+        }
+        else
+        {
+            break;  // Padding
+        }
+        offset += ( 3 + length );
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Translate a 20-byte DisplayID Type I or Type VII timing descriptor
+//
+//  Parameters:
+//      pDescriptor  - pointer to the descriptor
+//      clockUnitKHz - the pixel clock unit, 10kHz for Type I, 1kHz for VII
+//      pTiming      - receives the translation
+//
+//  Remarks:
+//      The pixel clock is 3 bytes, the active and blanking values 2 bytes
+//      each, all little-endian and stored as value - 1.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void EdidDecoder::TranslateDisplayIdTiming( const BYTE* pDescriptor,
+                                            DWORD clockUnitKHz, String* pTiming )
+{
+    DWORD pixelClock = 0, hActive = 0, hBlank = 0, vActive = 0, vBlank = 0;
+
+    if ( ( pDescriptor == nullptr ) || ( pTiming == nullptr ) )
+    {
+        throw ParameterException( L"pDescriptor/pTiming", __FUNCTION__ );
+    }
+
+    pixelClock = pDescriptor[ 0 ] |
+                 ( static_cast<DWORD>( pDescriptor[ 1 ] ) << 8  ) |
+                 ( static_cast<DWORD>( pDescriptor[ 2 ] ) << 16 );
+    hActive    = pDescriptor[ 4  ] | ( static_cast<DWORD>( pDescriptor[ 5  ] ) << 8 );
+    hBlank     = pDescriptor[ 6  ] | ( static_cast<DWORD>( pDescriptor[ 7  ] ) << 8 );
+    vActive    = pDescriptor[ 12 ] | ( static_cast<DWORD>( pDescriptor[ 13 ] ) << 8 );
+    vBlank     = pDescriptor[ 14 ] | ( static_cast<DWORD>( pDescriptor[ 15 ] ) << 8 );
+
+    FormatTiming( ( pixelClock + 1 ) * clockUnitKHz,
+                  hActive + 1,
+                  hBlank  + 1,
+                  vActive + 1, vBlank + 1, ( pDescriptor[ 3 ] & 0x10 ) != 0, pTiming );
+}
+
+//===============================================================================================//
+//  Description:
+//      Translate an EDID data block, the first 128 bytes which corresponds
+//      to EDID version 1
+//
+//  Parameters:
+//      pEdid         - pointer to EDID data block
+//      bufferSize    - size of the data block, must be at least 128 bytes
+//      pMonitorSerial- receives the monitor's serial number
+//      pTextData     - receives any associated text data
+//      pMonitorName  - receives the monitor's name
+//
+//  Remarks:
+//      The descriptor data starts at offset 0x36. There are 4 blocks, each
+//      of 18 bytes.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void EdidDecoder::TranslateEdidDescriptorBlock( const BYTE* pEdid,
+                                                size_t  bufferSize,
+                                                String* pMonitorSerial,
+                                                String* pTextData,
+                                                String* pMonitorName )
+{
+    char   szAnsi[ 32 ] = { 0 };    // Big enough for 13 chars + terminator
+    String DataString;
+
+    if ( pEdid == nullptr )
+    {
+        return;     // Nothing to do
+    }
+
+    // Must have at 126 bytes of data, 0x36 + ( 4 * 18 )
+    if ( bufferSize < 126 )
+    {
+        throw ParameterException( L"bufferSize", __FUNCTION__ );
+    }
+
+    if ( ( pMonitorSerial == nullptr ) || ( pTextData == nullptr ) || ( pMonitorName == nullptr ) )
+    {
+        throw ParameterException( L"nullptr", __FUNCTION__ );
+    }
+    *pMonitorSerial = PXS_STRING_EMPTY;
+    *pTextData      = PXS_STRING_EMPTY;
+    *pMonitorName   = PXS_STRING_EMPTY;
+
+    // Scan for the blocks
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        // Set start in array
+        size_t idxStart = 0x36 + ( i * 18 );  // Each descriptor block is 18 bytes
+
+        // FFh = Monitor Serial Number
+        // FEh = ASCII string
+        // FDh = Monitor Range Limits,
+        // FCh = Monitor name
+        // FBh = Colour Point Data
+        // FAh = Standard Timing Data
+        // F9h = Currently undefined
+        // F8h = Defined by manufacturer
+        BYTE bTag = pEdid[ idxStart + 3 ];
+
+        // Look for tag format 000n0
+        memset( szAnsi, 0, sizeof ( szAnsi ) );
+        if ( ( pEdid[ idxStart + 0 ] == 0 ) &&
+             ( pEdid[ idxStart + 1 ] == 0 ) &&
+             ( pEdid[ idxStart + 2 ] == 0 ) &&
+             ( pEdid[ idxStart + 4 ] == 0 )  )
+        {
+            // pEdid has ASCII data comprising of line-feed separated fields.
+            // The maximum length is 13 characters as its starts at offset 5
+            // and a descriptor block is 18 characters long
+            memcpy( szAnsi, pEdid + idxStart + 5, 13 );
+            szAnsi[ sizeof ( szAnsi ) - 1 ] = 0x00;
+            DataString.SetAnsi( szAnsi );
+            DataString.ReplaceChar( 0x0A, PXS_CHAR_NULL );
+            if ( bTag == 0xFF )
+            {
+                *pMonitorSerial = DataString;
+            }
+            else if ( bTag == 0xFE )
+            {
+                // Concat to existing data
+                *pTextData += DataString;
+            }
+            else if ( bTag == 0xFC )
+            {
+                // Concat to existing data
+                *pMonitorName += DataString;
+            }
+        }
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Run the worker thread. This method must only be called by the worker.
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      Takes files until none are left or told to stop. A file that fails is
+//      logged and skipped, its slot keeps no category.
+//
+//  Returns:
+//      DWORD system error code
+//===============================================================================================//
+DWORD EdidDecoder::RunWorkerThread()
+{
+    LONG   index = 0;
+    size_t numFiles = 0;
+    String Message;
+    AuditRecord Record;
+
+    if ( m_pBatchMT == nullptr )
+    {
+        return ERROR_INVALID_FUNCTION;
+    }
+    numFiles = m_pBatchMT->pFilePaths->GetSize();
+
+    while ( m_bRunMT )
+    {
+        index = InterlockedIncrement( &m_pBatchMT->nextIndex ) - 1;
+        if ( static_cast<size_t>( index ) >= numFiles )
+        {
+            break;
+        }
+
+        try
+        {
+            if ( DecodeFile( m_pBatchMT->pFilePaths->Get( static_cast<size_t>( index ) ),
+                             m_pBatchMT->pFileNames->Get( static_cast<size_t>( index ) ),
+                             &Record ) )
+            {
+                m_pBatchMT->pRecords->Set( static_cast<size_t>( index ), Record );
+            }
+        }
+        catch ( const Exception& e )
+        {
+            Message  = L"Error decoding EDID file '";
+            Message += m_pBatchMT->pFilePaths->Get( static_cast<size_t>( index ) );
+            Message += L"'.";
+            PXSLogException( Message.c_str(), e, __FUNCTION__ );
+        }
+    }
+
+    return ERROR_SUCCESS;
+}
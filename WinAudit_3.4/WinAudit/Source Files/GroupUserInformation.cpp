@@ -50,6 +50,7 @@
 #include "PxsBase/Header Files/Formatter.h"
 #include "PxsBase/Header Files/NullException.h"
 #include "PxsBase/Header Files/ParameterException.h"
+#include "PxsBase/Header Files/StringHashIndex.h"
 #include "PxsBase/Header Files/SystemException.h"
 #include "PxsBase/Header Files/TArray.h"
 
@@ -192,7 +193,11 @@ void GroupUserInformation::GetGroupMemberRecords(
             pRecords->Add( MemberRecord );
         }
     }
-    PXSSortAuditRecords( pRecords, PXS_GROUPMEMBERS_GROUP_NAME );
+
+    // Order by group then member
+    const DWORD ITEM_IDS[]  = { PXS_GROUPMEMBERS_GROUP_NAME, PXS_GROUPMEMBERS_MEMBER_NAME };
+    const DWORD KEY_TYPES[] = { PXS_SORT_KEY_STRING, PXS_SORT_KEY_STRING };
+    PXSSortAuditRecordsByKeys( pRecords, ITEM_IDS, KEY_TYPES, ARRAYSIZE( ITEM_IDS ) );
 }
 
 //===============================================================================================//
@@ -241,6 +246,61 @@ void GroupUserInformation::GetGroupPolicyRecords( TArray< AuditRecord >* pRecord
     PXSSortAuditRecords( pRecords, PXS_GROUPPOLICY_GROUP_NAME );
 }
 
+//===============================================================================================//
+//  Description:
+//      Get the groups of which an account is a member
+//
+//  Parameters:
+//      MemberName  - the account name
+//      localGroups - true for local groups, false for global groups
+//      haveIndex   - true if the membership index was built
+//      Members     - the unique member names, see MakeMembershipIndex
+//      GroupLists  - the comma separated groups of each member
+//      MemberIndex - the index of the member names
+//      pGroups     - receives the comma separated group names
+//
+//  Remarks:
+//      If the index could not be built falls back to asking for the groups
+//      of the account, which logs rather than throws on error.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void GroupUserInformation::GetMemberGroups( const String& MemberName,
+                                            bool localGroups,
+                                            bool haveIndex,
+                                            const StringArray& Members,
+                                            const StringArray& GroupLists,
+                                            const StringHashIndex& MemberIndex, String* pGroups )
+{
+    size_t idxMember = 0;
+
+    if ( pGroups == nullptr )
+    {
+        throw ParameterException( L"pGroups", __FUNCTION__ );
+    }
+    *pGroups = PXS_STRING_EMPTY;
+
+    if ( haveIndex == false )
+    {
+        if ( localGroups )
+        {
+            GetUserLocalGroups( MemberName, pGroups );
+        }
+        else
+        {
+            GetUserGlobalGroups( MemberName, pGroups );
+        }
+        return;
+    }
+
+    idxMember = FindMembership( MemberName, Members, MemberIndex );
+    if ( idxMember != PXS_MINUS_ONE )
+    {
+        *pGroups = GroupLists.Get( idxMember );
+    }
+}
+
 //===============================================================================================//
 //  Description:
 //        Get the user names as an array of audit records
@@ -252,20 +312,27 @@ void GroupUserInformation::GetGroupPolicyRecords( TArray< AuditRecord >* pRecord
 //      Normally, NetUserGetInfo does not require admin/account operator
 //      privileges.
 //
+//      Group memberships are read once per group and joined to the users in
+//      memory. If that fails, e.g. access is denied, falls back to asking
+//      for the groups of each user.
+//
 //  Returns:
 //      void
 //===============================================================================================//
 void GroupUserInformation::GetUserRecords( TArray< AuditRecord >* pRecords )
 {
+    bool      haveLocalIndex = false, haveGlobalIndex = false;
     DWORD     index = 0;   // First call to NetQueryDisplayInformation
     DWORD     returnedEntryCount = 0, lastIndex = 0;
     String    LocalGroups, GlobalGroups, Value, UserName;
     String    AccountStatus, FullName, Comment, LocaleNo, LocaleYes;
     String    LocaleDays, LocaleDay, Temp;
     Formatter Format;
+    StringArray       LocalMembers, LocalGroupLists, GlobalMembers, GlobalGroupLists;
     AuditRecord       Record;
     NET_API_STATUS    status = 0;
     NET_DISPLAY_USER* pDisplayUsers = nullptr;
+    StringHashIndex   LocalIndex, GlobalIndex;
 
     if ( pRecords == nullptr )
     {
@@ -279,6 +346,27 @@ void GroupUserInformation::GetUserRecords( TArray< AuditRecord >* pRecords )
     PXSGetResourceString( PXS_IDS_144_DAYS, &LocaleDays );
     PXSGetResourceString( PXS_IDS_143_DAY , &LocaleDay  );
 
+    // Member to groups indexes
+    try
+    {
+        GetMembershipIndex( true, &LocalMembers, &LocalGroupLists, &LocalIndex );
+        haveLocalIndex = true;
+    }
+    catch ( const Exception& e )
+    {
+        PXSLogException( L"Failed to index local group members.", e, __FUNCTION__ );
+    }
+
+    try
+    {
+        GetMembershipIndex( false, &GlobalMembers, &GlobalGroupLists, &GlobalIndex );
+        haveGlobalIndex = true;
+    }
+    catch ( const Exception& e )
+    {
+        PXSLogException( L"Failed to index global group members.", e, __FUNCTION__ );
+    }
+
     do
     {
         // On Windows 2000 and newer the limit is 100 entries
@@ -317,28 +405,37 @@ void GroupUserInformation::GetUserRecords( TArray< AuditRecord >* pRecords )
                     TranslateUserAccountFlags( pDisplayUsers[ i ].usri1_flags,
                                                &AccountStatus );
 
-                    // Get more information with NetUserGetInfo at level 11
+                    // Level 4 has all the logon data, if it cannot be read
+                    // level 11 has all but the expiry data
                     passwordAge  = 0;          // Zero signifies unknown
                     lastLogon    = 0;          // Zero signifies unknown
                     lastLogoff   = 0;          // Zero signifies unknown
                     numberLogons = DWORD_MAX;  // -1 signifies unknown
                     numBadLogons = DWORD_MAX;  // -1 signifies unknown
-                    GetUserInfo_11( UserName,
-                                    &passwordAge,
-                                    &lastLogon, &lastLogoff, &numberLogons, &numBadLogons );
-
-                    // Get level 4 information
                     passwordExpired = false;
                     accountExpires  = TIMEQ_FOREVER;   // Implies no expiry
-                    GetUserInfo_4( UserName, &passwordExpired, &accountExpires );
-
-                    // Get Local Group membership as comma separated list
-                    LocalGroups = PXS_STRING_EMPTY;
-                    GetUserLocalGroups( UserName, &LocalGroups );
+                    if ( GetUserInfo_4( UserName,
+                                        &passwordAge,
+                                        &lastLogon,
+                                        &lastLogoff,
+                                        &numberLogons,
+                                        &numBadLogons,
+                                        &passwordExpired, &accountExpires ) == false )
+                    {
+                        GetUserInfo_11( UserName,
+                                        &passwordAge,
+                                        &lastLogon, &lastLogoff, &numberLogons, &numBadLogons );
+                    }
 
-                    // Get Global Group membership as comma separated list
-                    GlobalGroups = PXS_STRING_EMPTY;
-                    GetUserGlobalGroups( UserName, &GlobalGroups );
+                    // Group memberships as comma separated lists
+                    GetMemberGroups( UserName,
+                                     true,
+                                     haveLocalIndex,
+                                     LocalMembers, LocalGroupLists, LocalIndex, &LocalGroups );
+                    GetMemberGroups( UserName,
+                                     false,
+                                     haveGlobalIndex,
+                                     GlobalMembers, GlobalGroupLists, GlobalIndex, &GlobalGroups );
 
                     // Make the record
                     FullName = pDisplayUsers[ i ].usri1_full_name;
@@ -429,6 +526,104 @@ void GroupUserInformation::GetUserRecords( TArray< AuditRecord >* pRecords )
     PXSSortAuditRecords( pRecords, PXS_USERS_USERNAME );
 }
 
+//===============================================================================================//
+//  Description:
+//      Callback for PXSStableSortIndexes to compare the group names
+//
+//  Parameters:
+//      index1   - index of the first name
+//      index2   - index of the second name
+//      pContext - pointer to the StringArray of group names
+//
+//  Returns:
+//      -ve, 0 or +ve for a case insensitive comparison of the names
+//===============================================================================================//
+static int SortIndexCompareGroupNames( size_t index1, size_t index2, const void* pContext )
+{
+    const StringArray* pGroupNames = static_cast<const StringArray*>( pContext );
+
+    return PXSCompareString( pGroupNames->Get( index1 ), pGroupNames->Get( index2 ), false );
+}
+
+//===============================================================================================//
+//  Description:
+//      Make an index of the groups to which each account belongs
+//
+//  Parameters:
+//      GroupNames   - the group names
+//      GroupMembers - the member names of each group
+//      DomainPrefix - for local groups the account domain followed by a
+//                     backslash, empty for global groups
+//      pMembers     - receives the unique member names
+//      pGroupLists  - receives the comma separated groups of each member
+//      pMemberIndex - receives the case insensitive index of pMembers
+//
+//  Remarks:
+//      Each member's groups are listed in alphabetical order. Local group
+//      members are named domain\account, only those that start with
+//      DomainPrefix are indexed and the prefix is removed.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void GroupUserInformation::MakeMembershipIndex( const StringArray& GroupNames,
+                                                const TArray< StringArray >& GroupMembers,
+                                                const String& DomainPrefix,
+                                                StringArray* pMembers,
+                                                StringArray* pGroupLists,
+                                                StringHashIndex* pMemberIndex )
+{
+    size_t  i = 0, j = 0, numGroups = GroupNames.GetSize(), numMembers = 0;
+    size_t* pOrder = nullptr;
+    String  GroupName, MemberName;
+    AllocateBytes AllocBytes;
+
+    if ( ( pMembers == nullptr ) || ( pGroupLists == nullptr ) || ( pMemberIndex == nullptr ) )
+    {
+        throw ParameterException( L"pMembers/pGroupLists/pMemberIndex", __FUNCTION__ );
+    }
+    pMembers->RemoveAll();
+    pGroupLists->RemoveAll();
+    pMemberIndex->RemoveAll();
+
+    if ( GroupMembers.GetSize() != numGroups )
+    {
+        throw ParameterException( L"GroupMembers", __FUNCTION__ );
+    }
+
+    if ( numGroups == 0 )
+    {
+        return;     // Nothing to do
+    }
+    pOrder = reinterpret_cast<size_t*>(
+                          AllocBytes.New( PXSMultiplySizeT( numGroups, sizeof ( size_t ) ) ) );
+    for ( i = 0; i < numGroups; i++ )
+    {
+        pOrder[ i ] = i;
+    }
+    PXSStableSortIndexes( pOrder, numGroups, SortIndexCompareGroupNames, &GroupNames );
+
+    for ( i = 0; i < numGroups; i++ )
+    {
+        GroupName  = GroupNames.Get( pOrder[ i ] );
+        const StringArray& Members = GroupMembers.Get( pOrder[ i ] );
+        numMembers = Members.GetSize();
+        for ( j = 0; j < numMembers; j++ )
+        {
+            MemberName = Members.Get( j );
+            if ( DomainPrefix.GetLength() )
+            {
+                if ( MemberName.StartsWithI( DomainPrefix.c_str() ) == false )
+                {
+                    continue;
+                }
+                MemberName = Members.Get( j ) + DomainPrefix.GetLength();
+            }
+            AddMembership( MemberName, GroupName, pMembers, pGroupLists, pMemberIndex );
+        }
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Protected Methods
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -437,6 +632,137 @@ void GroupUserInformation::GetUserRecords( TArray< AuditRecord >* pRecords )
 // Private Methods
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+//===============================================================================================//
+//  Description:
+//      Add a group to the membership index of the specified member
+//
+//  Parameters:
+//      MemberName   - the member's account name
+//      GroupName    - the group's name
+//      pMembers     - the unique member names
+//      pGroupLists  - the comma separated groups of each member
+//      pMemberIndex - case insensitive index of the member names in pMembers
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void GroupUserInformation::AddMembership( const String& MemberName,
+                                          const String& GroupName,
+                                          StringArray* pMembers,
+                                          StringArray* pGroupLists, StringHashIndex* pMemberIndex )
+{
+    String GroupList;
+
+    if ( ( pMembers == nullptr ) || ( pGroupLists == nullptr ) || ( pMemberIndex == nullptr ) )
+    {
+        throw ParameterException( L"pMembers/pGroupLists/pMemberIndex", __FUNCTION__ );
+    }
+
+    if ( MemberName.IsEmpty() || GroupName.IsEmpty() )
+    {
+        return;     // Nothing to do
+    }
+
+    size_t idxMember = pMemberIndex->Find( *pMembers, MemberName.c_str(), false );
+    if ( idxMember == PXS_MINUS_ONE )
+    {
+        pMembers->Add( MemberName );
+        pGroupLists->Add( GroupName );
+        pMemberIndex->Add( MemberName.c_str(), false, pMembers->GetSize() - 1 );
+    }
+    else
+    {
+        GroupList  = pGroupLists->Get( idxMember );
+        GroupList += L", ";
+        GroupList += GroupName;
+        pGroupLists->Set( idxMember, GroupList.c_str() );
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Find a member in a membership index
+//
+//  Parameters:
+//      MemberName  - the member's account name
+//      Members     - the unique member names
+//      MemberIndex - the index of the member names, see AddMembership
+//
+//  Returns:
+//      Index of the member in Members, PXS_MINUS_ONE if not found
+//===============================================================================================//
+size_t GroupUserInformation::FindMembership( const String& MemberName,
+                                             const StringArray& Members,
+                                             const StringHashIndex& MemberIndex )
+{
+    if ( MemberName.IsEmpty() )
+    {
+        return PXS_MINUS_ONE;
+    }
+
+    return MemberIndex.Find( Members, MemberName.c_str(), false );
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the name of the domain that holds this computer's accounts
+//
+//  Parameters:
+//      pDomainName - receives the domain name
+//
+//  Remarks:
+//      This is the computer name, or on a domain controller the domain name.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void GroupUserInformation::GetAccountDomainName( String* pDomainName )
+{
+    NTSTATUS   status = 0;
+    LSA_HANDLE PolicyHandle = nullptr;
+    LSA_OBJECT_ATTRIBUTES ObjectAttributes;
+    POLICY_ACCOUNT_DOMAIN_INFO* pDomainInfo = nullptr;
+
+    if ( pDomainName == nullptr )
+    {
+        throw ParameterException( L"pDomainName", __FUNCTION__ );
+    }
+    *pDomainName = PXS_STRING_EMPTY;
+
+    memset( &ObjectAttributes, 0, sizeof ( ObjectAttributes ) );
+    status = LsaOpenPolicy( nullptr,               // Local computer
+                            &ObjectAttributes, POLICY_VIEW_LOCAL_INFORMATION, &PolicyHandle );
+    if ( status )
+    {
+        throw SystemException( LsaNtStatusToWinError( status ), L"LsaOpenPolicy", __FUNCTION__ );
+    }
+
+    if ( PolicyHandle == nullptr )
+    {
+        throw NullException( L"PolicyHandle", __FUNCTION__ );
+    }
+
+    status = LsaQueryInformationPolicy( PolicyHandle,
+                                        PolicyAccountDomainInformation,
+                                        reinterpret_cast<PVOID*>( &pDomainInfo ) );
+    LsaClose( PolicyHandle );
+    if ( status )
+    {
+        throw SystemException( LsaNtStatusToWinError( status ),
+                               L"LsaQueryInformationPolicy", __FUNCTION__ );
+    }
+
+    if ( pDomainInfo )
+    {
+        if ( pDomainInfo->DomainName.Buffer )
+        {
+            pDomainName->AppendChars( pDomainInfo->DomainName.Buffer,
+                                      pDomainInfo->DomainName.Length / sizeof ( wchar_t ) );
+        }
+        LsaFreeMemory( pDomainInfo );
+    }
+}
+
 //===============================================================================================//
 //  Description:
 //      Get the comment associates with the specified global group
@@ -992,6 +1318,70 @@ void GroupUserInformation::GetLocalGroupNames( StringArray* pGroupNames )
     pGroupNames->Sort( true );
 }
 
+//===============================================================================================//
+//  Description:
+//      Make an index of the groups to which each account belongs
+//
+//  Parameters:
+//      localGroups  - true for local groups, false for global groups
+//      pMembers     - receives the unique member names
+//      pGroupLists  - receives the comma separated groups of each member
+//      pMemberIndex - receives the index of the member names
+//
+//  Remarks:
+//      One enumeration per group replaces the per user calls to
+//      NetUserGetLocalGroups and NetUserGetGroups. Local group members are
+//      named domain\account, only those in this computer's account domain
+//      are indexed.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void GroupUserInformation::GetMembershipIndex( bool localGroups,
+                                               StringArray* pMembers,
+                                               StringArray* pGroupLists,
+                                               StringHashIndex* pMemberIndex )
+{
+    String      GroupName, Prefix;
+    StringArray GroupNames, Members;
+    TArray< StringArray > GroupMembers;
+
+    if ( ( pMembers == nullptr ) || ( pGroupLists == nullptr ) || ( pMemberIndex == nullptr ) )
+    {
+        throw ParameterException( L"pMembers/pGroupLists/pMemberIndex", __FUNCTION__ );
+    }
+    pMembers->RemoveAll();
+    pGroupLists->RemoveAll();
+    pMemberIndex->RemoveAll();
+
+    if ( localGroups )
+    {
+        GetAccountDomainName( &Prefix );
+        Prefix += L"\\";
+        GetLocalGroupNames( &GroupNames );
+    }
+    else
+    {
+        GetGlobalGroupNames( &GroupNames );
+    }
+
+    size_t numGroups = GroupNames.GetSize();
+    for ( size_t i = 0; i < numGroups; i++ )
+    {
+        GroupName = GroupNames.Get( i );
+        if ( localGroups )
+        {
+            GetLocalGroupMembers3( GroupName, &Members );
+        }
+        else
+        {
+            GetGlobalGroupMembers( GroupName, &Members );
+        }
+        GroupMembers.Add( Members );
+    }
+    MakeMembershipIndex( GroupNames, GroupMembers, Prefix, pMembers, pGroupLists, pMemberIndex );
+}
+
 //===============================================================================================//
 //  Description:
 //      Get the global groups of which the specified user is a member
@@ -1050,7 +1440,7 @@ void GroupUserInformation::GetUserGlobalGroups( const String& UserName, String*
 
     for ( i = 0; i < entriesRead; i++ )
     {
-        GroupName = pGroupUsers->grui0_name;
+        GroupName = pGroupUsers[ i ].grui0_name;
         if ( GroupName.GetLength() )
         {
             if ( pGlobalGroups->GetLength() )
@@ -1068,35 +1458,57 @@ void GroupUserInformation::GetUserGlobalGroups( const String& UserName, String*
 //
 //  Parameters:
 //      UserName         - pointer to the user's name
+//      pPasswordAge     - receives the password age in days
+//      pLastLogon       - receives the last logon time
+//      pLastLogoff      - receives the last logoff time
+//      pNumberLogons    - receives the number of logons
+//      pNumBadLogons    - receives the number of bad logon attempts
 //      pPasswordExpired - receives if the password has expired
-//      pPasswordExpired - receives when the account expires
+//      pAccountExpires  - receives when the account expires
 //
 //  Remarks:
-//      See USER_INFO_4 Structure
+//      See USER_INFO_4 Structure, it is a superset of USER_INFO_11 so one
+//      call gets all the data.
 //
 //      Will log errors rather than throw as this method is used to get
 //      optional information
 //
 //  Returns:
-//      void
+//      true if got the data, otherwise false
 //===============================================================================================//
-void GroupUserInformation::GetUserInfo_4( const String& UserName,
-                                          bool*   pPasswordExpired, DWORD* pAccountExpires )
+bool GroupUserInformation::GetUserInfo_4( const String& UserName,
+                                          DWORD* pPasswordAge,
+                                          DWORD* pLastLogon,
+                                          DWORD* pLastLogoff,
+                                          DWORD* pNumberLogons,
+                                          DWORD* pNumBadLogons,
+                                          bool*  pPasswordExpired, DWORD* pAccountExpires )
 {
     String Insert2;
     USER_INFO_4*   pUserInfo = nullptr;
     NET_API_STATUS status = 0;
 
-    if ( ( pPasswordExpired == nullptr ) || ( pAccountExpires == nullptr ) )
+    if ( ( pPasswordAge     == nullptr ) ||
+         ( pLastLogon       == nullptr ) ||
+         ( pLastLogoff      == nullptr ) ||
+         ( pNumberLogons    == nullptr ) ||
+         ( pNumBadLogons    == nullptr ) ||
+         ( pPasswordExpired == nullptr ) ||
+         ( pAccountExpires  == nullptr )  )
     {
         throw ParameterException( L"nullptr", __FUNCTION__ );
     }
+    *pPasswordAge     = 0;          // = unknown
+    *pLastLogon       = 0;          // = unknown
+    *pLastLogoff      = 0;          // = unknown
+    *pNumberLogons    = DWORD_MAX;  // = unknown
+    *pNumBadLogons    = DWORD_MAX;  // = unknown
     *pPasswordExpired = false;
     *pAccountExpires  = TIMEQ_FOREVER;
 
     if ( UserName.IsEmpty() )
     {
-        return;     // Nothing to do
+        return true;    // Nothing to do
     }
 
     status = NetUserGetInfo( nullptr,
@@ -1108,22 +1520,30 @@ void GroupUserInformation::GetUserInfo_4( const String& UserName,
         Insert2.SetAnsi( __FUNCTION__ );
         PXSLogNetError2( status,
                          L"NetUserGetInfo(4) failed for user '%%1' in '%%2'.", UserName, Insert2 );
-        return;
+        return false;
     }
 
     if ( pUserInfo == nullptr )
     {
         Insert2.SetAnsi( __FUNCTION__ );
         PXSLogAppError2( L"No data for user '%%1' in '%%2'.", UserName, Insert2 );
-        return;
+        return false;
     }
     AutoNetApiBufferFree AutoFreeUserInfo( pUserInfo );
 
+    *pPasswordAge  = pUserInfo->usri4_password_age /( 24 * 3600 );
+    *pLastLogon    = pUserInfo->usri4_last_logon;
+    *pLastLogoff   = pUserInfo->usri4_last_logoff;
+    *pNumberLogons = pUserInfo->usri4_num_logons;
+    *pNumBadLogons = pUserInfo->usri4_bad_pw_count;
+
     if ( pUserInfo->usri4_password_expired )
     {
         *pPasswordExpired = true;
     }
     *pAccountExpires = pUserInfo->usri4_acct_expires;
+
+    return true;
 }
 
 //===============================================================================================//
@@ -53,6 +53,7 @@
 #include "PxsBase/Header Files/TArray.h"
 
 // 5. This Project
+#include "WinAudit/Header Files/AccountNameCache.h"
 #include "WinAudit/Header Files/AuditRecord.h"
 #include "WinAudit/Header Files/Ddk.h"
 #include "WinAudit/Header Files/PrinterInformation.h"
@@ -89,12 +90,14 @@ ObjectPermissionInformation::~ObjectPermissionInformation()
 //      Get printer and share permissions
 //
 //  Parameters:
-//      pRecords - array to receive the data
+//      pAccountNameCache - resolves the trustee and owner SIDs
+//      pRecords          - array to receive the data
 //
 //  Returns:
 //      void
 //===============================================================================================//
-void ObjectPermissionInformation::GetAuditRecords( TArray< AuditRecord >* pRecords )
+void ObjectPermissionInformation::GetAuditRecords( AccountNameCache* pAccountNameCache,
+                                                   TArray< AuditRecord >* pRecords )
 {
     size_t      i = 0, numElements = 0;
     String      Name;
@@ -103,9 +106,9 @@ void ObjectPermissionInformation::GetAuditRecords( TArray< AuditRecord >* pRecor
     TArray< AuditRecord >     PermissionRecords;
     WindowsNetworkInformation WindowsNetworkInfo;
 
-    if ( pRecords == nullptr )
+    if ( ( pAccountNameCache == nullptr ) || ( pRecords == nullptr ) )
     {
-        throw ParameterException( L"pRecords", __FUNCTION__ );
+        throw ParameterException( L"pAccountNameCache/pRecords", __FUNCTION__ );
     }
     pRecords->RemoveAll();
 
@@ -116,7 +119,7 @@ void ObjectPermissionInformation::GetAuditRecords( TArray< AuditRecord >* pRecor
     {
         Name = PrinterNames.Get( i );
         PermissionRecords.RemoveAll();
-        GetObjectPermissionRecords( Name, SE_PRINTER, &PermissionRecords );
+        GetObjectPermissionRecords( Name, SE_PRINTER, pAccountNameCache, &PermissionRecords );
         pRecords->Append( PermissionRecords );
     }
 
@@ -127,7 +130,7 @@ void ObjectPermissionInformation::GetAuditRecords( TArray< AuditRecord >* pRecor
     {
         Name = ShareNames.Get( i );
         PermissionRecords.RemoveAll();
-        GetObjectPermissionRecords( Name, SE_LMSHARE, &PermissionRecords );
+        GetObjectPermissionRecords( Name, SE_LMSHARE, pAccountNameCache, &PermissionRecords );
         pRecords->Append( PermissionRecords );
     }
     PXSSortAuditRecords( pRecords, PXS_PERMISSIONS_OBJECT_NAME );
@@ -141,64 +144,6 @@ void ObjectPermissionInformation::GetAuditRecords( TArray< AuditRecord >* pRecor
 // Private Methods
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-//===============================================================================================//
-//  Description:
-//      Get the account name from the specified security identifier
-//
-//  Parameters:
-//      pSid         - pointer to the SID
-//      pAccountName - receives the account name
-//
-//  Returns:
-//      void, empty string if SID not recognised
-//===============================================================================================//
-void ObjectPermissionInformation::GetAccountNameFromSid( const PSID pSid, String* pAccountName )
-{
-    DWORD   cchName = 0, cchDomainName = 0;
-    wchar_t szName[ MAX_PATH + 1 ] = { 0 };
-    wchar_t szDomainName[ MAX_PATH + 1 ] = { 0 };
-    Formatter    Format;
-    SID_NAME_USE eUse = SidTypeUnknown;
-
-    if ( pAccountName == nullptr )
-    {
-        throw ParameterException( L"pAccountName", __FUNCTION__ );
-    }
-    *pAccountName = PXS_STRING_EMPTY;
-
-    if ( pSid == nullptr )
-    {
-        return;     // No account name
-    }
-
-    cchName = ARRAYSIZE( szName );
-    cchDomainName = ARRAYSIZE( szDomainName );
-    if ( LookupAccountSid( nullptr,     // = local machine
-                           pSid, szName, &cchName, szDomainName, &cchDomainName, &eUse ) )
-    {
-        szName[ ARRAYSIZE( szName ) - 1 ] = PXS_CHAR_NULL;
-        szDomainName[ ARRAYSIZE( szDomainName ) - 1 ] = PXS_CHAR_NULL;
-
-        // Pre-pend the domain name if have it
-        if ( szDomainName[ 0 ] != PXS_CHAR_NULL )
-        {
-            *pAccountName  = szDomainName;
-            *pAccountName += PXS_PATH_SEPARATOR;
-        }
-        *pAccountName += szName;
-    }
-    else
-    {
-        // May not get an account name. e.g. ERROR_NONE_MAPPED. This happens
-        // for some ACEs of SE_WINDOWS_OBJECT. In which case will convert
-        // the SID to a string
-        DWORD lastError = GetLastError();
-        *pAccountName   = Format.SidToString( pSid );
-        PXSLogSysError1( lastError,
-                        L"LookupAccountSid failed for SID = '%%1'.", *pAccountName );
-    }
-}
-
 //===============================================================================================//
 //  Description:
 //      Get the desktop's security information
@@ -297,9 +242,10 @@ void ObjectPermissionInformation::GetNonWindowSecurity(const String& ObjectName,
 //      Get the permissions of the specified object
 //
 //  Parameters:
-//      ObjectName - the object's name
-//      objectType - defined enumeration constant of the object type
-//      pRecords   - array to receive the data
+//      ObjectName        - the object's name
+//      objectType        - defined enumeration constant of the object type
+//      pAccountNameCache - resolves the trustee and owner SIDs
+//      pRecords          - array to receive the data
 //
 //  Remarks:
 //      Rights are tabulated in "Provider-Independent and Windows NT Access
@@ -314,6 +260,7 @@ void ObjectPermissionInformation::GetNonWindowSecurity(const String& ObjectName,
 //===============================================================================================//
 void ObjectPermissionInformation::GetObjectPermissionRecords( const String& ObjectName,
                                                               SE_OBJECT_TYPE objectType,
+                                                              AccountNameCache* pAccountNameCache,
                                                               TArray< AuditRecord >* pRecords )
 {
     bool workStation = false;
@@ -362,7 +309,8 @@ void ObjectPermissionInformation::GetObjectPermissionRecords( const String& Obje
         {
             MakeObjectPermissionRecords( ObjectName,
                                          objectType,
-                                         workStation, pSecurityDescriptor, pRecords );
+                                         workStation,
+                                         pSecurityDescriptor, pAccountNameCache, pRecords );
         }
         else
         {
@@ -507,8 +455,13 @@ bool ObjectPermissionInformation::HasAllAccess( ACCESS_MASK accessMask,
 //      type        - the type of object
 //      workStation - flag to indicate its a windows station object
 //      ppSecurityDescriptor - receives the security descriptor
+//      pAccountNameCache    - resolves the trustee and owner SIDs
 //      pRecords    - string array to receive the formatted data
 //
+//  Remarks:
+//      The owner and trustee SIDs are resolved with one batched lookup
+//      before the records are made.
+//
 //  Returns:
 //      void
 //===============================================================================================//
@@ -517,6 +470,7 @@ void ObjectPermissionInformation::MakeObjectPermissionRecords(
                                                          SE_OBJECT_TYPE type,
                                                          bool workStation,
                                                          PSECURITY_DESCRIPTOR pSecurityDescriptor,
+                                                         AccountNameCache* pAccountNameCache,
                                                          TArray< AuditRecord >* pRecords )
 {
     BOOL   fOwnerDefaulted = FALSE, daclPresent = FALSE, daclDefaulted = FALSE;
@@ -526,11 +480,12 @@ void ObjectPermissionInformation::MakeObjectPermissionRecords(
     String Permissions, Trustee;
     Formatter   Format;
     AuditRecord Record;
+    TArray< PSID > Sids;
     ACCESS_ALLOWED_ACE* pACE = nullptr;
 
-    if ( pRecords == nullptr )
+    if ( ( pAccountNameCache == nullptr ) || ( pRecords == nullptr ) )
     {
-        throw ParameterException( L"pRecords", __FUNCTION__ );
+        throw ParameterException( L"pAccountNameCache/pRecords", __FUNCTION__ );
     }
     pRecords->RemoveAll();
 
@@ -559,20 +514,36 @@ void ObjectPermissionInformation::MakeObjectPermissionRecords(
 
 
     // Get the owning SID so can get the owner's name
-    if ( GetSecurityDescriptorOwner( pSecurityDescriptor, &pSidOwner, &fOwnerDefaulted ) )
-    {
-        GetAccountNameFromSid( pSidOwner, &Owner );
-    }
-    else
+    if ( GetSecurityDescriptorOwner( pSecurityDescriptor, &pSidOwner, &fOwnerDefaulted ) == 0 )
     {
         // Log and continue as this information is optional
         PXSLogSysError( GetLastError(), L"GetSecurityDescriptorOwner failed." );
+        pSidOwner = nullptr;
     }
 
     // A nullptr DACL is not an error as not all objects are have security. In
     // fact, MSDN: "A value of TRUE for lpbDaclPresent does not mean that
     // pDacl is not nullptr."
     GetSecurityDescriptorDacl( pSecurityDescriptor, &daclPresent, &pDacl, &daclDefaulted );
+
+    // Resolve the owner and trustees in one go
+    Sids.SetSize( pDacl ? pDacl->AceCount + 1u : 1u );
+    Sids.Set( 0, pSidOwner );
+    for ( WORD i = 0; pDacl && ( i < pDacl->AceCount ); i++ )
+    {
+        pACE = nullptr;
+        if ( GetAce( pDacl, i, reinterpret_cast<void**>( &pACE ) ) && pACE )
+        {
+            Sids.Set( 1u + i, (PSID)&pACE->SidStart );
+        }
+        else
+        {
+            Sids.Set( 1u + i, nullptr );
+        }
+    }
+    pAccountNameCache->LookupSids( Sids.GetPtr( 0 ), Sids.GetSize() );
+    pAccountNameCache->GetAccountName( pSidOwner, true, &Owner );
+
     if ( pDacl )
     {
         // Get each ACE in the DACL
@@ -590,7 +561,7 @@ void ObjectPermissionInformation::MakeObjectPermissionRecords(
             }
 
             Trustee = PXS_STRING_EMPTY;
-            GetAccountNameFromSid( (PSID)&pACE->SidStart, &Trustee );
+            pAccountNameCache->GetAccountName( (PSID)&pACE->SidStart, true, &Trustee );
 
             AceType = PXS_STRING_EMPTY;
             TranslateAceType( pACE->Header.AceType, &AceType );
@@ -1541,6 +1541,79 @@ void Odbc::SetStmtAttr( SQLHSTMT   StatementHandle,
     }
 }
 
+//===============================================================================================//
+//  Description:
+//      Wrapper for SQLStatistics
+//
+//  Parameters:
+//      See the ODBC documentation
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void Odbc::Statistics( SQLHSTMT     StatementHandle,
+                       const String& CatalogName,
+                       const String& SchemaName,
+                       const String& TableName, SQLUSMALLINT Unique, SQLUSMALLINT Reserved )
+{
+    size_t   numChars = 0;
+    wchar_t* pszCatalogName = nullptr;
+    wchar_t* pszSchemaName  = nullptr;
+    wchar_t* pszTableName   = nullptr;
+    String      ErrorMessage;
+    SQLRETURN   sqlReturn;
+    SQLSMALLINT NameLength1 = 0, NameLength2 = 0, NameLength3 = 0;
+    AllocateWChars AllocCatalog, AllocSchema, AllocTable;
+
+    // The table name is required
+    if ( TableName.IsEmpty() )
+    {
+        throw ParameterException( L"TableName", __FUNCTION__ );
+    }
+
+    // SQLStatistics wants non-const strings
+    numChars = CatalogName.GetLength();
+    if ( numChars )
+    {
+        NameLength1    = SQL_NTS;
+        numChars       = PXSAddSizeT( numChars, 1 );        // Terminator
+        pszCatalogName = AllocCatalog.New( numChars );
+        PXSStringCchCopy( pszCatalogName, numChars, CatalogName.c_str(), __FUNCTION__ );
+    }
+
+    numChars = SchemaName.GetLength();
+    if ( numChars )
+    {
+        NameLength2   = SQL_NTS;
+        numChars      = PXSAddSizeT( numChars, 1 );
+        pszSchemaName = AllocSchema.New( numChars );
+        PXSStringCchCopy( pszSchemaName, numChars, SchemaName.c_str(), __FUNCTION__ );
+    }
+
+    NameLength3  = SQL_NTS;
+    numChars     = PXSAddSizeT( TableName.GetLength(), 1 );
+    pszTableName = AllocTable.New( numChars );
+    PXSStringCchCopy( pszTableName, numChars, TableName.c_str(), __FUNCTION__ );
+
+    sqlReturn = SQLStatistics( StatementHandle,
+                               pszCatalogName,
+                               NameLength1,
+                               pszSchemaName,
+                               NameLength2, pszTableName, NameLength3, Unique, Reserved );
+    if ( sqlReturn == SQL_SUCCESS_WITH_INFO )
+    {
+        MakeErrorMsg( sqlReturn, SQL_HANDLE_STMT, StatementHandle, &ErrorMessage );
+        PXSLogAppInfo1( L"SQLStatistics SQL_SUCCESS_WITH_INFO: '%%1'.", ErrorMessage );
+    }
+
+    if ( !SQL_SUCCEEDED( sqlReturn ) )
+    {
+        MakeErrorMsg( sqlReturn, SQL_HANDLE_STMT, StatementHandle, &ErrorMessage );
+        throw Exception( PXS_ERROR_TYPE_APPLICATION,
+                         PXS_ERROR_DB_OPERATION_FAILED, ErrorMessage.c_str(), "SQLStatistics" );
+    }
+}
+
 //===============================================================================================//
 //  Description:
 //      Wrapper for SQLTables
@@ -50,6 +50,7 @@
 // 3. C++ System Files
 
 // 4. Other Libraries
+#include "PxsBase/Header Files/AllocateWChars.h"
 #include "PxsBase/Header Files/Application.h"
 #include "PxsBase/Header Files/Exception.h"
 #include "PxsBase/Header Files/Formatter.h"
@@ -57,6 +58,7 @@
 #include "PxsBase/Header Files/ParameterException.h"
 #include "PxsBase/Header Files/StringArray.h"
 #include "PxsBase/Header Files/SystemInformation.h"
+#include "PxsBase/Header Files/TArray.h"
 
 // 5. This Project
 #include "WinAudit/Header Files/OdbcRecordSet.h"
@@ -522,6 +524,153 @@ SQLLEN OdbcDatabase::ExecuteDirect( const String& SqlQuery )
     return rowCount;
 }
 
+//===============================================================================================//
+//  Description:
+//      Prepare and execute a parameterised SELECT statement
+//
+//  Parameters:
+//      SqlQuery   - the SQL statement with a ? marker for each parameter
+//      Parameters - the parameter values, an empty string is bound as NULL
+//      pRows      - receives the result set, one string array per row
+//
+//  Remarks:
+//      Parameters and fields are bound as character data and the driver
+//      converts to/from the column's type. A NULL field is returned as
+//      an empty string and fields longer than MAX_FIELD_CHARS are truncated.
+//
+//      As the values are never spliced into the statement text, the
+//      server sees the same text on every call so can reuse its plan.
+//
+//  Returns:
+//      number of rows fetched
+//===============================================================================================//
+size_t OdbcDatabase::ExecuteSelectParams( const String& SqlQuery,
+                                          const StringArray& Parameters,
+                                          TArray< StringArray >* pRows )
+{
+    const size_t MAX_FIELD_CHARS = 256;
+    size_t       i = 0, numChars = 0, numParams = 0, numColumns = 0;
+    LPCWSTR      pszValue = nullptr;
+    wchar_t*     pszSQL   = nullptr;
+    wchar_t*     pFields  = nullptr;
+    SQLLEN*      pLengths = nullptr;
+    SQLHSTMT     StatementHandle = nullptr;
+    SQLSMALLINT  columnCount = 0;
+    SQLUSMALLINT number = 0;
+    StringArray  Row;
+    TArray< SQLLEN > ParamLengths, FieldLengths;
+    AllocateWChars   AllocSQL, AllocFields;
+
+    // Verify connected to database
+    if ( IsConnected() == false )
+    {
+        throw Exception( PXS_ERROR_TYPE_APPLICATION,
+                         PXS_ERROR_DB_NOT_CONNECTED, PXS_STRING_EMPTY, __FUNCTION__ );
+    }
+
+    if ( SqlQuery.IsEmpty() )
+    {
+        throw ParameterException( L"SqlQuery", __FUNCTION__ );
+    }
+
+    if ( pRows == nullptr )
+    {
+        throw ParameterException( L"pRows", __FUNCTION__ );
+    }
+    pRows->RemoveAll();
+
+    // SQLPrepare wants a non-const pointer
+    numChars = PXSAddSizeT( SqlQuery.GetLength(), 1 );       // + Terminator
+    pszSQL   = AllocSQL.New( numChars );
+    PXSStringCchCopy( pszSQL, numChars, SqlQuery.c_str(), __FUNCTION__ );
+    PXSLogAppInfo1( L"OdbcDatabase::ExecuteSelectParams: '%%1'", SqlQuery );
+
+    numParams = Parameters.GetSize();
+    ParamLengths.SetSize( numParams );
+    m_ODBC.AllocHandle( SQL_HANDLE_STMT, m_ConnectionHandle, &StatementHandle );
+    try
+    {
+        SetQueryTimeoutAttr( StatementHandle );
+        m_ODBC.Prepare( StatementHandle, pszSQL, SQL_NTS );
+        for ( i = 0; i < numParams; i++ )
+        {
+            numChars = 0;
+            pszValue = Parameters.Get( i );
+            if ( pszValue )
+            {
+                numChars = wcslen( pszValue );
+            }
+            pLengths = ParamLengths.GetPtr( i );
+            if ( numChars )
+            {
+                *pLengths = SQL_NTS;
+            }
+            else
+            {
+                *pLengths = SQL_NULL_DATA;
+                numChars  = 1;                 // Column size must be non-zero
+            }
+            number = PXSCastSizeTToUInt16( PXSAddSizeT( i, 1 ) );
+            m_ODBC.BindParameter( StatementHandle,
+                                  number,
+                                  SQL_PARAM_INPUT,
+                                  SQL_C_WCHAR,
+                                  SQL_VARCHAR,
+                                  numChars,
+                                  0,
+                                  const_cast< wchar_t* >( pszValue ),   // Input only
+                                  0,
+                                  pLengths );
+        }
+        m_ODBC.Execute( StatementHandle );
+
+        // Bind every column to a fixed width slot in one buffer
+        m_ODBC.NumResultCols( StatementHandle, &columnCount );
+        numColumns = PXSCastInt16ToSizeT( columnCount );
+        if ( numColumns )
+        {
+            pFields = AllocFields.New( PXSMultiplySizeT( numColumns, MAX_FIELD_CHARS ) );
+            FieldLengths.SetSize( numColumns );
+            for ( i = 0; i < numColumns; i++ )
+            {
+                number = PXSCastSizeTToUInt16( PXSAddSizeT( i, 1 ) );
+                m_ODBC.BindCol( StatementHandle,
+                                number,
+                                SQL_C_WCHAR,
+                                pFields + ( i * MAX_FIELD_CHARS ),
+                                PXSCastSizeTToSqlLen( MAX_FIELD_CHARS * sizeof ( wchar_t ) ),
+                                FieldLengths.GetPtr( i ) );
+            }
+
+            Row.SetSize( numColumns );
+            while ( m_ODBC.Fetch( StatementHandle ) != SQL_NO_DATA )
+            {
+                for ( i = 0; i < numColumns; i++ )
+                {
+                    if ( FieldLengths.Get( i ) == SQL_NULL_DATA )
+                    {
+                        Row.Set( i, PXS_STRING_EMPTY );
+                    }
+                    else
+                    {
+                        pFields[ ( i * MAX_FIELD_CHARS ) + MAX_FIELD_CHARS - 1 ] = PXS_CHAR_NULL;
+                        Row.Set( i, pFields + ( i * MAX_FIELD_CHARS ) );
+                    }
+                }
+                pRows->Add( Row );
+            }
+        }
+    }
+    catch ( const Exception& )
+    {
+        m_ODBC.FreeHandle( SQL_HANDLE_STMT, StatementHandle );
+        throw;
+    }
+    m_ODBC.FreeHandle( SQL_HANDLE_STMT, StatementHandle );
+
+    return pRows->GetSize();
+}
+
 //===============================================================================================//
 //  Description:
 //      Execute a SELECT query and return the SQLINTEGER result
@@ -536,8 +685,7 @@ SQLLEN OdbcDatabase::ExecuteDirect( const String& SqlQuery )
 bool OdbcDatabase::ExecuteSelectSqlInteger( const String& SqlQuery, SQLINTEGER* pSqlInteger )
 {
     bool          success = false;
-    String        FieldValue;
-    Formatter     Format;
+    __int64       value   = 0;
     OdbcRecordSet RecordSet;
 
     if ( pSqlInteger == nullptr )
@@ -553,10 +701,9 @@ bool OdbcDatabase::ExecuteSelectSqlInteger( const String& SqlQuery, SQLINTEGER*
         return false;   // No data
     }
 
-    FieldValue = RecordSet.FieldValue( 0 );
-    if ( FieldValue.GetLength() )
+    if ( RecordSet.FieldInt64( 0, &value ) )
     {
-        *pSqlInteger = Format.StringToInt32( FieldValue );
+        *pSqlInteger = PXSCastInt64ToInt32( value );
         success = true;
     }
 
@@ -576,9 +723,9 @@ bool OdbcDatabase::ExecuteSelectSqlInteger( const String& SqlQuery, SQLINTEGER*
 //      executed within the transaction will also be rolled back
 //
 //  Returns:
-//      Void
+//      count of rows affected, -1 if unknown
 //===============================================================================================//
-void OdbcDatabase::ExecuteTrans( const String& SqlQuery, SQLLEN maxRecordsAffected )
+SQLLEN OdbcDatabase::ExecuteTrans( const String& SqlQuery, SQLLEN maxRecordsAffected )
 {
     SQLLEN rowCount = 0;
     String ErrorMessage;
@@ -606,11 +753,12 @@ void OdbcDatabase::ExecuteTrans( const String& SqlQuery, SQLLEN maxRecordsAffect
     FreeTransactionStatement();
     SetQueryTimeoutAttr( m_hTransactionStatement );
     m_ODBC.ExecDirect( m_hTransactionStatement, SqlQuery );
+
+    // Get the count, if it is unavailable then the returned value is -1,
+    // for example in a SELECT query
+    m_ODBC.RowCount( m_hTransactionStatement, &rowCount );
     if ( PXS_SQLLEN_MAX != maxRecordsAffected )
     {
-        // Get the count, if it is unavailable then the returned value is -1,
-        // for example in a SELECT query
-        m_ODBC.RowCount( m_hTransactionStatement, &rowCount );
         if ( ( rowCount != -1 ) &&
              ( rowCount > maxRecordsAffected ) )
         {
@@ -627,6 +775,8 @@ void OdbcDatabase::ExecuteTrans( const String& SqlQuery, SQLLEN maxRecordsAffect
         }
     }
     FreeTransactionStatement();     // Reuse the statement
+
+    return rowCount;
 }
 
 //===============================================================================================//
@@ -868,6 +1018,79 @@ const String& OdbcDatabase::GetDbmsName() const
     return m_DbmsName;
 }
 
+//===============================================================================================//
+//  Description:
+//     Get the names of the indexes on a table
+//
+//  Parameters:
+//      TableName - the table name as it is in the catalogue
+//      pIndexes  - array object to receive the index names
+//
+//  Remarks:
+//      The table's statistics row has no index name so is skipped
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void OdbcDatabase::GetIndexes( const String& TableName, StringArray* pIndexes )
+{
+    SQLLEN   StrLen_or_Ind = 0;
+    String   DatabaseName, NullSchemaName;
+    SQLHSTMT StatementHandle = nullptr;
+
+    if ( pIndexes == nullptr )
+    {
+        throw ParameterException( L"pIndexes", __FUNCTION__ );
+    }
+    pIndexes->RemoveAll();
+
+    if ( IsConnected() == false )
+    {
+        throw Exception ( PXS_ERROR_TYPE_APPLICATION,
+                          PXS_ERROR_DB_NOT_CONNECTED, PXS_STRING_EMPTY, __FUNCTION__ );
+    }
+
+    // Must have a database name as the catalogue
+    GetDatabaseName( &DatabaseName );
+    if ( DatabaseName.IsEmpty() )
+    {
+       throw FunctionException( L"DatabaseName", __FUNCTION__ );
+    }
+
+    // Catch all exceptions so can clean up the statement handle
+    m_ODBC.AllocHandle( SQL_HANDLE_STMT, m_ConnectionHandle, &StatementHandle);
+    try
+    {
+        SetQueryTimeoutAttr( StatementHandle );
+        m_ODBC.Statistics( StatementHandle,
+                           DatabaseName,
+                           NullSchemaName,          // All schemas
+                           TableName, SQL_INDEX_ALL, SQL_QUICK );
+
+        wchar_t  szIndexName[ 256 ] = { 0 };  // Enough for any index name
+        m_ODBC.BindCol( StatementHandle,
+                        6,             // = INDEX_NAME
+                        SQL_C_TCHAR, szIndexName, ARRAYSIZE( szIndexName ), &StrLen_or_Ind );
+
+        memset( szIndexName, 0, sizeof ( szIndexName ) );
+        while ( SQL_NO_DATA != m_ODBC.Fetch( StatementHandle ) )
+        {
+            szIndexName[ ARRAYSIZE( szIndexName ) - 1 ] = PXS_CHAR_NULL;
+            if ( StrLen_or_Ind != SQL_NULL_DATA )
+            {
+                pIndexes->AddUniqueI( szIndexName );    // One row per indexed column
+            }
+            memset( szIndexName, 0, sizeof ( szIndexName ) );   // Next pass
+        }
+    }
+    catch ( const Exception& )
+    {
+        m_ODBC.FreeHandle( SQL_HANDLE_STMT, StatementHandle );
+        throw;
+    }
+    m_ODBC.FreeHandle( SQL_HANDLE_STMT, StatementHandle );
+}
+
 //===============================================================================================//
 //  Description:
 //     Get the database's major and minor version numbers
@@ -67,7 +67,10 @@ OdbcExportDialog::OdbcExportDialog()
                  :m_bDidExport(),
                   m_idxProgressMessageStatic( PXS_MINUS_ONE ),
                   m_uNumColumns( 0 ),
+                  m_uRowBytes( 0 ),
+                  m_uRowCapacity( 0 ),
                   m_pColumnProps( nullptr ),
+                  m_pRowBuffer( nullptr ),
                   m_pRowStatus( nullptr ),
                   m_AuditMasterRecord(),
                   m_ComputerMasterRecord(),
@@ -196,6 +199,8 @@ void OdbcExportDialog::ExportRecordsToDatabase( AuditDatabase* pDatabase, String
     SQLHDBC      hDBC   = nullptr;
     SQLINTEGER   auditID = 0, computerID = 0;
     SQLUSMALLINT columnNumber = 0;
+    BYTE*        pTargetValue = nullptr;
+    BYTE*        pIndicator   = nullptr;
 
     if ( pDatabase == nullptr )
     {
@@ -246,29 +251,37 @@ void OdbcExportDialog::ExportRecordsToDatabase( AuditDatabase* pDatabase, String
 
     // Start database work
     startTickCount = GetTickCount64();
-    FreeAuditDataBindBuffers();
     AllocateAuditDataBindBuffers( pDatabase );
     pDatabase->BeginTrans();
 
-    // Identify the Computer_ID, if none then create one
-    computerID = pDatabase->IdentifyComputerID( m_ComputerMasterRecord );
-    if ( computerID == 0 )
+    // The connection may be reused so never leave the transaction open
+    try
     {
-        computerID = pDatabase->InsertComputerMaster( m_ComputerMasterRecord );
-    }
-    ComputerIDString = Format.Int32( computerID );
-    PXSLogAppInfo1( L"The Computer_ID for this computer is: %%1.", ComputerIDString );
-    m_ProgressBar.SetPercentage( 60 );
+        // Identify the Computer_ID, if none then create one
+        computerID = pDatabase->IdentifyComputerID( m_ComputerMasterRecord );
+        if ( computerID == 0 )
+        {
+            computerID = pDatabase->InsertComputerMaster( m_ComputerMasterRecord );
+        }
+        ComputerIDString = Format.Int32( computerID );
+        PXSLogAppInfo1( L"The Computer_ID for this computer is: %%1.", ComputerIDString );
+        m_ProgressBar.SetPercentage( 60 );
 
-    // Get the Audit ID
-    auditID = pDatabase->InsertAuditMaster( computerID, m_AuditMasterRecord );
-    AuditIDString = Format.Int32( auditID );
-    PXSLogAppInfo1( L"The Audit_ID for this audit is: %%1.", AuditIDString );
-    m_ProgressBar.SetPercentage( 70 );
+        // Get the Audit ID
+        auditID = pDatabase->InsertAuditMaster( computerID, m_AuditMasterRecord );
+        AuditIDString = Format.Int32( auditID );
+        PXSLogAppInfo1( L"The Audit_ID for this audit is: %%1.", AuditIDString );
+        m_ProgressBar.SetPercentage( 70 );
 
-    // Allocate a statement and set its properties
-    hDBC = pDatabase->GetConnectionHandle();
-    OdbcObject.AllocHandle( SQL_HANDLE_STMT, hDBC, &hStmt );
+        // Allocate a statement and set its properties
+        hDBC = pDatabase->GetConnectionHandle();
+        OdbcObject.AllocHandle( SQL_HANDLE_STMT, hDBC, &hStmt );
+    }
+    catch ( const Exception& )
+    {
+        pDatabase->RollbackTrans();
+        throw;
+    }
     try
     {
         // Optional query time out. Not supported by all databases
@@ -283,7 +296,7 @@ void OdbcExportDialog::ExportRecordsToDatabase( AuditDatabase* pDatabase, String
         OdbcObject.SetStmtAttr(
                             hStmt,
                             SQL_ATTR_ROW_BIND_TYPE,
-                            nullptr,            // SQL_BIND_BY_COLUMN = 0
+                            reinterpret_cast<SQLPOINTER>( m_uRowBytes ),  // Row-wise
                             SQL_IS_UINTEGER );
         OdbcObject.SetStmtAttr(
                             hStmt,
@@ -318,12 +331,15 @@ void OdbcExportDialog::ExportRecordsToDatabase( AuditDatabase* pDatabase, String
         {
             columnNumber = PXSCastSizeTToUInt16( i );   // SQLUSMALLINT = USHORT
             columnNumber = PXSAddUInt16( columnNumber, 1 );
+            // Row-wise so these are the addresses in the first row
+            pTargetValue = m_pRowBuffer + m_pColumnProps[ i ].valueOffset;
+            pIndicator   = m_pRowBuffer + m_pColumnProps[ i ].indicatorOffset;
             OdbcObject.BindCol( hStmt,
                                 columnNumber,
                                 m_pColumnProps[ i ].TargetType,
-                                m_pColumnProps[ i ].TargetValuePtr,
+                                pTargetValue,
                                 m_pColumnProps[ i ].BufferLength,
-                                m_pColumnProps[ i ].StrLen_or_Ind );
+                                reinterpret_cast<SQLLEN*>( pIndicator ) );
         }
         OdbcObject.BulkOperations( hStmt, SQL_ADD );
         m_ProgressBar.SetPercentage( 90 );
@@ -359,14 +375,8 @@ void OdbcExportDialog::ExportRecordsToDatabase( AuditDatabase* pDatabase, String
     {
         pDatabase->CommitTrans();
 
-        // Update the computer_master table with the audit id.
-        SqlQuery  = L"UPDATE Computer_Master SET Last_Audit_ID=";
-        SqlQuery += AuditIDString;
-        SqlQuery += L" WHERE Computer_ID=";
-        SqlQuery += ComputerIDString;
-        pDatabase->BeginTrans();
-        pDatabase->ExecuteTrans( SqlQuery, 1 );   // Limit to 1 row
-        pDatabase->CommitTrans();
+        // Make this the computer's last audit, also updates the report summaries
+        pDatabase->SetLastAuditID( computerID, auditID );
 
         // Result message
         AddedCount  = Format.UInt32( numRowsAdded );
@@ -951,14 +961,22 @@ void OdbcExportDialog::InitDialogEvent()
 //  Parameters:
 //      pDatabase - the audit database
 //
+//  Remarks:
+//      The buffers of a previous export are kept if the table has the same
+//      column types and they have room for all the records. Each row holds
+//      the value of a column followed by its length/indicator, aligned so
+//      the next column starts on a SQLLEN boundary.
+//
 //  Returns:
 //      void
 //===============================================================================================//
 void OdbcExportDialog::AllocateAuditDataBindBuffers( AuditDatabase* pDatabase )
 {
     const size_t  NUM_COLUMNS = 54;     // 4 integer + 50 string columns
+    const size_t  ALIGN_BYTES = sizeof ( SQLLEN );
     Odbc          OdbcObject;
-    size_t        i = 0, numRecords = 0;
+    bool          sameLayout = false;
+    size_t        i = 0, numRecords = 0, length = 0, rowBytes = 0;
     String        SqlQuery, ErrorMessage;
     Formatter     Format;
     OdbcRecordSet RecordSet;
@@ -999,76 +1017,97 @@ void OdbcExportDialog::AllocateAuditDataBindBuffers( AuditDatabase* pDatabase )
         }
     }
 
-    // Free
-    FreeAuditDataBindBuffers();
-
-    // Alloc the columns
-    m_pColumnProps = new TYPE_COLUMN_PROPS[ columnCount ];
-    if ( m_pColumnProps == nullptr )
+    // See if the columns bind as before
+    if ( m_pColumnProps && ( m_uNumColumns == columnCount ) )
     {
-        throw MemoryException( __FUNCTION__ );
+        sameLayout = true;
+        for ( i = 0; i < m_uNumColumns; i++ )
+        {
+            if ( m_pColumnProps[ i ].sqlType !=
+                                           GetBindSqlType( RecordSet.GetColumnSqlType( i ) ) )
+            {
+                sameLayout = false;
+            }
+        }
     }
-    memset( m_pColumnProps, 0, sizeof ( TYPE_COLUMN_PROPS ) * columnCount );
-    m_uNumColumns = columnCount;
 
-    // Allocate the row status fields
     numRecords = m_AuditRecords.GetSize();
-    m_pRowStatus = new SQLUSMALLINT[ numRecords ];
-    if ( m_pRowStatus == nullptr )
+    if ( sameLayout && ( numRecords <= m_uRowCapacity ) )
     {
-        throw MemoryException( __FUNCTION__ );
+        return;     // Reuse
     }
-    memset( m_pRowStatus, 0, sizeof ( SQLUSMALLINT ) * numRecords );
 
-    // Initialise and alloc the field buffers, column-wise
-    for ( i = 0; i < m_uNumColumns; i++ )
+    if ( sameLayout == false )
     {
-        size_t      length     = 0;
-        SQLSMALLINT columnType = RecordSet.GetColumnSqlType( i );
-        if ( columnType == SQL_INTEGER )
-        {
-            length = sizeof ( SQLINTEGER );
-            m_pColumnProps[ i ].sqlType    = SQL_INTEGER;
-            m_pColumnProps[ i ].TargetType = SQL_C_SLONG;
-        }
-        else if ( ( columnType == SQL_CHAR        ) ||
-                  ( columnType == SQL_VARCHAR     ) ||
-                  ( columnType == SQL_LONGVARCHAR )  )
-        {
-            length = PXSAddSizeT( MAX_COL_SIZE_CHARS, 1 );  // Account for NULL
-            length = PXSMultiplySizeT( length, sizeof ( char ) );
-            m_pColumnProps[ i ].sqlType    = SQL_VARCHAR;
-            m_pColumnProps[ i ].TargetType = SQL_C_CHAR;
-        }
-        else
-        {
-            // Wide strings
-            length = PXSAddSizeT( MAX_COL_SIZE_CHARS, 1 );  // Account for NULL
-            length = PXSMultiplySizeT( length, sizeof ( wchar_t ) );
-            m_pColumnProps[ i ].sqlType    = SQL_WVARCHAR;
-            m_pColumnProps[ i ].TargetType = SQL_C_WCHAR;
-        }
+        FreeAuditDataBindBuffers();
 
-        size_t numBytes = PXSMultiplySizeT( length, numRecords );
-        m_pColumnProps[ i ].BufferLength   = PXSCastSizeTToSqlLen( length );
-        m_pColumnProps[ i ].TargetValuePtr = new BYTE[ numBytes ];
-        if ( m_pColumnProps[ i ].TargetValuePtr == nullptr )
+        // Alloc the columns
+        m_pColumnProps = new TYPE_COLUMN_PROPS[ columnCount ];
+        if ( m_pColumnProps == nullptr )
         {
             throw MemoryException( __FUNCTION__ );
         }
-        memset( m_pColumnProps[ i ].TargetValuePtr, 0, numBytes );
-        m_pColumnProps[ i ].numBytes = numBytes;
+        memset( m_pColumnProps, 0, sizeof ( TYPE_COLUMN_PROPS ) * columnCount );
+        m_uNumColumns = columnCount;
 
-        // Allocate StrLen_or_Ind for each column
-        m_pColumnProps[ i ].StrLen_or_Ind = new SQLLEN[ numRecords ];
-        if ( m_pColumnProps[ i ].StrLen_or_Ind == nullptr )
+        // Lay out the row
+        for ( i = 0; i < m_uNumColumns; i++ )
         {
-            throw MemoryException( __FUNCTION__ );
+            m_pColumnProps[ i ].sqlType = GetBindSqlType( RecordSet.GetColumnSqlType( i ) );
+            if ( m_pColumnProps[ i ].sqlType == SQL_INTEGER )
+            {
+                length = sizeof ( SQLINTEGER );
+                m_pColumnProps[ i ].TargetType = SQL_C_SLONG;
+            }
+            else if ( m_pColumnProps[ i ].sqlType == SQL_VARCHAR )
+            {
+                length = PXSAddSizeT( MAX_COL_SIZE_CHARS, 1 );  // Account for NULL
+                length = PXSMultiplySizeT( length, sizeof ( char ) );
+                m_pColumnProps[ i ].TargetType = SQL_C_CHAR;
+            }
+            else
+            {
+                // Wide strings
+                length = PXSAddSizeT( MAX_COL_SIZE_CHARS, 1 );  // Account for NULL
+                length = PXSMultiplySizeT( length, sizeof ( wchar_t ) );
+                m_pColumnProps[ i ].TargetType = SQL_C_WCHAR;
+            }
+            m_pColumnProps[ i ].BufferLength = PXSCastSizeTToSqlLen( length );
+            m_pColumnProps[ i ].valueOffset  = rowBytes;
+            rowBytes = PXSAddSizeT( rowBytes, length );
+            rowBytes = PXSAddSizeT( rowBytes, ALIGN_BYTES - 1 ) & ~( ALIGN_BYTES - 1 );
+            m_pColumnProps[ i ].indicatorOffset = rowBytes;
+            rowBytes = PXSAddSizeT( rowBytes, sizeof ( SQLLEN ) );
         }
-        memset( m_pColumnProps[ i ].StrLen_or_Ind,
-                0,
-                sizeof ( SQLLEN ) * numRecords );
+        m_uRowBytes = rowBytes;
+    }
+
+    // Allocate the rows and their status fields
+    if ( m_pRowBuffer )
+    {
+        delete [] m_pRowBuffer;
+        m_pRowBuffer = nullptr;
+    }
+
+    if ( m_pRowStatus )
+    {
+        delete [] m_pRowStatus;
+        m_pRowStatus = nullptr;
+    }
+    m_uRowCapacity = 0;
+
+    m_pRowBuffer = new BYTE[ PXSMultiplySizeT( m_uRowBytes, numRecords ) ];
+    if ( m_pRowBuffer == nullptr )
+    {
+        throw MemoryException( __FUNCTION__ );
+    }
+
+    m_pRowStatus = new SQLUSMALLINT[ numRecords ];
+    if ( m_pRowStatus == nullptr )
+    {
+        throw MemoryException( __FUNCTION__ );
     }
+    m_uRowCapacity = numRecords;
 }
 
 //===============================================================================================//
@@ -1204,123 +1243,127 @@ void OdbcExportDialog::ExportRecords()
 //      Bind the data to the buffers for the Audit_Data table
 //
 //  Parameters:
-//      none
+//      auditID    - the audit identifier
+//      computerID - the computer identifier
+//
+//  Remarks:
+//      Every field of every row is written as the buffers hold the previous
+//      export. Values are copied or converted straight from the records and
+//      truncated to the column buffer, their lengths are set explicitly.
 //
 //  Returns:
 //      void
 //===============================================================================================//
 void OdbcExportDialog::FillAuditDataBindBuffers( SQLINTEGER auditID, SQLINTEGER computerID )
 {
-    size_t  length, offset, maxChars;
-    char    szAnsi[ MAX_COL_SIZE_CHARS + 1 ] = { 0 };
-    wchar_t szWide[ MAX_COL_SIZE_CHARS + 1 ] = { 0 };
-    String  Value;
-    SQLINTEGER   recordOrdinal = 0;
-    Formatter    Format;
-    AuditRecord  Record;
-    StringArray  Values;
+    int        numBytes = 0, wideChars = 0, ansiBytes = 0;
+    size_t     i = 0, j = 0, numRecords = 0, numValues = 0, numChars = 0, maxChars = 0;
+    BYTE*      pRow = nullptr;
+    BYTE*      pValue = nullptr;
+    char*      pszAnsi = nullptr;
+    SQLLEN*    pIndicator = nullptr;
+    LPCWSTR    pszValue = nullptr;
+    SQLINTEGER sqlInteger = 0;
 
     if ( ( auditID == 0 ) || ( computerID == 0 ) )
     {
         throw ParameterException( L"auditID/computerID", __FUNCTION__ );
     }
 
-    if ( ( m_pColumnProps == nullptr ) || ( m_pRowStatus == nullptr ) )
+    if ( ( m_pColumnProps == nullptr ) ||
+         ( m_pRowBuffer   == nullptr ) || ( m_pRowStatus == nullptr ) )
     {
-        throw NullException( L"m_pColumnProps/m_pRowStatus", __FUNCTION__ );
+        throw NullException( L"m_pColumnProps/m_pRowBuffer/m_pRowStatus", __FUNCTION__ );
     }
 
-    size_t numRecords = m_AuditRecords.GetSize();
-    for ( size_t i = 0; i < numRecords; i++ )
+    numRecords = m_AuditRecords.GetSize();
+    if ( numRecords > m_uRowCapacity )
     {
-        DWORD categoryID = 0;
-        recordOrdinal    = PXSAddInt32( recordOrdinal, 1 );
-        Values.RemoveAll();
-        Record = m_AuditRecords.Get( i );
-        Record.GetCategoryIdAndValues( &categoryID, &Values );
-        size_t numValues = Values.GetSize();
+        throw SystemException( ERROR_INSUFFICIENT_BUFFER, L"m_uRowCapacity", __FUNCTION__ );
+    }
+    memset( m_pRowStatus, 0, sizeof ( SQLUSMALLINT ) * numRecords );
 
-        // The first four columns are integers
-        size_t dataBytes       = 0;
-        SQLPOINTER pData       = nullptr;
-        SQLLEN     strLenOrInd = 0;
-        SQLINTEGER sqlInteger  = 0;
-        for ( size_t j = 0; j < m_uNumColumns; j++ )
+    for ( i = 0; i < numRecords; i++ )
+    {
+        const AuditRecord& Record = m_AuditRecords.Get( i );
+        numValues = Record.GetNumberOfValues();
+        pRow      = m_pRowBuffer + PXSMultiplySizeT( i, m_uRowBytes );
+        for ( j = 0; j < m_uNumColumns; j++ )
         {
-            pData = nullptr;
-            if ( j == 0 )               // Audit ID
-            {
-                pData     = &auditID;
-                dataBytes = sizeof ( auditID );
-            }
-            else if ( j == 1 )          // Record Ordinal
-            {
-                recordOrdinal = PXSAddInt32( recordOrdinal, 1 );
-                pData         = &recordOrdinal;
-                dataBytes     = sizeof ( recordOrdinal );
-            }
-            else if ( j == 2 )          // Computer ID
-            {
-                pData     = &computerID;
-                dataBytes = sizeof ( computerID );
-            }
-            else if ( j == 3 )          // Category ID
+            pValue     = pRow + m_pColumnProps[ j ].valueOffset;
+            pIndicator = reinterpret_cast<SQLLEN*>( pRow + m_pColumnProps[ j ].indicatorOffset );
+            maxChars   = PXSCastSqlLenToSizeT( m_pColumnProps[ j ].BufferLength );
+            if ( j < 4 )
             {
-                sqlInteger = PXSCastUInt32ToSqlInteger( categoryID );
-                pData      = &sqlInteger;
-                dataBytes   = sizeof ( sqlInteger );
+                // The first four columns are integers
+                if ( j == 0 )               // Audit ID
+                {
+                    sqlInteger = auditID;
+                }
+                else if ( j == 1 )          // Record Ordinal
+                {
+                    sqlInteger = PXSCastSizeTToInt32( i + 1 );
+                }
+                else if ( j == 2 )          // Computer ID
+                {
+                    sqlInteger = computerID;
+                }
+                else                        // Category ID
+                {
+                    sqlInteger = PXSCastUInt32ToSqlInteger( Record.GetCategoryID() );
+                }
+                memcpy( pValue, &sqlInteger, sizeof ( sqlInteger ) );
+                *pIndicator = sizeof ( sqlInteger );
             }
-            else //  j >= 4
+            else if ( ( j - 4 ) < numValues )
             {
-                // These are strings, truncate to the column length in bytes.
-                strLenOrInd = SQL_NTS;
-                if ( ( j - 4 ) < numValues )
+                // Strings, truncate to the buffer leaving room for the NULL
+                pszValue = Record.GetValue( j - 4 );
+                numChars = Record.GetValueLength( j - 4 );
+                if ( m_pColumnProps[ j ].sqlType == SQL_VARCHAR )
                 {
-                    Value    = Values.Get( j - 4 );
-                    maxChars = PXSCastSqlLenToSizeT( m_pColumnProps[ j ].BufferLength );
-                    if ( m_pColumnProps[ j ].sqlType == SQL_VARCHAR )
+                    numChars = PXSMinSizeT( numChars, maxChars - 1 );
+                    numBytes = 0;
+                    if ( numChars )
                     {
-                        if ( maxChars )
+                        // As Formatter::WideToMultiByte but for a counted string
+                        wideChars = PXSCastSizeTToInt32( numChars );
+                        ansiBytes = PXSCastSizeTToInt32( maxChars - 1 );
+                        pszAnsi   = reinterpret_cast<char*>( pValue );
+                        numBytes  = WideCharToMultiByte( CP_ACP,
+                                                         WC_NO_BEST_FIT_CHARS,
+                                                         pszValue,
+                                                         wideChars,
+                                                         pszAnsi, ansiBytes, nullptr, nullptr );
+                        if ( ( numBytes == 0 ) && ( GetLastError() == ERROR_INVALID_FLAGS ) )
                         {
-                            maxChars--;                     // Room for the NULL
+                            numBytes = WideCharToMultiByte( CP_ACP,
+                                                            0,
+                                                            pszValue,
+                                                            wideChars,
+                                                            pszAnsi, ansiBytes, nullptr, nullptr );
                         }
-                        Value.Truncate( maxChars );
-                        memset( szAnsi, 0, sizeof ( szAnsi ) );
-                        Format.StringToAnsi( Value, szAnsi, ARRAYSIZE(szAnsi) );
-                        pData     = szAnsi;
-                        dataBytes = strlen( szAnsi );
-                    }
-                    else
-                    {
-                        if ( maxChars >= sizeof ( wchar_t ) )
+                        if ( numBytes == 0 )
                         {
-                            maxChars -= sizeof ( wchar_t );  // Room for NULL
+                            throw SystemException( GetLastError(),
+                                                   L"WideCharToMultiByte", __FUNCTION__ );
                         }
-                        Value.Truncate( maxChars / sizeof ( wchar_t ) );
-                        memset( szWide, 0, sizeof ( szWide ) );
-                        Format.StringToWide( Value, szWide, ARRAYSIZE(szWide) );
-                        pData     = szWide;
-                        dataBytes = wcslen( szWide );
-                        dataBytes = PXSMultiplySizeT( dataBytes, sizeof ( wchar_t ) );
                     }
+                    pValue[ numBytes ] = 0;
+                    *pIndicator = numBytes;
                 }
-            }
-
-            if ( pData )
-            {
-                m_pColumnProps[ j ].StrLen_or_Ind[ i ] = strLenOrInd;
-                length = PXSCastSqlLenToSizeT( m_pColumnProps[j].BufferLength );
-                offset = PXSMultiplySizeT( i, length );
-                if ( PXSAddSizeT(offset, length) > m_pColumnProps[ j ].numBytes)
+                else
                 {
-                    throw SystemException( ERROR_INSUFFICIENT_BUFFER,
-                                           PXS_STRING_EMPTY, __FUNCTION__ );
+                    maxChars = maxChars / sizeof ( wchar_t );
+                    numChars = PXSMinSizeT( numChars, maxChars - 1 );
+                    memcpy( pValue, pszValue, numChars * sizeof ( wchar_t ) );
+                    reinterpret_cast<wchar_t*>( pValue )[ numChars ] = PXS_CHAR_NULL;
+                    *pIndicator = PXSCastSizeTToSqlLen( numChars * sizeof ( wchar_t ) );
                 }
-                memcpy( m_pColumnProps[ j ].TargetValuePtr + offset, pData, dataBytes );
             }
             else
             {
-                m_pColumnProps[ j ].StrLen_or_Ind[ i ] = SQL_NULL_DATA;
+                *pIndicator = SQL_NULL_DATA;
             }
         }
     }
@@ -1341,26 +1384,20 @@ void OdbcExportDialog::FreeAuditDataBindBuffers()
     // Columns
     if ( m_pColumnProps )
     {
-        // Values
-        for ( size_t i = 0; i < m_uNumColumns; i++ )
-        {
-            if ( m_pColumnProps[ i ].TargetValuePtr )
-            {
-                delete [] m_pColumnProps[ i ].TargetValuePtr;
-            }
-
-            if ( m_pColumnProps[ i ].StrLen_or_Ind )
-            {
-                delete [] m_pColumnProps[ i ].StrLen_or_Ind;
-            }
-        }
-
-        // Column array
         delete [] m_pColumnProps;
         m_pColumnProps = nullptr;
     }
     m_uNumColumns = 0;
 
+    // Rows
+    if ( m_pRowBuffer )
+    {
+        delete [] m_pRowBuffer;
+        m_pRowBuffer = nullptr;
+    }
+    m_uRowBytes    = 0;
+    m_uRowCapacity = 0;
+
     // Row Status
     if ( m_pRowStatus )
     {
@@ -1369,6 +1406,37 @@ void OdbcExportDialog::FreeAuditDataBindBuffers()
     }
 }
 
+//===============================================================================================//
+//  Description:
+//      Get the type a column is bound as
+//
+//  Parameters:
+//      columnType - the column's SQL data type
+//
+//  Remarks:
+//      Narrow character types are bound as SQL_VARCHAR, other non-integer
+//      types as SQL_WVARCHAR.
+//
+//  Returns:
+//      SQL_INTEGER, SQL_VARCHAR or SQL_WVARCHAR
+//===============================================================================================//
+SQLSMALLINT OdbcExportDialog::GetBindSqlType( SQLSMALLINT columnType )
+{
+    if ( columnType == SQL_INTEGER )
+    {
+        return SQL_INTEGER;
+    }
+
+    if ( ( columnType == SQL_CHAR        ) ||
+         ( columnType == SQL_VARCHAR     ) ||
+         ( columnType == SQL_LONGVARCHAR )  )
+    {
+        return SQL_VARCHAR;
+    }
+
+    return SQL_WVARCHAR;
+}
+
 //===============================================================================================//
 //  Description:
 //      Set text progress message on the dialog box
@@ -81,6 +81,9 @@ OdbcRecordSet::OdbcRecordSet()
               :ROW_ARRAY_SIZE( 50 ),
                MAX_COLUMN_LENGTH_BYTES( 0x1000 ),
                MAX_CACHE_RECORDS( 0xFFFF ),
+               MAX_ROW_ARRAY_SIZE( 1000 ),
+               CACHE_BUDGET_BYTES( 0x100000 ),     // 1MB
+               m_uFetchBlockSize( 0 ),
                m_uNumColumns( 0 ),
                m_uCacheSize( ROW_ARRAY_SIZE ),
                m_uCacheRowSizeBytes( 0 ),
@@ -156,6 +159,64 @@ void OdbcRecordSet::Close()
     }
 }
 
+//===============================================================================================//
+//  Description:
+//      Get the value of the field at the specified column in the current
+//      record as a double
+//
+//  Parameters:
+//      idxColumn - the zero-based index of the column in the query
+//      pValue    - receives the value
+//
+//  Remarks:
+//      Reads the bound buffer directly, no string is constructed for numeric
+//      columns.
+//
+//  Returns:
+//      true if the field has a value, false if it is NULL or deleted
+//===============================================================================================//
+bool OdbcRecordSet::FieldDouble( size_t idxColumn, double* pValue )
+{
+    __int64 int64Value = 0;
+
+    if ( pValue == nullptr )
+    {
+        throw ParameterException( L"pValue", __FUNCTION__ );
+    }
+    *pValue = 0.0;
+
+    return GetFieldNumber( idxColumn, &int64Value, pValue );
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the value of the field at the specified column in the current
+//      record as a 64-bit integer
+//
+//  Parameters:
+//      idxColumn - the zero-based index of the column in the query
+//      pValue    - receives the value
+//
+//  Remarks:
+//      Reads the bound buffer directly, no string is constructed for numeric
+//      columns. Floating point values are truncated.
+//
+//  Returns:
+//      true if the field has a value, false if it is NULL or deleted
+//===============================================================================================//
+bool OdbcRecordSet::FieldInt64( size_t idxColumn, __int64* pValue )
+{
+    double doubleValue = 0.0;
+
+    if ( pValue == nullptr )
+    {
+        throw ParameterException( L"pValue", __FUNCTION__ );
+    }
+    *pValue = 0;
+
+    return GetFieldNumber( idxColumn, pValue, &doubleValue );
+}
+
 //===============================================================================================//
 //  Description:
 //      Get the value of the field at the specified column in the current
@@ -743,6 +804,28 @@ void OdbcRecordSet::Open( const String& SqlQuery, OdbcDatabase* pDatabase )
     BindCache();
 }
 
+//===============================================================================================//
+//  Description:
+//      Set the number of rows fetched in each block
+//
+//  Parameters:
+//      numRows - the number of rows, zero to size the block from the row width
+//
+//  Remarks:
+//      Takes effect on the next call to Open.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void OdbcRecordSet::SetFetchBlockSize( size_t numRows )
+{
+    if ( numRows > MAX_ROW_ARRAY_SIZE )
+    {
+        throw BoundsException( L"numRows", __FUNCTION__ );
+    }
+    m_uFetchBlockSize = numRows;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Protected Methods
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -778,11 +861,6 @@ void OdbcRecordSet::AllocateCache()
         throw FunctionException( L"m_pDatabase", __FUNCTION__ );
     }
 
-    if ( m_uCacheSize == 0 )
-    {
-        throw FunctionException( L"m_uCacheSize", __FUNCTION__ );
-    }
-
     if ( m_StatementHandle == nullptr )
     {
         throw FunctionException( L"m_StatementHandle", __FUNCTION__ );
@@ -877,6 +955,16 @@ void OdbcRecordSet::AllocateCache()
     }
     m_uCacheRowSizeBytes = PXSAddSizeT( m_uCacheRowSizeBytes, rounding );
 
+    // Size the block, narrow rows are fetched in large blocks to reduce the
+    // number of round trips, wide rows in small ones to bound the memory used
+    ROW_ARRAY_SIZE = m_uFetchBlockSize;
+    if ( ROW_ARRAY_SIZE == 0 )
+    {
+        ROW_ARRAY_SIZE = CACHE_BUDGET_BYTES / m_uCacheRowSizeBytes;
+    }
+    PXSLimitSizeT( 1, MAX_ROW_ARRAY_SIZE, &ROW_ARRAY_SIZE );
+    m_uCacheSize = ROW_ARRAY_SIZE;
+
     numBytes = PXSMultiplySizeT( m_uCacheRowSizeBytes, m_uCacheSize );
     m_pCache = new BYTE[ numBytes ];
     if ( m_pCache == nullptr )
@@ -1668,6 +1756,129 @@ BYTE* OdbcRecordSet::GetDataPointerInCache( size_t idxRow, size_t idxColumn )
     return ( m_pCache + byteOffset );
 }
 
+//===============================================================================================//
+//  Description:
+//      Get the numeric value of a field in the current record
+//
+//  Parameters:
+//      idxColumn - zero based index of the column
+//      pInt64    - receives the value as an integer
+//      pDouble   - receives the value as a double
+//
+//  Remarks:
+//      Character columns are parsed in place.
+//
+//  Returns:
+//      true if the field has a value, false if it is NULL or deleted
+//===============================================================================================//
+bool OdbcRecordSet::GetFieldNumber( size_t idxColumn, __int64* pInt64, double* pDouble )
+{
+    BYTE*     pBuffer = nullptr;
+    char*     pszAnsi = nullptr;
+    wchar_t*  pwzWide = nullptr;
+    TYPE_COLUMN_PROPERTIES* pColumn = nullptr;
+
+    if ( ( pInt64 == nullptr ) || ( pDouble == nullptr ) )
+    {
+        throw ParameterException( L"pInt64/pDouble", __FUNCTION__ );
+    }
+
+    pBuffer = GetDataPointerInCache( m_idxCurrentRow, idxColumn );
+    if ( pBuffer == nullptr )
+    {
+        return false;       // NULL or deleted
+    }
+    pColumn = m_pColumns + idxColumn;       // Bounds checked above
+
+    if ( pColumn->boolean )
+    {
+        *pInt64 = ( *pBuffer == 0 ) ? 0 : 1;
+        *pDouble = static_cast<double>( *pInt64 );
+        return true;
+    }
+
+    switch( pColumn->sqlType )
+    {
+        default:
+            throw SystemException( ERROR_INVALID_DATATYPE, L"sqlType", __FUNCTION__ );
+
+        case SQL_CHAR:            // 1
+        case SQL_VARCHAR:         // 12
+        case SQL_LONGVARCHAR:     // (-1)
+
+            pszAnsi = reinterpret_cast<char*>( pBuffer );
+            pszAnsi[ pColumn->bytesAllocated - 1 ] = PXS_CHAR_NULL;
+            *pInt64  = _atoi64( pszAnsi );
+            *pDouble = atof( pszAnsi );
+            break;
+
+        case SQL_WCHAR:           // (-8)
+        case SQL_WVARCHAR:        // (-9)
+        case SQL_WLONGVARCHAR:    // (-10)
+
+            pwzWide = reinterpret_cast<wchar_t*>( pBuffer );
+            pwzWide[ ( pColumn->bytesAllocated / sizeof ( SQLWCHAR ) ) - 1 ] = 0;
+            *pInt64  = _wtoi64( pwzWide );
+            *pDouble = _wtof( pwzWide );
+            break;
+
+        // Fall through
+        case SQL_NUMERIC:         // 2
+        case SQL_DECIMAL:         // 3
+
+            *pDouble = m_Odbc.SqlNumericStructToDouble(
+                                         reinterpret_cast<SQL_NUMERIC_STRUCT*>( pBuffer ) );
+            *pInt64  = static_cast<__int64>( *pDouble );
+            break;
+
+        case SQL_SMALLINT:
+
+            *pInt64 = *reinterpret_cast<SQLSMALLINT*>( pBuffer );
+            *pDouble = static_cast<double>( *pInt64 );
+            break;
+
+        case SQL_INTEGER:
+
+            *pInt64 = *reinterpret_cast<SQLINTEGER*>( pBuffer );
+            *pDouble = static_cast<double>( *pInt64 );
+            break;
+
+        // Fall through
+        case SQL_FLOAT:           // 6
+        case SQL_DOUBLE:          // 8
+
+            *pDouble = *reinterpret_cast<SQLDOUBLE*>( pBuffer );
+            *pInt64  = static_cast<__int64>( *pDouble );
+            break;
+
+        case SQL_REAL:            // 7
+
+            *pDouble = *reinterpret_cast<SQLREAL*>( pBuffer );
+            *pInt64  = static_cast<__int64>( *pDouble );
+            break;
+
+        case SQL_BIGINT:          // (-5)
+
+            *pInt64 = *reinterpret_cast<SQLBIGINT*>( pBuffer );
+            *pDouble = static_cast<double>( *pInt64 );
+            break;
+
+        case SQL_TINYINT:         // (-6)
+
+            *pInt64 = *reinterpret_cast<SQLSCHAR*>( pBuffer );
+            *pDouble = static_cast<double>( *pInt64 );
+            break;
+
+        case SQL_BIT:             // (-7)
+
+            *pInt64 = *reinterpret_cast<SQLCHAR*>( pBuffer );
+            *pDouble = static_cast<double>( *pInt64 );
+            break;
+    }
+
+    return true;
+}
+
 //===============================================================================================//
 //  Description:
 //      Get the value of the indicator for the specified row and column
@@ -47,7 +47,6 @@
 #include "PxsBase/Header Files/AllocateBytes.h"
 #include "PxsBase/Header Files/Application.h"
 #include "PxsBase/Header Files/Exception.h"
-#include "PxsBase/Header Files/FileVersion.h"
 #include "PxsBase/Header Files/Formatter.h"
 #include "PxsBase/Header Files/ParameterException.h"
 
@@ -87,29 +86,27 @@ OpenNetworkPortInformation::~OpenNetworkPortInformation()
 //      Get open network ports as an array of audit records
 //
 //  Parameters:
-//      pRecords - array to receive the data
+//      pProcessInfo - the audit's process snapshot, used to resolve owning processes
+//      pRecords     - array to receive the data
 //
 //  Returns:
 //     void
 //===============================================================================================//
-void OpenNetworkPortInformation::GetAuditRecords(TArray<AuditRecord>* pRecords)
+void OpenNetworkPortInformation::GetAuditRecords( ProcessInformation* pProcessInfo,
+                                                  TArray<AuditRecord>* pRecords )
 {
-    void*     pResult = nullptr;
     size_t    i = 0, numPorts = 0;
     String    Caption, ServiceName, State, ProcessName;
     String    ManufacturerName, Description;
-    String    VersionString, LocalPort, ProcessID;
+    String    LocalPort, ProcessID;
     Formatter Format;
-    FileVersion    FileVer;
     AuditRecord    Record;
     TYPE_PORT_INFO PortInfo;
-    ProcessInformation     ProcessInfo;
-    PXS_TYPE_PORT_SERVICE* pPortService = nullptr;
     TArray< TYPE_PORT_INFO > Ports, PortsIPv6;
 
-    if ( pRecords == nullptr )
+    if ( ( pProcessInfo == nullptr ) || ( pRecords == nullptr ) )
     {
-        throw ParameterException( L"pRecords", __FUNCTION__ );
+        throw ParameterException( L"pProcessInfo/pRecords", __FUNCTION__ );
     }
     pRecords->RemoveAll();
 
@@ -119,7 +116,7 @@ void OpenNetworkPortInformation::GetAuditRecords(TArray<AuditRecord>* pRecords)
         GetPortsXPSP2( &Ports );            // IPv4
         GetPortsXPSP2v6( &PortsIPv6 );      // IPv6
         Ports.Append( PortsIPv6 );
-        ProcessInfo.FillProcessesInfo();
+        pProcessInfo->FillProcessesInfo();
     }
     catch ( const Exception& e )
     {
@@ -157,15 +154,15 @@ void OpenNetworkPortInformation::GetAuditRecords(TArray<AuditRecord>* pRecords)
 
             // Service name
             ServiceName = PXS_STRING_EMPTY;
-            pResult = bsearch( &PortInfo.localPort,
-                               PXS_WELL_KNOWN_PORT_SERVICES,
-                               ARRAYSIZE( PXS_WELL_KNOWN_PORT_SERVICES ),
-                               sizeof ( PXS_WELL_KNOWN_PORT_SERVICES[ 0 ] ),
-                               PXSBSearchComparePortServices );
-            pPortService = reinterpret_cast<PXS_TYPE_PORT_SERVICE*>( pResult );
-            if ( pPortService )
+            if ( PortInfo.localPort <= PXS_MAX_WELL_KNOWN_PORT )
             {
-                ServiceName = pPortService->pszServiceName;
+                WORD serviceIndex =
+                               PXS_WELL_KNOWN_PORTS_INDEX.serviceIndex[ PortInfo.localPort ];
+                if ( serviceIndex )
+                {
+                    ServiceName =
+                           PXS_WELL_KNOWN_PORT_SERVICES[ serviceIndex - 1 ].pszServiceName;
+                }
             }
             Record.Add( PXS_OPEN_PORTS_SERVICE_NAME, ServiceName );
 
@@ -186,21 +183,18 @@ void OpenNetworkPortInformation::GetAuditRecords(TArray<AuditRecord>* pRecords)
             }
 
             ProcessName = PXS_STRING_EMPTY;
-            ProcessInfo.GetExePath( PortInfo.owningPid, &ProcessName );
+            pProcessInfo->GetExePath( PortInfo.owningPid, &ProcessName );
             Record.Add( PXS_OPEN_PORTS_PROCESS_NAME, ProcessName );
 
             ProcessID = Format.UInt32( PortInfo.owningPid );
             Record.Add( PXS_OPEN_PORTS_PROCESS_ID, ProcessID );
 
+            // Version data is cached per process so only read once per owner
             ManufacturerName = PXS_STRING_EMPTY;
             Description  = PXS_STRING_EMPTY;
             try
             {
-                if ( ProcessName.GetLength() )
-                {
-                    FileVer.GetVersion( ProcessName,
-                                        &ManufacturerName, &VersionString, &Description );
-                }
+                pProcessInfo->GetExeVersion( PortInfo.owningPid, &ManufacturerName, &Description );
             }
             catch ( const Exception& eVersion )
             {
@@ -66,7 +66,10 @@
 
 // Default constructor
 ProcessInformation::ProcessInformation()
-                   :m_Processes()
+                   :m_bFilled( false ),
+                    m_numProcesses( 0 ),
+                    m_ProcessIndex(),
+                    m_Processes()
 {
 }
 
@@ -175,6 +178,10 @@ void ProcessInformation::ChangePrivilege( LPCWSTR pszPrivilege, bool enable )
 //  Parameters:
 //      None
 //
+//  Remarks:
+//      The snapshot is only taken once, subsequent calls return immediately
+//      so that all categories of an audit see the same set of processes.
+//
 //  Returns:
 //      void
 //===============================================================================================//
@@ -188,7 +195,14 @@ void ProcessInformation::FillProcessesInfo()
     PROCESSENTRY32    pe32;
     TYPE_PROCESS_INFO ProcessInfo;
 
+    // Test if already have the snapshot
+    if ( m_bFilled )
+    {
+        return;
+    }
+    m_numProcesses = 0;
     m_Processes.RemoveAll();
+    m_ProcessIndex.RemoveAll();
 
     // PSAPI usually requires SeDebugPrivilege
     try
@@ -274,9 +288,12 @@ void ProcessInformation::FillProcessesInfo()
                 PXSLogException( Message.c_str(), e, __FUNCTION__ );
             }
         }
-        m_Processes.Add( ProcessInfo );
+
+        AppendProcess( ProcessInfo );
     }
     while ( Process32Next( hSnapProcess, &pe32 ) );
+    IndexProcesses();
+    m_bFilled = true;
 
     // Reset privilege if it was changed
     if ( privilegeChanged )
@@ -301,8 +318,7 @@ void ProcessInformation::FillProcessesInfo()
 //===============================================================================================//
 void ProcessInformation::GetExePath( DWORD processID, String* pExePath ) const
 {
-    size_t i = 0, numProcesses = 0;
-    TYPE_PROCESS_INFO ProcessInfo;
+    size_t idx = 0;
 
     if ( pExePath == nullptr )
     {
@@ -310,17 +326,72 @@ void ProcessInformation::GetExePath( DWORD processID, String* pExePath ) const
     }
     *pExePath = PXS_STRING_EMPTY;
 
-    numProcesses = m_Processes.GetSize();
-    for ( i = 0; i < numProcesses; i++ )
+    idx = FindProcess( processID );
+    if ( idx != PXS_MINUS_ONE )
     {
-        ProcessInfo = m_Processes.Get( i );
-        if ( processID == ProcessInfo.processID )
+        *pExePath = m_Processes.GetPtr( idx )->szExePath;
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the manufacturer and description of a process' executable
+//
+//  Parameters:
+//      processID         - process id
+//      pManufacturerName - string object to receive the manufacturer's name
+//      pDescription      - string object to receive the file description
+//
+//  Remarks:
+//      Must first have called FillProcessesInfo. The version resource is read
+//      on first use and cached so processes owning many ports only read it once.
+//
+//  Returns:
+//      void, if the process is not found the strings will be ""
+//===============================================================================================//
+void ProcessInformation::GetExeVersion( DWORD processID,
+                                        String* pManufacturerName, String* pDescription )
+{
+    size_t      idx = 0;
+    File        FileObject;
+    String      ExePath, ManufacturerName, VersionString, Description;
+    FileVersion FileVer;
+    TYPE_PROCESS_INFO* pProcessInfo = nullptr;
+
+    if ( ( pManufacturerName == nullptr ) || ( pDescription == nullptr ) )
+    {
+        throw ParameterException( L"pManufacturerName/pDescription", __FUNCTION__ );
+    }
+    *pManufacturerName = PXS_STRING_EMPTY;
+    *pDescription      = PXS_STRING_EMPTY;
+
+    idx = FindProcess( processID );
+    if ( idx == PXS_MINUS_ONE )
+    {
+        return;
+    }
+    pProcessInfo = m_Processes.GetPtr( idx );
+
+    if ( pProcessInfo->versionRead == false )
+    {
+        // Set the flag first so a failure is not retried for every port
+        pProcessInfo->versionRead = true;
+        ExePath = pProcessInfo->szExePath;
+        if ( ExePath.GetLength() && FileObject.Exists( ExePath ) )
         {
-            ProcessInfo.szExePath[ ARRAYSIZE(ProcessInfo.szExePath ) - 1 ] = 0x00;
-            *pExePath = ProcessInfo.szExePath;
-            break;
+            FileVer.GetVersion( ExePath, &ManufacturerName, &VersionString, &Description );
+            ManufacturerName.Truncate( ARRAYSIZE( pProcessInfo->szManufacturer ) - 1 );
+            Description.Truncate( ARRAYSIZE( pProcessInfo->szDescription ) - 1 );
+            PXSStringCchCopy( pProcessInfo->szManufacturer,
+                              ARRAYSIZE( pProcessInfo->szManufacturer ),
+                              ManufacturerName.c_str(), __FUNCTION__ );
+            PXSStringCchCopy( pProcessInfo->szDescription,
+                              ARRAYSIZE( pProcessInfo->szDescription ),
+                              Description.c_str(), __FUNCTION__ );
         }
     }
+    *pManufacturerName = pProcessInfo->szManufacturer;
+    *pDescription      = pProcessInfo->szDescription;
 }
 
 //===============================================================================================//
@@ -330,20 +401,22 @@ void ProcessInformation::GetExePath( DWORD processID, String* pExePath ) const
 //  Parameters:
 //      pRecords - array to receive the data
 //
+//  Remarks:
+//      Uses the process snapshot, taking it if not already done
+//
 //  Returns:
 //      void
 //===============================================================================================//
 void ProcessInformation::GetLoadedModuleRecords( TArray<AuditRecord>* pRecords)
 {
-    DWORD     i = 0;
-    HANDLE    hSnapProcess;
+    size_t    i = 0;
     HANDLE    hSnapModule  = INVALID_HANDLE_VALUE;
     String    Insert1;
     FILETIME  fileTime;
     AuditRecord    Record;
     StringArray    ModulePaths;
     MODULEENTRY32  me32;
-    PROCESSENTRY32 pe32;
+    const TYPE_PROCESS_INFO* pProcessInfo = nullptr;
 
     if ( pRecords == nullptr )
     {
@@ -351,28 +424,14 @@ void ProcessInformation::GetLoadedModuleRecords( TArray<AuditRecord>* pRecords)
     }
     pRecords->RemoveAll();
 
-    hSnapProcess = CreateToolhelp32Snapshot( TH32CS_SNAPPROCESS, 0 );
-    if ( hSnapProcess == INVALID_HANDLE_VALUE )
-    {
-       throw SystemException( GetLastError(),
-                             L"CreateToolhelp32Snapshot/TH32CS_SNAPPROCESS", __FUNCTION__);
-    }
-    AutoCloseHandle CloseSnapProcess( hSnapProcess );
-
-    // Get first process,
-    memset( &pe32, 0, sizeof ( pe32 ) );
-    pe32.dwSize = sizeof ( pe32 );
-    if ( Process32First( hSnapProcess, &pe32 ) == 0 )
-    {
-        throw SystemException( GetLastError(), L"Process32First", __FUNCTION__ );
-    }
-
-    do
+    FillProcessesInfo();
+    for ( i = 0; i < m_numProcesses; i++ )
     {
-        if ( pe32.th32ProcessID > 4 )       // <=4 seem to be system processes
+        pProcessInfo = m_Processes.GetPtr( i );
+        if ( pProcessInfo->processID > 4 )       // <=4 seem to be system processes
         {
             hSnapModule = CreateToolhelp32Snapshot( TH32CS_SNAPMODULE,
-                                                    pe32.th32ProcessID );
+                                                    pProcessInfo->processID );
             if ( hSnapModule != INVALID_HANDLE_VALUE )
             {
                 AutoCloseHandle CloseSnapModule( hSnapModule );
@@ -391,18 +450,17 @@ void ProcessInformation::GetLoadedModuleRecords( TArray<AuditRecord>* pRecords)
                 }
                 else
                 {
-                    Insert1 = pe32.szExeFile;
+                    Insert1 = pProcessInfo->szExeName;
                     PXSLogSysWarn1( GetLastError(), L"Module32First failed for '%%1'.", Insert1 );
                 }
             }
             else
             {
-               Insert1 = pe32.szExeFile;
+               Insert1 = pProcessInfo->szExeName;
                PXSLogSysInfo1( GetLastError(), L"TH32CS_SNAPMODULE failed for '%%1'.", Insert1 );
             }
         }
     }
-    while ( Process32Next( hSnapProcess, &pe32 ) );
     ModulePaths.Sort( true );
 
     ///////////////////////////////////////////////////////////////////////////
@@ -476,14 +534,12 @@ void ProcessInformation::GetLoadedModuleRecords( TArray<AuditRecord>* pRecords)
 //===============================================================================================//
 void ProcessInformation::GetRunningProcesseRecords( TArray< AuditRecord >* pRecords )
 {
-    size_t      i = 0, memoryUsage = 0, numProcesses = 0;
-    File        FileObject;
-    String      Value, ManufacturerName, VersionString, Description, ExePath;
+    size_t      i = 0;
+    String      Value, ManufacturerName, Description;
     String      LocaleKB;
     Formatter   Format;
-    FileVersion FileVer;
     AuditRecord Record;
-    TYPE_PROCESS_INFO ProcessInfo;
+    const TYPE_PROCESS_INFO* pProcessInfo = nullptr;
 
     if ( pRecords == nullptr )
     {
@@ -493,52 +549,39 @@ void ProcessInformation::GetRunningProcesseRecords( TArray< AuditRecord >* pReco
 
     PXSGetResourceString( PXS_IDS_135_KB, &LocaleKB );
     ManufacturerName.Allocate( 256 );
-    VersionString.Allocate( 256 );
     Description.Allocate( 256 );
 
     FillProcessesInfo();
-    numProcesses = m_Processes.GetSize();
-    for ( i = 0; i < numProcesses; i++ )
+    for ( i = 0; i < m_numProcesses; i++ )
     {
-        ProcessInfo = m_Processes.Get( i );
-        ProcessInfo.szExePath[ARRAYSIZE( ProcessInfo.szExePath ) - 1 ] = 0x00;
+        pProcessInfo = m_Processes.GetPtr( i );
 
         // Catch exceptions so can progress to the next process
         try
         {
             // Ignore process 0
-            if ( ProcessInfo.processID )
+            if ( pProcessInfo->processID )
             {
                 Record.Reset( PXS_CATEGORY_RUNNING_PROCS );
 
                 // Process Name
-                ProcessInfo.szExeName[ ARRAYSIZE( ProcessInfo.szExeName ) - 1 ] = PXS_CHAR_NULL;
-                Record.Add( PXS_RUNNING_PROCS_NAME, ProcessInfo.szExeName );
+                Record.Add( PXS_RUNNING_PROCS_NAME, pProcessInfo->szExeName );
 
                 // Process ID
-                Value = Format.UInt32( ProcessInfo.processID );
+                Value = Format.UInt32( pProcessInfo->processID );
                 Record.Add( PXS_RUNNING_PROCS_PROCESS_ID, Value );
 
                 // Memory usage in KB, leave empty if have no value
                 Value = PXS_STRING_EMPTY;
-                memoryUsage = GetMemoryUsage( ProcessInfo.processID );
-                if ( memoryUsage > 0 )
+                if ( pProcessInfo->workingSet > 0 )
                 {
-                    Value  = Format.SizeT( memoryUsage / 1024 );
+                    Value  = Format.SizeT( pProcessInfo->workingSet / 1024 );
                     Value += LocaleKB;
                 }
                 Record.Add( PXS_RUNNING_PROCS_MEM_USAGE_KB, Value );
 
-                // Process Description, make sure have a path
-                ManufacturerName = PXS_STRING_EMPTY;
-                VersionString    = PXS_STRING_EMPTY;
-                Description      = PXS_STRING_EMPTY;
-                ExePath          = ProcessInfo.szExePath;
-                if ( FileObject.Exists( ExePath ) )
-                {
-                    FileVer.GetVersion( ExePath,
-                                        &ManufacturerName, &VersionString, &Description );
-                }
+                // Process Description, cached in the snapshot
+                GetExeVersion( pProcessInfo->processID, &ManufacturerName, &Description );
                 Record.Add( PXS_RUNNING_PROCS_DESCRIPTION, Description );
                 pRecords->Add( Record );
             }
@@ -546,9 +589,9 @@ void ProcessInformation::GetRunningProcesseRecords( TArray< AuditRecord >* pReco
         catch ( const Exception& eProcess )
         {
             // Typically cannot get data for special system processes
-            if ( ProcessInfo.processID > 4 )
+            if ( pProcessInfo->processID > 4 )
             {
-                PXSLogException( ProcessInfo.szExePath, eProcess, __FUNCTION__);
+                PXSLogException( pProcessInfo->szExePath, eProcess, __FUNCTION__);
             }
         }
     }
@@ -661,6 +704,74 @@ bool ProcessInformation::IsPrivilegeEnabled( LPCWSTR pszPrivilege )
     return enabled;
 }
 
+//===============================================================================================//
+//  Description:
+//      Discard the process snapshot so the next request takes a new one
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void ProcessInformation::Reset()
+{
+    m_bFilled      = false;
+    m_numProcesses = 0;
+    m_Processes.RemoveAll();
+    m_ProcessIndex.RemoveAll();
+}
+
+//===============================================================================================//
+//  Description:
+//      Replace the process snapshot with the specified processes
+//
+//  Parameters:
+//      ProcessIDs - the process ids
+//      ExePaths   - the executable path of each process
+//
+//  Remarks:
+//      Used to load a recorded snapshot. As with FillProcessesInfo, if a
+//      process id occurs more than once the first occurrence is found.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void ProcessInformation::SetProcesses( const TArray< DWORD >& ProcessIDs,
+                                       const StringArray& ExePaths )
+{
+    size_t i = 0, numProcesses = ProcessIDs.GetSize();
+    String ExePath, Drive, Dir, Fname, Ext;
+    TYPE_PROCESS_INFO ProcessInfo;
+
+    if ( numProcesses != ExePaths.GetSize() )
+    {
+        throw ParameterException( L"ExePaths", __FUNCTION__ );
+    }
+    Reset();
+
+    for ( i = 0; i < numProcesses; i++ )
+    {
+        memset( &ProcessInfo, 0, sizeof ( ProcessInfo ) );
+        ProcessInfo.processID = ProcessIDs.Get( i );
+        ExePath = ExePaths.Get( i );
+        ExePath.Truncate( ARRAYSIZE( ProcessInfo.szExePath ) - 1 );
+        PXSStringCchCopy( ProcessInfo.szExePath,
+                          ARRAYSIZE( ProcessInfo.szExePath ), ExePath.c_str(), __FUNCTION__ );
+        if ( ExePath.GetLength() )
+        {
+            Directory::SplitPath( ExePath, &Drive, &Dir, &Fname, &Ext );
+            Fname += Ext;
+            Fname.Truncate( ARRAYSIZE( ProcessInfo.szExeName ) - 1 );
+            PXSStringCchCopy( ProcessInfo.szExeName,
+                              ARRAYSIZE( ProcessInfo.szExeName ), Fname.c_str(), __FUNCTION__ );
+        }
+        AppendProcess( ProcessInfo );
+    }
+    IndexProcesses();
+    m_bFilled = true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Protected Methods
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -671,34 +782,57 @@ bool ProcessInformation::IsPrivilegeEnabled( LPCWSTR pszPrivilege )
 
 //===============================================================================================//
 //  Description:
-//      Get the memory usage of the specified process id.
+//      Append a process to the snapshot
+//
+//  Parameters:
+//      ProcessInfo - the process
+//
+//  Remarks:
+//      The table grows geometrically rather than re-allocating on every
+//      process. The index is not updated, call IndexProcesses when done.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void ProcessInformation::AppendProcess( const TYPE_PROCESS_INFO& ProcessInfo )
+{
+    if ( m_numProcesses == m_Processes.GetSize() )
+    {
+        m_Processes.SetSize( PXSMultiplySizeT( m_numProcesses + 1, 2 ) );
+    }
+    m_Processes.Set( m_numProcesses, ProcessInfo );
+    m_numProcesses++;
+}
+
+//===============================================================================================//
+//  Description:
+//      Find the index of a process in the snapshot from its process id
 //
 //  Parameters:
 //      processID - process id
 //
 //  Remarks:
-//      This is the cached value obtained when FillProcessesInfo was called
+//      Process ids are multiples of 4 so the low bits are dropped to make the
+//      hash.
 //
 //  Returns:
-//      size_t of memory, zero if process id not recognised
+//      size_t zero-based index into m_Processes, PXS_MINUS_ONE if not found
 //===============================================================================================//
-size_t ProcessInformation::GetMemoryUsage( DWORD processID ) const
+size_t ProcessInformation::FindProcess( DWORD processID ) const
 {
-    size_t  i = 0, workingSet = 0, numProcesses = 0;
-    TYPE_PROCESS_INFO ProcessInfo;
+    size_t position = 0;
 
-    numProcesses = m_Processes.GetSize();
-    for ( i = 0; i < numProcesses; i++ )
+    size_t idx = m_ProcessIndex.FindFirst( processID >> 2, &position );
+    while ( idx != PXS_MINUS_ONE )
     {
-        ProcessInfo = m_Processes.Get( i );
-        if ( processID == ProcessInfo.processID )
+        if ( processID == m_Processes.GetPtr( idx )->processID )
         {
-            workingSet = ProcessInfo.workingSet;
-            break;
+            return idx;
         }
+        idx = m_ProcessIndex.FindNext( processID >> 2, &position );
     }
 
-    return workingSet;
+    return PXS_MINUS_ONE;
 }
 
 //===============================================================================================//
@@ -732,3 +866,33 @@ size_t ProcessInformation::GetWorkingSetSize( DWORD processID )
 
     return pmc.WorkingSetSize;
 }
+
+//===============================================================================================//
+//  Description:
+//      Build the hash index of the process snapshot keyed on process id
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      If a process id appears twice the first entry wins, as it did for the
+//      previous linear search.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void ProcessInformation::IndexProcesses()
+{
+    size_t i = 0;
+    DWORD  processID = 0;
+
+    m_ProcessIndex.RemoveAll();
+    for ( i = 0; i < m_numProcesses; i++ )
+    {
+        processID = m_Processes.GetPtr( i )->processID;
+        if ( FindProcess( processID ) == PXS_MINUS_ONE )
+        {
+            m_ProcessIndex.Add( processID >> 2, i );
+        }
+    }
+}
@@ -60,6 +60,7 @@
 #include "PxsBase/Header Files/Wmi.h"
 
 // 5. This Project
+#include "WinAudit/Header Files/AccountNameCache.h"
 #include "WinAudit/Header Files/AuditRecord.h"
 #include "WinAudit/Header Files/WindowsInformation.h"
 
@@ -995,7 +996,8 @@ void SecurityInformation::GetSystemRestorePointRecords( TArray< AuditRecord >* p
 //        Get the User Rights Assignment policy on the machine
 //
 //  Parameters:
-//        pRecords - array to receive the audit records
+//        pAccountNameCache - resolves the SIDs that have each right
+//        pRecords          - array to receive the audit records
 //
 //  Remarks:
 //      The privileges available depend on the OS so LookupPrivilegeDisplayName
@@ -1006,7 +1008,8 @@ void SecurityInformation::GetSystemRestorePointRecords( TArray< AuditRecord >* p
 //  Returns:
 //      void
 //===============================================================================================//
-void SecurityInformation::GetUserRightsAssignmentRecords( TArray< AuditRecord >* pRecords )
+void SecurityInformation::GetUserRightsAssignmentRecords( AccountNameCache* pAccountNameCache,
+                                                          TArray< AuditRecord >* pRecords )
 {
     ULONG    CountReturned = 0;
     wchar_t  wzPrivilege[ 64 ]  = { 0 };           // Enough for any "Se..."
@@ -1114,9 +1117,9 @@ void SecurityInformation::GetUserRightsAssignmentRecords( TArray< AuditRecord >*
         { L"SeTakeOwnershipPrivilege",
           L"Take ownership of files or other objects"      } };
 
-    if ( pRecords == nullptr )
+    if ( ( pAccountNameCache == nullptr ) || ( pRecords == nullptr ) )
     {
-        throw ParameterException( L"pRecords", __FUNCTION__ );
+        throw ParameterException( L"pAccountNameCache/pRecords", __FUNCTION__ );
     }
     pRecords->RemoveAll();
 
@@ -1164,7 +1167,8 @@ void SecurityInformation::GetUserRightsAssignmentRecords( TArray< AuditRecord >*
                                                    &CountReturned );
             if ( status == ERROR_SUCCESS )
             {
-                EnumerationInformationToAccounts( pEnumerationBuffer, CountReturned, &Setting );
+                EnumerationInformationToAccounts( pEnumerationBuffer,
+                                                  CountReturned, pAccountNameCache, &Setting );
                 LsaFreeMemory( pEnumerationBuffer );
                 pEnumerationBuffer = nullptr;            // Reset for next pass
             }
@@ -1212,33 +1216,43 @@ void SecurityInformation::GetUserRightsAssignmentRecords( TArray< AuditRecord >*
 //      separated list of account names
 //
 //  Parameters:
-//      pEnumeration  - pointer to the buffer
-//      CountReturned - number of SIDs in the buffer
-//      pAccounts     - receives the account names
+//      pEnumeration      - pointer to the buffer
+//      CountReturned     - number of SIDs in the buffer
+//      pAccountNameCache - resolves the SIDs
+//      pAccounts         - receives the account names
 //
 //  Returns:
 //     void
 //===============================================================================================//
 void SecurityInformation::EnumerationInformationToAccounts(
                                                    const LSA_ENUMERATION_INFORMATION* pEnumeration,
-                                                   ULONG count, String* pAccounts )
+                                                   ULONG count,
+                                                   AccountNameCache* pAccountNameCache,
+                                                   String* pAccounts )
 {
-    wchar_t szName[ UNLEN + 1 ]   = { 0 };         // Enough for a account name
-    wchar_t szDomainName[ MAX_PATH + 1 ] = { 0 };  // Enough for a domain name
-    Formatter    Format;
-    SID_NAME_USE eUse;
+    String Name;
+    TArray< PSID > Sids;
 
-    if ( pAccounts == nullptr )
+    if ( ( pAccountNameCache == nullptr ) || ( pAccounts == nullptr ) )
     {
-        throw ParameterException( L"pAccounts", __FUNCTION__ );
+        throw ParameterException( L"pAccountNameCache/pAccounts", __FUNCTION__ );
     }
     *pAccounts = PXS_STRING_EMPTY;
 
-    if ( pEnumeration == nullptr )
+    if ( ( pEnumeration == nullptr ) || ( count == 0 ) )
     {
         return;
     }
 
+    // Resolve the SIDs in one go, most will already be cached from the
+    // previous rights
+    Sids.SetSize( count );
+    for ( ULONG i = 0; i < count; i++ )
+    {
+        Sids.Set( i, pEnumeration[ i ].Sid );
+    }
+    pAccountNameCache->LookupSids( Sids.GetPtr( 0 ), Sids.GetSize() );
+
     for ( ULONG i = 0; i < count; i++ )
     {
         if ( pEnumeration[ i ].Sid )
@@ -1247,24 +1261,8 @@ void SecurityInformation::EnumerationInformationToAccounts(
             {
                 *pAccounts += L", ";
             }
-            memset( szName, 0, sizeof ( szName ) );
-            memset( szDomainName,  0, sizeof ( szDomainName  ) );
-            DWORD cchName       = ARRAYSIZE( szName );
-            DWORD cchDomainName = ARRAYSIZE( szDomainName  );
-            if ( LookupAccountSid( nullptr,  // Local computer only
-                                   pEnumeration[ i ].Sid,
-                                   szName,
-                                   &cchName,
-                                   szDomainName, &cchDomainName, &eUse ) )
-            {
-                szName[ ARRAYSIZE( szName ) - 1 ] = PXS_CHAR_NULL;
-                *pAccounts += szName;
-            }
-            else
-            {
-                // Failed, format as a string
-                *pAccounts += Format.SidToString( pEnumeration[ i ].Sid );
-            }
+            pAccountNameCache->GetAccountName( pEnumeration[ i ].Sid, false, &Name );
+            *pAccounts += Name;
         }
     }
 }
@@ -0,0 +1,304 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// SMBIOS Batch Decoder Class Implementation
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Header Files/SmbiosBatchDecoder.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/Directory.h"
+#include "PxsBase/Header Files/Formatter.h"
+#include "PxsBase/Header Files/ParameterException.h"
+#include "PxsBase/Header Files/StringArray.h"
+#include "PxsBase/Header Files/TArray.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/AuditRecord.h"
+#include "WinAudit/Header Files/SmbiosInformation.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Default constructor
+SmbiosBatchDecoder::SmbiosBatchDecoder()
+                   :m_pBatchMT( nullptr )
+{
+}
+
+// Copy constructor - not allowed so no implementation
+
+// Destructor
+SmbiosBatchDecoder::~SmbiosBatchDecoder()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Operators
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Assignment operator - not allowed so no implementation
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Public Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Decode the SMBIOS dumps in a directory, one output file per dump
+//
+//  Parameters:
+//      DirectoryPath   - the directory holding the dump files
+//      FileSwitchValue - the /f= value, its directory and extension are
+//                        used for the output files, its name is ignored
+//
+//  Remarks:
+//      The output file of a dump is its file name, extension included, plus
+//      the output extension so host.bin and host.dmp do not collide. If the
+//      /f= value has no directory the output goes to a Decoded sub-directory
+//      of the dumps, with no extension the output is CSV. Files in the dump
+//      directory with the output extension are not dumps so are skipped.
+//      Databases and CSV2 files are not allowed as they would record the
+//      dumps as audits of this computer.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void SmbiosBatchDecoder::DecodeDirectory( const String& DirectoryPath,
+                                          const String& FileSwitchValue )
+{
+    const  DWORD MAX_WORKERS = 16;
+    DWORD  numWorkers = 0, i = 0;
+    size_t numDumps = 0, j = 0;
+    UINT64 startTick = 0;
+    String Drive, Dir, Fname, Ext, OutputDirectory, DumpDirectory, Insert2, Insert3;
+    String FileName, DumpPath, OutputPath;
+    Formatter   Format;
+    StringArray FileNames, DumpPaths, OutputPaths;
+    SYSTEM_INFO SystemInfo;
+    TYPE_SMBIOS_BATCH  Batch;
+    SmbiosBatchDecoder Workers[ MAX_WORKERS ];
+
+    if ( DirectoryPath.IsEmpty() )
+    {
+        throw ParameterException( L"DirectoryPath", __FUNCTION__ );
+    }
+
+    if ( PXSIsDatabaseOutputPath( FileSwitchValue ) )
+    {
+        PXSLogAppError( L"SMBIOS dumps cannot be sent to a database or a CSV2 file." );
+        return;
+    }
+
+    // Output location and format
+    Directory::SplitPath( FileSwitchValue, &Drive, &Dir, &Fname, &Ext );
+    DumpDirectory = DirectoryPath;
+    if ( DumpDirectory.EndsWithCharacterI( PXS_PATH_SEPARATOR ) == false )
+    {
+        DumpDirectory += PXS_PATH_SEPARATOR;
+    }
+    OutputDirectory  = Drive;
+    OutputDirectory += Dir;
+    if ( OutputDirectory.IsEmpty() )
+    {
+        OutputDirectory  = DumpDirectory;
+        OutputDirectory += L"Decoded";
+        Directory::CreateNew( OutputDirectory );
+        OutputDirectory += PXS_PATH_SEPARATOR;
+    }
+    if ( Ext.IsEmpty() )
+    {
+        Ext = L".csv";
+    }
+
+    Directory::ListFiles( DirectoryPath, PXS_STRING_EMPTY, &FileNames );
+    for ( j = 0; j < FileNames.GetSize(); j++ )
+    {
+        FileName = FileNames.Get( j );
+        if ( ( OutputDirectory.CompareI( DumpDirectory ) == 0 ) &&
+             FileName.EndsWithStringI( Ext.c_str() ) )
+        {
+            continue;   // An output file
+        }
+        DumpPath  = DumpDirectory;
+        DumpPath += FileName;
+        DumpPaths.Add( DumpPath );
+
+        OutputPath  = OutputDirectory;
+        OutputPath += FileName;
+        OutputPath += Ext;
+        OutputPaths.Add( OutputPath );
+    }
+    numDumps = DumpPaths.GetSize();
+
+    if ( numDumps == 0 )
+    {
+        PXSLogAppWarn1( L"No SMBIOS dumps found in '%%1'.", DirectoryPath );
+        return;
+    }
+
+    // One worker per processor, each takes the next undecoded dump
+    memset( &SystemInfo, 0, sizeof ( SystemInfo ) );
+    GetSystemInfo( &SystemInfo );
+    numWorkers = PXSMaxUInt32( 1, PXSMinUInt32( SystemInfo.dwNumberOfProcessors, MAX_WORKERS ) );
+    if ( numWorkers > numDumps )
+    {
+        numWorkers = PXSCastSizeTToUInt32( numDumps );
+    }
+
+    Batch.pDumpPaths   = &DumpPaths;
+    Batch.pOutputPaths = &OutputPaths;
+    Batch.nextIndex    = 0;
+    Batch.numDecoded   = 0;
+    startTick = GetTickCount64();
+    for ( i = 0; i < numWorkers; i++ )
+    {
+        Workers[ i ].m_pBatchMT = &Batch;
+        Workers[ i ].Run( nullptr );
+    }
+
+    // The batch is on the stack so wait for every worker
+    for ( i = 0; i < numWorkers; i++ )
+    {
+        Workers[ i ].Join();
+    }
+
+    Insert2 = Format.SizeT( numDumps );
+    Insert3 = Format.UInt64( GetTickCount64() - startTick );
+    PXSLogAppInfo3( L"Decoded %%1 of %%2 SMBIOS dump(s) in %%3ms.",
+                    Format.Int32( Batch.numDecoded ), Insert2, Insert3 );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Protected Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Private Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Decode one SMBIOS dump and save its records
+//
+//  Parameters:
+//      DumpPath   - path to the dump file
+//      OutputPath - path of the output file
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void SmbiosBatchDecoder::DecodeDump( const String& DumpPath, const String& OutputPath )
+{
+    const BYTE STRUCTURE_TYPES[] = { PXS_SMBIOS_TYPE_0_BIOS,
+                                     PXS_SMBIOS_TYPE_1_SYSTEM,
+                                     PXS_SMBIOS_TYPE_2_BASE_BOARD,
+                                     PXS_SMBIOS_TYPE_3_CHASSIS,
+                                     PXS_SMBIOS_TYPE_4_PROCESSOR,
+                                     PXS_SMBIOS_TYPE_5_MEM_CONTROL,
+                                     PXS_SMBIOS_TYPE_6_MEMORY_MODULE,
+                                     PXS_SMBIOS_TYPE_7_CPU_CACHE,
+                                     PXS_SMBIOS_TYPE_8_PORT_CONN,
+                                     PXS_SMBIOS_TYPE_9_SYSTEM_SLOT,
+                                     PXS_SMBIOS_TYPE_16_MEM_ARRAY,
+                                     PXS_SMBIOS_TYPE_17_MEMORY_DEVICE };
+    SmbiosInformation     SmbiosInfo;
+    TArray< AuditRecord > AuditRecords, TypeRecords;
+
+    // Throws if the dump is unusable, so never falls back to this computer
+    SmbiosInfo.ReadSmbiosDumpFile( DumpPath );
+    for ( size_t i = 0; i < ARRAYSIZE( STRUCTURE_TYPES ); i++ )
+    {
+        SmbiosInfo.GetAuditRecords( STRUCTURE_TYPES[ i ], &TypeRecords );
+        AuditRecords.Append( TypeRecords );
+    }
+    PXSSaveAuditCommandLine( OutputPath, AuditRecords );
+}
+
+//===============================================================================================//
+//  Description:
+//      Run the worker thread. This method must only be called by the worker.
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      Takes dumps until none are left or told to stop. A dump that fails is
+//      logged and skipped.
+//
+//  Returns:
+//      DWORD system error code
+//===============================================================================================//
+DWORD SmbiosBatchDecoder::RunWorkerThread()
+{
+    LONG   index = 0;
+    size_t numDumps = 0;
+    String Message;
+
+    if ( m_pBatchMT == nullptr )
+    {
+        return ERROR_INVALID_FUNCTION;
+    }
+    numDumps = m_pBatchMT->pDumpPaths->GetSize();
+
+    while ( m_bRunMT )
+    {
+        index = InterlockedIncrement( &m_pBatchMT->nextIndex ) - 1;
+        if ( static_cast<size_t>( index ) >= numDumps )
+        {
+            break;
+        }
+
+        try
+        {
+            DecodeDump( m_pBatchMT->pDumpPaths->Get( static_cast<size_t>( index ) ),
+                        m_pBatchMT->pOutputPaths->Get( static_cast<size_t>( index ) ) );
+            InterlockedIncrement( &m_pBatchMT->numDecoded );
+        }
+        catch ( const Exception& e )
+        {
+            Message  = L"Error decoding SMBIOS dump '";
+            Message += m_pBatchMT->pDumpPaths->Get( static_cast<size_t>( index ) );
+            Message += L"'.";
+            PXSLogException( Message.c_str(), e, __FUNCTION__ );
+        }
+    }
+
+    return ERROR_SUCCESS;
+}
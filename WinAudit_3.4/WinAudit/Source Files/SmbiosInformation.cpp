@@ -46,7 +46,9 @@
 #include "PxsBase/Header Files/Application.h"
 #include "PxsBase/Header Files/AllocateBytes.h"
 #include "PxsBase/Header Files/BoundsException.h"
+#include "PxsBase/Header Files/ByteArray.h"
 #include "PxsBase/Header Files/ComException.h"
+#include "PxsBase/Header Files/File.h"
 #include "PxsBase/Header Files/Formatter.h"
 #include "PxsBase/Header Files/FunctionException.h"
 #include "PxsBase/Header Files/MemoryException.h"
@@ -784,6 +786,179 @@ void SmbiosInformation::ReadSmbiosDataFromFile()
     PXSLogAppInfo1( L"SMBIOS BCD/DMI Revision: %%1", Format.UInt8( m_SmBiosData.BCDRevision  ) );
 }
 
+//===============================================================================================//
+//  Description:
+//      Read the SMBIOS data from a dump file
+//
+//  Parameters:
+//      FilePath - path to the dump file
+//
+//  Remarks:
+//      Accepts a raw structure table such as /sys/firmware/dmi/tables/DMI
+//      or a dmidecode --dump-bin file, which has the entry point structure
+//      at the start and the table at the address the entry point gives.
+//      A raw table has no version so assume 3.0, items that are not in a
+//      structure are skipped whatever the version. The 64-bit entry point
+//      gives the table's maximum size so the table may end before it, the
+//      structure walk finds where it really ends.
+//
+//  Returns:
+//        void
+//===============================================================================================//
+void SmbiosInformation::ReadSmbiosDumpFile( const String& FilePath )
+{
+    const  UINT64 MAX_DUMP_FILE_SIZE = 16 * 1024 * 1024;    // 16MB
+    BYTE   majorVersion = 3, minorVersion = 0;
+    DWORD  maxLength = 0;
+    UINT64 address64 = 0;
+    size_t fileSize = 0, tableAddress = 0, tableLength = 0;
+    File   DumpFile;
+    ByteArray   Contents;
+    const BYTE* pContents = nullptr;
+
+    DumpFile.Open( FilePath, GENERIC_READ, FILE_SHARE_READ, 1, false );
+    if ( DumpFile.GetSize() > MAX_DUMP_FILE_SIZE )
+    {
+        throw BoundsException( L"MAX_DUMP_FILE_SIZE", __FUNCTION__ );
+    }
+    DumpFile.ReadAll( &Contents );
+    DumpFile.Close();
+
+    fileSize    = Contents.GetSize();
+    pContents   = Contents.GetPtr();
+    tableLength = fileSize;
+    if ( ( fileSize >= 0x18 ) && ( memcmp( pContents, "_SM3_", 5 ) == 0 ) )
+    {
+        // 64-bit entry point, table maximum size is at 0Ch, address at 10h
+        majorVersion = pContents[ 0x07 ];
+        minorVersion = pContents[ 0x08 ];
+        maxLength    = static_cast<DWORD>(
+                            MAKELONG( MAKEWORD( pContents[ 0x0C ], pContents[ 0x0D ] ),
+                                      MAKEWORD( pContents[ 0x0E ], pContents[ 0x0F ] ) ) );
+        for ( size_t i = 0; i < sizeof ( address64 ); i++ )
+        {
+            address64 |= static_cast<UINT64>( pContents[ 0x10 + i ] ) << ( 8 * i );
+        }
+        if ( address64 > fileSize )
+        {
+            throw SystemException( ERROR_INVALID_DATA, L"address64", __FUNCTION__ );
+        }
+        tableAddress = static_cast<size_t>( address64 );
+        tableLength  = PXSMinSizeT( maxLength, fileSize - tableAddress );
+    }
+    else if ( ( fileSize >= 0x1F ) && ( memcmp( pContents, "_SM_", 4 ) == 0 ) )
+    {
+        // 32-bit entry point, table length is at 16h, address at 18h
+        majorVersion = pContents[ 0x06 ];
+        minorVersion = pContents[ 0x07 ];
+        tableLength  = MAKEWORD( pContents[ 0x16 ], pContents[ 0x17 ] );
+        tableAddress = static_cast<DWORD>(
+                            MAKELONG( MAKEWORD( pContents[ 0x18 ], pContents[ 0x19 ] ),
+                                      MAKEWORD( pContents[ 0x1A ], pContents[ 0x1B ] ) ) );
+    }
+
+    // The address of a dump is the table's offset in the file
+    if ( ( tableAddress > fileSize ) || ( tableLength > ( fileSize - tableAddress ) ) )
+    {
+        throw SystemException( ERROR_INVALID_DATA, L"tableAddress/tableLength", __FUNCTION__ );
+    }
+    SetSmbiosData( pContents + tableAddress, tableLength, majorVersion, minorVersion );
+    PXSLogAppInfo1( L"Read SMBIOS dump file  : %%1", FilePath );
+}
+
+//===============================================================================================//
+//  Description:
+//      Set the SMBIOS data from an in-memory structure table
+//
+//  Parameters:
+//      pTable       - the structure table
+//      tableLength  - length of the table in bytes
+//      majorVersion - SMBIOS major version
+//      minorVersion - SMBIOS minor version
+//
+//  Remarks:
+//      The table is checked structure by structure and cut at the first one
+//      whose formatted length or string set is malformed, so the lookups
+//      never read past the end of a structure. Throws if no structure is
+//      intact rather than leave the data invalid, otherwise a later read
+//      would fall back to this computer's firmware.
+//
+//  Returns:
+//        void
+//===============================================================================================//
+void SmbiosInformation::SetSmbiosData( const BYTE* pTable,
+                                       size_t tableLength, BYTE majorVersion, BYTE minorVersion )
+{
+    const  DWORD MAX_SMBIOS_DATA_LEN = 65536;       // 64KB
+    size_t offset = 0, validLength = 0, next = 0;
+    Formatter Format;
+
+    if ( pTable == nullptr )
+    {
+        throw ParameterException( L"pTable", __FUNCTION__ );
+    }
+
+    // The table length is held in a WORD
+    if ( tableLength > UINT16_MAX )
+    {
+        PXSLogAppWarn1( L"SMBIOS table truncated from %%1 bytes.", Format.SizeT( tableLength ) );
+        tableLength = UINT16_MAX;
+    }
+
+    // Walk the structures, each is a formatted area of at least 4 bytes then
+    // a string set ending in a double null
+    while ( ( offset + 4 ) <= tableLength )
+    {
+        if ( pTable[ offset + 1 ] < 4 )
+        {
+            break;
+        }
+
+        next = offset + pTable[ offset + 1 ];
+        while ( ( ( next + 1 ) < tableLength ) &&
+                ( ( pTable[ next ] != 0x00 ) || ( pTable[ next + 1 ] != 0x00 ) ) )
+        {
+            next++;
+        }
+        if ( ( next + 1 ) >= tableLength )
+        {
+            break;
+        }
+        offset      = next + 2;
+        validLength = offset;
+    }
+
+    if ( validLength == 0 )
+    {
+        throw SystemException( ERROR_INVALID_DATA, L"validLength = 0", __FUNCTION__ );
+    }
+
+    if ( validLength < tableLength )
+    {
+        PXSLogAppWarn1( L"SMBIOS table malformed after byte %%1.", Format.SizeT( validLength ) );
+    }
+
+    // Allocate memory for the data table if have not already done so
+    m_SmBiosData.validData = false;
+    if ( m_SmBiosData.pDataTable == nullptr )
+    {
+        m_SmBiosData.pDataTable = new BYTE[ MAX_SMBIOS_DATA_LEN ];
+        if ( m_SmBiosData.pDataTable == nullptr )
+        {
+            throw MemoryException( __FUNCTION__ );
+        }
+    }
+    memset( m_SmBiosData.pDataTable, 0, MAX_SMBIOS_DATA_LEN );
+    memcpy( m_SmBiosData.pDataTable, pTable, validLength );
+
+    m_SmBiosData.tableLength  = PXSCastSizeTToUInt16( validLength );
+    m_SmBiosData.majorVersion = majorVersion;
+    m_SmBiosData.minorVersion = minorVersion;
+    m_SmBiosData.BCDRevision  = static_cast<BYTE>( ( ( majorVersion & 0x0F ) << 4 ) |
+                                                   ( minorVersion & 0x0F ) );
+    m_SmBiosData.validData    = true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Protected Methods
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1154,6 +1329,15 @@ bool SmbiosInformation::GetSmbiosValue( DWORD itemID,
         return false;
     }
 
+    // The item must lie in the formatted area, a short structure means the
+    // firmware did not implement it. Test this first as a short structure
+    // at the end of the table is not out of bounds.
+    if ( ( SmbiosSpec.offset + SmbiosSpec.length ) >
+         m_SmBiosData.pDataTable[ structureOffset + 1 ] )
+    {
+        return false;
+    }
+
     // Check bounds
     if ( ( structureOffset + SmbiosSpec.offset + SmbiosSpec.length ) >= m_SmBiosData.tableLength )
     {
@@ -1274,10 +1458,11 @@ void SmbiosInformation::GetString( BYTE stringNumber,
             counter++;
             if ( stringNumber == counter )
             {
+                // An over long string is truncated rather than lose the record
                 HRESULT hr = StringCchCopyA( pszBuffer,
                                              bufferChars,
                                              reinterpret_cast<const char*>( pStructure + start ) );
-                if ( FAILED( hr ) )
+                if ( FAILED( hr ) && ( hr != STRSAFE_E_INSUFFICIENT_BUFFER ) )
                 {
                     throw ComException( hr, L"StringCchCopyA", __FUNCTION__ );
                 }
@@ -576,6 +576,8 @@ void SoftwareInformation::GetDiagnostics( String* pDiagnostics )
 //===============================================================================================//
 void SoftwareInformation::GetInstalledSoftwareRecords( TArray< AuditRecord >* pRecords )
 {
+    const DWORD SORT_ITEM_IDS[]  = { PXS_INSTAL_PROGS_NAME, PXS_INSTAL_PROGS_VERSION };
+    const DWORD SORT_KEY_TYPES[] = { PXS_SORT_KEY_STRING  , PXS_SORT_KEY_VERSION };
     String      Value;
     Formatter   Format;
     AuditRecord Record;
@@ -646,7 +648,10 @@ void SoftwareInformation::GetInstalledSoftwareRecords( TArray< AuditRecord >* pR
             pRecords->Add( Record );
         }
     } while ( Installed.Advance() );
-    PXSSortAuditRecords( pRecords, PXS_INSTAL_PROGS_NAME );
+
+    // By name then version so side by side installs are listed oldest first
+    PXSSortAuditRecordsByKeys( pRecords,
+                               SORT_ITEM_IDS, SORT_KEY_TYPES, ARRAYSIZE( SORT_ITEM_IDS ) );
 }
 
 //===============================================================================================//
@@ -661,6 +666,8 @@ void SoftwareInformation::GetInstalledSoftwareRecords( TArray< AuditRecord >* pR
 //===============================================================================================//
 void SoftwareInformation::GetSoftwareUpdateRecords( TArray< AuditRecord >* pRecords )
 {
+    DWORD       itemID  = PXS_SOFTWARE_UPDATES_UPDATE_ID;
+    DWORD       keyType = PXS_SORT_KEY_VERSION;
     Formatter   Format;
     AuditRecord Record;
     TList<TYPE_UPDATE_DATA> Updates, MsiUpdates, WmiUpdates, RegUpdates;
@@ -707,7 +714,9 @@ void SoftwareInformation::GetSoftwareUpdateRecords( TArray< AuditRecord >* pReco
           pRecords->Add( Record );
         }
     } while ( Updates.Advance() );
-    PXSSortAuditRecords( pRecords, PXS_SOFTWARE_UPDATES_UPDATE_ID );
+
+    // Version order puts KB890830 before KB5005565
+    PXSSortAuditRecordsByKeys( pRecords, &itemID, &keyType, 1 );
 }
 
 //===============================================================================================//
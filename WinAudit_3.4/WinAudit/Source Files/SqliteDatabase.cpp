@@ -0,0 +1,1486 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// SQLite Database Class Implementation
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Header Files/SqliteDatabase.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/Application.h"
+#include "PxsBase/Header Files/Formatter.h"
+#include "PxsBase/Header Files/FunctionException.h"
+#include "PxsBase/Header Files/ParameterException.h"
+#include "PxsBase/Header Files/StringArray.h"
+#include "PxsBase/Header Files/StringHashIndex.h"
+#include "PxsBase/Header Files/SystemException.h"
+#include "PxsBase/Header Files/TArray.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/AuditDatabase.h"
+#include "WinAudit/Header Files/AuditRecord.h"
+#include "WinAudit/Header Files/DatabaseAdministrationDialog.h"
+#include "WinAudit/Header Files/Resources.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Default constructor
+SqliteDatabase::SqliteDatabase()
+               :m_bValueDictionary( false ),
+                m_pDatabase( nullptr ),
+                m_SqliteLibrary(),
+                m_pfnBindInt64( nullptr ),
+                m_pfnBindNull( nullptr ),
+                m_pfnBindText16( nullptr ),
+                m_pfnBusyTimeout( nullptr ),
+                m_pfnClose( nullptr ),
+                m_pfnColumnInt64( nullptr ),
+                m_pfnErrMsg16( nullptr ),
+                m_pfnFinalize( nullptr ),
+                m_pfnLastInsertRowID( nullptr ),
+                m_pfnOpen16( nullptr ),
+                m_pfnPrepare16( nullptr ),
+                m_pfnReset( nullptr ),
+                m_pfnStep( nullptr )
+{
+}
+
+// Copy constructor - not allowed so no implementation
+
+// Destructor
+SqliteDatabase::~SqliteDatabase()
+{
+    try
+    {
+        Close();
+    }
+    catch ( const Exception& e )
+    {
+        PXSLogException( e, __FUNCTION__ );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Operators
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Assignment operator - not allowed so no implementation
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Public Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Close the database file
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      All statements are finalised before the methods that prepare them
+//      return so there is nothing to stop the close.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void SqliteDatabase::Close()
+{
+    int       result = 0;
+    Formatter Format;
+
+    if ( m_pDatabase == nullptr )
+    {
+        return;     // Nothing to do
+    }
+    result      = m_pfnClose( m_pDatabase );
+    m_pDatabase = nullptr;
+    if ( result != RESULT_OK )
+    {
+        PXSLogAppWarn1( L"sqlite3_close returned %%1.", Format.Int32( result ) );
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Count the audits that are outside the retention policy
+//
+//  Parameters:
+//      retainCount - the number of most recent audits to keep per computer
+//      retainDays  - keep audits newer than this many days, zero for no
+//                    age limit
+//
+//  Returns:
+//      size_t number of audits
+//===============================================================================================//
+size_t SqliteDatabase::CountOldAudits( DWORD retainCount, DWORD retainDays )
+{
+    __int64 count = 0;
+    String  DbmsName, Predicate, SqlQuery;
+    sqlite3_stmt* pStmt = nullptr;
+
+    if ( m_pDatabase == nullptr )
+    {
+        throw FunctionException( L"m_pDatabase", __FUNCTION__ );
+    }
+
+    DbmsName = PXS_DBMS_NAME_SQLITE;
+    AuditDatabase::MakeOldAuditsPredicate( DbmsName, retainCount, retainDays, &Predicate );
+    SqlQuery  = L"SELECT COUNT(*) FROM Audit_Master AS am WHERE ";
+    SqlQuery += Predicate;
+    pStmt = Prepare( SqlQuery.c_str() );
+    try
+    {
+        if ( Step( pStmt ) )
+        {
+            count = m_pfnColumnInt64( pStmt, 0 );
+        }
+    }
+    catch ( const Exception& )
+    {
+        Finalize( pStmt );
+        throw;
+    }
+    Finalize( pStmt );
+
+    if ( count < 0 )
+    {
+        count = 0;
+    }
+
+    return PXSCastInt64ToSizeT( count );
+}
+
+//===============================================================================================//
+//  Description:
+//      Delete a batch of the audits that are outside the retention policy
+//
+//  Parameters:
+//      retainCount  - the number of most recent audits to keep per computer
+//      retainDays   - keep audits newer than this many days, zero for no
+//                     age limit
+//      batchSize    - the maximum number of audits to delete
+//      pLastAuditID - on input the highest Audit_ID of the previous batch,
+//                     zero for the first. Receives the highest Audit_ID
+//                     deleted by this batch
+//
+//  Remarks:
+//      As for AuditDatabase::DeleteOldAuditsBatch, call repeatedly until
+//      zero is returned. The Audit_Data or Audit_Item rows go by ON DELETE
+//      CASCADE and unused Audit_Value rows by the trigger on Audit_Item.
+//      BEGIN IMMEDIATE so an export cannot add an audit between the read of
+//      the IDs and the delete.
+//
+//  Returns:
+//      size_t number of audits deleted
+//===============================================================================================//
+size_t SqliteDatabase::DeleteOldAuditsBatch( DWORD retainCount,
+                                             DWORD retainDays,
+                                             DWORD batchSize, __int64* pLastAuditID )
+{
+    size_t    numAudits = 0;
+    __int64   auditID   = 0;
+    String    DbmsName, Predicate, SqlQuery, AuditIDs;
+    Formatter Format;
+    sqlite3_stmt* pStmt = nullptr;
+
+    if ( pLastAuditID == nullptr )
+    {
+        throw ParameterException( L"pLastAuditID", __FUNCTION__ );
+    }
+
+    if ( batchSize == 0 )
+    {
+        throw ParameterException( L"batchSize", __FUNCTION__ );
+    }
+
+    if ( m_pDatabase == nullptr )
+    {
+        throw FunctionException( L"m_pDatabase", __FUNCTION__ );
+    }
+
+    DbmsName = PXS_DBMS_NAME_SQLITE;
+    AuditDatabase::MakeOldAuditsPredicate( DbmsName, retainCount, retainDays, &Predicate );
+    SqlQuery.Allocate( 512 );
+    SqlQuery  = L"SELECT am.Audit_ID FROM Audit_Master AS am WHERE ";
+    SqlQuery += Predicate;
+    SqlQuery += L" AND am.Audit_ID > ? ORDER BY am.Audit_ID LIMIT ";
+    SqlQuery += Format.UInt32( batchSize );
+
+    AuditIDs.Allocate( PXSMultiplySizeT( batchSize, 12 ) );
+    Execute( L"BEGIN IMMEDIATE" );
+    try
+    {
+        pStmt = Prepare( SqlQuery.c_str() );
+        try
+        {
+            BindInt64( pStmt, 1, *pLastAuditID );
+            while ( Step( pStmt ) )
+            {
+                auditID = m_pfnColumnInt64( pStmt, 0 );
+                if ( numAudits )
+                {
+                    AuditIDs += L",";
+                }
+                AuditIDs += Format.Int64( auditID );
+                *pLastAuditID = auditID;
+                numAudits++;
+            }
+        }
+        catch ( const Exception& )
+        {
+            Finalize( pStmt );
+            throw;
+        }
+        Finalize( pStmt );
+
+        if ( numAudits )
+        {
+            SqlQuery  = L"DELETE FROM Audit_Master WHERE Audit_ID IN (";
+            SqlQuery += AuditIDs;
+            SqlQuery += L")";
+            Execute( SqlQuery.c_str() );
+        }
+        Execute( L"COMMIT" );
+    }
+    catch ( const Exception& )
+    {
+        try
+        {
+            Execute( L"ROLLBACK" );
+        }
+        catch ( const Exception& eRollback )
+        {
+            PXSLogException( eRollback, __FUNCTION__ );
+        }
+        throw;
+    }
+
+    return numAudits;
+}
+
+//===============================================================================================//
+//  Description:
+//      Export an audit to the database
+//
+//  Parameters:
+//      ComputerMaster - the computer master record
+//      AuditMaster    - the audit master record
+//      AuditRecords   - the audit data records
+//      pResultMessage - receives a text message
+//
+//  Remarks:
+//      One transaction for the whole audit, so a failure leaves no trace of
+//      it. BEGIN IMMEDIATE takes the write lock at the start rather than
+//      at the first insert so concurrent writers wait on the busy timeout
+//      instead of failing part way through.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void SqliteDatabase::ExportAudit( const AuditRecord& ComputerMaster,
+                                  const AuditRecord& AuditMaster,
+                                  const TArray< AuditRecord >& AuditRecords,
+                                  String* pResultMessage )
+{
+    size_t      numRowsAdded = 0;
+    UINT64      startTickCount = 0;
+    __int64     computerID = 0, auditID = 0;
+    String      WinAuditGuid, AddedCount, ErrorsCount, MilliSecs;
+    Formatter   Format;
+    StringArray Keys;
+
+    if ( pResultMessage == nullptr )
+    {
+        throw ParameterException( L"pResultMessage", __FUNCTION__ );
+    }
+    *pResultMessage = PXS_STRING_EMPTY;
+
+    if ( m_pDatabase == nullptr )
+    {
+        throw FunctionException( L"m_pDatabase", __FUNCTION__ );
+    }
+
+    if ( AuditRecords.GetSize() == 0 )
+    {
+        throw ParameterException( L"AuditRecords", __FUNCTION__ );
+    }
+
+    // Same requirement as for an ODBC export
+    ComputerMaster.GetItemValue( PXS_COMP_MASTER_WINAUDIT_GUID, &WinAuditGuid );
+    if ( Format.IsValidStringGuid( WinAuditGuid ) == false )
+    {
+        PXSLogAppInfo1( L"Invalid WinAuditGUID '%%1'", WinAuditGuid );
+        throw SystemException( ERROR_INVALID_DATA, PXS_WINAUDIT_COMPUTER_GUID, __FUNCTION__ );
+    }
+    AuditDatabase::ComputerMasterRecordToKeys( ComputerMaster, &Keys );
+
+    startTickCount = GetTickCount64();
+    Execute( L"BEGIN IMMEDIATE" );
+    try
+    {
+        computerID = IdentifyComputerID( Keys );
+        if ( computerID == 0 )
+        {
+            computerID = InsertComputerMaster( ComputerMaster, Keys );
+        }
+        PXSLogAppInfo1( L"The Computer_ID for this computer is: %%1.", Format.Int64( computerID ) );
+
+        auditID = InsertAuditMaster( computerID, AuditMaster );
+        PXSLogAppInfo1( L"The Audit_ID for this audit is: %%1.", Format.Int64( auditID ) );
+
+        if ( m_bValueDictionary )
+        {
+            numRowsAdded = InsertAuditItems( auditID, computerID, AuditRecords );
+        }
+        else
+        {
+            numRowsAdded = InsertAuditData( auditID, computerID, AuditRecords );
+        }
+        SetLastAuditID( computerID, auditID );
+        Execute( L"COMMIT" );
+    }
+    catch ( const Exception& )
+    {
+        try
+        {
+            Execute( L"ROLLBACK" );
+        }
+        catch ( const Exception& eRollback )
+        {
+            PXSLogException( eRollback, __FUNCTION__ );
+        }
+        throw;
+    }
+
+    // Result message
+    AddedCount  = Format.SizeT( numRowsAdded );
+    ErrorsCount = Format.UInt32( 0 );
+    MilliSecs   = Format.UInt64( GetTickCount64() - startTickCount );
+    if ( g_pApplication )
+    {
+        g_pApplication->GetResourceString3( PXS_IDS_1236_INSERT_RESULT_MESSAGE,
+                                            AddedCount, ErrorsCount, MilliSecs, pResultMessage );
+    }
+    PXSLogAppInfo( pResultMessage->c_str() );
+}
+
+//===============================================================================================//
+//  Description:
+//      Determine if a file path names a SQLite database
+//
+//  Parameters:
+//      FilePath - the file path
+//
+//  Remarks:
+//      Based on the extension, the usual ones are .db, .sqlite and .sqlite3
+//
+//  Returns:
+//      true if the path is for a SQLite database, otherwise false
+//===============================================================================================//
+bool SqliteDatabase::IsSqliteFilePath( const String& FilePath )
+{
+    if ( FilePath.EndsWithStringI( L".db"      ) ||
+         FilePath.EndsWithStringI( L".sqlite"  ) ||
+         FilePath.EndsWithStringI( L".sqlite3" )  )
+    {
+        return true;
+    }
+
+    return false;
+}
+
+//===============================================================================================//
+//  Description:
+//      Open the database file, creating it and its tables if required
+//
+//  Parameters:
+//      FilePath        - full path to the database file
+//      valueDictionary - true to create the tables with the audit data in a
+//                        value dictionary, ignored if the file has tables
+//
+//  Remarks:
+//      Write-ahead logging is a property of the file so it persists once set.
+//      With WAL, synchronous = NORMAL only syncs at checkpoints, a commit can
+//      be lost on power failure but the file is never corrupted.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void SqliteDatabase::Open( const String& FilePath, bool valueDictionary )
+{
+    int    result = 0;
+    String Details;
+
+    if ( m_pDatabase )
+    {
+        throw FunctionException( L"m_pDatabase", __FUNCTION__ );
+    }
+
+    if ( FilePath.IsEmpty() )
+    {
+        throw ParameterException( L"FilePath", __FUNCTION__ );
+    }
+
+    if ( m_pfnOpen16 == nullptr )
+    {
+        LoadSqliteLibrary();
+    }
+
+    // A handle is returned even on error, it must still be closed
+    result = m_pfnOpen16( FilePath.c_str(), &m_pDatabase );
+    if ( result != RESULT_OK )
+    {
+        Close();
+        Details = L"sqlite3_open16 ";
+        Details += FilePath;
+        ThrowSqliteError( result, Details.c_str(), __FUNCTION__ );
+    }
+
+    try
+    {
+        m_pfnBusyTimeout( m_pDatabase, static_cast<int>( 1000 * PXS_DB_QUERY_TIMEOUT_SECS_DEF ) );
+        Execute( L"PRAGMA journal_mode = WAL" );
+        Execute( L"PRAGMA synchronous = NORMAL" );
+        Execute( L"PRAGMA foreign_keys = ON" );
+        CreateTables( valueDictionary );
+    }
+    catch ( const Exception& )
+    {
+        Close();
+        throw;
+    }
+    PXSLogAppInfo1( L"Opened SQLite database '%%1'.", FilePath );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Protected Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Private Methods
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Bind an integer to a parameter of a prepared statement
+//
+//  Parameters:
+//      pStmt - the statement
+//      index - one-based parameter index
+//      value - the value
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void SqliteDatabase::BindInt64( sqlite3_stmt* pStmt, int index, __int64 value )
+{
+    int result = m_pfnBindInt64( pStmt, index, value );
+    if ( result != RESULT_OK )
+    {
+        ThrowSqliteError( result, L"sqlite3_bind_int64", __FUNCTION__ );
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Bind text to a parameter of a prepared statement
+//
+//  Parameters:
+//      pStmt    - the statement
+//      index    - one-based parameter index
+//      pszValue - the text, can be NULL
+//      numChars - the number of characters of pszValue to bind
+//
+//  Remarks:
+//      No text is bound as NULL, the same as FixUpStringSQL does for ODBC.
+//      SQLite takes its own copy of the text.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void SqliteDatabase::BindText( sqlite3_stmt* pStmt,
+                               int index, LPCWSTR pszValue, size_t numChars )
+{
+    int result = 0;
+    LPFN_SQLITE3_DESTRUCTOR pfnTransient = nullptr;
+
+    if ( ( pszValue == nullptr ) || ( numChars == 0 ) )
+    {
+        result = m_pfnBindNull( pStmt, index );
+    }
+    else
+    {
+        // SQLITE_TRANSIENT is the destructor value -1
+        pfnTransient = reinterpret_cast<LPFN_SQLITE3_DESTRUCTOR>( static_cast<INT_PTR>( -1 ) );
+        numChars     = PXSMultiplySizeT( numChars, sizeof ( wchar_t ) );
+        result       = m_pfnBindText16( pStmt,
+                                        index,
+                                        pszValue, PXSCastSizeTToInt32( numChars ), pfnTransient );
+    }
+
+    if ( result != RESULT_OK )
+    {
+        ThrowSqliteError( result, L"sqlite3_bind_text16", __FUNCTION__ );
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Create the tables if the database does not already have them
+//
+//  Parameters:
+//      valueDictionary - true to create the value dictionary layout
+//
+//  Remarks:
+//      Test inside the transaction in case another computer is creating the
+//      same file at the same time. Audit_Data is a view in the value
+//      dictionary layout so the layout is found from the Audit_Item table.
+//      Databases made before the trigger that deletes unused Audit_Value rows
+//      get it here, along with a one off purge of the rows left by audits
+//      that were deleted without it.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void SqliteDatabase::CreateTables( bool valueDictionary )
+{
+    size_t      i = 0, numStatements = 0;
+    String      SqlQuery;
+    StringArray Statements;
+
+    Execute( L"BEGIN IMMEDIATE" );
+    try
+    {
+        if ( HasSchemaObject( L"table", L"Audit_Master" ) == false )
+        {
+            PXSLogAppInfo( L"Creating the tables in the SQLite database." );
+            DatabaseAdministrationDialog::AddCreateSqliteSql( valueDictionary, &Statements );
+            numStatements = Statements.GetSize();
+            for ( i = 0; i < numStatements; i++ )
+            {
+                SqlQuery = Statements.Get( i );
+                Execute( SqlQuery.c_str() );
+            }
+        }
+        m_bValueDictionary = HasSchemaObject( L"table", L"Audit_Item" );
+        if ( m_bValueDictionary &&
+             HasSchemaObject( L"trigger", L"trg_AI_Delete_Value" ) == false )
+        {
+            PXSLogAppInfo( L"Adding the Audit_Value clean up trigger to the SQLite database." );
+            Statements.RemoveAll();
+            DatabaseAdministrationDialog::AddCreateAuditValueTriggerSql( &Statements );
+            numStatements = Statements.GetSize();
+            for ( i = 0; i < numStatements; i++ )
+            {
+                SqlQuery = Statements.Get( i );
+                Execute( SqlQuery.c_str() );
+            }
+            Execute( L"DELETE FROM Audit_Value WHERE NOT EXISTS ( SELECT 1 FROM Audit_Item "
+                     L"WHERE Audit_Item.Value_ID = Audit_Value.Value_ID )" );
+        }
+        Execute( L"COMMIT" );
+    }
+    catch ( const Exception& )
+    {
+        try
+        {
+            Execute( L"ROLLBACK" );
+        }
+        catch ( const Exception& eRollback )
+        {
+            PXSLogException( eRollback, __FUNCTION__ );
+        }
+        throw;
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Execute an SQL statement that takes no parameters
+//
+//  Parameters:
+//      pszSql - the statement
+//
+//  Remarks:
+//      Any rows are discarded, e.g. PRAGMA journal_mode returns the mode
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void SqliteDatabase::Execute( LPCWSTR pszSql )
+{
+    sqlite3_stmt* pStmt = Prepare( pszSql );
+
+    try
+    {
+        while ( Step( pStmt ) )
+        {
+            // Discard the row
+        }
+    }
+    catch ( const Exception& )
+    {
+        Finalize( pStmt );
+        throw;
+    }
+    Finalize( pStmt );
+}
+
+//===============================================================================================//
+//  Description:
+//      Finalise a prepared statement
+//
+//  Parameters:
+//      pStmt - the statement, can be NULL
+//
+//  Remarks:
+//      The return value repeats the last error from sqlite3_step which has
+//      already been reported so it is ignored.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void SqliteDatabase::Finalize( sqlite3_stmt* pStmt )
+{
+    if ( pStmt )
+    {
+        m_pfnFinalize( pStmt );
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the maximum number of characters stored for an audit data item
+//
+//  Parameters:
+//      index - zero-based item index
+//
+//  Remarks:
+//      The sizes of the Item_n columns created by DatabaseAdministrationDialog.
+//      Values are truncated to them so the file can be merged into a server
+//      database.
+//
+//  Returns:
+//      number of characters
+//===============================================================================================//
+size_t SqliteDatabase::GetItemMaxChars( size_t index )
+{
+    if ( index < NUM_WIDE_ITEMS )
+    {
+        return WIDE_ITEM_CHARS;
+    }
+    return 1;
+}
+
+//===============================================================================================//
+//  Description:
+//      Determine if the database has the specified table, view, index or
+//      trigger
+//
+//  Parameters:
+//      pszType - the sqlite_master type, e.g. table or trigger
+//      pszName - the object's name
+//
+//  Returns:
+//      true if the object exists otherwise false
+//===============================================================================================//
+bool SqliteDatabase::HasSchemaObject( LPCWSTR pszType, LPCWSTR pszName )
+{
+    __int64 numObjects = 0;
+    sqlite3_stmt* pStmt = nullptr;
+
+    if ( pszType == nullptr )
+    {
+        throw ParameterException( L"pszType", __FUNCTION__ );
+    }
+
+    if ( pszName == nullptr )
+    {
+        throw ParameterException( L"pszName", __FUNCTION__ );
+    }
+
+    pStmt = Prepare( L"SELECT COUNT(*) FROM sqlite_master WHERE type = ? AND name = ?" );
+    try
+    {
+        BindText( pStmt, 1, pszType, wcslen( pszType ) );
+        BindText( pStmt, 2, pszName, wcslen( pszName ) );
+        if ( Step( pStmt ) )
+        {
+            numObjects = m_pfnColumnInt64( pStmt, 0 );
+        }
+    }
+    catch ( const Exception& )
+    {
+        Finalize( pStmt );
+        throw;
+    }
+    Finalize( pStmt );
+
+    return ( numObjects > 0 );
+}
+
+//===============================================================================================//
+//  Description:
+//      Get a computer's identifier from the Computer_Master table
+//
+//  Parameters:
+//      Keys - the computer's identifying keys in AuditDatabase KEY_ order
+//
+//  Remarks:
+//      A local file only ever sees computers that wrote to it so the
+//      WinAudit GUID is enough. The full matching on combinations of keys
+//      is done when the file is merged into a server database.
+//
+//  Returns:
+//      the computer identifier, zero if not found
+//===============================================================================================//
+__int64 SqliteDatabase::IdentifyComputerID( const StringArray& Keys )
+{
+    __int64 computerID = 0;
+    String  SqlQuery;
+    sqlite3_stmt* pStmt = nullptr;
+
+    const String& WinAuditGuid = Keys.Get( AuditDatabase::KEY_WINAUDIT_GUID );
+    SqlQuery  = L"SELECT Computer_ID FROM Computer_Master WHERE ";
+    SqlQuery += AuditDatabase::GetKeyColumnName( AuditDatabase::KEY_WINAUDIT_GUID, true );
+    SqlQuery += L" = ?";
+    pStmt = Prepare( SqlQuery.c_str() );
+    try
+    {
+        BindText( pStmt, 1, WinAuditGuid.c_str(), WinAuditGuid.GetLength() );
+        if ( Step( pStmt ) )
+        {
+            computerID = m_pfnColumnInt64( pStmt, 0 );
+        }
+    }
+    catch ( const Exception& )
+    {
+        Finalize( pStmt );
+        throw;
+    }
+    Finalize( pStmt );
+
+    if ( computerID == 0 )
+    {
+        PXSLogAppInfo( L"Did not find matching Computer_ID Computer_Master table." );
+    }
+
+    return computerID;
+}
+
+//===============================================================================================//
+//  Description:
+//      Insert the audit records into the Audit_Data table
+//
+//  Parameters:
+//      auditID      - the audit identifier
+//      computerID   - the computer identifier
+//      AuditRecords - the records
+//
+//  Remarks:
+//      One statement is prepared and then reset for each row. Every parameter
+//      is bound for each row so nothing carries over from the previous one.
+//      Values are truncated to the column sizes of a server database so the
+//      file can be merged into one.
+//
+//  Returns:
+//      Number of rows inserted
+//===============================================================================================//
+size_t SqliteDatabase::InsertAuditData( __int64 auditID,
+                                        __int64 computerID,
+                                        const TArray< AuditRecord >& AuditRecords )
+{
+    size_t    i = 0, j = 0, numRecords = 0, numValues = 0, numChars = 0;
+    int       index = 0;
+    String    SqlQuery, Placeholders;
+    Formatter Format;
+    sqlite3_stmt* pStmt = nullptr;
+
+    SqlQuery.Allocate( 1024 );
+    SqlQuery     = L"INSERT INTO Audit_Data ( Audit_ID, Record_Ordinal, Computer_ID, Category_ID";
+    Placeholders = L"?, ?, ?, ?";
+    for ( j = 0; j < NUM_AUDIT_DATA_ITEMS; j++ )
+    {
+        SqlQuery     += L", Item_";
+        SqlQuery     += Format.SizeT( j + 1 );
+        Placeholders += L", ?";
+    }
+    SqlQuery += L" ) VALUES ( ";
+    SqlQuery += Placeholders;
+    SqlQuery += L" )";
+
+    numRecords = AuditRecords.GetSize();
+    pStmt = Prepare( SqlQuery.c_str() );
+    try
+    {
+        for ( i = 0; i < numRecords; i++ )
+        {
+            const AuditRecord& Record = AuditRecords.Get( i );
+            BindInt64( pStmt, 1, auditID );
+            BindInt64( pStmt, 2, static_cast<__int64>( i + 1 ) );
+            BindInt64( pStmt, 3, computerID );
+            BindInt64( pStmt, 4, Record.GetCategoryID() );
+
+            numValues = Record.GetNumberOfValues();
+            for ( j = 0; j < NUM_AUDIT_DATA_ITEMS; j++ )
+            {
+                index = PXSCastSizeTToInt32( j + 5 );
+                if ( j < numValues )
+                {
+                    numChars = PXSMinSizeT( Record.GetValueLength( j ), GetItemMaxChars( j ) );
+                    BindText( pStmt, index, Record.GetValue( j ), numChars );
+                }
+                else
+                {
+                    BindText( pStmt, index, nullptr, 0 );
+                }
+            }
+            Step( pStmt );
+            m_pfnReset( pStmt );
+        }
+    }
+    catch ( const Exception& )
+    {
+        Finalize( pStmt );
+        throw;
+    }
+    Finalize( pStmt );
+
+    return numRecords;
+}
+
+//===============================================================================================//
+//  Description:
+//      Insert the audit records into the value dictionary tables
+//
+//  Parameters:
+//      auditID      - the audit identifier
+//      computerID   - the computer identifier
+//      AuditRecords - the records
+//
+//  Remarks:
+//      The values are first made distinct within the audit using a hash
+//      index so each is looked up in Audit_Value only once. A value is
+//      referred to by record index * NUM_AUDIT_DATA_ITEMS + item index to
+//      avoid copying it. Empty items are not stored except for the first so
+//      that every record has at least one row in Audit_Item.
+//
+//  Returns:
+//      Number of records inserted
+//===============================================================================================//
+size_t SqliteDatabase::InsertAuditItems( __int64 auditID,
+                                         __int64 computerID,
+                                         const TArray< AuditRecord >& AuditRecords )
+{
+    size_t    i = 0, j = 0, k = 0, numRecords = 0, numValues = 0, numChars = 0;
+    size_t    numItems = 0, position = 0, ref = 0, other = 0;
+    size_t    distinct = 0, numDistinct = 0, numItemRows = 0;
+    UINT32    hash = 0;
+    LPCWSTR   pszValue = nullptr;
+    String    Details;
+    Formatter Format;
+    StringHashIndex   ValueIndex;
+    TArray< size_t >  DistinctRefs, ItemDistinct;
+    TArray< __int64 > ValueIDs;
+    sqlite3_stmt* pStmt = nullptr;
+
+    numRecords = AuditRecords.GetSize();
+    if ( numRecords == 0 )
+    {
+        return 0;
+    }
+
+    numItems = PXSMultiplySizeT( numRecords, NUM_AUDIT_DATA_ITEMS );
+    DistinctRefs.SetSize( numItems );
+    ItemDistinct.SetSize( numItems );
+    for ( ref = 0; ref < numItems; ref++ )
+    {
+        DistinctRefs.Set( ref, 0 );
+        ItemDistinct.Set( ref, 0 );
+    }
+
+    // Make the values distinct, ItemDistinct holds the distinct index + 1
+    for ( i = 0; i < numRecords; i++ )
+    {
+        const AuditRecord& Record = AuditRecords.Get( i );
+        numValues = PXSMinSizeT( Record.GetNumberOfValues(), NUM_AUDIT_DATA_ITEMS );
+        for ( j = 0; j < numValues; j++ )
+        {
+            numChars = PXSMinSizeT( Record.GetValueLength( j ), GetItemMaxChars( j ) );
+            if ( numChars )
+            {
+                pszValue = Record.GetValue( j );
+                hash     = StringHashIndex::HashString( pszValue, numChars, true );
+                distinct = 0;
+                k        = ValueIndex.FindFirst( hash, &position );
+                while ( ( distinct == 0 ) && ( k != PXS_MINUS_ONE ) )
+                {
+                    ref   = DistinctRefs.Get( k );
+                    other = ref % NUM_AUDIT_DATA_ITEMS;
+                    const AuditRecord& Other = AuditRecords.Get( ref / NUM_AUDIT_DATA_ITEMS );
+                    if ( ( numChars == PXSMinSizeT( Other.GetValueLength( other ),
+                                                    GetItemMaxChars( other ) ) ) &&
+                         ( memcmp( pszValue,
+                                   Other.GetValue( other ), numChars * sizeof ( wchar_t ) ) == 0 ) )
+                    {
+                        distinct = k + 1;
+                    }
+                    else
+                    {
+                        k = ValueIndex.FindNext( hash, &position );
+                    }
+                }
+
+                if ( distinct == 0 )
+                {
+                    DistinctRefs.Set( numDistinct, ( i * NUM_AUDIT_DATA_ITEMS ) + j );
+                    ValueIndex.Add( hash, numDistinct );
+                    numDistinct++;
+                    distinct = numDistinct;
+                }
+                ItemDistinct.Set( ( i * NUM_AUDIT_DATA_ITEMS ) + j, distinct );
+            }
+        }
+    }
+    LookupValueIDs( AuditRecords, DistinctRefs, numDistinct, &ValueIDs );
+
+    pStmt = Prepare( L"INSERT INTO Audit_Item ( Audit_ID, Record_Ordinal, Computer_ID, "
+                     L"Category_ID, Item_Number, Value_ID ) VALUES ( ?, ?, ?, ?, ?, ? )" );
+    try
+    {
+        // Reset keeps the bindings so the record's are bound once
+        for ( i = 0; i < numRecords; i++ )
+        {
+            const AuditRecord& Record = AuditRecords.Get( i );
+            BindInt64( pStmt, 1, auditID );
+            BindInt64( pStmt, 2, static_cast<__int64>( i + 1 ) );
+            BindInt64( pStmt, 3, computerID );
+            BindInt64( pStmt, 4, Record.GetCategoryID() );
+            for ( j = 0; j < NUM_AUDIT_DATA_ITEMS; j++ )
+            {
+                distinct = ItemDistinct.Get( ( i * NUM_AUDIT_DATA_ITEMS ) + j );
+                if ( distinct || ( j == 0 ) )
+                {
+                    BindInt64( pStmt, 5, static_cast<__int64>( j + 1 ) );
+                    if ( distinct )
+                    {
+                        BindInt64( pStmt, 6, ValueIDs.Get( distinct - 1 ) );
+                    }
+                    else
+                    {
+                        BindText( pStmt, 6, nullptr, 0 );
+                    }
+                    Step( pStmt );
+                    m_pfnReset( pStmt );
+                    numItemRows++;
+                }
+            }
+        }
+    }
+    catch ( const Exception& )
+    {
+        Finalize( pStmt );
+        throw;
+    }
+    Finalize( pStmt );
+
+    Details  = L"Audit_Item rows inserted: ";
+    Details += Format.SizeT( numItemRows );
+    Details += L", distinct values: ";
+    Details += Format.SizeT( numDistinct );
+    PXSLogAppInfo( Details.c_str() );
+
+    return numRecords;
+}
+
+//===============================================================================================//
+//  Description:
+//      Insert a record into the Audit_Master table
+//
+//  Parameters:
+//      computerID  - the computer identifier for this audit
+//      AuditMaster - the audit master record
+//
+//  Remarks:
+//      The values are validated as for AuditDatabase::InsertAuditMaster. The
+//      database times are from SQLite's clock, i.e. the computer's.
+//
+//  Returns:
+//      the audit identifier
+//===============================================================================================//
+__int64 SqliteDatabase::InsertAuditMaster( __int64 computerID, const AuditRecord& AuditMaster )
+{
+    const size_t NUM_VALUES = 3;
+    const DWORD  ITEM_IDS[ NUM_VALUES ] = { PXS_AUDIT_MASTER_AUDIT_GUID,
+                                            PXS_AUDIT_MASTER_COMPUTER_LOCAL,
+                                            PXS_AUDIT_MASTER_COMPUTER_UTC };
+    size_t    i = 0;
+    bool      valid = false;
+    String    ErrorMessage;
+    Formatter Format;
+    StringArray   Values;
+    sqlite3_stmt* pStmt = nullptr;
+
+    if ( computerID <= 0 )
+    {
+        throw ParameterException( L"computerID", __FUNCTION__ );
+    }
+
+    for ( i = 0; i < NUM_VALUES; i++ )
+    {
+        const String& Value = AuditMaster.GetItemValue( ITEM_IDS[ i ] );
+        if ( i == 0 )
+        {
+            valid = Format.IsValidStringGuid( Value );
+        }
+        else
+        {
+            valid = Format.IsValidIsoTimestamp( Value, nullptr );
+        }
+
+        if ( valid == false )
+        {
+            ErrorMessage  = L"Audit_Master item ";
+            ErrorMessage += Format.UInt32( ITEM_IDS[ i ] );
+            ErrorMessage += L"=";
+            ErrorMessage += Value;
+            throw SystemException( ERROR_INVALID_DATA, ErrorMessage.c_str(), __FUNCTION__ );
+        }
+        Values.Add( Value );
+    }
+
+    pStmt = Prepare( L"INSERT INTO Audit_Master ( "
+                     L"Audit_GUID, DB_User_Name, Database_Local, Database_UTC, "
+                     L"Computer_Local, Computer_UTC, Computer_ID ) VALUES ( "
+                     L"?, NULL, datetime( 'now', 'localtime' ), datetime( 'now' ), ?, ?, ? )" );
+    try
+    {
+        for ( i = 0; i < NUM_VALUES; i++ )
+        {
+            const String& Value = Values.Get( i );
+            BindText( pStmt, PXSCastSizeTToInt32( i + 1 ), Value.c_str(), Value.GetLength() );
+        }
+        BindInt64( pStmt, 4, computerID );
+        Step( pStmt );
+    }
+    catch ( const Exception& )
+    {
+        Finalize( pStmt );
+        throw;
+    }
+    Finalize( pStmt );
+
+    return m_pfnLastInsertRowID( m_pDatabase );
+}
+
+//===============================================================================================//
+//  Description:
+//      Insert a record into the Computer_Master table
+//
+//  Parameters:
+//      ComputerMaster - the computer master record
+//      Keys           - the computer's identifying keys in AuditDatabase KEY_ order
+//
+//  Remarks:
+//      The values are validated as for AuditDatabase::InsertComputerMaster,
+//      an invalid MAC address or SMBIOS UUID is stored as NULL.
+//
+//  Returns:
+//      the computer identifier
+//===============================================================================================//
+__int64 SqliteDatabase::InsertComputerMaster( const AuditRecord& ComputerMaster,
+                                              const StringArray& Keys )
+{
+    const size_t NUM_VALUES = 10;
+    const DWORD  ITEM_IDS[ NUM_VALUES ] = { PXS_COMP_MASTER_MAC_ADDRESS,
+                                            PXS_COMP_MASTER_SMBIOS_UUID,
+                                            PXS_COMP_MASTER_ASSET_TAG,
+                                            PXS_COMP_MASTER_FQDN,
+                                            PXS_COMP_MASTER_SITE_NAME,
+                                            PXS_COMP_MASTER_DOMAIN_NAME,
+                                            PXS_COMP_MASTER_COMPUTER_NAME,
+                                            PXS_COMP_MASTER_OS_PRODUCT_ID,
+                                            PXS_COMP_MASTER_OTHER_ID,
+                                            PXS_COMP_MASTER_WINAUDIT_GUID };
+    LPCWSTR COLUMNS[ NUM_VALUES ] = { L"MAC_Address",
+                                      L"Smbios_UUID",
+                                      L"Asset_Tag",
+                                      L"Fully_Qualified_Domain_Name",
+                                      L"Site_Name",
+                                      L"Domain_Name",
+                                      L"Computer_Name",
+                                      L"OS_Product_ID",
+                                      L"Other_Identifier",
+                                      L"WinAudit_GUID" };
+    int       index = 0;
+    size_t    i = 0, numKeys = 0;
+    String    ComputerGuid, Value, ColumnName, SqlQuery, Placeholders;
+    Formatter Format;
+    sqlite3_stmt* pStmt = nullptr;
+
+    numKeys = Keys.GetSize();
+    if ( numKeys != AuditDatabase::NUM_KEYS )
+    {
+        throw ParameterException( L"Keys", __FUNCTION__ );
+    }
+
+    SqlQuery.Allocate( 1024 );
+    SqlQuery     = L"INSERT INTO Computer_Master ( "
+                   L"Computer_GUID, DB_User_Name, Database_Local, Last_Audit_ID";
+    Placeholders = L"?, NULL, datetime( 'now', 'localtime' ), 0";
+    for ( i = 0; i < NUM_VALUES; i++ )
+    {
+        SqlQuery     += L", ";
+        SqlQuery     += COLUMNS[ i ];
+        Placeholders += L", ?";
+    }
+    for ( i = 0; i < numKeys; i++ )
+    {
+        SqlQuery     += L", ";
+        SqlQuery     += AuditDatabase::GetKeyColumnName( i, true );
+        Placeholders += L", ?";
+    }
+    SqlQuery += L" ) VALUES ( ";
+    SqlQuery += Placeholders;
+    SqlQuery += L" )";
+
+    ComputerGuid = Format.CreateGuid();
+    pStmt = Prepare( SqlQuery.c_str() );
+    try
+    {
+        index = 1;
+        BindText( pStmt, index, ComputerGuid.c_str(), ComputerGuid.GetLength() );
+        for ( i = 0; i < NUM_VALUES; i++ )
+        {
+            Value = PXS_STRING_EMPTY;
+            ComputerMaster.GetItemValue( ITEM_IDS[ i ], &Value );
+            Value.Trim();
+            if ( ( ( ITEM_IDS[ i ] == PXS_COMP_MASTER_MAC_ADDRESS   ) &&
+                     !Format.IsValidMacAddress( Value ) ) ||
+                 ( ( ITEM_IDS[ i ] == PXS_COMP_MASTER_SMBIOS_UUID   ) &&
+                     !Format.IsValidStringGuid( Value ) ) ||
+                 ( ( ITEM_IDS[ i ] == PXS_COMP_MASTER_WINAUDIT_GUID ) &&
+                     !Format.IsValidStringGuid( Value ) )  )
+            {
+                ColumnName = COLUMNS[ i ];
+                PXSLogAppWarn2( L"Invalid %%1: '%%2'.", ColumnName, Value );
+                Value = PXS_STRING_EMPTY;
+            }
+            index++;
+            BindText( pStmt, index, Value.c_str(), Value.GetLength() );
+        }
+
+        for ( i = 0; i < numKeys; i++ )
+        {
+            const String& Key = Keys.Get( i );
+            index++;
+            BindText( pStmt, index, Key.c_str(), Key.GetLength() );
+        }
+        Step( pStmt );
+    }
+    catch ( const Exception& )
+    {
+        Finalize( pStmt );
+        throw;
+    }
+    Finalize( pStmt );
+
+    return m_pfnLastInsertRowID( m_pDatabase );
+}
+
+//===============================================================================================//
+//  Description:
+//      Load the SQLite library and get the addresses of the functions used
+//
+//  Parameters:
+//      None
+//
+//  Remarks:
+//      sqlite3.dll must be in the application's directory
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void SqliteDatabase::LoadSqliteLibrary()
+{
+    String LibFullPath;
+
+    PXSGetExeDirectory( &LibFullPath );
+    LibFullPath += L"sqlite3.dll";
+    m_SqliteLibrary.LoadFullPath( LibFullPath );
+
+    // Disable C4191 - unsafe conversion from 'type of expression' to 'type required'
+    #pragma warning( push )
+    #pragma warning( disable : 4191 )
+    m_pfnBindInt64  = (LPFN_SQLITE3_BIND_INT64)m_SqliteLibrary.ProcAddress( "sqlite3_bind_int64" );
+    m_pfnBindNull   = (LPFN_SQLITE3_BIND_NULL)m_SqliteLibrary.ProcAddress( "sqlite3_bind_null" );
+    m_pfnBindText16 = (LPFN_SQLITE3_BIND_TEXT16)m_SqliteLibrary.ProcAddress(
+                                                                        "sqlite3_bind_text16" );
+    m_pfnBusyTimeout = (LPFN_SQLITE3_BUSY_TIMEOUT)m_SqliteLibrary.ProcAddress(
+                                                                        "sqlite3_busy_timeout" );
+    m_pfnClose       = (LPFN_SQLITE3_CLOSE)m_SqliteLibrary.ProcAddress( "sqlite3_close" );
+    m_pfnColumnInt64 = (LPFN_SQLITE3_COLUMN_INT64)m_SqliteLibrary.ProcAddress(
+                                                                        "sqlite3_column_int64" );
+    m_pfnErrMsg16    = (LPFN_SQLITE3_ERRMSG16)m_SqliteLibrary.ProcAddress( "sqlite3_errmsg16" );
+    m_pfnFinalize    = (LPFN_SQLITE3_FINALIZE)m_SqliteLibrary.ProcAddress( "sqlite3_finalize" );
+    m_pfnLastInsertRowID = (LPFN_SQLITE3_LAST_INSERT_ROWID)m_SqliteLibrary.ProcAddress(
+                                                                    "sqlite3_last_insert_rowid" );
+    m_pfnPrepare16   = (LPFN_SQLITE3_PREPARE16_V2)m_SqliteLibrary.ProcAddress(
+                                                                        "sqlite3_prepare16_v2" );
+    m_pfnReset       = (LPFN_SQLITE3_RESET)m_SqliteLibrary.ProcAddress( "sqlite3_reset" );
+    m_pfnStep        = (LPFN_SQLITE3_STEP)m_SqliteLibrary.ProcAddress( "sqlite3_step" );
+
+    // Last so that it is only set when all the others are
+    m_pfnOpen16      = (LPFN_SQLITE3_OPEN16)m_SqliteLibrary.ProcAddress( "sqlite3_open16" );
+    #pragma warning( pop )
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the Audit_Value identifiers of the distinct values of an audit
+//
+//  Parameters:
+//      AuditRecords - the records
+//      DistinctRefs - the distinct values as record index * NUM_AUDIT_DATA_ITEMS
+//                     + item index
+//      numDistinct  - number of distinct values in DistinctRefs
+//      pValueIDs    - receives the identifiers in DistinctRefs order
+//
+//  Remarks:
+//      A value not in the dictionary is added to it. The statements are
+//      prepared once and reset for each value.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void SqliteDatabase::LookupValueIDs( const TArray< AuditRecord >& AuditRecords,
+                                     const TArray< size_t >& DistinctRefs,
+                                     size_t numDistinct, TArray< __int64 >* pValueIDs )
+{
+    size_t  i = 0, ref = 0, index = 0, numChars = 0;
+    __int64 hash = 0, valueID = 0;
+    LPCWSTR pszValue = nullptr;
+    sqlite3_stmt* pSelect = nullptr;
+    sqlite3_stmt* pInsert = nullptr;
+
+    if ( pValueIDs == nullptr )
+    {
+        throw ParameterException( L"pValueIDs", __FUNCTION__ );
+    }
+    pValueIDs->SetSize( numDistinct );
+    if ( numDistinct == 0 )
+    {
+        return;
+    }
+
+    pSelect = Prepare( L"SELECT Value_ID FROM Audit_Value "
+                       L"WHERE Value_Hash = ? AND Value_Text = ?" );
+    try
+    {
+        pInsert = Prepare( L"INSERT INTO Audit_Value ( Value_Hash, Value_Text ) VALUES ( ?, ? )" );
+        for ( i = 0; i < numDistinct; i++ )
+        {
+            ref      = DistinctRefs.Get( i );
+            index    = ref % NUM_AUDIT_DATA_ITEMS;
+            const AuditRecord& Record = AuditRecords.Get( ref / NUM_AUDIT_DATA_ITEMS );
+            pszValue = Record.GetValue( index );
+            numChars = PXSMinSizeT( Record.GetValueLength( index ), GetItemMaxChars( index ) );
+
+            // Stored in Value_Hash so the hash function must never change
+            hash = StringHashIndex::HashString( pszValue, numChars, true );
+
+            valueID = 0;
+            BindInt64( pSelect, 1, hash );
+            BindText( pSelect, 2, pszValue, numChars );
+            if ( Step( pSelect ) )
+            {
+                valueID = m_pfnColumnInt64( pSelect, 0 );
+            }
+            m_pfnReset( pSelect );
+
+            if ( valueID == 0 )
+            {
+                BindInt64( pInsert, 1, hash );
+                BindText( pInsert, 2, pszValue, numChars );
+                Step( pInsert );
+                m_pfnReset( pInsert );
+                valueID = m_pfnLastInsertRowID( m_pDatabase );
+            }
+            pValueIDs->Set( i, valueID );
+        }
+    }
+    catch ( const Exception& )
+    {
+        Finalize( pInsert );
+        Finalize( pSelect );
+        throw;
+    }
+    Finalize( pInsert );
+    Finalize( pSelect );
+}
+
+//===============================================================================================//
+//  Description:
+//      Prepare an SQL statement
+//
+//  Parameters:
+//      pszSql - the statement
+//
+//  Remarks:
+//      Caller must finalise the returned statement
+//
+//  Returns:
+//      Pointer to the statement
+//===============================================================================================//
+sqlite3_stmt* SqliteDatabase::Prepare( LPCWSTR pszSql )
+{
+    int result = 0;
+    sqlite3_stmt* pStmt = nullptr;
+
+    if ( m_pDatabase == nullptr )
+    {
+        throw FunctionException( L"m_pDatabase", __FUNCTION__ );
+    }
+
+    if ( ( pszSql == nullptr ) || ( *pszSql == PXS_CHAR_NULL ) )
+    {
+        throw ParameterException( L"pszSql", __FUNCTION__ );
+    }
+
+    result = m_pfnPrepare16( m_pDatabase, pszSql, -1, &pStmt, nullptr );
+    if ( ( result != RESULT_OK ) || ( pStmt == nullptr ) )
+    {
+        Finalize( pStmt );
+        ThrowSqliteError( result, pszSql, __FUNCTION__ );
+    }
+
+    return pStmt;
+}
+
+//===============================================================================================//
+//  Description:
+//      Make an audit the computer's last audit
+//
+//  Parameters:
+//      computerID - the computer identifier
+//      auditID    - the audit identifier
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void SqliteDatabase::SetLastAuditID( __int64 computerID, __int64 auditID )
+{
+    sqlite3_stmt* pStmt = nullptr;
+
+    pStmt = Prepare( L"UPDATE Computer_Master SET Last_Audit_ID = ? WHERE Computer_ID = ?" );
+    try
+    {
+        BindInt64( pStmt, 1, auditID );
+        BindInt64( pStmt, 2, computerID );
+        Step( pStmt );
+    }
+    catch ( const Exception& )
+    {
+        Finalize( pStmt );
+        throw;
+    }
+    Finalize( pStmt );
+}
+
+//===============================================================================================//
+//  Description:
+//      Evaluate a prepared statement
+//
+//  Parameters:
+//      pStmt - the statement
+//
+//  Returns:
+//      true if there is a row of data, false if the statement is done
+//===============================================================================================//
+bool SqliteDatabase::Step( sqlite3_stmt* pStmt )
+{
+    int result = m_pfnStep( pStmt );
+
+    if ( result == RESULT_ROW )
+    {
+        return true;
+    }
+
+    if ( result != RESULT_DONE )
+    {
+        ThrowSqliteError( result, L"sqlite3_step", __FUNCTION__ );
+    }
+
+    return false;
+}
+
+//===============================================================================================//
+//  Description:
+//      Throw an exception for a SQLite error
+//
+//  Parameters:
+//      result      - the SQLite result code
+//      pszDetails  - optional details, e.g. the SQL
+//      pszFunction - the function where the error occurred
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void SqliteDatabase::ThrowSqliteError( int result, LPCWSTR pszDetails, const char* pszFunction )
+{
+    String    ErrorMessage;
+    Formatter Format;
+
+    ErrorMessage  = L"SQLite error ";
+    ErrorMessage += Format.Int32( result );
+    if ( m_pDatabase && m_pfnErrMsg16 )
+    {
+        ErrorMessage += L": ";
+        ErrorMessage += static_cast<LPCWSTR>( m_pfnErrMsg16( m_pDatabase ) );
+    }
+
+    if ( pszDetails )
+    {
+        ErrorMessage += L"\r\n\r\n";
+        ErrorMessage += pszDetails;
+    }
+    throw Exception( PXS_ERROR_TYPE_APPLICATION,
+                     PXS_ERROR_DB_OPERATION_FAILED, ErrorMessage.c_str(), pszFunction );
+}
@@ -520,8 +520,9 @@ void TcpIpInformation::GetAdaptersRecords6( TArray< AuditRecord >* pRecords )
                 Name.Zero();
                 WMIAdapter.Get( L"Name", &Name );
 
+                // Connect re-uses the connection made for a previous adapter
                 WMILinkSpeed.Connect( L"root\\wmi" );
-                Query  = L"Select * from MSNdis_LinkSpeed WHERE InstanceName=\"";
+                Query  = L"Select NdisLinkSpeed from MSNdis_LinkSpeed WHERE InstanceName=\"";
                 Query += Name;
                 Query += L"\"";
                 WMILinkSpeed.ExecQuery( Query.c_str() );
@@ -532,7 +533,7 @@ void TcpIpInformation::GetAdaptersRecords6( TArray< AuditRecord >* pRecords )
                     Value  = Format.UInt32( linkSpeedMbps / 10000 );
                     Value += LocaleMbs;
                 }
-                WMILinkSpeed.Disconnect();
+                WMILinkSpeed.CloseQuery();
             }
             Record.Add( PXS_NET_ADAPT_CONNECT_MBPS, Value );
 
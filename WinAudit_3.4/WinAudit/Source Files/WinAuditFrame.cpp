@@ -62,12 +62,17 @@
 
 // 5. This Project
 #include "WinAudit/Header Files/AuditData.h"
+#include "WinAudit/Header Files/AuditFileIngester.h"
+#include "WinAudit/Header Files/CollectorThread.h"
 #include "WinAudit/Header Files/CpuInformation.h"
+#include "WinAudit/Header Files/DiskDataDecoder.h"
 #include "WinAudit/Header Files/DiskInformation.h"
 #include "WinAudit/Header Files/DisplayInformation.h"
+#include "WinAudit/Header Files/EdidDecoder.h"
 #include "WinAudit/Header Files/OdbcExportDialog.h"
 #include "WinAudit/Header Files/Resources.h"
 #include "WinAudit/Header Files/SecurityInformation.h"
+#include "WinAudit/Header Files/SmbiosBatchDecoder.h"
 #include "WinAudit/Header Files/SoftwareInformation.h"
 #include "WinAudit/Header Files/TcpIpInformation.h"
 #include "WinAudit/Header Files/WinAuditConfigDialog.h"
@@ -101,6 +106,7 @@ WinAuditFrame::WinAuditFrame()
                m_AuditThread(),
                m_ConfigurationSettings(),
                m_AuditRecords(),
+               m_AuditTableOffsets(),
                m_bRunAuditThreadMT( FALSE ),
                m_uAuditPercentDoneMT( 0 ),
                m_AuditThreadParameterMT(),
@@ -331,6 +337,7 @@ void WinAuditFrame::AuditStart()
     m_AuditRichBox.SetText( EmptyString );
     m_AuditCategories.ClearList();
     m_AuditRecords.RemoveAll();
+    m_AuditTableOffsets.RemoveAll();
     Repaint();
 
     // Document header
@@ -419,6 +426,7 @@ void WinAuditFrame::AuditThreadUpdate()
     AuditRecord  Record;
     TreeViewItem CategoryItem;
     TArray< Exception >    ThreadExceptions;
+    TArray< size_t >       TitleOffsets;
     TArray< AuditRecord >  NewAuditRecords;
     TArray< TreeViewItem > CategoryItems;
 
@@ -452,7 +460,9 @@ void WinAuditFrame::AuditThreadUpdate()
     {
         PXSLogAppInfo1( L"Worker posted %%1 audit record(s).", Format.SizeT( numElements ) );
     }
-    PXSAuditRecordsToContent( NewAuditRecords, &CategoryItems, &m_uTableCounter, &RichText );
+    DWORD firstTable = m_uTableCounter;
+    PXSAuditRecordsToContent( NewAuditRecords,
+                              &CategoryItems, &TitleOffsets, &m_uTableCounter, &RichText );
     if ( RichText.GetLength() )
     {
         m_bCreatedReport = true;
@@ -467,7 +477,7 @@ void WinAuditFrame::AuditThreadUpdate()
         CategoryItem = CategoryItems.Get( i );
         m_AuditCategories.AddItem( CategoryItem );
     }
-    m_AuditRichBox.AppendRichText( RichText );
+    AppendAuditContent( RichText, TitleOffsets, firstTable );
 
     if ( NewAuditRecords.GetSize() )
     {
@@ -1136,15 +1146,19 @@ void WinAuditFrame::CreateMenuItems()
 //===============================================================================================//
 void WinAuditFrame::DoAuditInCommandLineMode()
 {
-    DWORD  categoryID = 0;
-    size_t i = 0, numSwitches, numCategories;
+    DWORD  categoryID = 0, intervalSecs = 0, retainCount = 0, retainDays = 0, batchSize = 0;
+    size_t i = 0, j = 0, numSwitches, numCategories, numGroups, colon;
     String CommandLine, FileSwitchValue, ReportSwitchValue, LogSwitchValue;
     String TimestampSwitchValue, LanguageSwitchValue, LogPath, Switch, LocalTimeIso;
-    String OutputPath, LogDrive, LogDir, LogFname, LogExt;
+    String OutputPath, LogDrive, LogDir, LogFname, LogExt, EdidSwitchValue, SmbiosSwitchValue;
+    String DiskSwitchValue, DiskTranslations, IngestSwitchValue, LayoutSwitchValue;
+    String ScheduleSwitchValue, Group, Letters, Minutes, PurgeSwitchValue;
+    File        OutputFile;
     AuditData   Auditor;
     Formatter   Format;
     Directory   DirObject;
-    StringArray Switches;
+    StringArray Switches, Groups, Policy;
+    CollectorThread Collector;
     TArray< DWORD > Categories;
     TArray< AuditRecord > AuditRecords, CategoryRecords;
 
@@ -1169,7 +1183,14 @@ void WinAuditFrame::DoAuditInCommandLineMode()
     PXSGetCommandLineSwitchValues( Switches,
                                    &ReportSwitchValue,
                                    &FileSwitchValue,
-                                   &LogSwitchValue, &TimestampSwitchValue, &LanguageSwitchValue );
+                                   &LogSwitchValue,
+                                   &TimestampSwitchValue,
+                                   &LanguageSwitchValue,
+                                   &EdidSwitchValue,
+                                   &SmbiosSwitchValue,
+                                   &DiskSwitchValue,
+                                   &IngestSwitchValue,
+                                   &LayoutSwitchValue, &ScheduleSwitchValue, &PurgeSwitchValue );
 
     // Start logging to a file
     if ( LogSwitchValue.GetLength() )
@@ -1202,6 +1223,171 @@ void WinAuditFrame::DoAuditInCommandLineMode()
     // Do the audit
     PXSLogAppInfo1( L"Command Line: '%%1' ", CommandLine );
     LocalTimeIso = Format.LocalTimeInIsoFormat();  // YYYY-MM-DD HH:MM:SS
+
+    // The layout only applies to the database made by /I=, anything else
+    // would silently give the wide layout
+    if ( LayoutSwitchValue.GetLength() )
+    {
+        if ( LayoutSwitchValue.CompareI( L"eav" ) != 0 )
+        {
+            PXSLogAppError1( L"Unknown audit data layout '%%1', see the /A= switch.",
+                             LayoutSwitchValue );
+            return;
+        }
+
+        if ( IngestSwitchValue.IsEmpty() )
+        {
+            PXSLogAppError( L"The /A= switch can only be used with the /I= switch." );
+            return;
+        }
+    }
+
+    // Decoding saved EDID dumps replaces the audit of this computer. Not a
+    // database or CSV2 file as the monitors are not this computer's
+    if ( EdidSwitchValue.GetLength() )
+    {
+        if ( PXSIsDatabaseOutputPath( FileSwitchValue ) )
+        {
+            PXSLogAppError( L"EDID dumps cannot be sent to a database or a CSV2 file." );
+            return;
+        }
+        EdidDecoder::DecodeDirectory( EdidSwitchValue, &AuditRecords );
+        PXSMakeCommandLineOutputPath( FileSwitchValue,
+                                      TimestampSwitchValue, LocalTimeIso, &OutputPath );
+        PXSSaveAuditCommandLine( OutputPath, AuditRecords );
+        return;
+    }
+
+    // Likewise for SMBIOS dumps, these are saved one file per dump
+    if ( SmbiosSwitchValue.GetLength() )
+    {
+        SmbiosBatchDecoder::DecodeDirectory( SmbiosSwitchValue, FileSwitchValue );
+        return;
+    }
+
+    // Captured disk data blocks, a .txt output file gets the translation. Not
+    // a database or CSV2 file as the disks are not this computer's
+    if ( DiskSwitchValue.GetLength() )
+    {
+        if ( PXSIsDatabaseOutputPath( FileSwitchValue ) )
+        {
+            PXSLogAppError( L"Disk data blocks cannot be sent to a database or a CSV2 file." );
+            return;
+        }
+        DiskDataDecoder::DecodeDirectory( DiskSwitchValue, &AuditRecords, &DiskTranslations );
+        PXSMakeCommandLineOutputPath( FileSwitchValue,
+                                      TimestampSwitchValue, LocalTimeIso, &OutputPath );
+        if ( OutputPath.EndsWithStringI( L".txt" ) )
+        {
+            OutputFile.CreateNew( OutputPath, 0, true );     // Unicode
+            OutputFile.WriteChars( DiskTranslations );
+        }
+        else
+        {
+            PXSSaveAuditCommandLine( OutputPath, AuditRecords );
+        }
+        return;
+    }
+
+    // Audit files written by other computers, /f= names the database
+    if ( IngestSwitchValue.GetLength() )
+    {
+        AuditFileIngester::IngestDirectory( IngestSwitchValue,
+                                            FileSwitchValue,
+                                            LayoutSwitchValue.CompareI( L"eav" ) == 0 );
+        return;
+    }
+
+    // Delete old audits from the /f= database, the value is
+    // keep_count[:days[:batch_size]]
+    if ( PurgeSwitchValue.GetLength() )
+    {
+        retainDays = PXS_DB_RETAIN_DAYS_DEFAULT;
+        batchSize  = PXS_DB_PURGE_BATCH_DEFAULT;
+        PurgeSwitchValue.ToArray( ':', &Policy );
+        retainCount = Format.StringToUInt32( Policy.Get( 0 ) );
+        if ( Policy.GetSize() > 1 )
+        {
+            retainDays = Format.StringToUInt32( Policy.Get( 1 ) );
+        }
+        if ( Policy.GetSize() > 2 )
+        {
+            batchSize = Format.StringToUInt32( Policy.Get( 2 ) );
+        }
+
+        if ( ( Policy.GetSize() > 3 ) ||
+             ( retainCount < PXS_DB_RETAIN_AUDITS_MIN ) ||
+             ( retainCount > PXS_DB_RETAIN_AUDITS_MAX ) ||
+             ( retainDays  > PXS_DB_RETAIN_DAYS_MAX   ) ||
+             ( batchSize   < PXS_DB_PURGE_BATCH_MIN   ) ||
+             ( batchSize   > PXS_DB_PURGE_BATCH_MAX   )  )
+        {
+            PXSLogAppError1( L"Invalid retention policy '%%1', see the /K= switch.",
+                             PurgeSwitchValue );
+            return;
+        }
+
+        if ( ( PXSIsDatabaseOutputPath( FileSwitchValue ) == false ) ||
+             FileSwitchValue.EndsWithStringI( L".csv2" ) )
+        {
+            PXSLogAppError( L"The /K= switch needs a database in the /f= switch." );
+            return;
+        }
+        PXSPurgeOldAuditsCommandLine( FileSwitchValue, retainCount, retainDays, batchSize );
+        return;
+    }
+
+    // Stay resident re-auditing categories on their own schedules, the
+    // value is report_letters:minutes groups separated by commas
+    if ( ScheduleSwitchValue.GetLength() )
+    {
+        if ( ScheduleSwitchValue.CompareI( L"stop" ) == 0 )
+        {
+            CollectorThread::SignalStop();
+            return;
+        }
+
+        ScheduleSwitchValue.ToArray( ',', &Groups );
+        numGroups = Groups.GetSize();
+        for ( i = 0; i < numGroups; i++ )
+        {
+            Group = Groups.Get( i );
+            Group.Trim();
+            colon = Group.IndexOf( ':', 0 );
+            if ( colon == PXS_MINUS_ONE )
+            {
+                PXSLogAppError1( L"Schedule '%%1' has no interval in minutes.", Group );
+                return;
+            }
+            Group.SubString( 0, colon, &Letters );
+            Group.SubString( colon + 1, PXS_MINUS_ONE, &Minutes );
+            Minutes.Trim();
+            intervalSecs = PXSMultiplyUInt32( Format.StringToUInt32( Minutes ), 60 );
+            if ( intervalSecs < CollectorThread::MIN_INTERVAL_SECS )
+            {
+                PXSLogAppError1( L"Schedule '%%1' must be at least one minute.", Group );
+                return;
+            }
+
+            // Categories in more than one group keep the shortest interval
+            SetReportOptions( Letters );
+            m_ConfigurationSettings.MakeDataCategoriesArray( &Categories );
+            for ( j = 0; j < Categories.GetSize(); j++ )
+            {
+                Collector.AddSchedule( Categories.Get( j ), intervalSecs );
+            }
+        }
+
+        if ( Collector.GetNumberOfSchedules() == 0 )
+        {
+            PXSLogAppError( L"No categories were scheduled, see the /P= switch." );
+            return;
+        }
+        Collector.SetSink( FileSwitchValue, TimestampSwitchValue );
+        Collector.WaitForStop();
+        return;
+    }
+
     SetReportOptions( ReportSwitchValue );
     m_ConfigurationSettings.MakeDataCategoriesArray( &Categories );
     numCategories = Categories.GetSize();
@@ -1227,6 +1413,7 @@ void WinAuditFrame::DoAuditInCommandLineMode()
             PXSLogException( e, __FUNCTION__ );
         }
     }
+    Auditor.LogCacheStatistics();
 
     // Save it
     PXSMakeCommandLineOutputPath( FileSwitchValue,
@@ -1510,6 +1697,32 @@ void WinAuditFrame::ReadIniFile()
                         m_ConfigurationSettings.reportMaxRecords = dword;
                     }
                 }
+                else if ( Name.CompareI( L"retainAuditCount" ) == 0 )
+                {
+                    dword = wcstoul( Value.c_str(), &endptr, 10 );
+                    if ( ( dword >= PXS_DB_RETAIN_AUDITS_MIN ) &&
+                         ( dword <= PXS_DB_RETAIN_AUDITS_MAX ) )
+                    {
+                        m_ConfigurationSettings.retainAuditCount = dword;
+                    }
+                }
+                else if ( Name.CompareI( L"retainAuditDays" ) == 0 )
+                {
+                    dword = wcstoul( Value.c_str(), &endptr, 10 );
+                    if ( dword <= PXS_DB_RETAIN_DAYS_MAX )
+                    {
+                        m_ConfigurationSettings.retainAuditDays = dword;
+                    }
+                }
+                else if ( Name.CompareI( L"purgeBatchSize" ) == 0 )
+                {
+                    dword = wcstoul( Value.c_str(), &endptr, 10 );
+                    if ( ( dword >= PXS_DB_PURGE_BATCH_MIN ) &&
+                         ( dword <= PXS_DB_PURGE_BATCH_MAX ) )
+                    {
+                        m_ConfigurationSettings.purgeBatchSize = dword;
+                    }
+                }
                 else if ( Name.CompareI( L"DBMS" ) == 0 )
                 {
                     m_ConfigurationSettings.DBMS = Value;
@@ -2124,7 +2337,8 @@ void WinAuditFrame::CopyDataEvent( HWND hWnd, const COPYDATASTRUCT* pCds )
     if ( hWnd == m_AuditCategories.GetHwnd() )
     {
         m_TabWindow.SetSelectedTabID( m_auditTabID );
-        if ( m_AuditRichBox.FindText( Bookmark, true, true, true ) == false )
+        if ( ( FindAuditTable( Bookmark ) == false ) &&
+             ( m_AuditRichBox.FindText( Bookmark, true, true, true ) == false ) )
         {
             PXSLogAppWarn1( L"Audit bookmark '%%1' not found.", Bookmark );
         }
@@ -2235,6 +2449,61 @@ void WinAuditFrame::SettingChangeEvent()
 // Private Methods
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+//===============================================================================================//
+//  Description:
+//      Append new audit content to the report, noting where each table starts
+//
+//  Parameters:
+//      RichText     - the rich text made by PXSAuditRecordsToContent
+//      TitleOffsets - offsets of the table titles in RichText
+//      firstTable   - the table counter before RichText was made
+//
+//  Remarks:
+//      Each table is appended as its own document so that the control can
+//      report its character position. The text before the first title is the
+//      document start and the last character is the document end.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void WinAuditFrame::AppendAuditContent( const String& RichText,
+                                        const TArray< size_t >& TitleOffsets,
+                                        DWORD firstTable )
+{
+    size_t i = 0, start = 0, end = 0, numTitles = 0;
+    LONG   position = 0;
+    String DocumentStart, TableText, Document;
+
+    numTitles = TitleOffsets.GetSize();
+    if ( ( numTitles == 0 ) || ( RichText.GetLength() == 0 ) )
+    {
+        m_AuditRichBox.AppendRichText( RichText );
+        return;
+    }
+    RichText.SubString( 0, TitleOffsets.Get( 0 ), &DocumentStart );
+    m_AuditTableOffsets.SetSize( PXSAddSizeT( firstTable, numTitles ) );
+
+    for ( i = 0; i < numTitles; i++ )
+    {
+        start = TitleOffsets.Get( i );
+        end   = RichText.GetLength() - 1;     // Exclude the document end
+        if ( ( i + 1 ) < numTitles )
+        {
+            end = TitleOffsets.Get( i + 1 );
+        }
+        TableText = PXS_STRING_EMPTY;
+        if ( end > start )
+        {
+            RichText.SubString( start, end - start, &TableText );
+        }
+        Document  = DocumentStart;
+        Document += TableText;
+        Document += L"}";
+        position  = m_AuditRichBox.AppendRichText( Document );
+        m_AuditTableOffsets.Set( PXSAddSizeT( firstTable, i ), position );
+    }
+}
+
 //===============================================================================================//
 //  Description:
 //      Create the menu items
@@ -2382,6 +2651,49 @@ void WinAuditFrame::FillHelpContents()
     }
 }
 
+//===============================================================================================//
+//  Description:
+//     Go to the table in the audit report for the specified bookmark
+//
+//  Parameters:
+//      Bookmark - the bookmark, of the form "N) Title"
+//
+//  Remarks:
+//      Uses the table number to look up where the table starts rather than
+//      searching the whole report, this also avoids selecting an earlier
+//      occurrence of the same text.
+//
+//  Returns:
+//      true if found the table, otherwise false
+//===============================================================================================//
+bool WinAuditFrame::FindAuditTable( const String& Bookmark )
+{
+    wchar_t ch     = PXS_CHAR_NULL;
+    size_t  i      = 0, length = Bookmark.GetLength();
+    DWORD   tableNumber = 0;
+
+    // Table number, no more than 9 digits so cannot overflow
+    while ( ( i < length ) && ( i < 9 ) )
+    {
+        ch = Bookmark.CharAt( i );
+        if ( ( ch < '0' ) || ( ch > '9' ) )
+        {
+            break;
+        }
+        tableNumber = ( 10 * tableNumber ) + static_cast<DWORD>( ch - '0' );
+        i++;
+    }
+
+    if ( ( ch != ')' ) ||
+         ( tableNumber == 0 ) || ( tableNumber > m_AuditTableOffsets.GetSize() ) )
+    {
+        return false;
+    }
+
+    return m_AuditRichBox.FindTextFrom( Bookmark,
+                                        true, m_AuditTableOffsets.Get( tableNumber - 1 ) );
+}
+
 //===============================================================================================//
 //  Description:
 //     Find the text shown on the Find Text Bar in the currently selected tab
@@ -2758,7 +3070,8 @@ void WinAuditFrame::SaveToFile( DWORD tabID, DWORD dataFormat, const String& Fil
             {
                 OutputFilePath += L".rtf";
             }
-            PXSAuditRecordsToContent( m_AuditRecords, &CategoryItems, &tableCounter, &DataString );
+            PXSAuditRecordsToContent( m_AuditRecords,
+                                      &CategoryItems, nullptr, &tableCounter, &DataString );
             numChars = DataString.GetAnsiMultiByteLength();
             pszAnsi  = AnsiChars.New( numChars );
             Format.StringToAnsi( DataString, pszAnsi, numChars );
@@ -3826,7 +4139,11 @@ void WinAuditFrame::ShowCommandLineHelpMessage()
     Help  = L"WinAudit command line usage:";
     Help += PXS_STRING_CRLF;
     Help += PXS_STRING_CRLF;
-    Help += L"WinAudit /h /r=report /f=file /l=log_file /T=timestamp /L=en";
+    Help += L"WinAudit /h /r=report /f=file /l=log_file /T=timestamp /L=en /E=edid_directory";
+    Help += PXS_STRING_CRLF;
+    Help += L"         /S=smbios_directory /D=disk_directory /I=ingest_directory /A=layout";
+    Help += PXS_STRING_CRLF;
+    Help += L"         /P=schedule /K=retention";
     Help += PXS_STRING_CRLF;
     Help += PXS_STRING_CRLF;
     Help += L"/h\tShow this help message then exit";
@@ -3837,16 +4154,36 @@ void WinAuditFrame::ShowCommandLineHelpMessage()
     Help += PXS_STRING_CRLF;
     Help += L"/f\tFile name for output or database connection string";
     Help += PXS_STRING_CRLF;
+    Help += L"\tA .db or .sqlite file name exports to a SQLite database";
+    Help += PXS_STRING_CRLF;
     Help += L"/l\tLog file path";
     Help += PXS_STRING_CRLF;
     Help += L"/T\tTimestamp in output file name";
     Help += PXS_STRING_CRLF;
     Help += L"/L\tLocale strings forced to be in English, parameter must be 'en'";
     Help += PXS_STRING_CRLF;
+    Help += L"/E\tDecode the EDID files in a directory instead of auditing";
+    Help += PXS_STRING_CRLF;
+    Help += L"/S\tDecode the SMBIOS dumps in a directory, one output file each";
+    Help += PXS_STRING_CRLF;
+    Help += L"/D\tDecode the ATA and NVMe data blocks in a directory";
+    Help += PXS_STRING_CRLF;
+    Help += L"/I\tExport the CSV2 audit files in a directory to the /f database";
+    Help += PXS_STRING_CRLF;
+    Help += L"/A\tWith /I, the layout of a new SQLite database, 'eav' for a value dictionary";
+    Help += PXS_STRING_CRLF;
+    Help += L"/P\tStay resident re-auditing, e.g. 'N:5,XYZ:60' for report letters";
+    Help += PXS_STRING_CRLF;
+    Help += L"\tand minutes. Changed audits go to /f, use /P=stop to end";
+    Help += PXS_STRING_CRLF;
+    Help += L"/K\tDelete old audits from the /f database, e.g. '3:90:500' keeps each";
+    Help += PXS_STRING_CRLF;
+    Help += L"\tcomputer's last 3 and any newer than 90 days, 500 per transaction";
+    Help += PXS_STRING_CRLF;
 
     PXSGetApplicationName( &ApplicationName );
     Dialog.SetTitle( ApplicationName );
-    Dialog.SetSize( 550, 275 );
+    Dialog.SetSize( 550, 450 );
     Dialog.SetMessage( Help );
     Dialog.Create( m_hWindow );
 }
@@ -4480,6 +4817,18 @@ void WinAuditFrame::WriteIniFile()
     Content += Format.UInt32( m_ConfigurationSettings.reportMaxRecords );
     Content += PXS_STRING_CRLF;
 
+    Content += L"retainAuditCount=";
+    Content += Format.UInt32( m_ConfigurationSettings.retainAuditCount );
+    Content += PXS_STRING_CRLF;
+
+    Content += L"retainAuditDays=";
+    Content += Format.UInt32( m_ConfigurationSettings.retainAuditDays );
+    Content += PXS_STRING_CRLF;
+
+    Content += L"purgeBatchSize=";
+    Content += Format.UInt32( m_ConfigurationSettings.purgeBatchSize );
+    Content += PXS_STRING_CRLF;
+
     Content += L"DBMS=";
     Content += m_ConfigurationSettings.DBMS;
     Content += PXS_STRING_CRLF;
@@ -58,11 +58,13 @@
 
 // 5. This Project
 #include "WinAudit/Header Files/AuditData.h"
+#include "WinAudit/Header Files/AuditFileIngester.h"
 #include "WinAudit/Header Files/AuditDatabase.h"
 #include "WinAudit/Header Files/AuditRecord.h"
 #include "WinAudit/Header Files/OdbcExportDialog.h"
 #include "WinAudit/Header Files/Resources.h"
 #include "WinAudit/Header Files/SmbiosInformation.h"
+#include "WinAudit/Header Files/SqliteDatabase.h"
 #include "WinAudit/Header Files/TcpIpInformation.h"
 #include "WinAudit/Header Files/WinauditFrame.h"
 
@@ -81,17 +83,24 @@
 //  Parameters:
 //      AuditRecords   - the audit records
 //      pCategoryItems - receives the contents for the category tree view
+//      pTitleOffsets  - optional, receives the offset in pRichText of each
+//                       numbered table title, can be NULL
 //      pTableCounter  - receives the update count of tables in the rich text
 //      pRichText      - receives the rich text for the audit report
 //
 //  Remarks:
 //      8900 twips fits WordPad A4 with 1" left and right margins
 //
+//      There is one title offset for each increment of the table counter, so
+//      the offset of table N is at index N - 1 - (counter on entry). The
+//      rich text can be cut at these offsets into self-contained tables.
+//
 //  Returns:
 //      void
 //===============================================================================================//
 void PXSAuditRecordsToContent( const TArray< AuditRecord >&  AuditRecords,
                                TArray< TreeViewItem >* pCategoryItems,
+                               TArray< size_t >* pTitleOffsets,
                                DWORD* pTableCounter, String* pRichText )
 {
     const DWORD TABLE_WIDTH = 8900;
@@ -103,8 +112,6 @@ void PXSAuditRecordsToContent( const TArray< AuditRecord >&  AuditRecords,
     String HeaderCol_1, HeaderCol_2, RowEven_1, RowEven_2, RowOdd_1, RowOdd_2;
     String CategoryStringData;
     Formatter    Format;
-    StringArray  Values;
-    AuditRecord  Record;
     TreeViewItem Category;
 
     // Markup strings
@@ -152,6 +159,10 @@ void PXSAuditRecordsToContent( const TArray< AuditRecord >&  AuditRecords,
 
     // Guesstimate the memory, usually need about 4096 bytes per record
     pCategoryItems->RemoveAll();
+    if ( pTitleOffsets )
+    {
+        pTitleOffsets->RemoveAll();
+    }
     numRecords = AuditRecords.GetSize();
     pRichText->Allocate( numRecords * 4096 );
     *pRichText = PXS_STRING_EMPTY;
@@ -160,8 +171,8 @@ void PXSAuditRecordsToContent( const TArray< AuditRecord >&  AuditRecords,
     // Fill the tree view and rich text report
     for ( i = 0; i < numRecords; i++ )
     {
-        Record = AuditRecords.Get( i );
-        Record.GetCategoryIdAndValues( &categoryID, &Values );
+        const AuditRecord& Record = AuditRecords.Get( i );
+        categoryID = Record.GetCategoryID();
 
         // Category tree view
         if ( categoryID != previousCategoryID )
@@ -185,6 +196,10 @@ void PXSAuditRecordsToContent( const TArray< AuditRecord >&  AuditRecords,
             CategoryStringData = TableTitle;    // NB This does not need RTF escaping
 
             // Title - centred and bold
+            if ( pTitleOffsets )
+            {
+                pTitleOffsets->Add( pRichText->GetLength() );
+            }
             TableTitle.EscapeForRichText();
             *pRichText += L"\\par\\qc\\ul\\b ";
             *pRichText += TableTitle;
@@ -200,14 +215,14 @@ void PXSAuditRecordsToContent( const TArray< AuditRecord >&  AuditRecords,
         }
 
         // Message if no data, except for grouping categories
-        if ( ( Values.GetSize() == 0 ) && (categoryID > PXS_CATEGORY_INTERVAL) )
+        if ( ( Record.GetNumberOfValues() == 0 ) && (categoryID > PXS_CATEGORY_INTERVAL) )
         {
             *pRichText += L"\\par\\b No data available "
                           L"\\b0\\par\\par\\pard\r\n";
             *pRichText += Separator;
         }
 
-        size_t numValues = Values.GetSize();
+        size_t numValues = Record.GetNumberOfValues();
         if ( numValues )
         {
             if ( isColumnar )
@@ -223,6 +238,10 @@ void PXSAuditRecordsToContent( const TArray< AuditRecord >&  AuditRecords,
                         TableTitle   = Format.UInt32( *pTableCounter );
                         TableTitle  += L") ";
                         TableTitle  += LeafName;
+                        if ( pTitleOffsets )
+                        {
+                            pTitleOffsets->Add( pRichText->GetLength() );
+                        }
                     }
                     CategoryStringData = TableTitle;    // NB This does not need RTF escaping
 
@@ -254,7 +273,7 @@ void PXSAuditRecordsToContent( const TArray< AuditRecord >&  AuditRecords,
                 // Table rows
                 for ( size_t j = 0; j < numValues; j++ )
                 {
-                    Value = Values.Get( j );
+                    Value = Record.GetValue( j );
                     Value.EscapeForRichText();
                     DWORD itemID = PXSCastSizeTToUInt32( categoryID + j + 1 );
                     PXSGetAuditItemDisplayName( itemID, &ItemName );
@@ -330,7 +349,7 @@ void PXSAuditRecordsToContent( const TArray< AuditRecord >&  AuditRecords,
                 *pRichText += L"\\pard\\intbl\r\n";
                 for ( size_t j = 0; j < numValues; j++ )
                 {
-                    Value = Values.Get( j );
+                    Value = Record.GetValue( j );
                     Value.EscapeForRichText();
                     *pRichText += Value;
                     *pRichText += L" \\cell\r\n";
@@ -371,8 +390,6 @@ void PXSAuditRecordsToHtml( const TArray< AuditRecord >&  AuditRecords,
     String CategoryName, LeafName, ItemName, Value, TableTitle, HtmlBookmarks;
     String ResourceString, ComputerName, ApplicationName, DataString, ReportString;
     Formatter    Format;
-    StringArray  Values;
-    AuditRecord  Record;
     SystemInformation SystemInfo;
 
     // Markup strings
@@ -488,8 +505,8 @@ void PXSAuditRecordsToHtml( const TArray< AuditRecord >&  AuditRecords,
 
     for ( size_t i = 0; i < numRecords; i++ )
     {
-        Record = AuditRecords.Get( i );
-        Record.GetCategoryIdAndValues( &categoryID, &Values );
+        const AuditRecord& Record = AuditRecords.Get( i );
+        categoryID = Record.GetCategoryID();
 
         // Category tree view
         if ( categoryID != previousCategoryID )
@@ -533,13 +550,13 @@ void PXSAuditRecordsToHtml( const TArray< AuditRecord >&  AuditRecords,
         }
 
         // Message if no data, except for grouping categories
-        if ( ( Values.GetSize() == 0 ) && (categoryID > PXS_CATEGORY_INTERVAL) )
+        if ( ( Record.GetNumberOfValues() == 0 ) && (categoryID > PXS_CATEGORY_INTERVAL) )
         {
             ReportString += L"<center><b>No data available</b></center>\r\n";
             ReportString += STR_HR;
         }
 
-        size_t numValues = Values.GetSize();
+        size_t numValues = Record.GetNumberOfValues();
         if ( numValues )
         {
             if ( isColumnar )
@@ -586,7 +603,7 @@ void PXSAuditRecordsToHtml( const TArray< AuditRecord >&  AuditRecords,
                 // Table rows
                 for ( size_t j = 0; j < numValues; j++ )
                 {
-                    Value = Values.Get( j );
+                    Value = Record.GetValue( j );
                     Value.EscapeForHtml();
                     DWORD itemID = PXSCastSizeTToUInt32( categoryID + j + 1 );
                     PXSGetAuditItemDisplayName( itemID, &ItemName );
@@ -650,7 +667,7 @@ void PXSAuditRecordsToHtml( const TArray< AuditRecord >&  AuditRecords,
                 for ( size_t j = 0; j < numValues; j++ )
                 {
                     ReportString += L"<td>";
-                    Value = Values.Get( j );
+                    Value = Record.GetValue( j );
                     Value.EscapeForHtml();
                     if ( Value.GetLength() )
                     {
@@ -729,8 +746,6 @@ void PXSAuditRecordsToCsv( const TArray< AuditRecord >&  AuditRecords,
     DWORD  categoryID = 0, previousCategoryID = 0, captionID = 0;
     String Value, CsvLine, CategoryName, ItemName;
     Formatter    Format;
-    StringArray  Values;
-    AuditRecord  Record;
 
     if ( pCsvText == nullptr )
     {
@@ -744,8 +759,8 @@ void PXSAuditRecordsToCsv( const TArray< AuditRecord >&  AuditRecords,
     CsvLine.Allocate( 1024 );
     for ( size_t i = 0; i < numRecords; i++ )
     {
-        Record = AuditRecords.Get( i );
-        Record.GetCategoryIdAndValues( &categoryID, &Values );
+        const AuditRecord& Record = AuditRecords.Get( i );
+        categoryID = Record.GetCategoryID();
 
         // Make header row
         if ( categoryID != previousCategoryID )
@@ -760,7 +775,7 @@ void PXSAuditRecordsToCsv( const TArray< AuditRecord >&  AuditRecords,
                 CsvLine  = PXS_CHAR_QUOTE;
                 CsvLine += CategoryName;
                 CsvLine += PXS_CHAR_QUOTE;
-                size_t numValues = Values.GetSize();
+                size_t numValues = Record.GetNumberOfValues();
                 for ( size_t j = 0; j < numValues; j++ )
                 {
                     DWORD itemID = PXSCastSizeTToUInt32( categoryID + j + 1 );
@@ -784,11 +799,11 @@ void PXSAuditRecordsToCsv( const TArray< AuditRecord >&  AuditRecords,
         CsvLine += PXS_CHAR_QUOTE;
         CsvLine += CategoryName;
         CsvLine += PXS_CHAR_QUOTE;
-        size_t numValues = Values.GetSize();
+        size_t numValues = Record.GetNumberOfValues();
         for ( size_t j = 0; j < numValues; j++ )
         {
             // Escape any quotes then quote the value
-            Value = Values.Get( j );
+            Value = Record.GetValue( j );
             Value.ReplaceChar( PXS_CHAR_TAB, PXS_CHAR_SPACE );
             Value.ReplaceChar( PXS_CHAR_QUOTE, L"\"\"" );
             CsvLine += PXS_CHAR_COMMA;
@@ -822,8 +837,6 @@ void PXSAuditRecordsToCsv2( const TArray< AuditRecord >&  AuditRecords,
     DWORD  categoryID = 0, previousCategoryID = 0, captionID = 0, itemOrder = 0;
     String Value, CsvLine, CategoryName, ItemName;
     Formatter    Format;
-    StringArray  Values;
-    AuditRecord  Record;
 
     if ( pCsvText == nullptr )
     {
@@ -843,8 +856,8 @@ void PXSAuditRecordsToCsv2( const TArray< AuditRecord >&  AuditRecords,
     CsvLine.Allocate( 1024 );
     for ( size_t i = 0; i < numRecords; i++ )
     {
-        Record = AuditRecords.Get( i );
-        Record.GetCategoryIdAndValues( &categoryID, &Values );
+        const AuditRecord& Record = AuditRecords.Get( i );
+        categoryID = Record.GetCategoryID();
 
         if ( categoryID != previousCategoryID )
         {
@@ -856,7 +869,7 @@ void PXSAuditRecordsToCsv2( const TArray< AuditRecord >&  AuditRecords,
         }
 
         // Make the data rows
-        size_t numValues = Values.GetSize();
+        size_t numValues = Record.GetNumberOfValues();
         for ( size_t j = 0; j < numValues; j++ )
         {
             // ItemOrder
@@ -893,7 +906,7 @@ void PXSAuditRecordsToCsv2( const TArray< AuditRecord >&  AuditRecords,
             CsvLine += PXS_CHAR_COMMA;
 
             // ItemValue
-            Value = Values.Get( j );
+            Value = Record.GetValue( j );
             Value.ReplaceChar( PXS_CHAR_TAB, PXS_CHAR_SPACE );
             Value.ReplaceChar( PXS_CHAR_QUOTE, L"\"\"" );
             CsvLine += PXS_CHAR_QUOTE;
@@ -952,50 +965,6 @@ int PXSBSearchCompareAuditItems( const void* pItem1, const void* pItem2 )
     return nReturn;
 }
 
-//===============================================================================================//
-//  Description:
-//     bsearch comparison function for array of type PXS_TYPE_PORT_SERVICE
-//
-//  Parameters:
-//      pPort1 - pointer to the first port service
-//      pPort2 - pointer to the second port service
-//
-//  Returns:
-//      < 0 pPort1 less than pPort2
-//      = 0 pPort1 equal to pPort2
-//      > 0 pPort1 greater than pPort2
-//===============================================================================================//
-int PXSBSearchComparePortServices( const void* pPort1, const void* pPort2 )
-{
-    int nReturn = 0;
-    const PXS_TYPE_PORT_SERVICE* p1 = nullptr;
-    const PXS_TYPE_PORT_SERVICE* p2 = nullptr;
-
-    if ( pPort1 && pPort2 )
-    {
-        p1 = reinterpret_cast<const PXS_TYPE_PORT_SERVICE*>( pPort1 );
-        p2 = reinterpret_cast<const PXS_TYPE_PORT_SERVICE*>( pPort2 );
-        if ( p1->portID > p2->portID )
-        {
-            nReturn = 1;
-        }
-        else if ( p1->portID < p2->portID )
-        {
-             nReturn = -1;
-        }
-    }
-    else if ( pPort1 && ( pPort2 == nullptr ) )
-    {
-        nReturn = 1;
-    }
-    else if ( ( pPort1 == nullptr ) && pPort2 )
-    {
-        nReturn = -1;
-    }
-
-    return nReturn;
-}
-
 //===============================================================================================//
 //  Description:
 //      Get the name of an audit item for display purposes
@@ -1056,6 +1025,13 @@ void PXSGetAuditItemDisplayName( DWORD itemID, String* pDisplayName )
 //      pLogSwitchValue       - receives the /l= value
 //      pTimestampSwitchValue - receives the /T= value
 //      pLanguageSwitchValue  - receives the /L= value
+//      pEdidSwitchValue      - receives the /E= value
+//      pSmbiosSwitchValue    - receives the /S= value
+//      pDiskSwitchValue      - receives the /D= value
+//      pIngestSwitchValue    - receives the /I= value
+//      pLayoutSwitchValue    - receives the /A= value
+//      pScheduleSwitchValue  - receives the /P= value
+//      pPurgeSwitchValue     - receives the /K= value
 //
 //  Returns:
 //      void
@@ -1064,7 +1040,15 @@ void PXSGetCommandLineSwitchValues( const StringArray& Switches,
                                     String* pReportSwitchValue,
                                     String* pFileSwitchValue,
                                     String* pLogSwitchValue,
-                                    String* pTimestampSwitchValue, String* pLanguageSwitchValue )
+                                    String* pTimestampSwitchValue,
+                                    String* pLanguageSwitchValue,
+                                    String* pEdidSwitchValue,
+                                    String* pSmbiosSwitchValue,
+                                    String* pDiskSwitchValue,
+                                    String* pIngestSwitchValue,
+                                    String* pLayoutSwitchValue,
+                                    String* pScheduleSwitchValue,
+                                    String* pPurgeSwitchValue )
 {
     size_t i = 0;
     size_t numSwitches = Switches.GetSize();
@@ -1074,7 +1058,14 @@ void PXSGetCommandLineSwitchValues( const StringArray& Switches,
          ( pFileSwitchValue      == nullptr ) ||
          ( pLogSwitchValue       == nullptr ) ||
          ( pTimestampSwitchValue == nullptr ) ||
-         ( pLanguageSwitchValue  == nullptr )  )
+         ( pLanguageSwitchValue  == nullptr ) ||
+         ( pEdidSwitchValue      == nullptr ) ||
+         ( pSmbiosSwitchValue    == nullptr ) ||
+         ( pDiskSwitchValue      == nullptr ) ||
+         ( pIngestSwitchValue    == nullptr ) ||
+         ( pLayoutSwitchValue    == nullptr ) ||
+         ( pScheduleSwitchValue  == nullptr ) ||
+         ( pPurgeSwitchValue     == nullptr )  )
     {
         throw ParameterException( L"nullptr", __FUNCTION__ );
     }
@@ -1083,6 +1074,13 @@ void PXSGetCommandLineSwitchValues( const StringArray& Switches,
     *pLogSwitchValue       = PXS_STRING_EMPTY;
     *pTimestampSwitchValue = PXS_STRING_EMPTY;
     *pLanguageSwitchValue  = PXS_STRING_EMPTY;
+    *pEdidSwitchValue      = PXS_STRING_EMPTY;
+    *pSmbiosSwitchValue    = PXS_STRING_EMPTY;
+    *pDiskSwitchValue      = PXS_STRING_EMPTY;
+    *pIngestSwitchValue    = PXS_STRING_EMPTY;
+    *pLayoutSwitchValue    = PXS_STRING_EMPTY;
+    *pScheduleSwitchValue  = PXS_STRING_EMPTY;
+    *pPurgeSwitchValue     = PXS_STRING_EMPTY;
 
     // Identify the switches
     for ( i = 0; i < numSwitches; i++ )
@@ -1116,6 +1114,46 @@ void PXSGetCommandLineSwitchValues( const StringArray& Switches,
             Switch.SubString( 2, PXS_MINUS_ONE, pLanguageSwitchValue );
             pLanguageSwitchValue->Trim();
         }
+        else if ( Switch.StartsWith( L"E=", true ) )
+        {
+            Switch.SubString( 2, PXS_MINUS_ONE, pEdidSwitchValue );
+            PXSUnQuoteString( pEdidSwitchValue );
+            pEdidSwitchValue->Trim();
+        }
+        else if ( Switch.StartsWith( L"S=", true ) )
+        {
+            Switch.SubString( 2, PXS_MINUS_ONE, pSmbiosSwitchValue );
+            PXSUnQuoteString( pSmbiosSwitchValue );
+            pSmbiosSwitchValue->Trim();
+        }
+        else if ( Switch.StartsWith( L"D=", true ) )
+        {
+            Switch.SubString( 2, PXS_MINUS_ONE, pDiskSwitchValue );
+            PXSUnQuoteString( pDiskSwitchValue );
+            pDiskSwitchValue->Trim();
+        }
+        else if ( Switch.StartsWith( L"I=", true ) )
+        {
+            Switch.SubString( 2, PXS_MINUS_ONE, pIngestSwitchValue );
+            PXSUnQuoteString( pIngestSwitchValue );
+            pIngestSwitchValue->Trim();
+        }
+        else if ( Switch.StartsWith( L"A=", true ) )
+        {
+            Switch.SubString( 2, PXS_MINUS_ONE, pLayoutSwitchValue );
+            pLayoutSwitchValue->Trim();
+        }
+        else if ( Switch.StartsWith( L"P=", true ) )
+        {
+            Switch.SubString( 2, PXS_MINUS_ONE, pScheduleSwitchValue );
+            PXSUnQuoteString( pScheduleSwitchValue );
+            pScheduleSwitchValue->Trim();
+        }
+        else if ( Switch.StartsWith( L"K=", true ) )
+        {
+            Switch.SubString( 2, PXS_MINUS_ONE, pPurgeSwitchValue );
+            pPurgeSwitchValue->Trim();
+        }
     }
 }
 
@@ -1251,6 +1289,34 @@ void PXSGetWinAuditGuidFilePath( String* pFilePath )
     *pFilePath += PXS_WINAUDIT_GUID_TXT;
 }
 
+//===============================================================================================//
+//  Description:
+//      Determine if a /f= value sends the output to a database
+//
+//  Parameters:
+//      FileSwitchValue - /f= switch value
+//
+//  Remarks:
+//      A CSV2 file counts as it carries this computer's master records for
+//      ingesting into a database. The batch decoders refuse these outputs as
+//      their records are not this computer's.
+//
+//  Returns:
+//      true if a connection string, SQLite file or CSV2 file, otherwise false
+//===============================================================================================//
+bool PXSIsDatabaseOutputPath( const String& FileSwitchValue )
+{
+    if ( FileSwitchValue.StartsWith( L"DBQ="   , false ) ||
+         FileSwitchValue.StartsWith( L"DRIVER=", false ) ||
+         FileSwitchValue.EndsWithStringI( L".csv2" )     ||
+         SqliteDatabase::IsSqliteFilePath( FileSwitchValue ) )
+    {
+        return true;
+    }
+
+    return false;
+}
+
 //===============================================================================================//
 //  Description:
 //      Make the output path when in command line mode
@@ -1349,6 +1415,92 @@ void PXSMakeCommandLineOutputPath( const String& FileSwitchValue,
     *pOutputPath += FileName;
 }
 
+//===============================================================================================//
+//  Description:
+//      Delete the audits outside a retention policy when in command line mode
+//
+//  Parameters:
+//      FileSwitchValue - /f= value, an ODBC connection string or the path
+//                        of a SQLite database file
+//      retainCount     - the number of most recent audits to keep per computer
+//      retainDays      - keep audits newer than this many days, zero for no
+//                        age limit
+//      batchSize       - the number of audits deleted per transaction
+//
+//  Remarks:
+//      The same batches as the database administration dialog so an
+//      interrupted purge keeps what it has done and can be run again.
+//      Progress goes to the log.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void PXSPurgeOldAuditsCommandLine( const String& FileSwitchValue,
+                                   DWORD retainCount, DWORD retainDays, DWORD batchSize )
+{
+    bool       useSqlite    = false;
+    size_t     numOldAudits = 0, numDeleted = 0, totalDeleted = 0;
+    __int64    lastSqliteID = 0;
+    Formatter  Format;
+    SQLINTEGER lastAuditID  = 0;
+    AuditDatabase  Database;
+    SqliteDatabase SqliteDb;
+
+    useSqlite = SqliteDatabase::IsSqliteFilePath( FileSwitchValue );
+    if ( useSqlite )
+    {
+        // Do not create a database just to find it is empty
+        if ( File::Exists( FileSwitchValue ) == false )
+        {
+            throw SystemException( ERROR_FILE_NOT_FOUND, FileSwitchValue.c_str(), __FUNCTION__ );
+        }
+        SqliteDb.Open( FileSwitchValue, false );
+        numOldAudits = SqliteDb.CountOldAudits( retainCount, retainDays );
+    }
+    else if ( FileSwitchValue.StartsWith( L"DBQ="   , false ) ||
+              FileSwitchValue.StartsWith( L"DRIVER=", false )  )
+    {
+        Database.Connect( FileSwitchValue,
+                          PXS_DB_CONNECT_TIMEOUT_SECS_DEF,
+                          PXS_DB_QUERY_TIMEOUT_SECS_DEF, nullptr );
+        numOldAudits = Database.CountOldAudits( retainCount, retainDays );
+    }
+    else
+    {
+        throw ParameterException( L"FileSwitchValue", __FUNCTION__ );
+    }
+    PXSLogAppInfo1( L"Found %%1 old audits.", Format.SizeT( numOldAudits ) );
+
+    try
+    {
+        do
+        {
+            if ( useSqlite )
+            {
+                numDeleted = SqliteDb.DeleteOldAuditsBatch( retainCount,
+                                                            retainDays, batchSize, &lastSqliteID );
+            }
+            else
+            {
+                numDeleted = Database.DeleteOldAuditsBatch( retainCount,
+                                                            retainDays, batchSize, &lastAuditID );
+            }
+            totalDeleted = PXSAddSizeT( totalDeleted, numDeleted );
+            if ( numDeleted )
+            {
+                PXSLogAppInfo2( L"Deleted %%1 of %%2 old audits.",
+                                Format.SizeT( totalDeleted ), Format.SizeT( numOldAudits ) );
+            }
+        } while ( numDeleted );
+    }
+    catch ( const Exception& )
+    {
+        PXSLogAppInfo1( L"Deleted %%1 old audits before the error.", Format.SizeT( totalDeleted ) );
+        throw;
+    }
+    PXSLogAppInfo1( L"Deleted %%1 old audits.", Format.SizeT( totalDeleted ) );
+}
+
 //===============================================================================================//
 //  Description:
 //      Read the GUID in the file at CSIDL_COMMON_APPDATA\Parmavex\WinAudit\
@@ -1410,38 +1562,6 @@ void PXSReadWinAuditGuidFile( String* pWinAuditGuid )
     }
 }
 
-//===============================================================================================//
-//  Description:
-//      Callback for qsort for a case insensitive ascending sort of an
-//      PXS_TYPE_NUMBER_STRING array
-//
-//  Parameters:
-//      pArg1 - pointer to string 1
-//      pArg2 - pointer to string 2
-//
-//  Returns:
-//      > 0  if arg1 greater than arg2
-//      = 0  if arg1 equivalent to arg2
-//      < 0  if arg1 less than arg2
-//===============================================================================================//
-int PXSQSortNumberStringAscending( const void* pArg1, const void* pArg2 )
-{
-    LPCWSTR pszOne  = nullptr;
-    LPCWSTR pszTwo  = nullptr;
-
-    if ( pArg1 )
-    {
-        pszOne = ( (const PXS_TYPE_NUMBER_STRING*)pArg1 )->szValue;
-    }
-
-    if ( pArg2 )
-    {
-        pszTwo = ( (const PXS_TYPE_NUMBER_STRING*)pArg2 )->szValue;
-    }
-
-    return PXSCompareString( pszOne, pszTwo, false );
-}
-
 //===============================================================================================//
 //  Description:
 //      Save the audit to a database or a file when in command line mode
@@ -1463,6 +1583,7 @@ void PXSSaveAuditCommandLine( const String& OutputPath, const TArray< AuditRecor
     AuditRecord   AuditMasterRecord, ComputerMasterRecord;
     AllocateChars AnsiChars;
     AuditDatabase Database;
+    SqliteDatabase   SqliteDb;
     OdbcExportDialog OdbcExport;
     TArray< TreeViewItem > CategoryItems;
 
@@ -1501,6 +1622,17 @@ void PXSSaveAuditCommandLine( const String& OutputPath, const TArray< AuditRecor
             tries++;
         }
     }
+    else if ( SqliteDatabase::IsSqliteFilePath( OutputPath ) )
+    {
+        // Local database file, the busy timeout handles concurrent writers
+        PXSLogAppInfo1( L"Output SQLite database: '%%1'", OutputPath );
+        Auditor.MakeAuditMasterRecord( &AuditMasterRecord );
+        Auditor.MakeComputerMasterRecord( &ComputerMasterRecord );
+        SqliteDb.Open( OutputPath, false );
+        SqliteDb.ExportAudit( ComputerMasterRecord,
+                              AuditMasterRecord, AuditRecords, &ResultMessage );
+        SqliteDb.Close();
+    }
     else
     {
         PXSLogAppInfo1( L"Output file path: '%%1'", OutputPath );
@@ -1510,11 +1642,17 @@ void PXSSaveAuditCommandLine( const String& OutputPath, const TArray< AuditRecor
         }
         else if ( OutputPath.EndsWithStringI( L".csv2" ) )
         {
+            // Master records so the file can be ingested into a database
             PXSAuditRecordsToCsv2( AuditRecords, true, &DataString );
+            Auditor.MakeAuditMasterRecord( &AuditMasterRecord );
+            Auditor.MakeComputerMasterRecord( &ComputerMasterRecord );
+            AuditFileIngester::MasterRecordsToCsv2( ComputerMasterRecord,
+                                                    AuditMasterRecord, &DataString );
         }
         else if ( OutputPath.EndsWithStringI( L".rtf" ) )
         {
-            PXSAuditRecordsToContent( AuditRecords, &CategoryItems, &tableCounter, &DataString );
+            PXSAuditRecordsToContent( AuditRecords,
+                                      &CategoryItems, nullptr, &tableCounter, &DataString );
         }
         else
         {
@@ -1533,71 +1671,120 @@ void PXSSaveAuditCommandLine( const String& OutputPath, const TArray< AuditRecor
 
 //===============================================================================================//
 //  Description:
-//     Sort audit records in ascending on the specified item
+//      Callback for PXSStableSortIndexes to compare two audit records on
+//      their sort keys
+//
+//  Parameters:
+//      index1   - index of the first record
+//      index2   - index of the second record
+//      pContext - pointer to a PXS_TYPE_AUDIT_SORT_KEYS structure
+//
+//  Returns:
+//      -ve, 0 or +ve for the first key that differs
+//===============================================================================================//
+static int CompareAuditRecordKeys( size_t index1, size_t index2, const void* pContext )
+{
+    const PXS_TYPE_AUDIT_SORT_KEYS* pSortKeys =
+                                        static_cast<const PXS_TYPE_AUDIT_SORT_KEYS*>( pContext );
+    size_t numKeys = pSortKeys->numKeys;
+    const LPCWSTR* ppKeys1 = pSortKeys->ppKeys + ( index1 * numKeys );
+    const LPCWSTR* ppKeys2 = pSortKeys->ppKeys + ( index2 * numKeys );
+
+    for ( size_t k = 0; k < numKeys; k++ )
+    {
+        int result = PXSCompareSortKey( ppKeys1[ k ], ppKeys2[ k ], pSortKeys->pKeyTypes[ k ] );
+        if ( result != 0 )
+        {
+            return result;
+        }
+    }
+    return 0;
+}
+
+//===============================================================================================//
+//  Description:
+//     Sort audit records in ascending order on the specified item
 //
 //  Parameters:
 //      Records - the records to sort
 //      itemID  - the item ID
 //
 //  Remarks:
-//      Will sort on the first 32 characters of the item's string value as
-//      strings are usually different before getting to this length
+//      Case insensitive string sort on the item's full value, records with
+//      the same value keep their order
 //
 //  Returns:
 //      void
 //===============================================================================================//
 void PXSSortAuditRecords( TArray< AuditRecord >* pRecords, DWORD itemID )
 {
-    String        Value;
-    AuditRecord   Record;
-    AllocateBytes AllocBytes;
-    TArray< AuditRecord > SortedArray;
+    DWORD keyType = PXS_SORT_KEY_STRING;
+
+    PXSSortAuditRecordsByKeys( pRecords, &itemID, &keyType, 1 );
+}
+
+//===============================================================================================//
+//  Description:
+//     Stable sort of audit records in ascending order on one or more typed keys
+//
+//  Parameters:
+//      pRecords  - the records to sort
+//      pItemIDs  - the item ID of each key, most significant first
+//      pKeyTypes - PXS_SORT_KEY_xxx type of each key
+//      numKeys   - number of keys
+//
+//  Remarks:
+//      The keys point into the records so nothing is copied or truncated.
+//      Only an index permutation is sorted, the records are then swapped
+//      into place.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void PXSSortAuditRecordsByKeys( TArray< AuditRecord >* pRecords,
+                                const DWORD* pItemIDs, const DWORD* pKeyTypes, size_t numKeys )
+{
+    AllocateBytes KeyBytes, OrderBytes;
+    PXS_TYPE_AUDIT_SORT_KEYS SortKeys;
 
     if ( pRecords == nullptr )
     {
         throw ParameterException( L"pRecords", __FUNCTION__ );
     }
 
+    if ( ( pItemIDs == nullptr ) || ( pKeyTypes == nullptr ) || ( numKeys == 0 ) )
+    {
+        throw ParameterException( L"pItemIDs/pKeyTypes/numKeys", __FUNCTION__ );
+    }
+
     size_t numRecords = pRecords->GetSize();
-    if ( numRecords < 1 )
+    if ( numRecords < 2 )
     {
         return;     // Nothing to do
     }
 
-    // Fill array
-    size_t numBytes = PXSMultiplySizeT( sizeof ( PXS_TYPE_NUMBER_STRING ), numRecords);
-    PXS_TYPE_NUMBER_STRING* pArray = reinterpret_cast<PXS_TYPE_NUMBER_STRING* >(
-                                                                    AllocBytes.New( numBytes ) );
+    // Point at each record's key values
+    size_t numBytes  = PXSMultiplySizeT( numRecords, numKeys );
+    numBytes         = PXSMultiplySizeT( numBytes, sizeof ( LPCWSTR ) );
+    LPCWSTR* ppKeys  = reinterpret_cast<LPCWSTR*>( KeyBytes.New( numBytes ) );
+    numBytes         = PXSMultiplySizeT( numRecords, sizeof ( size_t ) );
+    size_t* pOrder   = reinterpret_cast<size_t*>( OrderBytes.New( numBytes ) );
     for ( size_t i = 0; i < numRecords; i++ )
     {
-        // Get the first field of the record
-        Value  = PXS_STRING_EMPTY;
-        Record = pRecords->Get( i );
-        Record.GetItemValue( itemID, &Value );
-
-        pArray[ i ].number = i;
-        size_t lenChars = Value.GetLength();
-        if ( lenChars )
+        const AuditRecord& Record = pRecords->Get( i );
+        for ( size_t k = 0; k < numKeys; k++ )
         {
-            // Copy as much as can fit
-            StringCchCopyN( pArray[ i ].szValue,
-                            ARRAYSIZE( pArray[ i ].szValue ), Value.c_str(), lenChars );
+            ppKeys[ ( i * numKeys ) + k ] = Record.GetItemValue( pItemIDs[ k ] );
         }
+        pOrder[ i ] = i;
     }
 
-    // Sort
-    qsort( pArray,
-           numRecords,
-           sizeof ( PXS_TYPE_NUMBER_STRING ), PXSQSortNumberStringAscending );
-
-    // Replace
-    SortedArray.SetSize( numRecords );
-    for ( size_t i = 0; i < numRecords; i++ )
-    {
-        Record = pRecords->Get( pArray[ i ].number );
-        SortedArray.Set( i, Record );
-    }
-    *pRecords = SortedArray;
+    memset( &SortKeys, 0, sizeof ( SortKeys ) );
+    SortKeys.numKeys   = numKeys;
+    SortKeys.pKeyTypes = pKeyTypes;
+    SortKeys.ppKeys    = ppKeys;
+    PXSStableSortIndexes( pOrder, numRecords, CompareAuditRecordKeys, &SortKeys );
+    pRecords->Permute( pOrder, numRecords );
 }
 
 //===============================================================================================//
@@ -0,0 +1,182 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Application Unit Tests
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The resource string tests load the English string tables linked into the
+// test runner, so the expected texts are those of winaudit_en.txt.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Test Files/WinAuditTests.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/Application.h"
+#include "PxsBase/Header Files/Formatter.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/Resources.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Resource strings are found by id and their inserts substituted once
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestResourceStrings()
+{
+    String Insert1, Insert2, Insert3, Result;
+
+    g_pApplication->GetResourceString( PXS_IDS_1260_NO, &Result );
+    PXS_TEST_CHECK( Result.Compare( L"No", true ) == 0 );
+    g_pApplication->GetResourceString( PXS_IDS_1261_YES, &Result );
+    PXS_TEST_CHECK( Result.Compare( L"Yes", true ) == 0 );
+
+    Insert1 = L"10";
+    Insert2 = L"0";
+    Insert3 = L"25";
+    g_pApplication->GetResourceString3( PXS_IDS_1236_INSERT_RESULT_MESSAGE,
+                                        Insert1, Insert2, Insert3, &Result );
+    PXS_TEST_CHECK( Result.Compare(
+                        L"Records inserted: 10, error count: 0, time taken: 25ms", true ) == 0 );
+
+    // Inserts are not themselves substituted
+    Insert1 = L"%%2";
+    Insert2 = L"%%3";
+    g_pApplication->GetResourceString3( PXS_IDS_1236_INSERT_RESULT_MESSAGE,
+                                        Insert1, Insert2, Insert3, &Result );
+    PXS_TEST_CHECK( Result.Compare(
+                        L"Records inserted: %%2, error count: %%3, time taken: 25ms", true ) == 0 );
+
+    // Inserts that were never set show as <null>, empty ones as nothing
+    Insert2 = L"";
+    g_pApplication->GetResourceString2( PXS_IDS_1236_INSERT_RESULT_MESSAGE,
+                                        Insert2, Insert2, &Result );
+    PXS_TEST_CHECK( Result.Compare(
+                        L"Records inserted: , error count: , time taken: <null>ms", true ) == 0 );
+
+    // The output may also be an insert
+    Insert1 = L"7";
+    Insert2 = L"1";
+    g_pApplication->GetResourceString3( PXS_IDS_1236_INSERT_RESULT_MESSAGE,
+                                        Insert1, Insert2, Insert3, &Insert1 );
+    PXS_TEST_CHECK( Insert1.Compare(
+                        L"Records inserted: 7, error count: 1, time taken: 25ms", true ) == 0 );
+
+    // Unknown ids give an empty string
+    Result = L"Stale";
+    g_pApplication->GetResourceString( 0xFFFF, &Result );
+    PXS_TEST_CHECK( Result.IsEmpty() );
+    Result = L"Stale";
+    g_pApplication->GetResourceString( 0, &Result );
+    PXS_TEST_CHECK( Result.IsEmpty() );
+}
+
+//===============================================================================================//
+//  Description:
+//      Render resource strings the way a report does, a message with
+//      inserts and a yes or no per record
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestRenderRate()
+{
+    const  size_t NUM_RECORDS = 200000;
+    size_t i = 0, numChars = 0, numYes = 0;
+    UINT64 startTick = 0;
+    String Inserted, Errors, Elapsed, Result, YesNo;
+    Formatter Format;
+
+    Errors  = L"0";
+    Elapsed = L"125";
+    startTick = GetTickCount64();
+    for ( i = 0; i < NUM_RECORDS; i++ )
+    {
+        Inserted = Format.SizeT( i );
+        g_pApplication->GetResourceString3( PXS_IDS_1236_INSERT_RESULT_MESSAGE,
+                                            Inserted, Errors, Elapsed, &Result );
+        numChars += Result.GetLength();
+
+        g_pApplication->GetResourceString( ( i % 2 ) ? PXS_IDS_1261_YES : PXS_IDS_1260_NO,
+                                           &YesNo );
+        if ( YesNo.Compare( L"Yes", true ) == 0 )
+        {
+            numYes++;
+        }
+    }
+    PXSTestReportRate( "Resource strings rendered", 2 * NUM_RECORDS, GetTickCount64() - startTick );
+
+    PXS_TEST_CHECK( numYes == ( NUM_RECORDS / 2 ) );
+    PXS_TEST_CHECK( numChars > ( NUM_RECORDS * 50 ) );
+    PXS_TEST_CHECK( Result.Compare( L"Records inserted: 199999, error count: 0, time taken: 125ms",
+                                    true ) == 0 );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Suite
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Run the application resource string tests
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void RunApplicationTests()
+{
+    g_pApplication->AddAppResourceLanguageID( IDR_STRINGS_WINAUDIT_EN, LANG_ENGLISH, 0 );
+    g_pApplication->LoadStringFile( LANG_ENGLISH, SUBLANG_ENGLISH_UK );
+
+    TestResourceStrings();
+    TestRenderRate();
+}
@@ -0,0 +1,258 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Audit Record Sort Unit Tests
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The records are installed program records made up in memory, the vendor
+// column holds each record's original position so the tests can see that
+// records with equal keys keep their order.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Test Files/WinAuditTests.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/Formatter.h"
+#include "PxsBase/Header Files/TArray.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/AuditRecord.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Fixtures
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+const DWORD SORT_ITEM_IDS[]  = { PXS_INSTAL_PROGS_NAME, PXS_INSTAL_PROGS_VERSION };
+const DWORD SORT_KEY_TYPES[] = { PXS_SORT_KEY_STRING  , PXS_SORT_KEY_VERSION };
+
+//===============================================================================================//
+//  Description:
+//      Fill in an installed program record
+//
+//  Parameters:
+//      pszName    - the program name
+//      pszVendor  - the vendor, the record's original position
+//      pszVersion - the version
+//      pRecord    - the record
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void MakeRecord( LPCWSTR pszName,
+                        LPCWSTR pszVendor, LPCWSTR pszVersion, AuditRecord* pRecord )
+{
+    pRecord->Reset( PXS_CATEGORY_INSTALLED_PROGS );
+    pRecord->Add( PXS_INSTAL_PROGS_NAME   , pszName );
+    pRecord->Add( PXS_INSTAL_PROGS_VENDOR , pszVendor );
+    pRecord->Add( PXS_INSTAL_PROGS_VERSION, pszVersion );
+}
+
+//===============================================================================================//
+//  Description:
+//      Test if sorted records are in key order and records with equal keys
+//      are in their original order
+//
+//  Parameters:
+//      Records - the sorted records
+//
+//  Returns:
+//      true if in order, otherwise false
+//===============================================================================================//
+static bool IsSorted( const TArray< AuditRecord >& Records )
+{
+    int    result = 0;
+    size_t i = 0, k = 0;
+
+    for ( i = 1; i < Records.GetSize(); i++ )
+    {
+        const AuditRecord& Previous = Records.Get( i - 1 );
+        const AuditRecord& Current  = Records.Get( i );
+
+        result = 0;
+        for ( k = 0; ( k < ARRAYSIZE( SORT_ITEM_IDS ) ) && ( result == 0 ); k++ )
+        {
+            result = PXSCompareSortKey( Previous.GetItemValue( SORT_ITEM_IDS[ k ] ),
+                                        Current.GetItemValue( SORT_ITEM_IDS[ k ] ),
+                                        SORT_KEY_TYPES[ k ] );
+        }
+        if ( result > 0 )
+        {
+            return false;
+        }
+
+        if ( ( result == 0 ) &&
+             ( _wtoi( Previous.GetItemValue( PXS_INSTAL_PROGS_VENDOR ) ) >=
+               _wtoi( Current.GetItemValue( PXS_INSTAL_PROGS_VENDOR ) ) ) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Version keys compare runs of digits by value
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestCompareSortKey()
+{
+    PXS_TEST_CHECK( PXSCompareSortKey( L"1.10", L"1.9", PXS_SORT_KEY_STRING  ) < 0 );
+    PXS_TEST_CHECK( PXSCompareSortKey( L"1.10", L"1.9", PXS_SORT_KEY_VERSION ) > 0 );
+    PXS_TEST_CHECK( PXSCompareSortKey( L"KB890830", L"KB5005565", PXS_SORT_KEY_VERSION ) < 0 );
+    PXS_TEST_CHECK( PXSCompareSortKey( L"1.2", L"1.2.0", PXS_SORT_KEY_VERSION ) < 0 );
+    PXS_TEST_CHECK( PXSCompareSortKey( L"v2", L"V2", PXS_SORT_KEY_VERSION ) == 0 );
+    PXS_TEST_CHECK( PXSCompareSortKey( nullptr, L"", PXS_SORT_KEY_VERSION ) == 0 );
+    PXS_TEST_CHECK( PXSCompareSortKey( L"99999999999999999999999", L"1",
+                                       PXS_SORT_KEY_VERSION ) > 0 );
+}
+
+//===============================================================================================//
+//  Description:
+//      Records are sorted on name without case then on version, records
+//      with equal keys keep their order
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestSortByKeys()
+{
+    size_t i = 0;
+    String Vendors;
+    AuditRecord Record;
+    TArray< AuditRecord > Records;
+
+    MakeRecord( L"Zip", L"0", L"1.10", &Record );
+    Records.Add( Record );
+    MakeRecord( L"app", L"1", L"1.9" , &Record );
+    Records.Add( Record );
+    MakeRecord( L"App", L"2", L"1.10", &Record );
+    Records.Add( Record );
+    MakeRecord( L"Zip", L"3", L"1.2" , &Record );
+    Records.Add( Record );
+    MakeRecord( L"APP", L"4", L"1.9" , &Record );
+    Records.Add( Record );
+
+    PXSSortAuditRecordsByKeys( &Records, SORT_ITEM_IDS, SORT_KEY_TYPES, ARRAYSIZE( SORT_ITEM_IDS ) );
+    for ( i = 0; i < Records.GetSize(); i++ )
+    {
+        Vendors += Records.Get( i ).GetItemValue( PXS_INSTAL_PROGS_VENDOR );
+    }
+    PXS_TEST_CHECK( Vendors.Compare( L"14230", true ) == 0 );
+    PXS_TEST_CHECK( IsSorted( Records ) );
+
+    // On the name alone the equal names keep their order
+    PXSSortAuditRecords( &Records, PXS_INSTAL_PROGS_NAME );
+    Vendors = PXS_STRING_EMPTY;
+    for ( i = 0; i < Records.GetSize(); i++ )
+    {
+        Vendors += Records.Get( i ).GetItemValue( PXS_INSTAL_PROGS_VENDOR );
+    }
+    PXS_TEST_CHECK( Vendors.Compare( L"14230", true ) == 0 );
+}
+
+//===============================================================================================//
+//  Description:
+//      Sort a million records on two keys
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestSortRate()
+{
+    const  size_t NUM_RECORDS = 1000000;
+    size_t i = 0;
+    UINT64 startTick = 0;
+    String Name, Vendor, Version;
+    Formatter Format;
+    TArray< AuditRecord > Records;
+
+    // Many records share a name and a version, scatter them
+    Records.SetSize( NUM_RECORDS );
+    for ( i = 0; i < NUM_RECORDS; i++ )
+    {
+        Name    = Format.StringUInt32( L"Program %%1", static_cast<DWORD>( ( i * 7919 ) % 1000 ) );
+        Vendor  = Format.SizeT( i );
+        Version = Format.StringUInt32_2( L"%%1.%%2",
+                                         static_cast<DWORD>( i % 3 ),
+                                         static_cast<DWORD>( ( i * 31 ) % 97 ) );
+        MakeRecord( Name.c_str(), Vendor.c_str(), Version.c_str(), Records.GetPtr( i ) );
+    }
+
+    startTick = GetTickCount64();
+    PXSSortAuditRecordsByKeys( &Records, SORT_ITEM_IDS, SORT_KEY_TYPES, ARRAYSIZE( SORT_ITEM_IDS ) );
+    PXSTestReportRate( "Audit records sorted", NUM_RECORDS, GetTickCount64() - startTick );
+
+    PXS_TEST_CHECK( Records.GetSize() == NUM_RECORDS );
+    PXS_TEST_CHECK( IsSorted( Records ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Suite
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Run the audit record sort tests
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void RunAuditRecordSortTests()
+{
+    TestCompareSortKey();
+    TestSortByKeys();
+    TestSortRate();
+}
@@ -0,0 +1,266 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Category Snapshot Cache Unit Tests
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The stub cache takes its fingerprint from the test rather than the
+// registry and the snapshots are kept in a directory under the temporary
+// directory. The stub collector makes a record the way the category's real
+// collector would and, if asked, logs an error and carries on as they do.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Test Files/WinAuditTests.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/Directory.h"
+#include "PxsBase/Header Files/File.h"
+#include "PxsBase/Header Files/Formatter.h"
+#include "PxsBase/Header Files/FunctionException.h"
+#include "PxsBase/Header Files/TArray.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/AuditRecord.h"
+#include "WinAudit/Header Files/CategorySnapshotCache.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Stubs
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class StubSnapshotCache : public CategorySnapshotCache
+{
+    public:
+        // Default constructor
+        explicit StubSnapshotCache( const String& DirectoryPath )
+            :m_Fingerprint( L"1" )
+        {
+            SetDirectoryPath( DirectoryPath );
+        }
+
+        // Data members
+        String m_Fingerprint;
+
+    protected:
+        void GetFingerprint( DWORD categoryID, String* pFingerprint ) override
+        {
+            UNREFERENCED_PARAMETER( categoryID );
+            *pFingerprint = m_Fingerprint;
+        }
+};
+
+//===============================================================================================//
+//  Description:
+//      Collect a category's records
+//
+//  Parameters:
+//      categoryID - defined category number
+//      pszValue   - the value of the first item
+//      logError   - true to log an error part way through
+//      pRecords   - receives the records
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void CollectStub( DWORD categoryID,
+                         LPCWSTR pszValue, bool logError, TArray< AuditRecord >* pRecords )
+{
+    AuditRecord Record( categoryID );
+
+    pRecords->RemoveAll();
+    Record.Add( categoryID + 1, pszValue );
+    Record.Add( categoryID + 2, L"Tab\there, new line\r\nand a back slash \\" );
+    pRecords->Add( Record );
+
+    if ( logError )
+    {
+        PXSLogException( L"Stub collector carried on after an error.",
+                         FunctionException( L"logError", __FUNCTION__ ), __FUNCTION__ );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Saved records are read back while the fingerprint is unchanged
+//
+//  Parameters:
+//      DirectoryPath - where to keep the snapshots
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestSnapshotRoundTrip( const String& DirectoryPath )
+{
+    const DWORD  CATEGORY_ID = PXS_CATEGORY_SOFTWARE_UPDATES;
+    size_t numHits = 0, numMisses = 0;
+    String Expected, Value;
+    TArray< AuditRecord > Collected, Records;
+    StubSnapshotCache Cache( DirectoryPath );
+
+    PXS_TEST_CHECK( Cache.GetRecords( CATEGORY_ID, &Records ) == false );
+    CollectStub( CATEGORY_ID, L"KB0000001", false, &Collected );
+    Cache.SaveRecords( CATEGORY_ID, Collected );
+
+    PXS_TEST_CHECK( Cache.GetRecords( CATEGORY_ID, &Records ) );
+    PXS_TEST_CHECK( Records.GetSize() == 1 );
+    if ( Records.GetSize() == 1 )
+    {
+        Records.Get( 0 ).GetItemValue( CATEGORY_ID + 1, &Value );
+        PXS_TEST_CHECK( Value.Compare( L"KB0000001", true ) == 0 );
+
+        Collected.Get( 0 ).GetItemValue( CATEGORY_ID + 2, &Expected );
+        Records.Get( 0 ).GetItemValue( CATEGORY_ID + 2, &Value );
+        PXS_TEST_CHECK( Value.Compare( Expected, true ) == 0 );
+    }
+    Cache.GetStatistics( &numHits, &numMisses );
+    PXS_TEST_CHECK( ( numHits == 1 ) && ( numMisses == 1 ) );
+
+    // The sources changed
+    Cache.m_Fingerprint = L"2";
+    PXS_TEST_CHECK( Cache.GetRecords( CATEGORY_ID, &Records ) == false );
+    PXS_TEST_CHECK( Records.GetSize() == 0 );
+}
+
+//===============================================================================================//
+//  Description:
+//      Records collected while an error was logged are not saved
+//
+//  Parameters:
+//      DirectoryPath - where to keep the snapshots
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestSnapshotNotSavedAfterError( const String& DirectoryPath )
+{
+    const DWORD CATEGORY_ID = PXS_CATEGORY_INSTALLED_PROGS;
+    TArray< AuditRecord > Collected, Records;
+    StubSnapshotCache Cache( DirectoryPath );
+
+    PXS_TEST_CHECK( Cache.GetRecords( CATEGORY_ID, &Records ) == false );
+    CollectStub( CATEGORY_ID, L"Partial", true, &Collected );
+    Cache.SaveRecords( CATEGORY_ID, Collected );
+    PXS_TEST_CHECK( Cache.GetRecords( CATEGORY_ID, &Records ) == false );
+
+    // A clean collection is saved
+    CollectStub( CATEGORY_ID, L"Complete", false, &Collected );
+    Cache.SaveRecords( CATEGORY_ID, Collected );
+    PXS_TEST_CHECK( Cache.GetRecords( CATEGORY_ID, &Records ) );
+}
+
+//===============================================================================================//
+//  Description:
+//      Nothing is saved without a lookup for the same category first
+//
+//  Parameters:
+//      DirectoryPath - where to keep the snapshots
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestSnapshotNeedsLookup( const String& DirectoryPath )
+{
+    const DWORD CATEGORY_ID = PXS_CATEGORY_NTSERVICES;
+    TArray< AuditRecord > Collected, Records;
+    StubSnapshotCache Cache( DirectoryPath );
+
+    // Reset forgets the lookup
+    PXS_TEST_CHECK( Cache.GetRecords( CATEGORY_ID, &Records ) == false );
+    Cache.Reset();
+    CollectStub( CATEGORY_ID, L"Service", false, &Collected );
+    Cache.SaveRecords( CATEGORY_ID, Collected );
+    PXS_TEST_CHECK( Cache.GetRecords( CATEGORY_ID, &Records ) == false );
+
+    // Another category was looked up
+    CollectStub( PXS_CATEGORY_PRINTERS, L"Printer", false, &Collected );
+    Cache.SaveRecords( PXS_CATEGORY_PRINTERS, Collected );
+    PXS_TEST_CHECK( Cache.GetRecords( PXS_CATEGORY_PRINTERS, &Records ) == false );
+
+    // Not cacheable
+    PXS_TEST_CHECK( Cache.GetRecords( PXS_CATEGORY_SYSTEM_OVERVIEW, &Records ) == false );
+    CollectStub( PXS_CATEGORY_SYSTEM_OVERVIEW, L"Computer", false, &Collected );
+    Cache.SaveRecords( PXS_CATEGORY_SYSTEM_OVERVIEW, Collected );
+    PXS_TEST_CHECK( Cache.GetRecords( PXS_CATEGORY_SYSTEM_OVERVIEW, &Records ) == false );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Suite
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Run the category snapshot cache tests
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void RunCategorySnapshotCacheTests()
+{
+    size_t    i = 0;
+    String    DirectoryPath, FilePath;
+    Formatter Format;
+    DWORD     CategoryIDs[] = { PXS_CATEGORY_INSTALLED_PROGS,
+                                PXS_CATEGORY_SOFTWARE_UPDATES,
+                                PXS_CATEGORY_NTSERVICES,
+                                PXS_CATEGORY_PRINTERS,
+                                PXS_CATEGORY_SYSTEM_OVERVIEW };
+
+    Directory::GetTempDirectory( &DirectoryPath );
+    DirectoryPath += Format.StringUInt32( L"WinAuditTests_%%1", GetCurrentProcessId() );
+
+    TestSnapshotRoundTrip( DirectoryPath );
+    TestSnapshotNotSavedAfterError( DirectoryPath );
+    TestSnapshotNeedsLookup( DirectoryPath );
+
+    // Clean up
+    for ( i = 0; i < ARRAYSIZE( CategoryIDs ); i++ )
+    {
+        FilePath  = DirectoryPath;
+        FilePath += PXS_PATH_SEPARATOR;
+        FilePath += Format.StringUInt32( L"Category_%%1.txt", CategoryIDs[ i ] );
+        PXS_TEST_CHECK( ( CategoryIDs[ i ] != PXS_CATEGORY_SYSTEM_OVERVIEW ) ||
+                        ( File::Exists( FilePath ) == false ) );
+        File::Delete( FilePath );
+    }
+    Directory::Delete( DirectoryPath );
+}
@@ -0,0 +1,333 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Collector Thread Unit Tests
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The collector is driven one pass at a time with a made-up clock. The stub
+// replaces collection and export so no computer is audited and nothing is
+// written, each category yields one record holding a value the test sets.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Test Files/WinAuditTests.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/FunctionException.h"
+#include "PxsBase/Header Files/ParameterException.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/CollectorThread.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Stub Collector
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class StubCollector : public CollectorThread
+{
+    public:
+        // Default constructor
+        StubCollector()
+            :m_bFailExport( false ),
+             m_uThrowCategoryID( 0 ),
+             m_uNumExports( 0 ),
+             m_uNumExportAttempts( 0 ),
+             m_uNumExportedRecords( 0 ),
+             m_FirstValue( L"A" ),
+             m_SecondValue( L"B" ),
+             m_ExportedFirstValue()
+        {
+            m_uNumCollects[ 0 ] = 0;
+            m_uNumCollects[ 1 ] = 0;
+            m_bRunMT = TRUE;      // As if the worker were running
+        }
+
+        // Methods
+        DWORD GetWaitAt( time_t now ) const
+        {
+            return GetWaitMilliSecs( now );
+        }
+
+        void RunPassAt( time_t now )
+        {
+            RunPass( now, L"2022-01-01 00:00:00" );
+        }
+
+        // Data members
+        bool   m_bFailExport;
+        DWORD  m_uThrowCategoryID;
+        DWORD  m_uNumCollects[ 2 ];
+        DWORD  m_uNumExports;
+        DWORD  m_uNumExportAttempts;
+        size_t m_uNumExportedRecords;
+        String m_FirstValue;
+        String m_SecondValue;
+        String m_ExportedFirstValue;
+
+        // Categories
+        static const DWORD FIRST_CATEGORY_ID  = PXS_CATEGORY_SYSTEM_OVERVIEW;
+        static const DWORD SECOND_CATEGORY_ID = PXS_CATEGORY_ACTIVE_SETUP;
+
+    protected:
+        void CollectCategory( DWORD categoryID,
+                              const String& LocalTime, TArray< AuditRecord >* pRecords ) override
+        {
+            UNREFERENCED_PARAMETER( LocalTime );
+            size_t      index  = ( categoryID == FIRST_CATEGORY_ID ) ? 0 : 1;
+            AuditRecord Record( categoryID );
+
+            m_uNumCollects[ index ]++;
+            if ( categoryID == m_uThrowCategoryID )
+            {
+                throw FunctionException( L"m_uThrowCategoryID", __FUNCTION__ );
+            }
+            Record.Add( categoryID + 1, index ? m_SecondValue : m_FirstValue );
+            pRecords->Add( Record );
+        }
+
+        void ExportAudit( const String& LocalTime,
+                          const TArray< AuditRecord >& AuditRecords ) override
+        {
+            UNREFERENCED_PARAMETER( LocalTime );
+            size_t i = 0, numRecords = AuditRecords.GetSize();
+
+            m_uNumExportAttempts++;
+            if ( m_bFailExport )
+            {
+                throw FunctionException( L"m_bFailExport", __FUNCTION__ );
+            }
+            m_uNumExports++;
+            m_uNumExportedRecords = numRecords;
+            m_ExportedFirstValue  = PXS_STRING_EMPTY;
+            for ( i = 0; i < numRecords; i++ )
+            {
+                const AuditRecord& Record = AuditRecords.Get( i );
+                if ( Record.GetCategoryID() == FIRST_CATEGORY_ID )
+                {
+                    Record.GetItemValue( FIRST_CATEGORY_ID + 1, &m_ExportedFirstValue );
+                }
+            }
+        }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Categories are collected when due and an audit exported only on change
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestCollectsWhenDue()
+{
+    const time_t START = 1000;
+    StubCollector Collector;
+
+    Collector.AddSchedule( StubCollector::FIRST_CATEGORY_ID , 900 );
+    Collector.AddSchedule( StubCollector::SECOND_CATEGORY_ID, 86400 );
+
+    // Both are due at the start and make a complete audit
+    Collector.RunPassAt( START );
+    PXS_TEST_CHECK( Collector.m_uNumCollects[ 0 ] == 1 );
+    PXS_TEST_CHECK( Collector.m_uNumCollects[ 1 ] == 1 );
+    PXS_TEST_CHECK( Collector.m_uNumExports == 1 );
+    PXS_TEST_CHECK( Collector.m_uNumExportedRecords == 2 );
+    PXS_TEST_CHECK( Collector.GetWaitAt( START ) == 900 * 1000 );
+
+    // Nothing is due yet
+    Collector.RunPassAt( START + 899 );
+    PXS_TEST_CHECK( Collector.m_uNumCollects[ 0 ] == 1 );
+    PXS_TEST_CHECK( Collector.GetWaitAt( START + 899 ) == 1000 );
+
+    // Due but unchanged so no export
+    Collector.RunPassAt( START + 900 );
+    PXS_TEST_CHECK( Collector.m_uNumCollects[ 0 ] == 2 );
+    PXS_TEST_CHECK( Collector.m_uNumCollects[ 1 ] == 1 );
+    PXS_TEST_CHECK( Collector.m_uNumExportAttempts == 1 );
+
+    // Changed so one export with the other category's last records
+    Collector.m_FirstValue = L"C";
+    Collector.RunPassAt( START + 1800 );
+    PXS_TEST_CHECK( Collector.m_uNumCollects[ 1 ] == 1 );
+    PXS_TEST_CHECK( Collector.m_uNumExports == 2 );
+    PXS_TEST_CHECK( Collector.m_uNumExportedRecords == 2 );
+    PXS_TEST_CHECK( Collector.m_ExportedFirstValue.CompareI( L"C" ) == 0 );
+}
+
+//===============================================================================================//
+//  Description:
+//      A failed export is retried with a doubling delay
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestExportBackOff()
+{
+    const time_t START = 1000;
+    StubCollector Collector;
+
+    Collector.AddSchedule( StubCollector::FIRST_CATEGORY_ID, 3600 );
+    Collector.m_bFailExport = true;
+    Collector.RunPassAt( START );
+    PXS_TEST_CHECK( Collector.m_uNumExportAttempts == 1 );
+    PXS_TEST_CHECK( Collector.GetWaitAt( START ) == 60 * 1000 );
+
+    // Not before the delay is up
+    Collector.RunPassAt( START + 59 );
+    PXS_TEST_CHECK( Collector.m_uNumExportAttempts == 1 );
+
+    // Fails again so the delay doubles
+    Collector.RunPassAt( START + 60 );
+    PXS_TEST_CHECK( Collector.m_uNumExportAttempts == 2 );
+    PXS_TEST_CHECK( Collector.GetWaitAt( START + 60 ) == 120 * 1000 );
+
+    // Sent once the delay is up
+    Collector.m_bFailExport = false;
+    Collector.RunPassAt( START + 180 );
+    PXS_TEST_CHECK( Collector.m_uNumExportAttempts == 3 );
+    PXS_TEST_CHECK( Collector.m_uNumExports == 1 );
+    PXS_TEST_CHECK( Collector.m_ExportedFirstValue.CompareI( L"A" ) == 0 );
+
+    // Success reset the delay so the next failure waits the minimum again
+    Collector.m_FirstValue  = L"D";
+    Collector.m_bFailExport = true;
+    Collector.RunPassAt( START + 3600 );
+    PXS_TEST_CHECK( Collector.m_uNumExportAttempts == 4 );
+    PXS_TEST_CHECK( Collector.GetWaitAt( START + 3600 ) == 60 * 1000 );
+}
+
+//===============================================================================================//
+//  Description:
+//      A category that fails keeps its records and is not retried early
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestCollectFailure()
+{
+    const time_t START = 1000;
+    StubCollector Collector;
+
+    Collector.AddSchedule( StubCollector::FIRST_CATEGORY_ID , 600 );
+    Collector.AddSchedule( StubCollector::SECOND_CATEGORY_ID, 60 );
+    Collector.RunPassAt( START );
+    PXS_TEST_CHECK( Collector.m_uNumExports == 1 );
+
+    // The first category fails while the second changes
+    Collector.m_uThrowCategoryID = StubCollector::FIRST_CATEGORY_ID;
+    Collector.m_FirstValue       = L"E";
+    Collector.m_SecondValue      = L"F";
+    Collector.RunPassAt( START + 600 );
+    PXS_TEST_CHECK( Collector.m_uNumCollects[ 0 ] == 2 );
+    PXS_TEST_CHECK( Collector.m_uNumExports == 2 );
+    PXS_TEST_CHECK( Collector.m_uNumExportedRecords == 2 );
+    PXS_TEST_CHECK( Collector.m_ExportedFirstValue.CompareI( L"A" ) == 0 );
+
+    // Its schedule moved on
+    Collector.RunPassAt( START + 660 );
+    PXS_TEST_CHECK( Collector.m_uNumCollects[ 0 ] == 2 );
+    PXS_TEST_CHECK( Collector.m_uNumCollects[ 1 ] == 3 );
+}
+
+//===============================================================================================//
+//  Description:
+//      Schedules keep the shortest interval and reject short ones
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestAddSchedule()
+{
+    bool   thrown = false;
+    StubCollector Collector;
+
+    Collector.AddSchedule( StubCollector::FIRST_CATEGORY_ID, 900 );
+    Collector.AddSchedule( StubCollector::FIRST_CATEGORY_ID, 600 );
+    Collector.AddSchedule( StubCollector::FIRST_CATEGORY_ID, 1200 );
+    PXS_TEST_CHECK( Collector.GetNumberOfSchedules() == 1 );
+
+    Collector.RunPassAt( 1000 );
+    PXS_TEST_CHECK( Collector.GetWaitAt( 1000 ) == 600 * 1000 );
+
+    try
+    {
+        Collector.AddSchedule( StubCollector::SECOND_CATEGORY_ID,
+                               CollectorThread::MIN_INTERVAL_SECS - 1 );
+    }
+    catch ( const ParameterException& )
+    {
+        thrown = true;
+    }
+    PXS_TEST_CHECK( thrown );
+    PXS_TEST_CHECK( Collector.GetNumberOfSchedules() == 1 );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Suite
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Run the collector thread tests
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void RunCollectorThreadTests()
+{
+    TestCollectsWhenDue();
+    TestExportBackOff();
+    TestCollectFailure();
+    TestAddSchedule();
+}
@@ -0,0 +1,665 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Disk Data Decoder Unit Tests
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The fixtures are 512-byte ATA IDENTIFY DEVICE and SMART READ DATA sectors
+// and 4096-byte NVMe Identify pages with a 512-byte SMART/Health log page,
+// built field by field from the specifications and written to a temporary
+// directory for DecodeDirectory.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Test Files/WinAuditTests.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/Directory.h"
+#include "PxsBase/Header Files/File.h"
+#include "PxsBase/Header Files/Formatter.h"
+#include "PxsBase/Header Files/StringArray.h"
+#include "PxsBase/Header Files/TArray.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/AuditRecord.h"
+#include "WinAudit/Header Files/DiskDataDecoder.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Fixtures
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Set a little-endian word of an ATA sector
+//
+//  Parameters:
+//      pSector - the sector
+//      word    - zero-based word number
+//      value   - the value
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void SetAtaWord( BYTE* pSector, size_t word, WORD value )
+{
+    pSector[ 2 * word ]     = LOBYTE( value );
+    pSector[ 2 * word + 1 ] = HIBYTE( value );
+}
+
+//===============================================================================================//
+//  Description:
+//      Set an unsigned little-endian integer in a buffer
+//
+//  Parameters:
+//      pBuffer  - where to put the value
+//      numBytes - size of the field
+//      value    - the value
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void SetUInt64LE( BYTE* pBuffer, size_t numBytes, UINT64 value )
+{
+    for ( size_t i = 0; i < numBytes; i++ )
+    {
+        pBuffer[ i ] = static_cast<BYTE>( value & 0xFF );
+        value      >>= 8;
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Set a space padded string field, optionally swapping each byte pair
+//
+//  Parameters:
+//      pField    - the field
+//      numBytes  - size of the field
+//      pszString - the string
+//      swapPairs - true for ATA strings which have two characters per word
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void SetStringField( BYTE* pField, size_t numBytes, const char* pszString, bool swapPairs )
+{
+    size_t i = 0, length = strlen( pszString );
+
+    for ( i = 0; i < numBytes; i++ )
+    {
+        pField[ i ] = ( i < length ) ? static_cast<BYTE>( pszString[ i ] ) : ' ';
+    }
+
+    if ( swapPairs )
+    {
+        for ( i = 0; ( i + 1 ) < numBytes; i += 2 )
+        {
+            BYTE b          = pField[ i ];
+            pField[ i ]     = pField[ i + 1 ];
+            pField[ i + 1 ] = b;
+        }
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Set the last byte of a sector so its bytes sum to zero
+//
+//  Parameters:
+//      pSector - the 512-byte sector
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void SetSectorCheckSum( BYTE* pSector )
+{
+    BYTE   sum = 0;
+    size_t i   = 0;
+
+    for ( i = 0; i < ( DiskDataDecoder::ATA_SECTOR_SIZE - 1 ); i++ )
+    {
+        sum = static_cast<BYTE>( sum + pSector[ i ] );
+    }
+    pSector[ DiskDataDecoder::ATA_SECTOR_SIZE - 1 ] = static_cast<BYTE>( 0x100 - sum );
+}
+
+//===============================================================================================//
+//  Description:
+//      Make an IDENTIFY DEVICE sector of a 1TB solid state disk
+//
+//  Parameters:
+//      pSector - receives the 512 bytes
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void MakeAtaIdentify( BYTE* pSector )
+{
+    memset( pSector, 0, DiskDataDecoder::ATA_SECTOR_SIZE );
+
+    SetAtaWord( pSector, 1, 16383 );                    // Cylinders
+    SetAtaWord( pSector, 3, 16 );                       // Heads
+    SetAtaWord( pSector, 6, 63 );                       // Sectors per track
+    SetStringField( pSector + 20, 20, "S08EJ1OA125287", true );
+    SetAtaWord( pSector, 21, 64 );                      // Buffer size
+    SetStringField( pSector + 46,  8, "01.01A01", true );
+    SetStringField( pSector + 54, 40, "WDC WDS100T2B0A", true );
+    SetAtaWord( pSector, 60, 0xFFFF );                  // 28-bit count, all
+    SetAtaWord( pSector, 61, 0x0FFF );
+    SetAtaWord( pSector, 82, 0x0001 );                  // SMART supported
+    SetAtaWord( pSector, 83, 0x0400 );                  // 48-bit supported
+    SetAtaWord( pSector, 85, 0x0001 );                  // SMART enabled
+    SetAtaWord( pSector, 86, 0x0400 );                  // 48-bit enabled
+    SetUInt64LE( pSector + 200, 8, 1953525168 );        // Words 100-103
+    SetAtaWord( pSector, 217, 1 );                      // No rotation
+    pSector[ 510 ] = 0xA5;
+    SetSectorCheckSum( pSector );
+}
+
+//===============================================================================================//
+//  Description:
+//      Make a SMART READ DATA sector
+//
+//  Parameters:
+//      selfTestStatus - the self-test execution status, 0 to 15
+//      pSector        - receives the 512 bytes
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void MakeAtaSmart( BYTE selfTestStatus, BYTE* pSector )
+{
+    BYTE* pAttribute = nullptr;
+
+    memset( pSector, 0, DiskDataDecoder::ATA_SECTOR_SIZE );
+    SetAtaWord( pSector, 0, 0x0010 );
+
+    // ID, flags, current, worst then a 6-byte raw value
+    pAttribute      = pSector + 2;
+    pAttribute[ 0 ] = 5;
+    pAttribute[ 3 ] = 100;
+    pAttribute[ 4 ] = 99;
+    SetUInt64LE( pAttribute + 5, 6, 258 );
+
+    pAttribute      = pSector + 2 + 12;               // Unused entry
+    pAttribute[ 3 ] = 100;
+
+    pAttribute      = pSector + 2 + ( 2 * 12 );
+    pAttribute[ 0 ] = 241;
+    pAttribute[ 3 ] = 100;
+    pAttribute[ 4 ] = 100;
+    SetUInt64LE( pAttribute + 5, 6, 0x123456789ABCULL );
+    pAttribute[ 11 ] = 0xEE;                            // Reserved, not raw
+
+    pAttribute      = pSector + 2 + ( 29 * 12 );        // Last entry
+    pAttribute[ 0 ] = 0xE7;
+    pAttribute[ 3 ] = 95;
+    pAttribute[ 4 ] = 95;
+    SetUInt64LE( pAttribute + 5, 6, 95 );
+
+    pSector[ 363 ] = static_cast<BYTE>( selfTestStatus << 4 );
+    SetSectorCheckSum( pSector );
+}
+
+//===============================================================================================//
+//  Description:
+//      Make an NVMe Identify Controller page
+//
+//  Parameters:
+//      capacityBytes - the total NVM capacity, zero if not reported
+//      pPage         - receives the 4096 bytes
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void MakeNvmeController( UINT64 capacityBytes, BYTE* pPage )
+{
+    memset( pPage, 0, DiskDataDecoder::NVME_IDENTIFY_SIZE );
+    SetUInt64LE( pPage, 2, 0x144D );
+    SetStringField( pPage +  4, 20, "S4EWNX0N123456", false );
+    SetStringField( pPage + 24, 40, "Samsung SSD 970 EVO Plus 1TB", false );
+    SetStringField( pPage + 64,  8, "2B2QEXM7", false );
+    SetUInt64LE( pPage + 80, 4, 0x00010300 );           // Version 1.3.0
+    SetUInt64LE( pPage + 266, 2, 358 );                 // Warning temperature
+    SetUInt64LE( pPage + 268, 2, 0 );                   // Critical, not reported
+
+    // 128-bit capacity, the upper half is set to check it is ignored
+    SetUInt64LE( pPage + 280, 8, capacityBytes );
+    SetUInt64LE( pPage + 288, 8, capacityBytes ? 1 : 0 );
+}
+
+//===============================================================================================//
+//  Description:
+//      Make an NVMe Identify Namespace page with 4096-byte logical blocks
+//
+//  Parameters:
+//      numBlocks - the namespace size in logical blocks
+//      pPage     - receives the 4096 bytes
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void MakeNvmeNamespace( UINT64 numBlocks, BYTE* pPage )
+{
+    memset( pPage, 0, DiskDataDecoder::NVME_IDENTIFY_SIZE );
+    SetUInt64LE( pPage, 8, numBlocks );
+    pPage[ 25 ] = 1;                                    // Two LBA formats
+    pPage[ 26 ] = 1;                                    // Format 1 in use
+    pPage[ 128 + 2 ] = 9;                               // Format 0, 512 bytes
+    pPage[ 132 + 2 ] = 12;                              // Format 1, 4096 bytes
+}
+
+//===============================================================================================//
+//  Description:
+//      Make an NVMe SMART/Health Information log page
+//
+//  Parameters:
+//      criticalWarning - the critical warning bits
+//      pPage           - receives the 512 bytes
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void MakeNvmeHealthLog( BYTE criticalWarning, BYTE* pPage )
+{
+    memset( pPage, 0, DiskDataDecoder::NVME_HEALTH_LOG_SIZE );
+    pPage[ 0 ] = criticalWarning;
+    SetUInt64LE( pPage + 1, 2, 310 );                   // 37 C
+    pPage[ 3 ] = 100;
+    pPage[ 4 ] = 10;
+    pPage[ 5 ] = 2;
+
+    // 128-bit counters, the upper halves are set to check they are ignored
+    SetUInt64LE( pPage +  32, 8, 0x100000000ULL );      // Data units read
+    SetUInt64LE( pPage +  40, 8, 7 );
+    SetUInt64LE( pPage +  48, 8, UINT64_MAX );          // Data units written
+    SetUInt64LE( pPage +  56, 8, 7 );
+    SetUInt64LE( pPage + 112, 8, 1234 );                // Power cycles
+    SetUInt64LE( pPage + 128, 8, 12345 );               // Power on hours
+    SetUInt64LE( pPage + 136, 8, 1 );
+    SetUInt64LE( pPage + 202, 2, 305 );                 // Sensor 2
+}
+
+//===============================================================================================//
+//  Description:
+//      Write a fixture file
+//
+//  Parameters:
+//      DirectoryPath - the directory
+//      pszFileName   - name of the file
+//      pBuffer       - the contents
+//      numBytes      - the number of bytes to write
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void WriteFixture( const String& DirectoryPath,
+                          LPCWSTR pszFileName, const BYTE* pBuffer, size_t numBytes )
+{
+    File   FixtureFile;
+    String FilePath;
+
+    FilePath  = DirectoryPath;
+    FilePath += PXS_PATH_SEPARATOR;
+    FilePath += pszFileName;
+    FixtureFile.CreateNew( FilePath, 0, false );
+    FixtureFile.Write( pBuffer, numBytes );
+    FixtureFile.Close();
+}
+
+//===============================================================================================//
+//  Description:
+//      Delete the files in a directory
+//
+//  Parameters:
+//      DirectoryPath - the directory
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void DeleteFixtures( const String& DirectoryPath )
+{
+    String      FilePath;
+    StringArray FileNames;
+
+    Directory::ListFiles( DirectoryPath, PXS_STRING_EMPTY, &FileNames );
+    for ( size_t i = 0; i < FileNames.GetSize(); i++ )
+    {
+        FilePath  = DirectoryPath;
+        FilePath += PXS_PATH_SEPARATOR;
+        FilePath += FileNames.Get( i );
+        File::Delete( FilePath );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Raw serial numbers have each pair of characters swapped
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestSerialByteSwap()
+{
+    BYTE   Field[ 20 ];
+    String SerialNumber;
+
+    DiskDataDecoder::DiskSerialHexToSerialNumber(
+                                    L"30534538314a414f323132353738202020202020", &SerialNumber );
+    PXS_TEST_CHECK( SerialNumber.Compare( L"S08EJ1OA125287", true ) == 0 );
+
+    // Not a multiple of 4, non-hex or non-printable so returned as is
+    DiskDataDecoder::DiskSerialHexToSerialNumber( L"305345", &SerialNumber );
+    PXS_TEST_CHECK( SerialNumber.Compare( L"305345", true ) == 0 );
+    DiskDataDecoder::DiskSerialHexToSerialNumber( L"3053453G", &SerialNumber );
+    PXS_TEST_CHECK( SerialNumber.Compare( L"3053453G", true ) == 0 );
+    DiskDataDecoder::DiskSerialHexToSerialNumber( L"30530045", &SerialNumber );
+    PXS_TEST_CHECK( SerialNumber.Compare( L"30530045", true ) == 0 );
+    DiskDataDecoder::DiskSerialHexToSerialNumber( PXS_STRING_EMPTY, &SerialNumber );
+    PXS_TEST_CHECK( SerialNumber.IsEmpty() );
+
+    // The IDENTIFY DEVICE field, an odd byte count ignores the last one
+    SetStringField( Field, sizeof ( Field ), "S08EJ1OA125287", true );
+    PXS_TEST_CHECK( DiskDataDecoder::ExtractIddStringValue( Field, sizeof ( Field ),
+                                                            &SerialNumber ) );
+    PXS_TEST_CHECK( SerialNumber.Compare( L"S08EJ1OA125287", true ) == 0 );
+    DiskDataDecoder::ExtractIddStringValue( Field, 5, &SerialNumber );
+    PXS_TEST_CHECK( SerialNumber.Compare( L"S08E", true ) == 0 );
+    PXS_TEST_CHECK( DiskDataDecoder::ExtractIddStringValue( nullptr, 0, &SerialNumber ) == false );
+}
+
+//===============================================================================================//
+//  Description:
+//      The SMART attribute table skips unused entries and keeps 6-byte raw
+//      values
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestAtaSmartAttributes()
+{
+    BYTE   Sector[ DiskDataDecoder::ATA_SECTOR_SIZE ];
+    String Translation;
+
+    MakeAtaSmart( 0, Sector );
+    DiskDataDecoder::FormatAtaSmartData( Sector, sizeof ( Sector ), &Translation );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"Revision                   \t= 16" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"CheckSum                   \t= Valid" ) !=
+                                                                                PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"\t5\t100\t99\t258\tReallocated Sectors Count\r\n" ) !=
+                                                                                PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"\t241\t100\t100\t20015998343868\tTotal LBAs" ) !=
+                                                                                PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"\t231\t95\t95\t95\tSSD Life Left" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"\t0\t100" ) == PXS_MINUS_ONE );
+
+    Sector[ 100 ]++;
+    DiskDataDecoder::FormatAtaSmartData( Sector, sizeof ( Sector ), &Translation );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"CheckSum                   \t= Invalid" ) !=
+                                                                                PXS_MINUS_ONE );
+
+    // Too short
+    DiskDataDecoder::FormatAtaSmartData( Sector, sizeof ( Sector ) - 1, &Translation );
+    PXS_TEST_CHECK( Translation.IsEmpty() );
+    DiskDataDecoder::FormatAtaSmartData( nullptr, 0, &Translation );
+    PXS_TEST_CHECK( Translation.IsEmpty() );
+}
+
+//===============================================================================================//
+//  Description:
+//      The Critical Warning bits and the 128-bit counters of the health log
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestNvmeHealthLog()
+{
+    BYTE   Page[ DiskDataDecoder::NVME_HEALTH_LOG_SIZE ];
+    String Translation;
+
+    MakeNvmeHealthLog( 0x05, Page );
+    DiskDataDecoder::FormatNvmeHealthLog( Page, sizeof ( Page ), &Translation );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"Critical Warning           \t= 0x00000005" ) !=
+                                                                                PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"\tSpare Below Threshold\t= 1\r\n" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"\tTemperature          \t= 0\r\n" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"\tReliability Degraded \t= 1\r\n" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"\tRead Only            \t= 0\r\n" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"\tVolatile Backup Fail \t= 0\r\n" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"Composite Temperature      \t= 310 K (37 C)" ) !=
+                                                                                PXS_MINUS_ONE );
+
+    // Lower 64 bits only, a count too large for bytes has no size
+    PXS_TEST_CHECK( Translation.IndexOfI( L"Data Units Read            \t= 4294967296 (" ) !=
+                                                                                PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI(
+                        L"Data Units Written         \t= 18446744073709551615\r\n" ) !=
+                                                                                PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"Power Cycles               \t= 1234\r\n" ) !=
+                                                                                PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"Power On Hours             \t= 12345\r\n" ) !=
+                                                                                PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"Temperature Sensor 2       \t= 305 K (32 C)" ) !=
+                                                                                PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"Temperature Sensor 1" ) == PXS_MINUS_ONE );
+
+    MakeNvmeHealthLog( 0x1A, Page );
+    DiskDataDecoder::FormatNvmeHealthLog( Page, sizeof ( Page ), &Translation );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"\tSpare Below Threshold\t= 0\r\n" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"\tTemperature          \t= 1\r\n" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"\tRead Only            \t= 1\r\n" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"\tVolatile Backup Fail \t= 1\r\n" ) != PXS_MINUS_ONE );
+
+    DiskDataDecoder::FormatNvmeHealthLog( Page, sizeof ( Page ) - 1, &Translation );
+    PXS_TEST_CHECK( Translation.IsEmpty() );
+}
+
+//===============================================================================================//
+//  Description:
+//      The controller's 128-bit capacity uses only the lower 64 bits
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestNvmeController()
+{
+    BYTE   Page[ DiskDataDecoder::NVME_IDENTIFY_SIZE ];
+    String Translation;
+
+    MakeNvmeController( 1000204886016ULL, Page );
+    DiskDataDecoder::FormatNvmeControllerData( Page, sizeof ( Page ), &Translation );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"Serial Number              \t= S4EWNX0N123456\r\n" ) !=
+                                                                                PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"Firmware Revision          \t= 2B2QEXM7\r\n" ) !=
+                                                                                PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"Version                    \t= 1.3.0\r\n" ) !=
+                                                                                PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"Warning Temperature        \t= 358 K (85 C)" ) !=
+                                                                                PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Translation.IndexOfI( L"Critical Temperature       \t= \r\n" ) !=
+                                                                                PXS_MINUS_ONE );
+
+    DiskDataDecoder::FormatNvmeControllerData( Page, sizeof ( Page ) - 1, &Translation );
+    PXS_TEST_CHECK( Translation.IsEmpty() );
+}
+
+//===============================================================================================//
+//  Description:
+//      Decode a directory of ATA and NVMe fixtures into records
+//
+//  Parameters:
+//      DirectoryPath - where to write the fixtures
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestDecodeDirectory( const String& DirectoryPath )
+{
+    BYTE   Sector[ DiskDataDecoder::ATA_SECTOR_SIZE ];
+    BYTE   Page[ DiskDataDecoder::NVME_IDENTIFY_SIZE ];
+    String Value, Translations, LocaleYes;
+    TArray< AuditRecord > Records;
+
+    PXSGetResourceString( PXS_IDS_1261_YES, &LocaleYes );
+
+    MakeAtaIdentify( Sector );
+    WriteFixture( DirectoryPath, L"disk0.idd", Sector, sizeof ( Sector ) );
+    MakeAtaSmart( 5, Sector );
+    WriteFixture( DirectoryPath, L"disk0.smart", Sector, sizeof ( Sector ) );
+
+    MakeNvmeController( 1000204886016ULL, Page );
+    WriteFixture( DirectoryPath, L"disk1.nvid", Page, sizeof ( Page ) );
+    MakeNvmeHealthLog( 0x00, Page );
+    WriteFixture( DirectoryPath, L"disk1.nvlog", Page, DiskDataDecoder::NVME_HEALTH_LOG_SIZE );
+
+    // No controller capacity so from the namespace, short log is skipped
+    MakeNvmeController( 0, Page );
+    WriteFixture( DirectoryPath, L"disk2.nvid", Page, sizeof ( Page ) );
+    MakeNvmeNamespace( 244190646, Page );
+    WriteFixture( DirectoryPath, L"disk2.nvns", Page, sizeof ( Page ) );
+    MakeNvmeHealthLog( 0x04, Page );
+    WriteFixture( DirectoryPath, L"disk2.nvlog", Page, 100 );
+
+    // Critical warning without the other pages
+    MakeNvmeHealthLog( 0x04, Page );
+    WriteFixture( DirectoryPath, L"disk3.nvlog", Page, DiskDataDecoder::NVME_HEALTH_LOG_SIZE );
+
+    DiskDataDecoder::DecodeDirectory( DirectoryPath, &Records, &Translations );
+    PXS_TEST_CHECK( Records.GetSize() == 4 );
+    if ( Records.GetSize() != 4 )
+    {
+        DeleteFixtures( DirectoryPath );
+        return;
+    }
+
+    // ATA, 48-bit sector count and byte swapped strings
+    const AuditRecord& Ata = Records.Get( 0 );
+    Ata.GetItemValue( PXS_PHYS_DISKS_TYPE, &Value );
+    PXS_TEST_CHECK( Value.Compare( L"ATA Solid State", true ) == 0 );
+    Ata.GetItemValue( PXS_PHYS_DISKS_SERIAL_NUMBER, &Value );
+    PXS_TEST_CHECK( Value.Compare( L"S08EJ1OA125287", true ) == 0 );
+    Ata.GetItemValue( PXS_PHYS_DISKS_MODEL, &Value );
+    PXS_TEST_CHECK( Value.Compare( L"WDC WDS100T2B0A", true ) == 0 );
+    Ata.GetItemValue( PXS_PHYS_DISKS_FIRMWARE_REV, &Value );
+    PXS_TEST_CHECK( Value.Compare( L"01.01A01", true ) == 0 );
+    Ata.GetItemValue( PXS_PHYS_DISKS_MANUFACTURER, &Value );
+    PXS_TEST_CHECK( Value.Compare( PXS_HDD_MANUFACTURER_WESTERN, true ) == 0 );
+    Ata.GetItemValue( PXS_PHYS_DISKS_CAPACITY_MB, &Value );
+    PXS_TEST_CHECK( Value.StartsWith( L"953869", true ) );
+    Ata.GetItemValue( PXS_PHYS_DISKS_TOTAL_HEADS, &Value );
+    PXS_TEST_CHECK( Value.Compare( L"16", true ) == 0 );
+    Ata.GetItemValue( PXS_PHYS_DISKS_SMART_ENABLED, &Value );
+    PXS_TEST_CHECK( Value.Compare( LocaleYes, true ) == 0 );
+    Ata.GetItemValue( PXS_PHYS_DISKS_SMART_SELF_TEST, &Value );
+    PXS_TEST_CHECK( Value.Compare( L"Failed with code 5", true ) == 0 );
+
+    // NVMe, capacity from the lower 64 bits
+    const AuditRecord& Nvme = Records.Get( 1 );
+    Nvme.GetItemValue( PXS_PHYS_DISKS_TYPE, &Value );
+    PXS_TEST_CHECK( Value.Compare( L"NVMe", true ) == 0 );
+    Nvme.GetItemValue( PXS_PHYS_DISKS_SERIAL_NUMBER, &Value );
+    PXS_TEST_CHECK( Value.Compare( L"S4EWNX0N123456", true ) == 0 );
+    Nvme.GetItemValue( PXS_PHYS_DISKS_MANUFACTURER, &Value );
+    PXS_TEST_CHECK( Value.Compare( PXS_HDD_MANUFACTURER_SAMSUNG, true ) == 0 );
+    Nvme.GetItemValue( PXS_PHYS_DISKS_CAPACITY_MB, &Value );
+    PXS_TEST_CHECK( Value.StartsWith( L"953869", true ) );
+    Nvme.GetItemValue( PXS_PHYS_DISKS_CRITICAL_WARN, &Value );
+    PXS_TEST_CHECK( Value.Compare( L"None", true ) == 0 );
+
+    // Capacity from the namespace, no valid log so no warning
+    Records.Get( 2 ).GetItemValue( PXS_PHYS_DISKS_CAPACITY_MB, &Value );
+    PXS_TEST_CHECK( Value.StartsWith( L"953869", true ) );
+    Records.Get( 2 ).GetItemValue( PXS_PHYS_DISKS_CRITICAL_WARN, &Value );
+    PXS_TEST_CHECK( Value.IsEmpty() );
+
+    Records.Get( 3 ).GetItemValue( PXS_PHYS_DISKS_CRITICAL_WARN, &Value );
+    PXS_TEST_CHECK( Value.Compare( L"0x00000004", true ) == 0 );
+    Records.Get( 3 ).GetItemValue( PXS_PHYS_DISKS_CAPACITY_MB, &Value );
+    PXS_TEST_CHECK( Value.IsEmpty() );
+
+    Records.Get( 3 ).GetItemValue( PXS_PHYS_DISKS_ITEM_NUMBER, &Value );
+    PXS_TEST_CHECK( Value.Compare( L"4", true ) == 0 );
+    PXS_TEST_CHECK( Translations.IndexOfI( L"\r\ndisk2\r\n" ) != PXS_MINUS_ONE );
+
+    DeleteFixtures( DirectoryPath );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Suite
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Run the disk data decoder tests
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void RunDiskDataDecoderTests()
+{
+    String    DirectoryPath;
+    Formatter Format;
+
+    Directory::GetTempDirectory( &DirectoryPath );
+    DirectoryPath += Format.StringUInt32( L"WinAuditDiskDataTests_%%1", GetCurrentProcessId() );
+    Directory::CreateNew( DirectoryPath );
+
+    TestSerialByteSwap();
+    TestAtaSmartAttributes();
+    TestNvmeHealthLog();
+    TestNvmeController();
+    TestDecodeDirectory( DirectoryPath );
+
+    Directory::Delete( DirectoryPath );
+}
@@ -0,0 +1,335 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Disk Information Unit Tests
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The rows are recorded Win32_DiskDrive and Win32_PhysicalMedia results so
+// the tests do not depend on this computer's disks or on WMI.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Test Files/WinAuditTests.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/Exception.h"
+#include "PxsBase/Header Files/StringArray.h"
+#include "PxsBase/Header Files/TArray.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/DiskInformation.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Fixtures
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The values of one drive as returned by GetWmiDiskValues
+typedef struct _TYPE_WMI_DISK_VALUES
+{
+    UINT64 diskSizeBytes;
+    UINT64 totalCylinders;
+    DWORD  totalHeads;
+    DWORD  sectorsPerTrack;
+    String MediaType;
+    String ManufacturerName;
+    String Model;
+    String SerialNumber;
+    String FirmwareRevision;
+} TYPE_WMI_DISK_VALUES;
+
+//===============================================================================================//
+//  Description:
+//      Add a recorded WMI row to a fixture
+//
+//  Parameters:
+//      pszRow - the column values separated by vertical bars
+//      pRows  - the fixture's rows
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void AddRow( LPCWSTR pszRow, TArray< StringArray >* pRows )
+{
+    String      Row;
+    StringArray Columns;
+
+    Row = pszRow;
+    Row.ToArray( '|', &Columns );
+    pRows->Add( Columns );
+}
+
+//===============================================================================================//
+//  Description:
+//      Make the recorded Win32_DiskDrive and Win32_PhysicalMedia rows
+//
+//  Parameters:
+//      pDiskDrives    - receives the Win32_DiskDrive rows
+//      pPhysicalMedia - receives the Win32_PhysicalMedia rows
+//
+//  Remarks:
+//      PhysicalDrive0 is an XP style row without the serial number and
+//      firmware revision columns.
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void MakeRows( TArray< StringArray >* pDiskDrives, TArray< StringArray >* pPhysicalMedia )
+{
+    pDiskDrives->RemoveAll();
+    pPhysicalMedia->RemoveAll();
+
+    AddRow( L"\\\\.\\PHYSICALDRIVE10|500105249280|60801|255|63|Fixed hard disk media"
+            L"|(Standard disk drives)|WDC WD5000AAKX|3|0|WD-WCAYUJ012345|15.01H15", pDiskDrives );
+    AddRow( L"\\\\.\\PHYSICALDRIVE1|1000202273280|121601|255|63|Fixed hard disk media"
+            L"|(Standard disk drives)|Samsung SSD 860 EVO 1TB|0|1|3SZ9BNK01234564A|RVT02B6Q",
+            pDiskDrives );
+    AddRow( L"\\\\.\\PHYSICALDRIVE0|80023749120|9729|255|63|Fixed hard disk media"
+            L"|(Standard disk drives)|ST380011A|1|0", pDiskDrives );
+    AddRow( L"\\\\.\\physicaldrive2|256052966400|31130|255|63|Fixed hard disk media"
+            L"|(Standard disk drives)|INTEL SSDSC2KW256G8|2|0|BTLA1234567890|LHF002C", pDiskDrives );
+    AddRow( L"\\\\.\\PHYSICALDRIVE3", pDiskDrives );
+    AddRow( L"", pDiskDrives );
+    AddRow( L"\\\\.\\PHYSICALDRIVE4|0|0|0|0|Removable Media|(Standard disk drives)"
+            L"|USB Flash Disk|||0011223344|1100", pDiskDrives );
+    AddRow( L"\\\\.\\PHYSICALDRIVE5|0|0|0|0|Fixed hard disk media|(Standard disk drives)"
+            L"|Virtual Disk|200|0||", pDiskDrives );
+
+    AddRow( L"\\\\.\\PHYSICALDRIVE1|        S3Z9NB0K123456A ", pPhysicalMedia );
+    AddRow( L"\\\\.\\PHYSICALDRIVE2|   ", pPhysicalMedia );
+    AddRow( L"\\\\.\\PHYSICALDRIVE0", pPhysicalMedia );
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the values of a drive from the recorded rows
+//
+//  Parameters:
+//      physicalDrive  - the OS drive number
+//      DiskDrives     - the Win32_DiskDrive rows
+//      PhysicalMedia  - the Win32_PhysicalMedia rows
+//      pValues        - receives the values
+//
+//  Returns:
+//      true if the drive has a row, otherwise false
+//===============================================================================================//
+static bool ValuesOf( BYTE physicalDrive,
+                      const TArray< StringArray >& DiskDrives,
+                      const TArray< StringArray >& PhysicalMedia, TYPE_WMI_DISK_VALUES* pValues )
+{
+    return DiskInformation::GetWmiDiskValues( physicalDrive,
+                                              DiskDrives,
+                                              PhysicalMedia,
+                                              &pValues->diskSizeBytes,
+                                              &pValues->totalCylinders,
+                                              &pValues->totalHeads,
+                                              &pValues->sectorsPerTrack,
+                                              &pValues->MediaType,
+                                              &pValues->ManufacturerName,
+                                              &pValues->Model,
+                                              &pValues->SerialNumber, &pValues->FirmwareRevision );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      A drive number only matches its own device id, without regard to case
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestFindRow()
+{
+    const StringArray* pRow = nullptr;
+    TArray< StringArray > DiskDrives, PhysicalMedia, NoRows;
+
+    MakeRows( &DiskDrives, &PhysicalMedia );
+
+    // PhysicalDrive10 comes first but is not drive 1
+    pRow = DiskInformation::FindWmiDiskRow( 1, DiskDrives );
+    PXS_TEST_CHECK( pRow != nullptr );
+    if ( pRow )
+    {
+        PXS_TEST_CHECK( pRow->Get( DiskInformation::WMI_DISK_MODEL ).Compare(
+                                                         L"Samsung SSD 860 EVO 1TB", true ) == 0 );
+    }
+    pRow = DiskInformation::FindWmiDiskRow( 10, DiskDrives );
+    PXS_TEST_CHECK( pRow != nullptr );
+    if ( pRow )
+    {
+        PXS_TEST_CHECK( pRow->Get( DiskInformation::WMI_DISK_MODEL ).Compare(
+                                                           L"WDC WD5000AAKX", true ) == 0 );
+    }
+
+    PXS_TEST_CHECK( DiskInformation::FindWmiDiskRow( 2, DiskDrives ) != nullptr );
+    PXS_TEST_CHECK( DiskInformation::FindWmiDiskRow( 3, DiskDrives ) != nullptr );
+    PXS_TEST_CHECK( DiskInformation::FindWmiDiskRow( 9, DiskDrives ) == nullptr );
+    PXS_TEST_CHECK( DiskInformation::FindWmiDiskRow( 255, DiskDrives ) == nullptr );
+    PXS_TEST_CHECK( DiskInformation::FindWmiDiskRow( 0, NoRows ) == nullptr );
+}
+
+//===============================================================================================//
+//  Description:
+//      The controller disk number is two per SCSI port plus the target id
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestDiskNumber()
+{
+    BYTE diskNumber = 0;
+    TArray< StringArray > DiskDrives, PhysicalMedia;
+
+    MakeRows( &DiskDrives, &PhysicalMedia );
+
+    PXS_TEST_CHECK( DiskInformation::GetWmiDiskNumber( 1, DiskDrives, &diskNumber ) );
+    PXS_TEST_CHECK( diskNumber == 1 );
+    PXS_TEST_CHECK( DiskInformation::GetWmiDiskNumber( 0, DiskDrives, &diskNumber ) );
+    PXS_TEST_CHECK( diskNumber == 2 );
+    PXS_TEST_CHECK( DiskInformation::GetWmiDiskNumber( 2, DiskDrives, &diskNumber ) );
+    PXS_TEST_CHECK( diskNumber == 4 );
+    PXS_TEST_CHECK( DiskInformation::GetWmiDiskNumber( 10, DiskDrives, &diskNumber ) );
+    PXS_TEST_CHECK( diskNumber == 6 );
+
+    // Device id only, no port, port out of range and no row
+    diskNumber = 0;
+    PXS_TEST_CHECK( DiskInformation::GetWmiDiskNumber( 3, DiskDrives, &diskNumber ) == false );
+    PXS_TEST_CHECK( diskNumber == UINT8_MAX );
+    PXS_TEST_CHECK( DiskInformation::GetWmiDiskNumber( 4, DiskDrives, &diskNumber ) == false );
+    PXS_TEST_CHECK( DiskInformation::GetWmiDiskNumber( 5, DiskDrives, &diskNumber ) == false );
+    PXS_TEST_CHECK( DiskInformation::GetWmiDiskNumber( 9, DiskDrives, &diskNumber ) == false );
+    PXS_TEST_CHECK( diskNumber == UINT8_MAX );
+}
+
+//===============================================================================================//
+//  Description:
+//      The values of a drive are read from its columns and the physical
+//      media serial number is preferred when not blank
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestDiskValues()
+{
+    bool thrown = false;
+    TYPE_WMI_DISK_VALUES  Values;
+    TArray< StringArray > DiskDrives, PhysicalMedia;
+
+    MakeRows( &DiskDrives, &PhysicalMedia );
+
+    // The trimmed media serial number replaces the disk's
+    PXS_TEST_CHECK( ValuesOf( 1, DiskDrives, PhysicalMedia, &Values ) );
+    PXS_TEST_CHECK( Values.diskSizeBytes   == 1000202273280 );
+    PXS_TEST_CHECK( Values.totalCylinders  == 121601 );
+    PXS_TEST_CHECK( Values.totalHeads      == 255 );
+    PXS_TEST_CHECK( Values.sectorsPerTrack == 63 );
+    PXS_TEST_CHECK( Values.MediaType.Compare( L"Fixed hard disk media", true ) == 0 );
+    PXS_TEST_CHECK( Values.ManufacturerName.Compare( L"(Standard disk drives)", true ) == 0 );
+    PXS_TEST_CHECK( Values.Model.Compare( L"Samsung SSD 860 EVO 1TB", true ) == 0 );
+    PXS_TEST_CHECK( Values.SerialNumber.Compare( L"S3Z9NB0K123456A", true ) == 0 );
+    PXS_TEST_CHECK( Values.FirmwareRevision.Compare( L"RVT02B6Q", true ) == 0 );
+
+    // A blank media serial number keeps the disk's
+    PXS_TEST_CHECK( ValuesOf( 2, DiskDrives, PhysicalMedia, &Values ) );
+    PXS_TEST_CHECK( Values.SerialNumber.Compare( L"BTLA1234567890", true ) == 0 );
+    PXS_TEST_CHECK( Values.FirmwareRevision.Compare( L"LHF002C", true ) == 0 );
+
+    // XP style row without the serial number and firmware columns
+    PXS_TEST_CHECK( ValuesOf( 0, DiskDrives, PhysicalMedia, &Values ) );
+    PXS_TEST_CHECK( Values.diskSizeBytes == 80023749120 );
+    PXS_TEST_CHECK( Values.Model.Compare( L"ST380011A", true ) == 0 );
+    PXS_TEST_CHECK( Values.SerialNumber.IsEmpty() );
+    PXS_TEST_CHECK( Values.FirmwareRevision.IsEmpty() );
+
+    // Short and missing rows reset the values
+    PXS_TEST_CHECK( ValuesOf( 3, DiskDrives, PhysicalMedia, &Values ) == false );
+    PXS_TEST_CHECK( Values.diskSizeBytes == 0 );
+    PXS_TEST_CHECK( Values.Model.IsEmpty() );
+    PXS_TEST_CHECK( Values.SerialNumber.IsEmpty() );
+    PXS_TEST_CHECK( ValuesOf( 9, DiskDrives, PhysicalMedia, &Values ) == false );
+
+    try
+    {
+        DiskInformation::GetWmiDiskValues( 1,
+                                           DiskDrives,
+                                           PhysicalMedia,
+                                           nullptr,
+                                           &Values.totalCylinders,
+                                           &Values.totalHeads,
+                                           &Values.sectorsPerTrack,
+                                           &Values.MediaType,
+                                           &Values.ManufacturerName,
+                                           &Values.Model,
+                                           &Values.SerialNumber, &Values.FirmwareRevision );
+    }
+    catch ( const Exception& )
+    {
+        thrown = true;
+    }
+    PXS_TEST_CHECK( thrown );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Suite
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Run the WMI disk row tests
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void RunDiskInformationTests()
+{
+    TestFindRow();
+    TestDiskNumber();
+    TestDiskValues();
+}
@@ -0,0 +1,606 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// EDID Decoder Unit Tests
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The fixtures are built in memory from a valid base block and extension
+// blocks then damaged one field at a time. The random blocks are allocated
+// to their exact size so an address sanitizer build reports any read past
+// the end.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Test Files/WinAuditTests.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/AllocateBytes.h"
+#include "PxsBase/Header Files/ByteArray.h"
+#include "PxsBase/Header Files/Directory.h"
+#include "PxsBase/Header Files/Exception.h"
+#include "PxsBase/Header Files/File.h"
+#include "PxsBase/Header Files/Formatter.h"
+#include "PxsBase/Header Files/StringArray.h"
+#include "PxsBase/Header Files/TArray.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/AuditRecord.h"
+#include "WinAudit/Header Files/EdidDecoder.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Fixtures
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Detailed timing of 1920 x 1080 @ 60Hz, 148.5MHz
+static const BYTE DETAILED_TIMING[] = { 0x02, 0x3A, 0x80, 0x18, 0x71, 0x38, 0x2D, 0x40 };
+
+//===============================================================================================//
+//  Description:
+//      Set the checksum byte of a 128-byte block
+//
+//  Parameters:
+//      pBlock - the block
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void SetCheckSum( BYTE* pBlock )
+{
+    DWORD checkSum = 0;
+
+    for ( size_t i = 0; i < 127; i++ )
+    {
+        checkSum += pBlock[ i ];
+    }
+    pBlock[ 127 ] = static_cast<BYTE>( ( 256 - ( checkSum % 256 ) ) % 256 );
+}
+
+//===============================================================================================//
+//  Description:
+//      Make a valid EDID 1.4 base block
+//
+//  Parameters:
+//      pszName       - the monitor name, at most 12 characters
+//      numExtensions - the extension count at offset 0x7E
+//      pEdid         - receives the 128-byte block
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void MakeBaseBlock( const char* pszName, BYTE numExtensions, BYTE* pEdid )
+{
+    const BYTE HEADER[] = { 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00 };
+
+    memset( pEdid, 0, 128 );
+    memcpy( pEdid, HEADER, sizeof ( HEADER ) );
+    pEdid[ 0x08 ] = 0x10;           // DEL
+    pEdid[ 0x09 ] = 0xAC;
+    pEdid[ 0x12 ] = 1;
+    pEdid[ 0x13 ] = 4;
+    memcpy( pEdid + 0x36, DETAILED_TIMING, sizeof ( DETAILED_TIMING ) );
+
+    // Monitor name descriptor, line feed terminated
+    pEdid[ 0x48 + 3 ] = 0xFC;
+    memcpy( pEdid + 0x48 + 5, pszName, strlen( pszName ) );
+    pEdid[ 0x48 + 5 + strlen( pszName ) ] = 0x0A;
+
+    pEdid[ 0x7E ] = numExtensions;
+    SetCheckSum( pEdid );
+}
+
+//===============================================================================================//
+//  Description:
+//      Make a valid CEA-861 revision 3 extension block
+//
+//  Parameters:
+//      pBlock - receives the 128-byte block
+//
+//  Remarks:
+//      A video data block of VIC 16 (native) and 4 then one detailed timing
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void MakeCeaBlock( BYTE* pBlock )
+{
+    memset( pBlock, 0, 128 );
+    pBlock[ 0 ] = 0x02;
+    pBlock[ 1 ] = 3;
+    pBlock[ 2 ] = 7;                // Detailed timings offset
+    pBlock[ 4 ] = 0x42;             // Video, 2 bytes
+    pBlock[ 5 ] = 0x90;
+    pBlock[ 6 ] = 0x04;
+    memcpy( pBlock + 7, DETAILED_TIMING, sizeof ( DETAILED_TIMING ) );
+    SetCheckSum( pBlock );
+}
+
+//===============================================================================================//
+//  Description:
+//      Make a valid DisplayID 1.2 extension block with one Type I timing
+//
+//  Parameters:
+//      pBlock - receives the 128-byte block
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void MakeDisplayIdBlock( BYTE* pBlock )
+{
+    // 1920 x 1080, each value stored less one
+    const BYTE TIMING[] = { 0x01, 0x3A, 0x00, 0x00, 0x7F, 0x07, 0x17, 0x01, 0x00, 0x00,
+                            0x00, 0x00, 0x37, 0x04, 0x2C, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+    memset( pBlock, 0, 128 );
+    pBlock[ 0 ] = 0x70;
+    pBlock[ 1 ] = 0x12;
+    pBlock[ 2 ] = 3 + sizeof ( TIMING );
+    pBlock[ 5 ] = 0x03;             // Type I timing
+    pBlock[ 7 ] = sizeof ( TIMING );
+    memcpy( pBlock + 8, TIMING, sizeof ( TIMING ) );
+    SetCheckSum( pBlock );
+}
+
+//===============================================================================================//
+//  Description:
+//      Write a fixture file
+//
+//  Parameters:
+//      FilePath - path of the file
+//      pBuffer  - the contents
+//      numBytes - the number of bytes to write
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void WriteFixture( const String& FilePath, const void* pBuffer, size_t numBytes )
+{
+    File FixtureFile;
+
+    FixtureFile.CreateNew( FilePath, 0, false );
+    if ( numBytes )
+    {
+        FixtureFile.Write( pBuffer, numBytes );
+    }
+    FixtureFile.Close();
+}
+
+//===============================================================================================//
+//  Description:
+//      Determine if ReadEdidFile accepts a fixture
+//
+//  Parameters:
+//      FilePath - path of the fixture file
+//      pText    - the file's contents
+//      pEdid    - receives the data read
+//
+//  Returns:
+//      true if read an EDID block, otherwise false
+//===============================================================================================//
+static bool ReadTextFixture( const String& FilePath, const char* pText, ByteArray* pEdid )
+{
+    WriteFixture( FilePath, pText, strlen( pText ) );
+    return EdidDecoder::ReadEdidFile( FilePath, pEdid );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Binary and hex text dumps are read, truncated or malformed ones are not
+//
+//  Parameters:
+//      DirectoryPath - where to write the fixtures
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestReadEdidFile( const String& DirectoryPath )
+{
+    size_t    i = 0, numChars = 0;
+    char      szText[ 1024 ] = { 0 };
+    const char* pszSeparator = nullptr;
+    BYTE      Edid[ 128 ];
+    String    FilePath;
+    ByteArray Read;
+
+    FilePath  = DirectoryPath;
+    FilePath += L"\\fixture.bin";
+
+    MakeBaseBlock( "TEST", 0, Edid );
+    WriteFixture( FilePath, Edid, sizeof ( Edid ) );
+    PXS_TEST_CHECK( EdidDecoder::ReadEdidFile( FilePath, &Read ) );
+    PXS_TEST_CHECK( Read.GetSize() == sizeof ( Edid ) );
+    PXS_TEST_CHECK( Read.Compare( 0, Edid, sizeof ( Edid ) ) == 0 );
+
+    // Truncated binary block
+    WriteFixture( FilePath, Edid, sizeof ( Edid ) - 1 );
+    PXS_TEST_CHECK( EdidDecoder::ReadEdidFile( FilePath, &Read ) == false );
+
+    WriteFixture( FilePath, Edid, 0 );
+    PXS_TEST_CHECK( EdidDecoder::ReadEdidFile( FilePath, &Read ) == false );
+
+    // Hex text with the 0x prefix and separators
+    for ( i = 0; i < sizeof ( Edid ); i++ )
+    {
+        pszSeparator = ( ( i % 16 ) == 15 ) ? "\r\n" : ", ";
+        StringCchPrintfA( szText + numChars,
+                          ARRAYSIZE( szText ) - numChars, "0x%02X%s", Edid[ i ], pszSeparator );
+        numChars = strlen( szText );
+    }
+    PXS_TEST_CHECK( ReadTextFixture( FilePath, szText, &Read ) );
+    PXS_TEST_CHECK( Read.Compare( 0, Edid, sizeof ( Edid ) ) == 0 );
+
+    // Half a block, an odd digit, a bad digit and a misplaced x
+    PXS_TEST_CHECK( ReadTextFixture( FilePath, "00 FF FF FF FF FF FF 00", &Read ) == false );
+    PXS_TEST_CHECK( ReadTextFixture( FilePath, "00 FF FF FF FF FF FF 0", &Read ) == false );
+    PXS_TEST_CHECK( ReadTextFixture( FilePath, "00 FF FF FF FF FF FF 0G", &Read ) == false );
+    PXS_TEST_CHECK( ReadTextFixture( FilePath, "1x00", &Read ) == false );
+    PXS_TEST_CHECK( ReadTextFixture( FilePath, "0 0", &Read ) == false );
+
+    File::Delete( FilePath );
+}
+
+//===============================================================================================//
+//  Description:
+//      A bad checksum is reported but the block is still translated
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestBaseBlockCheckSum()
+{
+    bool   validHeader = false, validCheckSum = false;
+    BYTE   Edid[ 128 ];
+    String VersionRev, ManufacturerID, ProductID, SerialNumber;
+    String ManufacDate, DigDisplay, DisplaySize, Gamma;
+    String DisplayType, MonitorSerial, TextData, MonitorName;
+    String Features, EstTimings, StdTimings, HexData, Resolution;
+
+    MakeBaseBlock( "TEST MONITOR", 0, Edid );
+    EdidDecoder::TranslateEdidData( Edid, sizeof ( Edid ),
+                                    &validHeader, &validCheckSum,
+                                    &VersionRev , &ManufacturerID,
+                                    &ProductID  , &SerialNumber,
+                                    &ManufacDate, &DigDisplay,
+                                    &DisplaySize, &Gamma,
+                                    &DisplayType, &MonitorSerial,
+                                    &TextData   , &MonitorName,
+                                    &Features   , &EstTimings,
+                                    &StdTimings , &HexData );
+    PXS_TEST_CHECK( validHeader );
+    PXS_TEST_CHECK( validCheckSum );
+    PXS_TEST_CHECK( VersionRev.CompareI( L"1.4" ) == 0 );
+    PXS_TEST_CHECK( ManufacturerID.CompareI( L"DEL" ) == 0 );
+    PXS_TEST_CHECK( MonitorName.CompareI( L"TEST MONITOR" ) == 0 );
+
+    Edid[ 0x10 ]++;
+    EdidDecoder::TranslateEdidData( Edid, sizeof ( Edid ),
+                                    &validHeader, &validCheckSum,
+                                    &VersionRev , &ManufacturerID,
+                                    &ProductID  , &SerialNumber,
+                                    &ManufacDate, &DigDisplay,
+                                    &DisplaySize, &Gamma,
+                                    &DisplayType, &MonitorSerial,
+                                    &TextData   , &MonitorName,
+                                    &Features   , &EstTimings,
+                                    &StdTimings , &HexData );
+    PXS_TEST_CHECK( validHeader );
+    PXS_TEST_CHECK( validCheckSum == false );
+    PXS_TEST_CHECK( MonitorName.CompareI( L"TEST MONITOR" ) == 0 );
+
+    EdidDecoder::TranslatePreferredTiming( Edid, sizeof ( Edid ), &Resolution );
+    PXS_TEST_CHECK( Resolution.CompareI( L"1920 x 1080 pixels" ) == 0 );
+}
+
+//===============================================================================================//
+//  Description:
+//      CEA-861 blocks with bad checksums, missing blocks and bad offsets
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestCeaExtension()
+{
+    bool   thrown = false;
+    BYTE   Edid[ 256 ];
+    String Extensions;
+
+    MakeBaseBlock( "TEST", 1, Edid );
+    MakeCeaBlock( Edid + 128 );
+    EdidDecoder::TranslateExtensionBlocks( Edid, sizeof ( Edid ), &Extensions );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"CEA-861" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"16 (native), 4" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"Detailed Timing: 1920 x 1080 @" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"invalid checksum" ) == PXS_MINUS_ONE );
+
+    // Bad checksum
+    Edid[ 128 + 126 ]++;
+    EdidDecoder::TranslateExtensionBlocks( Edid, sizeof ( Edid ), &Extensions );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"invalid checksum" ) != PXS_MINUS_ONE );
+
+    // More extensions claimed than are present, only the present one is read
+    Edid[ 0x7E ] = 3;
+    EdidDecoder::TranslateExtensionBlocks( Edid, sizeof ( Edid ), &Extensions );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"not all present, expected 3" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"Block 2" ) == PXS_MINUS_ONE );
+    EdidDecoder::TranslateExtensionBlocks( Edid, 128, &Extensions );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"Block 1" ) == PXS_MINUS_ONE );
+
+    // Detailed timing offset past the block, then too near its end
+    Edid[ 0x7E ] = 1;
+    MakeCeaBlock( Edid + 128 );
+    Edid[ 128 + 2 ] = 200;
+    EdidDecoder::TranslateExtensionBlocks( Edid, sizeof ( Edid ), &Extensions );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"Detailed Timing" ) == PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"Video" ) == PXS_MINUS_ONE );
+
+    Edid[ 128 + 2 ] = 120;
+    memcpy( Edid + 128 + 120, DETAILED_TIMING, 7 );
+    EdidDecoder::TranslateExtensionBlocks( Edid, sizeof ( Edid ), &Extensions );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"Detailed Timing" ) == PXS_MINUS_ONE );
+
+    // Data block longer than the space before the detailed timings
+    MakeCeaBlock( Edid + 128 );
+    Edid[ 128 + 4 ] = 0x45;
+    EdidDecoder::TranslateExtensionBlocks( Edid, sizeof ( Edid ), &Extensions );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"Truncated data block" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"Detailed Timing: 1920 x 1080 @" ) != PXS_MINUS_ONE );
+
+    // Less than a base block
+    try
+    {
+        EdidDecoder::TranslateExtensionBlocks( Edid, 127, &Extensions );
+    }
+    catch ( const Exception& )
+    {
+        thrown = true;
+    }
+    PXS_TEST_CHECK( thrown );
+}
+
+//===============================================================================================//
+//  Description:
+//      DisplayID blocks with section and data block lengths past the block
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestDisplayIdExtension()
+{
+    BYTE   Edid[ 256 ];
+    String Extensions;
+
+    MakeBaseBlock( "TEST", 1, Edid );
+    MakeDisplayIdBlock( Edid + 128 );
+    EdidDecoder::TranslateExtensionBlocks( Edid, sizeof ( Edid ), &Extensions );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"DisplayID" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"Version: 1.2" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"Detailed Timing: 1920 x 1080 @" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"Truncated" ) == PXS_MINUS_ONE );
+
+    // Section length past the block is limited to it
+    Edid[ 128 + 2 ] = 250;
+    SetCheckSum( Edid + 128 );
+    EdidDecoder::TranslateExtensionBlocks( Edid, sizeof ( Edid ), &Extensions );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"Detailed Timing: 1920 x 1080 @" ) != PXS_MINUS_ONE );
+
+    // Data block longer than the section
+    Edid[ 128 + 7 ] = 200;
+    SetCheckSum( Edid + 128 );
+    EdidDecoder::TranslateExtensionBlocks( Edid, sizeof ( Edid ), &Extensions );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"Truncated data block" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"Detailed Timing" ) == PXS_MINUS_ONE );
+
+    // Data block inside the block but past a short section
+    MakeDisplayIdBlock( Edid + 128 );
+    Edid[ 128 + 2 ] = 10;
+    SetCheckSum( Edid + 128 );
+    EdidDecoder::TranslateExtensionBlocks( Edid, sizeof ( Edid ), &Extensions );
+    PXS_TEST_CHECK( Extensions.IndexOfI( L"Truncated data block" ) != PXS_MINUS_ONE );
+}
+
+//===============================================================================================//
+//  Description:
+//      Random data, with and without valid headers, never reads out of
+//      bounds or throws
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestFuzzDecoding()
+{
+    const  size_t NUM_ITERATIONS = 5000;
+    bool   validHeader = false, validCheckSum = false;
+    size_t i = 0, j = 0, numBytes = 0, numExceptions = 0;
+    DWORD  seed = 0x2F6B1D03;
+    BYTE   Header[ 8 ] = { 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00 };
+    BYTE   ExtensionTags[] = { 0x02, 0x70, 0xF0, 0x10 };
+    BYTE*  pEdid = nullptr;
+    AllocateBytes AllocBytes;
+    String VersionRev, ManufacturerID, ProductID, SerialNumber;
+    String ManufacDate, DigDisplay, DisplaySize, Gamma;
+    String DisplayType, MonitorSerial, TextData, MonitorName;
+    String Features, EstTimings, StdTimings, HexData, Resolution, Extensions;
+
+    for ( i = 0; i < NUM_ITERATIONS; i++ )
+    {
+        // Exactly the size of the blocks, a fresh allocation each time
+        AllocBytes.Delete();
+        numBytes = 128 * ( 1 + ( i % 4 ) );
+        pEdid    = AllocBytes.New( numBytes );
+        for ( j = 0; j < numBytes; j++ )
+        {
+            seed       = ( seed * 1103515245 ) + 12345;
+            pEdid[ j ] = static_cast<BYTE>( seed >> 16 );
+        }
+        if ( i % 2 )
+        {
+            memcpy( pEdid, Header, sizeof ( Header ) );
+        }
+        for ( j = 128; j < numBytes; j += 128 )
+        {
+            pEdid[ j ] = ExtensionTags[ ( i + j / 128 ) % ARRAYSIZE( ExtensionTags ) ];
+        }
+
+        try
+        {
+            EdidDecoder::TranslateEdidData( pEdid, numBytes,
+                                            &validHeader, &validCheckSum,
+                                            &VersionRev , &ManufacturerID,
+                                            &ProductID  , &SerialNumber,
+                                            &ManufacDate, &DigDisplay,
+                                            &DisplaySize, &Gamma,
+                                            &DisplayType, &MonitorSerial,
+                                            &TextData   , &MonitorName,
+                                            &Features   , &EstTimings,
+                                            &StdTimings , &HexData );
+            EdidDecoder::TranslatePreferredTiming( pEdid, numBytes, &Resolution );
+            EdidDecoder::TranslateExtensionBlocks( pEdid, numBytes, &Extensions );
+        }
+        catch ( const Exception& )
+        {
+            numExceptions++;
+        }
+    }
+    PXS_TEST_CHECK( numExceptions == 0 );
+}
+
+//===============================================================================================//
+//  Description:
+//      A directory of dumps is decoded by the workers, numbered in file
+//      order with the bad files skipped
+//
+//  Parameters:
+//      DirectoryPath - where to write the fixtures
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestDecodeDirectory( const String& DirectoryPath )
+{
+    const  size_t NUM_FILES = 200;
+    size_t i = 0, numNamed = 0, itemSum = 0;
+    char   szName[ 16 ] = { 0 };
+    BYTE   Edid[ 128 ];
+    String FilePath, Value;
+    Formatter   Format;
+    StringArray FileNames;
+    TArray< AuditRecord > Records;
+
+    for ( i = 0; i < NUM_FILES; i++ )
+    {
+        StringCchPrintfA( szName, ARRAYSIZE( szName ), "MONITOR %03u", static_cast<unsigned>( i ) );
+        MakeBaseBlock( szName, 0, Edid );
+        FilePath  = DirectoryPath;
+        FilePath += Format.StringUInt32( L"\\display_%%1.bin", PXSCastSizeTToUInt32( i ) );
+        WriteFixture( FilePath, Edid, ( i % 10 ) == 9 ? 100 : sizeof ( Edid ) );
+    }
+
+    EdidDecoder::DecodeDirectory( DirectoryPath, &Records );
+    PXS_TEST_CHECK( Records.GetSize() == NUM_FILES - ( NUM_FILES / 10 ) );
+    for ( i = 0; i < Records.GetSize(); i++ )
+    {
+        Records.Get( i ).GetItemValue( PXS_DISPLAY_EDID_DISPLAY_NAME, &Value );
+        if ( Value.StartsWithI( L"MONITOR " ) )
+        {
+            numNamed++;
+        }
+        Records.Get( i ).GetItemValue( PXS_DISPLAY_EDID_ITEM_NUMBER, &Value );
+        itemSum += Format.StringToUInt32( Value );
+    }
+    PXS_TEST_CHECK( numNamed == Records.GetSize() );
+    PXS_TEST_CHECK( itemSum == ( Records.GetSize() * ( Records.GetSize() + 1 ) ) / 2 );
+
+    // Sorted by display name
+    Records.Get( 0 ).GetItemValue( PXS_DISPLAY_EDID_DISPLAY_NAME, &Value );
+    PXS_TEST_CHECK( Value.CompareI( L"MONITOR 000" ) == 0 );
+
+    Directory::ListFiles( DirectoryPath, PXS_STRING_EMPTY, &FileNames );
+    for ( i = 0; i < FileNames.GetSize(); i++ )
+    {
+        FilePath  = DirectoryPath;
+        FilePath += PXS_PATH_SEPARATOR;
+        FilePath += FileNames.Get( i );
+        File::Delete( FilePath );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Suite
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Run the EDID decoder tests
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void RunEdidDecoderTests()
+{
+    String    DirectoryPath;
+    Formatter Format;
+
+    Directory::GetTempDirectory( &DirectoryPath );
+    DirectoryPath += Format.StringUInt32( L"WinAuditEdidTests_%%1", GetCurrentProcessId() );
+    Directory::CreateNew( DirectoryPath );
+
+    TestReadEdidFile( DirectoryPath );
+    TestBaseBlockCheckSum();
+    TestCeaExtension();
+    TestDisplayIdExtension();
+    TestFuzzDecoding();
+    TestDecodeDirectory( DirectoryPath );
+
+    Directory::Delete( DirectoryPath );
+}
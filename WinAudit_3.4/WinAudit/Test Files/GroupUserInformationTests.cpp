@@ -0,0 +1,328 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Group User Information Unit Tests
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The membership indexes are built from recorded group to member arrays so
+// the tests do not depend on this computer's accounts. Only the fallback
+// test calls the network management functions, for an account that does not
+// exist.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Test Files/WinAuditTests.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/Exception.h"
+#include "PxsBase/Header Files/StringArray.h"
+#include "PxsBase/Header Files/StringHashIndex.h"
+#include "PxsBase/Header Files/TArray.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/GroupUserInformation.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Fixtures
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// A membership index and the data it indexes
+typedef struct _TYPE_MEMBERSHIP_FIXTURE
+{
+    StringArray     GroupNames;
+    StringArray     Members;
+    StringArray     GroupLists;
+    StringHashIndex MemberIndex;
+    TArray< StringArray > GroupMembers;
+} TYPE_MEMBERSHIP_FIXTURE;
+
+//===============================================================================================//
+//  Description:
+//      Add a group and its members to a fixture
+//
+//  Parameters:
+//      pszGroupName - the group name
+//      pszMembers   - the member names separated by semi-colons
+//      pFixture     - the fixture
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void AddGroup( LPCWSTR pszGroupName, LPCWSTR pszMembers, TYPE_MEMBERSHIP_FIXTURE* pFixture )
+{
+    String      Members;
+    StringArray MemberNames;
+
+    Members = pszMembers;
+    if ( Members.GetLength() )
+    {
+        Members.ToArray( ';', &MemberNames );
+    }
+    pFixture->GroupNames.Add( pszGroupName );
+    pFixture->GroupMembers.Add( MemberNames );
+}
+
+//===============================================================================================//
+//  Description:
+//      Build the membership index of a fixture
+//
+//  Parameters:
+//      pszDomainPrefix - the local account domain prefix, empty for global
+//      pFixture        - the fixture
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void BuildIndex( LPCWSTR pszDomainPrefix, TYPE_MEMBERSHIP_FIXTURE* pFixture )
+{
+    String DomainPrefix;
+
+    DomainPrefix = pszDomainPrefix;
+    GroupUserInformation::MakeMembershipIndex( pFixture->GroupNames,
+                                               pFixture->GroupMembers,
+                                               DomainPrefix,
+                                               &pFixture->Members,
+                                               &pFixture->GroupLists, &pFixture->MemberIndex );
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the groups of an account from a fixture's index
+//
+//  Parameters:
+//      Fixture      - the fixture
+//      pszMember    - the account name
+//
+//  Returns:
+//      The comma separated group names
+//===============================================================================================//
+static String GroupsOf( const TYPE_MEMBERSHIP_FIXTURE& Fixture, LPCWSTR pszMember )
+{
+    String Member, Groups;
+
+    Member = pszMember;
+    GroupUserInformation::GetMemberGroups( Member,
+                                           true,
+                                           true,
+                                           Fixture.Members,
+                                           Fixture.GroupLists, Fixture.MemberIndex, &Groups );
+    return Groups;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Each account's groups are listed alphabetically whatever the order
+//      of the groups
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestAlphabeticalOrder()
+{
+    TYPE_MEMBERSHIP_FIXTURE Fixture;
+
+    AddGroup( L"Users"           , L"Alice;Bob"  , &Fixture );
+    AddGroup( L"administrators"  , L"Alice"      , &Fixture );
+    AddGroup( L"Remote Users"    , L""           , &Fixture );
+    AddGroup( L"Backup Operators", L"Bob;Alice"  , &Fixture );
+    BuildIndex( L"", &Fixture );
+
+    PXS_TEST_CHECK( Fixture.Members.GetSize() == 2 );
+    PXS_TEST_CHECK( GroupsOf( Fixture, L"Alice" ).Compare(
+                                        L"administrators, Backup Operators, Users", true ) == 0 );
+    PXS_TEST_CHECK( GroupsOf( Fixture, L"Bob" ).Compare( L"Backup Operators, Users", true ) == 0 );
+    PXS_TEST_CHECK( GroupsOf( Fixture, L"Carol" ).IsEmpty() );
+    PXS_TEST_CHECK( GroupsOf( Fixture, L"" ).IsEmpty() );
+}
+
+//===============================================================================================//
+//  Description:
+//      Account names are matched without regard to case
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestCaseInsensitiveMatching()
+{
+    TYPE_MEMBERSHIP_FIXTURE Fixture;
+
+    AddGroup( L"Guests"  , L"ALICE"           , &Fixture );
+    AddGroup( L"Users"   , L"alice;Bob"       , &Fixture );
+    AddGroup( L"Auditors", L"aLiCe;BOB;Carol" , &Fixture );
+    BuildIndex( L"", &Fixture );
+
+    PXS_TEST_CHECK( Fixture.Members.GetSize() == 3 );
+    PXS_TEST_CHECK( GroupsOf( Fixture, L"Alice" ).Compare( L"Auditors, Guests, Users",
+                                                           true ) == 0 );
+    PXS_TEST_CHECK( GroupsOf( Fixture, L"alice" ).Compare( L"Auditors, Guests, Users",
+                                                           true ) == 0 );
+    PXS_TEST_CHECK( GroupsOf( Fixture, L"bob" ).Compare( L"Auditors, Users", true ) == 0 );
+    PXS_TEST_CHECK( GroupsOf( Fixture, L"CAROL" ).Compare( L"Auditors", true ) == 0 );
+    PXS_TEST_CHECK( GroupsOf( Fixture, L"Alic" ).IsEmpty() );
+}
+
+//===============================================================================================//
+//  Description:
+//      Only local group members in the account domain are indexed, without
+//      the domain
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestDomainPrefix()
+{
+    TYPE_MEMBERSHIP_FIXTURE Fixture;
+
+    AddGroup( L"Administrators",
+              L"PC01\\Alice;CORP\\Domain Admins;NT AUTHORITY\\SYSTEM", &Fixture );
+    AddGroup( L"Users",
+              L"pc01\\Bob;PC01X\\Dave;Eve;PC01\\;CORP\\Alice", &Fixture );
+    BuildIndex( L"PC01\\", &Fixture );
+
+    PXS_TEST_CHECK( Fixture.Members.GetSize() == 2 );
+    PXS_TEST_CHECK( GroupsOf( Fixture, L"Alice" ).Compare( L"Administrators", true ) == 0 );
+    PXS_TEST_CHECK( GroupsOf( Fixture, L"Bob" ).Compare( L"Users", true ) == 0 );
+    PXS_TEST_CHECK( GroupsOf( Fixture, L"PC01\\Alice" ).IsEmpty() );
+    PXS_TEST_CHECK( GroupsOf( Fixture, L"Domain Admins" ).IsEmpty() );
+    PXS_TEST_CHECK( GroupsOf( Fixture, L"Dave" ).IsEmpty() );
+    PXS_TEST_CHECK( GroupsOf( Fixture, L"Eve" ).IsEmpty() );
+
+    // Global groups are not filtered
+    BuildIndex( L"", &Fixture );
+    PXS_TEST_CHECK( GroupsOf( Fixture, L"Eve" ).Compare( L"Users", true ) == 0 );
+    PXS_TEST_CHECK( GroupsOf( Fixture, L"CORP\\Alice" ).Compare( L"Users", true ) == 0 );
+}
+
+//===============================================================================================//
+//  Description:
+//      When one index fails to build its lookups fall back to per account
+//      calls and the other index is still used
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestIndexFallback()
+{
+    bool   haveLocalIndex = false, haveGlobalIndex = false, thrown = false;
+    String Member, Groups;
+    TYPE_MEMBERSHIP_FIXTURE Local, Global;
+
+    AddGroup( L"Users", L"PC01\\WinAuditNoSuchUser", &Local );
+    try
+    {
+        BuildIndex( L"PC01\\", &Local );
+        haveLocalIndex = true;
+    }
+    catch ( const Exception& )
+    {
+        haveLocalIndex = false;
+    }
+
+    // A group without its member array fails and leaves an empty index
+    AddGroup( L"Domain Users", L"WinAuditNoSuchUser", &Global );
+    BuildIndex( L"", &Global );
+    PXS_TEST_CHECK( GroupsOf( Global, L"WinAuditNoSuchUser" ).Compare( L"Domain Users",
+                                                                       true ) == 0 );
+    Global.GroupNames.Add( L"Domain Guests" );
+    try
+    {
+        BuildIndex( L"", &Global );
+        haveGlobalIndex = true;
+    }
+    catch ( const Exception& )
+    {
+        thrown = true;
+    }
+    PXS_TEST_CHECK( haveLocalIndex );
+    PXS_TEST_CHECK( thrown && ( haveGlobalIndex == false ) );
+    PXS_TEST_CHECK( Global.Members.GetSize() == 0 );
+    PXS_TEST_CHECK( Global.MemberIndex.GetSize() == 0 );
+
+    Member = L"WinAuditNoSuchUser";
+    GroupUserInformation::GetMemberGroups( Member,
+                                           true,
+                                           haveLocalIndex,
+                                           Local.Members,
+                                           Local.GroupLists, Local.MemberIndex, &Groups );
+    PXS_TEST_CHECK( Groups.Compare( L"Users", true ) == 0 );
+
+    // Falls back to asking for the account's groups, which logs the error
+    Groups = L"Stale";
+    GroupUserInformation::GetMemberGroups( Member,
+                                           false,
+                                           haveGlobalIndex,
+                                           Global.Members,
+                                           Global.GroupLists, Global.MemberIndex, &Groups );
+    PXS_TEST_CHECK( Groups.IsEmpty() );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Suite
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Run the group membership index tests
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void RunGroupUserInformationTests()
+{
+    TestAlphabeticalOrder();
+    TestCaseInsensitiveMatching();
+    TestDomainPrefix();
+    TestIndexFallback();
+}
@@ -0,0 +1,317 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Process Information Unit Tests
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The snapshots are loaded with SetProcesses so the tests do not depend on
+// what is running. The version cache tests use a copy of kernel32.dll so the
+// file can be deleted to show a second lookup does not read it again.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Test Files/WinAuditTests.h"
+
+// 2. C System Files
+#include <ShlObj.h>
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/Directory.h"
+#include "PxsBase/Header Files/Exception.h"
+#include "PxsBase/Header Files/File.h"
+#include "PxsBase/Header Files/Formatter.h"
+#include "PxsBase/Header Files/StringArray.h"
+#include "PxsBase/Header Files/TArray.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/ProcessInformation.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Fixtures
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Add a process to a snapshot fixture
+//
+//  Parameters:
+//      processID   - the process id
+//      pszExePath  - the executable path
+//      pProcessIDs - the fixture's process ids
+//      pExePaths   - the fixture's executable paths
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void AddFixture( DWORD processID,
+                        LPCWSTR pszExePath, TArray< DWORD >* pProcessIDs, StringArray* pExePaths )
+{
+    pProcessIDs->Add( processID );
+    pExePaths->Add( pszExePath );
+}
+
+//===============================================================================================//
+//  Description:
+//      Get the executable path of a process in the snapshot
+//
+//  Parameters:
+//      Processes - the snapshot
+//      processID - the process id
+//
+//  Returns:
+//      The path, empty if not found
+//===============================================================================================//
+static String ExePathOf( const ProcessInformation& Processes, DWORD processID )
+{
+    String ExePath;
+
+    Processes.GetExePath( processID, &ExePath );
+    return ExePath;
+}
+
+//===============================================================================================//
+//  Description:
+//      Copy kernel32.dll, which has a version resource, to a fixture path
+//
+//  Parameters:
+//      FilePath - where to put the copy
+//
+//  Returns:
+//      true if copied, otherwise false
+//===============================================================================================//
+static bool CopyVersionedFile( const String& FilePath )
+{
+    String SourcePath;
+
+    Directory::GetSpecialDirectory( CSIDL_SYSTEM, &SourcePath );
+    if ( SourcePath.EndsWithCharacterI( PXS_PATH_SEPARATOR ) == false )
+    {
+        SourcePath += PXS_PATH_SEPARATOR;
+    }
+    SourcePath += L"kernel32.dll";
+
+    return ( CopyFile( SourcePath.c_str(), FilePath.c_str(), FALSE ) != 0 );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Lookups of duplicate, colliding and missing process ids
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestFindProcess()
+{
+    bool   thrown = false;
+    String Manufacturer, Description;
+    StringArray     ExePaths;
+    TArray< DWORD > ProcessIDs;
+    ProcessInformation Processes;
+
+    AddFixture(    0, L""                        , &ProcessIDs, &ExePaths );
+    AddFixture(    4, L""                        , &ProcessIDs, &ExePaths );
+    AddFixture(    8, L"C:\\First\\first.exe"    , &ProcessIDs, &ExePaths );
+    AddFixture(    8, L"C:\\Second\\second.exe"  , &ProcessIDs, &ExePaths );
+    AddFixture( 1000, L"C:\\A\\a.exe"            , &ProcessIDs, &ExePaths );
+    AddFixture( 1001, L"C:\\B\\b.exe"            , &ProcessIDs, &ExePaths );
+    AddFixture( 1003, L"C:\\D\\d.exe"            , &ProcessIDs, &ExePaths );
+    Processes.SetProcesses( ProcessIDs, ExePaths );
+
+    // Duplicates find the first
+    PXS_TEST_CHECK( ExePathOf( Processes, 8 ).Compare( L"C:\\First\\first.exe", true ) == 0 );
+
+    // Ids that share a hash are told apart
+    PXS_TEST_CHECK( ExePathOf( Processes, 1000 ).Compare( L"C:\\A\\a.exe", true ) == 0 );
+    PXS_TEST_CHECK( ExePathOf( Processes, 1001 ).Compare( L"C:\\B\\b.exe", true ) == 0 );
+    PXS_TEST_CHECK( ExePathOf( Processes, 1003 ).Compare( L"C:\\D\\d.exe", true ) == 0 );
+    PXS_TEST_CHECK( ExePathOf( Processes, 1002 ).IsEmpty() );
+
+    // Missing
+    PXS_TEST_CHECK( ExePathOf( Processes, 12 ).IsEmpty() );
+    PXS_TEST_CHECK( ExePathOf( Processes, 1004 ).IsEmpty() );
+    PXS_TEST_CHECK( ExePathOf( Processes, 0xFFFFFFFC ).IsEmpty() );
+    Processes.GetExeVersion( 12, &Manufacturer, &Description );
+    PXS_TEST_CHECK( Manufacturer.IsEmpty() && Description.IsEmpty() );
+
+    // Reset empties the snapshot
+    Processes.Reset();
+    PXS_TEST_CHECK( ExePathOf( Processes, 1000 ).IsEmpty() );
+
+    // Mismatched fixture
+    ExePaths.Add( L"C:\\E\\e.exe" );
+    try
+    {
+        Processes.SetProcesses( ProcessIDs, ExePaths );
+    }
+    catch ( const Exception& )
+    {
+        thrown = true;
+    }
+    PXS_TEST_CHECK( thrown );
+}
+
+//===============================================================================================//
+//  Description:
+//      A snapshot much larger than the initial table is found in full
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestGrowth()
+{
+    const  DWORD NUM_PROCESSES = 5000;
+    DWORD  i = 0, numFound = 0;
+    String ExePath;
+    Formatter       Format;
+    StringArray     ExePaths;
+    TArray< DWORD > ProcessIDs;
+    ProcessInformation Processes;
+
+    for ( i = 0; i < NUM_PROCESSES; i++ )
+    {
+        ExePath = Format.StringUInt32( L"C:\\Apps\\process%%1.exe", i );
+        AddFixture( 8 + ( 4 * i ), ExePath.c_str(), &ProcessIDs, &ExePaths );
+    }
+    Processes.SetProcesses( ProcessIDs, ExePaths );
+
+    for ( i = 0; i < NUM_PROCESSES; i++ )
+    {
+        ExePath = Format.StringUInt32( L"C:\\Apps\\process%%1.exe", i );
+        if ( ExePathOf( Processes, 8 + ( 4 * i ) ).Compare( ExePath, true ) == 0 )
+        {
+            numFound++;
+        }
+    }
+    PXS_TEST_CHECK( numFound == NUM_PROCESSES );
+    PXS_TEST_CHECK( ExePathOf( Processes, 8 + ( 4 * NUM_PROCESSES ) ).IsEmpty() );
+}
+
+//===============================================================================================//
+//  Description:
+//      The version resource is read once per process and not carried over
+//      to a new snapshot that reuses the process id
+//
+//  Parameters:
+//      DirectoryPath - where to write the fixtures
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestVersionCache( const String& DirectoryPath )
+{
+    String FirstPath, SecondPath;
+    String Manufacturer, Description, Manufacturer2, Description2;
+    StringArray     ExePaths;
+    TArray< DWORD > ProcessIDs;
+    ProcessInformation Processes;
+
+    FirstPath   = DirectoryPath;
+    FirstPath  += L"\\first.dll";
+    SecondPath  = DirectoryPath;
+    SecondPath += L"\\second.dll";
+    PXS_TEST_CHECK( CopyVersionedFile( FirstPath ) );
+
+    AddFixture( 100, FirstPath.c_str() , &ProcessIDs, &ExePaths );
+    AddFixture( 104, SecondPath.c_str(), &ProcessIDs, &ExePaths );
+    Processes.SetProcesses( ProcessIDs, ExePaths );
+
+    // First port of the process reads the file, the second uses the cache
+    Processes.GetExeVersion( 100, &Manufacturer, &Description );
+    PXS_TEST_CHECK( Manufacturer.GetLength() > 0 );
+    File::Delete( FirstPath );
+    Processes.GetExeVersion( 100, &Manufacturer2, &Description2 );
+    PXS_TEST_CHECK( Manufacturer2.Compare( Manufacturer, true ) == 0 );
+    PXS_TEST_CHECK( Description2.Compare( Description, true ) == 0 );
+
+    // A file that could not be read is not retried
+    Processes.GetExeVersion( 104, &Manufacturer2, &Description2 );
+    PXS_TEST_CHECK( Manufacturer2.IsEmpty() );
+    PXS_TEST_CHECK( CopyVersionedFile( SecondPath ) );
+    Processes.GetExeVersion( 104, &Manufacturer2, &Description2 );
+    PXS_TEST_CHECK( Manufacturer2.IsEmpty() );
+
+    // New snapshot, the ids are reused by other executables
+    ProcessIDs.RemoveAll();
+    ExePaths.RemoveAll();
+    AddFixture( 100, SecondPath.c_str(), &ProcessIDs, &ExePaths );
+    AddFixture( 104, FirstPath.c_str() , &ProcessIDs, &ExePaths );
+    Processes.SetProcesses( ProcessIDs, ExePaths );
+
+    Processes.GetExeVersion( 100, &Manufacturer2, &Description2 );
+    PXS_TEST_CHECK( Manufacturer2.Compare( Manufacturer, true ) == 0 );
+    Processes.GetExeVersion( 104, &Manufacturer2, &Description2 );
+    PXS_TEST_CHECK( Manufacturer2.IsEmpty() && Description2.IsEmpty() );
+
+    File::Delete( SecondPath );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Suite
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Run the process information tests
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void RunProcessInformationTests()
+{
+    String    DirectoryPath;
+    Formatter Format;
+
+    Directory::GetTempDirectory( &DirectoryPath );
+    DirectoryPath += Format.StringUInt32( L"WinAuditProcessTests_%%1", GetCurrentProcessId() );
+    Directory::CreateNew( DirectoryPath );
+
+    TestFindProcess();
+    TestGrowth();
+    TestVersionCache( DirectoryPath );
+
+    Directory::Delete( DirectoryPath );
+}
@@ -0,0 +1,596 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// SMBIOS Information Unit Tests
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Every table is given to SetSmbiosData or written as a dump file so nothing
+// is read from this computer's firmware. The tables are allocated to their
+// exact size so an address sanitizer build reports any read past the end.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Test Files/WinAuditTests.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/AllocateBytes.h"
+#include "PxsBase/Header Files/ByteArray.h"
+#include "PxsBase/Header Files/Directory.h"
+#include "PxsBase/Header Files/Exception.h"
+#include "PxsBase/Header Files/File.h"
+#include "PxsBase/Header Files/Formatter.h"
+#include "PxsBase/Header Files/TArray.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/AuditRecord.h"
+#include "WinAudit/Header Files/SmbiosInformation.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Fixtures
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Type 1 with manufacturer and product name strings
+static const BYTE SYSTEM_STRUCTURE[] = { 0x01, 0x08, 0x01, 0x00, 0x01, 0x02, 0x00, 0x00,
+                                         'A', 'C', 'M', 'E', 0x00,
+                                         'W', 'i', 'd', 'g', 'e', 't', 0x00, 0x00 };
+
+// Type 2 with a formatted length less than the header
+static const BYTE SHORT_STRUCTURE[] = { 0x02, 0x03, 0x02, 0x00, 0x00, 0x00 };
+
+// Type 2 whose string set has no terminator
+static const BYTE OPEN_STRUCTURE[] = { 0x02, 0x08, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00,
+                                       'B', 'o', 'a', 'r', 'd', 0x00, 'X' };
+
+// Type 127 end of table
+static const BYTE END_STRUCTURE[] = { 0x7F, 0x04, 0xFF, 0xFF, 0x00, 0x00 };
+
+// The structure types the batch decoder reports
+static const BYTE STRUCTURE_TYPES[] = { PXS_SMBIOS_TYPE_0_BIOS,
+                                        PXS_SMBIOS_TYPE_1_SYSTEM,
+                                        PXS_SMBIOS_TYPE_2_BASE_BOARD,
+                                        PXS_SMBIOS_TYPE_3_CHASSIS,
+                                        PXS_SMBIOS_TYPE_4_PROCESSOR,
+                                        PXS_SMBIOS_TYPE_5_MEM_CONTROL,
+                                        PXS_SMBIOS_TYPE_6_MEMORY_MODULE,
+                                        PXS_SMBIOS_TYPE_7_CPU_CACHE,
+                                        PXS_SMBIOS_TYPE_8_PORT_CONN,
+                                        PXS_SMBIOS_TYPE_9_SYSTEM_SLOT,
+                                        PXS_SMBIOS_TYPE_16_MEM_ARRAY,
+                                        PXS_SMBIOS_TYPE_17_MEMORY_DEVICE };
+
+//===============================================================================================//
+//  Description:
+//      Set a table in a new SmbiosInformation object
+//
+//  Parameters:
+//      Table   - the structure table
+//      pSmbios - the object
+//
+//  Returns:
+//      true if the table was accepted, false if SetSmbiosData threw
+//===============================================================================================//
+static bool SetTable( const ByteArray& Table, SmbiosInformation* pSmbios )
+{
+    AllocateBytes AllocBytes;
+    BYTE* pTable = AllocBytes.New( Table.GetSize() );
+
+    memcpy( pTable, Table.GetPtr(), Table.GetSize() );
+    try
+    {
+        pSmbios->SetSmbiosData( pTable, Table.GetSize(), 3, 4 );
+    }
+    catch ( const Exception& )
+    {
+        return false;
+    }
+
+    return true;
+}
+
+//===============================================================================================//
+//  Description:
+//      Determine if the object has the specified structure
+//
+//  Parameters:
+//      Smbios          - the object
+//      structureType   - the structure type
+//      structureNumber - one-based occurrence of the type
+//
+//  Returns:
+//      true if present, otherwise false
+//===============================================================================================//
+static bool HasStructure( const SmbiosInformation& Smbios,
+                          BYTE structureType, WORD structureNumber )
+{
+    WORD offset = 0;
+
+    return Smbios.GetStructureOffset( structureType, structureNumber, &offset );
+}
+
+//===============================================================================================//
+//  Description:
+//      Write a dump file of an entry point followed by a table
+//
+//  Parameters:
+//      FilePath     - path of the file
+//      pEntryPoint  - the entry point, NULL for a raw table
+//      entryLength  - length of the entry point
+//      tableAddress - offset of the table in the file
+//      Table        - the table
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void WriteDump( const String& FilePath,
+                       const BYTE* pEntryPoint,
+                       size_t entryLength, size_t tableAddress, const ByteArray& Table )
+{
+    File      DumpFile;
+    ByteArray Contents;
+
+    if ( pEntryPoint )
+    {
+        Contents.Append( pEntryPoint, entryLength );
+    }
+    while ( Contents.GetSize() < tableAddress )
+    {
+        Contents.AppendByte( 0 );
+    }
+    Contents.Append( Table );
+
+    DumpFile.CreateNew( FilePath, 0, false );
+    DumpFile.Write( Contents );
+    DumpFile.Close();
+}
+
+//===============================================================================================//
+//  Description:
+//      Determine if a dump file is accepted
+//
+//  Parameters:
+//      FilePath - path of the dump file
+//
+//  Returns:
+//      true if the manufacturer was read from the dump, false if it threw
+//===============================================================================================//
+static bool ReadsDump( const String& FilePath )
+{
+    String Manufacturer;
+    SmbiosInformation Smbios;
+
+    try
+    {
+        Smbios.ReadSmbiosDumpFile( FilePath );
+    }
+    catch ( const Exception& )
+    {
+        return false;
+    }
+    Smbios.GetSystemManufacturer( &Manufacturer );
+
+    return ( Manufacturer.CompareI( L"ACME" ) == 0 );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      A well formed table is kept whole
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestValidTable()
+{
+    bool      thrown = false;
+    String    Value;
+    ByteArray Table;
+    SmbiosInformation Smbios;
+
+    Table.Append( SYSTEM_STRUCTURE, sizeof ( SYSTEM_STRUCTURE ) );
+    Table.Append( END_STRUCTURE, sizeof ( END_STRUCTURE ) );
+    PXS_TEST_CHECK( SetTable( Table, &Smbios ) );
+    PXS_TEST_CHECK( HasStructure( Smbios, PXS_SMBIOS_TYPE_1_SYSTEM, 1 ) );
+    PXS_TEST_CHECK( HasStructure( Smbios, 0x7F, 1 ) );
+
+    Smbios.GetSystemManufacturer( &Value );
+    PXS_TEST_CHECK( Value.CompareI( L"ACME" ) == 0 );
+    Smbios.GetProductName( &Value );
+    PXS_TEST_CHECK( Value.CompareI( L"Widget" ) == 0 );
+
+    try
+    {
+        Smbios.SetSmbiosData( nullptr, 0, 3, 4 );
+    }
+    catch ( const Exception& )
+    {
+        thrown = true;
+    }
+    PXS_TEST_CHECK( thrown );
+}
+
+//===============================================================================================//
+//  Description:
+//      A formatted length less than 4 ends the table
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestShortFormattedLength()
+{
+    ByteArray Table;
+    SmbiosInformation Smbios, Smbios2;
+
+    Table.Append( SYSTEM_STRUCTURE, sizeof ( SYSTEM_STRUCTURE ) );
+    Table.Append( SHORT_STRUCTURE, sizeof ( SHORT_STRUCTURE ) );
+    Table.Append( END_STRUCTURE, sizeof ( END_STRUCTURE ) );
+    PXS_TEST_CHECK( SetTable( Table, &Smbios ) );
+    PXS_TEST_CHECK( HasStructure( Smbios, PXS_SMBIOS_TYPE_1_SYSTEM, 1 ) );
+    PXS_TEST_CHECK( HasStructure( Smbios, PXS_SMBIOS_TYPE_2_BASE_BOARD, 1 ) == false );
+    PXS_TEST_CHECK( HasStructure( Smbios, 0x7F, 1 ) == false );
+
+    // Nothing intact
+    Table.Free();
+    Table.Append( SHORT_STRUCTURE, sizeof ( SHORT_STRUCTURE ) );
+    Table.Append( SYSTEM_STRUCTURE, sizeof ( SYSTEM_STRUCTURE ) );
+    PXS_TEST_CHECK( SetTable( Table, &Smbios2 ) == false );
+}
+
+//===============================================================================================//
+//  Description:
+//      A string set with no double null terminator ends the table
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestUnterminatedStrings()
+{
+    ByteArray Table;
+    SmbiosInformation Smbios, Smbios2;
+
+    Table.Append( SYSTEM_STRUCTURE, sizeof ( SYSTEM_STRUCTURE ) );
+    Table.Append( OPEN_STRUCTURE, sizeof ( OPEN_STRUCTURE ) );
+    PXS_TEST_CHECK( SetTable( Table, &Smbios ) );
+    PXS_TEST_CHECK( HasStructure( Smbios, PXS_SMBIOS_TYPE_1_SYSTEM, 1 ) );
+    PXS_TEST_CHECK( HasStructure( Smbios, PXS_SMBIOS_TYPE_2_BASE_BOARD, 1 ) == false );
+
+    Table.Free();
+    Table.Append( OPEN_STRUCTURE, sizeof ( OPEN_STRUCTURE ) );
+    PXS_TEST_CHECK( SetTable( Table, &Smbios2 ) == false );
+}
+
+//===============================================================================================//
+//  Description:
+//      A table that ends part way through a structure keeps those before it
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestEndsMidStructure()
+{
+    size_t    i = 0, numAccepted = 0;
+    ByteArray Table;
+    SmbiosInformation Smbios;
+
+    Table.Append( SYSTEM_STRUCTURE, sizeof ( SYSTEM_STRUCTURE ) );
+    Table.Append( SYSTEM_STRUCTURE, 5 );
+    PXS_TEST_CHECK( SetTable( Table, &Smbios ) );
+    PXS_TEST_CHECK( HasStructure( Smbios, PXS_SMBIOS_TYPE_1_SYSTEM, 1 ) );
+    PXS_TEST_CHECK( HasStructure( Smbios, PXS_SMBIOS_TYPE_1_SYSTEM, 2 ) == false );
+
+    // Formatted length past the end of the table
+    Table.Free();
+    Table.Append( SYSTEM_STRUCTURE, sizeof ( SYSTEM_STRUCTURE ) );
+    Table.AppendByte( PXS_SMBIOS_TYPE_3_CHASSIS );
+    Table.AppendByte( 0x40 );
+    Table.Append( END_STRUCTURE, sizeof ( END_STRUCTURE ) );
+    PXS_TEST_CHECK( SetTable( Table, &Smbios ) );
+    PXS_TEST_CHECK( HasStructure( Smbios, PXS_SMBIOS_TYPE_3_CHASSIS, 1 ) == false );
+
+    // Every cut of a single structure is refused, the whole one accepted
+    for ( i = 0; i <= sizeof ( SYSTEM_STRUCTURE ); i++ )
+    {
+        SmbiosInformation Cut;
+        Table.Free();
+        Table.Append( SYSTEM_STRUCTURE, i );
+        if ( SetTable( Table, &Cut ) )
+        {
+            numAccepted++;
+        }
+    }
+    PXS_TEST_CHECK( numAccepted == 1 );
+}
+
+//===============================================================================================//
+//  Description:
+//      Dump files whose entry point gives an address or length past the end
+//
+//  Parameters:
+//      DirectoryPath - where to write the dumps
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestReadSmbiosDumpFile( const String& DirectoryPath )
+{
+    BYTE      Entry64[ 0x18 ], Entry32[ 0x1F ];
+    String    FilePath;
+    ByteArray Table;
+
+    FilePath  = DirectoryPath;
+    FilePath += L"\\smbios.bin";
+    Table.Append( SYSTEM_STRUCTURE, sizeof ( SYSTEM_STRUCTURE ) );
+    Table.Append( END_STRUCTURE, sizeof ( END_STRUCTURE ) );
+
+    // Raw table
+    WriteDump( FilePath, nullptr, 0, 0, Table );
+    PXS_TEST_CHECK( ReadsDump( FilePath ) );
+
+    // 64-bit entry point, the size is a maximum so may exceed the table
+    memset( Entry64, 0, sizeof ( Entry64 ) );
+    memcpy( Entry64, "_SM3_", 5 );
+    Entry64[ 0x06 ] = sizeof ( Entry64 );
+    Entry64[ 0x07 ] = 3;
+    Entry64[ 0x08 ] = 4;
+    Entry64[ 0x0D ] = 0x10;             // 4KB maximum
+    Entry64[ 0x10 ] = 0x20;
+    WriteDump( FilePath, Entry64, sizeof ( Entry64 ), 0x20, Table );
+    PXS_TEST_CHECK( ReadsDump( FilePath ) );
+
+    Entry64[ 0x0D ] = 0x00;             // Exact
+    Entry64[ 0x0C ] = static_cast<BYTE>( Table.GetSize() );
+    WriteDump( FilePath, Entry64, sizeof ( Entry64 ), 0x20, Table );
+    PXS_TEST_CHECK( ReadsDump( FilePath ) );
+
+    Entry64[ 0x10 ] = 0xF0;             // Address past the end
+    WriteDump( FilePath, Entry64, sizeof ( Entry64 ), 0x20, Table );
+    PXS_TEST_CHECK( ReadsDump( FilePath ) == false );
+
+    Entry64[ 0x10 ] = 0x20;             // High DWORD of the address set
+    Entry64[ 0x14 ] = 0x01;
+    WriteDump( FilePath, Entry64, sizeof ( Entry64 ), 0x20, Table );
+    PXS_TEST_CHECK( ReadsDump( FilePath ) == false );
+
+    // 32-bit entry point, the length is exact
+    memset( Entry32, 0, sizeof ( Entry32 ) );
+    memcpy( Entry32, "_SM_", 4 );
+    Entry32[ 0x05 ] = sizeof ( Entry32 );
+    Entry32[ 0x06 ] = 2;
+    Entry32[ 0x07 ] = 8;
+    Entry32[ 0x16 ] = static_cast<BYTE>( Table.GetSize() );
+    Entry32[ 0x18 ] = 0x20;
+    WriteDump( FilePath, Entry32, sizeof ( Entry32 ), 0x20, Table );
+    PXS_TEST_CHECK( ReadsDump( FilePath ) );
+
+    Entry32[ 0x16 ] = static_cast<BYTE>( Table.GetSize() + 1 );
+    WriteDump( FilePath, Entry32, sizeof ( Entry32 ), 0x20, Table );
+    PXS_TEST_CHECK( ReadsDump( FilePath ) == false );
+
+    Entry32[ 0x16 ] = static_cast<BYTE>( Table.GetSize() );
+    Entry32[ 0x19 ] = 0x01;             // Address past the end
+    WriteDump( FilePath, Entry32, sizeof ( Entry32 ), 0x20, Table );
+    PXS_TEST_CHECK( ReadsDump( FilePath ) == false );
+
+    // Entry point with no table
+    Entry64[ 0x10 ] = 0x18;
+    Entry64[ 0x14 ] = 0x00;
+    WriteDump( FilePath, Entry64, 0x18, 0x18, ByteArray() );
+    PXS_TEST_CHECK( ReadsDump( FilePath ) == false );
+
+    File::Delete( FilePath );
+}
+
+//===============================================================================================//
+//  Description:
+//      Random structures with random lengths, strings and cuts are either
+//      refused or decoded without reading past the table
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestFuzzTables()
+{
+    const  size_t NUM_ITERATIONS = 2000;
+    size_t i = 0, j = 0, k = 0, numStructures = 0, numStrings = 0, length = 0;
+    size_t numAccepted = 0, numExceptions = 0;
+    DWORD  seed = 0x5EED5EED;
+    ByteArray Table;
+    TArray< AuditRecord > Records;
+
+    for ( i = 0; i < NUM_ITERATIONS; i++ )
+    {
+        SmbiosInformation Smbios;
+        Table.Free();
+        seed = ( seed * 1103515245 ) + 12345;
+        numStructures = 1 + ( ( seed >> 16 ) % 12 );
+        for ( j = 0; j < numStructures; j++ )
+        {
+            // Type, formatted length then the rest of the formatted area
+            seed   = ( seed * 1103515245 ) + 12345;
+            length = ( seed >> 16 ) % 0x60;
+            Table.AppendByte( STRUCTURE_TYPES[ ( seed >> 8 ) % ARRAYSIZE( STRUCTURE_TYPES ) ] );
+            Table.AppendByte( static_cast<BYTE>( length ) );
+            for ( k = 2; k < length; k++ )
+            {
+                seed = ( seed * 1103515245 ) + 12345;
+                Table.AppendByte( static_cast<BYTE>( seed >> 16 ) );
+            }
+
+            // Strings, usually terminated
+            seed       = ( seed * 1103515245 ) + 12345;
+            numStrings = ( seed >> 16 ) % 4;
+            for ( k = 0; k < numStrings; k++ )
+            {
+                Table.Append( reinterpret_cast<const BYTE*>( "String" ), 1 + ( k % 6 ) );
+                Table.AppendByte( 0 );
+            }
+            if ( ( ( seed >> 20 ) % 16 ) != 0 )
+            {
+                Table.AppendByte( 0 );
+                if ( numStrings == 0 )
+                {
+                    Table.AppendByte( 0 );
+                }
+            }
+        }
+
+        // Sometimes cut the table anywhere
+        seed = ( seed * 1103515245 ) + 12345;
+        if ( ( ( seed >> 16 ) % 4 ) == 0 )
+        {
+            Table.Truncate( ( seed >> 8 ) % ( Table.GetSize() + 1 ) );
+        }
+        if ( Table.GetSize() == 0 )
+        {
+            continue;
+        }
+
+        if ( SetTable( Table, &Smbios ) )
+        {
+            numAccepted++;
+            try
+            {
+                for ( k = 0; k < ARRAYSIZE( STRUCTURE_TYPES ); k++ )
+                {
+                    Smbios.GetAuditRecords( STRUCTURE_TYPES[ k ], &Records );
+                }
+            }
+            catch ( const Exception& )
+            {
+                numExceptions++;
+            }
+        }
+    }
+    PXS_TEST_CHECK( numAccepted > 0 );
+    PXS_TEST_CHECK( numExceptions == 0 );
+}
+
+//===============================================================================================//
+//  Description:
+//      Time setting and decoding a table of every reported type
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestDecodeRate()
+{
+    const  size_t NUM_TABLES = 2000;
+    size_t i = 0, k = 0, numRecords = 0;
+    UINT64 startTick = 0;
+    BYTE   Formatted[ 0x40 ];
+    ByteArray Table;
+    TArray< AuditRecord > Records;
+
+    // A structure of each type with the formatted area filled with string 1
+    memset( Formatted, 0x01, sizeof ( Formatted ) );
+    for ( k = 0; k < ARRAYSIZE( STRUCTURE_TYPES ); k++ )
+    {
+        Formatted[ 0 ] = STRUCTURE_TYPES[ k ];
+        Formatted[ 1 ] = sizeof ( Formatted );
+        Table.Append( Formatted, sizeof ( Formatted ) );
+        Table.Append( reinterpret_cast<const BYTE*>( "Value" ), 6 );
+        Table.AppendByte( 0 );
+    }
+    Table.Append( END_STRUCTURE, sizeof ( END_STRUCTURE ) );
+
+    startTick = GetTickCount64();
+    for ( i = 0; i < NUM_TABLES; i++ )
+    {
+        SmbiosInformation Smbios;
+        Smbios.SetSmbiosData( Table.GetPtr(), Table.GetSize(), 3, 4 );
+        for ( k = 0; k < ARRAYSIZE( STRUCTURE_TYPES ); k++ )
+        {
+            Smbios.GetAuditRecords( STRUCTURE_TYPES[ k ], &Records );
+            numRecords += Records.GetSize();
+        }
+    }
+    PXSTestReportRate( "SMBIOS tables decoded", NUM_TABLES, GetTickCount64() - startTick );
+    PXS_TEST_CHECK( numRecords >= NUM_TABLES );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Suite
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Run the SMBIOS table tests
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void RunSmbiosInformationTests()
+{
+    String    DirectoryPath;
+    Formatter Format;
+
+    Directory::GetTempDirectory( &DirectoryPath );
+    DirectoryPath += Format.StringUInt32( L"WinAuditSmbiosTests_%%1", GetCurrentProcessId() );
+    Directory::CreateNew( DirectoryPath );
+
+    TestValidTable();
+    TestShortFormattedLength();
+    TestUnterminatedStrings();
+    TestEndsMidStructure();
+    TestReadSmbiosDumpFile( DirectoryPath );
+    TestFuzzTables();
+    TestDecodeRate();
+
+    Directory::Delete( DirectoryPath );
+}
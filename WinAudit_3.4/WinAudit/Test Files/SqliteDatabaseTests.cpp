@@ -0,0 +1,305 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// SQLite Database Unit Tests
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The retention predicate is checked as text for each dialect then run on a
+// SQLite file of made-up audits in both layouts. sqlite3.dll must be in the
+// directory of the test program, as it must for WinAudit.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Test Files/WinAuditTests.h"
+
+// 2. C System Files
+#include <stdio.h>
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/Directory.h"
+#include "PxsBase/Header Files/Exception.h"
+#include "PxsBase/Header Files/File.h"
+#include "PxsBase/Header Files/Formatter.h"
+#include "PxsBase/Header Files/TArray.h"
+
+// 5. This Project
+#include "WinAudit/Header Files/AuditDatabase.h"
+#include "WinAudit/Header Files/AuditRecord.h"
+#include "WinAudit/Header Files/SqliteDatabase.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Fixtures
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Export audits of a made-up computer
+//
+//  Parameters:
+//      ComputerGuid - the computer's WinAudit GUID
+//      numAudits    - the number of audits to export
+//      pDatabase    - the open database
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void ExportAudits( const String& ComputerGuid, size_t numAudits, SqliteDatabase* pDatabase )
+{
+    size_t      i = 0;
+    String      ResultMessage;
+    Formatter   Format;
+    AuditRecord ComputerMaster( PXS_CATEGORY_COMPUTER_MASTER );
+    AuditRecord AuditMaster, Record;
+    TArray< AuditRecord > AuditRecords;
+
+    ComputerMaster.Add( PXS_COMP_MASTER_WINAUDIT_GUID, ComputerGuid );
+    ComputerMaster.Add( PXS_COMP_MASTER_COMPUTER_NAME, L"PC01" );
+    for ( i = 0; i < numAudits; i++ )
+    {
+        AuditMaster.Reset( PXS_CATEGORY_AUDIT_MASTER );
+        AuditMaster.Add( PXS_AUDIT_MASTER_AUDIT_GUID    , Format.CreateGuid() );
+        AuditMaster.Add( PXS_AUDIT_MASTER_COMPUTER_LOCAL, L"2026-01-01 12:00:00" );
+        AuditMaster.Add( PXS_AUDIT_MASTER_COMPUTER_UTC  , L"2026-01-01 11:00:00" );
+
+        // Shared and per audit values so the value dictionary has both
+        AuditRecords.RemoveAll();
+        Record.Reset( PXS_CATEGORY_SOFTWARE_UPDATES );
+        Record.Add( PXS_SOFTWARE_UPDATES_UPDATE_ID  , L"KB5005565" );
+        Record.Add( PXS_SOFTWARE_UPDATES_DESCRIPTION, Format.SizeT( i ) );
+        AuditRecords.Add( Record );
+        pDatabase->ExportAudit( ComputerMaster, AuditMaster, AuditRecords, &ResultMessage );
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Make the retention predicate of a dialect
+//
+//  Parameters:
+//      pszDbmsName - the SQL_DBMS_NAME
+//      retainCount - the number of audits to keep per computer
+//      retainDays  - the age limit in days, zero for none
+//
+//  Returns:
+//      the predicate, empty if it could not be made
+//===============================================================================================//
+static String PredicateOf( LPCWSTR pszDbmsName, DWORD retainCount, DWORD retainDays )
+{
+    String DbmsName, Predicate;
+
+    DbmsName = pszDbmsName;
+    try
+    {
+        AuditDatabase::MakeOldAuditsPredicate( DbmsName, retainCount, retainDays, &Predicate );
+    }
+    catch ( const Exception& )
+    {
+        Predicate = PXS_STRING_EMPTY;
+    }
+
+    return Predicate;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      The predicate keeps the newest audits of each computer and adds the
+//      age limit in each dialect's date arithmetic
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestPredicate()
+{
+    LPCWSTR SQLITE_CUT_OFF = L"am.Database_Local < datetime( 'now', 'localtime', '-90 days' )";
+    String  Predicate;
+
+    Predicate = PredicateOf( PXS_DBMS_NAME_SQLITE, 3, 0 );
+    PXS_TEST_CHECK( Predicate.IndexOfI( L"newer.Audit_ID > am.Audit_ID ) >= 3" ) != PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Predicate.IndexOfI( L"Database_Local" ) == PXS_MINUS_ONE );
+
+    Predicate = PredicateOf( PXS_DBMS_NAME_SQLITE, 1, 90 );
+    PXS_TEST_CHECK( Predicate.IndexOfI( SQLITE_CUT_OFF ) != PXS_MINUS_ONE );
+    Predicate = PredicateOf( PXS_DBMS_NAME_SQL_SERVER, 1, 90 );
+    PXS_TEST_CHECK( Predicate.IndexOfI( L"DATEADD( day, -90, " ) != PXS_MINUS_ONE );
+    Predicate = PredicateOf( PXS_DBMS_NAME_POSTGRE_SQL, 1, 90 );
+    PXS_TEST_CHECK( Predicate.IndexOfI( L"INTERVAL '90 days'" ) != PXS_MINUS_ONE );
+
+    // Any database without an age limit, none with an unknown one
+    PXS_TEST_CHECK( PredicateOf( PXS_DBMS_NAME_ORACLE, 1, 0 ).GetLength() > 0 );
+    PXS_TEST_CHECK( PredicateOf( PXS_DBMS_NAME_ORACLE, 1, 90 ).IsEmpty() );
+
+    // Must keep at least one so Last_Audit_ID is not orphaned
+    PXS_TEST_CHECK( PredicateOf( PXS_DBMS_NAME_SQLITE, 0, 0 ).IsEmpty() );
+}
+
+//===============================================================================================//
+//  Description:
+//      Old audits are counted and purged in batches from a SQLite file
+//
+//  Parameters:
+//      DirectoryPath   - where to create the database
+//      valueDictionary - true for the value dictionary layout
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestPurge( const String& DirectoryPath, bool valueDictionary )
+{
+    bool      opened = false, thrown = false;
+    size_t    numDeleted = 0, numBatches = 0, totalDeleted = 0;
+    __int64   lastAuditID = 0, previousID = 0;
+    String    FilePath, SidePath, FirstGuid, SecondGuid, ThirdGuid;
+    Formatter Format;
+    SqliteDatabase Database;
+
+    FilePath  = DirectoryPath;
+    FilePath += valueDictionary ? L"\\purge-eav.db" : L"\\purge.db";
+    try
+    {
+        Database.Open( FilePath, valueDictionary );
+        opened = true;
+    }
+    catch ( const Exception& e )
+    {
+        wprintf( L"SQLite purge tests not run: %s\n", e.GetMessage().c_str() );
+    }
+    PXS_TEST_CHECK( opened );
+    if ( opened == false )
+    {
+        return;
+    }
+
+    FirstGuid  = Format.CreateGuid();
+    SecondGuid = Format.CreateGuid();
+    ThirdGuid  = Format.CreateGuid();
+    ExportAudits( FirstGuid , 4, &Database );
+    ExportAudits( SecondGuid, 2, &Database );
+    ExportAudits( ThirdGuid , 1, &Database );
+
+    PXS_TEST_CHECK( Database.CountOldAudits( 2, 0 ) == 2 );
+    PXS_TEST_CHECK( Database.CountOldAudits( 1, 0 ) == 4 );
+    PXS_TEST_CHECK( Database.CountOldAudits( 5, 0 ) == 0 );
+
+    // The audits were stored now so are all inside an age limit
+    PXS_TEST_CHECK( Database.CountOldAudits( 1, 1 ) == 0 );
+    PXS_TEST_CHECK( Database.DeleteOldAuditsBatch( 1, 1, 10, &lastAuditID ) == 0 );
+    PXS_TEST_CHECK( lastAuditID == 0 );
+
+    // One audit per batch, each batch starts after the last
+    do
+    {
+        previousID = lastAuditID;
+        numDeleted = Database.DeleteOldAuditsBatch( 2, 0, 1, &lastAuditID );
+        if ( numDeleted )
+        {
+            PXS_TEST_CHECK( lastAuditID > previousID );
+            numBatches++;
+        }
+        totalDeleted += numDeleted;
+    } while ( numDeleted && ( numBatches < 10 ) );
+    PXS_TEST_CHECK( numBatches == 2 );
+    PXS_TEST_CHECK( totalDeleted == 2 );
+    PXS_TEST_CHECK( Database.CountOldAudits( 2, 0 ) == 0 );
+    PXS_TEST_CHECK( Database.CountOldAudits( 1, 0 ) == 2 );
+
+    // A new audit of the first computer makes one more old one
+    ExportAudits( FirstGuid, 1, &Database );
+    PXS_TEST_CHECK( Database.CountOldAudits( 2, 0 ) == 1 );
+    lastAuditID = 0;
+    PXS_TEST_CHECK( Database.DeleteOldAuditsBatch( 2, 0, 100, &lastAuditID ) == 1 );
+    PXS_TEST_CHECK( Database.DeleteOldAuditsBatch( 2, 0, 100, &lastAuditID ) == 0 );
+
+    try
+    {
+        Database.DeleteOldAuditsBatch( 2, 0, 0, &lastAuditID );
+    }
+    catch ( const Exception& )
+    {
+        thrown = true;
+    }
+    PXS_TEST_CHECK( thrown );
+    Database.Close();
+
+    // The write-ahead log files normally go when the last connection closes
+    File::Delete( FilePath );
+    SidePath  = FilePath;
+    SidePath += L"-wal";
+    if ( File::Exists( SidePath ) )
+    {
+        File::Delete( SidePath );
+    }
+    SidePath  = FilePath;
+    SidePath += L"-shm";
+    if ( File::Exists( SidePath ) )
+    {
+        File::Delete( SidePath );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Suite
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Run the SQLite database tests
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void RunSqliteDatabaseTests()
+{
+    String    DirectoryPath;
+    Formatter Format;
+
+    Directory::GetTempDirectory( &DirectoryPath );
+    DirectoryPath += Format.StringUInt32( L"WinAuditSqliteTests_%%1", GetCurrentProcessId() );
+    Directory::CreateNew( DirectoryPath );
+
+    TestPredicate();
+    TestPurge( DirectoryPath, false );
+    TestPurge( DirectoryPath, true );
+
+    Directory::Delete( DirectoryPath );
+}
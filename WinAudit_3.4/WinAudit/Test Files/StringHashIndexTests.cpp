@@ -0,0 +1,224 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// String Hash Index Unit Tests
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The index is shared by the account name cache, the group membership and
+// device string pools, the process snapshot and the value dictionary.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Test Files/WinAuditTests.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/Formatter.h"
+#include "PxsBase/Header Files/StringArray.h"
+#include "PxsBase/Header Files/StringHashIndex.h"
+
+// 5. This Project
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      String keys are found after the table has grown, with and without case
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestFindStrings()
+{
+    const  size_t NUM_KEYS = 1000;
+    size_t    i = 0, numFound = 0;
+    String    Key;
+    Formatter Format;
+    StringArray     Keys;
+    StringHashIndex Index;
+
+    PXS_TEST_CHECK( Index.Find( Keys, L"S-1-5-18", false ) == PXS_MINUS_ONE );
+    for ( i = 0; i < NUM_KEYS; i++ )
+    {
+        Key = Format.StringUInt32( L"S-1-5-21-%%1", PXSCastSizeTToUInt32( i ) );
+        Keys.Add( Key );
+        Index.Add( Key.c_str(), false, i );
+    }
+    PXS_TEST_CHECK( Index.GetSize() == NUM_KEYS );
+
+    for ( i = 0; i < NUM_KEYS; i++ )
+    {
+        if ( Index.Find( Keys, Keys.Get( i ), false ) == i )
+        {
+            numFound++;
+        }
+    }
+    PXS_TEST_CHECK( numFound == NUM_KEYS );
+    PXS_TEST_CHECK( Index.Find( Keys, L"s-1-5-21-7", false ) == 7 );
+    PXS_TEST_CHECK( Index.Find( Keys, L"S-1-5-21-1000", false ) == PXS_MINUS_ONE );
+
+    Index.RemoveAll();
+    PXS_TEST_CHECK( Index.GetSize() == 0 );
+    PXS_TEST_CHECK( Index.Find( Keys, Keys.Get( 0 ), false ) == PXS_MINUS_ONE );
+}
+
+//===============================================================================================//
+//  Description:
+//      Entries with the same hash are all visited, the earliest first
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestFindCollisions()
+{
+    size_t position = 0;
+    StringHashIndex Index;
+
+    Index.Add( 5, 10 );
+    Index.Add( 69, 11 );    // Same first slot, different hash
+    Index.Add( 5, 12 );
+
+    PXS_TEST_CHECK( Index.FindFirst( 5, &position ) == 10 );
+    PXS_TEST_CHECK( Index.FindNext( 5, &position ) == 12 );
+    PXS_TEST_CHECK( Index.FindNext( 5, &position ) == PXS_MINUS_ONE );
+    PXS_TEST_CHECK( Index.FindFirst( 69, &position ) == 11 );
+    PXS_TEST_CHECK( Index.FindFirst( 6, &position ) == PXS_MINUS_ONE );
+}
+
+//===============================================================================================//
+//  Description:
+//      The hash is stored in databases so must not change
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestHashString()
+{
+    PXS_TEST_CHECK( StringHashIndex::HashString( L"", true ) == 2166136261 );
+    PXS_TEST_CHECK( StringHashIndex::HashString( L"a", true ) == 0xE40C292C );
+    PXS_TEST_CHECK( StringHashIndex::HashString( L"ab", 1, true ) == 0xE40C292C );
+    PXS_TEST_CHECK( StringHashIndex::HashString( nullptr, 4, true ) == 2166136261 );
+    PXS_TEST_CHECK( StringHashIndex::HashString( L"a", false ) ==
+                    StringHashIndex::HashString( L"A", true ) );
+}
+
+//===============================================================================================//
+//  Description:
+//      Without case, strings that PXSCompareString finds equal have the same
+//      hash and are found in the index whatever their script
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestHashWithoutCase()
+{
+    const  size_t NUM_PAIRS = 5;
+    LPCWSTR LOWER[ NUM_PAIRS ] = {
+        L"\x0430\x0434\x043C\x0438\x043D\x0438\x0441\x0442\x0440\x0430\x0442\x043E\x0440",
+        L"\x03BF\x03BC\x03B1\x03B4\x03B1 \x03C7\x03C1\x03B7\x03C3\x03C4\x03C9\x03BD",
+        L"\x00E9quipe r\x00E9seau",
+        L"administrateurs du domaine \x00E0 distance",
+        L"\x0433\x043E\x0441\x0442\x0438 abcdefghijklmnopqrstuvwxyz 0123456789 "
+        L"abcdefghijklmnopqrstuvwxyz 0123456789 \x03B1\x03B2\x03B3" };
+    LPCWSTR UPPER[ NUM_PAIRS ] = {
+        L"\x0410\x0414\x041C\x0418\x041D\x0418\x0421\x0422\x0420\x0410\x0422\x041E\x0420",
+        L"\x039F\x039C\x0391\x0394\x0391 \x03A7\x03A1\x0397\x03A3\x03A4\x03A9\x039D",
+        L"\x00C9QUIPE R\x00C9SEAU",
+        L"ADMINISTRATEURS DU DOMAINE \x00C0 DISTANCE",
+        L"\x0413\x041E\x0421\x0422\x0418 ABCDEFGHIJKLMNOPQRSTUVWXYZ 0123456789 "
+        L"ABCDEFGHIJKLMNOPQRSTUVWXYZ 0123456789 \x0391\x0392\x0393" };
+    size_t i = 0;
+    StringArray     Keys;
+    StringHashIndex Index;
+
+    for ( i = 0; i < NUM_PAIRS; i++ )
+    {
+        PXS_TEST_CHECK( PXSCompareString( LOWER[ i ], UPPER[ i ], false ) == 0 );
+        PXS_TEST_CHECK( StringHashIndex::HashString( LOWER[ i ], false ) ==
+                        StringHashIndex::HashString( UPPER[ i ], false ) );
+        PXS_TEST_CHECK( StringHashIndex::HashString( LOWER[ i ], true ) !=
+                        StringHashIndex::HashString( UPPER[ i ], true ) );
+        Keys.Add( UPPER[ i ] );
+        Index.Add( UPPER[ i ], false, i );
+    }
+
+    for ( i = 0; i < NUM_PAIRS; i++ )
+    {
+        PXS_TEST_CHECK( Index.Find( Keys, LOWER[ i ], false ) == i );
+        PXS_TEST_CHECK( Index.Find( Keys, LOWER[ i ], true ) == PXS_MINUS_ONE );
+    }
+
+    // Only the first characters, part way into a chunk
+    PXS_TEST_CHECK( StringHashIndex::HashString( LOWER[ 4 ], 70, false ) ==
+                    StringHashIndex::HashString( UPPER[ 4 ], 70, false ) );
+    PXS_TEST_CHECK( StringHashIndex::HashString( LOWER[ 4 ], 70, false ) !=
+                    StringHashIndex::HashString( UPPER[ 4 ], false ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Suite
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Run the string hash index tests
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void RunStringHashIndexTests()
+{
+    TestFindStrings();
+    TestFindCollisions();
+    TestHashString();
+    TestHashWithoutCase();
+}
@@ -0,0 +1,278 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// String Unit Tests
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Values of up to 19 characters are kept in the string object itself, longer
+// ones on the heap. The tests tell them apart by where c_str() points. The
+// project does not use the standard library, so moves are made with a cast.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Test Files/WinAuditTests.h"
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/Formatter.h"
+
+// 5. This Project
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Fixtures
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+const LPCWSTR INLINE_VALUE = L"1234567890123456789";    // 19 characters
+const LPCWSTR HEAP_VALUE   = L"12345678901234567890";   // 20 characters
+
+//===============================================================================================//
+//  Description:
+//      Test if a string's characters are held in the string object
+//
+//  Parameters:
+//      Value - the string
+//
+//  Returns:
+//      true if inline, otherwise false
+//===============================================================================================//
+static bool IsInline( const String& Value )
+{
+    const BYTE* pObject = reinterpret_cast<const BYTE*>( &Value );
+    const BYTE* pChars  = reinterpret_cast<const BYTE*>( Value.c_str() );
+
+    return ( pChars >= pObject ) && ( pChars < ( pObject + sizeof ( Value ) ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Copies, moves and swaps keep a null string distinct from an empty one
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestNullAndEmpty()
+{
+    String Null, Empty, Copy;
+
+    Empty = L"";
+    PXS_TEST_CHECK( Null.IsNull() && Null.IsEmpty() );
+    PXS_TEST_CHECK( ( Empty.IsNull() == false ) && Empty.IsEmpty() );
+    PXS_TEST_CHECK( Empty.c_str() && ( Empty.c_str()[ 0 ] == PXS_CHAR_NULL ) );
+
+    // Copy
+    Copy = Null;
+    PXS_TEST_CHECK( Copy.IsNull() );
+    Copy = Empty;
+    PXS_TEST_CHECK( ( Copy.IsNull() == false ) && Copy.IsEmpty() );
+    Copy = Null;
+    PXS_TEST_CHECK( Copy.IsNull() );
+    String Constructed( Empty );
+    PXS_TEST_CHECK( ( Constructed.IsNull() == false ) && Constructed.IsEmpty() );
+
+    // Swap
+    Null.Swap( Empty );
+    PXS_TEST_CHECK( ( Null.IsNull() == false ) && Null.IsEmpty() );
+    PXS_TEST_CHECK( Empty.IsNull() );
+    Null.Swap( Empty );
+    PXS_TEST_CHECK( Null.IsNull() && ( Empty.IsNull() == false ) );
+
+    // Move, the source is left null
+    String Moved( static_cast<String&&>( Empty ) );
+    PXS_TEST_CHECK( ( Moved.IsNull() == false ) && Moved.IsEmpty() );
+    PXS_TEST_CHECK( Empty.IsNull() );
+    Moved = static_cast<String&&>( Null );
+    PXS_TEST_CHECK( Moved.IsNull() && Null.IsNull() );
+}
+
+//===============================================================================================//
+//  Description:
+//      Short values are inline, growing a value moves it to the heap
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestInlineLimit()
+{
+    String Value;
+
+    Value = INLINE_VALUE;
+    PXS_TEST_CHECK( IsInline( Value ) );
+    PXS_TEST_CHECK( Value.Compare( INLINE_VALUE, true ) == 0 );
+
+    Value += L"0";
+    PXS_TEST_CHECK( IsInline( Value ) == false );
+    PXS_TEST_CHECK( Value.Compare( HEAP_VALUE, true ) == 0 );
+    PXS_TEST_CHECK( Value.GetLength() == 20 );
+
+    // A heap buffer is kept for shorter values
+    Value = L"Yes";
+    PXS_TEST_CHECK( IsInline( Value ) == false );
+    PXS_TEST_CHECK( Value.Compare( L"Yes", true ) == 0 );
+
+    String Copy( Value );
+    PXS_TEST_CHECK( IsInline( Copy ) );
+    PXS_TEST_CHECK( Copy.Compare( L"Yes", true ) == 0 );
+}
+
+//===============================================================================================//
+//  Description:
+//      Swap and move with inline and heap values, inline characters must
+//      end up in their new owner
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestSwapAndMove()
+{
+    LPCWSTR pszHeap = nullptr;
+    String  Inline, Heap, Other;
+
+    // Inline with heap
+    Inline  = L"No";
+    Heap    = HEAP_VALUE;
+    pszHeap = Heap.c_str();
+    Inline.Swap( Heap );
+    PXS_TEST_CHECK( Inline.c_str() == pszHeap );
+    PXS_TEST_CHECK( Inline.Compare( HEAP_VALUE, true ) == 0 );
+    PXS_TEST_CHECK( IsInline( Heap ) );
+    PXS_TEST_CHECK( Heap.Compare( L"No", true ) == 0 );
+
+    // Changing one does not change the other
+    Heap += L"ne";
+    Inline += L"!";
+    PXS_TEST_CHECK( Heap.Compare( L"None", true ) == 0 );
+    PXS_TEST_CHECK( Inline.GetLength() == 21 );
+
+    // Inline with inline
+    Other = L"Yes";
+    Heap.Swap( Other );
+    PXS_TEST_CHECK( IsInline( Heap ) && IsInline( Other ) );
+    PXS_TEST_CHECK( Heap.Compare( L"Yes", true ) == 0 );
+    PXS_TEST_CHECK( Other.Compare( L"None", true ) == 0 );
+
+    // With itself
+    Other.Swap( Other );
+    PXS_TEST_CHECK( Other.Compare( L"None", true ) == 0 );
+
+    // A moved heap value keeps its buffer
+    pszHeap = Inline.c_str();
+    String Moved( static_cast<String&&>( Inline ) );
+    PXS_TEST_CHECK( Moved.c_str() == pszHeap );
+    PXS_TEST_CHECK( Inline.IsNull() );
+
+    // A moved inline value is copied into the target
+    Moved = static_cast<String&&>( Other );
+    PXS_TEST_CHECK( IsInline( Moved ) );
+    PXS_TEST_CHECK( Moved.Compare( L"None", true ) == 0 );
+    PXS_TEST_CHECK( Other.IsNull() );
+    Other = L"Reused";
+    PXS_TEST_CHECK( Other.Compare( L"Reused", true ) == 0 );
+}
+
+//===============================================================================================//
+//  Description:
+//      Copy, move and swap typical audit values
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+static void TestCopyRate()
+{
+    const  size_t NUM_VALUES = 1000000;
+    size_t i = 0, numChars = 0, expectChars = 0;
+    UINT64 startTick = 0;
+    String Copy, Other, Values[ 4 ];
+    Formatter Format;
+
+    Values[ 0 ] = L"Yes";
+    Values[ 1 ] = L"No";
+    Values[ 2 ] = Format.SizeT( 1234567 );
+    Values[ 3 ] = Format.CreateGuid();
+    for ( i = 0; i < NUM_VALUES; i++ )
+    {
+        expectChars += Values[ i % ARRAYSIZE( Values ) ].GetLength();
+    }
+
+    startTick = GetTickCount64();
+    for ( i = 0; i < NUM_VALUES; i++ )
+    {
+        Copy = Values[ i % ARRAYSIZE( Values ) ];
+        String Moved( static_cast<String&&>( Copy ) );
+        Other.Swap( Moved );
+        numChars += Other.GetLength();
+    }
+    PXSTestReportRate( "Strings copied", NUM_VALUES, GetTickCount64() - startTick );
+
+    PXS_TEST_CHECK( numChars == expectChars );
+    PXS_TEST_CHECK( Other.Compare( Values[ ( NUM_VALUES - 1 ) % ARRAYSIZE( Values ) ], true ) == 0 );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Suite
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Run the string tests
+//
+//  Parameters:
+//      None
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void RunStringTests()
+{
+    TestNullAndEmpty();
+    TestInlineLimit();
+    TestSwapAndMove();
+    TestCopyRate();
+}
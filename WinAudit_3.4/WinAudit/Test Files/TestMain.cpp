@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// WinAudit Unit Tests Entry Point
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Include Files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+#include "WinAudit/Test Files/WinAuditTests.h"
+
+// 2. C System Files
+#include <stdio.h>
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+#include "PxsBase/Header Files/Application.h"
+#include "PxsBase/Header Files/Exception.h"
+
+// 5. This Project
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Data
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static int g_numChecks   = 0;
+static int g_numFailures = 0;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Functions
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//===============================================================================================//
+//  Description:
+//      Record the outcome of a check
+//
+//  Parameters:
+//      passed        - the result of the check
+//      pszExpression - the expression that was checked
+//      pszFile       - the source file of the check
+//      line          - the line number of the check
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void PXSTestCheck( bool passed, const char* pszExpression, const char* pszFile, int line )
+{
+    g_numChecks++;
+    if ( passed == false )
+    {
+        g_numFailures++;
+        printf( "%s(%d): FAILED: %s\n",
+                pszFile ? pszFile : "", line, pszExpression ? pszExpression : "" );
+    }
+}
+
+//===============================================================================================//
+//  Description:
+//      Print a throughput figure
+//
+//  Parameters:
+//      pszName   - what was timed
+//      numItems  - the number of items processed
+//      elapsedMS - the time taken in milliseconds
+//
+//  Returns:
+//      void
+//===============================================================================================//
+void PXSTestReportRate( const char* pszName, size_t numItems, UINT64 elapsedMS )
+{
+    UINT64 count = numItems;
+
+    if ( elapsedMS == 0 )
+    {
+        elapsedMS = 1;
+    }
+    printf( "%s: %llu in %llums, %llu per second.\n",
+            pszName ? pszName : "", count, elapsedMS, ( 1000 * count ) / elapsedMS );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Main Entry Point
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int wmain()
+{
+    try
+    {
+        // Global application object, used by the logger and the messages
+        g_pApplication = new Application;
+        if ( g_pApplication == nullptr )
+        {
+            printf( "ERROR_NOT_ENOUGH_MEMORY\n" );
+            return 1;
+        }
+        g_pApplication->SetApplicationName( PXS_APPLICATION_NAME );
+
+        RunApplicationTests();
+        RunAuditRecordSortTests();
+        RunCategorySnapshotCacheTests();
+        RunCollectorThreadTests();
+        RunDiskDataDecoderTests();
+        RunDiskInformationTests();
+        RunEdidDecoderTests();
+        RunGroupUserInformationTests();
+        RunProcessInformationTests();
+        RunSmbiosInformationTests();
+        RunSqliteDatabaseTests();
+        RunStringHashIndexTests();
+        RunStringTests();
+    }
+    catch ( const Exception& e )
+    {
+        wprintf( L"Unhandled exception: %s\n", e.GetMessage().c_str() );
+        g_numFailures++;
+    }
+    catch ( ... )
+    {
+        printf( "Unhandled exception.\n" );
+        g_numFailures++;
+    }
+    delete g_pApplication;
+    g_pApplication = nullptr;
+
+    printf( "%d checks, %d failed.\n", g_numChecks, g_numFailures );
+
+    return g_numFailures;
+}
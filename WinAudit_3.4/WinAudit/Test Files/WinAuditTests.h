@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// WinAudit Unit Tests Header
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 1987-2022 PARMAVEX SERVICES
+//
+// Licensed under the European Union Public Licence (EUPL), Version 1.1 or -
+// as soon they will be approved by the European Commission - subsequent
+// versions of the EUPL (the "Licence"). You may not use this work except in
+// compliance with the Licence. You may obtain a copy of the Licence at:
+//
+// http://ec.europa.eu/idabc/eupl
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Licence is distributed on an "AS IS" basis,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the Licence for the specific language governing permissions and
+// limitations under the Licence. This source code is free software. It
+// must not be sold, leased, rented, sub-licensed or used for any form of
+// monetary recompense whatsoever. This notice must not be removed or altered
+// from this source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef WINAUDIT_WINAUDIT_TESTS_H_
+#define WINAUDIT_WINAUDIT_TESTS_H_
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Remarks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Console runner for the parts of WinAudit that can be driven without a real
+// computer to audit, e.g. the collector's scheduling with stub collectors and
+// a made-up clock or the snapshot cache with a made-up fingerprint. A check
+// that fails is reported and the run carries on, the exit code is the number
+// of failures. Throughput figures are printed for comparison between builds,
+// they are not checks.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Includes
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 1. Own Interface
+
+// 2. C System Files
+
+// 3. C++ System Files
+
+// 4. Other Libraries
+
+// 5. This Project
+#include "WinAudit/Header Files/WinAudit.h"
+
+// 6. Forwards
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Macros
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define PXS_TEST_CHECK( expr ) PXSTestCheck( ( expr ), #expr, __FILE__, __LINE__ )
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Functions
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void PXSTestCheck( bool passed, const char* pszExpression, const char* pszFile, int line );
+void PXSTestReportRate( const char* pszName, size_t numItems, UINT64 elapsedMS );
+
+// Test suites
+void RunApplicationTests();
+void RunAuditRecordSortTests();
+void RunCategorySnapshotCacheTests();
+void RunCollectorThreadTests();
+void RunDiskDataDecoderTests();
+void RunDiskInformationTests();
+void RunEdidDecoderTests();
+void RunGroupUserInformationTests();
+void RunProcessInformationTests();
+void RunSmbiosInformationTests();
+void RunSqliteDatabaseTests();
+void RunStringHashIndexTests();
+void RunStringTests();
+
+#endif  // WINAUDIT_WINAUDIT_TESTS_H_